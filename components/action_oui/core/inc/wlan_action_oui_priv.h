@@ -28,6 +28,7 @@
 #define _WLAN_ACTION_OUI_PRIV_STRUCT_H_
 
 #include <qdf_list.h>
+#include <qdf_lock.h>
 #include <qdf_types.h>
 #include "wlan_action_oui_public_struct.h"
 #include "wlan_action_oui_tgt_api.h"
@@ -84,18 +85,61 @@ struct action_oui_priv {
 	qdf_mutex_t extension_lock;
 };
 
+/* Extensions of all the actions */
+#define ACTION_OUI_MATCHER_MAX_ENTRIES \
+	(ACTION_OUI_MAX_EXTENSIONS * ACTION_OUI_MAXIMUM_ID)
+/* Buckets of the matcher, indexed by the first 3 bytes of the OUI */
+#define ACTION_OUI_MATCHER_HASH_SIZE 32
+/* End of a matcher chain */
+#define ACTION_OUI_MATCHER_NONE (-1)
+
+/**
+ * struct action_oui_matcher_entry - Extension compiled in the matcher
+ * @extension: Extension contents
+ * @action_id: type of action the extension belongs to
+ * @next: index of the next entry of the same chain
+ */
+struct action_oui_matcher_entry {
+	struct action_oui_extension extension;
+	enum action_oui_id action_id;
+	int16_t next;
+};
+
+/**
+ * struct action_oui_matcher - Extensions of all actions indexed by OUI
+ * @num_entries: number of entries used in @entries
+ * @buckets: first entry of each chain of extensions with an OUI
+ * @wildcard: first entry of the chain of extensions without an OUI
+ * @entries: compiled extensions
+ *
+ * One pass over the vendor IEs of a BSS finds the applicable extensions of
+ * all actions at once.
+ */
+struct action_oui_matcher {
+	uint32_t num_entries;
+	int16_t buckets[ACTION_OUI_MATCHER_HASH_SIZE];
+	int16_t wildcard;
+	struct action_oui_matcher_entry entries[ACTION_OUI_MATCHER_MAX_ENTRIES];
+};
+
 /**
  * struct action_oui_psoc_priv - Private object to be stored in psoc
  * @psoc: pointer to psoc object
  * @total_extensions: total count of extensions from all actions
  * @oui_priv: array of pointers used to refer each action info
  * @tx_ops: call-back functions to send OUIs to firmware
+ * @matcher_lock: lock to control access to @matcher
+ * @matcher_stale: extensions changed since @matcher was compiled
+ * @matcher: extensions of all actions compiled for searches
  */
 struct action_oui_psoc_priv {
 	struct wlan_objmgr_psoc *psoc;
 	uint32_t total_extensions;
 	struct action_oui_priv *oui_priv[ACTION_OUI_MAXIMUM_ID];
 	struct action_oui_tx_ops tx_ops;
+	qdf_mutex_t matcher_lock;
+	bool matcher_stale;
+	struct action_oui_matcher matcher;
 };
 
 /**
@@ -135,7 +179,8 @@ action_oui_send(struct action_oui_psoc_priv *psoc_priv,
  * @action_id: type of action to be checked
  *
  * This function parses the IE buffer and finds if any of the vendor OUI
- * and related attributes are present in it.
+ * and related attributes are present in it. The extensions of all actions
+ * are matched in a single pass over the IEs.
  *
  * Return: If vendor OUI is present return true else false
  */
@@ -144,4 +189,24 @@ action_oui_search(struct action_oui_psoc_priv *psoc_priv,
 		  struct action_oui_search_attr *attr,
 		  enum action_oui_id action_id);
 
+/**
+ * action_oui_search_all() - Find the actions applicable to an IE buffer
+ * @psoc_priv: pointer to action_oui psoc priv obj
+ * @attr: pointer to structure containing beacon IE data etc.,
+ *
+ * Return: bitmap of the actions, BIT(action_id), whose vendor OUI and
+ *	related attributes are present in the IE buffer
+ */
+uint32_t
+action_oui_search_all(struct action_oui_psoc_priv *psoc_priv,
+		      struct action_oui_search_attr *attr);
+
+/**
+ * action_oui_matcher_invalidate() - Recompile the matcher at next search
+ * @psoc_priv: pointer to action_oui psoc priv obj
+ *
+ * Return: None
+ */
+void action_oui_matcher_invalidate(struct action_oui_psoc_priv *psoc_priv);
+
 #endif /* End  of _WLAN_ACTION_OUI_PRIV_STRUCT_H_ */
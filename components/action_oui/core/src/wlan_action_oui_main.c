@@ -147,6 +147,8 @@ action_oui_psoc_create_notification(struct wlan_objmgr_psoc *psoc, void *arg)
 
 	target_if_action_oui_register_tx_ops(&psoc_priv->tx_ops);
 	psoc_priv->psoc = psoc;
+	qdf_mutex_create(&psoc_priv->matcher_lock);
+	psoc_priv->matcher_stale = true;
 
 	status = action_oui_allocate(psoc_priv);
 	if (!QDF_IS_STATUS_SUCCESS(status)) {
@@ -158,6 +160,7 @@ action_oui_psoc_create_notification(struct wlan_objmgr_psoc *psoc, void *arg)
 	goto exit;
 
 detach_psoc_priv:
+	qdf_mutex_destroy(&psoc_priv->matcher_lock);
 	wlan_objmgr_psoc_component_obj_detach(psoc,
 					      WLAN_UMAC_COMP_ACTION_OUI,
 					      (void *)psoc_priv);
@@ -190,6 +193,7 @@ action_oui_psoc_destroy_notification(struct wlan_objmgr_psoc *psoc, void *arg)
 		action_oui_err("Failed to detach priv with psoc");
 
 	action_oui_destroy(psoc_priv);
+	qdf_mutex_destroy(&psoc_priv->matcher_lock);
 	qdf_mem_free(psoc_priv);
 
 exit:
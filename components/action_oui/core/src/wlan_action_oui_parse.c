@@ -505,6 +505,8 @@ action_oui_extension_store(struct action_oui_psoc_priv *psoc_priv,
 	psoc_priv->total_extensions++;
 	qdf_mutex_release(&oui_priv->extension_lock);
 
+	action_oui_matcher_invalidate(psoc_priv);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -854,96 +856,209 @@ check_for_vendor_ap_capabilities(struct action_oui_extension *extension,
 	return true;
 }
 
-static const uint8_t *
-action_oui_get_oui_ptr(struct action_oui_extension *extension,
-		       struct action_oui_search_attr *attr)
+void action_oui_matcher_invalidate(struct action_oui_psoc_priv *psoc_priv)
 {
-	if (!attr->ie_data || !attr->ie_length)
-		return NULL;
+	qdf_mutex_acquire(&psoc_priv->matcher_lock);
+	psoc_priv->matcher_stale = true;
+	qdf_mutex_release(&psoc_priv->matcher_lock);
+}
 
-	return wlan_get_vendor_ie_ptr_from_oui(extension->oui,
-					       extension->oui_length,
-					       attr->ie_data,
-					       attr->ie_length);
+static inline uint8_t action_oui_matcher_hash(const uint8_t *oui)
+{
+	return (oui[0] ^ (oui[1] << 1) ^ (oui[2] << 2)) &
+		(ACTION_OUI_MATCHER_HASH_SIZE - 1);
 }
 
-bool
-action_oui_search(struct action_oui_psoc_priv *psoc_priv,
-		  struct action_oui_search_attr *attr,
-		  enum action_oui_id action_id)
+/**
+ * action_oui_matcher_build() - compile the extensions of all actions
+ * @psoc_priv: pointer to action_oui psoc priv obj
+ *
+ * Called with the matcher lock held. Extensions keep the order they have
+ * in the ini within each chain.
+ *
+ * Return: None
+ */
+static void action_oui_matcher_build(struct action_oui_psoc_priv *psoc_priv)
 {
-	struct action_oui_priv *oui_priv;
+	struct action_oui_matcher *matcher = &psoc_priv->matcher;
+	struct action_oui_matcher_entry *entry;
 	struct action_oui_extension_priv *priv_ext;
-	struct action_oui_extension *extension;
-	qdf_list_node_t *node = NULL;
-	qdf_list_node_t *next_node = NULL;
-	qdf_list_t *extension_list;
-	QDF_STATUS qdf_status;
-	const uint8_t *oui_ptr;
-	bool wildcard_oui = false;
+	struct action_oui_priv *oui_priv;
+	int16_t *tails[ACTION_OUI_MATCHER_HASH_SIZE];
+	int16_t *wildcard_tail;
+	int16_t **tail;
+	qdf_list_node_t *node;
+	qdf_list_node_t *next_node;
+	uint32_t i;
 
-	oui_priv = psoc_priv->oui_priv[action_id];
-	if (!oui_priv) {
-		action_oui_debug("action oui for id %d is empty",
-				 action_id);
-		return false;
+	matcher->num_entries = 0;
+	matcher->wildcard = ACTION_OUI_MATCHER_NONE;
+	wildcard_tail = &matcher->wildcard;
+	for (i = 0; i < ACTION_OUI_MATCHER_HASH_SIZE; i++) {
+		matcher->buckets[i] = ACTION_OUI_MATCHER_NONE;
+		tails[i] = &matcher->buckets[i];
 	}
 
-	extension_list = &oui_priv->extension_list;
-	qdf_mutex_acquire(&oui_priv->extension_lock);
-	if (qdf_list_empty(extension_list)) {
+	for (i = 0; i < ACTION_OUI_MAXIMUM_ID; i++) {
+		oui_priv = psoc_priv->oui_priv[i];
+		if (!oui_priv)
+			continue;
+
+		qdf_mutex_acquire(&oui_priv->extension_lock);
+		node = NULL;
+		qdf_list_peek_front(&oui_priv->extension_list, &node);
+		while (node &&
+		       matcher->num_entries < ACTION_OUI_MATCHER_MAX_ENTRIES) {
+			priv_ext = qdf_container_of(node,
+					struct action_oui_extension_priv,
+					item);
+			entry = &matcher->entries[matcher->num_entries];
+			entry->extension = priv_ext->extension;
+			entry->action_id = i;
+			entry->next = ACTION_OUI_MATCHER_NONE;
+
+			if (entry->extension.info_mask & ACTION_OUI_INFO_OUI)
+				tail = &tails[action_oui_matcher_hash(
+						entry->extension.oui)];
+			else
+				tail = &wildcard_tail;
+			**tail = matcher->num_entries;
+			*tail = &entry->next;
+			matcher->num_entries++;
+
+			next_node = NULL;
+			if (QDF_IS_STATUS_ERROR(
+				qdf_list_peek_next(&oui_priv->extension_list,
+						   node, &next_node)))
+				break;
+			node = next_node;
+		}
 		qdf_mutex_release(&oui_priv->extension_lock);
-		return false;
 	}
 
-	qdf_list_peek_front(extension_list, &node);
-	while (node) {
-		priv_ext = qdf_container_of(node,
-					   struct action_oui_extension_priv,
-					   item);
-		extension = &priv_ext->extension;
+	psoc_priv->matcher_stale = false;
+	action_oui_debug("compiled %u action oui extensions",
+			 matcher->num_entries);
+}
 
-		/*
-		 * If a wildcard OUI bit is not set in the info_mask, proceed
-		 * to other checks skipping the OUI and vendor data checks
-		 */
+/**
+ * action_oui_matcher_check_entry() - check the non IE attributes of an entry
+ * @entry: compiled extension
+ * @attr: search attributes
+ *
+ * Return: true if the AP mac and capabilities of @attr match @entry
+ */
+static bool
+action_oui_matcher_check_entry(struct action_oui_matcher_entry *entry,
+			       struct action_oui_search_attr *attr)
+{
+	struct action_oui_extension *extension = &entry->extension;
 
-		if (!(extension->info_mask & ACTION_OUI_INFO_OUI))
-			wildcard_oui = true;
+	if ((extension->info_mask & ACTION_OUI_INFO_MAC_ADDRESS) &&
+	    (!attr->mac_addr || !check_for_vendor_ap_mac(extension, attr)))
+		return false;
 
-		oui_ptr = action_oui_get_oui_ptr(extension, attr);
+	return check_for_vendor_ap_capabilities(extension, attr);
+}
 
-		if (!oui_ptr  && !wildcard_oui)
-			goto next;
+/**
+ * action_oui_matcher_run() - find the actions applicable to a BSS
+ * @matcher: compiled extensions
+ * @attr: search attributes
+ *
+ * As with a lookup of each extension, only the first vendor IE carrying
+ * the OUI of an extension is checked against its data.
+ *
+ * Return: bitmap of the applicable actions
+ */
+static uint32_t action_oui_matcher_run(struct action_oui_matcher *matcher,
+				       struct action_oui_search_attr *attr)
+{
+	bool seen[ACTION_OUI_MATCHER_MAX_ENTRIES] = {0};
+	struct action_oui_matcher_entry *entry;
+	struct action_oui_extension *extension;
+	const uint8_t *ie = attr->ie_data;
+	uint32_t remaining = attr->ie_data ? attr->ie_length : 0;
+	uint32_t found = 0;
+	uint8_t elem_len;
+	int16_t idx;
+
+	for (idx = matcher->wildcard; idx != ACTION_OUI_MATCHER_NONE;
+	     idx = entry->next) {
+		entry = &matcher->entries[idx];
+		if (!(found & BIT(entry->action_id)) &&
+		    action_oui_matcher_check_entry(entry, attr))
+			found |= BIT(entry->action_id);
+	}
 
-		if (extension->data_length && !wildcard_oui &&
-		    !check_for_vendor_oui_data(extension, oui_ptr))
-			goto next;
+	while (remaining >= 2) {
+		elem_len = ie[1];
+		if (elem_len + 2 > remaining)
+			break;
 
+		if (ie[0] != WLAN_ELEMID_VENDOR || elem_len < 3)
+			goto next_ie;
+
+		idx = matcher->buckets[action_oui_matcher_hash(&ie[2])];
+		for (; idx != ACTION_OUI_MATCHER_NONE; idx = entry->next) {
+			entry = &matcher->entries[idx];
+			extension = &entry->extension;
+			if (seen[idx] ||
+			    found & BIT(entry->action_id))
+				continue;
+
+			if (elem_len < extension->oui_length ||
+			    qdf_mem_cmp(&ie[2], extension->oui,
+					extension->oui_length))
+				continue;
+
+			seen[idx] = true;
+
+			if (extension->data_length &&
+			    !check_for_vendor_oui_data(extension, ie))
+				continue;
+
+			if (!action_oui_matcher_check_entry(entry, attr))
+				continue;
+
+			action_oui_debug("Vendor AP/STA found for OUI, action %u",
+					 entry->action_id);
+			QDF_TRACE_HEX_DUMP(QDF_MODULE_ID_PE,
+					   QDF_TRACE_LEVEL_DEBUG,
+					   extension->oui,
+					   extension->oui_length);
+			found |= BIT(entry->action_id);
+		}
 
-		if ((extension->info_mask & ACTION_OUI_INFO_MAC_ADDRESS) &&
-		    !check_for_vendor_ap_mac(extension, attr))
-			goto next;
+next_ie:
+		ie += elem_len + 2;
+		remaining -= elem_len + 2;
+	}
 
-		if (!check_for_vendor_ap_capabilities(extension, attr))
-			goto next;
+	return found;
+}
 
-		action_oui_debug("Vendor AP/STA found for OUI");
-		QDF_TRACE_HEX_DUMP(QDF_MODULE_ID_PE, QDF_TRACE_LEVEL_DEBUG,
-				   extension->oui, extension->oui_length);
-		qdf_mutex_release(&oui_priv->extension_lock);
-		return true;
-next:
-		qdf_status = qdf_list_peek_next(extension_list,
-						node, &next_node);
-		if (!QDF_IS_STATUS_SUCCESS(qdf_status))
-			break;
+uint32_t
+action_oui_search_all(struct action_oui_psoc_priv *psoc_priv,
+		      struct action_oui_search_attr *attr)
+{
+	uint32_t found = 0;
 
-		node = next_node;
-		next_node = NULL;
-		wildcard_oui = false;
-	}
+	qdf_mutex_acquire(&psoc_priv->matcher_lock);
+	if (psoc_priv->matcher_stale)
+		action_oui_matcher_build(psoc_priv);
 
-	qdf_mutex_release(&oui_priv->extension_lock);
-	return false;
+	if (psoc_priv->matcher.num_entries)
+		found = action_oui_matcher_run(&psoc_priv->matcher, attr);
+	qdf_mutex_release(&psoc_priv->matcher_lock);
+
+	return found;
+}
+
+bool
+action_oui_search(struct action_oui_psoc_priv *psoc_priv,
+		  struct action_oui_search_attr *attr,
+		  enum action_oui_id action_id)
+{
+	return !!(action_oui_search_all(psoc_priv, attr) & BIT(action_id));
 }
@@ -108,6 +108,19 @@ bool ucfg_action_oui_search(struct wlan_objmgr_psoc *psoc,
 			    struct action_oui_search_attr *attr,
 			    enum action_oui_id action_id);
 
+/**
+ * ucfg_action_oui_search_all() - Find the actions applicable to IE data.
+ * @psoc: objmgr psoc object
+ * @attr: pointer to structure containing beacon IE data etc.,
+ *
+ * All the actions are matched in a single pass over the IEs, so a caller
+ * checking several actions for a BSS searches its IEs once.
+ *
+ * Return: bitmap of the applicable actions, BIT(action_id) set for each
+ */
+uint32_t ucfg_action_oui_search_all(struct wlan_objmgr_psoc *psoc,
+				    struct action_oui_search_attr *attr);
+
 #else
 
 /**
@@ -205,6 +218,20 @@ bool ucfg_action_oui_search(struct wlan_objmgr_psoc *psoc,
 	return false;
 }
 
+/**
+ * ucfg_action_oui_search_all() - Find the actions applicable to IE data.
+ * @psoc: objmgr psoc object
+ * @attr: pointer to structure containing beacon IE data etc.,
+ *
+ * Return: bitmap of the applicable actions, BIT(action_id) set for each
+ */
+static inline
+uint32_t ucfg_action_oui_search_all(struct wlan_objmgr_psoc *psoc,
+				    struct action_oui_search_attr *attr)
+{
+	return 0;
+}
+
 #endif /* WLAN_FEATURE_ACTION_OUI */
 
 #endif /* _WLAN_ACTION_OUI_UCFG_API_H_ */
@@ -193,3 +193,22 @@ exit:
 
 	return found;
 }
+
+uint32_t ucfg_action_oui_search_all(struct wlan_objmgr_psoc *psoc,
+				    struct action_oui_search_attr *attr)
+{
+	struct action_oui_psoc_priv *psoc_priv;
+
+	if (!psoc || !attr) {
+		action_oui_err("Invalid psoc or search attrs");
+		return 0;
+	}
+
+	psoc_priv = action_oui_psoc_get_priv(psoc);
+	if (!psoc_priv) {
+		action_oui_err("psoc priv is NULL");
+		return 0;
+	}
+
+	return action_oui_search_all(psoc_priv, attr);
+}
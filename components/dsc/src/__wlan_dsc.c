@@ -24,6 +24,9 @@
 #include "qdf_timer.h"
 #include "__wlan_dsc.h"
 #include "cds_api.h"
+#ifdef WLAN_DSC_PERCPU_OPS
+#include <linux/rcupdate.h>
+#endif
 
 #ifdef WLAN_DSC_DEBUG
 static void __dsc_dbg_op_timeout(void *opaque_op)
@@ -135,15 +138,172 @@ static inline void
 __dsc_dbg_ops_remove(struct dsc_ops *ops, const char *func) { }
 #endif /* WLAN_DSC_DEBUG */
 
+#ifdef WLAN_DSC_PERCPU_OPS
+/**
+ * __dsc_pcpu_ops_init() - initialize the per CPU count of @ops
+ * @ops: the ops container to initialize
+ *
+ * On allocation failure the lockless path stays forbidden on @ops.
+ *
+ * Return: None
+ */
+static void __dsc_pcpu_ops_init(struct dsc_ops *ops)
+{
+	ops->pcpu_count = alloc_percpu(int);
+	ops->fast = false;
+	ops->fold_pending = false;
+	ops->waiters = 0;
+}
+
+/**
+ * __dsc_pcpu_ops_sum() - move the per CPU count of @ops into @ops->count
+ * @ops: the ops container to fold
+ *
+ * Only safe once no CPU can be counting on the lockless path.
+ *
+ * Return: None
+ */
+static void __dsc_pcpu_ops_sum(struct dsc_ops *ops)
+{
+	int *pcpu_count;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		pcpu_count = per_cpu_ptr(ops->pcpu_count, cpu);
+		ops->count += *pcpu_count;
+		*pcpu_count = 0;
+	}
+
+	ops->fold_pending = false;
+}
+
+/**
+ * __dsc_pcpu_ops_deinit() - de-initialize the per CPU count of @ops
+ * @ops: the ops container to de-initialize
+ *
+ * Return: None
+ */
+static void __dsc_pcpu_ops_deinit(struct dsc_ops *ops)
+{
+	if (!ops->pcpu_count)
+		return;
+
+	if (ops->fast || ops->fold_pending) {
+		WRITE_ONCE(ops->fast, false);
+		synchronize_rcu();
+		__dsc_pcpu_ops_sum(ops);
+	}
+
+	free_percpu(ops->pcpu_count);
+	ops->pcpu_count = NULL;
+}
+
+/**
+ * __dsc_pcpu_ops_exact() - check if @ops->count holds every operation
+ * @ops: the ops container to check
+ *
+ * Return: true if nothing is left to fold from the per CPU count
+ */
+static inline bool __dsc_pcpu_ops_exact(struct dsc_ops *ops)
+{
+	return !ops->fold_pending;
+}
+
+bool __dsc_ops_fast_insert(struct dsc_ops *ops)
+{
+	bool fast;
+
+	rcu_read_lock();
+	fast = READ_ONCE(ops->fast);
+	if (fast)
+		this_cpu_inc(*ops->pcpu_count);
+	rcu_read_unlock();
+
+	return fast;
+}
+
+bool __dsc_ops_fast_remove(struct dsc_ops *ops)
+{
+	bool fast;
+
+	rcu_read_lock();
+	fast = READ_ONCE(ops->fast);
+	if (fast)
+		this_cpu_dec(*ops->pcpu_count);
+	rcu_read_unlock();
+
+	return fast;
+}
+
+void __dsc_ops_gate(struct dsc_ops *ops, bool open)
+{
+	/* kept closed while waited for, so that @ops->count stays exact */
+	if (ops->waiters)
+		open = false;
+
+	if (!ops->pcpu_count || ops->fast == open)
+		return;
+
+	WRITE_ONCE(ops->fast, open);
+	if (open)
+		return;
+
+	/* ops counted per CPU are folded by the next *_wait_for_ops() */
+	ops->fold_pending = true;
+}
+
+void __dsc_ops_fold(struct dsc_driver *driver, struct dsc_ops *ops)
+{
+	if (!ops->pcpu_count)
+		return;
+
+	/* close the lockless path whatever the transitions in progress */
+	ops->waiters++;
+	__dsc_ops_gate(ops, false);
+
+	while (ops->fold_pending) {
+		/* wait for the ops which saw the lockless path allowed */
+		__dsc_unlock(driver);
+		synchronize_rcu();
+		__dsc_lock(driver);
+
+		/* another waiter may have folded meanwhile */
+		if (ops->fold_pending)
+			__dsc_pcpu_ops_sum(ops);
+	}
+}
+
+void __dsc_ops_unfold(struct dsc_ops *ops)
+{
+	if (!ops->pcpu_count)
+		return;
+
+	dsc_assert(ops->waiters);
+	ops->waiters--;
+}
+#else
+static inline void __dsc_pcpu_ops_init(struct dsc_ops *ops) { }
+
+static inline void __dsc_pcpu_ops_deinit(struct dsc_ops *ops) { }
+
+static inline bool __dsc_pcpu_ops_exact(struct dsc_ops *ops)
+{
+	return true;
+}
+#endif /* WLAN_DSC_PERCPU_OPS */
+
 void __dsc_ops_init(struct dsc_ops *ops)
 {
 	ops->count = 0;
 	qdf_event_create(&ops->event);
 	__dsc_dbg_ops_init(ops);
+	__dsc_pcpu_ops_init(ops);
 }
 
 void __dsc_ops_deinit(struct dsc_ops *ops)
 {
+	__dsc_pcpu_ops_deinit(ops);
+
 	/* assert no ops in flight */
 	dsc_assert(!ops->count);
 
@@ -166,12 +326,15 @@ QDF_STATUS __dsc_ops_insert(struct dsc_ops *ops, const char *func)
 
 bool __dsc_ops_remove(struct dsc_ops *ops, const char *func)
 {
-	dsc_assert(ops->count);
+	bool exact = __dsc_pcpu_ops_exact(ops);
+
+	/* an op started on the lockless path may be counted per CPU still */
+	dsc_assert(ops->count > 0 || !exact);
 	ops->count--;
 
 	__dsc_dbg_ops_remove(ops, func);
 
-	return ops->count == 0;
+	return exact && ops->count == 0;
 }
 
 #ifdef WLAN_DSC_DEBUG
@@ -30,6 +30,9 @@
 #include "qdf_trace.h"
 #include "qdf_types.h"
 #include "wlan_dsc.h"
+#ifdef WLAN_DSC_PERCPU_OPS
+#include <linux/percpu.h>
+#endif
 
 #define dsc_err(params...) QDF_TRACE_ERROR(QDF_MODULE_ID_QDF, params)
 #define dsc_info(params...) QDF_TRACE_INFO(QDF_MODULE_ID_QDF, params)
@@ -89,15 +92,29 @@ struct dsc_op {
 /**
  * struct dsc_ops - operations in flight tracking container
  * @list: list for tracking debug information
- * @count: count of current operations in flight
+ * @count: count of current operations in flight, except the ones counted in
+ *	@pcpu_count; can go negative while @fold_pending is set
  * @event: event used to wait in *_wait_for_ops() APIs
+ * @pcpu_count: per CPU count of the operations started or stopped without
+ *	taking the driver lock, NULL if it could not be allocated
+ * @fast: operations are counted in @pcpu_count; only set while no transition
+ *	can make the operations fail
+ * @fold_pending: @pcpu_count may be non-zero and has to be folded into @count
+ *	before @count is checked for zero
+ * @waiters: number of *_wait_for_ops() callers, which keep @fast cleared
  */
 struct dsc_ops {
 #ifdef WLAN_DSC_DEBUG
 	qdf_list_t list;
 #endif
-	uint32_t count;
+	int32_t count;
 	qdf_event_t event;
+#ifdef WLAN_DSC_PERCPU_OPS
+	int __percpu *pcpu_count;
+	bool fast;
+	bool fold_pending;
+	uint32_t waiters;
+#endif
 };
 
 /**
@@ -232,10 +249,131 @@ QDF_STATUS __dsc_ops_insert(struct dsc_ops *ops, const char *func);
  * @ops: the ops container to remove from
  * @func: the debug information to remove
  *
- * Return: None
+ * Return: true if no operation is left in flight
  */
 bool __dsc_ops_remove(struct dsc_ops *ops, const char *func);
 
+#ifdef WLAN_DSC_PERCPU_OPS
+/**
+ * __dsc_ops_fast_insert() - count an operation in @ops without the driver lock
+ * @ops: the ops container to insert into
+ *
+ * Return: true if the operation got counted, false if it has to be inserted
+ *	under the driver lock
+ */
+bool __dsc_ops_fast_insert(struct dsc_ops *ops);
+
+/**
+ * __dsc_ops_fast_remove() - uncount an operation in @ops without the driver
+ *	lock
+ * @ops: the ops container to remove from
+ *
+ * The operation does not have to be removed on the CPU it was inserted on, or
+ * on the same path it was inserted on.
+ *
+ * Return: true if the operation got uncounted, false if it has to be removed
+ *	under the driver lock
+ */
+bool __dsc_ops_fast_remove(struct dsc_ops *ops);
+
+/**
+ * __dsc_ops_gate() - allow or forbid the lockless path on @ops
+ * @ops: the ops container to update
+ * @open: true if no transition can make the operations on @ops fail
+ *
+ * Called with the driver lock held.
+ *
+ * Return: None
+ */
+void __dsc_ops_gate(struct dsc_ops *ops, bool open);
+
+/**
+ * __dsc_ops_fold() - fold the per CPU count of @ops into @ops->count
+ * @driver: the driver @ops belongs to
+ * @ops: the ops container to fold
+ *
+ * Like percpu_ref_kill(), the lockless path is forbidden on @ops whatever the
+ * transitions in progress, and stays so until __dsc_ops_unfold(). Called with
+ * the driver lock held, which is released while the operations which saw the
+ * lockless path allowed finish counting. @ops->count is exact on return.
+ *
+ * Return: None
+ */
+void __dsc_ops_fold(struct dsc_driver *driver, struct dsc_ops *ops);
+
+/**
+ * __dsc_ops_unfold() - release the hold of __dsc_ops_fold() on @ops
+ * @ops: the ops container to release
+ *
+ * Called with the driver lock held. The caller then updates the gate of @ops,
+ * which may allow the lockless path again.
+ *
+ * Return: None
+ */
+void __dsc_ops_unfold(struct dsc_ops *ops);
+
+/**
+ * __dsc_driver_ops_gate_update() - allow or forbid the lockless path on the
+ *	ops of every psoc and vdev of @driver
+ * @driver: the driver to update
+ *
+ * Called with the driver lock held, after any transition got started, queued,
+ * stopped or aborted.
+ *
+ * Return: None
+ */
+void __dsc_driver_ops_gate_update(struct dsc_driver *driver);
+
+/**
+ * __dsc_psoc_ops_gate_update() - allow or forbid the lockless path on the ops
+ *	of @psoc and its vdevs
+ * @psoc: the psoc to update
+ *
+ * Return: None
+ */
+void __dsc_psoc_ops_gate_update(struct dsc_psoc *psoc);
+
+/**
+ * __dsc_vdev_ops_gate_update() - allow or forbid the lockless path on the ops
+ *	of @vdev
+ * @vdev: the vdev to update
+ *
+ * Return: None
+ */
+void __dsc_vdev_ops_gate_update(struct dsc_vdev *vdev);
+#else
+static inline bool __dsc_ops_fast_insert(struct dsc_ops *ops)
+{
+	return false;
+}
+
+static inline bool __dsc_ops_fast_remove(struct dsc_ops *ops)
+{
+	return false;
+}
+
+static inline void
+__dsc_ops_fold(struct dsc_driver *driver, struct dsc_ops *ops)
+{
+}
+
+static inline void __dsc_ops_unfold(struct dsc_ops *ops)
+{
+}
+
+static inline void __dsc_driver_ops_gate_update(struct dsc_driver *driver)
+{
+}
+
+static inline void __dsc_psoc_ops_gate_update(struct dsc_psoc *psoc)
+{
+}
+
+static inline void __dsc_vdev_ops_gate_update(struct dsc_vdev *vdev)
+{
+}
+#endif /* WLAN_DSC_PERCPU_OPS */
+
 /**
  * __dsc_trans_init() - initialize @trans
  * @trans: the trans container to initialize
@@ -119,6 +119,17 @@ static bool __dsc_driver_trans_active_down_tree(struct dsc_driver *driver)
 	return false;
 }
 
+#ifdef WLAN_DSC_PERCPU_OPS
+void __dsc_driver_ops_gate_update(struct dsc_driver *driver)
+{
+	struct dsc_psoc *psoc;
+
+	/* driver ops are rare, and always counted under the lock */
+	dsc_for_each_driver_psoc(driver, psoc)
+		__dsc_psoc_ops_gate_update(psoc);
+}
+#endif /* WLAN_DSC_PERCPU_OPS */
+
 #define __dsc_driver_can_op(driver) __dsc_driver_can_trans(driver)
 
 static bool __dsc_driver_can_trans(struct dsc_driver *driver)
@@ -155,6 +166,7 @@ __dsc_driver_trans_start(struct dsc_driver *driver, const char *desc)
 
 	__dsc_lock(driver);
 	status = __dsc_driver_trans_start_nolock(driver, desc);
+	__dsc_driver_ops_gate_update(driver);
 	__dsc_unlock(driver);
 
 	return status;
@@ -195,11 +207,13 @@ __dsc_driver_trans_start_wait(struct dsc_driver *driver, const char *desc)
 	if (QDF_IS_STATUS_ERROR(status))
 		goto unlock;
 
+	__dsc_driver_ops_gate_update(driver);
 	__dsc_unlock(driver);
 
 	return __dsc_tran_wait(&tran);
 
 unlock:
+	__dsc_driver_ops_gate_update(driver);
 	__dsc_unlock(driver);
 
 	return status;
@@ -256,6 +270,7 @@ static void __dsc_driver_trans_stop(struct dsc_driver *driver)
 
 	__dsc_trans_stop(&driver->trans);
 	__dsc_driver_trigger_trans(driver);
+	__dsc_driver_ops_gate_update(driver);
 
 	__dsc_unlock(driver);
 }
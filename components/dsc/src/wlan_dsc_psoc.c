@@ -52,6 +52,7 @@ __dsc_psoc_create(struct dsc_driver *driver, struct dsc_psoc **out_psoc)
 	/* attach */
 	__dsc_driver_lock(psoc);
 	qdf_list_insert_back(&driver->psocs, &psoc->node);
+	__dsc_psoc_ops_gate_update(psoc);
 	__dsc_driver_unlock(psoc);
 
 	*out_psoc = psoc;
@@ -92,6 +93,7 @@ static void __dsc_psoc_destroy(struct dsc_psoc **out_psoc)
 	/* detach */
 	__dsc_driver_lock(psoc);
 	qdf_list_remove_node(&psoc->driver->psocs, &psoc->node);
+	__dsc_driver_ops_gate_update(psoc->driver);
 	__dsc_driver_unlock(psoc);
 
 	/* de-init */
@@ -152,6 +154,19 @@ static QDF_STATUS __dsc_psoc_can_trans(struct dsc_psoc *psoc)
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_DSC_PERCPU_OPS
+void __dsc_psoc_ops_gate_update(struct dsc_psoc *psoc)
+{
+	struct dsc_vdev *vdev;
+
+	__dsc_ops_gate(&psoc->ops,
+		       QDF_IS_STATUS_SUCCESS(__dsc_psoc_can_op(psoc)));
+
+	dsc_for_each_psoc_vdev(psoc, vdev)
+		__dsc_vdev_ops_gate_update(vdev);
+}
+#endif /* WLAN_DSC_PERCPU_OPS */
+
 static bool __dsc_psoc_can_trigger(struct dsc_psoc *psoc)
 {
 	return !__dsc_trans_active_or_queued(&psoc->driver->trans) &&
@@ -184,6 +199,7 @@ __dsc_psoc_trans_start(struct dsc_psoc *psoc, const char *desc)
 
 	__dsc_driver_lock(psoc);
 	status = __dsc_psoc_trans_start_nolock(psoc, desc);
+	__dsc_driver_ops_gate_update(psoc->driver);
 	__dsc_driver_unlock(psoc);
 
 	return status;
@@ -224,11 +240,13 @@ __dsc_psoc_trans_start_wait(struct dsc_psoc *psoc, const char *desc)
 	if (QDF_IS_STATUS_ERROR(status))
 		goto unlock;
 
+	__dsc_driver_ops_gate_update(psoc->driver);
 	__dsc_driver_unlock(psoc);
 
 	return __dsc_tran_wait(&tran);
 
 unlock:
+	__dsc_driver_ops_gate_update(psoc->driver);
 	__dsc_driver_unlock(psoc);
 
 	return status;
@@ -269,6 +287,7 @@ static void __dsc_psoc_trans_stop(struct dsc_psoc *psoc)
 
 	__dsc_trans_stop(&psoc->trans);
 	__dsc_psoc_trigger_trans(psoc);
+	__dsc_driver_ops_gate_update(psoc->driver);
 
 	__dsc_driver_unlock(psoc);
 }
@@ -316,6 +335,9 @@ static QDF_STATUS __dsc_psoc_op_start(struct dsc_psoc *psoc, const char *func)
 	if (!dsc_assert(func))
 		return QDF_STATUS_E_INVAL;
 
+	if (__dsc_ops_fast_insert(&psoc->ops))
+		return QDF_STATUS_SUCCESS;
+
 	__dsc_driver_lock(psoc);
 
 	status = __dsc_psoc_can_op(psoc);
@@ -347,6 +369,9 @@ static void __dsc_psoc_op_stop(struct dsc_psoc *psoc, const char *func)
 	if (!dsc_assert(func))
 		return;
 
+	if (__dsc_ops_fast_remove(&psoc->ops))
+		return;
+
 	__dsc_driver_lock(psoc);
 	if (__dsc_ops_remove(&psoc->ops, func))
 		qdf_event_set(&psoc->ops.event);
@@ -368,6 +393,7 @@ static void __dsc_psoc_wait_for_ops(struct dsc_psoc *psoc)
 
 	__dsc_driver_lock(psoc);
 
+	__dsc_ops_fold(psoc->driver, &psoc->ops);
 	wait = psoc->ops.count > 0;
 	if (wait)
 		qdf_event_reset(&psoc->ops.event);
@@ -377,6 +403,11 @@ static void __dsc_psoc_wait_for_ops(struct dsc_psoc *psoc)
 	if (wait)
 		qdf_wait_single_event(&psoc->ops.event, 0);
 
+	__dsc_driver_lock(psoc);
+	__dsc_ops_unfold(&psoc->ops);
+	__dsc_psoc_ops_gate_update(psoc);
+	__dsc_driver_unlock(psoc);
+
 	/* wait for down-tree ops to complete as well */
 	dsc_for_each_psoc_vdev(psoc, vdev)
 		dsc_vdev_wait_for_ops(vdev);
@@ -52,6 +52,7 @@ __dsc_vdev_create(struct dsc_psoc *psoc, struct dsc_vdev **out_vdev)
 	/* attach */
 	__dsc_driver_lock(vdev);
 	qdf_list_insert_back(&psoc->vdevs, &vdev->node);
+	__dsc_vdev_ops_gate_update(vdev);
 	__dsc_driver_unlock(vdev);
 
 	*out_vdev = vdev;
@@ -88,6 +89,7 @@ static void __dsc_vdev_destroy(struct dsc_vdev **out_vdev)
 	/* detach */
 	__dsc_driver_lock(vdev);
 	qdf_list_remove_node(&vdev->psoc->vdevs, &vdev->node);
+	__dsc_driver_ops_gate_update(vdev->psoc->driver);
 	__dsc_driver_unlock(vdev);
 
 	/* de-init */
@@ -160,6 +162,17 @@ static QDF_STATUS __dsc_vdev_can_trans(struct dsc_vdev *vdev)
 	return QDF_STATUS_SUCCESS;
 }
 
+#ifdef WLAN_DSC_PERCPU_OPS
+void __dsc_vdev_ops_gate_update(struct dsc_vdev *vdev)
+{
+	/* recovery is not tracked by DSC, the lockless path checks for it */
+	__dsc_ops_gate(&vdev->ops,
+		       !__dsc_trans_active_or_queued(&vdev->psoc->driver->trans) &&
+		       !__dsc_trans_active_or_queued(&vdev->psoc->trans) &&
+		       !__dsc_trans_active_or_queued(&vdev->trans));
+}
+#endif /* WLAN_DSC_PERCPU_OPS */
+
 static QDF_STATUS
 __dsc_vdev_trans_start_nolock(struct dsc_vdev *vdev, const char *desc)
 {
@@ -185,6 +198,7 @@ __dsc_vdev_trans_start(struct dsc_vdev *vdev, const char *desc)
 
 	__dsc_driver_lock(vdev);
 	status = __dsc_vdev_trans_start_nolock(vdev, desc);
+	__dsc_driver_ops_gate_update(vdev->psoc->driver);
 	__dsc_driver_unlock(vdev);
 
 	return status;
@@ -225,11 +239,13 @@ __dsc_vdev_trans_start_wait(struct dsc_vdev *vdev, const char *desc)
 	if (QDF_IS_STATUS_ERROR(status))
 		goto unlock;
 
+	__dsc_driver_ops_gate_update(vdev->psoc->driver);
 	__dsc_driver_unlock(vdev);
 
 	return __dsc_tran_wait(&tran);
 
 unlock:
+	__dsc_driver_ops_gate_update(vdev->psoc->driver);
 	__dsc_driver_unlock(vdev);
 
 	return status;
@@ -267,6 +283,7 @@ static void __dsc_vdev_trans_stop(struct dsc_vdev *vdev)
 
 	__dsc_trans_stop(&vdev->trans);
 	__dsc_vdev_trigger_trans(vdev);
+	__dsc_driver_ops_gate_update(vdev->psoc->driver);
 
 	__dsc_driver_unlock(vdev);
 }
@@ -303,6 +320,9 @@ static QDF_STATUS __dsc_vdev_op_start(struct dsc_vdev *vdev, const char *func)
 	if (!dsc_assert(func))
 		return QDF_STATUS_E_INVAL;
 
+	if (!qdf_is_recovering() && __dsc_ops_fast_insert(&vdev->ops))
+		return QDF_STATUS_SUCCESS;
+
 	__dsc_driver_lock(vdev);
 
 	status = __dsc_vdev_can_op(vdev);
@@ -338,6 +358,9 @@ static void __dsc_vdev_op_stop(struct dsc_vdev *vdev, const char *func)
 	if (!dsc_assert(func))
 		return;
 
+	if (__dsc_ops_fast_remove(&vdev->ops))
+		return;
+
 	__dsc_driver_lock(vdev);
 	if (__dsc_ops_remove(&vdev->ops, func))
 		qdf_event_set(&vdev->ops.event);
@@ -361,6 +384,7 @@ static void __dsc_vdev_wait_for_ops(struct dsc_vdev *vdev)
 
 	__dsc_driver_lock(vdev);
 
+	__dsc_ops_fold(vdev->psoc->driver, &vdev->ops);
 	wait = vdev->ops.count > 0;
 	if (wait)
 		qdf_event_reset(&vdev->ops.event);
@@ -369,6 +393,11 @@ static void __dsc_vdev_wait_for_ops(struct dsc_vdev *vdev)
 
 	if (wait)
 		qdf_wait_single_event(&vdev->ops.event, 0);
+
+	__dsc_driver_lock(vdev);
+	__dsc_ops_unfold(&vdev->ops);
+	__dsc_vdev_ops_gate_update(vdev);
+	__dsc_driver_unlock(vdev);
 }
 
 void dsc_vdev_wait_for_ops(struct dsc_vdev *vdev)
@@ -17,8 +17,10 @@
  */
 
 #include "__wlan_dsc.h"
+#include "qdf_atomic.h"
 #include "qdf_event.h"
 #include "qdf_threads.h"
+#include "qdf_time.h"
 #include "qdf_trace.h"
 #include "qdf_types.h"
 #include "wlan_dsc.h"
@@ -613,6 +615,241 @@ exit:
 	return errors;
 }
 
+#define DSC_BENCH_THREADS 4
+#define DSC_BENCH_VDEVS 2
+#define DSC_BENCH_ITERATIONS 100000
+#define DSC_RACE_ROUNDS 200
+#define DSC_RACE_OP_US 20
+
+struct bench_ctx {
+	struct dsc_psoc *psoc;
+	struct dsc_vdev *vdev;
+	qdf_atomic_t *stop;
+	qdf_atomic_t started;
+	qdf_atomic_t ended;
+};
+
+static QDF_STATUS dsc_thread_bench_ops(void *context)
+{
+	struct bench_ctx *ctx = context;
+	uint32_t i;
+
+	/* the psoc and vdevs are stable, so none of these can fail */
+	for (i = 0; i < DSC_BENCH_ITERATIONS; i++) {
+		dsc_assert_success(dsc_psoc_op_start(ctx->psoc));
+		dsc_assert_success(dsc_vdev_op_start(ctx->vdev));
+		dsc_vdev_op_stop(ctx->vdev);
+		dsc_psoc_op_stop(ctx->psoc);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static uint64_t dsc_bench_run(struct dsc_psoc *psoc,
+			      struct bench_ctx ctx[DSC_BENCH_THREADS])
+{
+	qdf_thread_t *threads[DSC_BENCH_THREADS];
+	uint64_t start_us;
+	int i;
+
+	start_us = qdf_get_log_timestamp_usecs();
+
+	for (i = 0; i < DSC_BENCH_THREADS; i++) {
+		ctx[i].psoc = psoc;
+		ctx[i].vdev = nth_vdev(psoc, 1 + i % DSC_BENCH_VDEVS);
+		threads[i] = qdf_thread_run(dsc_thread_bench_ops, &ctx[i]);
+	}
+
+	for (i = 0; i < DSC_BENCH_THREADS; i++)
+		qdf_thread_join(threads[i]);
+
+	return qdf_get_log_timestamp_usecs() - start_us;
+}
+
+/* keep, or stop keeping, every op of @psoc on the locked path */
+static void dsc_bench_force_lock(struct dsc_psoc *psoc, bool force)
+{
+	struct dsc_vdev *vdev;
+
+	__dsc_lock(psoc->driver);
+
+	if (force) {
+		__dsc_ops_fold(psoc->driver, &psoc->ops);
+		dsc_for_each_psoc_vdev(psoc, vdev)
+			__dsc_ops_fold(psoc->driver, &vdev->ops);
+	} else {
+		__dsc_ops_unfold(&psoc->ops);
+		dsc_for_each_psoc_vdev(psoc, vdev)
+			__dsc_ops_unfold(&vdev->ops);
+		__dsc_psoc_ops_gate_update(psoc);
+	}
+
+	__dsc_unlock(psoc->driver);
+}
+
+/* count the ops of @psoc and its vdevs left over, with every op folded */
+static uint32_t dsc_bench_check_ops(struct dsc_psoc *psoc)
+{
+	struct dsc_vdev *vdev;
+	uint32_t errors = 0;
+
+	__dsc_lock(psoc->driver);
+
+	if (psoc->ops.count) {
+		dsc_err("FAIL: %d psoc ops left", psoc->ops.count);
+		errors++;
+	}
+
+	dsc_for_each_psoc_vdev(psoc, vdev) {
+		if (vdev->ops.count) {
+			dsc_err("FAIL: %d vdev ops left", vdev->ops.count);
+			errors++;
+		}
+	}
+
+	__dsc_unlock(psoc->driver);
+
+	return errors;
+}
+
+static uint32_t dsc_test_ops_contention(void)
+{
+	uint32_t errors = 0;
+	QDF_STATUS status;
+	struct dsc_driver *driver;
+	struct dsc_psoc *psoc;
+	struct bench_ctx ctx[DSC_BENCH_THREADS];
+	uint64_t lock_us, elapsed_us;
+
+	dsc_enter();
+
+	status = __dsc_tree_create(&driver, 1, DSC_BENCH_VDEVS);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		errors++;
+		goto exit;
+	}
+
+	psoc = nth_psoc(driver, 1);
+
+	/* baseline, with every op counted under the driver lock */
+	dsc_bench_force_lock(psoc, true);
+	lock_us = dsc_bench_run(psoc, ctx);
+	errors += dsc_bench_check_ops(psoc);
+	dsc_bench_force_lock(psoc, false);
+
+	/* every op started on the lockless path must have been stopped */
+	elapsed_us = dsc_bench_run(psoc, ctx);
+	dsc_bench_force_lock(psoc, true);
+	errors += dsc_bench_check_ops(psoc);
+	dsc_bench_force_lock(psoc, false);
+	dsc_info("%d threads, %d psoc+vdev op start/stop pairs each: %llu us, %llu us under the lock",
+		 DSC_BENCH_THREADS, DSC_BENCH_ITERATIONS, elapsed_us, lock_us);
+
+	__dsc_tree_destroy(driver);
+
+exit:
+	dsc_exit();
+
+	return errors;
+}
+
+static QDF_STATUS dsc_thread_race_ops(void *context)
+{
+	struct bench_ctx *ctx = context;
+
+	while (!qdf_atomic_read(ctx->stop)) {
+		if (QDF_IS_STATUS_ERROR(dsc_vdev_op_start(ctx->vdev))) {
+			schedule();
+			continue;
+		}
+
+		qdf_atomic_inc(&ctx->started);
+		/* keep the op in flight across a wait for ops */
+		qdf_udelay(DSC_RACE_OP_US);
+		qdf_atomic_inc(&ctx->ended);
+
+		dsc_vdev_op_stop(ctx->vdev);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static uint32_t dsc_test_ops_race(void)
+{
+	uint32_t errors = 0;
+	QDF_STATUS status;
+	struct dsc_driver *driver;
+	struct dsc_vdev *vdev;
+	qdf_thread_t *threads[DSC_BENCH_THREADS];
+	struct bench_ctx ctx[DSC_BENCH_THREADS];
+	int started[DSC_BENCH_THREADS];
+	qdf_atomic_t stop;
+	bool trans;
+	int round, i;
+
+	dsc_enter();
+
+	status = __dsc_tree_create(&driver, 1, 1);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		errors++;
+		goto exit;
+	}
+
+	vdev = nth_vdev(nth_psoc(driver, 1), 1);
+	qdf_atomic_init(&stop);
+
+	for (i = 0; i < DSC_BENCH_THREADS; i++) {
+		ctx[i].vdev = vdev;
+		ctx[i].stop = &stop;
+		qdf_atomic_init(&ctx[i].started);
+		qdf_atomic_init(&ctx[i].ended);
+		threads[i] = qdf_thread_run(dsc_thread_race_ops, &ctx[i]);
+	}
+
+	/*
+	 * Every other round waits for the ops without a transition on the
+	 * vdev, as when an interface gets deleted on behalf of another one.
+	 * Either way, the ops seen started before the wait must have ended
+	 * when it returns.
+	 */
+	for (round = 0; round < DSC_RACE_ROUNDS; round++) {
+		trans = round & 1;
+		if (trans)
+			dsc_assert_success(dsc_vdev_trans_start(vdev));
+
+		for (i = 0; i < DSC_BENCH_THREADS; i++)
+			started[i] = qdf_atomic_read(&ctx[i].started);
+
+		dsc_vdev_wait_for_ops(vdev);
+
+		for (i = 0; i < DSC_BENCH_THREADS; i++) {
+			/* no op can start while the vdev transitions */
+			if (trans)
+				started[i] = qdf_atomic_read(&ctx[i].started);
+
+			if (qdf_atomic_read(&ctx[i].ended) < started[i]) {
+				dsc_err("round %d: op of thread %d in flight",
+					round, i);
+				errors++;
+			}
+		}
+
+		if (trans)
+			dsc_vdev_trans_stop(vdev);
+	}
+
+	qdf_atomic_set(&stop, 1);
+	for (i = 0; i < DSC_BENCH_THREADS; i++)
+		qdf_thread_join(threads[i]);
+
+	__dsc_tree_destroy(driver);
+
+exit:
+	dsc_exit();
+
+	return errors;
+}
+
 uint32_t dsc_unit_test(void)
 {
 	uint32_t errors = 0;
@@ -622,6 +859,8 @@ uint32_t dsc_unit_test(void)
 	errors += dsc_test_psoc_trans_blocks();
 	errors += dsc_test_vdev_trans_blocks();
 	errors += dsc_test_trans_wait();
+	errors += dsc_test_ops_contention();
+	errors += dsc_test_ops_race();
 
 	return errors;
 }
@@ -554,6 +554,21 @@ void wlan_ipa_reg_send_to_nw_cb(struct wlan_ipa_priv *ipa_ctx,
 	ipa_ctx->send_to_nw = cb;
 }
 
+/**
+ * wlan_ipa_reg_send_to_nw_list_cb() - Register cb to send a list of IPA Rx
+ *				       packets to network
+ * @ipa_ctx: IPA context
+ * @cb: callback
+ *
+ * Return: None
+ */
+static inline
+void wlan_ipa_reg_send_to_nw_list_cb(struct wlan_ipa_priv *ipa_ctx,
+				     wlan_ipa_send_to_nw_list cb)
+{
+	ipa_ctx->send_to_nw_list = cb;
+}
+
 #ifdef IPA_LAN_RX_NAPI_SUPPORT
 /**
  * wlan_ipa_reg_rps_enable_cb() - Register callback to enable RPS
@@ -76,6 +76,8 @@
 
 #define WLAN_IPA_MAX_PENDING_EVENT_COUNT    20
 
+#define WLAN_IPA_EXCEP_RX_MAX_QUEUE         1024
+
 #define IPA_WLAN_RX_SOFTIRQ_THRESH 32
 
 #define WLAN_IPA_UC_BW_MONITOR_LEVEL        3
@@ -280,6 +282,16 @@ struct wlan_ipa_pm_tx_cb {
 	qdf_ipa_rx_data_t *ipa_tx_desc;
 };
 
+/**
+ * struct wlan_ipa_excep_rx_cb - Batched exception RX callback
+ * @session_id: Session ID of the interface the packet is delivered to,
+ *	resolved when the batch is sent so that a packet queued for an
+ *	interface torn down meanwhile is dropped
+ */
+struct wlan_ipa_excep_rx_cb {
+	uint8_t session_id;
+};
+
 /**
  * struct wlan_ipa_sys_pipe - IPA system pipe
  * @conn_hdl: IPA system pipe connection handle
@@ -359,6 +371,12 @@ struct wlan_ipa_iface_context {
  * @num_rx_excep: Number of RX IPA exception packets
  * @num_tx_fwd_ok: Number of TX forward packet success
  * @num_tx_fwd_err: Number of TX forward packet failures
+ * @num_pm_flush: Number of PM queue flushes
+ * @num_excep_rx_batch: Number of exception RX batches sent to network stack
+ * @num_excep_rx_batched: Number of exception RX packets sent in batches
+ * @num_max_excep_rx_batch: Maximum exception RX batch size
+ * @num_excep_rx_batch_drop: Number of exception RX packets dropped because
+ *	the batch queue was full
  */
 struct wlan_ipa_stats {
 	uint32_t event[QDF_IPA_WLAN_EVENT_MAX];
@@ -379,6 +397,11 @@ struct wlan_ipa_stats {
 	uint64_t num_rx_excep;
 	uint64_t num_tx_fwd_ok;
 	uint64_t num_tx_fwd_err;
+	uint64_t num_pm_flush;
+	uint64_t num_excep_rx_batch;
+	uint64_t num_excep_rx_batched;
+	uint64_t num_max_excep_rx_batch;
+	uint64_t num_excep_rx_batch_drop;
 };
 
 /**
@@ -583,6 +606,8 @@ struct wlan_ipa_tx_desc {
 
 typedef QDF_STATUS (*wlan_ipa_softap_xmit)(qdf_nbuf_t nbuf, qdf_netdev_t dev);
 typedef void (*wlan_ipa_send_to_nw)(qdf_nbuf_t nbuf, qdf_netdev_t dev);
+typedef void (*wlan_ipa_send_to_nw_list)(qdf_nbuf_t nbuf_list,
+					 qdf_netdev_t dev);
 
 /**
  * typedef wlan_ipa_rps_enable - Enable/disable RPS for adapter using vdev id
@@ -617,7 +642,13 @@ struct wlan_ipa_priv {
 	qdf_nbuf_queue_t pm_queue_head;
 	qdf_work_t pm_work;
 	qdf_spinlock_t pm_lock;
+	/* Number of packets taken off pm_queue_head and not yet sent */
+	uint32_t pm_flush_pending;
 	bool suspended;
+	/* Exception packets waiting to be sent to network stack as a batch */
+	qdf_nbuf_queue_t excep_rx_queue;
+	qdf_work_t excep_rx_work;
+	qdf_spinlock_t excep_rx_lock;
 	qdf_spinlock_t q_lock;
 	qdf_spinlock_t enable_disable_lock;
 	/* Flag to indicate wait on pending TX completions */
@@ -696,6 +727,7 @@ struct wlan_ipa_priv {
 
 	wlan_ipa_softap_xmit softap_xmit;
 	wlan_ipa_send_to_nw send_to_nw;
+	wlan_ipa_send_to_nw_list send_to_nw_list;
 	ipa_uc_offload_control_req ipa_tx_op;
 
 #ifdef IPA_LAN_RX_NAPI_SUPPORT
@@ -423,6 +423,68 @@ drop_pkt:
 	return ret;
 }
 
+/**
+ * wlan_ipa_pm_flush_queue() - send packets queued while host was suspended
+ * @ipa_ctx: IPA context
+ *
+ * The pending queue is spliced into a local queue with a single hold of
+ * pm_lock and the spliced packets are sent without taking the lock again.
+ * This is repeated until the pending queue is found empty, so packets
+ * queued while the flush is running are not left behind.
+ *
+ * Return: Number of packets sent
+ */
+static uint32_t wlan_ipa_pm_flush_queue(struct wlan_ipa_priv *ipa_ctx)
+{
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	qdf_nbuf_queue_t local_q;
+	qdf_nbuf_t skb;
+	uint32_t dequeued = 0;
+
+	qdf_nbuf_queue_init(&local_q);
+
+	while (true) {
+		qdf_spin_lock_bh(&ipa_ctx->pm_lock);
+		if (qdf_nbuf_is_queue_empty(&ipa_ctx->pm_queue_head)) {
+			ipa_ctx->pm_flush_pending = 0;
+			qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
+			break;
+		}
+		qdf_nbuf_queue_append(&local_q, &ipa_ctx->pm_queue_head);
+		qdf_nbuf_queue_init(&ipa_ctx->pm_queue_head);
+		ipa_ctx->pm_flush_pending = qdf_nbuf_queue_len(&local_q);
+		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
+
+		while ((skb = qdf_nbuf_queue_remove(&local_q))) {
+			pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+			dequeued++;
+
+			if (pm_tx_cb->exception) {
+				if (ipa_ctx->softap_xmit &&
+				    pm_tx_cb->iface_context->dev) {
+					ipa_ctx->softap_xmit(skb,
+						pm_tx_cb->iface_context->dev);
+					ipa_ctx->stats.num_tx_fwd_ok++;
+				} else {
+					dev_kfree_skb_any(skb);
+				}
+			} else {
+				wlan_ipa_send_pkt_to_tl(pm_tx_cb->iface_context,
+							pm_tx_cb->ipa_tx_desc);
+			}
+		}
+	}
+
+	if (dequeued) {
+		ipa_ctx->stats.num_pm_flush++;
+		ipa_ctx->stats.num_tx_dequeued += dequeued;
+		if (dequeued > ipa_ctx->stats.num_max_pm_queue)
+			ipa_ctx->stats.num_max_pm_queue = dequeued;
+	}
+
+	return dequeued;
+}
+
 #ifdef CONFIG_IPA_WDI_UNIFIED_API
 /*
  * TODO: Get WDI version through FW capabilities
@@ -586,39 +648,8 @@ static inline int wlan_ipa_wdi_teardown_sys_pipe(struct wlan_ipa_priv *ipa_ctx,
 static void wlan_ipa_pm_flush(void *data)
 {
 	struct wlan_ipa_priv *ipa_ctx = (struct wlan_ipa_priv *)data;
-	struct wlan_ipa_pm_tx_cb *pm_tx_cb = NULL;
-	qdf_nbuf_t skb;
-	uint32_t dequeued = 0;
-
-	qdf_spin_lock_bh(&ipa_ctx->pm_lock);
-	while (((skb = qdf_nbuf_queue_remove(&ipa_ctx->pm_queue_head)) !=
-	       NULL)) {
-		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
-
-		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
-		dequeued++;
-
-		if (pm_tx_cb->exception) {
-			if (ipa_ctx->softap_xmit &&
-			    pm_tx_cb->iface_context->dev) {
-				ipa_ctx->softap_xmit(skb,
-						pm_tx_cb->iface_context->dev);
-				ipa_ctx->stats.num_tx_fwd_ok++;
-			} else {
-				dev_kfree_skb_any(skb);
-			}
-		} else {
-			wlan_ipa_send_pkt_to_tl(pm_tx_cb->iface_context,
-						pm_tx_cb->ipa_tx_desc);
-		}
 
-		qdf_spin_lock_bh(&ipa_ctx->pm_lock);
-	}
-	qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
-
-	ipa_ctx->stats.num_tx_dequeued += dequeued;
-	if (dequeued > ipa_ctx->stats.num_max_pm_queue)
-		ipa_ctx->stats.num_max_pm_queue = dequeued;
+	wlan_ipa_pm_flush_queue(ipa_ctx);
 }
 
 int wlan_ipa_uc_smmu_map(bool map, uint32_t num_buf, qdf_mem_info_t *buf_arr)
@@ -836,43 +867,12 @@ static inline int wlan_ipa_wdi_teardown_sys_pipe(
 static void wlan_ipa_pm_flush(void *data)
 {
 	struct wlan_ipa_priv *ipa_ctx = (struct wlan_ipa_priv *)data;
-	struct wlan_ipa_pm_tx_cb *pm_tx_cb = NULL;
-	qdf_nbuf_t skb;
-	uint32_t dequeued = 0;
 
 	qdf_wake_lock_acquire(&ipa_ctx->wake_lock,
 			      WIFI_POWER_EVENT_WAKELOCK_IPA);
-	qdf_spin_lock_bh(&ipa_ctx->pm_lock);
-	while (((skb = qdf_nbuf_queue_remove(&ipa_ctx->pm_queue_head)) !=
-	       NULL)) {
-		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
-
-		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
-		dequeued++;
-
-		if (pm_tx_cb->exception) {
-			if (ipa_ctx->softap_xmit &&
-			    pm_tx_cb->iface_context->dev) {
-				ipa_ctx->softap_xmit(skb,
-						pm_tx_cb->iface_context->dev);
-				ipa_ctx->stats.num_tx_fwd_ok++;
-			} else {
-				dev_kfree_skb_any(skb);
-			}
-		} else {
-			wlan_ipa_send_pkt_to_tl(pm_tx_cb->iface_context,
-						pm_tx_cb->ipa_tx_desc);
-		}
-
-		qdf_spin_lock_bh(&ipa_ctx->pm_lock);
-	}
-	qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
+	wlan_ipa_pm_flush_queue(ipa_ctx);
 	qdf_wake_lock_release(&ipa_ctx->wake_lock,
 			      WIFI_POWER_EVENT_WAKELOCK_IPA);
-
-	ipa_ctx->stats.num_tx_dequeued += dequeued;
-	if (dequeued > ipa_ctx->stats.num_max_pm_queue)
-		ipa_ctx->stats.num_max_pm_queue = dequeued;
 }
 
 int wlan_ipa_uc_smmu_map(bool map, uint32_t num_buf, qdf_mem_info_t *buf_arr)
@@ -917,8 +917,13 @@ wlan_ipa_send_skb_to_network(qdf_nbuf_t skb,
 			     struct wlan_ipa_iface_context *iface_ctx)
 {
 	struct wlan_ipa_priv *ipa_ctx = gp_ipa;
+	qdf_netdev_t dev;
+
+	qdf_spin_lock_bh(&iface_ctx->interface_lock);
+	dev = iface_ctx->dev;
+	qdf_spin_unlock_bh(&iface_ctx->interface_lock);
 
-	if (!iface_ctx->dev) {
+	if (!dev) {
 		ipa_debug_rl("Invalid interface");
 		ipa_ctx->ipa_rx_internal_drop_count++;
 		dev_kfree_skb_any(skb);
@@ -928,11 +933,243 @@ wlan_ipa_send_skb_to_network(qdf_nbuf_t skb,
 	skb->destructor = wlan_ipa_uc_rt_debug_destructor;
 
 	if (ipa_ctx->send_to_nw)
-		ipa_ctx->send_to_nw(skb, iface_ctx->dev);
+		ipa_ctx->send_to_nw(skb, dev);
 
 	ipa_ctx->ipa_rx_net_send_count++;
 }
 
+/**
+ * wlan_ipa_get_ifaceid() - Get IPA context interface ID
+ * @ipa_ctx: IPA context
+ * @session_id: Session ID
+ *
+ * Return: None
+ */
+static int wlan_ipa_get_ifaceid(struct wlan_ipa_priv *ipa_ctx,
+				uint8_t session_id)
+{
+	struct wlan_ipa_iface_context *iface_ctx;
+	int i;
+
+	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++) {
+		iface_ctx = &ipa_ctx->iface_context[i];
+		if (iface_ctx->session_id == session_id)
+			break;
+	}
+
+	return i;
+}
+
+/**
+ * wlan_ipa_excep_rx_drop() - Drop a list of exception packets
+ * @ipa_ctx: IPA context
+ * @nbuf_list: packets chained through qdf_nbuf_next
+ *
+ * Return: None
+ */
+static void wlan_ipa_excep_rx_drop(struct wlan_ipa_priv *ipa_ctx,
+				   qdf_nbuf_t nbuf_list)
+{
+	qdf_nbuf_t skb, next;
+
+	for (skb = nbuf_list; skb; skb = next) {
+		next = qdf_nbuf_next(skb);
+		ipa_ctx->ipa_rx_internal_drop_count++;
+		dev_kfree_skb_any(skb);
+	}
+}
+
+/**
+ * wlan_ipa_excep_rx_send_batch() - Send a batch of exception packets to kernel
+ * @ipa_ctx: IPA context
+ * @nbuf_list: packets chained through qdf_nbuf_next
+ * @session_id: Session ID of the interface all the packets belong to
+ * @count: number of packets in @nbuf_list
+ *
+ * The interface is looked up again from @session_id, the one the packets
+ * were queued for may have been cleaned up meanwhile.
+ *
+ * Return: None
+ */
+static void
+wlan_ipa_excep_rx_send_batch(struct wlan_ipa_priv *ipa_ctx,
+			     qdf_nbuf_t nbuf_list, uint8_t session_id,
+			     uint32_t count)
+{
+	struct wlan_ipa_iface_context *iface_ctx;
+	qdf_netdev_t dev = NULL;
+	int iface_id;
+
+	iface_id = wlan_ipa_get_ifaceid(ipa_ctx, session_id);
+	if (iface_id < WLAN_IPA_MAX_IFACE) {
+		iface_ctx = &ipa_ctx->iface_context[iface_id];
+		qdf_spin_lock_bh(&iface_ctx->interface_lock);
+		if (iface_ctx->session_id == session_id)
+			dev = iface_ctx->dev;
+		qdf_spin_unlock_bh(&iface_ctx->interface_lock);
+	}
+
+	if (!dev) {
+		ipa_debug_rl("Invalid interface for session_id %u",
+			     session_id);
+		wlan_ipa_excep_rx_drop(ipa_ctx, nbuf_list);
+		return;
+	}
+
+	/*
+	 * wlan_ipa_cleanup_iface() waits for this work after clearing the
+	 * device, so that @dev stays valid until the list is sent.
+	 */
+	ipa_ctx->send_to_nw_list(nbuf_list, dev);
+
+	ipa_ctx->ipa_rx_net_send_count += count;
+	ipa_ctx->stats.num_excep_rx_batch++;
+	ipa_ctx->stats.num_excep_rx_batched += count;
+	if (count > ipa_ctx->stats.num_max_excep_rx_batch)
+		ipa_ctx->stats.num_max_excep_rx_batch = count;
+}
+
+/**
+ * wlan_ipa_excep_rx_flush() - Send batched exception packets to kernel
+ * @data: IPA context
+ *
+ * Consecutive packets of the same interface are handed over to the network
+ * stack as one list, so the interface is resolved and the stack is entered
+ * once per run instead of once per packet.
+ *
+ * Return: None
+ */
+static void wlan_ipa_excep_rx_flush(void *data)
+{
+	struct wlan_ipa_priv *ipa_ctx = (struct wlan_ipa_priv *)data;
+	struct wlan_ipa_excep_rx_cb *rx_cb;
+	qdf_nbuf_queue_t local_q;
+	qdf_nbuf_t skb, run_head = NULL, run_tail = NULL;
+	uint32_t run_len = 0;
+	uint8_t run_session_id = WLAN_IPA_MAX_SESSION;
+
+	qdf_nbuf_queue_init(&local_q);
+
+	qdf_spin_lock_bh(&ipa_ctx->excep_rx_lock);
+	qdf_nbuf_queue_append(&local_q, &ipa_ctx->excep_rx_queue);
+	qdf_nbuf_queue_init(&ipa_ctx->excep_rx_queue);
+	qdf_spin_unlock_bh(&ipa_ctx->excep_rx_lock);
+
+	while ((skb = qdf_nbuf_queue_remove(&local_q))) {
+		rx_cb = (struct wlan_ipa_excep_rx_cb *)skb->cb;
+
+		if (run_head && rx_cb->session_id != run_session_id) {
+			wlan_ipa_excep_rx_send_batch(ipa_ctx, run_head,
+						     run_session_id, run_len);
+			run_head = NULL;
+			run_len = 0;
+		}
+
+		if (!run_head) {
+			run_head = skb;
+			run_session_id = rx_cb->session_id;
+		} else {
+			qdf_nbuf_set_next(run_tail, skb);
+		}
+
+		qdf_mem_zero(skb->cb, sizeof(skb->cb));
+		qdf_nbuf_set_next(skb, NULL);
+		run_tail = skb;
+		run_len++;
+	}
+
+	if (run_head)
+		wlan_ipa_excep_rx_send_batch(ipa_ctx, run_head, run_session_id,
+					     run_len);
+}
+
+/**
+ * wlan_ipa_excep_rx_flush_iface() - Drop the batched packets of an interface
+ * @ipa_ctx: IPA context
+ * @session_id: Session ID of the interface being cleaned up
+ *
+ * Called once the interface got cleared, so that no packet is queued for
+ * it anymore. Also waits for a batch being sent to its device.
+ *
+ * Return: None
+ */
+static void wlan_ipa_excep_rx_flush_iface(struct wlan_ipa_priv *ipa_ctx,
+					  uint8_t session_id)
+{
+	struct wlan_ipa_excep_rx_cb *rx_cb;
+	qdf_nbuf_queue_t keep_q;
+	qdf_nbuf_t skb;
+
+	qdf_nbuf_queue_init(&keep_q);
+
+	qdf_spin_lock_bh(&ipa_ctx->excep_rx_lock);
+	while ((skb = qdf_nbuf_queue_remove(&ipa_ctx->excep_rx_queue))) {
+		rx_cb = (struct wlan_ipa_excep_rx_cb *)skb->cb;
+		if (rx_cb->session_id != session_id) {
+			qdf_nbuf_queue_add(&keep_q, skb);
+			continue;
+		}
+
+		ipa_ctx->ipa_rx_internal_drop_count++;
+		dev_kfree_skb_any(skb);
+	}
+	qdf_nbuf_queue_append(&ipa_ctx->excep_rx_queue, &keep_q);
+	qdf_spin_unlock_bh(&ipa_ctx->excep_rx_lock);
+
+	qdf_flush_work(&ipa_ctx->excep_rx_work);
+}
+
+/**
+ * wlan_ipa_excep_rx_enqueue() - Queue exception packet to be sent to kernel
+ * @ipa_ctx: IPA context
+ * @skb: network buffer
+ * @iface_ctx: IPA interface context
+ *
+ * If exception RX batching is disabled or the upper layer has not
+ * registered a list callback, the packet is sent to the kernel right away.
+ *
+ * Return: None
+ */
+static void
+wlan_ipa_excep_rx_enqueue(struct wlan_ipa_priv *ipa_ctx, qdf_nbuf_t skb,
+			  struct wlan_ipa_iface_context *iface_ctx)
+{
+	struct wlan_ipa_excep_rx_cb *rx_cb;
+	uint32_t batch_size = ipa_ctx->config->excep_rx_batch_size;
+	uint32_t qlen;
+
+	if (!batch_size || !ipa_ctx->send_to_nw_list) {
+		wlan_ipa_send_skb_to_network(skb, iface_ctx);
+		return;
+	}
+
+	skb->destructor = wlan_ipa_uc_rt_debug_destructor;
+	qdf_mem_zero(skb->cb, sizeof(skb->cb));
+	rx_cb = (struct wlan_ipa_excep_rx_cb *)skb->cb;
+	rx_cb->session_id = iface_ctx->session_id;
+
+	qdf_spin_lock_bh(&ipa_ctx->excep_rx_lock);
+	qlen = qdf_nbuf_queue_len(&ipa_ctx->excep_rx_queue);
+	if (qlen >= WLAN_IPA_EXCEP_RX_MAX_QUEUE) {
+		qdf_spin_unlock_bh(&ipa_ctx->excep_rx_lock);
+		ipa_ctx->stats.num_excep_rx_batch_drop++;
+		ipa_ctx->ipa_rx_internal_drop_count++;
+		dev_kfree_skb_any(skb);
+		return;
+	}
+	qdf_nbuf_queue_add(&ipa_ctx->excep_rx_queue, skb);
+	qlen++;
+	qdf_spin_unlock_bh(&ipa_ctx->excep_rx_lock);
+
+	/*
+	 * Kick the flush work for the first packet of a batch so that an
+	 * isolated packet is not held back, and again once the batch size is
+	 * reached in case the work has already started draining.
+	 */
+	if (qlen == 1 || qlen >= batch_size)
+		qdf_sched_work(0, &ipa_ctx->excep_rx_work);
+}
+
 /**
  * __wlan_ipa_w2i_cb() - WLAN to IPA callback handler
  * @priv: pointer to private data registered with IPA (we register a
@@ -1018,7 +1255,7 @@ static void __wlan_ipa_w2i_cb(void *priv, qdf_ipa_dp_evt_type_t evt,
 				     session_id);
 		}
 
-		wlan_ipa_send_skb_to_network(skb, iface_context);
+		wlan_ipa_excep_rx_enqueue(ipa_ctx, skb, iface_context);
 		break;
 
 	default:
@@ -1376,28 +1613,6 @@ static bool wlan_ipa_uc_find_add_assoc_sta(struct wlan_ipa_priv *ipa_ctx,
 	return sta_found;
 }
 
-/**
- * wlan_ipa_get_ifaceid() - Get IPA context interface ID
- * @ipa_ctx: IPA context
- * @session_id: Session ID
- *
- * Return: None
- */
-static int wlan_ipa_get_ifaceid(struct wlan_ipa_priv *ipa_ctx,
-				uint8_t session_id)
-{
-	struct wlan_ipa_iface_context *iface_ctx;
-	int i;
-
-	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++) {
-		iface_ctx = &ipa_ctx->iface_context[i];
-		if (iface_ctx->session_id == session_id)
-			break;
-	}
-
-	return i;
-}
-
 /**
  * wlan_ipa_cleanup_iface() - Cleanup IPA on a given interface
  * @iface_context: interface-specific IPA context
@@ -1407,10 +1622,11 @@ static int wlan_ipa_get_ifaceid(struct wlan_ipa_priv *ipa_ctx,
 static void wlan_ipa_cleanup_iface(struct wlan_ipa_iface_context *iface_context)
 {
 	struct wlan_ipa_priv *ipa_ctx = iface_context->ipa_ctx;
+	uint8_t session_id = iface_context->session_id;
 
 	ipa_debug("enter");
 
-	if (iface_context->session_id == WLAN_IPA_MAX_SESSION)
+	if (session_id == WLAN_IPA_MAX_SESSION)
 		return;
 
 	cdp_ipa_cleanup_iface(ipa_ctx->dp_soc,
@@ -1425,6 +1641,7 @@ static void wlan_ipa_cleanup_iface(struct wlan_ipa_iface_context *iface_context)
 	iface_context->device_mode = QDF_MAX_NO_OF_MODE;
 	iface_context->session_id = WLAN_IPA_MAX_SESSION;
 	qdf_spin_unlock_bh(&iface_context->interface_lock);
+	wlan_ipa_excep_rx_flush_iface(ipa_ctx, session_id);
 	iface_context->ifa_address = 0;
 	if (!iface_context->ipa_ctx->num_iface) {
 		ipa_err("NUM INTF 0, Invalid");
@@ -3165,11 +3382,15 @@ QDF_STATUS wlan_ipa_setup(struct wlan_ipa_priv *ipa_ctx,
 
 	qdf_create_work(0, &ipa_ctx->pm_work, wlan_ipa_pm_flush, ipa_ctx);
 	qdf_spinlock_create(&ipa_ctx->pm_lock);
+	qdf_create_work(0, &ipa_ctx->excep_rx_work, wlan_ipa_excep_rx_flush,
+			ipa_ctx);
+	qdf_spinlock_create(&ipa_ctx->excep_rx_lock);
 	qdf_spinlock_create(&ipa_ctx->q_lock);
 	qdf_spinlock_create(&ipa_ctx->enable_disable_lock);
 	ipa_ctx->pipes_down_in_progress = false;
 	ipa_ctx->pipes_enable_in_progress = false;
 	qdf_nbuf_queue_init(&ipa_ctx->pm_queue_head);
+	qdf_nbuf_queue_init(&ipa_ctx->excep_rx_queue);
 	qdf_list_create(&ipa_ctx->pending_event, 1000);
 	qdf_mutex_create(&ipa_ctx->event_lock);
 	qdf_mutex_create(&ipa_ctx->ipa_lock);
@@ -3238,6 +3459,7 @@ ipa_wdi_destroy:
 
 fail_setup_rm:
 	qdf_spinlock_destroy(&ipa_ctx->pm_lock);
+	qdf_spinlock_destroy(&ipa_ctx->excep_rx_lock);
 	qdf_spinlock_destroy(&ipa_ctx->q_lock);
 	qdf_spinlock_destroy(&ipa_ctx->enable_disable_lock);
 	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++) {
@@ -3281,6 +3503,13 @@ void wlan_ipa_flush(struct wlan_ipa_priv *ipa_ctx)
 		qdf_spin_lock_bh(&ipa_ctx->pm_lock);
 	}
 	qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
+
+	qdf_cancel_work(&ipa_ctx->excep_rx_work);
+
+	qdf_spin_lock_bh(&ipa_ctx->excep_rx_lock);
+	while ((skb = qdf_nbuf_queue_remove(&ipa_ctx->excep_rx_queue)))
+		dev_kfree_skb_any(skb);
+	qdf_spin_unlock_bh(&ipa_ctx->excep_rx_lock);
 }
 
 QDF_STATUS wlan_ipa_cleanup(struct wlan_ipa_priv *ipa_ctx)
@@ -3306,6 +3535,7 @@ QDF_STATUS wlan_ipa_cleanup(struct wlan_ipa_priv *ipa_ctx)
 	wlan_ipa_flush(ipa_ctx);
 
 	qdf_spinlock_destroy(&ipa_ctx->pm_lock);
+	qdf_spinlock_destroy(&ipa_ctx->excep_rx_lock);
 	qdf_spinlock_destroy(&ipa_ctx->q_lock);
 	qdf_spinlock_destroy(&ipa_ctx->enable_disable_lock);
 
@@ -347,6 +347,28 @@ void ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 	return wlan_ipa_reg_send_to_nw_cb(ipa_obj, cb);
 }
 
+void ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				wlan_ipa_send_to_nw_list cb)
+{
+	struct wlan_ipa_priv *ipa_obj;
+
+	if (!ipa_config_is_enabled()) {
+		ipa_debug("ipa is disabled");
+		return;
+	}
+
+	if (!ipa_is_ready())
+		return;
+
+	ipa_obj = ipa_pdev_get_priv_obj(pdev);
+	if (!ipa_obj) {
+		ipa_err("IPA object is NULL");
+		return;
+	}
+
+	return wlan_ipa_reg_send_to_nw_list_cb(ipa_obj, cb);
+}
+
 #ifdef IPA_LAN_RX_NAPI_SUPPORT
 void ipa_reg_rps_enable_cb(struct wlan_objmgr_pdev *pdev,
 			   wlan_ipa_rps_enable cb)
@@ -774,6 +796,8 @@ void ipa_component_config_update(struct wlan_objmgr_psoc *psoc)
 		cfg_get(psoc, CFG_DP_BUS_BANDWIDTH_LOW_THRESHOLD);
 	g_ipa_config->ipa_force_voting =
 		cfg_get(psoc, CFG_DP_IPA_ENABLE_FORCE_VOTING);
+	g_ipa_config->excep_rx_batch_size =
+		cfg_get(psoc, CFG_DP_IPA_EXCEP_RX_BATCH_SIZE);
 }
 
 void ipa_component_config_free(void)
@@ -181,7 +181,8 @@ QDF_STATUS wlan_ipa_wdi_rm_try_release(struct wlan_ipa_priv *ipa_ctx)
 
 	qdf_spin_lock_bh(&ipa_ctx->pm_lock);
 
-	if (!qdf_nbuf_is_queue_empty(&ipa_ctx->pm_queue_head)) {
+	if (!qdf_nbuf_is_queue_empty(&ipa_ctx->pm_queue_head) ||
+	    ipa_ctx->pm_flush_pending) {
 		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
 		return QDF_STATUS_E_AGAIN;
 	}
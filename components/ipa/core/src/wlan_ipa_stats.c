@@ -577,6 +577,11 @@ static void wlan_ipa_print_txrx_stats(struct wlan_ipa_priv *ipa_ctx)
 		"NUM TX QUEUED: %llu\n"
 		"NUM TX DEQUEUED: %llu\n"
 		"NUM MAX PM QUEUE: %llu\n"
+		"NUM PM FLUSH: %llu\n"
+		"NUM EXCP RX BATCH: %llu\n"
+		"NUM EXCP RX BATCHED: %llu\n"
+		"NUM MAX EXCP RX BATCH: %llu\n"
+		"NUM EXCP RX BATCH DROP: %llu\n"
 		"TX REF CNT: %d\n"
 		"SUSPENDED: %d\n"
 		"PEND DESC HEAD: %pK\n"
@@ -596,6 +601,11 @@ static void wlan_ipa_print_txrx_stats(struct wlan_ipa_priv *ipa_ctx)
 		ipa_ctx->stats.num_tx_queued,
 		ipa_ctx->stats.num_tx_dequeued,
 		ipa_ctx->stats.num_max_pm_queue,
+		ipa_ctx->stats.num_pm_flush,
+		ipa_ctx->stats.num_excep_rx_batch,
+		ipa_ctx->stats.num_excep_rx_batched,
+		ipa_ctx->stats.num_max_excep_rx_batch,
+		ipa_ctx->stats.num_excep_rx_batch_drop,
 		ipa_ctx->tx_ref_cnt.counter,
 		ipa_ctx->suspended,
 		&ipa_ctx->pend_desc_head,
@@ -198,6 +198,34 @@
 		512, \
 		CFG_VALUE_OR_DEFAULT, "IPA tx buffer count")
 
+/*
+ * <ini>
+ * IpaExcepRxBatchSize - IPA exception RX batch size
+ * @Min: 0
+ * @Max: 64
+ * @Default: 0
+ *
+ * This ini specifies the number of IPA exception packets which are
+ * collected before they are handed over to the network stack as one
+ * list. Packets are also handed over as soon as the deferred batch
+ * work runs, so this is an upper bound rather than a fixed size.
+ * 0 hands every exception packet over to the network stack inline.
+ *
+ * Related: N/A
+ *
+ * Supported Feature: IPA
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_IPA_EXCEP_RX_BATCH_SIZE \
+		CFG_INI_UINT("IpaExcepRxBatchSize", \
+		0, \
+		64, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, "IPA exception RX batch size")
+
 #define CFG_IPA \
 	CFG(CFG_DP_IPA_OFFLOAD_CONFIG) \
 	CFG(CFG_DP_IPA_DESC_SIZE) \
@@ -205,6 +233,7 @@
 	CFG(CFG_DP_IPA_MEDIUM_BANDWIDTH_MBPS) \
 	CFG(CFG_DP_IPA_LOW_BANDWIDTH_MBPS) \
 	CFG(CFG_DP_IPA_ENABLE_FORCE_VOTING) \
-	CFG(CFG_DP_IPA_UC_TX_BUF_COUNT)
+	CFG(CFG_DP_IPA_UC_TX_BUF_COUNT) \
+	CFG(CFG_DP_IPA_EXCEP_RX_BATCH_SIZE)
 
 #endif /* _CFG_IPA_H_ */
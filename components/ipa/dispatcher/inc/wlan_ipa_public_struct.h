@@ -51,6 +51,7 @@ struct wlan_ipa_config {
 	uint32_t ipa_bw_medium;
 	uint32_t ipa_bw_low;
 	bool ipa_force_voting;
+	uint32_t excep_rx_batch_size;
 };
 
 /**
@@ -176,6 +176,20 @@ void ucfg_ipa_reg_sap_xmit_cb(struct wlan_objmgr_pdev *pdev,
 void ucfg_ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 				wlan_ipa_send_to_nw cb);
 
+/**
+ * ucfg_ipa_reg_send_to_nw_list_cb() - Register cb to send a list of IPA Rx
+ *				       packets to network
+ * @pdev: pdev obj
+ * @cb: callback
+ *
+ * The packets handed over to @cb are chained through qdf_nbuf_next and
+ * all belong to the same network device.
+ *
+ * Return: None
+ */
+void ucfg_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				     wlan_ipa_send_to_nw_list cb);
+
 /**
  * ucfg_ipa_reg_rps_enable_cb() - Register cb to enable RPS
  * @pdev: pdev obj
@@ -512,6 +526,12 @@ void ucfg_ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 {
 }
 
+static inline
+void ucfg_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				     wlan_ipa_send_to_nw_list cb)
+{
+}
+
 static inline
 void ucfg_ipa_reg_rps_enable_cb(struct wlan_objmgr_pdev *pdev,
 				wlan_ipa_rps_enable cb)
@@ -106,6 +106,12 @@ void ucfg_ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 	return ipa_reg_send_to_nw_cb(pdev, cb);
 }
 
+void ucfg_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				     wlan_ipa_send_to_nw_list cb)
+{
+	return ipa_reg_send_to_nw_list_cb(pdev, cb);
+}
+
 #ifdef IPA_LAN_RX_NAPI_SUPPORT
 void ucfg_ipa_reg_rps_enable_cb(struct wlan_objmgr_pdev *pdev,
 				wlan_ipa_rps_enable cb)
@@ -42,11 +42,15 @@
  * @cfg:     cfg items
  * @rso_tx_ops: Roam Tx ops to send roam offload commands to firmware
  * @wfa_testcmd: WFA config tx ops to send to FW
+ * @roam_latency: roam synch propagation latency tracer
  */
 struct wlan_mlme_psoc_ext_obj {
 	struct wlan_mlme_cfg cfg;
 	struct wlan_cm_roam_tx_ops rso_tx_ops;
 	struct wlan_mlme_wfa_cmd wfa_testcmd;
+#ifdef WLAN_ROAM_LATENCY_TRACE
+	struct roam_latency_tracer roam_latency;
+#endif
 };
 
 /**
@@ -1277,6 +1277,8 @@ static void mlme_init_sap_cfg(struct wlan_objmgr_psoc *psoc,
 		cfg_get(psoc, CFG_IS_SAP_BCAST_DEAUTH_ENABLED);
 	sap_cfg->is_6g_sap_fd_enabled =
 		cfg_get(psoc, CFG_6G_SAP_FILS_DISCOVERY_ENABLED);
+	sap_cfg->probe_req_dedup_window =
+		cfg_get(psoc, CFG_SAP_PROBE_REQ_DEDUP_WINDOW);
 }
 
 static void mlme_init_obss_ht40_cfg(struct wlan_objmgr_psoc *psoc,
@@ -1414,6 +1416,8 @@ static void mlme_init_acs_cfg(struct wlan_objmgr_psoc *psoc,
 	acs->is_external_acs_policy =
 		cfg_get(psoc, CFG_EXTERNAL_ACS_POLICY);
 	acs->np_chan_weightage = cfg_get(psoc, CFG_ACS_NP_CHAN_WEIGHT);
+	acs->early_stop_stable_chan =
+		cfg_get(psoc, CFG_ACS_EARLY_STOP_STABLE_CHAN);
 	mlme_acs_parse_weight_list(psoc, acs);
 }
 
@@ -30,6 +30,7 @@
 #include "target_if_cm_roam_offload.h"
 #include "wlan_crypto_global_api.h"
 #include "target_if_wfa_testcmd.h"
+#include "wlan_cm_roam_api.h"
 
 static struct vdev_mlme_ops sta_mlme_ops;
 static struct vdev_mlme_ops ap_mlme_ops;
@@ -1381,6 +1382,40 @@ vdevmgr_vdev_stop_rsp_handle(struct vdev_mlme_obj *vdev_mlme,
 	return wma_vdev_stop_resp_handler(vdev_mlme, rsp);
 }
 
+#ifdef WLAN_ROAM_LATENCY_TRACE
+/**
+ * mlme_roam_latency_init() - initialize the roam latency tracer
+ * @mlme_obj: mlme ext psoc priv object
+ *
+ * Return: None
+ */
+static void mlme_roam_latency_init(struct wlan_mlme_psoc_ext_obj *mlme_obj)
+{
+	cm_roam_latency_init(&mlme_obj->roam_latency);
+}
+
+/**
+ * mlme_roam_latency_deinit() - de-initialize the roam latency tracer
+ * @mlme_obj: mlme ext psoc priv object
+ *
+ * Return: None
+ */
+static void mlme_roam_latency_deinit(struct wlan_mlme_psoc_ext_obj *mlme_obj)
+{
+	cm_roam_latency_deinit(&mlme_obj->roam_latency);
+}
+#else
+static inline void
+mlme_roam_latency_init(struct wlan_mlme_psoc_ext_obj *mlme_obj)
+{
+}
+
+static inline void
+mlme_roam_latency_deinit(struct wlan_mlme_psoc_ext_obj *mlme_obj)
+{
+}
+#endif
+
 /**
  * psoc_mlme_ext_hdl_create() - Create mlme legacy priv object
  * @psoc_mlme: psoc mlme object
@@ -1401,6 +1436,8 @@ QDF_STATUS psoc_mlme_ext_hdl_create(struct psoc_mlme_obj *psoc_mlme)
 	target_if_wfatestcmd_register_tx_ops(
 			&psoc_mlme->ext_psoc_ptr->wfa_testcmd.tx_ops);
 
+	mlme_roam_latency_init(psoc_mlme->ext_psoc_ptr);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -1419,6 +1456,7 @@ QDF_STATUS psoc_mlme_ext_hdl_destroy(struct psoc_mlme_obj *psoc_mlme)
 	}
 
 	if (psoc_mlme->ext_psoc_ptr) {
+		mlme_roam_latency_deinit(psoc_mlme->ext_psoc_ptr);
 		qdf_mem_free(psoc_mlme->ext_psoc_ptr);
 		psoc_mlme->ext_psoc_ptr = NULL;
 	}
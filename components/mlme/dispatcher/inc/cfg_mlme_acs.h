@@ -240,6 +240,35 @@
 		CFG_VALUE_OR_DEFAULT, \
 		"np chan weight")
 
+/*
+ * <ini>
+ * acs_early_stop_stable_chan - Stop the ACS scan once its ranking is stable
+ * @Min: 0
+ * @Max: 64
+ * @Default: 0
+ *
+ * When the ACS channels are scored along with the ACS scan, this ini stops
+ * the scan once the best channel scanned so far did not change over this
+ * number of scanned channels, and at least half of the channels are
+ * scanned. The channels left unscanned are not selected. 0 disables the
+ * early stop.
+ *
+ * Related: None
+ *
+ * Supported Feature: ACS
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_ACS_EARLY_STOP_STABLE_CHAN CFG_INI_UINT( \
+		"acs_early_stop_stable_chan", \
+		0, \
+		64, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, \
+		"ACS early stop stable channels")
+
 #define CFG_ACS_ALL \
 	CFG(CFG_ACS_WITH_MORE_PARAM) \
 	CFG(CFG_AUTO_CHANNEL_SELECT_WEIGHT) \
@@ -248,6 +277,7 @@
 	CFG(CFG_EXTERNAL_ACS_POLICY) \
 	CFG(CFG_NORMALIZE_ACS_WEIGHT) \
 	CFG(CFG_ACS_FORCE_START_SAP) \
-	CFG(CFG_ACS_NP_CHAN_WEIGHT)
+	CFG(CFG_ACS_NP_CHAN_WEIGHT) \
+	CFG(CFG_ACS_EARLY_STOP_STABLE_CHAN)
 
 #endif /* __CFG_MLME_ACS_H */
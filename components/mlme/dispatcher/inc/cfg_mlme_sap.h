@@ -732,6 +732,37 @@
 					1, \
 					"Enable/Disable fils discovery for SAP")
 
+/*
+ * <ini>
+ * sap_probe_req_dedup_window - Window probe requests are deduplicated over
+ * @Min: 0
+ * @Max: 1000
+ * @Default: 0
+ *
+ * This ini is used to set, in milliseconds, the window over which the probe
+ * requests handled by the host for SAP and P2P GO are deduplicated. A probe
+ * request from the same source, for the same SSID, on the same channel and
+ * with or without a P2P IE as one received within the window is dropped
+ * before being parsed or posted to PE. Probe requests received while no
+ * SAP or P2P GO operates on their channel are not deduplicated. 0 disables
+ * the deduplication.
+ *
+ * Related: None
+ *
+ * Supported Feature: SAP
+ *
+ * Usage: Internal/External
+ *
+ * </ini>
+ */
+#define CFG_SAP_PROBE_REQ_DEDUP_WINDOW CFG_INI_UINT( \
+			"sap_probe_req_dedup_window", \
+			0, \
+			1000, \
+			0, \
+			CFG_VALUE_OR_DEFAULT, \
+			"probe request dedup window in ms")
+
 #define CFG_SAP_ALL \
 	CFG_SAP_SAE \
 	CFG(CFG_AP_ENABLE_RANDOM_BSSID) \
@@ -766,6 +797,7 @@
 	CFG(CFG_GO_FORCE_11N_FOR_11AC) \
 	CFG(CFG_GO_11AC_OVERRIDE) \
 	CFG(CFG_IS_SAP_BCAST_DEAUTH_ENABLED) \
-	CFG(CFG_6G_SAP_FILS_DISCOVERY_ENABLED)
+	CFG(CFG_6G_SAP_FILS_DISCOVERY_ENABLED) \
+	CFG(CFG_SAP_PROBE_REQ_DEDUP_WINDOW)
 
 #endif /* __CFG_MLME_SAP_H */
@@ -701,6 +701,8 @@ struct wlan_mlme_wps_params {
  * @sap_sae_enabled: enable sae in sap mode
  * @is_sap_bcast_deauth_enabled: enable bcast deauth for sap
  * @is_6g_sap_fd_enabled: enable fils discovery on sap
+ * @probe_req_dedup_window: window in ms duplicate probe requests are
+ *	dropped over, 0 if disabled
  */
 struct wlan_mlme_cfg_sap {
 	uint8_t cfg_ssid[WLAN_SSID_MAX_LEN];
@@ -738,6 +740,7 @@ struct wlan_mlme_cfg_sap {
 	bool sap_sae_enabled;
 	bool is_sap_bcast_deauth_enabled;
 	bool is_6g_sap_fd_enabled;
+	uint16_t probe_req_dedup_window;
 };
 
 /**
@@ -1316,6 +1319,8 @@ struct acs_weight_range {
  * @force_sap_start: Force SAP start when no channel is found suitable
  * by ACS
  * @np_chan_weightage: Weightage to be given to non preferred channels.
+ * @early_stop_stable_chan: number of scanned channels the best channel has
+ * to hold over for the ACS scan to stop, 0 to never stop it early
  */
 struct wlan_mlme_acs {
 	bool is_acs_with_more_param;
@@ -1329,6 +1334,7 @@ struct wlan_mlme_acs {
 	uint16_t num_weight_range;
 	bool force_sap_start;
 	uint32_t np_chan_weightage;
+	uint8_t early_stop_stable_chan;
 };
 
 /*
@@ -709,6 +709,7 @@ QDF_STATUS p2p_psoc_object_open(struct wlan_objmgr_psoc *soc)
 {
 	QDF_STATUS status;
 	struct p2p_soc_priv_obj *p2p_soc_obj;
+	uint32_t i;
 
 	if (!soc) {
 		p2p_err("psoc context passed is NULL");
@@ -726,6 +727,12 @@ QDF_STATUS p2p_psoc_object_open(struct wlan_objmgr_psoc *soc)
 	qdf_list_create(&p2p_soc_obj->roc_q, MAX_QUEUE_LENGTH);
 	qdf_list_create(&p2p_soc_obj->tx_q_roc, MAX_QUEUE_LENGTH);
 	qdf_list_create(&p2p_soc_obj->tx_q_ack, MAX_QUEUE_LENGTH);
+	for (i = 0; i < P2P_TX_HASH_SIZE; i++) {
+		qdf_list_create(&p2p_soc_obj->tx_cookie_hash[i],
+				2 * MAX_QUEUE_LENGTH);
+		qdf_list_create(&p2p_soc_obj->tx_nbuf_hash[i],
+				MAX_QUEUE_LENGTH);
+	}
 
 	status = qdf_event_create(&p2p_soc_obj->cleanup_roc_done);
 	if (status != QDF_STATUS_SUCCESS) {
@@ -751,6 +758,10 @@ fail_cleanup_tx:
 	qdf_event_destroy(&p2p_soc_obj->cleanup_roc_done);
 
 fail_cleanup_roc:
+	for (i = 0; i < P2P_TX_HASH_SIZE; i++) {
+		qdf_list_destroy(&p2p_soc_obj->tx_nbuf_hash[i]);
+		qdf_list_destroy(&p2p_soc_obj->tx_cookie_hash[i]);
+	}
 	qdf_list_destroy(&p2p_soc_obj->tx_q_ack);
 	qdf_list_destroy(&p2p_soc_obj->tx_q_roc);
 	qdf_list_destroy(&p2p_soc_obj->roc_q);
@@ -761,6 +772,7 @@ fail_cleanup_roc:
 QDF_STATUS p2p_psoc_object_close(struct wlan_objmgr_psoc *soc)
 {
 	struct p2p_soc_priv_obj *p2p_soc_obj;
+	uint32_t i;
 
 	if (!soc) {
 		p2p_err("psoc context passed is NULL");
@@ -778,6 +790,10 @@ QDF_STATUS p2p_psoc_object_close(struct wlan_objmgr_psoc *soc)
 	qdf_runtime_lock_deinit(&p2p_soc_obj->roc_runtime_lock);
 	qdf_event_destroy(&p2p_soc_obj->cleanup_tx_done);
 	qdf_event_destroy(&p2p_soc_obj->cleanup_roc_done);
+	for (i = 0; i < P2P_TX_HASH_SIZE; i++) {
+		qdf_list_destroy(&p2p_soc_obj->tx_nbuf_hash[i]);
+		qdf_list_destroy(&p2p_soc_obj->tx_cookie_hash[i]);
+	}
 	qdf_list_destroy(&p2p_soc_obj->tx_q_ack);
 	qdf_list_destroy(&p2p_soc_obj->tx_q_roc);
 	qdf_list_destroy(&p2p_soc_obj->roc_q);
@@ -37,6 +37,9 @@
 #define P2P_MODULE_NAME  "P2P"
 #define P2P_INVALID_VDEV_ID 0xFFFFFFFF
 #define MAX_RANDOM_MAC_ADDRS 4
+/* Buckets of the tx context indexes */
+#define P2P_TX_HASH_BITS 4
+#define P2P_TX_HASH_SIZE (1 << P2P_TX_HASH_BITS)
 
 #define p2p_debug(params ...) \
 	QDF_TRACE_DEBUG(QDF_MODULE_ID_P2P, params)
@@ -212,6 +215,8 @@ struct p2p_param {
  * @roc_q:            Queue for pending roc requests
  * @tx_q_roc:         Queue for tx frames waiting for RoC
  * @tx_q_ack:         Queue for tx frames waiting for ack
+ * @tx_cookie_hash:   Tx frames of both queues indexed by cookie
+ * @tx_nbuf_hash:     Tx frames waiting for ack indexed by nbuf
  * @scan_req_id:      Scan requestor id
  * @start_param:      Start parameters, include callbacks and user
  *                    data to HDD
@@ -230,6 +235,8 @@ struct p2p_soc_priv_obj {
 	qdf_list_t roc_q;
 	qdf_list_t tx_q_roc;
 	qdf_list_t tx_q_ack;
+	qdf_list_t tx_cookie_hash[P2P_TX_HASH_SIZE];
+	qdf_list_t tx_nbuf_hash[P2P_TX_HASH_SIZE];
 	wlan_scan_requester scan_req_id;
 	struct p2p_start_param *start_param;
 	qdf_event_t cleanup_roc_done;
@@ -1066,6 +1066,112 @@ static QDF_STATUS p2p_mgmt_tx(struct tx_action_context *tx_ctx,
 	return status;
 }
 
+/**
+ * p2p_tx_hash() - bucket of a tx context index
+ * @key: cookie or nbuf
+ *
+ * Return: bucket index
+ */
+static inline uint32_t p2p_tx_hash(uint64_t key)
+{
+	key ^= key >> 32;
+
+	return ((uint32_t)key * 0x9e3779b1) >> (32 - P2P_TX_HASH_BITS);
+}
+
+/**
+ * p2p_tx_q_insert() - queue tx context
+ * @tx_ctx:        tx context
+ * @tx_q:          waiting for roc or waiting for ack queue
+ *
+ * This function queues the tx context and indexes it by cookie, and
+ * also by nbuf once it waits for ack.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_tx_q_insert(struct tx_action_context *tx_ctx,
+				  enum p2p_tx_queue tx_q)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = tx_ctx->p2p_soc_obj;
+	qdf_list_t *queue;
+	qdf_list_t *cookie_bucket;
+	qdf_list_t *nbuf_bucket = NULL;
+	QDF_STATUS status;
+
+	if (tx_q == P2P_TX_Q_ACK) {
+		queue = &p2p_soc_obj->tx_q_ack;
+		nbuf_bucket = &p2p_soc_obj->tx_nbuf_hash[
+				p2p_tx_hash((uintptr_t)tx_ctx->nbuf)];
+	} else {
+		queue = &p2p_soc_obj->tx_q_roc;
+	}
+	cookie_bucket = &p2p_soc_obj->tx_cookie_hash[
+				p2p_tx_hash((uintptr_t)tx_ctx)];
+
+	status = qdf_list_insert_back(queue, &tx_ctx->node);
+	if (status != QDF_STATUS_SUCCESS)
+		return status;
+
+	status = qdf_list_insert_back(cookie_bucket, &tx_ctx->cookie_node);
+	if (status != QDF_STATUS_SUCCESS)
+		goto remove_queue;
+
+	if (nbuf_bucket) {
+		status = qdf_list_insert_back(nbuf_bucket,
+					      &tx_ctx->nbuf_node);
+		if (status != QDF_STATUS_SUCCESS)
+			goto remove_cookie;
+	}
+
+	tx_ctx->tx_q = tx_q;
+
+	return QDF_STATUS_SUCCESS;
+
+remove_cookie:
+	qdf_list_remove_node(cookie_bucket, &tx_ctx->cookie_node);
+remove_queue:
+	qdf_list_remove_node(queue, &tx_ctx->node);
+
+	return status;
+}
+
+/**
+ * p2p_tx_q_remove() - dequeue tx context
+ * @tx_ctx:        tx context
+ *
+ * This function removes the tx context from its queue and indexes.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_tx_q_remove(struct tx_action_context *tx_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = tx_ctx->p2p_soc_obj;
+	qdf_list_t *queue;
+	QDF_STATUS status;
+
+	switch (tx_ctx->tx_q) {
+	case P2P_TX_Q_ROC:
+		queue = &p2p_soc_obj->tx_q_roc;
+		break;
+	case P2P_TX_Q_ACK:
+		queue = &p2p_soc_obj->tx_q_ack;
+		qdf_list_remove_node(&p2p_soc_obj->tx_nbuf_hash[
+				p2p_tx_hash((uintptr_t)tx_ctx->nbuf)],
+				&tx_ctx->nbuf_node);
+		break;
+	default:
+		return QDF_STATUS_E_NOENT;
+	}
+
+	qdf_list_remove_node(&p2p_soc_obj->tx_cookie_hash[
+				p2p_tx_hash((uintptr_t)tx_ctx)],
+			     &tx_ctx->cookie_node);
+	status = qdf_list_remove_node(queue, &tx_ctx->node);
+	tx_ctx->tx_q = P2P_TX_Q_NONE;
+
+	return status;
+}
+
 /**
  * p2p_roc_req_for_tx_action() - new a roc request for tx
  * @tx_ctx:        tx context
@@ -1106,8 +1212,7 @@ static QDF_STATUS p2p_roc_req_for_tx_action(
 		return status;
 	}
 
-	status = qdf_list_insert_back(&p2p_soc_obj->tx_q_roc,
-		&tx_ctx->node);
+	status = p2p_tx_q_insert(tx_ctx, P2P_TX_Q_ROC);
 	if (status != QDF_STATUS_SUCCESS)
 		p2p_err("Failed to insert off chan tx context to wait roc req queue");
 
@@ -1130,6 +1235,7 @@ static struct tx_action_context *p2p_find_tx_ctx(
 	bool *is_roc_q, bool *is_ack_q)
 {
 	struct tx_action_context *cur_tx_ctx;
+	qdf_list_t *bucket;
 	qdf_list_node_t *p_node;
 	QDF_STATUS status;
 	*is_roc_q = false;
@@ -1138,67 +1244,51 @@ static struct tx_action_context *p2p_find_tx_ctx(
 	p2p_debug("Start to find tx ctx, p2p soc_obj:%pK, cookie:%llx",
 		p2p_soc_obj, cookie);
 
-	status = qdf_list_peek_front(&p2p_soc_obj->tx_q_roc, &p_node);
-	while (QDF_IS_STATUS_SUCCESS(status)) {
-		cur_tx_ctx = qdf_container_of(p_node,
-				struct tx_action_context, node);
-		if ((uintptr_t) cur_tx_ctx == cookie) {
-			*is_roc_q = true;
-			p2p_debug("find tx ctx, cookie:%llx", cookie);
-			return cur_tx_ctx;
-		}
-		status = qdf_list_peek_next(&p2p_soc_obj->tx_q_roc,
-						p_node, &p_node);
-	}
-
-	status = qdf_list_peek_front(&p2p_soc_obj->tx_q_ack, &p_node);
+	bucket = &p2p_soc_obj->tx_cookie_hash[p2p_tx_hash(cookie)];
+	status = qdf_list_peek_front(bucket, &p_node);
 	while (QDF_IS_STATUS_SUCCESS(status)) {
 		cur_tx_ctx = qdf_container_of(p_node,
-				struct tx_action_context, node);
+				struct tx_action_context, cookie_node);
 		if ((uintptr_t) cur_tx_ctx == cookie) {
-			*is_ack_q = true;
+			*is_roc_q = cur_tx_ctx->tx_q == P2P_TX_Q_ROC;
+			*is_ack_q = cur_tx_ctx->tx_q == P2P_TX_Q_ACK;
 			p2p_debug("find tx ctx, cookie:%llx", cookie);
 			return cur_tx_ctx;
 		}
-		status = qdf_list_peek_next(&p2p_soc_obj->tx_q_ack,
-						p_node, &p_node);
+		status = qdf_list_peek_next(bucket, p_node, &p_node);
 	}
 
 	return NULL;
 }
 
 /**
- * p2p_find_tx_ctx_by_roc() - find tx context by roc
+ * p2p_roc_tx_count() - count tx contexts waiting for a roc
  * @p2p_soc_obj:        p2p soc object
  * @cookie:          cookie to roc context
  *
- * This function finds out tx context by roc context.
+ * This function counts the frames batched on a roc context.
  *
- * Return: pointer to tx context
+ * Return: number of tx contexts
  */
-static struct tx_action_context *p2p_find_tx_ctx_by_roc(
+static uint32_t p2p_roc_tx_count(
 	struct p2p_soc_priv_obj *p2p_soc_obj, uint64_t cookie)
 {
 	struct tx_action_context *cur_tx_ctx;
 	qdf_list_node_t *p_node;
 	QDF_STATUS status;
-
-	p2p_debug("Start to find tx ctx, p2p soc_obj:%pK, cookie:%llx",
-		p2p_soc_obj, cookie);
+	uint32_t count = 0;
 
 	status = qdf_list_peek_front(&p2p_soc_obj->tx_q_roc, &p_node);
 	while (QDF_IS_STATUS_SUCCESS(status)) {
 		cur_tx_ctx = qdf_container_of(p_node,
 					struct tx_action_context, node);
-		if (cur_tx_ctx->roc_cookie == cookie) {
-			p2p_debug("find tx ctx, cookie:%llx", cookie);
-			return cur_tx_ctx;
-		}
+		if (cur_tx_ctx->roc_cookie == cookie)
+			count++;
 		status = qdf_list_peek_next(&p2p_soc_obj->tx_q_roc,
 						p_node, &p_node);
 	}
 
-	return NULL;
+	return count;
 }
 
 /**
@@ -1212,33 +1302,21 @@ static struct tx_action_context *p2p_find_tx_ctx_by_roc(
 static QDF_STATUS p2p_move_tx_context_to_ack_queue(
 	struct tx_action_context *tx_ctx)
 {
-	bool is_roc_q = false;
-	bool is_ack_q = false;
-	struct p2p_soc_priv_obj *p2p_soc_obj = tx_ctx->p2p_soc_obj;
-	struct tx_action_context *cur_tx_ctx;
 	QDF_STATUS status;
 
-	cur_tx_ctx = p2p_find_tx_ctx(p2p_soc_obj, (uintptr_t)tx_ctx,
-					&is_roc_q, &is_ack_q);
-	if (cur_tx_ctx) {
-		if (is_roc_q) {
-			p2p_debug("find in wait for roc queue");
-			status = qdf_list_remove_node(
-				&p2p_soc_obj->tx_q_roc,
-				(qdf_list_node_t *)tx_ctx);
-			if (status != QDF_STATUS_SUCCESS)
-				p2p_err("Failed to remove off chan tx context from wait roc req queue");
-		}
+	if (tx_ctx->tx_q == P2P_TX_Q_ACK) {
+		p2p_debug("Already in waiting for ack queue");
+		return QDF_STATUS_SUCCESS;
+	}
 
-		if (is_ack_q) {
-			p2p_debug("Already in waiting for ack queue");
-			return QDF_STATUS_SUCCESS;
-		}
+	if (tx_ctx->tx_q == P2P_TX_Q_ROC) {
+		p2p_debug("find in wait for roc queue");
+		status = p2p_tx_q_remove(tx_ctx);
+		if (status != QDF_STATUS_SUCCESS)
+			p2p_err("Failed to remove off chan tx context from wait roc req queue");
 	}
 
-	status = qdf_list_insert_back(
-				&p2p_soc_obj->tx_q_ack,
-				&tx_ctx->node);
+	status = p2p_tx_q_insert(tx_ctx, P2P_TX_Q_ACK);
 	if (status != QDF_STATUS_SUCCESS)
 		p2p_err("Failed to insert off chan tx context to wait ack req queue");
 
@@ -1247,6 +1325,28 @@ static QDF_STATUS p2p_move_tx_context_to_ack_queue(
 
 /**
  * p2p_extend_roc_timer() - extend roc timer
+ * @roc_ctx:       roc context
+ * @extend_time:   time to stay on channel
+ *
+ * This function updates the roc duration. The roc timer is restarted
+ * with it if the roc is on channel, otherwise the timer starts with it
+ * once on channel.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_extend_roc_timer(struct p2p_roc_context *roc_ctx,
+				       uint32_t extend_time)
+{
+	p2p_debug("extend roc timer, duration:%d", extend_time);
+	roc_ctx->duration = extend_time;
+	if (roc_ctx->roc_state != ROC_STATE_ON_CHAN)
+		return QDF_STATUS_SUCCESS;
+
+	return p2p_restart_roc_timer(roc_ctx);
+}
+
+/**
+ * p2p_extend_roc_for_rx() - extend roc timer for rx frame
  * @p2p_soc_obj:   p2p soc private object
  * @frame_info:    pointer to frame information
  *
@@ -1254,7 +1354,7 @@ static QDF_STATUS p2p_move_tx_context_to_ack_queue(
  *
  * Return: QDF_STATUS_SUCCESS - in case of success
  */
-static QDF_STATUS p2p_extend_roc_timer(
+static QDF_STATUS p2p_extend_roc_for_rx(
 	struct p2p_soc_priv_obj *p2p_soc_obj,
 	struct p2p_frame_info *frame_info)
 {
@@ -1286,11 +1386,8 @@ static QDF_STATUS p2p_extend_roc_timer(
 		break;
 	}
 
-	if (extend_time) {
-		p2p_debug("extend roc timer, duration:%d", extend_time);
-		curr_roc_ctx->duration = extend_time;
-		return p2p_restart_roc_timer(curr_roc_ctx);
-	}
+	if (extend_time)
+		return p2p_extend_roc_timer(curr_roc_ctx, extend_time);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -1352,21 +1449,10 @@ static QDF_STATUS p2p_remove_tx_context(
 		goto end;
 	}
 
-	if (is_roc_q) {
-		status = qdf_list_remove_node(
-			&p2p_soc_obj->tx_q_roc,
-			(qdf_list_node_t *)cur_tx_ctx);
-		if (status != QDF_STATUS_SUCCESS)
-			p2p_err("Failed to  tx context from wait roc req queue");
-	}
-
-	if (is_ack_q) {
-		status = qdf_list_remove_node(
-			&p2p_soc_obj->tx_q_ack,
-			(qdf_list_node_t *)cur_tx_ctx);
-		if (status != QDF_STATUS_SUCCESS)
-			p2p_err("Failed to  tx context from wait ack req queue");
-	}
+	status = p2p_tx_q_remove(cur_tx_ctx);
+	if (status != QDF_STATUS_SUCCESS)
+		p2p_err("Failed to remove tx context from %s queue",
+			is_roc_q ? "wait roc req" : "wait ack req");
 
 end:
 	if (!tx_ctx->roc_cookie)
@@ -1407,8 +1493,7 @@ static void p2p_tx_timeout(void *pdata)
 					    p_node, &p_node);
 		if (QDF_TIMER_STATE_STOPPED ==
 		    qdf_mc_timer_get_current_state(&tx_ctx->tx_timer)) {
-			ret = qdf_list_remove_node(&p2p_soc_obj->tx_q_ack,
-						   &tx_ctx->node);
+			ret = p2p_tx_q_remove(tx_ctx);
 			if (ret == QDF_STATUS_SUCCESS) {
 				qdf_mc_timer_destroy(&tx_ctx->tx_timer);
 				p2p_send_tx_conf(tx_ctx, false);
@@ -1724,10 +1809,93 @@ static QDF_STATUS p2p_execute_tx_action_frame(
 	return status;
 }
 
+/**
+ * p2p_add_tx_to_roc() - batch off channel tx on a roc
+ * @roc_ctx:       roc context on the channel of the frame
+ * @tx_ctx:        tx context
+ *
+ * This function queues the frame until the roc is on channel. A roc
+ * requested for off channel tx is extended to cover the wait of every
+ * frame of the batch, a user requested roc keeps its duration.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_add_tx_to_roc(struct p2p_roc_context *roc_ctx,
+				    struct tx_action_context *tx_ctx)
+{
+	QDF_STATUS status;
+
+	tx_ctx->roc_cookie = (uintptr_t)roc_ctx;
+	status = p2p_tx_q_insert(tx_ctx, P2P_TX_Q_ROC);
+	if (status != QDF_STATUS_SUCCESS) {
+		p2p_err("Failed to insert off chan tx context to wait roc req queue");
+		return status;
+	}
+
+	if (roc_ctx->roc_type == OFF_CHANNEL_TX) {
+		p2p_adjust_tx_wait(tx_ctx);
+		if (tx_ctx->duration > roc_ctx->duration)
+			p2p_extend_roc_timer(roc_ctx, tx_ctx->duration);
+	}
+
+	p2p_debug("tx ctx:%pK batched on roc ctx:%pK, chan:%d, duration:%d",
+		  tx_ctx, roc_ctx, roc_ctx->chan, roc_ctx->duration);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * p2p_schedule_off_chan_tx() - schedule off channel tx
+ * @tx_ctx:        tx context
+ *
+ * This function groups off channel frames by channel, so that a burst
+ * of action frames pays a single channel switch. A frame for the channel
+ * of the roc in progress joins it or is sent right away if the roc is on
+ * channel, a frame for the channel of a queued roc joins that roc, and
+ * only the first frame for a channel requests a new roc.
+ *
+ * Return: QDF_STATUS_SUCCESS - in case of success
+ */
+static QDF_STATUS p2p_schedule_off_chan_tx(struct tx_action_context *tx_ctx)
+{
+	struct p2p_soc_priv_obj *p2p_soc_obj = tx_ctx->p2p_soc_obj;
+	struct p2p_roc_context *curr_roc_ctx;
+	QDF_STATUS status;
+
+	curr_roc_ctx = p2p_find_current_roc_ctx(p2p_soc_obj);
+	if (curr_roc_ctx && (curr_roc_ctx->chan == tx_ctx->chan)) {
+		switch (curr_roc_ctx->roc_state) {
+		case ROC_STATE_REQUESTED:
+		case ROC_STATE_STARTED:
+			return p2p_add_tx_to_roc(curr_roc_ctx, tx_ctx);
+		case ROC_STATE_ON_CHAN:
+			p2p_adjust_tx_wait(tx_ctx);
+			status = p2p_extend_roc_timer(curr_roc_ctx,
+					qdf_max(curr_roc_ctx->duration,
+						tx_ctx->duration));
+			curr_roc_ctx->tx_ctx = tx_ctx;
+			if (status != QDF_STATUS_SUCCESS) {
+				p2p_err("restart roc timer fail");
+				return status;
+			}
+			return p2p_execute_tx_action_frame(tx_ctx);
+		default:
+			break;
+		}
+	}
+
+	curr_roc_ctx = p2p_find_roc_by_chan(p2p_soc_obj, tx_ctx->chan);
+	if (curr_roc_ctx && (curr_roc_ctx->roc_state == ROC_STATE_IDLE))
+		return p2p_add_tx_to_roc(curr_roc_ctx, tx_ctx);
+
+	return p2p_roc_req_for_tx_action(tx_ctx);
+}
+
 struct tx_action_context *p2p_find_tx_ctx_by_nbuf(
 	struct p2p_soc_priv_obj *p2p_soc_obj, void *nbuf)
 {
 	struct tx_action_context *cur_tx_ctx;
+	qdf_list_t *bucket;
 	qdf_list_node_t *p_node;
 	QDF_STATUS status;
 
@@ -1736,16 +1904,17 @@ struct tx_action_context *p2p_find_tx_ctx_by_nbuf(
 		return NULL;
 	}
 
-	status = qdf_list_peek_front(&p2p_soc_obj->tx_q_ack, &p_node);
+	bucket = &p2p_soc_obj->tx_nbuf_hash[p2p_tx_hash((uintptr_t)nbuf)];
+	status = qdf_list_peek_front(bucket, &p_node);
 	while (QDF_IS_STATUS_SUCCESS(status)) {
-		cur_tx_ctx =
-			qdf_container_of(p_node, struct tx_action_context, node);
+		cur_tx_ctx = qdf_container_of(p_node,
+					      struct tx_action_context,
+					      nbuf_node);
 		if (cur_tx_ctx->nbuf == nbuf) {
 			p2p_debug("find tx ctx, nbuf:%pK", nbuf);
 			return cur_tx_ctx;
 		}
-		status = qdf_list_peek_next(&p2p_soc_obj->tx_q_ack,
-						p_node, &p_node);
+		status = qdf_list_peek_next(bucket, p_node, &p_node);
 	}
 
 	return NULL;
@@ -1799,23 +1968,54 @@ QDF_STATUS p2p_ready_to_tx_frame(struct p2p_soc_priv_obj *p2p_soc_obj,
 	uint64_t cookie)
 {
 	struct tx_action_context *cur_tx_ctx;
+	qdf_list_node_t *p_node;
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	QDF_STATUS ret;
 
-	cur_tx_ctx = p2p_find_tx_ctx_by_roc(p2p_soc_obj, cookie);
+	/* the whole batch goes out as soon as the roc is on channel */
+	ret = qdf_list_peek_front(&p2p_soc_obj->tx_q_roc, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(ret)) {
+		cur_tx_ctx = qdf_container_of(p_node,
+					struct tx_action_context, node);
+		ret = qdf_list_peek_next(&p2p_soc_obj->tx_q_roc,
+					 p_node, &p_node);
+		if (cur_tx_ctx->roc_cookie != cookie)
+			continue;
 
-	while (cur_tx_ctx) {
 		p2p_debug("tx_ctx:%pK", cur_tx_ctx);
 		status = p2p_execute_tx_action_frame(cur_tx_ctx);
 		if (status != QDF_STATUS_SUCCESS) {
 			p2p_send_tx_conf(cur_tx_ctx, false);
 			p2p_remove_tx_context(cur_tx_ctx);
 		}
-		cur_tx_ctx = p2p_find_tx_ctx_by_roc(p2p_soc_obj, cookie);
 	}
 
 	return status;
 }
 
+void p2p_abort_tx_for_roc(struct p2p_soc_priv_obj *p2p_soc_obj,
+			  uint64_t cookie)
+{
+	struct tx_action_context *cur_tx_ctx;
+	qdf_list_node_t *p_node;
+	QDF_STATUS status;
+
+	status = qdf_list_peek_front(&p2p_soc_obj->tx_q_roc, &p_node);
+	while (QDF_IS_STATUS_SUCCESS(status)) {
+		cur_tx_ctx = qdf_container_of(p_node,
+					struct tx_action_context, node);
+		status = qdf_list_peek_next(&p2p_soc_obj->tx_q_roc,
+					    p_node, &p_node);
+		if (cur_tx_ctx->roc_cookie != cookie)
+			continue;
+
+		p2p_debug("roc %llx ended before tx, tx_ctx:%pK",
+			  cookie, cur_tx_ctx);
+		p2p_send_tx_conf(cur_tx_ctx, false);
+		p2p_remove_tx_context(cur_tx_ctx);
+	}
+}
+
 QDF_STATUS p2p_cleanup_tx_sync(
 	struct p2p_soc_priv_obj *p2p_soc_obj,
 	struct wlan_objmgr_vdev *vdev)
@@ -1890,8 +2090,7 @@ QDF_STATUS p2p_process_cleanup_tx_queue(struct p2p_cleanup_param *param)
 					    p_node, &p_node);
 		if ((vdev_id == P2P_INVALID_VDEV_ID) ||
 		    (vdev_id == curr_tx_ctx->vdev_id)) {
-			ret = qdf_list_remove_node(&p2p_soc_obj->tx_q_roc,
-						   &curr_tx_ctx->node);
+			ret = p2p_tx_q_remove(curr_tx_ctx);
 			if (ret == QDF_STATUS_SUCCESS) {
 				p2p_send_tx_conf(curr_tx_ctx, false);
 				qdf_mem_free(curr_tx_ctx->buf);
@@ -1913,8 +2112,7 @@ QDF_STATUS p2p_process_cleanup_tx_queue(struct p2p_cleanup_param *param)
 					    p_node, &p_node);
 		if ((vdev_id == P2P_INVALID_VDEV_ID) ||
 		    (vdev_id == curr_tx_ctx->vdev_id)) {
-			ret = qdf_list_remove_node(&p2p_soc_obj->tx_q_ack,
-						   &curr_tx_ctx->node);
+			ret = p2p_tx_q_remove(curr_tx_ctx);
 			if (ret == QDF_STATUS_SUCCESS) {
 				p2p_disable_tx_timer(curr_tx_ctx);
 				p2p_send_tx_conf(curr_tx_ctx, false);
@@ -2788,7 +2986,6 @@ void p2p_deinit_random_mac_vdev(struct p2p_vdev_priv_obj *p2p_vdev_obj)
 QDF_STATUS p2p_process_mgmt_tx(struct tx_action_context *tx_ctx)
 {
 	struct p2p_soc_priv_obj *p2p_soc_obj;
-	struct p2p_roc_context *curr_roc_ctx;
 	uint8_t *mac_to;
 	QDF_STATUS status;
 
@@ -2852,58 +3049,14 @@ QDF_STATUS p2p_process_mgmt_tx(struct tx_action_context *tx_ctx)
 	}
 
 	/* For off channel tx case */
-	curr_roc_ctx = p2p_find_current_roc_ctx(p2p_soc_obj);
-	if (curr_roc_ctx && (curr_roc_ctx->chan == tx_ctx->chan)) {
-		if ((curr_roc_ctx->roc_state == ROC_STATE_REQUESTED) ||
-		    (curr_roc_ctx->roc_state == ROC_STATE_STARTED)) {
-			tx_ctx->roc_cookie = (uintptr_t)curr_roc_ctx;
-			status = qdf_list_insert_back(
-					&p2p_soc_obj->tx_q_roc,
-					&tx_ctx->node);
-			if (status != QDF_STATUS_SUCCESS) {
-				p2p_err("Failed to insert off chan tx context to wait roc req queue");
-				goto fail;
-			} else
-				return QDF_STATUS_SUCCESS;
-		} else if (curr_roc_ctx->roc_state == ROC_STATE_ON_CHAN) {
-			p2p_adjust_tx_wait(tx_ctx);
-			status = p2p_restart_roc_timer(curr_roc_ctx);
-			curr_roc_ctx->tx_ctx = tx_ctx;
-			if (status != QDF_STATUS_SUCCESS) {
-				p2p_err("restart roc timer fail");
-				goto fail;
-			}
-			status = p2p_execute_tx_action_frame(tx_ctx);
-			if (status != QDF_STATUS_SUCCESS) {
-				p2p_err("execute tx fail");
-				goto fail;
-			} else
-				return QDF_STATUS_SUCCESS;
-		}
-	}
-
-	curr_roc_ctx = p2p_find_roc_by_chan(p2p_soc_obj, tx_ctx->chan);
-	if (curr_roc_ctx && (curr_roc_ctx->roc_state == ROC_STATE_IDLE)) {
-		tx_ctx->roc_cookie = (uintptr_t)curr_roc_ctx;
-		status = qdf_list_insert_back(
-				&p2p_soc_obj->tx_q_roc,
-				&tx_ctx->node);
-		if (status != QDF_STATUS_SUCCESS) {
-			p2p_err("Failed to insert off chan tx context to wait roc req queue");
-			goto fail;
-		} else {
-			return QDF_STATUS_SUCCESS;
-		}
-	}
-
 	if (!tx_ctx->duration) {
 		tx_ctx->duration = P2P_ACTION_FRAME_DEFAULT_WAIT;
 		p2p_debug("use default wait %d",
 			  P2P_ACTION_FRAME_DEFAULT_WAIT);
 	}
-	status = p2p_roc_req_for_tx_action(tx_ctx);
+	status = p2p_schedule_off_chan_tx(tx_ctx);
 	if (status != QDF_STATUS_SUCCESS) {
-		p2p_err("Failed to request roc before off chan tx");
+		p2p_err("Failed to schedule off chan tx");
 		goto fail;
 	}
 
@@ -2941,6 +3094,13 @@ QDF_STATUS p2p_process_mgmt_tx_cancel(
 			cancel_roc.cookie =
 					cur_tx_ctx->roc_cookie;
 			p2p_remove_tx_context(cur_tx_ctx);
+			/* keep the roc for the rest of the batch */
+			if (p2p_roc_tx_count(cancel_tx->p2p_soc_obj,
+					     cancel_roc.cookie)) {
+				p2p_debug("roc %llx still has tx pending",
+					  cancel_roc.cookie);
+				return QDF_STATUS_SUCCESS;
+			}
 			return p2p_process_cancel_roc_req(&cancel_roc);
 		}
 		if (is_ack_q) {
@@ -3065,7 +3225,7 @@ QDF_STATUS p2p_process_rx_mgmt(
 			return QDF_STATUS_SUCCESS;
 		} else {
 			p2p_debug("p2p frame, extend roc accordingly");
-			p2p_extend_roc_timer(p2p_soc_obj, &frame_info);
+			p2p_extend_roc_for_rx(p2p_soc_obj, &frame_info);
 		}
 	}
 
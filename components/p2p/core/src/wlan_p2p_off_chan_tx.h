@@ -148,9 +148,24 @@ struct p2p_frame_info {
 	enum p2p_action_type action_type;
 };
 
+/**
+ * enum p2p_tx_queue - queue a tx action frame context is in
+ * @P2P_TX_Q_NONE: not queued
+ * @P2P_TX_Q_ROC:  waiting for roc
+ * @P2P_TX_Q_ACK:  waiting for ack
+ */
+enum p2p_tx_queue {
+	P2P_TX_Q_NONE = 0,
+	P2P_TX_Q_ROC,
+	P2P_TX_Q_ACK,
+};
+
 /**
  * struct tx_action_context - tx action frame context
  * @node:           Node for next element in the list
+ * @cookie_node:    Node in the cookie index
+ * @nbuf_node:      Node in the nbuf index
+ * @tx_q:           Queue this context is in
  * @p2p_soc_obj:    Pointer to SoC global p2p private object
  * @vdev_id:        Vdev id on which this request has come
  * @scan_id:        Scan id given by scan component for this roc req
@@ -165,9 +180,13 @@ struct p2p_frame_info {
  * @duration:       Duration for the RoC
  * @tx_timer:       RoC timer
  * @frame_info:     Frame type information
+ * @nbuf:           Frame handed to the target, if any
  */
 struct tx_action_context {
 	qdf_list_node_t node;
+	qdf_list_node_t cookie_node;
+	qdf_list_node_t nbuf_node;
+	enum p2p_tx_queue tx_q;
 	struct p2p_soc_priv_obj *p2p_soc_obj;
 	int vdev_id;
 	int scan_id;
@@ -251,6 +270,19 @@ void p2p_dump_tx_queue(struct p2p_soc_priv_obj *p2p_soc_obj);
 QDF_STATUS p2p_ready_to_tx_frame(struct p2p_soc_priv_obj *p2p_soc_obj,
 	uint64_t cookie);
 
+/**
+ * p2p_abort_tx_for_roc() - fail the tx frames waiting for a roc
+ * @p2p_soc_obj: p2p soc private object
+ * @cookie: cookie is pointer to roc
+ *
+ * This function completes the frames queued to a roc which ends without
+ * going on channel, so that they do not wait for a cleanup.
+ *
+ * Return: None
+ */
+void p2p_abort_tx_for_roc(struct p2p_soc_priv_obj *p2p_soc_obj,
+			  uint64_t cookie);
+
 /**
  * p2p_cleanup_tx_sync() - Cleanup tx queue
  * @p2p_soc_obj: p2p psoc private object
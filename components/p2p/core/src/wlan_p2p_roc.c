@@ -272,6 +272,9 @@ static QDF_STATUS p2p_destroy_roc_ctx(struct p2p_roc_context *roc_ctx,
 			p2p_err("Failed to remove roc req, status %d", status);
 	}
 
+	/* frames batched on a roc which never got on channel */
+	p2p_abort_tx_for_roc(p2p_soc_obj, (uintptr_t)roc_ctx);
+
 	qdf_idr_remove(&p2p_soc_obj->p2p_idr, roc_ctx->id);
 	qdf_mem_free(roc_ctx);
 
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: Declare private API which shall be used internally only
+ * in pkt_capture component. This file shall include prototypes of
+ * the capture filter which is evaluated before captured frames are
+ * copied and handed over to the mon thread.
+ *
+ * Note: This API should be never accessed out of pkt_capture component.
+ */
+
+#ifndef _WLAN_PKT_CAPTURE_FILTER_H_
+#define _WLAN_PKT_CAPTURE_FILTER_H_
+
+#include <qdf_types.h>
+#include "wlan_pkt_capture_priv.h"
+
+/**
+ * pkt_capture_filter_init() - initialize packet capture filter
+ * @filter: pointer to filter context
+ *
+ * Return: None
+ */
+void pkt_capture_filter_init(struct pkt_capture_filter *filter);
+
+/**
+ * pkt_capture_filter_deinit() - de-initialize packet capture filter
+ * @filter: pointer to filter context
+ *
+ * Return: None
+ */
+void pkt_capture_filter_deinit(struct pkt_capture_filter *filter);
+
+/**
+ * pkt_capture_filter_add_rule() - add a capture filter rule
+ * @vdev: pointer to vdev object
+ * @rule: rule to be added
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pkt_capture_filter_add_rule(struct wlan_objmgr_vdev *vdev,
+				       struct pkt_capture_filter_rule *rule);
+
+/**
+ * pkt_capture_filter_clear_rules() - remove all capture filter rules
+ * @vdev: pointer to vdev object
+ *
+ * Once all rules are removed every frame is captured again.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pkt_capture_filter_clear_rules(struct wlan_objmgr_vdev *vdev);
+
+/**
+ * pkt_capture_filter_get_stats() - get capture filter statistics
+ * @vdev: pointer to vdev object
+ * @num_rules: number of installed rules, filled by this API
+ * @stats: filter statistics, filled by this API
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pkt_capture_filter_get_stats(struct wlan_objmgr_vdev *vdev,
+					uint8_t *num_rules,
+					struct pkt_capture_filter_stats *stats);
+
+/**
+ * pkt_capture_filter_8023_frame() - run capture filter on a 802.3 frame
+ * @data: start of the ethernet header
+ * @len: length of the frame
+ * @peer_mac: mac address of the peer the frame is exchanged with
+ * @snaplen: number of bytes to capture, 0 for full frame
+ *
+ * This API is called before the frame is copied for packet capture, so
+ * that frames nobody is interested in are never copied.
+ *
+ * Return: true if the frame needs to be captured, false otherwise
+ */
+bool pkt_capture_filter_8023_frame(uint8_t *data, uint32_t len,
+				   uint8_t *peer_mac, uint32_t *snaplen);
+
+/**
+ * pkt_capture_filter_80211_frame() - run capture filter on a 802.11 frame
+ * @data: start of the 802.11 header
+ * @len: length of the frame
+ * @snaplen: number of bytes to capture, 0 for full frame
+ *
+ * Return: true if the frame needs to be captured, false otherwise
+ */
+bool pkt_capture_filter_80211_frame(uint8_t *data, uint32_t len,
+				    uint32_t *snaplen);
+
+/**
+ * pkt_capture_filter_copy_len() - get number of bytes to be copied
+ * @len: length of the frame
+ * @snaplen: snaplen returned by the capture filter
+ *
+ * Return: number of bytes of the frame to be copied
+ */
+static inline uint32_t pkt_capture_filter_copy_len(uint32_t len,
+						   uint32_t snaplen)
+{
+	if (snaplen && snaplen < len)
+		return snaplen;
+
+	return len;
+}
+#endif /* _WLAN_PKT_CAPTURE_FILTER_H_ */
@@ -51,6 +51,20 @@ struct pkt_capture_cb_context {
 	enum pkt_capture_mode pkt_capture_mode;
 };
 
+/**
+ * struct pkt_capture_filter - packet capture filter context
+ * @lock: lock protecting the rules and the statistics
+ * @num_rules: number of valid entries in @rules
+ * @rules: capture filter rules, evaluated in order
+ * @stats: filter statistics
+ */
+struct pkt_capture_filter {
+	qdf_spinlock_t lock;
+	uint8_t num_rules;
+	struct pkt_capture_filter_rule rules[PKT_CAPTURE_FILTER_MAX_RULES];
+	struct pkt_capture_filter_stats stats;
+};
+
 /**
  * struct pkt_capture_vdev_priv - Private object to be stored in vdev
  * @vdev: pointer to vdev object
@@ -58,6 +72,7 @@ struct pkt_capture_cb_context {
  * @cb_ctx: pointer to packet capture mon callback context
  * @rx_ops: rx ops
  * @tx_ops: tx ops
+ * @filter: capture filter applied before frames are copied
  */
 struct pkt_capture_vdev_priv {
 	struct wlan_objmgr_vdev *vdev;
@@ -65,6 +80,7 @@ struct pkt_capture_vdev_priv {
 	struct pkt_capture_cb_context *cb_ctx;
 	struct wlan_pkt_capture_rx_ops rx_ops;
 	struct wlan_pkt_capture_tx_ops tx_ops;
+	struct pkt_capture_filter filter;
 };
 
 /**
@@ -23,6 +23,7 @@
 
 #include <wlan_pkt_capture_data_txrx.h>
 #include <wlan_pkt_capture_main.h>
+#include <wlan_pkt_capture_filter.h>
 #include <enet.h>
 #include <wlan_reg_services_api.h>
 #include <cds_ieee80211_common.h>
@@ -377,13 +378,29 @@ void pkt_capture_msdu_process_pkts(
 {
 	qdf_nbuf_t loop_msdu, pktcapture_msdu;
 	qdf_nbuf_t msdu, prev = NULL;
+	uint32_t snaplen, len;
 
 	pktcapture_msdu = NULL;
 	loop_msdu = head_msdu;
 	while (loop_msdu) {
+		len = qdf_nbuf_len(loop_msdu);
+		if (!pkt_capture_filter_8023_frame(qdf_nbuf_data(loop_msdu),
+						   len, bssid, &snaplen)) {
+			loop_msdu = qdf_nbuf_next(loop_msdu);
+			continue;
+		}
+
 		msdu = qdf_nbuf_copy(loop_msdu);
 
 		if (msdu) {
+			/*
+			 * The rx descriptor is looked up relative to the
+			 * head of the buffer, so the copy has to keep the
+			 * original layout; truncate it afterwards instead.
+			 */
+			qdf_nbuf_trim_tail(msdu,
+					   len - pkt_capture_filter_copy_len(
+							len, snaplen));
 			qdf_nbuf_push_head(msdu,
 					   HTT_RX_STD_DESC_RESERVATION);
 			qdf_nbuf_set_next(msdu, NULL);
@@ -821,8 +838,11 @@ void pkt_capture_offload_deliver_indication_handler(
 	bool pkt_format;
 	u_int32_t *msg_word = (u_int32_t *)msg;
 	u_int8_t *buf = (u_int8_t *)msg;
+	u_int8_t *mpdu;
 	struct htt_tx_data_hdr_information *txhdr;
 	struct htt_tx_offload_deliver_ind_hdr_t *offload_deliver_msg;
+	uint32_t snaplen;
+	bool capture;
 
 	offload_deliver_msg = (struct htt_tx_offload_deliver_ind_hdr_t *)msg;
 
@@ -830,6 +850,18 @@ void pkt_capture_offload_deliver_indication_handler(
 		(msg_word + 1);
 
 	nbuf_len = offload_deliver_msg->tx_mpdu_bytes;
+	mpdu = buf + sizeof(struct htt_tx_offload_deliver_ind_hdr_t);
+
+	if (offload_deliver_msg->format == TXRX_PKTCAPTURE_PKT_FORMAT_8023)
+		capture = pkt_capture_filter_8023_frame(mpdu, nbuf_len,
+							bssid, &snaplen);
+	else
+		capture = pkt_capture_filter_80211_frame(mpdu, nbuf_len,
+							 &snaplen);
+	if (!capture)
+		return;
+
+	nbuf_len = pkt_capture_filter_copy_len(nbuf_len, snaplen);
 
 	netbuf = qdf_nbuf_alloc(NULL,
 				roundup(nbuf_len + RESERVE_BYTES, 4),
@@ -840,9 +872,7 @@ void pkt_capture_offload_deliver_indication_handler(
 
 	qdf_nbuf_put_tail(netbuf, nbuf_len);
 
-	qdf_mem_copy(qdf_nbuf_data(netbuf),
-		     buf + sizeof(struct htt_tx_offload_deliver_ind_hdr_t),
-		     nbuf_len);
+	qdf_mem_copy(qdf_nbuf_data(netbuf), mpdu, nbuf_len);
 
 	qdf_nbuf_push_head(
 			netbuf,
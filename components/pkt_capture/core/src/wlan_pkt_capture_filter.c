@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: Implement the packet capture filter. The filter is evaluated on
+ * the original frame before it is copied for packet capture, so frames
+ * which do not match any rule cost only a header parse.
+ */
+
+#include "wlan_pkt_capture_main.h"
+#include "wlan_pkt_capture_filter.h"
+#include <enet.h>
+#include <cds_ieee80211_common.h>
+
+#define PKT_CAPTURE_FRAME_TYPE_DATA	(2)
+
+#define PKT_CAPTURE_80211_HDR_LEN	(24)
+#define PKT_CAPTURE_80211_ADDR4_LEN	(6)
+#define PKT_CAPTURE_80211_QOS_LEN	(2)
+#define PKT_CAPTURE_80211_HTC_LEN	(4)
+#define PKT_CAPTURE_80211_ADDR1_OFFSET	(4)
+#define PKT_CAPTURE_80211_ADDR2_OFFSET	(10)
+#define PKT_CAPTURE_80211_ADDR3_OFFSET	(16)
+#define PKT_CAPTURE_80211_ADDR4_OFFSET	(24)
+#define PKT_CAPTURE_80211_SUBTYPE_QOS	(0x08)
+#define PKT_CAPTURE_80211_FC1_PROTECTED	(0x40)
+#define PKT_CAPTURE_80211_FC1_ORDER	(0x80)
+
+#define PKT_CAPTURE_LLC_SNAP_LEN	(8)
+#define PKT_CAPTURE_LLC_ETHTYPE_OFFSET	(6)
+
+#define PKT_CAPTURE_IPV4_MIN_HDR_LEN	(20)
+#define PKT_CAPTURE_IPV4_PROTO_OFFSET	(9)
+#define PKT_CAPTURE_IPV4_FRAG_OFFSET	(6)
+#define PKT_CAPTURE_IPV4_FRAG_MASK	(0x1fff)
+#define PKT_CAPTURE_IPV6_HDR_LEN	(40)
+#define PKT_CAPTURE_IPV6_NEXT_HDR_OFFSET (6)
+#define PKT_CAPTURE_IP_PROTO_TCP	(6)
+#define PKT_CAPTURE_IP_PROTO_UDP	(17)
+#define PKT_CAPTURE_L4_PORTS_LEN	(4)
+
+#define PKT_CAPTURE_L3_FIELDS	(PKT_CAPTURE_FILTER_ETHER_TYPE | \
+				 PKT_CAPTURE_FILTER_IP_PROTO | \
+				 PKT_CAPTURE_FILTER_PORT)
+
+/**
+ * struct pkt_capture_frame_info - fields of a frame the filter matches on
+ * @type: 802.11 frame type
+ * @subtype: 802.11 frame subtype
+ * @is_80211: true if @subtype is valid
+ * @addr: frame addresses
+ * @num_addr: number of valid entries in @addr
+ * @ether_type: ether type, valid if @has_ether_type
+ * @has_ether_type: true if the payload ether type is known
+ * @ip_proto: IP protocol, valid if @has_ip_proto
+ * @has_ip_proto: true if the frame is an IPv4/IPv6 frame
+ * @src_port: TCP/UDP source port, valid if @has_ports
+ * @dst_port: TCP/UDP destination port, valid if @has_ports
+ * @has_ports: true if the frame carries an unfragmented TCP/UDP header
+ */
+struct pkt_capture_frame_info {
+	uint8_t type;
+	uint8_t subtype;
+	bool is_80211;
+	uint8_t *addr[4];
+	uint8_t num_addr;
+	uint16_t ether_type;
+	bool has_ether_type;
+	uint8_t ip_proto;
+	bool has_ip_proto;
+	uint16_t src_port;
+	uint16_t dst_port;
+	bool has_ports;
+};
+
+void pkt_capture_filter_init(struct pkt_capture_filter *filter)
+{
+	qdf_spinlock_create(&filter->lock);
+	filter->num_rules = 0;
+	qdf_mem_zero(&filter->stats, sizeof(filter->stats));
+}
+
+void pkt_capture_filter_deinit(struct pkt_capture_filter *filter)
+{
+	filter->num_rules = 0;
+	qdf_spinlock_destroy(&filter->lock);
+}
+
+/**
+ * pkt_capture_filter_get() - get filter context of the capture vdev
+ * @vdev: pointer to vdev object
+ *
+ * Return: filter context on success, NULL otherwise
+ */
+static struct pkt_capture_filter *
+pkt_capture_filter_get(struct wlan_objmgr_vdev *vdev)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+
+	if (!vdev)
+		return NULL;
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv)
+		return NULL;
+
+	return &vdev_priv->filter;
+}
+
+QDF_STATUS pkt_capture_filter_add_rule(struct wlan_objmgr_vdev *vdev,
+				       struct pkt_capture_filter_rule *rule)
+{
+	struct pkt_capture_filter *filter;
+
+	filter = pkt_capture_filter_get(vdev);
+	if (!filter) {
+		pkt_capture_err("vdev priv is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	if (!rule->match_flags ||
+	    (rule->match_flags & ~PKT_CAPTURE_FILTER_FIELD_ALL)) {
+		pkt_capture_err("invalid match flags 0x%x", rule->match_flags);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	/*
+	 * Make sure the radiotap/802.11 conversion always finds the
+	 * headers it needs in a truncated frame.
+	 */
+	if (rule->snaplen && rule->snaplen < PKT_CAPTURE_FILTER_MIN_SNAPLEN)
+		rule->snaplen = PKT_CAPTURE_FILTER_MIN_SNAPLEN;
+
+	qdf_spin_lock_bh(&filter->lock);
+	if (filter->num_rules >= PKT_CAPTURE_FILTER_MAX_RULES) {
+		qdf_spin_unlock_bh(&filter->lock);
+		pkt_capture_err("max %d filter rules supported",
+				PKT_CAPTURE_FILTER_MAX_RULES);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	filter->rules[filter->num_rules++] = *rule;
+	qdf_spin_unlock_bh(&filter->lock);
+
+	pkt_capture_debug("added rule flags 0x%x type %d subtype %d peer "
+			  QDF_MAC_ADDR_FMT " ether_type 0x%x proto %d port %d snaplen %d",
+			  rule->match_flags, rule->frame_type,
+			  rule->frame_subtype,
+			  QDF_MAC_ADDR_REF(rule->peer_mac.bytes),
+			  rule->ether_type, rule->ip_proto, rule->port,
+			  rule->snaplen);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS pkt_capture_filter_clear_rules(struct wlan_objmgr_vdev *vdev)
+{
+	struct pkt_capture_filter *filter;
+
+	filter = pkt_capture_filter_get(vdev);
+	if (!filter) {
+		pkt_capture_err("vdev priv is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_spin_lock_bh(&filter->lock);
+	filter->num_rules = 0;
+	qdf_mem_zero(&filter->stats, sizeof(filter->stats));
+	qdf_spin_unlock_bh(&filter->lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS pkt_capture_filter_get_stats(struct wlan_objmgr_vdev *vdev,
+					uint8_t *num_rules,
+					struct pkt_capture_filter_stats *stats)
+{
+	struct pkt_capture_filter *filter;
+
+	filter = pkt_capture_filter_get(vdev);
+	if (!filter) {
+		pkt_capture_err("vdev priv is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_spin_lock_bh(&filter->lock);
+	*num_rules = filter->num_rules;
+	*stats = filter->stats;
+	qdf_spin_unlock_bh(&filter->lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * pkt_capture_filter_parse_l3() - parse network and transport headers
+ * @info: frame info to be filled
+ * @data: start of the network header
+ * @len: number of bytes available at @data
+ *
+ * Return: None
+ */
+static void
+pkt_capture_filter_parse_l3(struct pkt_capture_frame_info *info,
+			    uint8_t *data, uint32_t len)
+{
+	uint32_t l4_offset;
+	uint16_t frag;
+
+	if (info->ether_type == ETHERTYPE_IPV4) {
+		if (len < PKT_CAPTURE_IPV4_MIN_HDR_LEN)
+			return;
+
+		info->ip_proto = data[PKT_CAPTURE_IPV4_PROTO_OFFSET];
+		info->has_ip_proto = true;
+
+		frag = (data[PKT_CAPTURE_IPV4_FRAG_OFFSET] << 8) |
+			data[PKT_CAPTURE_IPV4_FRAG_OFFSET + 1];
+		if (frag & PKT_CAPTURE_IPV4_FRAG_MASK)
+			return;
+
+		l4_offset = (data[0] & 0x0f) << 2;
+	} else if (info->ether_type == ETHERTYPE_IPV6) {
+		if (len < PKT_CAPTURE_IPV6_HDR_LEN)
+			return;
+
+		info->ip_proto = data[PKT_CAPTURE_IPV6_NEXT_HDR_OFFSET];
+		info->has_ip_proto = true;
+		l4_offset = PKT_CAPTURE_IPV6_HDR_LEN;
+	} else {
+		return;
+	}
+
+	if (info->ip_proto != PKT_CAPTURE_IP_PROTO_TCP &&
+	    info->ip_proto != PKT_CAPTURE_IP_PROTO_UDP)
+		return;
+
+	if (len < l4_offset + PKT_CAPTURE_L4_PORTS_LEN)
+		return;
+
+	info->src_port = (data[l4_offset] << 8) | data[l4_offset + 1];
+	info->dst_port = (data[l4_offset + 2] << 8) | data[l4_offset + 3];
+	info->has_ports = true;
+}
+
+/**
+ * pkt_capture_filter_match_rule() - match frame info against a rule
+ * @rule: filter rule
+ * @info: parsed frame info
+ *
+ * Return: true if all fields selected by the rule match
+ */
+static bool
+pkt_capture_filter_match_rule(struct pkt_capture_filter_rule *rule,
+			      struct pkt_capture_frame_info *info)
+{
+	uint32_t flags = rule->match_flags;
+	uint8_t i;
+
+	if ((flags & PKT_CAPTURE_FILTER_FRAME_TYPE) &&
+	    rule->frame_type != info->type)
+		return false;
+
+	if ((flags & PKT_CAPTURE_FILTER_FRAME_SUBTYPE) && info->is_80211 &&
+	    rule->frame_subtype != info->subtype)
+		return false;
+
+	if (flags & PKT_CAPTURE_FILTER_PEER_MAC) {
+		for (i = 0; i < info->num_addr; i++) {
+			if (!qdf_mem_cmp(info->addr[i], rule->peer_mac.bytes,
+					 QDF_MAC_ADDR_SIZE))
+				break;
+		}
+		if (i == info->num_addr)
+			return false;
+	}
+
+	if ((flags & PKT_CAPTURE_FILTER_ETHER_TYPE) &&
+	    (!info->has_ether_type || rule->ether_type != info->ether_type))
+		return false;
+
+	if ((flags & PKT_CAPTURE_FILTER_IP_PROTO) &&
+	    (!info->has_ip_proto || rule->ip_proto != info->ip_proto))
+		return false;
+
+	if ((flags & PKT_CAPTURE_FILTER_PORT) &&
+	    (!info->has_ports ||
+	     (rule->port != info->src_port && rule->port != info->dst_port)))
+		return false;
+
+	return true;
+}
+
+/**
+ * pkt_capture_filter_run() - run all filter rules on a frame
+ * @filter: filter context
+ * @info: parsed frame info
+ * @len: length of the frame
+ * @snaplen: snaplen of the first matching rule, filled by this API
+ *
+ * Caller must hold the filter lock.
+ *
+ * Return: true if any rule matches
+ */
+static bool
+pkt_capture_filter_run(struct pkt_capture_filter *filter,
+		       struct pkt_capture_frame_info *info,
+		       uint32_t len, uint32_t *snaplen)
+{
+	uint8_t i;
+
+	for (i = 0; i < filter->num_rules; i++) {
+		if (!pkt_capture_filter_match_rule(&filter->rules[i], info))
+			continue;
+
+		*snaplen = filter->rules[i].snaplen;
+		filter->stats.matched++;
+		if (*snaplen && *snaplen < len)
+			filter->stats.truncated++;
+
+		return true;
+	}
+
+	filter->stats.filtered++;
+
+	return false;
+}
+
+/**
+ * pkt_capture_filter_needs_l3() - check if any rule matches on L3/L4
+ * @filter: filter context
+ *
+ * Caller must hold the filter lock.
+ *
+ * Return: true if ether type, IP protocol or port needs to be parsed
+ */
+static bool pkt_capture_filter_needs_l3(struct pkt_capture_filter *filter)
+{
+	uint8_t i;
+
+	for (i = 0; i < filter->num_rules; i++) {
+		if (filter->rules[i].match_flags & PKT_CAPTURE_L3_FIELDS)
+			return true;
+	}
+
+	return false;
+}
+
+bool pkt_capture_filter_8023_frame(uint8_t *data, uint32_t len,
+				   uint8_t *peer_mac, uint32_t *snaplen)
+{
+	struct pkt_capture_filter *filter;
+	struct pkt_capture_frame_info info = {0};
+	struct ethernet_hdr_t *eth_hdr;
+	bool match;
+
+	*snaplen = 0;
+
+	filter = pkt_capture_filter_get(pkt_capture_get_vdev());
+	if (!filter || !filter->num_rules)
+		return true;
+
+	if (len < sizeof(*eth_hdr))
+		return false;
+
+	eth_hdr = (struct ethernet_hdr_t *)data;
+	info.type = PKT_CAPTURE_FRAME_TYPE_DATA;
+	info.addr[info.num_addr++] = eth_hdr->dest_addr;
+	info.addr[info.num_addr++] = eth_hdr->src_addr;
+	if (peer_mac)
+		info.addr[info.num_addr++] = peer_mac;
+
+	qdf_spin_lock_bh(&filter->lock);
+	if (pkt_capture_filter_needs_l3(filter)) {
+		info.ether_type = (eth_hdr->ethertype[0] << 8) |
+				  eth_hdr->ethertype[1];
+		info.has_ether_type = true;
+		pkt_capture_filter_parse_l3(&info, data + sizeof(*eth_hdr),
+					    len - sizeof(*eth_hdr));
+	}
+	match = pkt_capture_filter_run(filter, &info, len, snaplen);
+	qdf_spin_unlock_bh(&filter->lock);
+
+	return match;
+}
+
+/**
+ * pkt_capture_filter_parse_80211_data() - parse payload of a data frame
+ * @info: frame info to be filled
+ * @data: start of the 802.11 header
+ * @len: length of the frame
+ *
+ * Return: None
+ */
+static void
+pkt_capture_filter_parse_80211_data(struct pkt_capture_frame_info *info,
+				    uint8_t *data, uint32_t len)
+{
+	uint32_t hdr_len = PKT_CAPTURE_80211_HDR_LEN;
+	uint8_t *llc;
+
+	if (data[1] & PKT_CAPTURE_80211_FC1_PROTECTED)
+		return;
+
+	if ((data[1] & IEEE80211_FC1_DIR_MASK) == IEEE80211_FC1_DIR_DSTODS)
+		hdr_len += PKT_CAPTURE_80211_ADDR4_LEN;
+
+	if (info->subtype & PKT_CAPTURE_80211_SUBTYPE_QOS) {
+		hdr_len += PKT_CAPTURE_80211_QOS_LEN;
+		if (data[1] & PKT_CAPTURE_80211_FC1_ORDER)
+			hdr_len += PKT_CAPTURE_80211_HTC_LEN;
+	}
+
+	if (len < hdr_len + PKT_CAPTURE_LLC_SNAP_LEN)
+		return;
+
+	llc = data + hdr_len;
+	if (llc[0] != 0xaa || llc[1] != 0xaa || llc[2] != 0x03)
+		return;
+
+	info->ether_type = (llc[PKT_CAPTURE_LLC_ETHTYPE_OFFSET] << 8) |
+			   llc[PKT_CAPTURE_LLC_ETHTYPE_OFFSET + 1];
+	info->has_ether_type = true;
+	hdr_len += PKT_CAPTURE_LLC_SNAP_LEN;
+
+	pkt_capture_filter_parse_l3(info, data + hdr_len, len - hdr_len);
+}
+
+bool pkt_capture_filter_80211_frame(uint8_t *data, uint32_t len,
+				    uint32_t *snaplen)
+{
+	struct pkt_capture_filter *filter;
+	struct pkt_capture_frame_info info = {0};
+	bool match;
+
+	*snaplen = 0;
+
+	filter = pkt_capture_filter_get(pkt_capture_get_vdev());
+	if (!filter || !filter->num_rules)
+		return true;
+
+	if (len < PKT_CAPTURE_80211_ADDR2_OFFSET)
+		return false;
+
+	info.type = (data[0] & IEEE80211_FC0_TYPE_MASK) >> 2;
+	info.subtype = (data[0] & IEEE80211_FC0_SUBTYPE_MASK) >>
+			IEEE80211_FC0_SUBTYPE_SHIFT;
+	info.is_80211 = true;
+
+	info.addr[info.num_addr++] = data + PKT_CAPTURE_80211_ADDR1_OFFSET;
+	if (len >= PKT_CAPTURE_80211_ADDR3_OFFSET)
+		info.addr[info.num_addr++] =
+				data + PKT_CAPTURE_80211_ADDR2_OFFSET;
+	if (len >= PKT_CAPTURE_80211_HDR_LEN)
+		info.addr[info.num_addr++] =
+				data + PKT_CAPTURE_80211_ADDR3_OFFSET;
+	if (info.type == PKT_CAPTURE_FRAME_TYPE_DATA &&
+	    (data[1] & IEEE80211_FC1_DIR_MASK) == IEEE80211_FC1_DIR_DSTODS &&
+	    len >= PKT_CAPTURE_80211_HDR_LEN + PKT_CAPTURE_80211_ADDR4_LEN)
+		info.addr[info.num_addr++] =
+				data + PKT_CAPTURE_80211_ADDR4_OFFSET;
+
+	qdf_spin_lock_bh(&filter->lock);
+	if (info.type == PKT_CAPTURE_FRAME_TYPE_DATA &&
+	    pkt_capture_filter_needs_l3(filter))
+		pkt_capture_filter_parse_80211_data(&info, data, len);
+	match = pkt_capture_filter_run(filter, &info, len, snaplen);
+	qdf_spin_unlock_bh(&filter->lock);
+
+	return match;
+}
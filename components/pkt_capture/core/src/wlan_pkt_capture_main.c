@@ -28,6 +28,7 @@
 #include "target_if_pkt_capture.h"
 #include "cdp_txrx_ctrl.h"
 #include "wlan_pkt_capture_tgt_api.h"
+#include "wlan_pkt_capture_filter.h"
 
 static struct wlan_objmgr_vdev *gp_pkt_capture_vdev;
 
@@ -368,6 +369,7 @@ pkt_capture_vdev_create_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	}
 
 	vdev_priv->vdev = vdev;
+	pkt_capture_filter_init(&vdev_priv->filter);
 	gp_pkt_capture_vdev = vdev;
 
 	status = pkt_capture_callback_ctx_create(vdev_priv);
@@ -404,6 +406,7 @@ destroy_mon_context:
 destroy_pkt_capture_cb_context:
 	pkt_capture_callback_ctx_destroy(vdev_priv);
 detach_vdev_priv:
+	pkt_capture_filter_deinit(&vdev_priv->filter);
 	wlan_objmgr_vdev_component_obj_detach(vdev,
 					      WLAN_UMAC_COMP_PKT_CAPTURE,
 					      vdev_priv);
@@ -438,6 +441,7 @@ pkt_capture_vdev_destroy_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	pkt_capture_close_mon_thread(vdev_priv->mon_ctx);
 	pkt_capture_mon_context_destroy(vdev_priv);
 	pkt_capture_callback_ctx_destroy(vdev_priv);
+	pkt_capture_filter_deinit(&vdev_priv->filter);
 	qdf_mem_free(vdev_priv);
 	gp_pkt_capture_vdev = NULL;
 	return status;
@@ -25,6 +25,7 @@
 #include "wlan_pkt_capture_main.h"
 #include "wlan_pkt_capture_priv.h"
 #include "wlan_pkt_capture_mgmt_txrx.h"
+#include "wlan_pkt_capture_filter.h"
 #include "wlan_mlme_main.h"
 #include "wlan_lmac_if_api.h"
 #include "wlan_mgmt_txrx_utils_api.h"
@@ -332,6 +333,7 @@ void pkt_capture_mgmt_tx(struct wlan_objmgr_pdev *pdev,
 	qdf_nbuf_t wbuf;
 	int nbuf_len;
 	struct mgmt_offload_event_params params = {0};
+	uint32_t snaplen;
 
 	if (!pdev) {
 		pkt_capture_err("pdev is NULL");
@@ -339,6 +341,11 @@ void pkt_capture_mgmt_tx(struct wlan_objmgr_pdev *pdev,
 	}
 
 	nbuf_len = qdf_nbuf_len(nbuf);
+	if (!pkt_capture_filter_80211_frame(qdf_nbuf_data(nbuf), nbuf_len,
+					    &snaplen))
+		return;
+
+	nbuf_len = pkt_capture_filter_copy_len(nbuf_len, snaplen);
 	wbuf = qdf_nbuf_alloc(NULL, roundup(nbuf_len + RESERVE_BYTES, 4),
 			      RESERVE_BYTES, 4, false);
 	if (!wbuf) {
@@ -382,6 +389,7 @@ pkt_capture_mgmt_tx_completion(struct wlan_objmgr_pdev *pdev,
 {
 	qdf_nbuf_t wbuf, nbuf;
 	int nbuf_len;
+	uint32_t snaplen;
 
 	if (!pdev) {
 		pkt_capture_err("pdev is NULL");
@@ -393,6 +401,11 @@ pkt_capture_mgmt_tx_completion(struct wlan_objmgr_pdev *pdev,
 		return;
 
 	nbuf_len = qdf_nbuf_len(nbuf);
+	if (!pkt_capture_filter_80211_frame(qdf_nbuf_data(nbuf), nbuf_len,
+					    &snaplen))
+		return;
+
+	nbuf_len = pkt_capture_filter_copy_len(nbuf_len, snaplen);
 	wbuf = qdf_nbuf_alloc(NULL, roundup(nbuf_len + RESERVE_BYTES, 4),
 			      RESERVE_BYTES, 4, false);
 	if (!wbuf) {
@@ -431,6 +444,7 @@ pkt_capture_mgmt_rx_data_cb(struct wlan_objmgr_psoc *psoc,
 	qdf_nbuf_t nbuf;
 	int buf_len;
 	struct wlan_objmgr_vdev *vdev;
+	uint32_t snaplen;
 
 	if (!(pkt_capture_get_pktcap_mode(psoc) & PKT_CAPTURE_MODE_MGMT_ONLY)) {
 		qdf_nbuf_free(wbuf);
@@ -438,6 +452,13 @@ pkt_capture_mgmt_rx_data_cb(struct wlan_objmgr_psoc *psoc,
 	}
 
 	buf_len = qdf_nbuf_len(wbuf);
+	if (!pkt_capture_filter_80211_frame(qdf_nbuf_data(wbuf), buf_len,
+					    &snaplen)) {
+		qdf_nbuf_free(wbuf);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	buf_len = pkt_capture_filter_copy_len(buf_len, snaplen);
 	nbuf = qdf_nbuf_alloc(NULL, roundup(
 				  buf_len + RESERVE_BYTES, 4),
 				  RESERVE_BYTES, 4, false);
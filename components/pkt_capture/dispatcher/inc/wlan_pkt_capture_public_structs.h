@@ -33,6 +33,68 @@ enum pkt_capture_mode {
 	PACKET_CAPTURE_MODE_DATA_MGMT,
 };
 
+#define PKT_CAPTURE_FILTER_MAX_RULES	(8)
+#define PKT_CAPTURE_FILTER_MIN_SNAPLEN	(64)
+
+/**
+ * enum pkt_capture_filter_field - fields a packet capture filter rule
+ * can match on
+ * @PKT_CAPTURE_FILTER_FRAME_TYPE: match 802.11 frame type
+ * @PKT_CAPTURE_FILTER_FRAME_SUBTYPE: match 802.11 frame subtype
+ * @PKT_CAPTURE_FILTER_PEER_MAC: match any of the frame addresses
+ * @PKT_CAPTURE_FILTER_ETHER_TYPE: match ether type of data frames
+ * @PKT_CAPTURE_FILTER_IP_PROTO: match IPv4/IPv6 next protocol
+ * @PKT_CAPTURE_FILTER_PORT: match TCP/UDP source or destination port
+ */
+enum pkt_capture_filter_field {
+	PKT_CAPTURE_FILTER_FRAME_TYPE = BIT(0),
+	PKT_CAPTURE_FILTER_FRAME_SUBTYPE = BIT(1),
+	PKT_CAPTURE_FILTER_PEER_MAC = BIT(2),
+	PKT_CAPTURE_FILTER_ETHER_TYPE = BIT(3),
+	PKT_CAPTURE_FILTER_IP_PROTO = BIT(4),
+	PKT_CAPTURE_FILTER_PORT = BIT(5),
+};
+
+#define PKT_CAPTURE_FILTER_FIELD_ALL	(BIT(6) - 1)
+
+/**
+ * struct pkt_capture_filter_rule - packet capture filter rule
+ * @match_flags: bitmap of enum pkt_capture_filter_field to match on
+ * @frame_type: 802.11 frame type (0 - mgmt, 1 - ctrl, 2 - data)
+ * @frame_subtype: 802.11 frame subtype
+ * @peer_mac: peer mac address
+ * @ether_type: ether type in host byte order
+ * @ip_proto: IP protocol number
+ * @port: TCP/UDP port in host byte order
+ * @snaplen: max number of bytes of the frame to capture, 0 for full frame
+ *
+ * A frame matches the rule when every field selected in @match_flags
+ * matches. Data frames which the target hands over in 802.3 format are
+ * treated as frame type data; @frame_subtype is ignored for them.
+ */
+struct pkt_capture_filter_rule {
+	uint32_t match_flags;
+	uint8_t frame_type;
+	uint8_t frame_subtype;
+	struct qdf_mac_addr peer_mac;
+	uint16_t ether_type;
+	uint8_t ip_proto;
+	uint16_t port;
+	uint16_t snaplen;
+};
+
+/**
+ * struct pkt_capture_filter_stats - packet capture filter statistics
+ * @matched: number of frames accepted by the filter
+ * @filtered: number of frames dropped by the filter before being copied
+ * @truncated: number of accepted frames truncated to the rule snaplen
+ */
+struct pkt_capture_filter_stats {
+	uint32_t matched;
+	uint32_t filtered;
+	uint32_t truncated;
+};
+
 /**
  * struct mgmt_offload_event_params - Management offload event params
  * @tsf_l32: The lower 32 bits of the TSF
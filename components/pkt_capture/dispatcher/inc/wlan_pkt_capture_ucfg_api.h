@@ -266,6 +266,55 @@ void ucfg_pkt_capture_record_channel(struct wlan_objmgr_vdev *vdev);
 int
 ucfg_pkt_capture_register_wma_callbacks(struct wlan_objmgr_psoc *psoc,
 					struct pkt_capture_callbacks *cb_obj);
+/**
+ * ucfg_pkt_capture_filter_add_rule() - add a packet capture filter rule
+ * @vdev: pointer to vdev object
+ * @rule: rule to be added
+ *
+ * Frames are captured if they match any of the installed rules. If no
+ * rule is installed all frames are captured.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+ucfg_pkt_capture_filter_add_rule(struct wlan_objmgr_vdev *vdev,
+				 struct pkt_capture_filter_rule *rule);
+
+/**
+ * ucfg_pkt_capture_filter_clear_rules() - remove all packet capture filter
+ * rules
+ * @vdev: pointer to vdev object
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+ucfg_pkt_capture_filter_clear_rules(struct wlan_objmgr_vdev *vdev);
+
+/**
+ * ucfg_pkt_capture_filter_get_stats() - get packet capture filter stats
+ * @vdev: pointer to vdev object
+ * @num_rules: number of installed rules
+ * @stats: filter statistics
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+ucfg_pkt_capture_filter_get_stats(struct wlan_objmgr_vdev *vdev,
+				  uint8_t *num_rules,
+				  struct pkt_capture_filter_stats *stats);
+
+/**
+ * ucfg_pkt_capture_filter_8023_frame() - run packet capture filter on a
+ * 802.3 data frame before it is copied
+ * @data: start of the ethernet header
+ * @len: length of the frame
+ * @peer_mac: mac address of the peer
+ * @snaplen: number of bytes to capture, 0 for full frame
+ *
+ * Return: true if the frame needs to be captured, false otherwise
+ */
+bool ucfg_pkt_capture_filter_8023_frame(uint8_t *data, uint32_t len,
+					uint8_t *peer_mac, uint32_t *snaplen);
 #else
 static inline
 QDF_STATUS ucfg_pkt_capture_init(void)
@@ -395,5 +444,34 @@ static inline void
 ucfg_pkt_capture_record_channel(struct wlan_objmgr_vdev *vdev)
 {
 }
+static inline QDF_STATUS
+ucfg_pkt_capture_filter_add_rule(struct wlan_objmgr_vdev *vdev,
+				 struct pkt_capture_filter_rule *rule)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline QDF_STATUS
+ucfg_pkt_capture_filter_clear_rules(struct wlan_objmgr_vdev *vdev)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline QDF_STATUS
+ucfg_pkt_capture_filter_get_stats(struct wlan_objmgr_vdev *vdev,
+				  uint8_t *num_rules,
+				  struct pkt_capture_filter_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline bool
+ucfg_pkt_capture_filter_8023_frame(uint8_t *data, uint32_t len,
+				   uint8_t *peer_mac, uint32_t *snaplen)
+{
+	*snaplen = 0;
+
+	return true;
+}
 #endif /* WLAN_FEATURE_PKT_CAPTURE */
 #endif /* _WLAN_PKT_CAPTURE_UCFG_API_H_ */
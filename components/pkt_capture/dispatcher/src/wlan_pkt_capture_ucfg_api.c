@@ -28,6 +28,7 @@
 #include "target_if_pkt_capture.h"
 #include "wlan_pkt_capture_data_txrx.h"
 #include "wlan_pkt_capture_tgt_api.h"
+#include "wlan_pkt_capture_filter.h"
 
 enum pkt_capture_mode ucfg_pkt_capture_get_mode(struct wlan_objmgr_psoc *psoc)
 {
@@ -308,3 +309,30 @@ ucfg_pkt_capture_register_wma_callbacks(struct wlan_objmgr_psoc *psoc,
 
 	return 0;
 }
+
+QDF_STATUS
+ucfg_pkt_capture_filter_add_rule(struct wlan_objmgr_vdev *vdev,
+				 struct pkt_capture_filter_rule *rule)
+{
+	return pkt_capture_filter_add_rule(vdev, rule);
+}
+
+QDF_STATUS
+ucfg_pkt_capture_filter_clear_rules(struct wlan_objmgr_vdev *vdev)
+{
+	return pkt_capture_filter_clear_rules(vdev);
+}
+
+QDF_STATUS
+ucfg_pkt_capture_filter_get_stats(struct wlan_objmgr_vdev *vdev,
+				  uint8_t *num_rules,
+				  struct pkt_capture_filter_stats *stats)
+{
+	return pkt_capture_filter_get_stats(vdev, num_rules, stats);
+}
+
+bool ucfg_pkt_capture_filter_8023_frame(uint8_t *data, uint32_t len,
+					uint8_t *peer_mac, uint32_t *snaplen)
+{
+	return pkt_capture_filter_8023_frame(data, len, peer_mac, snaplen);
+}
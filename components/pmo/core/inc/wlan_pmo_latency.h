@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: Declare suspend/resume latency tracer API's
+ */
+
+#ifndef _WLAN_PMO_LATENCY_H_
+#define _WLAN_PMO_LATENCY_H_
+
+#include "wlan_pmo_priv.h"
+
+#ifdef WLAN_PMO_LATENCY_TRACE
+/**
+ * pmo_latency_init() - initialize suspend/resume latency tracer
+ * @psoc_ctx: pmo private psoc ctx
+ *
+ * Return: None
+ */
+void pmo_latency_init(struct pmo_psoc_priv_obj *psoc_ctx);
+
+/**
+ * pmo_latency_deinit() - de-initialize suspend/resume latency tracer
+ * @psoc_ctx: pmo private psoc ctx
+ *
+ * Return: None
+ */
+void pmo_latency_deinit(struct pmo_psoc_priv_obj *psoc_ctx);
+
+/**
+ * pmo_latency_cycle_begin() - start tracing a suspend/resume cycle
+ * @psoc: objmgr psoc handle
+ * @type: cycle type
+ *
+ * A cycle which was still open, e.g. because its end was never reached
+ * due to an early error return, is committed as aborted.
+ *
+ * Return: None
+ */
+void pmo_latency_cycle_begin(struct wlan_objmgr_psoc *psoc,
+			     enum pmo_latency_cycle_type type);
+
+/**
+ * pmo_latency_cycle_end() - stop tracing a suspend/resume cycle
+ * @psoc: objmgr psoc handle
+ * @type: cycle type
+ * @status: status the cycle completed with
+ *
+ * Return: None
+ */
+void pmo_latency_cycle_end(struct wlan_objmgr_psoc *psoc,
+			   enum pmo_latency_cycle_type type,
+			   QDF_STATUS status);
+
+/**
+ * pmo_latency_begin() - get the start timestamp of a stage
+ *
+ * Return: start timestamp to be passed to pmo_latency_record()
+ */
+static inline uint64_t pmo_latency_begin(void)
+{
+	return qdf_get_log_timestamp_usecs();
+}
+
+/**
+ * pmo_latency_record() - record the duration of a stage
+ * @psoc: objmgr psoc handle
+ * @stage: stage which completed
+ * @vdev_id: vdev the stage ran for, PMO_LATENCY_NO_VDEV if not per vdev
+ * @begin_us: timestamp returned by pmo_latency_begin()
+ *
+ * Return: None
+ */
+void pmo_latency_record(struct wlan_objmgr_psoc *psoc,
+			enum pmo_latency_stage stage,
+			uint8_t vdev_id, uint64_t begin_us);
+
+/**
+ * pmo_latency_print() - dump suspend/resume latency trace into a buffer
+ * @psoc: objmgr psoc handle
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @plen: number of bytes written into @buf, filled by this API
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pmo_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+			     ssize_t buf_len, ssize_t *plen);
+
+/**
+ * pmo_latency_reset() - clear suspend/resume latency trace
+ * @psoc: objmgr psoc handle
+ *
+ * Return: None
+ */
+void pmo_latency_reset(struct wlan_objmgr_psoc *psoc);
+#else
+static inline void pmo_latency_init(struct pmo_psoc_priv_obj *psoc_ctx)
+{
+}
+
+static inline void pmo_latency_deinit(struct pmo_psoc_priv_obj *psoc_ctx)
+{
+}
+
+static inline void
+pmo_latency_cycle_begin(struct wlan_objmgr_psoc *psoc,
+			enum pmo_latency_cycle_type type)
+{
+}
+
+static inline void
+pmo_latency_cycle_end(struct wlan_objmgr_psoc *psoc,
+		      enum pmo_latency_cycle_type type,
+		      QDF_STATUS status)
+{
+}
+
+static inline uint64_t pmo_latency_begin(void)
+{
+	return 0;
+}
+
+static inline void
+pmo_latency_record(struct wlan_objmgr_psoc *psoc,
+		   enum pmo_latency_stage stage,
+		   uint8_t vdev_id, uint64_t begin_us)
+{
+}
+
+static inline QDF_STATUS
+pmo_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+		  ssize_t buf_len, ssize_t *plen)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline void pmo_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif /* WLAN_PMO_LATENCY_TRACE */
+
+#endif /* end  of _WLAN_PMO_LATENCY_H_ */
@@ -33,6 +33,7 @@
 #include "wlan_pmo_gtk_public_struct.h"
 #include "wlan_pmo_wow_public_struct.h"
 #include "wlan_pmo_mc_addr_filtering_public_struct.h"
+#include "wlan_pmo_latency_public_struct.h"
 
 /**
  * struct pmo_psoc_priv_obj - psoc related data require for pmo
@@ -49,6 +50,7 @@
  * @get_dtim_period: register callback to get dtim period from mlme
  * @get_beacon_interval: register callback to get beacon interval from mlme
  * @lock: spin lock for pmo psoc
+ * @latency: suspend/resume latency tracer
  */
 struct pmo_psoc_priv_obj {
 	struct pmo_psoc_cfg psoc_cfg;
@@ -66,6 +68,9 @@ struct pmo_psoc_priv_obj {
 	pmo_get_dtim_period get_dtim_period;
 	pmo_get_beacon_interval get_beacon_interval;
 	qdf_spinlock_t lock;
+#ifdef WLAN_PMO_LATENCY_TRACE
+	struct pmo_latency_tracer latency;
+#endif
 };
 
 /**
@@ -93,6 +98,7 @@ struct wlan_pmo_ctx {
  * @vdev_arp_req: place holder for arp request for vdev
  * @vdev_ns_req: place holder for ns request for vdev
  * @vdev_mc_list_req: place holder for mc addr list for vdev
+ * @vdev_mc_list_fw: mc addr list currently installed in fwr for vdev
  * @addr_filter_pattern: addr filter pattern for vdev
  * @vdev_gtk_params: place holder for gtk request for vdev
  * @gtk_err_enable: gtk error is enabled or not
@@ -116,6 +122,7 @@ struct pmo_vdev_priv_obj {
 	struct pmo_arp_offload_params vdev_arp_req;
 	struct pmo_ns_offload_params vdev_ns_req;
 	struct pmo_mc_addr_list vdev_mc_list_req;
+	struct pmo_mc_addr_list vdev_mc_list_fw;
 	uint8_t addr_filter_pattern;
 	struct pmo_gtk_req vdev_gtk_req;
 	struct pmo_gtk_rsp_req vdev_gtk_rsp_req;
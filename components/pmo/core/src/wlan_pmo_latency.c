@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: Implements suspend/resume latency tracer API's
+ */
+
+#include "wlan_pmo_main.h"
+#include "wlan_pmo_latency.h"
+
+static const char *pmo_latency_cycle_name[PMO_LATENCY_CYCLE_TYPE_MAX] = {
+	[PMO_LATENCY_SYSTEM_SUSPEND] = "system_suspend",
+	[PMO_LATENCY_SYSTEM_RESUME] = "system_resume",
+	[PMO_LATENCY_RUNTIME_SUSPEND] = "runtime_suspend",
+	[PMO_LATENCY_RUNTIME_RESUME] = "runtime_resume",
+};
+
+static const char *pmo_latency_stage_name[PMO_LATENCY_STAGE_MAX] = {
+	[PMO_LATENCY_STAGE_CONFIGURE_SUSPEND] = "configure_suspend",
+	[PMO_LATENCY_STAGE_RUNTIME_PM_OFFLOADS] = "runtime_pm_offloads",
+	[PMO_LATENCY_STAGE_LPHB] = "lphb",
+	[PMO_LATENCY_STAGE_WAKE_EVENTS] = "wake_events",
+	[PMO_LATENCY_STAGE_SUSPEND_DTIM] = "suspend_dtim",
+	[PMO_LATENCY_STAGE_BUS_SUSPEND] = "bus_suspend",
+	[PMO_LATENCY_STAGE_WOW_ENABLE_SEND] = "wow_enable_send",
+	[PMO_LATENCY_STAGE_WOW_ENABLE_ACK] = "wow_enable_ack",
+	[PMO_LATENCY_STAGE_TARGET_SUSPEND] = "target_suspend",
+	[PMO_LATENCY_STAGE_HIF_RUNTIME_SUSPEND] = "hif_runtime_suspend",
+	[PMO_LATENCY_STAGE_PLD_RUNTIME_SUSPEND] = "pld_runtime_suspend",
+	[PMO_LATENCY_STAGE_PLD_RUNTIME_RESUME] = "pld_runtime_resume",
+	[PMO_LATENCY_STAGE_HIF_RUNTIME_RESUME] = "hif_runtime_resume",
+	[PMO_LATENCY_STAGE_BUS_RESUME] = "bus_resume",
+	[PMO_LATENCY_STAGE_WOW_DISABLE] = "wow_disable",
+	[PMO_LATENCY_STAGE_TARGET_RESUME] = "target_resume",
+	[PMO_LATENCY_STAGE_CONFIGURE_RESUME] = "configure_resume",
+	[PMO_LATENCY_STAGE_RESUME_DTIM] = "resume_dtim",
+};
+
+void pmo_latency_init(struct pmo_psoc_priv_obj *psoc_ctx)
+{
+	struct pmo_latency_tracer *tracer = &psoc_ctx->latency;
+
+	qdf_mem_zero(tracer, sizeof(*tracer));
+	tracer->next_cycle_id = 1;
+	qdf_spinlock_create(&tracer->lock);
+}
+
+void pmo_latency_deinit(struct pmo_psoc_priv_obj *psoc_ctx)
+{
+	qdf_spinlock_destroy(&psoc_ctx->latency.lock);
+}
+
+/**
+ * pmo_latency_hist_add() - add a sample to a latency histogram
+ * @hist: histogram
+ * @duration_us: sample in microseconds
+ *
+ * Return: None
+ */
+static void pmo_latency_hist_add(struct pmo_latency_hist *hist,
+				 uint32_t duration_us)
+{
+	uint32_t limit = PMO_LATENCY_HIST_BASE_US;
+	uint8_t i;
+
+	for (i = 0; i < PMO_LATENCY_HIST_BUCKETS - 1; i++) {
+		if (duration_us < limit)
+			break;
+		limit <<= 1;
+	}
+
+	hist->bucket[i]++;
+	hist->count++;
+	hist->last_us = duration_us;
+	hist->total_us += duration_us;
+	if (duration_us > hist->max_us)
+		hist->max_us = duration_us;
+}
+
+/**
+ * pmo_latency_commit_cycle() - move the open cycle into the cycle ring
+ * @tracer: latency tracer, lock must be held by the caller
+ * @status: status the cycle completed with
+ *
+ * Return: None
+ */
+static void pmo_latency_commit_cycle(struct pmo_latency_tracer *tracer,
+				     QDF_STATUS status)
+{
+	struct pmo_latency_cycle *cur = &tracer->cur;
+
+	cur->status = status;
+	cur->total_us = qdf_get_log_timestamp_usecs() - cur->start_us;
+	if (QDF_IS_STATUS_SUCCESS(status))
+		pmo_latency_hist_add(&tracer->cycle_hist[cur->type],
+				     cur->total_us);
+
+	tracer->cycles[tracer->cycle_idx] = *cur;
+	tracer->cycle_idx = (tracer->cycle_idx + 1) % PMO_LATENCY_MAX_CYCLES;
+	if (tracer->num_cycles < PMO_LATENCY_MAX_CYCLES)
+		tracer->num_cycles++;
+	tracer->cycle_active = false;
+}
+
+void pmo_latency_cycle_begin(struct wlan_objmgr_psoc *psoc,
+			     enum pmo_latency_cycle_type type)
+{
+	struct pmo_psoc_priv_obj *psoc_ctx = pmo_psoc_get_priv(psoc);
+	struct pmo_latency_tracer *tracer;
+
+	if (type >= PMO_LATENCY_CYCLE_TYPE_MAX)
+		return;
+
+	tracer = &psoc_ctx->latency;
+	qdf_spin_lock_bh(&tracer->lock);
+	if (tracer->cycle_active)
+		pmo_latency_commit_cycle(tracer, QDF_STATUS_E_ABORTED);
+
+	qdf_mem_zero(&tracer->cur, sizeof(tracer->cur));
+	tracer->cur.id = tracer->next_cycle_id++;
+	tracer->cur.type = type;
+	tracer->cur.start_us = qdf_get_log_timestamp_usecs();
+	tracer->cycle_active = true;
+	qdf_spin_unlock_bh(&tracer->lock);
+}
+
+void pmo_latency_cycle_end(struct wlan_objmgr_psoc *psoc,
+			   enum pmo_latency_cycle_type type,
+			   QDF_STATUS status)
+{
+	struct pmo_psoc_priv_obj *psoc_ctx = pmo_psoc_get_priv(psoc);
+	struct pmo_latency_tracer *tracer = &psoc_ctx->latency;
+
+	qdf_spin_lock_bh(&tracer->lock);
+	if (tracer->cycle_active && tracer->cur.type == type)
+		pmo_latency_commit_cycle(tracer, status);
+	qdf_spin_unlock_bh(&tracer->lock);
+}
+
+void pmo_latency_record(struct wlan_objmgr_psoc *psoc,
+			enum pmo_latency_stage stage,
+			uint8_t vdev_id, uint64_t begin_us)
+{
+	struct pmo_psoc_priv_obj *psoc_ctx = pmo_psoc_get_priv(psoc);
+	struct pmo_latency_tracer *tracer;
+	struct pmo_latency_vdev_record *record;
+	uint32_t duration_us;
+
+	if (stage >= PMO_LATENCY_STAGE_MAX)
+		return;
+
+	duration_us = qdf_get_log_timestamp_usecs() - begin_us;
+	tracer = &psoc_ctx->latency;
+
+	qdf_spin_lock_bh(&tracer->lock);
+	pmo_latency_hist_add(&tracer->stage_hist[stage], duration_us);
+	if (tracer->cycle_active)
+		tracer->cur.stage_us[stage] += duration_us;
+
+	if (vdev_id != PMO_LATENCY_NO_VDEV) {
+		record = &tracer->vdev_records[tracer->vdev_record_idx];
+		record->cycle_id = tracer->cycle_active ? tracer->cur.id : 0;
+		record->vdev_id = vdev_id;
+		record->stage = stage;
+		record->duration_us = duration_us;
+		tracer->vdev_record_idx = (tracer->vdev_record_idx + 1) %
+					  PMO_LATENCY_MAX_VDEV_RECORDS;
+		if (tracer->num_vdev_records < PMO_LATENCY_MAX_VDEV_RECORDS)
+			tracer->num_vdev_records++;
+	}
+	qdf_spin_unlock_bh(&tracer->lock);
+}
+
+/**
+ * pmo_latency_print_hist() - print a latency histogram into a buffer
+ * @name: name of the histogram
+ * @hist: histogram
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @len: number of bytes already written into @buf
+ *
+ * Return: number of bytes written into @buf
+ */
+static ssize_t pmo_latency_print_hist(const char *name,
+				      struct pmo_latency_hist *hist,
+				      uint8_t *buf, ssize_t buf_len,
+				      ssize_t len)
+{
+	uint8_t i;
+
+	if (!hist->count)
+		return len;
+
+	len += qdf_scnprintf(buf + len, buf_len - len,
+			     "%-20s cnt %u last %u avg %llu max %u |",
+			     name, hist->count, hist->last_us,
+			     qdf_do_div(hist->total_us, hist->count),
+			     hist->max_us);
+	for (i = 0; i < PMO_LATENCY_HIST_BUCKETS; i++)
+		len += qdf_scnprintf(buf + len, buf_len - len, " %u",
+				     hist->bucket[i]);
+	len += qdf_scnprintf(buf + len, buf_len - len, "\n");
+
+	return len;
+}
+
+QDF_STATUS pmo_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+			     ssize_t buf_len, ssize_t *plen)
+{
+	struct pmo_psoc_priv_obj *psoc_ctx = pmo_psoc_get_priv(psoc);
+	struct pmo_latency_tracer *tracer;
+	struct pmo_latency_cycle *cycle;
+	struct pmo_latency_vdev_record *record;
+	ssize_t len = 0;
+	uint8_t i, j, idx;
+
+	if (!buf || !plen)
+		return QDF_STATUS_E_INVAL;
+
+	tracer = &psoc_ctx->latency;
+	qdf_spin_lock_bh(&tracer->lock);
+
+	len += qdf_scnprintf(buf + len, buf_len - len,
+			     "histogram buckets (usecs): <%u, then x2 up to >=%u\n",
+			     PMO_LATENCY_HIST_BASE_US,
+			     PMO_LATENCY_HIST_BASE_US <<
+			     (PMO_LATENCY_HIST_BUCKETS - 2));
+
+	len += qdf_scnprintf(buf + len, buf_len - len, "\ncycles:\n");
+	for (i = 0; i < PMO_LATENCY_CYCLE_TYPE_MAX; i++)
+		len = pmo_latency_print_hist(pmo_latency_cycle_name[i],
+					     &tracer->cycle_hist[i],
+					     buf, buf_len, len);
+
+	len += qdf_scnprintf(buf + len, buf_len - len, "\nstages:\n");
+	for (i = 0; i < PMO_LATENCY_STAGE_MAX; i++)
+		len = pmo_latency_print_hist(pmo_latency_stage_name[i],
+					     &tracer->stage_hist[i],
+					     buf, buf_len, len);
+
+	len += qdf_scnprintf(buf + len, buf_len - len,
+			     "\nlast %u cycles:\n", tracer->num_cycles);
+	for (i = 0; i < tracer->num_cycles; i++) {
+		idx = (tracer->cycle_idx + PMO_LATENCY_MAX_CYCLES -
+		       tracer->num_cycles + i) % PMO_LATENCY_MAX_CYCLES;
+		cycle = &tracer->cycles[idx];
+		len += qdf_scnprintf(buf + len, buf_len - len,
+				     "#%u %s ts %llu status %d total %u:",
+				     cycle->id,
+				     pmo_latency_cycle_name[cycle->type],
+				     cycle->start_us, cycle->status,
+				     cycle->total_us);
+		for (j = 0; j < PMO_LATENCY_STAGE_MAX; j++) {
+			if (!cycle->stage_us[j])
+				continue;
+			len += qdf_scnprintf(buf + len, buf_len - len,
+					     " %s %u",
+					     pmo_latency_stage_name[j],
+					     cycle->stage_us[j]);
+		}
+		len += qdf_scnprintf(buf + len, buf_len - len, "\n");
+	}
+
+	len += qdf_scnprintf(buf + len, buf_len - len,
+			     "\nlast %u vdev stages:\n",
+			     tracer->num_vdev_records);
+	for (i = 0; i < tracer->num_vdev_records; i++) {
+		idx = (tracer->vdev_record_idx + PMO_LATENCY_MAX_VDEV_RECORDS -
+		       tracer->num_vdev_records + i) %
+		      PMO_LATENCY_MAX_VDEV_RECORDS;
+		record = &tracer->vdev_records[idx];
+		len += qdf_scnprintf(buf + len, buf_len - len,
+				     "#%u vdev %u %s %u\n",
+				     record->cycle_id, record->vdev_id,
+				     pmo_latency_stage_name[record->stage],
+				     record->duration_us);
+	}
+
+	qdf_spin_unlock_bh(&tracer->lock);
+	*plen = len;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void pmo_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+	struct pmo_psoc_priv_obj *psoc_ctx = pmo_psoc_get_priv(psoc);
+	struct pmo_latency_tracer *tracer = &psoc_ctx->latency;
+
+	qdf_spin_lock_bh(&tracer->lock);
+	tracer->cycle_active = false;
+	tracer->cycle_idx = 0;
+	tracer->num_cycles = 0;
+	tracer->vdev_record_idx = 0;
+	tracer->num_vdev_records = 0;
+	qdf_mem_zero(tracer->stage_hist, sizeof(tracer->stage_hist));
+	qdf_mem_zero(tracer->cycle_hist, sizeof(tracer->cycle_hist));
+	qdf_spin_unlock_bh(&tracer->lock);
+}
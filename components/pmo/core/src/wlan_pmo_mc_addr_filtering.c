@@ -98,6 +98,13 @@ static QDF_STATUS pmo_core_flush_mc_addr_list_from_vdev_priv(
 	qdf_spin_lock_bh(&vdev_ctx->pmo_vdev_lock);
 	qdf_mem_zero(&vdev_ctx->vdev_mc_list_req,
 		sizeof(vdev_ctx->vdev_mc_list_req));
+	/*
+	 * The list may be flushed without clearing it in fwr (e.g. vdev is
+	 * no longer connected), so forget what was installed and let the
+	 * next enable program the full list.
+	 */
+	qdf_mem_zero(&vdev_ctx->vdev_mc_list_fw,
+		sizeof(vdev_ctx->vdev_mc_list_fw));
 	qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -174,14 +181,81 @@ QDF_STATUS pmo_core_clear_mc_filter_req(struct wlan_objmgr_vdev *vdev,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * struct pmo_mc_addr_delta - mc addr list delta against fwr
+ * @fw_list: mc addr list currently installed in fwr
+ * @add_list: mc addr to be added to fwr
+ * @del_list: mc addr to be deleted from fwr
+ */
+struct pmo_mc_addr_delta {
+	struct pmo_mc_addr_list fw_list;
+	struct pmo_mc_addr_list add_list;
+	struct pmo_mc_addr_list del_list;
+};
+
+/**
+ * pmo_core_mc_addr_list_diff() - get mc addr of one list missing in another
+ * @from: list whose mc addr are looked up
+ * @in: list the mc addr are looked up in
+ * @diff: filled with mc addr of @from which are not present in @in
+ *
+ * Return: None
+ */
+static void pmo_core_mc_addr_list_diff(struct pmo_mc_addr_list *from,
+				       struct pmo_mc_addr_list *in,
+				       struct pmo_mc_addr_list *diff)
+{
+	int i, j;
+
+	diff->mc_cnt = 0;
+	for (i = 0; i < from->mc_cnt; i++) {
+		for (j = 0; j < in->mc_cnt; j++) {
+			if (qdf_is_macaddr_equal(&from->mc_addr[i],
+						 &in->mc_addr[j]))
+				break;
+		}
+
+		if (j < in->mc_cnt)
+			continue;
+
+		qdf_copy_macaddr(&diff->mc_addr[diff->mc_cnt],
+				 &from->mc_addr[i]);
+		diff->mc_cnt++;
+	}
+}
+
+/**
+ * pmo_core_update_fw_mc_list() - update fwr shadow of the mc addr list
+ * @vdev_ctx: pmo vdev priv ctx
+ * @mc_list: mc addr list now installed in fwr
+ *
+ * Return: None
+ */
+static void pmo_core_update_fw_mc_list(struct pmo_vdev_priv_obj *vdev_ctx,
+				       struct pmo_mc_addr_list *mc_list)
+{
+	qdf_spin_lock_bh(&vdev_ctx->pmo_vdev_lock);
+	qdf_mem_copy(&vdev_ctx->vdev_mc_list_fw, mc_list,
+		     sizeof(vdev_ctx->vdev_mc_list_fw));
+	vdev_ctx->vdev_mc_list_fw.is_filter_applied = !!mc_list->mc_cnt;
+	vdev_ctx->vdev_mc_list_req.is_filter_applied = !!mc_list->mc_cnt;
+	qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
+}
+
 static QDF_STATUS pmo_core_do_enable_mc_addr_list(struct wlan_objmgr_vdev *vdev,
 	struct pmo_vdev_priv_obj *vdev_ctx,
 	struct pmo_mc_addr_list *op_mc_list_req)
 {
 	QDF_STATUS status;
+	struct pmo_mc_addr_delta *delta;
+
+	delta = qdf_mem_malloc(sizeof(*delta));
+	if (!delta)
+		return QDF_STATUS_E_NOMEM;
 
 	qdf_spin_lock_bh(&vdev_ctx->pmo_vdev_lock);
-	if (!vdev_ctx->vdev_mc_list_req.mc_cnt) {
+	if (!vdev_ctx->vdev_mc_list_req.mc_cnt &&
+	    !vdev_ctx->vdev_mc_list_fw.mc_cnt) {
 		qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
 		pmo_err("mc_cnt is zero so skip to add mc list");
 		status = QDF_STATUS_E_INVAL;
@@ -189,19 +263,52 @@ static QDF_STATUS pmo_core_do_enable_mc_addr_list(struct wlan_objmgr_vdev *vdev,
 	}
 	qdf_mem_copy(op_mc_list_req, &vdev_ctx->vdev_mc_list_req,
 		sizeof(*op_mc_list_req));
+	qdf_mem_copy(&delta->fw_list, &vdev_ctx->vdev_mc_list_fw,
+		     sizeof(delta->fw_list));
 	qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
 
-	status = pmo_core_set_mc_filter_req(vdev, op_mc_list_req);
-	if (status != QDF_STATUS_SUCCESS) {
-		pmo_err("cannot apply mc filter request");
-		status = QDF_STATUS_E_INVAL;
+	pmo_core_mc_addr_list_diff(&delta->fw_list, op_mc_list_req,
+				   &delta->del_list);
+	pmo_core_mc_addr_list_diff(op_mc_list_req, &delta->fw_list,
+				   &delta->add_list);
+
+	if (!delta->del_list.mc_cnt && !delta->add_list.mc_cnt) {
+		pmo_debug("mc list unchanged, %d addr already in fwr",
+			  delta->fw_list.mc_cnt);
+		status = QDF_STATUS_SUCCESS;
 		goto out;
 	}
 
-	qdf_spin_lock_bh(&vdev_ctx->pmo_vdev_lock);
-	vdev_ctx->vdev_mc_list_req.is_filter_applied = true;
-	qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
+	pmo_debug("mc list delta: add %d del %d fwr %d",
+		  delta->add_list.mc_cnt, delta->del_list.mc_cnt,
+		  delta->fw_list.mc_cnt);
+
+	if (delta->del_list.mc_cnt) {
+		status = pmo_core_clear_mc_filter_req(vdev, &delta->del_list);
+		if (status != QDF_STATUS_SUCCESS) {
+			pmo_err("cannot clear stale mc filter");
+			status = QDF_STATUS_E_INVAL;
+			goto out;
+		}
+	}
+
+	if (delta->add_list.mc_cnt) {
+		status = pmo_core_set_mc_filter_req(vdev, &delta->add_list);
+		if (status != QDF_STATUS_SUCCESS) {
+			pmo_err("cannot apply mc filter request");
+			/* stale entries are already gone from fwr */
+			pmo_core_mc_addr_list_diff(&delta->fw_list,
+						   &delta->del_list,
+						   &delta->add_list);
+			pmo_core_update_fw_mc_list(vdev_ctx, &delta->add_list);
+			status = QDF_STATUS_E_INVAL;
+			goto out;
+		}
+	}
+
+	pmo_core_update_fw_mc_list(vdev_ctx, op_mc_list_req);
 out:
+	qdf_mem_free(delta);
 
 	return status;
 }
@@ -215,13 +322,14 @@ static QDF_STATUS pmo_core_do_disable_mc_addr_list(
 
 	qdf_spin_lock_bh(&vdev_ctx->pmo_vdev_lock);
 	/* validate filter is applied before clearing in fwr */
-	if (!vdev_ctx->vdev_mc_list_req.is_filter_applied) {
+	if (!vdev_ctx->vdev_mc_list_fw.mc_cnt) {
 		qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
 		pmo_debug("mc filter is not applied in fwr");
 		status = QDF_STATUS_E_INVAL;
 		goto out;
 	}
-	qdf_mem_copy(op_mc_list_req, &vdev_ctx->vdev_mc_list_req,
+	/* clear exactly what was installed, cached list may have changed */
+	qdf_mem_copy(op_mc_list_req, &vdev_ctx->vdev_mc_list_fw,
 		sizeof(*op_mc_list_req));
 	qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
 
@@ -232,9 +340,8 @@ static QDF_STATUS pmo_core_do_disable_mc_addr_list(
 		goto out;
 	}
 
-	qdf_spin_lock_bh(&vdev_ctx->pmo_vdev_lock);
-	vdev_ctx->vdev_mc_list_req.is_filter_applied = false;
-	qdf_spin_unlock_bh(&vdev_ctx->pmo_vdev_lock);
+	op_mc_list_req->mc_cnt = 0;
+	pmo_core_update_fw_mc_list(vdev_ctx, op_mc_list_req);
 out:
 
 	return status;
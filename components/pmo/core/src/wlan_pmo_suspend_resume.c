@@ -26,6 +26,7 @@
 #include "wlan_pmo_obj_mgmt_public_struct.h"
 #include "wlan_pmo_lphb.h"
 #include "wlan_pmo_hw_filter.h"
+#include "wlan_pmo_latency.h"
 #include "wlan_pmo_suspend_resume.h"
 #include "cdp_txrx_ops.h"
 #include "cdp_txrx_misc.h"
@@ -316,6 +317,7 @@ static void pmo_core_set_suspend_dtim(struct wlan_objmgr_psoc *psoc)
 	struct pmo_vdev_priv_obj *vdev_ctx;
 	struct pmo_psoc_priv_obj *psoc_ctx;
 	bool li_offload_support = false;
+	uint64_t begin_us;
 
 	pmo_psoc_with_ctx(psoc, psoc_ctx) {
 		li_offload_support = psoc_ctx->caps.li_offload;
@@ -331,11 +333,14 @@ static void pmo_core_set_suspend_dtim(struct wlan_objmgr_psoc *psoc)
 		if (!vdev)
 			continue;
 
+		begin_us = pmo_latency_begin();
 		vdev_ctx = pmo_vdev_get_priv(vdev);
 		if (!pmo_is_listen_interval_user_set(vdev_ctx)
 		    && !li_offload_support)
 			pmo_core_set_vdev_suspend_dtim(psoc, vdev, vdev_ctx);
 		pmo_configure_vdev_suspend_params(psoc, vdev, vdev_ctx);
+		pmo_latency_record(psoc, PMO_LATENCY_STAGE_SUSPEND_DTIM,
+				   vdev_id, begin_us);
 		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
 	}
 }
@@ -372,6 +377,7 @@ void pmo_core_configure_dynamic_wake_events(struct wlan_objmgr_psoc *psoc)
 	struct pmo_psoc_priv_obj *psoc_ctx;
 	bool enable_configured;
 	bool disable_configured;
+	uint64_t begin_us;
 
 	/* Iterate through VDEV list */
 	for (vdev_id = 0; vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS; vdev_id++) {
@@ -387,6 +393,7 @@ void pmo_core_configure_dynamic_wake_events(struct wlan_objmgr_psoc *psoc)
 		if (!vdev)
 			continue;
 
+		begin_us = pmo_latency_begin();
 		if (ucfg_scan_get_pno_in_progress(vdev)) {
 			if (ucfg_scan_get_pno_match(vdev)) {
 				pmo_set_wow_event_bitmap(EV_NLO,
@@ -423,6 +430,8 @@ void pmo_core_configure_dynamic_wake_events(struct wlan_objmgr_psoc *psoc)
 		if (disable_configured)
 			pmo_tgt_disable_wow_wakeup_event(vdev, disable_mask);
 
+		pmo_latency_record(psoc, PMO_LATENCY_STAGE_WAKE_EVENTS,
+				   vdev_id, begin_us);
 		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
 	}
 
@@ -432,6 +441,7 @@ static void pmo_core_enable_runtime_pm_offloads(struct wlan_objmgr_psoc *psoc)
 {
 	uint8_t vdev_id;
 	struct wlan_objmgr_vdev *vdev;
+	uint64_t begin_us;
 
 	/* Iterate through VDEV list */
 	for (vdev_id = 0; vdev_id < WLAN_UMAC_PSOC_MAX_VDEVS; vdev_id++) {
@@ -440,7 +450,10 @@ static void pmo_core_enable_runtime_pm_offloads(struct wlan_objmgr_psoc *psoc)
 		if (!vdev)
 			continue;
 
+		begin_us = pmo_latency_begin();
 		pmo_register_action_frame_patterns(vdev, QDF_RUNTIME_SUSPEND);
+		pmo_latency_record(psoc, PMO_LATENCY_STAGE_RUNTIME_PM_OFFLOADS,
+				   vdev_id, begin_us);
 		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
 	}
 }
@@ -475,9 +488,11 @@ static QDF_STATUS pmo_core_psoc_configure_suspend(struct wlan_objmgr_psoc *psoc,
 						  bool is_runtime_pm)
 {
 	struct pmo_psoc_priv_obj *psoc_ctx;
+	uint64_t begin_us, lphb_begin_us;
 
 	pmo_enter();
 
+	begin_us = pmo_latency_begin();
 	psoc_ctx = pmo_psoc_get_priv(psoc);
 
 	if (is_runtime_pm)
@@ -485,7 +500,10 @@ static QDF_STATUS pmo_core_psoc_configure_suspend(struct wlan_objmgr_psoc *psoc,
 
 	if (pmo_core_is_wow_applicable(psoc)) {
 		pmo_debug("WOW Suspend");
+		lphb_begin_us = pmo_latency_begin();
 		pmo_core_apply_lphb(psoc);
+		pmo_latency_record(psoc, PMO_LATENCY_STAGE_LPHB,
+				   PMO_LATENCY_NO_VDEV, lphb_begin_us);
 		/*
 		 * Dynamic wake events should not be needed for runtime PM.
 		 * Any wake events can be configed by default if they are
@@ -516,6 +534,8 @@ static QDF_STATUS pmo_core_psoc_configure_suspend(struct wlan_objmgr_psoc *psoc,
 	 */
 	pmo_core_update_wow_bus_suspend(psoc, psoc_ctx, true);
 
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_CONFIGURE_SUSPEND,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 	pmo_exit();
 
 	return QDF_STATUS_SUCCESS;
@@ -534,9 +554,13 @@ QDF_STATUS pmo_core_psoc_user_space_suspend_req(struct wlan_objmgr_psoc *psoc,
 		goto out;
 	}
 
+	pmo_latency_cycle_begin(psoc, PMO_LATENCY_SYSTEM_SUSPEND);
 	status = pmo_core_psoc_configure_suspend(psoc, false);
-	if (status != QDF_STATUS_SUCCESS)
+	if (status != QDF_STATUS_SUCCESS) {
 		pmo_err("Failed to configure suspend");
+		pmo_latency_cycle_end(psoc, PMO_LATENCY_SYSTEM_SUSPEND,
+				      status);
+	}
 
 	pmo_psoc_put_ref(psoc);
 out:
@@ -598,6 +622,7 @@ static void pmo_core_set_resume_dtim(struct wlan_objmgr_psoc *psoc)
 	struct pmo_vdev_priv_obj *vdev_ctx;
 	struct pmo_psoc_priv_obj *psoc_ctx;
 	bool li_offload_support = false;
+	uint64_t begin_us;
 
 	pmo_psoc_with_ctx(psoc, psoc_ctx) {
 		li_offload_support = psoc_ctx->caps.li_offload;
@@ -613,11 +638,14 @@ static void pmo_core_set_resume_dtim(struct wlan_objmgr_psoc *psoc)
 		if (!vdev)
 			continue;
 
+		begin_us = pmo_latency_begin();
 		vdev_ctx = pmo_vdev_get_priv(vdev);
 		if (!pmo_is_listen_interval_user_set(vdev_ctx)
 		    && !li_offload_support)
 			pmo_core_set_vdev_resume_dtim(psoc, vdev, vdev_ctx);
 		pmo_configure_vdev_resume_params(psoc, vdev, vdev_ctx);
+		pmo_latency_record(psoc, PMO_LATENCY_STAGE_RESUME_DTIM,
+				   vdev_id, begin_us);
 		wlan_objmgr_vdev_release_ref(vdev, WLAN_PMO_ID);
 	}
 }
@@ -668,9 +696,11 @@ static QDF_STATUS pmo_core_psoc_configure_resume(struct wlan_objmgr_psoc *psoc,
 						 bool is_runtime_pm)
 {
 	struct pmo_psoc_priv_obj *psoc_ctx;
+	uint64_t begin_us;
 
 	pmo_enter();
 
+	begin_us = pmo_latency_begin();
 	psoc_ctx = pmo_psoc_get_priv(psoc);
 	if (is_runtime_pm)
 		pmo_core_disable_runtime_pm_offloads(psoc);
@@ -685,6 +715,8 @@ static QDF_STATUS pmo_core_psoc_configure_resume(struct wlan_objmgr_psoc *psoc,
 	pmo_core_update_wow_bus_suspend(psoc, psoc_ctx, false);
 	pmo_unpause_all_vdev(psoc, psoc_ctx);
 
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_CONFIGURE_RESUME,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 	pmo_exit();
 
 	return QDF_STATUS_SUCCESS;
@@ -706,6 +738,7 @@ QDF_STATUS pmo_core_psoc_user_space_resume_req(struct wlan_objmgr_psoc *psoc,
 	status = pmo_core_psoc_configure_resume(psoc, false);
 	if (status != QDF_STATUS_SUCCESS)
 		pmo_err("Failed to configure resume");
+	pmo_latency_cycle_end(psoc, PMO_LATENCY_SYSTEM_RESUME, status);
 
 	pmo_psoc_put_ref(psoc);
 out:
@@ -733,6 +766,7 @@ pmo_core_enable_wow_in_fw(struct wlan_objmgr_psoc *psoc,
 	struct pmo_wow_cmd_params param = {0};
 	struct pmo_psoc_cfg *psoc_cfg = &psoc_ctx->psoc_cfg;
 	QDF_STATUS status;
+	uint64_t begin_us;
 
 	pmo_enter();
 	qdf_event_reset(&psoc_ctx->wow.target_suspend);
@@ -816,7 +850,10 @@ pmo_core_enable_wow_in_fw(struct wlan_objmgr_psoc *psoc,
 		param.flags |= WMI_WOW_FLAG_MOD_DTIM_ON_SYS_SUSPEND;
 	}
 
+	begin_us = pmo_latency_begin();
 	status = pmo_tgt_psoc_send_wow_enable_req(psoc, &param);
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_WOW_ENABLE_SEND,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 	if (status != QDF_STATUS_SUCCESS) {
 		pmo_err("Failed to enable wow in fw");
 		goto out;
@@ -824,8 +861,11 @@ pmo_core_enable_wow_in_fw(struct wlan_objmgr_psoc *psoc,
 
 	pmo_tgt_update_target_suspend_flag(psoc, true);
 
+	begin_us = pmo_latency_begin();
 	status = qdf_wait_for_event_completion(&psoc_ctx->wow.target_suspend,
 					       PMO_TARGET_SUSPEND_TIMEOUT);
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_WOW_ENABLE_ACK,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		pmo_err("Failed to receive WoW Enable Ack from FW");
 		pmo_err("Credits:%d; Pending_Cmds: %d",
@@ -873,9 +913,11 @@ QDF_STATUS pmo_core_psoc_suspend_target(struct wlan_objmgr_psoc *psoc,
 	struct pmo_suspend_params param;
 	struct pmo_psoc_priv_obj *psoc_ctx;
 	void *dp_soc = pmo_core_psoc_get_dp_handle(psoc);
+	uint64_t begin_us;
 
 	pmo_enter();
 
+	begin_us = pmo_latency_begin();
 	psoc_ctx = pmo_psoc_get_priv(psoc);
 
 	cdp_process_target_suspend_req(dp_soc, OL_TXRX_PDEV_ID);
@@ -898,6 +940,8 @@ QDF_STATUS pmo_core_psoc_suspend_target(struct wlan_objmgr_psoc *psoc,
 		pmo_tgt_update_target_suspend_acked_flag(psoc, true);
 	}
 
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_TARGET_SUSPEND,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 out:
 	pmo_exit();
 
@@ -912,6 +956,7 @@ QDF_STATUS pmo_core_psoc_bus_suspend_req(struct wlan_objmgr_psoc *psoc,
 	QDF_STATUS status;
 	bool wow_mode_selected = false;
 	qdf_time_t begin, end;
+	uint64_t begin_us;
 
 	pmo_enter();
 	if (!psoc) {
@@ -937,6 +982,7 @@ QDF_STATUS pmo_core_psoc_bus_suspend_req(struct wlan_objmgr_psoc *psoc,
 	wow_mode_selected = pmo_core_is_wow_enabled(psoc_ctx);
 	pmo_debug("wow mode selected %d", wow_mode_selected);
 
+	begin_us = pmo_latency_begin();
 	begin = qdf_get_log_timestamp_usecs();
 	if (wow_mode_selected)
 		status = pmo_core_enable_wow_in_fw(psoc, psoc_ctx,
@@ -947,6 +993,11 @@ QDF_STATUS pmo_core_psoc_bus_suspend_req(struct wlan_objmgr_psoc *psoc,
 	end = qdf_get_log_timestamp_usecs();
 	pmo_debug("fw took total time %lu microseconds to enable wow",
 		  end - begin);
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_BUS_SUSPEND,
+			   PMO_LATENCY_NO_VDEV, begin_us);
+	if (type == QDF_SYSTEM_SUSPEND)
+		pmo_latency_cycle_end(psoc, PMO_LATENCY_SYSTEM_SUSPEND,
+				      status);
 
 	pmo_psoc_put_ref(psoc);
 out:
@@ -975,6 +1026,7 @@ QDF_STATUS pmo_core_psoc_bus_runtime_suspend(struct wlan_objmgr_psoc *psoc,
 	struct pmo_psoc_priv_obj *psoc_ctx;
 	qdf_time_t begin, end;
 	int pending;
+	uint64_t begin_us;
 
 	pmo_enter();
 
@@ -990,6 +1042,7 @@ QDF_STATUS pmo_core_psoc_bus_runtime_suspend(struct wlan_objmgr_psoc *psoc,
 		goto out;
 	}
 
+	pmo_latency_cycle_begin(psoc, PMO_LATENCY_RUNTIME_SUSPEND);
 	hif_ctx = pmo_core_psoc_get_hif_handle(psoc);
 	dp_soc = pmo_core_psoc_get_dp_handle(psoc);
 	pdev_id = pmo_core_psoc_get_txrx_handle(psoc);
@@ -1034,7 +1087,10 @@ QDF_STATUS pmo_core_psoc_bus_runtime_suspend(struct wlan_objmgr_psoc *psoc,
 	if (status != QDF_STATUS_SUCCESS)
 		goto pmo_resume_configure;
 
+	begin_us = pmo_latency_begin();
 	ret = hif_runtime_suspend(hif_ctx);
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_HIF_RUNTIME_SUSPEND,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 	if (ret) {
 		status = qdf_status_from_os_return(ret);
 		goto pmo_bus_resume;
@@ -1048,11 +1104,14 @@ QDF_STATUS pmo_core_psoc_bus_runtime_suspend(struct wlan_objmgr_psoc *psoc,
 	}
 
 	if (pld_cb) {
+		begin_us = pmo_latency_begin();
 		begin = qdf_get_log_timestamp_usecs();
 		ret = pld_cb();
 		end = qdf_get_log_timestamp_usecs();
 		pmo_debug("runtime pci bus suspend took total time %lu microseconds",
 			  end - begin);
+		pmo_latency_record(psoc, PMO_LATENCY_STAGE_PLD_RUNTIME_SUSPEND,
+				   PMO_LATENCY_NO_VDEV, begin_us);
 
 		if (ret) {
 			status = qdf_status_from_os_return(ret);
@@ -1113,6 +1172,7 @@ pre_runtime_failure:
 	hif_process_runtime_suspend_failure(hif_ctx);
 
 dec_psoc_ref:
+	pmo_latency_cycle_end(psoc, PMO_LATENCY_RUNTIME_SUSPEND, status);
 	pmo_psoc_put_ref(psoc);
 
 out:
@@ -1131,6 +1191,7 @@ QDF_STATUS pmo_core_psoc_bus_runtime_resume(struct wlan_objmgr_psoc *psoc,
 	void *htc_ctx;
 	QDF_STATUS status;
 	qdf_time_t begin, end;
+	uint64_t begin_us;
 
 	pmo_enter();
 
@@ -1146,6 +1207,7 @@ QDF_STATUS pmo_core_psoc_bus_runtime_resume(struct wlan_objmgr_psoc *psoc,
 		goto out;
 	}
 
+	pmo_latency_cycle_begin(psoc, PMO_LATENCY_RUNTIME_RESUME);
 	hif_ctx = pmo_core_psoc_get_hif_handle(psoc);
 	dp_soc = pmo_core_psoc_get_dp_handle(psoc);
 	pdev_id = pmo_core_psoc_get_txrx_handle(psoc);
@@ -1160,18 +1222,25 @@ QDF_STATUS pmo_core_psoc_bus_runtime_resume(struct wlan_objmgr_psoc *psoc,
 
 	hif_pre_runtime_resume(hif_ctx);
 	if (pld_cb) {
+		begin_us = pmo_latency_begin();
 		begin = qdf_get_log_timestamp_usecs();
 		ret = pld_cb();
 		end = qdf_get_log_timestamp_usecs();
 		pmo_debug("pci bus resume took total time %lu microseconds",
 			  end - begin);
+		pmo_latency_record(psoc, PMO_LATENCY_STAGE_PLD_RUNTIME_RESUME,
+				   PMO_LATENCY_NO_VDEV, begin_us);
 		if (ret) {
 			status = QDF_STATUS_E_FAILURE;
 			goto fail;
 		}
 	}
 
-	if (hif_runtime_resume(hif_ctx)) {
+	begin_us = pmo_latency_begin();
+	ret = hif_runtime_resume(hif_ctx);
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_HIF_RUNTIME_RESUME,
+			   PMO_LATENCY_NO_VDEV, begin_us);
+	if (ret) {
 		status = QDF_STATUS_E_FAILURE;
 		goto fail;
 	}
@@ -1204,6 +1273,7 @@ fail:
 		qdf_trigger_self_recovery(psoc, QDF_RESUME_TIMEOUT);
 
 dec_psoc_ref:
+	pmo_latency_cycle_end(psoc, PMO_LATENCY_RUNTIME_RESUME, status);
 	pmo_psoc_put_ref(psoc);
 
 out:
@@ -1229,8 +1299,10 @@ QDF_STATUS pmo_core_psoc_send_host_wakeup_ind_to_fw(
 			struct pmo_psoc_priv_obj *psoc_ctx)
 {
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	uint64_t begin_us;
 
 	pmo_enter();
+	begin_us = pmo_latency_begin();
 	qdf_event_reset(&psoc_ctx->wow.target_resume);
 
 	status = pmo_tgt_psoc_send_host_wakeup_ind(psoc);
@@ -1255,6 +1327,8 @@ QDF_STATUS pmo_core_psoc_send_host_wakeup_ind_to_fw(
 		pmo_tgt_update_target_suspend_flag(psoc, false);
 		pmo_tgt_update_target_suspend_acked_flag(psoc, false);
 	}
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_WOW_DISABLE,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 out:
 	pmo_exit();
 
@@ -1303,8 +1377,10 @@ QDF_STATUS pmo_core_psoc_resume_target(struct wlan_objmgr_psoc *psoc,
 		struct pmo_psoc_priv_obj *psoc_ctx)
 {
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	uint64_t begin_us;
 
 	pmo_enter();
+	begin_us = pmo_latency_begin();
 	qdf_event_reset(&psoc_ctx->wow.target_resume);
 
 	status = pmo_tgt_psoc_send_target_resume_req(psoc);
@@ -1327,6 +1403,8 @@ QDF_STATUS pmo_core_psoc_resume_target(struct wlan_objmgr_psoc *psoc,
 		pmo_tgt_update_target_suspend_flag(psoc, false);
 		pmo_tgt_update_target_suspend_acked_flag(psoc, false);
 	}
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_TARGET_RESUME,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 out:
 	pmo_exit();
 
@@ -1340,6 +1418,7 @@ QDF_STATUS pmo_core_psoc_bus_resume_req(struct wlan_objmgr_psoc *psoc,
 	bool wow_mode;
 	QDF_STATUS status;
 	qdf_time_t begin, end;
+	uint64_t begin_us;
 
 	pmo_enter();
 	if (!psoc) {
@@ -1354,6 +1433,9 @@ QDF_STATUS pmo_core_psoc_bus_resume_req(struct wlan_objmgr_psoc *psoc,
 		goto out;
 	}
 
+	if (type == QDF_SYSTEM_SUSPEND)
+		pmo_latency_cycle_begin(psoc, PMO_LATENCY_SYSTEM_RESUME);
+
 	psoc_ctx = pmo_psoc_get_priv(psoc);
 	wow_mode = pmo_core_is_wow_enabled(psoc_ctx);
 	pmo_debug("wow mode %d", wow_mode);
@@ -1367,6 +1449,7 @@ QDF_STATUS pmo_core_psoc_bus_resume_req(struct wlan_objmgr_psoc *psoc,
 		goto out;
 	}
 
+	begin_us = pmo_latency_begin();
 	begin = qdf_get_log_timestamp_usecs();
 	if (wow_mode)
 		status = pmo_core_psoc_disable_wow_in_fw(psoc, psoc_ctx);
@@ -1375,6 +1458,8 @@ QDF_STATUS pmo_core_psoc_bus_resume_req(struct wlan_objmgr_psoc *psoc,
 	end = qdf_get_log_timestamp_usecs();
 	pmo_debug("fw took total time %lu microseconds to disable wow",
 		  end - begin);
+	pmo_latency_record(psoc, PMO_LATENCY_STAGE_BUS_RESUME,
+			   PMO_LATENCY_NO_VDEV, begin_us);
 
 	pmo_psoc_put_ref(psoc);
 
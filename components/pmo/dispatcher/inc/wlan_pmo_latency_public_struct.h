@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+/**
+ * DOC: Declare various struct, macros which shall be used in
+ * pmo suspend/resume latency tracer.
+ *
+ * Note: This file shall not contain public API's prototype/declarations.
+ *
+ */
+
+#ifndef _WLAN_PMO_LATENCY_PUBLIC_STRUCT_H_
+#define _WLAN_PMO_LATENCY_PUBLIC_STRUCT_H_
+
+#include "qdf_types.h"
+#include "qdf_lock.h"
+
+#define PMO_LATENCY_HIST_BUCKETS 16
+#define PMO_LATENCY_HIST_BASE_US 64
+#define PMO_LATENCY_MAX_CYCLES 16
+#define PMO_LATENCY_MAX_VDEV_RECORDS 64
+#define PMO_LATENCY_NO_VDEV 0xff
+
+/**
+ * enum pmo_latency_cycle_type - suspend/resume cycle traced by pmo
+ * @PMO_LATENCY_SYSTEM_SUSPEND: system suspend, user space suspend request
+ *	till bus suspend
+ * @PMO_LATENCY_SYSTEM_RESUME: system resume, bus resume till user space
+ *	resume request
+ * @PMO_LATENCY_RUNTIME_SUSPEND: runtime PM suspend
+ * @PMO_LATENCY_RUNTIME_RESUME: runtime PM resume
+ * @PMO_LATENCY_CYCLE_TYPE_MAX: max value
+ */
+enum pmo_latency_cycle_type {
+	PMO_LATENCY_SYSTEM_SUSPEND,
+	PMO_LATENCY_SYSTEM_RESUME,
+	PMO_LATENCY_RUNTIME_SUSPEND,
+	PMO_LATENCY_RUNTIME_RESUME,
+	PMO_LATENCY_CYCLE_TYPE_MAX,
+};
+
+/**
+ * enum pmo_latency_stage - stage of a suspend/resume cycle
+ * @PMO_LATENCY_STAGE_CONFIGURE_SUSPEND: configure suspend, all sub stages
+ * @PMO_LATENCY_STAGE_RUNTIME_PM_OFFLOADS: runtime PM offloads, per vdev
+ * @PMO_LATENCY_STAGE_LPHB: apply low power heart beat
+ * @PMO_LATENCY_STAGE_WAKE_EVENTS: dynamic wake events, per vdev
+ * @PMO_LATENCY_STAGE_SUSPEND_DTIM: suspend dtim and vdev params, per vdev
+ * @PMO_LATENCY_STAGE_BUS_SUSPEND: bus suspend, all sub stages
+ * @PMO_LATENCY_STAGE_WOW_ENABLE_SEND: send wow enable command
+ * @PMO_LATENCY_STAGE_WOW_ENABLE_ACK: wait for wow enable ack
+ * @PMO_LATENCY_STAGE_TARGET_SUSPEND: pdev suspend and ack
+ * @PMO_LATENCY_STAGE_HIF_RUNTIME_SUSPEND: hif runtime suspend
+ * @PMO_LATENCY_STAGE_PLD_RUNTIME_SUSPEND: pld runtime bus suspend
+ * @PMO_LATENCY_STAGE_PLD_RUNTIME_RESUME: pld runtime bus resume
+ * @PMO_LATENCY_STAGE_HIF_RUNTIME_RESUME: hif runtime resume
+ * @PMO_LATENCY_STAGE_BUS_RESUME: bus resume, all sub stages
+ * @PMO_LATENCY_STAGE_WOW_DISABLE: host wakeup indication and resume event
+ * @PMO_LATENCY_STAGE_TARGET_RESUME: pdev resume and resume event
+ * @PMO_LATENCY_STAGE_CONFIGURE_RESUME: configure resume, all sub stages
+ * @PMO_LATENCY_STAGE_RESUME_DTIM: resume dtim and vdev params, per vdev
+ * @PMO_LATENCY_STAGE_MAX: max value
+ */
+enum pmo_latency_stage {
+	PMO_LATENCY_STAGE_CONFIGURE_SUSPEND,
+	PMO_LATENCY_STAGE_RUNTIME_PM_OFFLOADS,
+	PMO_LATENCY_STAGE_LPHB,
+	PMO_LATENCY_STAGE_WAKE_EVENTS,
+	PMO_LATENCY_STAGE_SUSPEND_DTIM,
+	PMO_LATENCY_STAGE_BUS_SUSPEND,
+	PMO_LATENCY_STAGE_WOW_ENABLE_SEND,
+	PMO_LATENCY_STAGE_WOW_ENABLE_ACK,
+	PMO_LATENCY_STAGE_TARGET_SUSPEND,
+	PMO_LATENCY_STAGE_HIF_RUNTIME_SUSPEND,
+	PMO_LATENCY_STAGE_PLD_RUNTIME_SUSPEND,
+	PMO_LATENCY_STAGE_PLD_RUNTIME_RESUME,
+	PMO_LATENCY_STAGE_HIF_RUNTIME_RESUME,
+	PMO_LATENCY_STAGE_BUS_RESUME,
+	PMO_LATENCY_STAGE_WOW_DISABLE,
+	PMO_LATENCY_STAGE_TARGET_RESUME,
+	PMO_LATENCY_STAGE_CONFIGURE_RESUME,
+	PMO_LATENCY_STAGE_RESUME_DTIM,
+	PMO_LATENCY_STAGE_MAX,
+};
+
+#ifdef WLAN_PMO_LATENCY_TRACE
+/**
+ * struct pmo_latency_hist - latency histogram
+ * @count: number of samples
+ * @last_us: last sample in microseconds
+ * @max_us: max sample in microseconds
+ * @total_us: sum of all samples in microseconds
+ * @bucket: log2 buckets, bucket 0 counts samples below
+ *	PMO_LATENCY_HIST_BASE_US and bucket n samples below
+ *	PMO_LATENCY_HIST_BASE_US << n, last bucket counts all the rest
+ */
+struct pmo_latency_hist {
+	uint32_t count;
+	uint32_t last_us;
+	uint32_t max_us;
+	uint64_t total_us;
+	uint32_t bucket[PMO_LATENCY_HIST_BUCKETS];
+};
+
+/**
+ * struct pmo_latency_cycle - one traced suspend/resume cycle
+ * @id: cycle sequence number
+ * @type: cycle type
+ * @status: status the cycle completed with
+ * @start_us: log timestamp the cycle started at
+ * @total_us: duration of the cycle in microseconds
+ * @stage_us: time spent in each stage, summed over vdevs
+ */
+struct pmo_latency_cycle {
+	uint32_t id;
+	enum pmo_latency_cycle_type type;
+	QDF_STATUS status;
+	uint64_t start_us;
+	uint32_t total_us;
+	uint32_t stage_us[PMO_LATENCY_STAGE_MAX];
+};
+
+/**
+ * struct pmo_latency_vdev_record - per vdev stage sample
+ * @cycle_id: cycle the sample belongs to, 0 if taken outside a cycle
+ * @vdev_id: vdev id
+ * @stage: enum pmo_latency_stage
+ * @duration_us: duration in microseconds
+ */
+struct pmo_latency_vdev_record {
+	uint32_t cycle_id;
+	uint8_t vdev_id;
+	uint8_t stage;
+	uint32_t duration_us;
+};
+
+/**
+ * struct pmo_latency_tracer - suspend/resume latency tracer
+ * @lock: protects the tracer
+ * @cycle_active: a cycle is being traced
+ * @cur: cycle being traced
+ * @next_cycle_id: id of the next cycle
+ * @cycles: ring of completed cycles
+ * @cycle_idx: next write position in @cycles
+ * @num_cycles: number of valid entries in @cycles
+ * @vdev_records: ring of per vdev samples
+ * @vdev_record_idx: next write position in @vdev_records
+ * @num_vdev_records: number of valid entries in @vdev_records
+ * @stage_hist: latency histogram of each stage
+ * @cycle_hist: latency histogram of each cycle type
+ */
+struct pmo_latency_tracer {
+	qdf_spinlock_t lock;
+	bool cycle_active;
+	struct pmo_latency_cycle cur;
+	uint32_t next_cycle_id;
+	struct pmo_latency_cycle cycles[PMO_LATENCY_MAX_CYCLES];
+	uint8_t cycle_idx;
+	uint8_t num_cycles;
+	struct pmo_latency_vdev_record
+		vdev_records[PMO_LATENCY_MAX_VDEV_RECORDS];
+	uint8_t vdev_record_idx;
+	uint8_t num_vdev_records;
+	struct pmo_latency_hist stage_hist[PMO_LATENCY_STAGE_MAX];
+	struct pmo_latency_hist cycle_hist[PMO_LATENCY_CYCLE_TYPE_MAX];
+};
+
+#endif /* WLAN_PMO_LATENCY_TRACE */
+
+#endif /* end  of _WLAN_PMO_LATENCY_PUBLIC_STRUCT_H_ */
@@ -1982,4 +1982,37 @@ ucfg_pmo_get_runtime_pm_delay(struct wlan_objmgr_psoc *psoc)
  */
 bool
 ucfg_pmo_get_enable_sap_suspend(struct wlan_objmgr_psoc *psoc);
+
+#ifdef WLAN_PMO_LATENCY_TRACE
+/**
+ * ucfg_pmo_latency_print() - dump suspend/resume latency trace into a buffer
+ * @psoc: objmgr psoc handle
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @plen: number of bytes written into @buf, filled by this API
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS ucfg_pmo_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+				  ssize_t buf_len, ssize_t *plen);
+
+/**
+ * ucfg_pmo_latency_reset() - clear suspend/resume latency trace
+ * @psoc: objmgr psoc handle
+ *
+ * Return: None
+ */
+void ucfg_pmo_latency_reset(struct wlan_objmgr_psoc *psoc);
+#else
+static inline QDF_STATUS
+ucfg_pmo_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+		       ssize_t buf_len, ssize_t *plen)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline void ucfg_pmo_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif /* WLAN_PMO_LATENCY_TRACE */
 #endif /* end  of _WLAN_PMO_UCFG_API_H_ */
@@ -24,6 +24,7 @@
 #include "wlan_pmo_tgt_api.h"
 #include "wlan_pmo_static_config.h"
 #include "wlan_pmo_main.h"
+#include "wlan_pmo_latency.h"
 #include "target_if_pmo.h"
 
 QDF_STATUS pmo_init(void)
@@ -173,6 +174,7 @@ QDF_STATUS pmo_psoc_object_created_notification(
 		goto out;
 	}
 	qdf_spinlock_create(&psoc_ctx->lock);
+	pmo_latency_init(psoc_ctx);
 	qdf_wake_lock_create(&psoc_ctx->wow.wow_wake_lock, "pmo_wow_wl");
 	status = qdf_event_create(&psoc_ctx->wow.target_suspend);
 	if (status != QDF_STATUS_SUCCESS) {
@@ -215,6 +217,7 @@ QDF_STATUS pmo_psoc_object_destroyed_notification(
 		goto out;
 	}
 
+	pmo_latency_deinit(psoc_ctx);
 	qdf_spinlock_destroy(&psoc_ctx->lock);
 	qdf_event_destroy(&psoc_ctx->wow.target_suspend);
 	qdf_event_destroy(&psoc_ctx->wow.target_resume);
@@ -31,6 +31,7 @@
 #include "wlan_pmo_suspend_resume.h"
 #include "wlan_pmo_pkt_filter.h"
 #include "wlan_pmo_hw_filter.h"
+#include "wlan_pmo_latency.h"
 #include "wlan_pmo_cfg.h"
 #include "wlan_pmo_static_config.h"
 #include "cfg_ucfg_api.h"
@@ -869,3 +870,16 @@ ucfg_pmo_get_active_mc_bc_apf_mode(struct wlan_objmgr_psoc *psoc)
 
 	return pmo_psoc_ctx->psoc_cfg.active_mc_bc_apf_mode;
 }
+
+#ifdef WLAN_PMO_LATENCY_TRACE
+QDF_STATUS ucfg_pmo_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+				  ssize_t buf_len, ssize_t *plen)
+{
+	return pmo_latency_print(psoc, buf, buf_len, plen);
+}
+
+void ucfg_pmo_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+	pmo_latency_reset(psoc);
+}
+#endif
@@ -179,13 +179,89 @@ void tdls_implicit_enable(struct tdls_vdev_priv_obj *tdls_vdev)
 			   tdls_vdev->threshold_config.tx_period_t);
 }
 
+/**
+ * tdls_ct_hash() - connection tracker hash of a peer mac address
+ * @mac_addr: peer mac address
+ *
+ * Return: first bucket of @mac_addr in the connection tracker tables
+ */
+static inline uint8_t tdls_ct_hash(struct qdf_mac_addr *mac_addr)
+{
+	return (mac_addr->bytes[3] ^ mac_addr->bytes[4] ^ mac_addr->bytes[5]) &
+		(WLAN_TDLS_CT_HASH_SIZE - 1);
+}
+
+/**
+ * tdls_ct_entry_read() - read a connection tracker entry of any CPU
+ * @entry: entry to read
+ * @epoch: sampling interval the entry has to count packets for
+ * @sample: filled with the content of @entry
+ *
+ * The CPU owning @entry may reclaim it for another peer meanwhile, which
+ * is detected from the epoch changing.
+ *
+ * Return: true if @sample holds the packets @entry counted during @epoch
+ */
+static bool tdls_ct_entry_read(struct tdls_ct_entry *entry, uint32_t epoch,
+			       struct tdls_ct_entry *sample)
+{
+	if (READ_ONCE(entry->epoch) != epoch)
+		return false;
+
+	smp_rmb();
+	qdf_copy_macaddr(&sample->mac_address, &entry->mac_address);
+	sample->tx_packet_cnt = READ_ONCE(entry->tx_packet_cnt);
+	sample->rx_packet_cnt = READ_ONCE(entry->rx_packet_cnt);
+	smp_rmb();
+
+	return READ_ONCE(entry->epoch) == epoch;
+}
+
+/**
+ * tdls_ct_table_add() - merge a sample in the table of the interval
+ * @mac_table: peers sampled during the interval
+ * @mac_entries: number of valid entries in @mac_table
+ * @sample: sample of a CPU
+ *
+ * Return: None
+ */
+static void tdls_ct_table_add(struct tdls_conn_tracker_mac_table *mac_table,
+			      uint8_t *mac_entries,
+			      struct tdls_ct_entry *sample)
+{
+	uint8_t mac_cnt;
+
+	for (mac_cnt = 0; mac_cnt < *mac_entries; mac_cnt++) {
+		if (qdf_is_macaddr_equal(&mac_table[mac_cnt].mac_address,
+					 &sample->mac_address))
+			goto add;
+	}
+
+	/* If we have more than 8 peers within an interval, we will
+	 * stop tracking the new ones till the next interval
+	 */
+	if (mac_cnt >= WLAN_TDLS_CT_TABLE_SIZE)
+		return;
+
+	qdf_copy_macaddr(&mac_table[mac_cnt].mac_address,
+			 &sample->mac_address);
+	(*mac_entries)++;
+
+add:
+	mac_table[mac_cnt].tx_packet_cnt += sample->tx_packet_cnt;
+	mac_table[mac_cnt].rx_packet_cnt += sample->rx_packet_cnt;
+}
+
 /**
  * tdls_ct_sampling_tx_rx() - collect tx/rx traffic sample
  * @tdls_vdev_obj: tdls vdev object
  * @tdls_soc_obj: tdls soc object
  *
  * Function to update data traffic information in tdls connection
- * tracker data structure for connection tracker operation
+ * tracker data structure for connection tracker operation. The per CPU
+ * tables of the interval which just elapsed are folded, the packets of a
+ * CPU still counting for that interval while it is being closed may be
+ * missed.
  *
  * Return: None
  */
@@ -193,35 +269,49 @@ static void tdls_ct_sampling_tx_rx(struct tdls_vdev_priv_obj *tdls_vdev,
 				   struct tdls_soc_priv_obj *tdls_soc)
 {
 	struct tdls_peer *curr_peer;
-	uint8_t mac[QDF_MAC_ADDR_SIZE];
+	struct tdls_ct_pcpu_table *table;
+	struct tdls_ct_entry sample;
+	struct wlan_objmgr_peer *bss_peer;
+	struct qdf_mac_addr bss_mac = QDF_MAC_ADDR_ZERO_INIT;
 	uint8_t mac_cnt;
-	uint8_t mac_entries;
+	uint8_t mac_entries = 0;
 	struct tdls_conn_tracker_mac_table mac_table[WLAN_TDLS_CT_TABLE_SIZE];
+	uint32_t epoch;
+	int cpu, i;
 
-	qdf_spin_lock_bh(&tdls_soc->tdls_ct_spinlock);
-
-	if (0 == tdls_vdev->valid_mac_entries) {
-		qdf_spin_unlock_bh(&tdls_soc->tdls_ct_spinlock);
-		return;
+	/* traffic with the AP is counted as well, it is dropped here */
+	bss_peer = wlan_objmgr_vdev_try_get_bsspeer(tdls_vdev->vdev,
+						    WLAN_TDLS_NB_ID);
+	if (bss_peer) {
+		qdf_mem_copy(bss_mac.bytes, bss_peer->macaddr,
+			     QDF_MAC_ADDR_SIZE);
+		wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
 	}
 
-	mac_entries = QDF_MIN(tdls_vdev->valid_mac_entries,
-			      WLAN_TDLS_CT_TABLE_SIZE);
-
-	qdf_mem_copy(mac_table, tdls_vdev->ct_peer_table,
-	       (sizeof(struct tdls_conn_tracker_mac_table)) * mac_entries);
-
-	qdf_mem_zero(tdls_vdev->ct_peer_table,
-	       (sizeof(struct tdls_conn_tracker_mac_table)) * mac_entries);
+	/* close the interval, its entries are reclaimed from now on */
+	epoch = tdls_vdev->ct_epoch;
+	WRITE_ONCE(tdls_vdev->ct_epoch, epoch + 1 ? epoch + 1 : 1);
+	smp_mb();
+
+	qdf_mem_zero(mac_table, sizeof(mac_table));
+	for_each_possible_cpu(cpu) {
+		table = per_cpu_ptr(tdls_vdev->ct_pcpu_table, cpu);
+		for (i = 0; i < WLAN_TDLS_CT_HASH_SIZE; i++) {
+			if (!tdls_ct_entry_read(&table->entries[i], epoch,
+						&sample))
+				continue;
 
-	tdls_vdev->valid_mac_entries = 0;
+			if (qdf_is_macaddr_equal(&sample.mac_address,
+						 &bss_mac))
+				continue;
 
-	qdf_spin_unlock_bh(&tdls_soc->tdls_ct_spinlock);
+			tdls_ct_table_add(mac_table, &mac_entries, &sample);
+		}
+	}
 
 	for (mac_cnt = 0; mac_cnt < mac_entries; mac_cnt++) {
-		qdf_mem_copy(mac, mac_table[mac_cnt].mac_address.bytes,
-		       QDF_MAC_ADDR_SIZE);
-		curr_peer = tdls_get_peer(tdls_vdev, mac);
+		curr_peer = tdls_get_peer(tdls_vdev,
+					  mac_table[mac_cnt].mac_address.bytes);
 		if (curr_peer) {
 			curr_peer->tx_pkt =
 			mac_table[mac_cnt].tx_packet_cnt;
@@ -231,16 +321,78 @@ static void tdls_ct_sampling_tx_rx(struct tdls_vdev_priv_obj *tdls_vdev,
 	}
 }
 
+/**
+ * tdls_ct_count() - count a packet of a peer in the table of this CPU
+ * @tdls_vdev: tdls vdev object
+ * @mac_addr: peer mac address
+ * @tx: true for a tx packet, false for a rx packet
+ *
+ * Runs for every data packet, so neither a lock nor an objmgr reference
+ * is taken. Each CPU only writes its own table, and an entry is reclaimed
+ * once the interval it counted for is closed. A packet is not counted if
+ * other peers took every bucket of @mac_addr during the interval.
+ *
+ * Packets are counted from softirq and from process context, such as the
+ * RX thread, so bottom halves are disabled while the table of this CPU is
+ * updated. The interval is read once they are, an entry of a later
+ * interval than the one read is still in use and only the entries of an
+ * earlier interval are reclaimed.
+ *
+ * Return: None
+ */
+static void tdls_ct_count(struct tdls_vdev_priv_obj *tdls_vdev,
+			  struct qdf_mac_addr *mac_addr, bool tx)
+{
+	struct tdls_ct_pcpu_table *table;
+	struct tdls_ct_entry *entry;
+	uint32_t epoch;
+	uint8_t hash = tdls_ct_hash(mac_addr);
+	uint8_t i;
+
+	local_bh_disable();
+	epoch = READ_ONCE(tdls_vdev->ct_epoch);
+	table = this_cpu_ptr(tdls_vdev->ct_pcpu_table);
+
+	for (i = 0; i < WLAN_TDLS_CT_HASH_WAYS; i++) {
+		entry = &table->entries[(hash + i) &
+					(WLAN_TDLS_CT_HASH_SIZE - 1)];
+		/* the epoch wraps from U32_MAX to 1 */
+		if (entry->epoch && (int32_t)(entry->epoch - epoch) >= 0) {
+			if (qdf_is_macaddr_equal(&entry->mac_address,
+						 mac_addr))
+				goto count;
+			continue;
+		}
+
+		/* stale, the sampler skips the entry while it is rewritten */
+		WRITE_ONCE(entry->epoch, 0);
+		smp_wmb();
+		qdf_copy_macaddr(&entry->mac_address, mac_addr);
+		entry->tx_packet_cnt = 0;
+		entry->rx_packet_cnt = 0;
+		smp_wmb();
+		WRITE_ONCE(entry->epoch, epoch);
+		goto count;
+	}
+
+	goto put;
+
+count:
+	if (tx)
+		WRITE_ONCE(entry->tx_packet_cnt, entry->tx_packet_cnt + 1);
+	else
+		WRITE_ONCE(entry->rx_packet_cnt, entry->rx_packet_cnt + 1);
+
+put:
+	local_bh_enable();
+}
+
 void tdls_update_rx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 				 struct qdf_mac_addr *mac_addr,
 				 struct qdf_mac_addr *dest_mac_addr)
 {
 	struct tdls_vdev_priv_obj *tdls_vdev_obj;
 	struct tdls_soc_priv_obj *tdls_soc_obj;
-	uint8_t mac_cnt;
-	uint8_t valid_mac_entries;
-	struct tdls_conn_tracker_mac_table *mac_table;
-	struct wlan_objmgr_peer *bss_peer;
 
 	if (QDF_STATUS_SUCCESS != tdls_get_vdev_objects(vdev, &tdls_vdev_obj,
 							&tdls_soc_obj))
@@ -259,40 +411,7 @@ void tdls_update_rx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 			 QDF_MAC_ADDR_SIZE))
 		return;
 
-	bss_peer = wlan_objmgr_vdev_try_get_bsspeer(vdev, WLAN_TDLS_NB_ID);
-	if (bss_peer) {
-		if (!qdf_mem_cmp(bss_peer->macaddr, mac_addr,
-				 QDF_MAC_ADDR_SIZE)) {
-			wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-			return;
-		}
-		wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-	}
-	qdf_spin_lock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	valid_mac_entries = tdls_vdev_obj->valid_mac_entries;
-	mac_table = tdls_vdev_obj->ct_peer_table;
-
-	for (mac_cnt = 0; mac_cnt < valid_mac_entries; mac_cnt++) {
-		if (qdf_mem_cmp(mac_table[mac_cnt].mac_address.bytes,
-		    mac_addr, QDF_MAC_ADDR_SIZE) == 0) {
-			mac_table[mac_cnt].rx_packet_cnt++;
-			goto rx_cnt_return;
-		}
-	}
-
-	/* If we have more than 8 peers within 30 mins. we will
-	 *  stop tracking till the old entries are removed
-	 */
-	if (mac_cnt < WLAN_TDLS_CT_TABLE_SIZE) {
-		qdf_mem_copy(mac_table[mac_cnt].mac_address.bytes,
-		       mac_addr, QDF_MAC_ADDR_SIZE);
-		tdls_vdev_obj->valid_mac_entries = mac_cnt+1;
-		mac_table[mac_cnt].rx_packet_cnt = 1;
-	}
-
-rx_cnt_return:
-	qdf_spin_unlock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	return;
+	tdls_ct_count(tdls_vdev_obj, mac_addr, false);
 }
 
 void tdls_update_tx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
@@ -300,10 +419,6 @@ void tdls_update_tx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 {
 	struct tdls_vdev_priv_obj *tdls_vdev_obj;
 	struct tdls_soc_priv_obj *tdls_soc_obj;
-	uint8_t mac_cnt;
-	uint8_t valid_mac_entries;
-	struct tdls_conn_tracker_mac_table *mac_table;
-	struct wlan_objmgr_peer *bss_peer;
 
 	if (QDF_STATUS_SUCCESS != tdls_get_vdev_objects(vdev, &tdls_vdev_obj,
 							&tdls_soc_obj))
@@ -318,42 +433,8 @@ void tdls_update_tx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 	if (!qdf_mem_cmp(vdev->vdev_mlme.macaddr, mac_addr,
 			 QDF_MAC_ADDR_SIZE))
 		return;
-	bss_peer = wlan_objmgr_vdev_try_get_bsspeer(vdev, WLAN_TDLS_NB_ID);
-	if (bss_peer) {
-		if (!qdf_mem_cmp(bss_peer->macaddr, mac_addr,
-				 QDF_MAC_ADDR_SIZE)) {
-			wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-			return;
-		}
-		wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-	}
-
-	qdf_spin_lock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	mac_table = tdls_vdev_obj->ct_peer_table;
 
-	valid_mac_entries = tdls_vdev_obj->valid_mac_entries;
-
-	for (mac_cnt = 0; mac_cnt < valid_mac_entries; mac_cnt++) {
-		if (qdf_mem_cmp(mac_table[mac_cnt].mac_address.bytes,
-		    mac_addr, QDF_MAC_ADDR_SIZE) == 0) {
-			mac_table[mac_cnt].tx_packet_cnt++;
-			goto tx_cnt_return;
-		}
-	}
-
-	/* If we have more than 8 peers within 30 mins. we will
-	 *  stop tracking till the old entries are removed
-	 */
-	if (mac_cnt < WLAN_TDLS_CT_TABLE_SIZE) {
-		qdf_mem_copy(mac_table[mac_cnt].mac_address.bytes,
-			mac_addr, QDF_MAC_ADDR_SIZE);
-		mac_table[mac_cnt].tx_packet_cnt = 1;
-		tdls_vdev_obj->valid_mac_entries++;
-	}
-
-tx_cnt_return:
-	qdf_spin_unlock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	return;
+	tdls_ct_count(tdls_vdev_obj, mac_addr, true);
 }
 
 void tdls_implicit_send_discovery_request(
@@ -210,6 +210,14 @@ static QDF_STATUS tdls_vdev_init(struct tdls_vdev_priv_obj *vdev_obj)
 		user_config->tdls_rssi_teardown_threshold;
 	config->rssi_delta = user_config->tdls_rssi_delta;
 
+	vdev_obj->ct_pcpu_table = alloc_percpu(struct tdls_ct_pcpu_table);
+	if (!vdev_obj->ct_pcpu_table) {
+		tdls_err("Failed to alloc connection tracker tables");
+		return QDF_STATUS_E_NOMEM;
+	}
+	/* entries start with epoch 0, which no sampling interval uses */
+	vdev_obj->ct_epoch = 1;
+
 	for (i = 0; i < WLAN_TDLS_PEER_LIST_SIZE; i++) {
 		qdf_list_create(&vdev_obj->peer_list[i],
 				WLAN_TDLS_PEER_SUB_LIST_SIZE);
@@ -232,6 +240,9 @@ static void tdls_vdev_deinit(struct tdls_vdev_priv_obj *vdev_obj)
 
 	tdls_peer_idle_timers_destroy(vdev_obj);
 	tdls_free_peer_list(vdev_obj);
+
+	free_percpu(vdev_obj->ct_pcpu_table);
+	vdev_obj->ct_pcpu_table = NULL;
 }
 
 QDF_STATUS tdls_vdev_obj_create_notification(struct wlan_objmgr_vdev *vdev,
@@ -35,6 +35,8 @@
 #include <scheduler_api.h>
 #include "wlan_serialization_api.h"
 #include <wlan_utility.h>
+#include <linux/percpu.h>
+#include <linux/bottom_half.h>
 
 
 /* Bit mask flag for tdls_option to FW */
@@ -132,6 +134,30 @@ struct tdls_conn_tracker_mac_table {
 	uint32_t peer_timestamp_ms;
 };
 
+/**
+ * struct tdls_ct_entry - connection tracker sample of a peer on a CPU
+ * @epoch: sampling interval the entry counts packets for, 0 while the entry
+ *         is being reclaimed for another peer
+ * @mac_address: peer mac address
+ * @tx_packet_cnt: number of tx pkts
+ * @rx_packet_cnt: number of rx pkts
+ */
+struct tdls_ct_entry {
+	uint32_t epoch;
+	struct qdf_mac_addr mac_address;
+	uint32_t tx_packet_cnt;
+	uint32_t rx_packet_cnt;
+};
+
+/**
+ * struct tdls_ct_pcpu_table - connection tracker samples of a CPU
+ * @entries: samples hashed by peer mac address, only written from the CPU
+ *           owning the table
+ */
+struct tdls_ct_pcpu_table {
+	struct tdls_ct_entry entries[WLAN_TDLS_CT_HASH_SIZE];
+};
+
 /**
  * struct tdls_set_state_db - to record set tdls state command, we need to
  * set correct tdls state to firmware:
@@ -183,7 +209,6 @@ struct tdls_set_state_info {
  * @tdls_del_all_peers:store eWNI_SME_DEL_ALL_TDLS_PEERS
  * @tdls_update_dp_vdev_flags store CDP_UPDATE_TDLS_FLAGS
  * @tdls_idle_peer_data: provide information about idle peer
- * @tdls_ct_spinlock: connection tracker spin lock
  * @is_prevent_suspend: prevent suspend or not
  * @is_drv_supported: platform supports drv or not, enable/disable tdls wow
  * based on this flag.
@@ -230,7 +255,6 @@ struct tdls_soc_priv_obj {
 	uint16_t tdls_update_peer_state;
 	uint16_t tdls_del_all_peers;
 	uint32_t tdls_update_dp_vdev_flags;
-	qdf_spinlock_t tdls_ct_spinlock;
 #ifdef TDLS_WOW_ENABLED
 	bool is_prevent_suspend;
 	bool is_drv_supported;
@@ -251,8 +275,8 @@ struct tdls_soc_priv_obj {
  * @discovery_peer_cnt: discovery peer count
  * @discovery_sent_cnt: discovery sent count
  * @curr_candidate: current candidate
- * @ct_peer_table: linear mac address table for counting the packets
- * @valid_mac_entries: number of valid mac entry in @ct_peer_mac_table
+ * @ct_pcpu_table: per CPU tables counting the packets of each peer
+ * @ct_epoch: current sampling interval of the connection tracker, never 0
  * @magic: magic
  * @tx_queue: tx frame queue
  * @tdls_teardown_comp: tdls teardown completion
@@ -266,9 +290,8 @@ struct tdls_vdev_priv_obj {
 	int32_t discovery_peer_cnt;
 	uint32_t discovery_sent_cnt;
 	struct tdls_peer *curr_candidate;
-	struct tdls_conn_tracker_mac_table
-			ct_peer_table[WLAN_TDLS_CT_TABLE_SIZE];
-	uint8_t valid_mac_entries;
+	struct tdls_ct_pcpu_table __percpu *ct_pcpu_table;
+	uint32_t ct_epoch;
 	uint32_t magic;
 	uint8_t session_id;
 	qdf_list_t tx_queue;
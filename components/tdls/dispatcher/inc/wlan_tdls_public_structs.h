@@ -37,6 +37,8 @@
 #define WLAN_TDLS_STA_P_UAPSD_OFFCHAN_MAX_NUM        1
 #define WLAN_TDLS_PEER_LIST_SIZE                     16
 #define WLAN_TDLS_CT_TABLE_SIZE                      8
+#define WLAN_TDLS_CT_HASH_SIZE                       16
+#define WLAN_TDLS_CT_HASH_WAYS                       2
 #define WLAN_TDLS_PEER_SUB_LIST_SIZE                 10
 #define WLAN_MAC_MAX_EXTN_CAP                        8
 #define WLAN_MAC_MAX_SUPP_CHANNELS                   100
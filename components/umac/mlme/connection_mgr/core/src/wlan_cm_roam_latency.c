@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * DOC: wlan_cm_roam_latency.c
+ *
+ * Implementation of the roam synch propagation latency tracer.
+ */
+
+#include "wlan_mlme_main.h"
+#include "wlan_cm_roam_latency.h"
+
+static const char *roam_latency_stage_name[ROAM_LATENCY_STAGE_MAX] = {
+	[ROAM_LATENCY_STAGE_SYNCH_START] = "synch_start",
+	[ROAM_LATENCY_STAGE_FILL_BUFFER] = "fill_buffer",
+	[ROAM_LATENCY_STAGE_PE_PROPAGATION] = "pe_propagation",
+	[ROAM_LATENCY_STAGE_CSR_PROPAGATION] = "csr_propagation",
+	[ROAM_LATENCY_STAGE_ROAMED_IND] = "roamed_ind",
+	[ROAM_LATENCY_STAGE_PEER_AUTHORIZED] = "peer_authorized",
+	[ROAM_LATENCY_STAGE_NETIF_ENABLED] = "netif_enabled",
+	[ROAM_LATENCY_STAGE_SYNCH_COMPLETE] = "synch_complete",
+};
+
+/**
+ * cm_roam_get_latency_tracer() - get the roam latency tracer of a psoc
+ * @psoc: objmgr psoc
+ *
+ * Return: tracer, NULL if the psoc has no mlme object
+ */
+static struct roam_latency_tracer *
+cm_roam_get_latency_tracer(struct wlan_objmgr_psoc *psoc)
+{
+	struct wlan_mlme_psoc_ext_obj *mlme_obj;
+
+	mlme_obj = mlme_get_psoc_ext_obj(psoc);
+	if (!mlme_obj)
+		return NULL;
+
+	return &mlme_obj->roam_latency;
+}
+
+void cm_roam_latency_init(struct roam_latency_tracer *tracer)
+{
+	qdf_mem_zero(tracer, sizeof(*tracer));
+	tracer->next_id = 1;
+	qdf_spinlock_create(&tracer->lock);
+}
+
+void cm_roam_latency_deinit(struct roam_latency_tracer *tracer)
+{
+	qdf_spinlock_destroy(&tracer->lock);
+}
+
+/**
+ * cm_roam_latency_commit() - move a traced roam into the record ring
+ * @tracer: latency tracer, lock must be held by the caller
+ * @cur: roam being traced
+ * @status: status the roam synch completed with
+ *
+ * Return: None
+ */
+static void cm_roam_latency_commit(struct roam_latency_tracer *tracer,
+				   struct roam_latency_record *cur,
+				   QDF_STATUS status)
+{
+	cur->status = status;
+	cur->total_us = qdf_get_log_timestamp_usecs() - cur->start_us;
+	cur->active = false;
+
+	tracer->records[tracer->record_idx] = *cur;
+	tracer->record_idx = (tracer->record_idx + 1) %
+			     ROAM_LATENCY_MAX_RECORDS;
+	if (tracer->num_records < ROAM_LATENCY_MAX_RECORDS)
+		tracer->num_records++;
+}
+
+void cm_roam_latency_begin(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id)
+{
+	struct roam_latency_tracer *tracer = cm_roam_get_latency_tracer(psoc);
+	struct roam_latency_record *cur;
+
+	if (!tracer || vdev_id >= WLAN_MAX_VDEVS)
+		return;
+
+	cur = &tracer->cur[vdev_id];
+	qdf_spin_lock_bh(&tracer->lock);
+	if (cur->active)
+		cm_roam_latency_commit(tracer, cur, QDF_STATUS_E_ABORTED);
+
+	qdf_mem_zero(cur, sizeof(*cur));
+	cur->id = tracer->next_id++;
+	cur->vdev_id = vdev_id;
+	cur->start_us = qdf_get_log_timestamp_usecs();
+	cur->active = true;
+	qdf_spin_unlock_bh(&tracer->lock);
+}
+
+void cm_roam_latency_record(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			    enum roam_latency_stage stage)
+{
+	struct roam_latency_tracer *tracer = cm_roam_get_latency_tracer(psoc);
+	struct roam_latency_record *cur;
+	uint32_t elapsed_us;
+
+	if (!tracer || vdev_id >= WLAN_MAX_VDEVS ||
+	    stage >= ROAM_LATENCY_STAGE_MAX)
+		return;
+
+	cur = &tracer->cur[vdev_id];
+	qdf_spin_lock_bh(&tracer->lock);
+	if (cur->active && !cur->stage_us[stage]) {
+		elapsed_us = qdf_get_log_timestamp_usecs() - cur->start_us;
+		/* 0 means not reached, a stage reached at once still counts */
+		cur->stage_us[stage] = elapsed_us ? elapsed_us : 1;
+	}
+	qdf_spin_unlock_bh(&tracer->lock);
+}
+
+void cm_roam_latency_end(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			 QDF_STATUS status)
+{
+	struct roam_latency_tracer *tracer = cm_roam_get_latency_tracer(psoc);
+	struct roam_latency_record *cur;
+
+	if (!tracer || vdev_id >= WLAN_MAX_VDEVS)
+		return;
+
+	cur = &tracer->cur[vdev_id];
+	qdf_spin_lock_bh(&tracer->lock);
+	if (cur->active)
+		cm_roam_latency_commit(tracer, cur, status);
+	qdf_spin_unlock_bh(&tracer->lock);
+}
+
+/**
+ * cm_roam_latency_sort() - sort latency samples in ascending order
+ * @samples: samples to sort
+ * @num: number of samples, at most ROAM_LATENCY_MAX_RECORDS
+ *
+ * Return: None
+ */
+static void cm_roam_latency_sort(uint32_t *samples, uint8_t num)
+{
+	uint32_t sample;
+	int8_t i, j;
+
+	for (i = 1; i < num; i++) {
+		sample = samples[i];
+		for (j = i - 1; j >= 0 && samples[j] > sample; j--)
+			samples[j + 1] = samples[j];
+		samples[j + 1] = sample;
+	}
+}
+
+/**
+ * cm_roam_latency_print_summary() - print percentiles of a roam stage
+ * @name: name of the stage
+ * @samples: samples of the stage, sorted by this API
+ * @num: number of samples
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @len: number of bytes already written into @buf
+ *
+ * Return: number of bytes written into @buf
+ */
+static ssize_t cm_roam_latency_print_summary(const char *name,
+					     uint32_t *samples, uint8_t num,
+					     uint8_t *buf, ssize_t buf_len,
+					     ssize_t len)
+{
+	if (!num)
+		return len;
+
+	cm_roam_latency_sort(samples, num);
+
+	return len + qdf_scnprintf(buf + len, buf_len - len,
+				   "%-16s cnt %u p50 %u p90 %u p99 %u max %u\n",
+				   name, num, samples[(num - 1) * 50 / 100],
+				   samples[(num - 1) * 90 / 100],
+				   samples[(num - 1) * 99 / 100],
+				   samples[num - 1]);
+}
+
+QDF_STATUS cm_roam_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+				 ssize_t buf_len, ssize_t *plen)
+{
+	struct roam_latency_tracer *tracer = cm_roam_get_latency_tracer(psoc);
+	struct roam_latency_record *record;
+	uint32_t samples[ROAM_LATENCY_MAX_RECORDS];
+	ssize_t len = 0;
+	uint8_t i, j, idx, num;
+
+	if (!tracer || !buf || !plen)
+		return QDF_STATUS_E_INVAL;
+
+	qdf_spin_lock_bh(&tracer->lock);
+
+	len += qdf_scnprintf(buf + len, buf_len - len,
+			     "usecs from roam synch event, completed roams:\n");
+	for (i = 0; i < ROAM_LATENCY_STAGE_MAX; i++) {
+		num = 0;
+		for (j = 0; j < tracer->num_records; j++) {
+			record = &tracer->records[j];
+			if (QDF_IS_STATUS_SUCCESS(record->status) &&
+			    record->stage_us[i])
+				samples[num++] = record->stage_us[i];
+		}
+		len = cm_roam_latency_print_summary(roam_latency_stage_name[i],
+						    samples, num, buf,
+						    buf_len, len);
+	}
+
+	num = 0;
+	for (j = 0; j < tracer->num_records; j++) {
+		record = &tracer->records[j];
+		if (QDF_IS_STATUS_SUCCESS(record->status))
+			samples[num++] = record->total_us;
+	}
+	len = cm_roam_latency_print_summary("total", samples, num, buf,
+					    buf_len, len);
+
+	len += qdf_scnprintf(buf + len, buf_len - len,
+			     "\nlast %u roams:\n", tracer->num_records);
+	for (i = 0; i < tracer->num_records; i++) {
+		idx = (tracer->record_idx + ROAM_LATENCY_MAX_RECORDS -
+		       tracer->num_records + i) % ROAM_LATENCY_MAX_RECORDS;
+		record = &tracer->records[idx];
+		len += qdf_scnprintf(buf + len, buf_len - len,
+				     "#%u vdev %u ts %llu status %d total %u:",
+				     record->id, record->vdev_id,
+				     record->start_us, record->status,
+				     record->total_us);
+		for (j = 0; j < ROAM_LATENCY_STAGE_MAX; j++) {
+			if (!record->stage_us[j])
+				continue;
+			len += qdf_scnprintf(buf + len, buf_len - len,
+					     " %s %u",
+					     roam_latency_stage_name[j],
+					     record->stage_us[j]);
+		}
+		len += qdf_scnprintf(buf + len, buf_len - len, "\n");
+	}
+
+	qdf_spin_unlock_bh(&tracer->lock);
+	*plen = len;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void cm_roam_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+	struct roam_latency_tracer *tracer = cm_roam_get_latency_tracer(psoc);
+
+	if (!tracer)
+		return;
+
+	qdf_spin_lock_bh(&tracer->lock);
+	tracer->record_idx = 0;
+	tracer->num_records = 0;
+	qdf_spin_unlock_bh(&tracer->lock);
+}
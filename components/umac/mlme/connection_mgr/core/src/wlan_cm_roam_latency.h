@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * DOC: wlan_cm_roam_latency.h
+ *
+ * Roam synch propagation latency tracer. Each roam synch is traced from
+ * the arrival of the WMI roam synch event through WMA, PE, CSR and HDD
+ * until the roam synch complete, and kept in a ring for debugfs.
+ */
+
+#ifndef _WLAN_CM_ROAM_LATENCY_H_
+#define _WLAN_CM_ROAM_LATENCY_H_
+
+#include "qdf_types.h"
+#include "wlan_cm_roam_public_struct.h"
+
+#ifdef WLAN_ROAM_LATENCY_TRACE
+/**
+ * cm_roam_latency_init() - initialize roam latency tracer
+ * @tracer: tracer to be initialized
+ *
+ * Return: None
+ */
+void cm_roam_latency_init(struct roam_latency_tracer *tracer);
+
+/**
+ * cm_roam_latency_deinit() - de-initialize roam latency tracer
+ * @tracer: tracer to be de-initialized
+ *
+ * Return: None
+ */
+void cm_roam_latency_deinit(struct roam_latency_tracer *tracer);
+
+/**
+ * cm_roam_latency_begin() - start tracing a roam synch propagation
+ * @psoc: objmgr psoc
+ * @vdev_id: vdev the roam synch event is received for
+ *
+ * A roam synch still being traced on the vdev is completed as aborted.
+ *
+ * Return: None
+ */
+void cm_roam_latency_begin(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id);
+
+/**
+ * cm_roam_latency_record() - record that a roam synch stage is reached
+ * @psoc: objmgr psoc
+ * @vdev_id: vdev id
+ * @stage: stage reached
+ *
+ * Only the first time a stage is reached is recorded, nothing is recorded
+ * if no roam synch is traced on the vdev.
+ *
+ * Return: None
+ */
+void cm_roam_latency_record(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			    enum roam_latency_stage stage);
+
+/**
+ * cm_roam_latency_end() - complete tracing a roam synch propagation
+ * @psoc: objmgr psoc
+ * @vdev_id: vdev id
+ * @status: status the roam synch completed with
+ *
+ * Return: None
+ */
+void cm_roam_latency_end(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			 QDF_STATUS status);
+
+/**
+ * cm_roam_latency_print() - print roam latency trace into a buffer
+ * @psoc: objmgr psoc
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @plen: number of bytes written into @buf, filled by this API
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS cm_roam_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+				 ssize_t buf_len, ssize_t *plen);
+
+/**
+ * cm_roam_latency_reset() - drop the roam latency trace collected so far
+ * @psoc: objmgr psoc
+ *
+ * Return: None
+ */
+void cm_roam_latency_reset(struct wlan_objmgr_psoc *psoc);
+#endif /* WLAN_ROAM_LATENCY_TRACE */
+#endif /* _WLAN_CM_ROAM_LATENCY_H_ */
@@ -25,6 +25,7 @@
 
 #include "wlan_mlme_dbg.h"
 #include "../../core/src/wlan_cm_roam_offload.h"
+#include "../../core/src/wlan_cm_roam_latency.h"
 #include "wlan_mlme_main.h"
 #include "wlan_mlme_api.h"
 
@@ -611,4 +612,92 @@ uint32_t wlan_cm_get_roam_scan_scheme_bitmap(struct wlan_objmgr_psoc *psoc,
 	return 0;
 }
 #endif  /* FEATURE_ROAM_OFFLOAD */
+
+#ifdef WLAN_ROAM_LATENCY_TRACE
+/**
+ * wlan_cm_roam_latency_begin() - start tracing a roam synch propagation
+ * @psoc: PSOC pointer
+ * @vdev_id: vdev the roam synch event is received for
+ *
+ * Return: None
+ */
+void wlan_cm_roam_latency_begin(struct wlan_objmgr_psoc *psoc,
+				uint8_t vdev_id);
+
+/**
+ * wlan_cm_roam_latency_record() - record a roam synch propagation stage
+ * @psoc: PSOC pointer
+ * @vdev_id: vdev id
+ * @stage: stage reached
+ *
+ * Return: None
+ */
+void wlan_cm_roam_latency_record(struct wlan_objmgr_psoc *psoc,
+				 uint8_t vdev_id,
+				 enum roam_latency_stage stage);
+
+/**
+ * wlan_cm_roam_latency_end() - complete tracing a roam synch propagation
+ * @psoc: PSOC pointer
+ * @vdev_id: vdev id
+ * @status: status the roam synch completed with
+ *
+ * Return: None
+ */
+void wlan_cm_roam_latency_end(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			      QDF_STATUS status);
+
+/**
+ * wlan_cm_roam_latency_print() - print roam latency trace into a buffer
+ * @psoc: PSOC pointer
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @plen: number of bytes written into @buf, filled by this API
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS wlan_cm_roam_latency_print(struct wlan_objmgr_psoc *psoc,
+				      uint8_t *buf, ssize_t buf_len,
+				      ssize_t *plen);
+
+/**
+ * wlan_cm_roam_latency_reset() - drop the roam latency trace
+ * @psoc: PSOC pointer
+ *
+ * Return: None
+ */
+void wlan_cm_roam_latency_reset(struct wlan_objmgr_psoc *psoc);
+#else
+static inline
+void wlan_cm_roam_latency_begin(struct wlan_objmgr_psoc *psoc,
+				uint8_t vdev_id)
+{
+}
+
+static inline
+void wlan_cm_roam_latency_record(struct wlan_objmgr_psoc *psoc,
+				 uint8_t vdev_id,
+				 enum roam_latency_stage stage)
+{
+}
+
+static inline
+void wlan_cm_roam_latency_end(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			      QDF_STATUS status)
+{
+}
+
+static inline
+QDF_STATUS wlan_cm_roam_latency_print(struct wlan_objmgr_psoc *psoc,
+				      uint8_t *buf, ssize_t buf_len,
+				      ssize_t *plen)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline
+void wlan_cm_roam_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif /* WLAN_ROAM_LATENCY_TRACE */
 #endif  /* WLAN_CM_ROAM_API_H__ */
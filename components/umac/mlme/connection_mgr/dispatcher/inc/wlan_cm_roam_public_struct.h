@@ -1359,4 +1359,76 @@ struct cm_roam_values_copy {
 	bool bool_value;
 
 };
+
+#define ROAM_LATENCY_MAX_RECORDS 32
+
+/**
+ * enum roam_latency_stage - hop of the roam synch propagation
+ * @ROAM_LATENCY_STAGE_SYNCH_START: roam synch event delivered to the vdev
+ *	state machine and handed to the roam synch handler
+ * @ROAM_LATENCY_STAGE_FILL_BUFFER: roam synch indication filled from the
+ *	event
+ * @ROAM_LATENCY_STAGE_PE_PROPAGATION: PE session updated for the new AP
+ * @ROAM_LATENCY_STAGE_CSR_PROPAGATION: CSR session updated, reassociation
+ *	about to be indicated to HDD
+ * @ROAM_LATENCY_STAGE_ROAMED_IND: roamed indication sent to userspace
+ * @ROAM_LATENCY_STAGE_PEER_AUTHORIZED: peer moved to authorized state with
+ *	the keys installed by firmware
+ * @ROAM_LATENCY_STAGE_NETIF_ENABLED: netdev tx queues enabled again
+ * @ROAM_LATENCY_STAGE_SYNCH_COMPLETE: roam synch complete sent to firmware
+ *	and processed by CSR
+ * @ROAM_LATENCY_STAGE_MAX: max value
+ */
+enum roam_latency_stage {
+	ROAM_LATENCY_STAGE_SYNCH_START,
+	ROAM_LATENCY_STAGE_FILL_BUFFER,
+	ROAM_LATENCY_STAGE_PE_PROPAGATION,
+	ROAM_LATENCY_STAGE_CSR_PROPAGATION,
+	ROAM_LATENCY_STAGE_ROAMED_IND,
+	ROAM_LATENCY_STAGE_PEER_AUTHORIZED,
+	ROAM_LATENCY_STAGE_NETIF_ENABLED,
+	ROAM_LATENCY_STAGE_SYNCH_COMPLETE,
+	ROAM_LATENCY_STAGE_MAX,
+};
+
+#ifdef WLAN_ROAM_LATENCY_TRACE
+/**
+ * struct roam_latency_record - trace of one roam synch propagation
+ * @id: roam sequence number
+ * @vdev_id: vdev id
+ * @active: roam synch propagation is in progress
+ * @status: status the roam synch completed with
+ * @start_us: log timestamp the roam synch event arrived at
+ * @total_us: duration of the whole propagation in microseconds
+ * @stage_us: time from @start_us each stage was reached at, 0 if the
+ *	stage was not reached
+ */
+struct roam_latency_record {
+	uint32_t id;
+	uint8_t vdev_id;
+	bool active;
+	QDF_STATUS status;
+	uint64_t start_us;
+	uint32_t total_us;
+	uint32_t stage_us[ROAM_LATENCY_STAGE_MAX];
+};
+
+/**
+ * struct roam_latency_tracer - roam synch propagation latency tracer
+ * @lock: protects the tracer
+ * @cur: roam synch propagation being traced on each vdev
+ * @next_id: id of the next traced roam
+ * @records: ring of completed roams
+ * @record_idx: next write position in @records
+ * @num_records: number of valid entries in @records
+ */
+struct roam_latency_tracer {
+	qdf_spinlock_t lock;
+	struct roam_latency_record cur[WLAN_MAX_VDEVS];
+	uint32_t next_id;
+	struct roam_latency_record records[ROAM_LATENCY_MAX_RECORDS];
+	uint8_t record_idx;
+	uint8_t num_records;
+};
+#endif /* WLAN_ROAM_LATENCY_TRACE */
 #endif
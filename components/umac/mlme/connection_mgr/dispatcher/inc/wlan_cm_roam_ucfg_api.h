@@ -155,4 +155,31 @@ ucfg_cm_update_roam_scan_scheme_bitmap(struct wlan_objmgr_psoc *psoc,
 	return QDF_STATUS_SUCCESS;
 }
 #endif
+
+/**
+ * ucfg_cm_roam_latency_print() - print roam latency trace into a buffer
+ * @psoc: PSOC pointer
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @plen: number of bytes written into @buf, filled by this API
+ *
+ * Return: QDF_STATUS
+ */
+static inline QDF_STATUS
+ucfg_cm_roam_latency_print(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+			   ssize_t buf_len, ssize_t *plen)
+{
+	return wlan_cm_roam_latency_print(psoc, buf, buf_len, plen);
+}
+
+/**
+ * ucfg_cm_roam_latency_reset() - drop the roam latency trace
+ * @psoc: PSOC pointer
+ *
+ * Return: None
+ */
+static inline void ucfg_cm_roam_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+	wlan_cm_roam_latency_reset(psoc);
+}
 #endif
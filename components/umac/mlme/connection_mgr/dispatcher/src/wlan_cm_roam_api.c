@@ -736,3 +736,36 @@ uint32_t wlan_cm_get_roam_scan_scheme_bitmap(struct wlan_objmgr_psoc *psoc,
 	return roam_scan_scheme_bitmap;
 }
 #endif
+
+#ifdef WLAN_ROAM_LATENCY_TRACE
+void wlan_cm_roam_latency_begin(struct wlan_objmgr_psoc *psoc,
+				uint8_t vdev_id)
+{
+	cm_roam_latency_begin(psoc, vdev_id);
+}
+
+void wlan_cm_roam_latency_record(struct wlan_objmgr_psoc *psoc,
+				 uint8_t vdev_id,
+				 enum roam_latency_stage stage)
+{
+	cm_roam_latency_record(psoc, vdev_id, stage);
+}
+
+void wlan_cm_roam_latency_end(struct wlan_objmgr_psoc *psoc, uint8_t vdev_id,
+			      QDF_STATUS status)
+{
+	cm_roam_latency_end(psoc, vdev_id, status);
+}
+
+QDF_STATUS wlan_cm_roam_latency_print(struct wlan_objmgr_psoc *psoc,
+				      uint8_t *buf, ssize_t buf_len,
+				      ssize_t *plen)
+{
+	return cm_roam_latency_print(psoc, buf, buf_len, plen);
+}
+
+void wlan_cm_roam_latency_reset(struct wlan_objmgr_psoc *psoc)
+{
+	cm_roam_latency_reset(psoc);
+}
+#endif
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: cds_boot_profile.h
+ *
+ * Connectivity driver services boot profiler. The start and end of every
+ * step of a driver load, SSR re-init or idle restart are recorded on a
+ * timeline, so that the steps on the critical path and the ones running
+ * in parallel with the firmware can be told apart.
+ */
+
+#ifndef __CDS_BOOT_PROFILE_H
+#define __CDS_BOOT_PROFILE_H
+
+#include <qdf_types.h>
+#include <qdf_status.h>
+
+/**
+ * enum cds_boot_type - reason the driver is brought up
+ * @CDS_BOOT_LOAD: driver load or probe
+ * @CDS_BOOT_SSR: re-init after a subsystem restart
+ * @CDS_BOOT_IDLE_RESTART: restart after an idle shutdown, e.g. when the
+ *	interface comes up again after airplane mode
+ * @CDS_BOOT_TYPE_MAX: max value
+ */
+enum cds_boot_type {
+	CDS_BOOT_LOAD,
+	CDS_BOOT_SSR,
+	CDS_BOOT_IDLE_RESTART,
+	CDS_BOOT_TYPE_MAX,
+};
+
+/**
+ * enum cds_boot_step - step of the bring up
+ * @CDS_BOOT_STEP_CTX_CREATE: hdd context creation and ini parsing
+ * @CDS_BOOT_STEP_POWER_ON: platform power on
+ * @CDS_BOOT_STEP_HIF_OPEN: bus open
+ * @CDS_BOOT_STEP_PSOC_OPEN: component psoc open and config update
+ * @CDS_BOOT_STEP_HOST_PREP: host preparation run in parallel with the
+ *	firmware download and ready waits
+ * @CDS_BOOT_STEP_FW_DOWNLOAD: firmware download
+ * @CDS_BOOT_STEP_WMA_OPEN: WMA open
+ * @CDS_BOOT_STEP_WAIT_TARGET: wait for the target to come up over HTC
+ * @CDS_BOOT_STEP_MAC_OPEN: MAC and SME open
+ * @CDS_BOOT_STEP_DISPATCHER_OPEN: UMAC components psoc open
+ * @CDS_BOOT_STEP_DP_OPEN: data path open
+ * @CDS_BOOT_STEP_PRE_ENABLE: HTC start up to the WMI ready event
+ * @CDS_BOOT_STEP_SERVICE_READY: handling of the service ready event
+ * @CDS_BOOT_STEP_SERVICE_READY_EXT: handling of the service ready ext event
+ * @CDS_BOOT_STEP_READY: handling of the ready event
+ * @CDS_BOOT_STEP_WAIT_READY: wait for the ready event
+ * @CDS_BOOT_STEP_CONFIGURE: CDS enable and component configuration
+ * @CDS_BOOT_STEP_WIPHY_INIT: wiphy update and registration
+ * @CDS_BOOT_STEP_CREATE_VDEVS: creation of the default interfaces
+ * @CDS_BOOT_STEP_MAX: max value
+ */
+enum cds_boot_step {
+	CDS_BOOT_STEP_CTX_CREATE,
+	CDS_BOOT_STEP_POWER_ON,
+	CDS_BOOT_STEP_HIF_OPEN,
+	CDS_BOOT_STEP_PSOC_OPEN,
+	CDS_BOOT_STEP_HOST_PREP,
+	CDS_BOOT_STEP_FW_DOWNLOAD,
+	CDS_BOOT_STEP_WMA_OPEN,
+	CDS_BOOT_STEP_WAIT_TARGET,
+	CDS_BOOT_STEP_MAC_OPEN,
+	CDS_BOOT_STEP_DISPATCHER_OPEN,
+	CDS_BOOT_STEP_DP_OPEN,
+	CDS_BOOT_STEP_PRE_ENABLE,
+	CDS_BOOT_STEP_SERVICE_READY,
+	CDS_BOOT_STEP_SERVICE_READY_EXT,
+	CDS_BOOT_STEP_READY,
+	CDS_BOOT_STEP_WAIT_READY,
+	CDS_BOOT_STEP_CONFIGURE,
+	CDS_BOOT_STEP_WIPHY_INIT,
+	CDS_BOOT_STEP_CREATE_VDEVS,
+	CDS_BOOT_STEP_MAX,
+};
+
+#ifdef WLAN_BOOT_PROFILE
+/* Number of bring ups kept */
+#define CDS_BOOT_PROFILE_HISTORY 4
+
+/**
+ * cds_boot_profile_init() - initialize the boot profiler
+ *
+ * Return: None
+ */
+void cds_boot_profile_init(void);
+
+/**
+ * cds_boot_profile_deinit() - deinitialize the boot profiler
+ *
+ * Return: None
+ */
+void cds_boot_profile_deinit(void);
+
+/**
+ * cds_boot_profile_start() - start the timeline of a bring up
+ * @type: reason of the bring up
+ *
+ * A bring up still in progress is committed as aborted.
+ *
+ * Return: None
+ */
+void cds_boot_profile_start(enum cds_boot_type type);
+
+/**
+ * cds_boot_profile_stop() - complete the timeline of the current bring up
+ * @status: result of the bring up
+ *
+ * Return: None
+ */
+void cds_boot_profile_stop(QDF_STATUS status);
+
+/**
+ * cds_boot_profile_step_begin() - record the start of a step
+ * @step: step
+ *
+ * Nothing is recorded outside of a bring up, so that the steps shared with
+ * other paths, such as a mode change, do not need to check for it.
+ *
+ * Return: None
+ */
+void cds_boot_profile_step_begin(enum cds_boot_step step);
+
+/**
+ * cds_boot_profile_step_end() - record the end of a step
+ * @step: step
+ *
+ * Return: None
+ */
+void cds_boot_profile_step_end(enum cds_boot_step step);
+
+/**
+ * cds_boot_profile_print() - print the recorded bring ups
+ * @buf: buffer to print to
+ * @buf_len: size of @buf
+ *
+ * Return: number of bytes printed
+ */
+int cds_boot_profile_print(char *buf, size_t buf_len);
+
+/**
+ * cds_boot_profile_reset() - drop the recorded bring ups
+ *
+ * Return: None
+ */
+void cds_boot_profile_reset(void);
+#else
+static inline void cds_boot_profile_init(void)
+{
+}
+
+static inline void cds_boot_profile_deinit(void)
+{
+}
+
+static inline void cds_boot_profile_start(enum cds_boot_type type)
+{
+}
+
+static inline void cds_boot_profile_stop(QDF_STATUS status)
+{
+}
+
+static inline void cds_boot_profile_step_begin(enum cds_boot_step step)
+{
+}
+
+static inline void cds_boot_profile_step_end(enum cds_boot_step step)
+{
+}
+
+static inline int cds_boot_profile_print(char *buf, size_t buf_len)
+{
+	return 0;
+}
+
+static inline void cds_boot_profile_reset(void)
+{
+}
+#endif /* WLAN_BOOT_PROFILE */
+#endif /* __CDS_BOOT_PROFILE_H */
@@ -46,6 +46,7 @@
 #include "hif.h"
 #include "wlan_policy_mgr_api.h"
 #include "cds_utils.h"
+#include "cds_boot_profile.h"
 #include "wlan_logging_sock_svc.h"
 #include "wma.h"
 #include "pktlog_ac.h"
@@ -242,6 +243,7 @@ QDF_STATUS cds_init(void)
 	}
 
 	cds_ssr_protect_init();
+	cds_boot_profile_init();
 
 	gp_cds_context->qdf_ctx = &g_qdf_ctx;
 
@@ -283,6 +285,7 @@ void cds_deinit(void)
 	qdf_mem_zero(&g_qdf_ctx, sizeof(g_qdf_ctx));
 
 	/* currently, no ssr_protect_deinit */
+	cds_boot_profile_deinit();
 
 	cds_recovery_work_deinit();
 
@@ -699,7 +702,9 @@ QDF_STATUS cds_open(struct wlan_objmgr_psoc *psoc)
 
 	/* Initialize BMI and Download firmware */
 	ol_ctx = cds_get_context(QDF_MODULE_ID_BMI);
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_FW_DOWNLOAD);
 	status = bmi_download_firmware(ol_ctx);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_FW_DOWNLOAD);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		cds_alert("BMI FIALED status:%d", status);
 		goto err_bmi_close;
@@ -734,8 +739,10 @@ QDF_STATUS cds_open(struct wlan_objmgr_psoc *psoc)
 	}
 
 	/*Open the WMA module */
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_WMA_OPEN);
 	status = wma_open(psoc, hdd_update_tgt_cfg, cds_cfg,
 			  hdd_ctx->target_type);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_WMA_OPEN);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		cds_alert("Failed to open WMA module");
 		goto err_htc_close;
@@ -762,7 +769,9 @@ QDF_STATUS cds_open(struct wlan_objmgr_psoc *psoc)
 		goto err_wma_close;
 	}
 
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_WAIT_TARGET);
 	status = htc_wait_target(HTCHandle);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_WAIT_TARGET);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		cds_alert("Failed to complete BMI phase. status: %d", status);
 		QDF_BUG(status == QDF_STATUS_E_NOMEM || cds_is_fw_down());
@@ -821,6 +830,7 @@ QDF_STATUS cds_open(struct wlan_objmgr_psoc *psoc)
 	bmi_target_ready(scn, gp_cds_context->cfg_ctx);
 
 	/* Now proceed to open the MAC */
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_MAC_OPEN);
 	status = mac_open(psoc, &mac_handle,
 			  gp_cds_context->hdd_context, cds_cfg);
 
@@ -836,10 +846,13 @@ QDF_STATUS cds_open(struct wlan_objmgr_psoc *psoc)
 		cds_alert("Failed to open SME");
 		goto err_mac_close;
 	}
+	cds_boot_profile_step_end(CDS_BOOT_STEP_MAC_OPEN);
 
 	cds_register_all_modules();
 
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_DISPATCHER_OPEN);
 	status = dispatcher_psoc_open(psoc);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_DISPATCHER_OPEN);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		cds_alert("Failed to open PSOC Components");
 		goto deregister_modules;
@@ -1051,7 +1064,9 @@ QDF_STATUS cds_pre_enable(void)
 		goto exit_with_status;
 	}
 
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_WAIT_READY);
 	status = wma_wait_for_ready_event(gp_cds_context->wma_context);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_WAIT_READY);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		cds_err("Failed to wait for ready event; status: %u", status);
 		goto stop_wmi;
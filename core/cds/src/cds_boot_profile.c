@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: cds_boot_profile.c
+ *
+ * Connectivity driver services boot profiler
+ */
+
+#include <qdf_lock.h>
+#include <qdf_mem.h>
+#include <qdf_time.h>
+#include <qdf_util.h>
+#include "cds_boot_profile.h"
+
+/**
+ * struct cds_boot_step_time - timestamps of a step
+ * @start_us: start of the step, 0 if the step did not run
+ * @end_us: end of the step, 0 if it did not complete
+ */
+struct cds_boot_step_time {
+	uint64_t start_us;
+	uint64_t end_us;
+};
+
+/**
+ * struct cds_boot_record - timeline of a bring up
+ * @type: reason of the bring up
+ * @status: result of the bring up
+ * @start_us: start of the bring up
+ * @end_us: end of the bring up
+ * @steps: timestamps of every step
+ */
+struct cds_boot_record {
+	enum cds_boot_type type;
+	QDF_STATUS status;
+	uint64_t start_us;
+	uint64_t end_us;
+	struct cds_boot_step_time steps[CDS_BOOT_STEP_MAX];
+};
+
+/**
+ * struct cds_boot_profile - boot profiler
+ * @lock: protects the profiler, steps are also recorded from the WMI
+ *	event handlers
+ * @initialized: @lock is created
+ * @active: a bring up is in progress, in the record at @count - 1
+ * @count: number of bring ups recorded
+ * @records: last bring ups
+ */
+struct cds_boot_profile {
+	qdf_spinlock_t lock;
+	bool initialized;
+	bool active;
+	uint32_t count;
+	struct cds_boot_record records[CDS_BOOT_PROFILE_HISTORY];
+};
+
+static struct cds_boot_profile g_cds_boot_profile;
+
+static const char * const cds_boot_type_name[CDS_BOOT_TYPE_MAX] = {
+	[CDS_BOOT_LOAD] = "load",
+	[CDS_BOOT_SSR] = "ssr",
+	[CDS_BOOT_IDLE_RESTART] = "idle_restart",
+};
+
+static const char * const cds_boot_step_name[CDS_BOOT_STEP_MAX] = {
+	[CDS_BOOT_STEP_CTX_CREATE] = "ctx_create",
+	[CDS_BOOT_STEP_POWER_ON] = "power_on",
+	[CDS_BOOT_STEP_HIF_OPEN] = "hif_open",
+	[CDS_BOOT_STEP_PSOC_OPEN] = "psoc_open",
+	[CDS_BOOT_STEP_HOST_PREP] = "host_prep",
+	[CDS_BOOT_STEP_FW_DOWNLOAD] = "fw_download",
+	[CDS_BOOT_STEP_WMA_OPEN] = "wma_open",
+	[CDS_BOOT_STEP_WAIT_TARGET] = "wait_target",
+	[CDS_BOOT_STEP_MAC_OPEN] = "mac_open",
+	[CDS_BOOT_STEP_DISPATCHER_OPEN] = "dispatcher_open",
+	[CDS_BOOT_STEP_DP_OPEN] = "dp_open",
+	[CDS_BOOT_STEP_PRE_ENABLE] = "pre_enable",
+	[CDS_BOOT_STEP_SERVICE_READY] = "service_ready",
+	[CDS_BOOT_STEP_SERVICE_READY_EXT] = "service_ready_ext",
+	[CDS_BOOT_STEP_READY] = "ready",
+	[CDS_BOOT_STEP_WAIT_READY] = "wait_ready",
+	[CDS_BOOT_STEP_CONFIGURE] = "configure",
+	[CDS_BOOT_STEP_WIPHY_INIT] = "wiphy_init",
+	[CDS_BOOT_STEP_CREATE_VDEVS] = "create_vdevs",
+};
+
+static struct cds_boot_record *cds_boot_profile_cur(void)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+
+	return &profile->records[(profile->count - 1) %
+				 CDS_BOOT_PROFILE_HISTORY];
+}
+
+void cds_boot_profile_init(void)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+
+	qdf_mem_zero(profile, sizeof(*profile));
+	qdf_spinlock_create(&profile->lock);
+	profile->initialized = true;
+}
+
+void cds_boot_profile_deinit(void)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+
+	if (!profile->initialized)
+		return;
+
+	profile->initialized = false;
+	qdf_spinlock_destroy(&profile->lock);
+}
+
+void cds_boot_profile_start(enum cds_boot_type type)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+	struct cds_boot_record *rec;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+
+	if (!profile->initialized || type >= CDS_BOOT_TYPE_MAX)
+		return;
+
+	qdf_spin_lock_bh(&profile->lock);
+	if (profile->active) {
+		rec = cds_boot_profile_cur();
+		rec->status = QDF_STATUS_E_ABORTED;
+		rec->end_us = now_us;
+	}
+
+	profile->count++;
+	rec = cds_boot_profile_cur();
+	qdf_mem_zero(rec, sizeof(*rec));
+	rec->type = type;
+	rec->status = QDF_STATUS_E_PENDING;
+	rec->start_us = now_us;
+	profile->active = true;
+	qdf_spin_unlock_bh(&profile->lock);
+}
+
+void cds_boot_profile_stop(QDF_STATUS status)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+	struct cds_boot_record *rec;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+
+	if (!profile->initialized)
+		return;
+
+	qdf_spin_lock_bh(&profile->lock);
+	if (profile->active) {
+		rec = cds_boot_profile_cur();
+		rec->status = status;
+		rec->end_us = now_us;
+		profile->active = false;
+	}
+	qdf_spin_unlock_bh(&profile->lock);
+}
+
+void cds_boot_profile_step_begin(enum cds_boot_step step)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+	struct cds_boot_step_time *time;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+
+	if (!profile->initialized || step >= CDS_BOOT_STEP_MAX)
+		return;
+
+	qdf_spin_lock_bh(&profile->lock);
+	if (profile->active) {
+		time = &cds_boot_profile_cur()->steps[step];
+		time->start_us = now_us;
+		time->end_us = 0;
+	}
+	qdf_spin_unlock_bh(&profile->lock);
+}
+
+void cds_boot_profile_step_end(enum cds_boot_step step)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+	struct cds_boot_step_time *time;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+
+	if (!profile->initialized || step >= CDS_BOOT_STEP_MAX)
+		return;
+
+	qdf_spin_lock_bh(&profile->lock);
+	if (profile->active) {
+		time = &cds_boot_profile_cur()->steps[step];
+		if (time->start_us)
+			time->end_us = now_us;
+	}
+	qdf_spin_unlock_bh(&profile->lock);
+}
+
+static int cds_boot_profile_print_record(struct cds_boot_record *rec,
+					 uint32_t id, bool active,
+					 char *buf, size_t buf_len)
+{
+	struct cds_boot_step_time *time;
+	int len = 0;
+	int i;
+
+	len += qdf_scnprintf(buf + len, buf_len - len, "boot %u: %s, ", id,
+			     cds_boot_type_name[rec->type]);
+	if (active)
+		len += qdf_scnprintf(buf + len, buf_len - len,
+				     "in progress\n");
+	else
+		len += qdf_scnprintf(buf + len, buf_len - len,
+				     "status %d, total %llu us\n", rec->status,
+				     rec->end_us - rec->start_us);
+
+	len += qdf_scnprintf(buf + len, buf_len - len, "  %-18s %10s %10s\n",
+			     "step", "start_us", "dur_us");
+	for (i = 0; i < CDS_BOOT_STEP_MAX; i++) {
+		time = &rec->steps[i];
+		if (!time->start_us)
+			continue;
+
+		len += qdf_scnprintf(buf + len, buf_len - len,
+				     "  %-18s %10llu ", cds_boot_step_name[i],
+				     time->start_us - rec->start_us);
+		if (time->end_us)
+			len += qdf_scnprintf(buf + len, buf_len - len,
+					     "%10llu\n",
+					     time->end_us - time->start_us);
+		else
+			len += qdf_scnprintf(buf + len, buf_len - len,
+					     "%10s\n", "-");
+	}
+
+	return len;
+}
+
+int cds_boot_profile_print(char *buf, size_t buf_len)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+	struct cds_boot_record *rec;
+	uint32_t num, id;
+	int len = 0;
+
+	if (!profile->initialized)
+		return 0;
+
+	qdf_spin_lock_bh(&profile->lock);
+	num = qdf_min(profile->count, (uint32_t)CDS_BOOT_PROFILE_HISTORY);
+	/* latest bring up first */
+	for (id = profile->count; id > profile->count - num; id--) {
+		rec = &profile->records[(id - 1) % CDS_BOOT_PROFILE_HISTORY];
+		len += cds_boot_profile_print_record(rec, id,
+						     profile->active &&
+						     id == profile->count,
+						     buf + len, buf_len - len);
+	}
+	qdf_spin_unlock_bh(&profile->lock);
+
+	return len;
+}
+
+void cds_boot_profile_reset(void)
+{
+	struct cds_boot_profile *profile = &g_cds_boot_profile;
+
+	if (!profile->initialized)
+		return;
+
+	qdf_spin_lock_bh(&profile->lock);
+	/* keep the bring up in progress, if any */
+	if (profile->active) {
+		profile->records[0] = *cds_boot_profile_cur();
+		profile->count = 1;
+	} else {
+		profile->count = 0;
+	}
+	qdf_spin_unlock_bh(&profile->lock);
+}
@@ -631,6 +631,8 @@ ol_tx_pkt_capture_tx_completion_process(
 	struct ol_txrx_peer_t *peer;
 	uint8_t bssid[QDF_MAC_ADDR_SIZE];
 	uint8_t pkt_type = 0;
+	uint8_t *frm_data;
+	uint32_t frm_len, snaplen;
 
 	qdf_assert(tx_desc);
 
@@ -653,6 +655,8 @@ ol_tx_pkt_capture_tx_completion_process(
 
 		tso_seg = tx_desc->tso_desc;
 		nbuf_len = tso_seg->seg.total_len;
+		frm_data = tso_seg->seg.tso_frags[0].vaddr;
+		frm_len = tso_seg->seg.tso_frags[0].length;
 	} else {
 		int i, extra_frag_len = 0;
 
@@ -661,6 +665,8 @@ ol_tx_pkt_capture_tx_completion_process(
 			extra_frag_len =
 			QDF_NBUF_CB_TX_EXTRA_FRAG_LEN(tx_desc->netbuf);
 		nbuf_len = qdf_nbuf_len(tx_desc->netbuf) - extra_frag_len;
+		frm_data = qdf_nbuf_data(tx_desc->netbuf);
+		frm_len = nbuf_len;
 	}
 
 	qdf_spin_lock_bh(&pdev->peer_ref_mutex);
@@ -673,6 +679,13 @@ ol_tx_pkt_capture_tx_completion_process(
 	qdf_mem_copy(bssid, &peer->mac_addr.raw, QDF_MAC_ADDR_SIZE);
 	qdf_spin_unlock_bh(&peer->peer_info_lock);
 
+	if (!ucfg_pkt_capture_filter_8023_frame(frm_data, frm_len,
+						bssid, &snaplen))
+		return;
+
+	if (snaplen && snaplen < nbuf_len)
+		nbuf_len = snaplen;
+
 	netbuf = qdf_nbuf_alloc(NULL,
 				roundup(nbuf_len + RESERVE_BYTES, 4),
 				RESERVE_BYTES, 4, false);
@@ -708,10 +721,18 @@ ol_tx_pkt_capture_tx_completion_process(
 		ip_len = qdf_cpu_to_be16(ip_len);
 
 		for (frag_cnt = 0; frag_cnt < num_frags; frag_cnt++) {
+			int copy_len = tso_seg->seg.tso_frags[frag_cnt].length;
+
+			/* frames may be truncated by the capture snaplen */
+			if (copy_len > nbuf_len - frag_len)
+				copy_len = nbuf_len - frag_len;
+			if (!copy_len)
+				break;
+
 			qdf_mem_copy(qdf_nbuf_data(netbuf) + frag_len,
 				     tso_seg->seg.tso_frags[frag_cnt].vaddr,
-				     tso_seg->seg.tso_frags[frag_cnt].length);
-			frag_len += tso_seg->seg.tso_frags[frag_cnt].length;
+				     copy_len);
+			frag_len += copy_len;
 		}
 
 		qdf_spin_unlock_bh(&pdev->tso_seg_pool.tso_mutex);
@@ -412,6 +412,99 @@
 #define CFG_MSCS_FEATURE_ALL
 #endif
 
+#ifdef WLAN_FEATURE_LATENCY_FLOW
+/*
+ * <ini>
+ * gLatencyFlowDetect - Enable latency sensitive flow detection
+ * @Default: false
+ *
+ * This ini is used to enable the detection of interactive UDP flows,
+ * such as gaming, VoIP or video calls, from their packet size, pacing
+ * and direction symmetry. Detected flows are transmitted on the VI or VO
+ * access category until they stop qualifying.
+ *
+ * Every UDP packet of the adapter is then looked up in a flow table
+ * shared by the TX and RX paths, so enable it only where the promotion
+ * is worth that cost.
+ *
+ * Related: gLatencyFlowMscs
+ *
+ * Supported Feature: STA, SAP
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_LATENCY_FLOW_DETECT \
+		CFG_INI_BOOL( \
+		"gLatencyFlowDetect", \
+		false, \
+		"Enable latency sensitive flow detection")
+
+/*
+ * <ini>
+ * gLatencyFlowMscs - Request MSCS for latency sensitive flows
+ * @Default: false
+ *
+ * This ini is used to send an MSCS request to the AP once a latency
+ * sensitive flow has been detected on a connected STA, so that the AP
+ * mirrors the priority of the flow on the downlink.
+ *
+ * Related: gLatencyFlowDetect
+ *
+ * Supported Feature: STA
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_LATENCY_FLOW_MSCS \
+		CFG_INI_BOOL( \
+		"gLatencyFlowMscs", \
+		false, \
+		"Request MSCS for latency sensitive flows")
+
+#define CFG_LATENCY_FLOW_ALL \
+		CFG(CFG_DP_LATENCY_FLOW_DETECT) \
+		CFG(CFG_DP_LATENCY_FLOW_MSCS)
+
+#else
+#define CFG_LATENCY_FLOW_ALL
+#endif
+
+#ifdef WLAN_FEATURE_RX_COALESCE
+/*
+ * <ini>
+ * gRxCoalesce - Enable software coalescing of received TCP segments
+ * @Default: false
+ *
+ * This ini is used to enable the coalescing by the driver of the received
+ * TCP segments which neither LRO nor GRO took, for instance when LRO is
+ * disabled on the interface or by a bridge. In order segments of a flow
+ * are delivered to the network stack as one GSO packet. Nothing is
+ * coalesced on an interface GRO is turned off on.
+ *
+ * Related: LROEnable, GROEnable
+ *
+ * Supported Feature: STA, SAP
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_COALESCE \
+		CFG_INI_BOOL( \
+		"gRxCoalesce", \
+		false, \
+		"Enable software coalescing of received TCP segments")
+
+#define CFG_RX_COALESCE_ALL \
+		CFG(CFG_DP_RX_COALESCE)
+
+#else
+#define CFG_RX_COALESCE_ALL
+#endif
+
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
 /*
  * <ini>
@@ -753,6 +846,165 @@
 		false, \
 		"Control to enable latency critical clients")
 
+/*
+ * <ini>
+ * gBusBwGovernor - Governor picking the bus bandwidth vote level
+ * @Min: 0
+ * @Max: 1
+ * @Default: 0
+ *
+ * This ini selects how the bus bandwidth vote level is derived from the
+ * packet count of each bus bandwidth compute interval.
+ * 0 - threshold: compare the packet count of the last interval with the
+ *     bus bandwidth thresholds
+ * 1 - predictive: compare an EWMA of the packet count, extrapolated along
+ *     its slope, with the bus bandwidth thresholds and apply hysteresis
+ *     before lowering the vote
+ *
+ * Related: gBusBwEwmaWeight, gBusBwHysteresis, gBusBwRampDownHoldCnt,
+ * gBusBwRampUpPolicy, gBusBwRampDownPolicy
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOVERNOR \
+		CFG_INI_UINT( \
+		"gBusBwGovernor", \
+		0, \
+		1, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth governor")
+
+/*
+ * <ini>
+ * gBusBwEwmaWeight - Weight of the latest interval in the EWMA
+ * @Min: 1
+ * @Max: 100
+ * @Default: 50
+ *
+ * This ini specifies, in percent, the weight the packet count of the
+ * latest bus bandwidth compute interval has in the moving average used by
+ * the predictive governor. 100 disables the averaging.
+ *
+ * Related: gBusBwGovernor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_EWMA_WEIGHT \
+		CFG_INI_UINT( \
+		"gBusBwEwmaWeight", \
+		1, \
+		100, \
+		50, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth EWMA weight")
+
+/*
+ * <ini>
+ * gBusBwHysteresis - Hysteresis applied before lowering the vote
+ * @Min: 0
+ * @Max: 50
+ * @Default: 10
+ *
+ * This ini specifies, in percent of each bus bandwidth threshold, how far
+ * the traffic has to drop below the threshold of the current vote level
+ * before the predictive governor considers lowering it.
+ *
+ * Related: gBusBwGovernor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_HYSTERESIS \
+		CFG_INI_UINT( \
+		"gBusBwHysteresis", \
+		0, \
+		50, \
+		10, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth hysteresis")
+
+/*
+ * <ini>
+ * gBusBwRampDownHoldCnt - Intervals to hold before lowering the vote
+ * @Min: 1
+ * @Max: 100
+ * @Default: 3
+ *
+ * This ini specifies the number of consecutive bus bandwidth compute
+ * intervals the predictive governor needs to see below the hysteresis
+ * band before it lowers the vote level. Raising the vote is not delayed.
+ *
+ * Related: gBusBwGovernor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_RAMP_DOWN_HOLD_CNT \
+		CFG_INI_UINT( \
+		"gBusBwRampDownHoldCnt", \
+		1, \
+		100, \
+		3, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth ramp down hold count")
+
+/*
+ * <ini>
+ * gBusBwRampUpPolicy - How the predictive governor raises the vote
+ * @Min: 0
+ * @Max: 1
+ * @Default: 0
+ *
+ * 0 - jump straight to the predicted vote level
+ * 1 - step up one vote level per interval
+ *
+ * Related: gBusBwGovernor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_RAMP_UP_POLICY \
+		CFG_INI_UINT( \
+		"gBusBwRampUpPolicy", \
+		0, \
+		1, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth ramp up policy")
+
+/*
+ * <ini>
+ * gBusBwRampDownPolicy - How the predictive governor lowers the vote
+ * @Min: 0
+ * @Max: 1
+ * @Default: 1
+ *
+ * 0 - jump straight to the predicted vote level
+ * 1 - step down one vote level each time the hold count expires
+ *
+ * Related: gBusBwGovernor, gBusBwRampDownHoldCnt
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_RAMP_DOWN_POLICY \
+		CFG_INI_UINT( \
+		"gBusBwRampDownPolicy", \
+		0, \
+		1, \
+		1, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth ramp down policy")
+
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef QCA_SUPPORT_TXRX_DRIVER_TCP_DEL_ACK
@@ -1493,7 +1745,13 @@
 	CFG(CFG_DP_TCP_DELACK_TIMER_COUNT) \
 	CFG(CFG_DP_TCP_TX_HIGH_TPUT_THRESHOLD) \
 	CFG(CFG_DP_BUS_LOW_BW_CNT_THRESHOLD) \
-	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS)
+	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS) \
+	CFG(CFG_DP_BUS_BW_GOVERNOR) \
+	CFG(CFG_DP_BUS_BW_EWMA_WEIGHT) \
+	CFG(CFG_DP_BUS_BW_HYSTERESIS) \
+	CFG(CFG_DP_BUS_BW_RAMP_DOWN_HOLD_CNT) \
+	CFG(CFG_DP_BUS_BW_RAMP_UP_POLICY) \
+	CFG(CFG_DP_BUS_BW_RAMP_DOWN_POLICY)
 
 #else
 #define CFG_HDD_DP_BUS_BANDWIDTH
@@ -1540,6 +1798,8 @@
 	CFG(CFG_DP_HTC_WMI_CREDIT_CNT) \
 	CFG(CFG_DP_ICMP_REQ_TO_FW_MARK_INTERVAL) \
 	CFG_MSCS_FEATURE_ALL \
+	CFG_LATENCY_FLOW_ALL \
+	CFG_RX_COALESCE_ALL \
 	CFG_DP_ENABLE_FASTPATH_ALL \
 	CFG_HDD_DP_BUS_BANDWIDTH \
 	CFG_DP_DRIVER_TCP_DELACK \
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_bus_bw_governor.h
+ *
+ * WLAN Host Device Driver governors deriving the bus bandwidth vote level
+ * from the packet count of each bus bandwidth compute interval.
+ */
+
+#ifndef _WLAN_HDD_BUS_BW_GOVERNOR_H
+#define _WLAN_HDD_BUS_BW_GOVERNOR_H
+
+#ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
+#include <qdf_types.h>
+#include <pld_common.h>
+
+struct hdd_config;
+struct hdd_bus_bw_governor;
+
+/**
+ * enum hdd_bus_bw_governor_type - bus bandwidth governors
+ * @HDD_BUS_BW_GOVERNOR_THRESHOLD: vote on the packet count of the last
+ *	interval against the bus bandwidth thresholds
+ * @HDD_BUS_BW_GOVERNOR_PREDICTIVE: vote on an EWMA of the packet count
+ *	extrapolated along its slope, with hysteresis on the way down
+ * @HDD_BUS_BW_GOVERNOR_MAX: max value
+ */
+enum hdd_bus_bw_governor_type {
+	HDD_BUS_BW_GOVERNOR_THRESHOLD,
+	HDD_BUS_BW_GOVERNOR_PREDICTIVE,
+	HDD_BUS_BW_GOVERNOR_MAX,
+};
+
+/**
+ * enum hdd_bus_bw_ramp_policy - how a governor moves between vote levels
+ * @HDD_BUS_BW_RAMP_JUMP: move straight to the target vote level
+ * @HDD_BUS_BW_RAMP_STEP: move one vote level at a time
+ */
+enum hdd_bus_bw_ramp_policy {
+	HDD_BUS_BW_RAMP_JUMP,
+	HDD_BUS_BW_RAMP_STEP,
+};
+
+/**
+ * struct hdd_bus_bw_gov_params - bus bandwidth governor parameters
+ * @very_high_thresh: packets per interval for PLD_BUS_WIDTH_VERY_HIGH
+ * @high_thresh: packets per interval for PLD_BUS_WIDTH_HIGH
+ * @medium_thresh: packets per interval for PLD_BUS_WIDTH_MEDIUM
+ * @low_thresh: packets per interval for PLD_BUS_WIDTH_LOW
+ * @ewma_weight: weight in percent of the latest interval in the EWMA
+ * @hysteresis: margin in percent below a threshold before lowering the vote
+ * @down_hold_cnt: intervals below the margin needed to lower the vote
+ * @ramp_up: ramp policy when raising the vote
+ * @ramp_down: ramp policy when lowering the vote
+ */
+struct hdd_bus_bw_gov_params {
+	uint32_t very_high_thresh;
+	uint32_t high_thresh;
+	uint32_t medium_thresh;
+	uint32_t low_thresh;
+	uint8_t ewma_weight;
+	uint8_t hysteresis;
+	uint8_t down_hold_cnt;
+	enum hdd_bus_bw_ramp_policy ramp_up;
+	enum hdd_bus_bw_ramp_policy ramp_down;
+};
+
+/**
+ * struct hdd_bus_bw_governor_ops - bus bandwidth governor operations
+ * @name: name of the governor
+ * @get_vote: get the vote level for the packet count of an interval
+ */
+struct hdd_bus_bw_governor_ops {
+	const char *name;
+	enum pld_bus_width_type (*get_vote)(struct hdd_bus_bw_governor *gov,
+					    uint64_t total_pkts);
+};
+
+/**
+ * struct hdd_bus_bw_governor - bus bandwidth governor context
+ * @ops: operations of the selected governor
+ * @params: governor parameters
+ * @cur_level: vote level of the last interval
+ * @ewma: moving average of the packet count
+ * @predicted: packet count predicted for the next interval
+ * @prev_pkts: packet count of the previous interval
+ * @down_cnt: consecutive intervals seen below the hysteresis margin
+ * @primed: set once the first interval has been seen
+ */
+struct hdd_bus_bw_governor {
+	const struct hdd_bus_bw_governor_ops *ops;
+	struct hdd_bus_bw_gov_params params;
+	enum pld_bus_width_type cur_level;
+	uint64_t ewma;
+	uint64_t predicted;
+	uint64_t prev_pkts;
+	uint8_t down_cnt;
+	bool primed;
+};
+
+/**
+ * hdd_bus_bw_governor_init() - select and configure the bus bw governor
+ * @gov: governor context
+ * @config: hdd config holding the bus bandwidth ini values
+ *
+ * Return: None
+ */
+void hdd_bus_bw_governor_init(struct hdd_bus_bw_governor *gov,
+			      struct hdd_config *config);
+
+/**
+ * hdd_bus_bw_governor_select() - switch the bus bw governor
+ * @gov: governor context
+ * @type: governor to use
+ *
+ * Return: None
+ */
+void hdd_bus_bw_governor_select(struct hdd_bus_bw_governor *gov,
+				enum hdd_bus_bw_governor_type type);
+
+/**
+ * hdd_bus_bw_governor_reset() - drop the traffic history of the governor
+ * @gov: governor context
+ *
+ * Called when bus bandwidth voting stops, so that the next session does
+ * not start from the prediction of the previous one.
+ *
+ * Return: None
+ */
+void hdd_bus_bw_governor_reset(struct hdd_bus_bw_governor *gov);
+
+/**
+ * hdd_bus_bw_governor_name() - get the name of the selected governor
+ * @gov: governor context
+ *
+ * Return: name of the governor
+ */
+static inline const char *
+hdd_bus_bw_governor_name(struct hdd_bus_bw_governor *gov)
+{
+	return gov->ops->name;
+}
+
+/**
+ * hdd_bus_bw_governor_get_vote() - get the vote level for an interval
+ * @gov: governor context
+ * @tx_packets: packets transmitted during the interval
+ * @rx_packets: packets received during the interval
+ *
+ * Return: bus bandwidth vote level
+ */
+enum pld_bus_width_type
+hdd_bus_bw_governor_get_vote(struct hdd_bus_bw_governor *gov,
+			     uint64_t tx_packets, uint64_t rx_packets);
+#endif /* WLAN_FEATURE_DP_BUS_BANDWIDTH */
+#endif /* _WLAN_HDD_BUS_BW_GOVERNOR_H */
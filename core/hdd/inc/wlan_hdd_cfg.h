@@ -173,6 +173,12 @@ struct hdd_config {
 	bool     enable_tcp_param_update;
 	uint32_t bus_low_cnt_threshold;
 	bool enable_latency_crit_clients;
+	uint8_t bus_bw_governor;
+	uint8_t bus_bw_ewma_weight;
+	uint8_t bus_bw_hysteresis;
+	uint8_t bus_bw_ramp_down_hold_cnt;
+	uint8_t bus_bw_ramp_up_policy;
+	uint8_t bus_bw_ramp_down_policy;
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef WLAN_FEATURE_MSCS
@@ -180,6 +186,15 @@ struct hdd_config {
 	uint32_t mscs_voice_interval;
 #endif /* WLAN_FEATURE_MSCS */
 
+#ifdef WLAN_FEATURE_LATENCY_FLOW
+	bool latency_flow_detect;
+	bool latency_flow_mscs;
+#endif /* WLAN_FEATURE_LATENCY_FLOW */
+
+#ifdef WLAN_FEATURE_RX_COALESCE
+	bool rx_coalesce;
+#endif /* WLAN_FEATURE_RX_COALESCE */
+
 #ifdef QCA_SUPPORT_TXRX_DRIVER_TCP_DEL_ACK
 	bool del_ack_enable;
 	uint32_t del_ack_threshold_high;
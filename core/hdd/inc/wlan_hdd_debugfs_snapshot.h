@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_snapshot.h
+ *
+ * WLAN Host Device Driver debugfs files showing a snapshot of a trace,
+ * taken when the file is opened, and clearing the trace when written.
+ */
+
+#ifndef _WLAN_HDD_DEBUGFS_SNAPSHOT_H
+#define _WLAN_HDD_DEBUGFS_SNAPSHOT_H
+
+#include <qdf_types.h>
+
+struct wlan_objmgr_psoc;
+
+#ifdef WLAN_DEBUGFS
+/**
+ * struct hdd_debugfs_snapshot - a snapshot debugfs file
+ * @buf_size: size of the snapshot buffer
+ * @print: print the trace into the snapshot buffer and set the number of
+ *	bytes printed in @plen
+ * @reset: clear the trace
+ */
+struct hdd_debugfs_snapshot {
+	ssize_t buf_size;
+	QDF_STATUS (*print)(struct wlan_objmgr_psoc *psoc, uint8_t *buf,
+			    ssize_t buf_len, ssize_t *plen);
+	void (*reset)(struct wlan_objmgr_psoc *psoc);
+};
+
+/**
+ * hdd_debugfs_snapshot_create() - create a snapshot file
+ * @name: name of the file under the qdf debugfs root
+ * @snapshot: callbacks of the file, must outlive it
+ *
+ * The file is removed as part of qdf remove.
+ *
+ * Return: 0 on success and errno on failure
+ */
+int hdd_debugfs_snapshot_create(const char *name,
+				struct hdd_debugfs_snapshot *snapshot);
+#endif /* WLAN_DEBUGFS */
+#endif /* _WLAN_HDD_DEBUGFS_SNAPSHOT_H */
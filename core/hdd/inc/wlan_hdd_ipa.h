@@ -41,6 +41,19 @@
  */
 void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev);
 
+/**
+ * hdd_ipa_send_nbuf_list_to_network() - Send a list of network buffers to
+ *					 kernel
+ * @nbuf_list: network buffers chained through qdf_nbuf_next
+ * @dev: network adapter
+ *
+ * Called with a batch of IPA exception packets which all belong to @dev.
+ *
+ * Return: None
+ */
+void hdd_ipa_send_nbuf_list_to_network(qdf_nbuf_t nbuf_list,
+				       qdf_netdev_t dev);
+
 /**
  * hdd_ipa_set_tx_flow_info() - To set TX flow info if IPA is
  * enabled
@@ -67,6 +80,12 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t skb, qdf_netdev_t dev)
 {
 }
 
+static inline
+void hdd_ipa_send_nbuf_list_to_network(qdf_nbuf_t nbuf_list,
+				       qdf_netdev_t dev)
+{
+}
+
 static inline void hdd_ipa_set_tx_flow_info(void)
 {
 }
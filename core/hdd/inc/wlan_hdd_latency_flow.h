@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_latency_flow.h
+ *
+ * WLAN Host Device Driver detection of latency sensitive flows. UDP flows
+ * are tracked in a bounded table and a flow whose packet size, pacing and
+ * direction symmetry look interactive, such as gaming, VoIP or a video
+ * call, is promoted to the VI or VO access category until it stops
+ * qualifying.
+ */
+
+#ifndef _WLAN_HDD_LATENCY_FLOW_H
+#define _WLAN_HDD_LATENCY_FLOW_H
+
+#include <qdf_types.h>
+#include <qdf_lock.h>
+#include <sme_qos_api.h>
+
+struct hdd_adapter;
+struct hdd_context;
+struct sk_buff;
+
+#ifdef WLAN_FEATURE_LATENCY_FLOW
+/* Number of flows tracked per adapter */
+#define HDD_LATENCY_FLOW_MAX 32
+/* Length of the window the flow is evaluated over */
+#define HDD_LATENCY_FLOW_WINDOW_US 500000
+/* A flow not seen for this long is dropped from the table */
+#define HDD_LATENCY_FLOW_IDLE_US 2000000
+/* TX packets per window, roughly 20 to 500 packets per second */
+#define HDD_LATENCY_FLOW_MIN_TX_PKTS 10
+#define HDD_LATENCY_FLOW_MAX_TX_PKTS 250
+/* Max ratio between the packet counts of the two directions */
+#define HDD_LATENCY_FLOW_MAX_DIR_RATIO 64
+/* Average TX packet size limits for VI and VO */
+#define HDD_LATENCY_FLOW_VI_MAX_SIZE 1200
+#define HDD_LATENCY_FLOW_VO_MAX_SIZE 256
+/* Max smoothed gap between two TX packets */
+#define HDD_LATENCY_FLOW_MAX_GAP_US 50000
+/* Qualifying windows needed to promote and failing ones to demote */
+#define HDD_LATENCY_FLOW_PROMOTE_CNT 2
+#define HDD_LATENCY_FLOW_DEMOTE_CNT 3
+
+/**
+ * enum hdd_latency_flow_dir - direction of a packet of a flow
+ * @HDD_LATENCY_FLOW_TX: packet transmitted by the adapter
+ * @HDD_LATENCY_FLOW_RX: packet received by the adapter
+ * @HDD_LATENCY_FLOW_DIR_MAX: max value
+ */
+enum hdd_latency_flow_dir {
+	HDD_LATENCY_FLOW_TX,
+	HDD_LATENCY_FLOW_RX,
+	HDD_LATENCY_FLOW_DIR_MAX,
+};
+
+/**
+ * struct hdd_latency_flow_key - direction independent flow identifier
+ * @hash: hash of the address and port pairs sorted so that both
+ *	directions of a flow give the same value
+ * @port: UDP ports sorted the same way
+ * @ip_ver: IP version of the flow
+ */
+struct hdd_latency_flow_key {
+	uint32_t hash;
+	uint16_t port[2];
+	uint8_t ip_ver;
+};
+
+/**
+ * struct hdd_latency_flow - state of a tracked flow
+ * @key: flow identifier
+ * @in_use: entry holds a flow
+ * @promoted: flow is currently promoted
+ * @up: user priority the flow is promoted to
+ * @pass_cnt: consecutive qualifying windows
+ * @fail_cnt: consecutive failing windows while promoted
+ * @promote_cnt: number of times the flow got promoted
+ * @window_start_us: start of the current window
+ * @last_seen_us: time of the last packet in any direction
+ * @last_tx_us: time of the last TX packet
+ * @gap_ewma_us: smoothed gap between two TX packets
+ * @jitter_ewma_us: smoothed deviation of that gap from its average
+ * @pkts: packets of the current window per direction
+ * @bytes: bytes of the current window per direction
+ * @last_pkts: packets of the last evaluated window per direction
+ * @last_tx_size: average TX packet size of the last evaluated window
+ */
+struct hdd_latency_flow {
+	struct hdd_latency_flow_key key;
+	bool in_use;
+	bool promoted;
+	uint8_t up;
+	uint8_t pass_cnt;
+	uint8_t fail_cnt;
+	uint32_t promote_cnt;
+	uint64_t window_start_us;
+	uint64_t last_seen_us;
+	uint64_t last_tx_us;
+	uint32_t gap_ewma_us;
+	uint32_t jitter_ewma_us;
+	uint32_t pkts[HDD_LATENCY_FLOW_DIR_MAX];
+	uint32_t bytes[HDD_LATENCY_FLOW_DIR_MAX];
+	uint32_t last_pkts[HDD_LATENCY_FLOW_DIR_MAX];
+	uint32_t last_tx_size;
+};
+
+/**
+ * struct hdd_latency_flow_table - bounded table of tracked flows
+ * @lock: protects the table against the TX and RX paths
+ * @enabled: detection is enabled on the adapter
+ * @num_promoted: number of flows currently promoted
+ * @evictions: flows dropped to make room for a new one
+ * @flows: tracked flows
+ */
+struct hdd_latency_flow_table {
+	qdf_spinlock_t lock;
+	bool enabled;
+	uint32_t num_promoted;
+	uint32_t evictions;
+	struct hdd_latency_flow flows[HDD_LATENCY_FLOW_MAX];
+};
+
+/**
+ * hdd_latency_flow_table_init() - initialize a flow table
+ * @table: flow table
+ * @enabled: whether flows are tracked
+ *
+ * Return: None
+ */
+void hdd_latency_flow_table_init(struct hdd_latency_flow_table *table,
+				 bool enabled);
+
+/**
+ * hdd_latency_flow_table_deinit() - deinitialize a flow table
+ * @table: flow table
+ *
+ * Return: None
+ */
+void hdd_latency_flow_table_deinit(struct hdd_latency_flow_table *table);
+
+/**
+ * hdd_latency_flow_table_update() - account a packet of a flow
+ * @table: flow table
+ * @key: flow of the packet
+ * @len: length of the packet
+ * @dir: direction of the packet
+ * @now_us: timestamp of the packet
+ *
+ * The window of the flow is evaluated first if it elapsed, so that the
+ * table costs nothing between packets.
+ *
+ * Return: user priority the flow is promoted to, SME_QOS_WMM_UP_BE if the
+ *	flow is not promoted
+ */
+enum sme_qos_wmmuptype
+hdd_latency_flow_table_update(struct hdd_latency_flow_table *table,
+			      struct hdd_latency_flow_key *key, uint32_t len,
+			      enum hdd_latency_flow_dir dir, uint64_t now_us);
+
+/**
+ * hdd_latency_flow_table_age() - evaluate and expire idle flows
+ * @table: flow table
+ * @now_us: current timestamp
+ *
+ * Return: None
+ */
+void hdd_latency_flow_table_age(struct hdd_latency_flow_table *table,
+				uint64_t now_us);
+
+/**
+ * hdd_latency_flow_table_dump() - print the flow table
+ * @table: flow table
+ * @buf: buffer to print to
+ * @buf_len: size of @buf
+ *
+ * Return: number of bytes printed
+ */
+int hdd_latency_flow_table_dump(struct hdd_latency_flow_table *table,
+				char *buf, size_t buf_len);
+
+/**
+ * hdd_latency_flow_init() - initialize flow detection of an adapter
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_latency_flow_init(struct hdd_adapter *adapter);
+
+/**
+ * hdd_latency_flow_deinit() - deinitialize flow detection of an adapter
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_latency_flow_deinit(struct hdd_adapter *adapter);
+
+/**
+ * hdd_latency_flow_tx() - account a TX packet and get its promotion
+ * @adapter: adapter the packet is transmitted on
+ * @skb: packet, starting with its ethernet header
+ * @up: set to the user priority of the flow if it is promoted
+ *
+ * Return: true if the flow of the packet is promoted
+ */
+bool hdd_latency_flow_tx(struct hdd_adapter *adapter, struct sk_buff *skb,
+			 enum sme_qos_wmmuptype *up);
+
+/**
+ * hdd_latency_flow_rx() - account an RX packet
+ * @adapter: adapter the packet is received on
+ * @skb: packet, starting with its ethernet header
+ *
+ * Return: None
+ */
+void hdd_latency_flow_rx(struct hdd_adapter *adapter, struct sk_buff *skb);
+
+/**
+ * hdd_latency_flow_age() - demote and expire idle flows of an adapter
+ * @adapter: adapter
+ *
+ * Called periodically from the bus bandwidth work, so that a flow which
+ * went silent does not stay promoted.
+ *
+ * Return: None
+ */
+void hdd_latency_flow_age(struct hdd_adapter *adapter);
+
+/**
+ * hdd_latency_flow_mscs_needed() - check if MSCS should be requested
+ * @hdd_ctx: hdd context
+ * @adapter: adapter
+ *
+ * Return: true if MSCS requests are enabled for promoted flows and the
+ *	adapter has at least one
+ */
+bool hdd_latency_flow_mscs_needed(struct hdd_context *hdd_ctx,
+				  struct hdd_adapter *adapter);
+#else
+static inline void hdd_latency_flow_init(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_latency_flow_deinit(struct hdd_adapter *adapter)
+{
+}
+
+static inline bool hdd_latency_flow_tx(struct hdd_adapter *adapter,
+				       struct sk_buff *skb,
+				       enum sme_qos_wmmuptype *up)
+{
+	return false;
+}
+
+static inline void hdd_latency_flow_rx(struct hdd_adapter *adapter,
+				       struct sk_buff *skb)
+{
+}
+
+static inline void hdd_latency_flow_age(struct hdd_adapter *adapter)
+{
+}
+
+static inline bool hdd_latency_flow_mscs_needed(struct hdd_context *hdd_ctx,
+						struct hdd_adapter *adapter)
+{
+	return false;
+}
+#endif /* WLAN_FEATURE_LATENCY_FLOW */
+#endif /* _WLAN_HDD_LATENCY_FLOW_H */
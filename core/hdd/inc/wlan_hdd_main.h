@@ -110,6 +110,7 @@
 
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
 #include "qdf_periodic_work.h"
+#include "wlan_hdd_bus_bw_governor.h"
 #endif
 
 #if defined(CLD_PM_QOS) || defined(FEATURE_RUNTIME_PM)
@@ -117,6 +118,8 @@
 #endif
 
 #include "wlan_hdd_sta_info.h"
+#include "wlan_hdd_latency_flow.h"
+#include "wlan_hdd_rx_coalesce.h"
 
 /*
  * Preprocessor definitions and constants
@@ -227,6 +230,8 @@ static inline bool in_compat_syscall(void) { return is_compat_task(); }
 #define ACS_COMPLETE_TIMEOUT 3000
 
 #define HDD_PSOC_IDLE_SHUTDOWN_SUSPEND_DELAY (1000)
+/* Net devices allocated ahead of the default interfaces, wlan0 and p2p0 */
+#define HDD_NETDEV_PREALLOC_MAX 2
 /**
  * enum hdd_adapter_flags - event bitmap flags registered net device
  * @NET_DEVICE_REGISTERED: Adapter is registered with the kernel
@@ -472,8 +477,37 @@ struct hdd_tx_rx_histogram {
 	uint64_t qtime;
 };
 
+/**
+ * struct hdd_pcpu_tx_rx_stats - per CPU data path counters of an adapter
+ * @tx_packets: packets accepted for transmission
+ * @tx_bytes: bytes accepted for transmission
+ * @tx_dropped: packets dropped in start_xmit
+ * @rx_packets: packets received from the data path
+ * @rx_bytes: bytes received from the data path
+ * @tx_called: start_xmit invocations
+ * @tx_classified_ac: packets classified into each access category
+ * @tx_dropped_ac: packets dropped in each access category
+ *
+ * These counters are updated for every packet, so each CPU owns a
+ * cacheline of its own. They are folded into struct net_device_stats and
+ * struct hdd_tx_rx_stats only when read, see hdd_sync_tx_rx_stats().
+ */
+struct hdd_pcpu_tx_rx_stats {
+	uint64_t tx_packets;
+	uint64_t tx_bytes;
+	uint64_t tx_dropped;
+	uint64_t rx_packets;
+	uint64_t rx_bytes;
+	uint32_t tx_called;
+	uint32_t tx_classified_ac[NUM_TX_QUEUES];
+	uint32_t tx_dropped_ac[NUM_TX_QUEUES];
+} ____cacheline_aligned_in_smp;
+
 struct hdd_tx_rx_stats {
-	/* start_xmit stats */
+	/* per CPU counters of the data path */
+	struct hdd_pcpu_tx_rx_stats pcpu[NUM_CPUS];
+
+	/* start_xmit stats, aggregated from pcpu */
 	__u32    tx_called;
 	__u32    tx_dropped;
 	__u32    tx_orphaned;
@@ -1126,6 +1160,8 @@ struct hdd_context;
  *                          as per enum qca_sta_connect_fail_reason_codes
  * @upgrade_udp_qos_threshold: The threshold for user priority upgrade for
 			       any UDP packet.
+ * @latency_flows: flows tracked to detect latency sensitive traffic
+ * @rx_coalesce: software coalescing of received TCP segments
  * @gro_disallowed: Flag to check if GRO is enabled or disable for adapter
  * @gro_flushed: Flag to indicate if GRO explicit flush is done or not
  * @handle_feature_update: Handle feature update only if it is triggered
@@ -1346,6 +1382,12 @@ struct hdd_adapter {
 #endif
 	uint8_t link_status;
 	uint8_t upgrade_udp_qos_threshold;
+#ifdef WLAN_FEATURE_LATENCY_FLOW
+	struct hdd_latency_flow_table latency_flows;
+#endif
+#ifdef WLAN_FEATURE_RX_COALESCE
+	struct hdd_rx_coalesce rx_coalesce;
+#endif
 
 	/* variable for temperature in Celsius */
 	int temperature;
@@ -1761,6 +1803,11 @@ struct hdd_adapter_ops_history {
  * @multi_client_thermal_mitigation: Multi client thermal mitigation by fw
  * @disconnect_for_sta_mon_conc: disconnect if sta monitor intf concurrency
  * @is_dual_mac_cfg_updated: indicate whether dual mac cfg has been updated
+ * @host_prep_work: host side preparation run while the firmware is being
+ *	downloaded and brought up
+ * @host_prep_pending: @host_prep_work is scheduled and not waited for yet
+ * @prealloc_netdev: net devices allocated by @host_prep_work for the
+ *	default interfaces
  */
 struct hdd_context {
 	struct wlan_objmgr_psoc *psoc;
@@ -1852,6 +1899,7 @@ struct hdd_context {
 	uint64_t prev_tx;
 	qdf_atomic_t low_tput_gro_enable;
 	uint32_t bus_low_vote_cnt;
+	struct hdd_bus_bw_governor bus_bw_gov;
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 	struct completion ready_to_suspend;
@@ -2104,6 +2152,9 @@ struct hdd_context {
 #endif
 	bool disconnect_for_sta_mon_conc;
 	bool is_dual_mac_cfg_updated;
+	qdf_work_t host_prep_work;
+	bool host_prep_pending;
+	struct net_device *prealloc_netdev[HDD_NETDEV_PREALLOC_MAX];
 };
 
 /**
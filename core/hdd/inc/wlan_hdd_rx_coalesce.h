@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_rx_coalesce.h
+ *
+ * WLAN Host Device Driver software coalescing of received TCP segments.
+ * In order segments of a flow are chained into a GSO super packet before
+ * they are given to the network stack, for the frames which neither LRO
+ * nor GRO took.
+ */
+
+#ifndef _WLAN_HDD_RX_COALESCE_H
+#define _WLAN_HDD_RX_COALESCE_H
+
+#include <linux/skbuff.h>
+#include <qdf_types.h>
+#include <qdf_lock.h>
+#include <qdf_atomic.h>
+#include <qdf_defer.h>
+#include <qdf_hrtimer.h>
+#include <dp_txrx.h>
+
+struct hdd_adapter;
+struct sk_buff;
+
+#ifdef WLAN_FEATURE_RX_COALESCE
+/* Number of flow tables, one per RX context */
+#define HDD_RX_COALESCE_MAX_CTX DP_MAX_RX_THREADS
+/* Number of flows held at once per RX context */
+#define HDD_RX_COALESCE_MAX_FLOWS 8
+/* Segments of a super packet, which also stays below 64KB */
+#define HDD_RX_COALESCE_MAX_SEGS 44
+/* Segments a super packet is held for at high rates */
+#define HDD_RX_COALESCE_TARGET_SEGS 16
+/* Rate below which held flows are flushed at the end of every batch */
+#define HDD_RX_COALESCE_MIN_PPS 2000
+/* Longest time a super packet is held for */
+#define HDD_RX_COALESCE_MAX_FLUSH_US 1000
+/* Length of the window the RX rate is measured over */
+#define HDD_RX_COALESCE_RATE_WINDOW_US 10000
+
+/**
+ * enum hdd_rx_coalesce_flush_reason - why a super packet got flushed
+ * @HDD_RX_COALESCE_FLUSH_BATCH: end of an RX batch
+ * @HDD_RX_COALESCE_FLUSH_TIMEOUT: flush interval elapsed
+ * @HDD_RX_COALESCE_FLUSH_OOO: segment out of order
+ * @HDD_RX_COALESCE_FLUSH_MISMATCH: segment headers or flags differ
+ * @HDD_RX_COALESCE_FLUSH_PUSH: segment has PSH set or is short
+ * @HDD_RX_COALESCE_FLUSH_FULL: super packet cannot grow further
+ * @HDD_RX_COALESCE_FLUSH_EVICT: room needed for another flow
+ * @HDD_RX_COALESCE_FLUSH_MAX: max value
+ */
+enum hdd_rx_coalesce_flush_reason {
+	HDD_RX_COALESCE_FLUSH_BATCH,
+	HDD_RX_COALESCE_FLUSH_TIMEOUT,
+	HDD_RX_COALESCE_FLUSH_OOO,
+	HDD_RX_COALESCE_FLUSH_MISMATCH,
+	HDD_RX_COALESCE_FLUSH_PUSH,
+	HDD_RX_COALESCE_FLUSH_FULL,
+	HDD_RX_COALESCE_FLUSH_EVICT,
+	HDD_RX_COALESCE_FLUSH_MAX,
+};
+
+/**
+ * struct hdd_rx_coalesce_flow - super packet held for a flow
+ * @head: first segment, holding the headers of the super packet
+ * @tail: last segment chained to the frag list of @head
+ * @start_us: time @head was received
+ * @next_seq: TCP sequence number expected next
+ * @mss: payload length of the first segment
+ * @segs: number of segments of the super packet
+ * @net_len: length of the IP header
+ * @hdr_len: length of the IP and TCP headers
+ */
+struct hdd_rx_coalesce_flow {
+	struct sk_buff *head;
+	struct sk_buff *tail;
+	uint64_t start_us;
+	uint32_t next_seq;
+	uint16_t mss;
+	uint16_t segs;
+	uint16_t net_len;
+	uint16_t hdr_len;
+};
+
+/**
+ * struct hdd_rx_coalesce_stats - coalescing statistics of an RX context
+ * @eligible: TCP segments which could be coalesced
+ * @merged: segments chained to a held super packet
+ * @super_pkts: super packets of more than one segment delivered
+ * @super_segs: segments of those super packets
+ * @flush: super packets delivered per flush reason
+ */
+struct hdd_rx_coalesce_stats {
+	uint64_t eligible;
+	uint64_t merged;
+	uint64_t super_pkts;
+	uint64_t super_segs;
+	uint64_t flush[HDD_RX_COALESCE_FLUSH_MAX];
+};
+
+/**
+ * struct hdd_rx_coalesce_ctx - flow table of an RX context
+ * @lock: protects the table against the flush timer
+ * @num_flows: number of flows held
+ * @deliver_q: released super packets waiting to be given to the stack
+ * @draining: @deliver_q is being delivered, outside of @lock
+ * @pending: @deliver_q is not fully delivered yet, read without @lock
+ * @flush_us: current flush interval, 0 to flush at every batch end
+ * @rate_pps: smoothed RX rate of eligible segments
+ * @rate_start_us: start of the current rate window
+ * @rate_pkts: eligible segments of the current rate window
+ * @stats: statistics
+ * @flows: held flows
+ */
+struct hdd_rx_coalesce_ctx {
+	qdf_spinlock_t lock;
+	uint32_t num_flows;
+	struct sk_buff_head deliver_q;
+	bool draining;
+	bool pending;
+	uint32_t flush_us;
+	uint32_t rate_pps;
+	uint64_t rate_start_us;
+	uint32_t rate_pkts;
+	struct hdd_rx_coalesce_stats stats;
+	struct hdd_rx_coalesce_flow flows[HDD_RX_COALESCE_MAX_FLOWS];
+};
+
+/**
+ * typedef hdd_rx_coalesce_deliver_cb - gives a packet to the network stack
+ * @skb: packet
+ */
+typedef void (*hdd_rx_coalesce_deliver_cb)(struct sk_buff *skb);
+
+/**
+ * struct hdd_rx_coalesce - software RX coalescing state of an adapter
+ * @enabled: coalescing is enabled on the adapter
+ * @deliver: callback released packets are delivered with
+ * @timer: flushes super packets held past their interval
+ * @timer_running: @timer is armed
+ * @flush_bh: bottom half the expired super packets are delivered from
+ * @ctx: flow tables per RX context
+ */
+struct hdd_rx_coalesce {
+	bool enabled;
+	hdd_rx_coalesce_deliver_cb deliver;
+	qdf_hrtimer_data_t timer;
+	qdf_atomic_t timer_running;
+	qdf_bh_t flush_bh;
+	struct hdd_rx_coalesce_ctx ctx[HDD_RX_COALESCE_MAX_CTX];
+};
+
+/**
+ * hdd_rx_coalesce_state_init() - initialize an RX coalescing state
+ * @rxc: RX coalescing state
+ * @enabled: coalescing is enabled
+ * @deliver: callback released packets are delivered with
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_state_init(struct hdd_rx_coalesce *rxc, bool enabled,
+				hdd_rx_coalesce_deliver_cb deliver);
+
+/**
+ * hdd_rx_coalesce_state_deinit() - deinitialize an RX coalescing state
+ * @rxc: RX coalescing state
+ *
+ * Held super packets are dropped.
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_state_deinit(struct hdd_rx_coalesce *rxc);
+
+/**
+ * hdd_rx_coalesce_state_rx() - coalesce a received packet
+ * @rxc: RX coalescing state
+ * @skb: packet, starting with its IP header
+ * @hold: @skb may start a new super packet
+ *
+ * See hdd_rx_coalesce_rx().
+ *
+ * Return: QDF_STATUS_SUCCESS if the packet is held or was delivered as
+ *	part of a super packet, QDF_STATUS_E_NOSUPPORT if it has to be
+ *	delivered by the caller
+ */
+QDF_STATUS hdd_rx_coalesce_state_rx(struct hdd_rx_coalesce *rxc,
+				    struct sk_buff *skb, bool hold);
+
+/**
+ * hdd_rx_coalesce_state_flush_flow() - deliver the super packet of a flow
+ * @rxc: RX coalescing state
+ * @skb: packet about to be given to the stack outside of the coalescing
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_state_flush_flow(struct hdd_rx_coalesce *rxc,
+				      struct sk_buff *skb);
+
+/**
+ * hdd_rx_coalesce_state_flush_batch() - end of an RX batch of a context
+ * @rxc: RX coalescing state
+ * @rx_ctx_id: RX context of the batch
+ * @flush_all: deliver every held super packet
+ *
+ * See hdd_rx_coalesce_flush_batch().
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_state_flush_batch(struct hdd_rx_coalesce *rxc,
+				       uint8_t rx_ctx_id, bool flush_all);
+
+/**
+ * hdd_rx_coalesce_state_flush_all() - deliver every held super packet
+ * @rxc: RX coalescing state
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_state_flush_all(struct hdd_rx_coalesce *rxc);
+
+/**
+ * hdd_rx_coalesce_init() - initialize RX coalescing of an adapter
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_init(struct hdd_adapter *adapter);
+
+/**
+ * hdd_rx_coalesce_deinit() - deinitialize RX coalescing of an adapter
+ * @adapter: adapter
+ *
+ * Held super packets are dropped.
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_deinit(struct hdd_adapter *adapter);
+
+/**
+ * hdd_rx_coalesce_rx() - coalesce a received packet
+ * @adapter: adapter the packet is received on
+ * @skb: packet, starting with its IP header
+ * @hold: @skb may start a new super packet, else it is only chained to
+ *	the super packet already held for its flow
+ *
+ * When @skb cannot be chained, the super packet held for its flow is
+ * delivered first. Nothing is coalesced while GRO is turned off on the
+ * interface.
+ *
+ * Return: QDF_STATUS_SUCCESS if the packet is held or was delivered as
+ *	part of a super packet, QDF_STATUS_E_NOSUPPORT if it has to be
+ *	delivered by the caller
+ */
+QDF_STATUS hdd_rx_coalesce_rx(struct hdd_adapter *adapter,
+			      struct sk_buff *skb, bool hold);
+
+/**
+ * hdd_rx_coalesce_flush_flow() - deliver the super packet of a flow
+ * @adapter: adapter the packet is received on
+ * @skb: packet about to be given to the stack outside of the coalescing
+ *
+ * Keeps the flow of @skb in order when it bypasses the coalescing.
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_flush_flow(struct hdd_adapter *adapter,
+				struct sk_buff *skb);
+
+/**
+ * hdd_rx_coalesce_flush_batch() - end of an RX batch of a context
+ * @adapter: adapter
+ * @rx_ctx_id: RX context of the batch
+ * @flush_all: deliver every held super packet, as when the RX context
+ *	has no more packets queued
+ *
+ * Otherwise only the super packets held for longer than the flush
+ * interval are delivered and the flush timer is armed for the others.
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_flush_batch(struct hdd_adapter *adapter,
+				 uint8_t rx_ctx_id, bool flush_all);
+
+/**
+ * hdd_rx_coalesce_flush_all() - deliver every held super packet
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_flush_all(struct hdd_adapter *adapter);
+
+/**
+ * hdd_rx_coalesce_dump() - print the coalescing statistics
+ * @adapter: adapter
+ * @buf: buffer to print to
+ * @buf_len: size of @buf
+ *
+ * Return: number of bytes printed
+ */
+int hdd_rx_coalesce_dump(struct hdd_adapter *adapter, char *buf,
+			 size_t buf_len);
+
+/**
+ * hdd_rx_coalesce_display_stats() - log the coalescing statistics
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_rx_coalesce_display_stats(struct hdd_adapter *adapter);
+#else
+static inline void hdd_rx_coalesce_init(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_rx_coalesce_deinit(struct hdd_adapter *adapter)
+{
+}
+
+static inline QDF_STATUS hdd_rx_coalesce_rx(struct hdd_adapter *adapter,
+					    struct sk_buff *skb, bool hold)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline void hdd_rx_coalesce_flush_flow(struct hdd_adapter *adapter,
+					      struct sk_buff *skb)
+{
+}
+
+static inline void hdd_rx_coalesce_flush_batch(struct hdd_adapter *adapter,
+					       uint8_t rx_ctx_id,
+					       bool flush_all)
+{
+}
+
+static inline void hdd_rx_coalesce_flush_all(struct hdd_adapter *adapter)
+{
+}
+
+static inline int hdd_rx_coalesce_dump(struct hdd_adapter *adapter,
+				       char *buf, size_t buf_len)
+{
+	return 0;
+}
+
+static inline void hdd_rx_coalesce_display_stats(struct hdd_adapter *adapter)
+{
+}
+#endif /* WLAN_FEATURE_RX_COALESCE */
+#endif /* _WLAN_HDD_RX_COALESCE_H */
@@ -242,6 +242,26 @@ void hdd_disable_rx_ol_for_low_tput(struct hdd_context *hdd_ctx, bool disable);
  */
 void hdd_reset_all_adapters_connectivity_stats(struct hdd_context *hdd_ctx);
 
+/**
+ * hdd_sync_tx_rx_stats() - fold the per CPU data path counters
+ * @adapter: adapter whose counters are read
+ *
+ * Sums the per CPU counters of @adapter into adapter->stats and
+ * adapter->hdd_stats.tx_rx_stats. Must be called before reading any of
+ * the aggregated counters.
+ *
+ * Return: None
+ */
+void hdd_sync_tx_rx_stats(struct hdd_adapter *adapter);
+
+/**
+ * hdd_clear_pcpu_tx_rx_stats() - reset the per CPU data path counters
+ * @adapter: adapter whose counters are reset
+ *
+ * Return: None
+ */
+void hdd_clear_pcpu_tx_rx_stats(struct hdd_adapter *adapter);
+
 /**
  * hdd_tx_rx_collect_connectivity_stats_info() - collect connectivity stats
  * @skb: pointer to skb data
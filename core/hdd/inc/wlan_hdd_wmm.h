@@ -175,6 +175,23 @@ struct hdd_wmm_ac_status {
 #endif
 };
 
+/* Number of flows whose classification is cached, must be a power of 2 */
+#define HDD_WMM_FLOW_CACHE_SIZE 64
+
+/**
+ * struct hdd_wmm_dscp_class - TX classification of a DSCP value
+ * @up - user priority of non UDP packets
+ * @queue - netdev queue of non UDP packets
+ * @udp_up - user priority of UDP packets, after the UDP QoS upgrade
+ * @udp_queue - netdev queue of UDP packets, after the UDP QoS upgrade
+ */
+struct hdd_wmm_dscp_class {
+	uint8_t up;
+	uint8_t queue;
+	uint8_t udp_up;
+	uint8_t udp_queue;
+};
+
 /**
  * struct hdd_wmm_status - WMM status maintained per-adapter
  * @context_list - list of WMM contexts active on the adapter
@@ -182,6 +199,11 @@ struct hdd_wmm_ac_status {
  * @ac_status - per-AC WMM status
  * @qap - is this connected to a QoS-enabled AP?
  * @qos_connection - is this a QoS connection?
+ * @dscp_class - DSCP to (UP, queue) table derived from dscp_to_up_map
+ * @flow_cache_gen - generation of @dscp_class, stale flow cache entries
+ *	carry an older generation
+ * @flow_cache - classification of recent TX flows indexed by skb->hash,
+ *	each entry packs hash, TOS, generation, UP and queue
  */
 struct hdd_wmm_status {
 	struct list_head context_list;
@@ -189,6 +211,9 @@ struct hdd_wmm_status {
 	struct hdd_wmm_ac_status ac_status[WLAN_MAX_AC];
 	bool qap;
 	bool qos_connection;
+	struct hdd_wmm_dscp_class dscp_class[WLAN_MAX_DSCP + 1];
+	uint16_t flow_cache_gen;
+	uint64_t flow_cache[HDD_WMM_FLOW_CACHE_SIZE];
 };
 
 extern const uint8_t hdd_qdisc_ac_to_tl_ac[];
@@ -228,6 +253,18 @@ QDF_STATUS hdd_send_dscp_up_map_to_fw(struct hdd_adapter *adapter);
  */
 QDF_STATUS hdd_wmm_dscp_initial_state(struct hdd_adapter *adapter);
 
+/**
+ * hdd_wmm_update_dscp_class() - rebuild the TX classification table
+ * @adapter: [in]  pointer to Adapter context
+ *
+ * Must be called whenever the DSCP-to-UP map or the UDP QoS upgrade
+ * threshold of @adapter changes. Flows classified with the previous
+ * table are classified again on their next packet.
+ *
+ * Return: None
+ */
+void hdd_wmm_update_dscp_class(struct hdd_adapter *adapter);
+
 /**
  * hdd_wmm_adapter_init() - initialize the WMM configuration of an adapter
  * @adapter: [in]  pointer to Adapter context
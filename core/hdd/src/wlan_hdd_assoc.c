@@ -3244,6 +3244,10 @@ hdd_association_completion_handler(struct hdd_adapter *adapter,
 								assoc_req_len,
 								assoc_rsp,
 								assoc_rsp_len);
+						wlan_cm_roam_latency_record(
+						hdd_ctx->psoc,
+						adapter->vdev_id,
+						ROAM_LATENCY_STAGE_ROAMED_IND);
 						wlan_hdd_send_roam_auth_event(
 							adapter,
 							roam_info->bssid.bytes,
@@ -3371,6 +3375,9 @@ hdd_association_completion_handler(struct hdd_adapter *adapter,
 				hdd_objmgr_set_peer_mlme_auth_state(
 							adapter->vdev,
 							true);
+				wlan_cm_roam_latency_record(
+					hdd_ctx->psoc, adapter->vdev_id,
+					ROAM_LATENCY_STAGE_PEER_AUTHORIZED);
 			}
 
 			if (QDF_IS_STATUS_SUCCESS(qdf_status)) {
@@ -3385,6 +3392,9 @@ hdd_association_completion_handler(struct hdd_adapter *adapter,
 			/* Start the tx queues */
 			hdd_debug("Enabling queues");
 			hdd_netif_queue_enable(adapter);
+			wlan_cm_roam_latency_record(
+					hdd_ctx->psoc, adapter->vdev_id,
+					ROAM_LATENCY_STAGE_NETIF_ENABLED);
 		}
 		qdf_mem_free(reqRsnIe);
 
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_bus_bw_governor.c
+ *
+ * WLAN Host Device Driver governors deriving the bus bandwidth vote level
+ * from the packet count of each bus bandwidth compute interval.
+ */
+
+#include "wlan_hdd_main.h"
+#include "wlan_hdd_bus_bw_governor.h"
+
+/**
+ * hdd_bus_bw_scale_thresh() - lower a threshold by a margin
+ * @thresh: bus bandwidth threshold
+ * @margin: margin in percent
+ *
+ * Return: scaled threshold
+ */
+static uint64_t hdd_bus_bw_scale_thresh(uint32_t thresh, uint8_t margin)
+{
+	if (!margin)
+		return thresh;
+
+	return qdf_do_div((uint64_t)thresh * (100 - margin), 100);
+}
+
+/**
+ * hdd_bus_bw_get_level() - map a packet count on a vote level
+ * @params: governor parameters
+ * @pkts: packets per interval
+ * @margin: margin in percent every threshold is lowered by
+ *
+ * Return: bus bandwidth vote level
+ */
+static enum pld_bus_width_type
+hdd_bus_bw_get_level(struct hdd_bus_bw_gov_params *params, uint64_t pkts,
+		     uint8_t margin)
+{
+	if (pkts > hdd_bus_bw_scale_thresh(params->very_high_thresh, margin))
+		return PLD_BUS_WIDTH_VERY_HIGH;
+	if (pkts > hdd_bus_bw_scale_thresh(params->high_thresh, margin))
+		return PLD_BUS_WIDTH_HIGH;
+	if (pkts > hdd_bus_bw_scale_thresh(params->medium_thresh, margin))
+		return PLD_BUS_WIDTH_MEDIUM;
+	if (pkts > hdd_bus_bw_scale_thresh(params->low_thresh, margin))
+		return PLD_BUS_WIDTH_LOW;
+
+	return PLD_BUS_WIDTH_IDLE;
+}
+
+/**
+ * hdd_bus_bw_threshold_get_vote() - threshold governor vote
+ * @gov: governor context
+ * @total_pkts: packets transmitted and received during the interval
+ *
+ * Return: bus bandwidth vote level
+ */
+static enum pld_bus_width_type
+hdd_bus_bw_threshold_get_vote(struct hdd_bus_bw_governor *gov,
+			      uint64_t total_pkts)
+{
+	gov->cur_level = hdd_bus_bw_get_level(&gov->params, total_pkts, 0);
+
+	return gov->cur_level;
+}
+
+/**
+ * hdd_bus_bw_predictive_get_vote() - predictive governor vote
+ * @gov: governor context
+ * @total_pkts: packets transmitted and received during the interval
+ *
+ * The vote is raised as soon as the traffic predicted for the next
+ * interval, the EWMA extrapolated along a rising slope, crosses a
+ * threshold. It is lowered only after the traffic stayed below the
+ * hysteresis band of the current level for down_hold_cnt intervals, so
+ * that a burst is served at once and a boundary does not flap.
+ *
+ * Return: bus bandwidth vote level
+ */
+static enum pld_bus_width_type
+hdd_bus_bw_predictive_get_vote(struct hdd_bus_bw_governor *gov,
+			       uint64_t total_pkts)
+{
+	struct hdd_bus_bw_gov_params *params = &gov->params;
+	enum pld_bus_width_type level;
+
+	if (!gov->primed) {
+		gov->ewma = total_pkts;
+		gov->prev_pkts = total_pkts;
+		gov->primed = true;
+	} else {
+		gov->ewma = qdf_do_div(total_pkts * params->ewma_weight +
+				       gov->ewma * (100 - params->ewma_weight),
+				       100);
+	}
+
+	/* only a rising slope is extrapolated, the EWMA handles the decay */
+	gov->predicted = gov->ewma;
+	if (total_pkts > gov->prev_pkts)
+		gov->predicted += total_pkts - gov->prev_pkts;
+	gov->prev_pkts = total_pkts;
+
+	level = hdd_bus_bw_get_level(params,
+				     QDF_MAX(gov->predicted, total_pkts), 0);
+	if (level > gov->cur_level) {
+		gov->down_cnt = 0;
+		if (params->ramp_up == HDD_BUS_BW_RAMP_STEP)
+			gov->cur_level++;
+		else
+			gov->cur_level = level;
+
+		return gov->cur_level;
+	}
+
+	level = hdd_bus_bw_get_level(params, QDF_MAX(gov->ewma, total_pkts),
+				     params->hysteresis);
+	if (level >= gov->cur_level) {
+		gov->down_cnt = 0;
+		return gov->cur_level;
+	}
+
+	if (++gov->down_cnt < params->down_hold_cnt)
+		return gov->cur_level;
+
+	gov->down_cnt = 0;
+	if (params->ramp_down == HDD_BUS_BW_RAMP_STEP)
+		gov->cur_level--;
+	else
+		gov->cur_level = level;
+
+	return gov->cur_level;
+}
+
+static const struct hdd_bus_bw_governor_ops
+hdd_bus_bw_governors[HDD_BUS_BW_GOVERNOR_MAX] = {
+	[HDD_BUS_BW_GOVERNOR_THRESHOLD] = {
+		.name = "threshold",
+		.get_vote = hdd_bus_bw_threshold_get_vote,
+	},
+	[HDD_BUS_BW_GOVERNOR_PREDICTIVE] = {
+		.name = "predictive",
+		.get_vote = hdd_bus_bw_predictive_get_vote,
+	},
+};
+
+void hdd_bus_bw_governor_select(struct hdd_bus_bw_governor *gov,
+				enum hdd_bus_bw_governor_type type)
+{
+	if (type >= HDD_BUS_BW_GOVERNOR_MAX)
+		type = HDD_BUS_BW_GOVERNOR_THRESHOLD;
+
+	gov->ops = &hdd_bus_bw_governors[type];
+}
+
+void hdd_bus_bw_governor_init(struct hdd_bus_bw_governor *gov,
+			      struct hdd_config *config)
+{
+	struct hdd_bus_bw_gov_params *params = &gov->params;
+
+	hdd_bus_bw_governor_select(gov, config->bus_bw_governor);
+	params->very_high_thresh = config->bus_bw_very_high_threshold;
+	params->high_thresh = config->bus_bw_high_threshold;
+	params->medium_thresh = config->bus_bw_medium_threshold;
+	params->low_thresh = config->bus_bw_low_threshold;
+	params->ewma_weight = config->bus_bw_ewma_weight;
+	params->hysteresis = config->bus_bw_hysteresis;
+	params->down_hold_cnt = config->bus_bw_ramp_down_hold_cnt;
+	params->ramp_up = config->bus_bw_ramp_up_policy;
+	params->ramp_down = config->bus_bw_ramp_down_policy;
+
+	hdd_bus_bw_governor_reset(gov);
+	hdd_debug("bus bw governor %s", gov->ops->name);
+}
+
+void hdd_bus_bw_governor_reset(struct hdd_bus_bw_governor *gov)
+{
+	gov->cur_level = PLD_BUS_WIDTH_IDLE;
+	gov->ewma = 0;
+	gov->predicted = 0;
+	gov->prev_pkts = 0;
+	gov->down_cnt = 0;
+	gov->primed = false;
+}
+
+enum pld_bus_width_type
+hdd_bus_bw_governor_get_vote(struct hdd_bus_bw_governor *gov,
+			     uint64_t tx_packets, uint64_t rx_packets)
+{
+	return gov->ops->get_vote(gov, tx_packets + rx_packets);
+}
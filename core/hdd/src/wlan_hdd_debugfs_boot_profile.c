@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_boot_profile.c
+ *
+ * WLAN Host Device Driver implementation to update
+ * debugfs with the boot phase timeline
+ */
+
+#include "wlan_hdd_main.h"
+#include "cds_boot_profile.h"
+#include "wlan_hdd_debugfs_snapshot.h"
+#include "wlan_hdd_debugfs_boot_profile.h"
+
+#define DEBUGFS_BOOT_PROFILE_BUF_SIZE (4096 * 2)
+
+/**
+ * hdd_boot_profile_print() - print the boot timeline
+ * @psoc: objmgr psoc handle, unused as the timeline covers the driver
+ * @buf: buffer to fill
+ * @buf_len: size of @buf
+ * @plen: set to the number of bytes printed
+ *
+ * Return: QDF_STATUS_SUCCESS
+ */
+static QDF_STATUS hdd_boot_profile_print(struct wlan_objmgr_psoc *psoc,
+					 uint8_t *buf, ssize_t buf_len,
+					 ssize_t *plen)
+{
+	*plen = cds_boot_profile_print(buf, buf_len);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * hdd_boot_profile_reset() - drop the bring ups recorded so far
+ * @psoc: objmgr psoc handle, unused as the timeline covers the driver
+ *
+ * Return: None
+ */
+static void hdd_boot_profile_reset(struct wlan_objmgr_psoc *psoc)
+{
+	cds_boot_profile_reset();
+}
+
+static struct hdd_debugfs_snapshot boot_profile_snapshot = {
+	.buf_size = DEBUGFS_BOOT_PROFILE_BUF_SIZE,
+	.print = hdd_boot_profile_print,
+	.reset = hdd_boot_profile_reset,
+};
+
+int hdd_debugfs_boot_profile_init(struct hdd_context *hdd_ctx)
+{
+	return hdd_debugfs_snapshot_create("boot_profile",
+					   &boot_profile_snapshot);
+}
+
+void hdd_debugfs_boot_profile_deinit(struct hdd_context *hdd_ctx)
+{
+	/*
+	 * The file is created under the qdf debugfs root and it is
+	 * removed as part of qdf remove
+	 */
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_bus_bw.c
+ *
+ * WLAN Host Device Driver implementation of the bus_bw_replay debugfs
+ * file. Per interval tx/rx packet counts written to the file, one
+ * "<tx_packets> <rx_packets>" pair per line, are fed through the bus
+ * bandwidth governors with the current ini parameters and the vote level
+ * timeline of each governor is returned on read.
+ */
+
+#include "wlan_hdd_main.h"
+#include "osif_psoc_sync.h"
+#include "wlan_hdd_bus_bw_governor.h"
+#include "wlan_hdd_debugfs_bus_bw.h"
+
+#define DEBUGFS_BUS_BW_REPLAY_MAX_INPUT (4096 * 4)
+#define DEBUGFS_BUS_BW_REPLAY_BUF_SIZE (4096 * 16)
+
+/**
+ * struct bus_bw_replay_buf - the buffer struct to save the vote timeline
+ * @len: buffer len
+ * @result: the pointer to buffer
+ */
+struct bus_bw_replay_buf {
+	ssize_t len;
+	uint8_t *result;
+};
+
+static struct bus_bw_replay_buf bus_bw_replay;
+
+static DEFINE_MUTEX(bus_bw_replay_mutex);
+
+static const char *bus_bw_level_name[] = {
+	[PLD_BUS_WIDTH_NONE] = "none",
+	[PLD_BUS_WIDTH_IDLE] = "idle",
+	[PLD_BUS_WIDTH_LOW] = "low",
+	[PLD_BUS_WIDTH_MEDIUM] = "medium",
+	[PLD_BUS_WIDTH_HIGH] = "high",
+	[PLD_BUS_WIDTH_VERY_HIGH] = "very_high",
+	[PLD_BUS_WIDTH_LOW_LATENCY] = "low_latency",
+};
+
+/**
+ * hdd_bus_bw_replay() - feed packet counts through the governors
+ * @hdd_ctx: hdd context
+ * @input: NUL terminated packet counts, modified by this API
+ *
+ * Caller must hold bus_bw_replay_mutex.
+ *
+ * Return: None
+ */
+static void hdd_bus_bw_replay(struct hdd_context *hdd_ctx, char *input)
+{
+	struct hdd_bus_bw_governor gov[HDD_BUS_BW_GOVERNOR_MAX];
+	enum pld_bus_width_type level;
+	uint64_t tx_packets, rx_packets;
+	uint8_t *buf = bus_bw_replay.result;
+	ssize_t size = DEBUGFS_BUS_BW_REPLAY_BUF_SIZE;
+	ssize_t len;
+	uint32_t interval = 0;
+	char *line;
+	int i;
+
+	for (i = 0; i < HDD_BUS_BW_GOVERNOR_MAX; i++) {
+		hdd_bus_bw_governor_init(&gov[i], hdd_ctx->config);
+		hdd_bus_bw_governor_select(&gov[i], i);
+	}
+
+	len = scnprintf(buf, size, "%8s %10s %10s", "interval", "tx", "rx");
+	for (i = 0; i < HDD_BUS_BW_GOVERNOR_MAX; i++)
+		len += scnprintf(buf + len, size - len, " %11s",
+				 hdd_bus_bw_governor_name(&gov[i]));
+	len += scnprintf(buf + len, size - len, " %10s %10s\n",
+			 "ewma", "predicted");
+
+	while ((line = strsep(&input, "\n"))) {
+		if (sscanf(line, "%llu %llu", &tx_packets, &rx_packets) != 2)
+			continue;
+
+		len += scnprintf(buf + len, size - len, "%8u %10llu %10llu",
+				 interval++, tx_packets, rx_packets);
+		for (i = 0; i < HDD_BUS_BW_GOVERNOR_MAX; i++) {
+			level = hdd_bus_bw_governor_get_vote(&gov[i],
+							     tx_packets,
+							     rx_packets);
+			len += scnprintf(buf + len, size - len, " %11s",
+					 bus_bw_level_name[level]);
+		}
+		len += scnprintf(buf + len, size - len, " %10llu %10llu\n",
+				 gov[HDD_BUS_BW_GOVERNOR_PREDICTIVE].ewma,
+				 gov[HDD_BUS_BW_GOVERNOR_PREDICTIVE].predicted);
+	}
+
+	bus_bw_replay.len = len;
+}
+
+/**
+ * __wlan_hdd_write_bus_bw_replay_debugfs() - replay packet counts
+ * @hdd_ctx: hdd context
+ * @buf: text being written to the debugfs
+ * @count: size of @buf
+ *
+ * The whole trace has to be written at once, every write starts a new
+ * replay.
+ *
+ * Return: number of bytes processed or errno
+ */
+static ssize_t __wlan_hdd_write_bus_bw_replay_debugfs(
+		struct hdd_context *hdd_ctx,
+		const char __user *buf, size_t count)
+{
+	char *input;
+
+	if (!count || count > DEBUGFS_BUS_BW_REPLAY_MAX_INPUT) {
+		hdd_err_rl("Input length (%zu) is invalid, expected [1, %d]",
+			   count, DEBUGFS_BUS_BW_REPLAY_MAX_INPUT);
+		return -EINVAL;
+	}
+
+	input = qdf_mem_malloc(count + 1);
+	if (!input)
+		return -ENOMEM;
+
+	if (copy_from_user(input, buf, count)) {
+		qdf_mem_free(input);
+		return -EFAULT;
+	}
+	input[count] = '\0';
+
+	mutex_lock(&bus_bw_replay_mutex);
+	if (!bus_bw_replay.result)
+		bus_bw_replay.result =
+			qdf_mem_malloc(DEBUGFS_BUS_BW_REPLAY_BUF_SIZE);
+	if (bus_bw_replay.result)
+		hdd_bus_bw_replay(hdd_ctx, input);
+	mutex_unlock(&bus_bw_replay_mutex);
+
+	qdf_mem_free(input);
+
+	return count;
+}
+
+/**
+ * wlan_hdd_write_bus_bw_replay_debugfs() - wrapper to replay packet counts
+ * @file: file pointer
+ * @buf: buffer
+ * @count: count
+ * @pos: position pointer
+ *
+ * Return: number of bytes processed or errno
+ */
+static ssize_t wlan_hdd_write_bus_bw_replay_debugfs(struct file *file,
+						    const char __user *buf,
+						    size_t count, loff_t *pos)
+{
+	struct hdd_context *hdd_ctx = file_inode(file)->i_private;
+	struct osif_psoc_sync *psoc_sync;
+	ssize_t errno_size;
+
+	errno_size = wlan_hdd_validate_context(hdd_ctx);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy),
+					     &psoc_sync);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = __wlan_hdd_write_bus_bw_replay_debugfs(hdd_ctx, buf,
+							    count);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+
+	return errno_size;
+}
+
+/**
+ * wlan_hdd_read_bus_bw_replay_debugfs() - read the vote timeline
+ * @file: file pointer
+ * @buf: buffer
+ * @count: count
+ * @pos: position pointer
+ *
+ * Return: Number of bytes read on success, error number otherwise
+ */
+static ssize_t wlan_hdd_read_bus_bw_replay_debugfs(struct file *file,
+						   char __user *buf,
+						   size_t count, loff_t *pos)
+{
+	ssize_t ret = 0;
+
+	mutex_lock(&bus_bw_replay_mutex);
+	if (bus_bw_replay.result)
+		ret = simple_read_from_buffer(buf, count, pos,
+					      bus_bw_replay.result,
+					      bus_bw_replay.len);
+	mutex_unlock(&bus_bw_replay_mutex);
+
+	return ret;
+}
+
+static const struct file_operations fops_bus_bw_replay_debugfs = {
+	.read = wlan_hdd_read_bus_bw_replay_debugfs,
+	.write = wlan_hdd_write_bus_bw_replay_debugfs,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+int hdd_debugfs_bus_bw_init(struct hdd_context *hdd_ctx)
+{
+	if (!debugfs_create_file("bus_bw_replay", 0644,
+				 qdf_debugfs_get_root(),
+				 hdd_ctx, &fops_bus_bw_replay_debugfs))
+		return -EINVAL;
+
+	return 0;
+}
+
+void hdd_debugfs_bus_bw_deinit(struct hdd_context *hdd_ctx)
+{
+	/*
+	 * The file is created under the qdf debugfs root and it is
+	 * removed as part of qdf remove
+	 */
+	mutex_lock(&bus_bw_replay_mutex);
+	qdf_mem_free(bus_bw_replay.result);
+	bus_bw_replay.result = NULL;
+	bus_bw_replay.len = 0;
+	mutex_unlock(&bus_bw_replay_mutex);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_pmo_latency.c
+ *
+ * WLAN Host Device Driver implementation to update
+ * debugfs with suspend/resume latency trace
+ */
+
+#include "wlan_hdd_main.h"
+#include "wlan_pmo_ucfg_api.h"
+#include "wlan_hdd_debugfs_snapshot.h"
+#include "wlan_hdd_debugfs_pmo_latency.h"
+
+#define DEBUGFS_PMO_LATENCY_BUF_SIZE (4096 * 4)
+
+static struct hdd_debugfs_snapshot pmo_latency_snapshot = {
+	.buf_size = DEBUGFS_PMO_LATENCY_BUF_SIZE,
+	.print = ucfg_pmo_latency_print,
+	.reset = ucfg_pmo_latency_reset,
+};
+
+int hdd_debugfs_pmo_latency_init(struct hdd_context *hdd_ctx)
+{
+	return hdd_debugfs_snapshot_create("pmo_latency",
+					   &pmo_latency_snapshot);
+}
+
+void hdd_debugfs_pmo_latency_deinit(struct hdd_context *hdd_ctx)
+{
+	/*
+	 * The file is created under the qdf debugfs root and it is
+	 * removed as part of qdf remove
+	 */
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_snapshot.c
+ *
+ * WLAN Host Device Driver implementation of the debugfs files showing a
+ * snapshot of a trace
+ */
+
+#include "wlan_hdd_main.h"
+#include "osif_psoc_sync.h"
+#include "wlan_hdd_debugfs_snapshot.h"
+
+/**
+ * struct hdd_debugfs_snapshot_buf - the buffer struct to save a snapshot
+ * @len: buffer len
+ * @result: the buffer
+ */
+struct hdd_debugfs_snapshot_buf {
+	ssize_t len;
+	uint8_t result[];
+};
+
+/**
+ * __wlan_hdd_read_snapshot_debugfs() - function to get the snapshot
+ * @file: file pointer
+ * @buf: buffer
+ * @count: count
+ * @pos: position pointer
+ *
+ * Return: Number of bytes read on success, error number otherwise
+ */
+static ssize_t __wlan_hdd_read_snapshot_debugfs(struct file *file,
+						char __user *buf,
+						size_t count, loff_t *pos)
+{
+	struct hdd_debugfs_snapshot_buf *snap = file->private_data;
+
+	if (!snap)
+		return -ENOMEM;
+
+	return simple_read_from_buffer(buf, count, pos, snap->result,
+				       snap->len);
+}
+
+/**
+ * wlan_hdd_read_snapshot_debugfs() - wrapper function to get the snapshot
+ * @file: file pointer
+ * @buf: buffer
+ * @count: count
+ * @pos: position pointer
+ *
+ * Return: Number of bytes read on success, error number otherwise
+ */
+static ssize_t wlan_hdd_read_snapshot_debugfs(struct file *file,
+					      char __user *buf,
+					      size_t count, loff_t *pos)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	struct osif_psoc_sync *psoc_sync;
+	ssize_t err_size;
+
+	err_size = wlan_hdd_validate_context(hdd_ctx);
+	if (err_size)
+		return err_size;
+
+	err_size = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy),
+					   &psoc_sync);
+	if (err_size)
+		return err_size;
+
+	err_size = __wlan_hdd_read_snapshot_debugfs(file, buf, count, pos);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+
+	return err_size;
+}
+
+/**
+ * wlan_hdd_write_snapshot_debugfs() - clear the trace
+ * @file: file pointer
+ * @buf: buffer
+ * @count: count
+ * @pos: position pointer
+ *
+ * Any write to the file clears the trace collected so far.
+ *
+ * Return: Number of bytes consumed on success, error number otherwise
+ */
+static ssize_t wlan_hdd_write_snapshot_debugfs(struct file *file,
+					       const char __user *buf,
+					       size_t count, loff_t *pos)
+{
+	struct hdd_debugfs_snapshot *snapshot = file_inode(file)->i_private;
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	struct osif_psoc_sync *psoc_sync;
+	ssize_t errno;
+
+	errno = wlan_hdd_validate_context(hdd_ctx);
+	if (errno)
+		return errno;
+
+	errno = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy),
+					&psoc_sync);
+	if (errno)
+		return errno;
+
+	snapshot->reset(hdd_ctx->psoc);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+
+	return count;
+}
+
+/**
+ * __wlan_hdd_open_snapshot_debugfs() - function to open a snapshot debugfs
+ * @hdd_ctx: hdd context
+ * @file: file pointer
+ *
+ * The trace is snapshotted on open so that a reader sees a consistent view
+ * even if the trace is updated while it is reading.
+ *
+ * Return: Errno
+ */
+static int __wlan_hdd_open_snapshot_debugfs(struct hdd_context *hdd_ctx,
+					    struct file *file)
+{
+	struct hdd_debugfs_snapshot *snapshot = file_inode(file)->i_private;
+	struct hdd_debugfs_snapshot_buf *snap;
+	QDF_STATUS status;
+
+	if (!(file->f_mode & FMODE_READ))
+		return 0;
+
+	snap = qdf_mem_malloc(sizeof(*snap) + snapshot->buf_size);
+	if (!snap)
+		return -ENOMEM;
+
+	status = snapshot->print(hdd_ctx->psoc, snap->result,
+				 snapshot->buf_size, &snap->len);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		qdf_mem_free(snap);
+		return qdf_status_to_os_return(status);
+	}
+
+	file->private_data = snap;
+	return 0;
+}
+
+/**
+ * wlan_hdd_open_snapshot_debugfs() - wrapper function to open a snapshot
+ * debugfs
+ * @inode: Pointer to inode structure
+ * @file: file pointer
+ *
+ * Return: Errno
+ */
+static int wlan_hdd_open_snapshot_debugfs(struct inode *inode,
+					  struct file *file)
+{
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
+	struct osif_psoc_sync *psoc_sync;
+	ssize_t errno;
+
+	errno = wlan_hdd_validate_context(hdd_ctx);
+	if (errno)
+		return errno;
+
+	errno = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy),
+					&psoc_sync);
+	if (errno)
+		return errno;
+
+	errno = __wlan_hdd_open_snapshot_debugfs(hdd_ctx, file);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+	return errno;
+}
+
+/**
+ * wlan_hdd_release_snapshot_debugfs() - wrapper to release
+ * @inode: Pointer to inode structure
+ * @file: file pointer
+ *
+ * Return: Errno
+ */
+static int wlan_hdd_release_snapshot_debugfs(struct inode *inode,
+					     struct file *file)
+{
+	qdf_mem_free(file->private_data);
+	file->private_data = NULL;
+
+	return 0;
+}
+
+static const struct file_operations fops_snapshot_debugfs = {
+	.read = wlan_hdd_read_snapshot_debugfs,
+	.write = wlan_hdd_write_snapshot_debugfs,
+	.open = wlan_hdd_open_snapshot_debugfs,
+	.release = wlan_hdd_release_snapshot_debugfs,
+	.owner = THIS_MODULE,
+	.llseek = default_llseek,
+};
+
+int hdd_debugfs_snapshot_create(const char *name,
+				struct hdd_debugfs_snapshot *snapshot)
+{
+	if (!debugfs_create_file(name, 0644, qdf_debugfs_get_root(),
+				 snapshot, &fops_snapshot_debugfs))
+		return -EINVAL;
+
+	return 0;
+}
@@ -47,6 +47,7 @@
 #include <qdf_notifier.h>
 #include <qdf_hang_event_notifier.h>
 #include "wlan_hdd_thermal.h"
+#include "cds_boot_profile.h"
 
 #ifdef MODULE
 #define WLAN_MODULE_NAME  module_name(THIS_MODULE)
@@ -557,6 +558,7 @@ static int __hdd_soc_probe(struct device *dev,
 	hdd_info("probing driver");
 
 	hdd_soc_load_lock(dev);
+	cds_boot_profile_start(CDS_BOOT_LOAD);
 	cds_set_load_in_progress(true);
 	cds_set_driver_in_bad_state(false);
 	cds_set_recovery_in_progress(false);
@@ -576,11 +578,13 @@ static int __hdd_soc_probe(struct device *dev,
 		goto unlock;
 	}
 
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_CTX_CREATE);
 	hdd_ctx = hdd_context_create(dev);
 	if (IS_ERR(hdd_ctx)) {
 		errno = PTR_ERR(hdd_ctx);
 		goto assert_fail_count;
 	}
+	cds_boot_profile_step_end(CDS_BOOT_STEP_CTX_CREATE);
 
 	errno = hdd_wlan_startup(hdd_ctx);
 	if (errno)
@@ -597,6 +601,7 @@ static int __hdd_soc_probe(struct device *dev,
 	cds_set_load_in_progress(false);
 	hdd_start_complete(0);
 	hdd_thermal_mitigation_register(hdd_ctx, dev);
+	cds_boot_profile_stop(QDF_STATUS_SUCCESS);
 
 	hdd_soc_load_unlock(dev);
 
@@ -615,6 +620,7 @@ assert_fail_count:
 	QDF_BUG(probe_fail_cnt < SSR_MAX_FAIL_CNT);
 
 unlock:
+	cds_boot_profile_stop(qdf_status_from_os_return(errno));
 	cds_set_load_in_progress(false);
 	hdd_soc_load_unlock(dev);
 
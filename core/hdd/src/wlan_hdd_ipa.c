@@ -433,22 +433,17 @@ static int hdd_ipa_aggregated_rx_ind(qdf_nbuf_t skb)
 }
 #endif
 
-void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
+/**
+ * hdd_ipa_update_rx_nbuf() - Prepare IPA exception packet for network stack
+ * @adapter: adapter the packet is received on
+ * @nbuf: network buffer
+ *
+ * Return: None
+ */
+static void hdd_ipa_update_rx_nbuf(struct hdd_adapter *adapter,
+				   qdf_nbuf_t nbuf)
 {
-	struct hdd_adapter *adapter = (struct hdd_adapter *) netdev_priv(dev);
-	int result;
-	unsigned int cpu_index;
-	uint32_t enabled;
-
-	if (hdd_validate_adapter(adapter)) {
-		kfree_skb(nbuf);
-		return;
-	}
-
-	if (cds_is_driver_unloading()) {
-		kfree_skb(nbuf);
-		return;
-	}
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 
 	if ((adapter->device_mode == QDF_SAP_MODE) &&
 	    (qdf_nbuf_is_ipv4_dhcp_pkt(nbuf) == true)) {
@@ -470,6 +465,37 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
 				      QDF_DP_TRACE_RX_PACKET_RECORD, 0,
 				      QDF_RX));
 
+	nbuf->dev = adapter->dev;
+	nbuf->protocol = eth_type_trans(nbuf, nbuf->dev);
+	nbuf->ip_summed = CHECKSUM_NONE;
+
+	/*
+	 * Update STA RX exception packet stats.
+	 * For SAP as part of IPA HW stats are updated.
+	 */
+
+	pcpu_stats = &adapter->hdd_stats.tx_rx_stats.pcpu[wlan_hdd_get_cpu()];
+	++pcpu_stats->rx_packets;
+	pcpu_stats->rx_bytes += nbuf->len;
+}
+
+void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
+{
+	struct hdd_adapter *adapter = (struct hdd_adapter *) netdev_priv(dev);
+	int result;
+	unsigned int cpu_index;
+	uint32_t enabled;
+
+	if (hdd_validate_adapter(adapter)) {
+		kfree_skb(nbuf);
+		return;
+	}
+
+	if (cds_is_driver_unloading()) {
+		kfree_skb(nbuf);
+		return;
+	}
+
 	/*
 	 * Set PF_WAKE_UP_IDLE flag in the task structure
 	 * This task and any task woken by this will be waken to idle CPU
@@ -478,22 +504,12 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
 	if (!enabled)
 		hdd_ipa_set_wake_up_idle(true);
 
-	nbuf->dev = adapter->dev;
-	nbuf->protocol = eth_type_trans(nbuf, nbuf->dev);
-	nbuf->ip_summed = CHECKSUM_NONE;
+	hdd_ipa_update_rx_nbuf(adapter, nbuf);
 
 	cpu_index = wlan_hdd_get_cpu();
 
 	++adapter->hdd_stats.tx_rx_stats.rx_packets[cpu_index];
 
-	/*
-	 * Update STA RX exception packet stats.
-	 * For SAP as part of IPA HW stats are updated.
-	 */
-
-	++adapter->stats.rx_packets;
-	adapter->stats.rx_bytes += nbuf->len;
-
 	result = hdd_ipa_aggregated_rx_ind(nbuf);
 	if (result == NET_RX_SUCCESS) {
 		++adapter->hdd_stats.tx_rx_stats.rx_delivered[cpu_index];
@@ -511,6 +527,104 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
 		hdd_ipa_set_wake_up_idle(false);
 }
 
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 19, 0))
+/**
+ * hdd_ipa_send_list_to_nw_stack() - Send a list of packets to network stack
+ * @nbuf_list: packets chained through qdf_nbuf_next
+ *
+ * If IPA LAN RX supports NAPI polling the whole list is received with a
+ * single netif_receive_skb_list call. Otherwise each packet is queued with
+ * netif_rx and the RX softirq is run once for the whole list when bottom
+ * halves are enabled again. The list is sent from the IPA exception batch
+ * work, so bottom halves are disabled around the hand over.
+ *
+ * Return: Number of packets refused by the network stack
+ */
+static uint32_t hdd_ipa_send_list_to_nw_stack(qdf_nbuf_t nbuf_list)
+{
+	struct list_head rx_list;
+	qdf_nbuf_t nbuf, next;
+	uint32_t refused = 0;
+
+	local_bh_disable();
+	if (qdf_ipa_get_lan_rx_napi()) {
+		INIT_LIST_HEAD(&rx_list);
+		for (nbuf = nbuf_list; nbuf; nbuf = next) {
+			next = qdf_nbuf_next(nbuf);
+			qdf_nbuf_set_next(nbuf, NULL);
+			list_add_tail(&nbuf->list, &rx_list);
+		}
+		netif_receive_skb_list(&rx_list);
+	} else {
+		for (nbuf = nbuf_list; nbuf; nbuf = next) {
+			next = qdf_nbuf_next(nbuf);
+			qdf_nbuf_set_next(nbuf, NULL);
+			if (netif_rx(nbuf) != NET_RX_SUCCESS)
+				refused++;
+		}
+	}
+	local_bh_enable();
+
+	return refused;
+}
+#else
+static uint32_t hdd_ipa_send_list_to_nw_stack(qdf_nbuf_t nbuf_list)
+{
+	qdf_nbuf_t nbuf, next;
+	uint32_t refused = 0;
+
+	local_bh_disable();
+	for (nbuf = nbuf_list; nbuf; nbuf = next) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+		if (netif_rx(nbuf) != NET_RX_SUCCESS)
+			refused++;
+	}
+	local_bh_enable();
+
+	return refused;
+}
+#endif
+
+void hdd_ipa_send_nbuf_list_to_network(qdf_nbuf_t nbuf_list, qdf_netdev_t dev)
+{
+	struct hdd_adapter *adapter = (struct hdd_adapter *) netdev_priv(dev);
+	qdf_nbuf_t nbuf, next;
+	unsigned int cpu_index;
+	uint32_t enabled;
+	uint32_t count = 0;
+	uint32_t refused;
+
+	if (hdd_validate_adapter(adapter) || cds_is_driver_unloading()) {
+		for (nbuf = nbuf_list; nbuf; nbuf = next) {
+			next = qdf_nbuf_next(nbuf);
+			kfree_skb(nbuf);
+		}
+		return;
+	}
+
+	enabled = hdd_ipa_get_wake_up_idle();
+	if (!enabled)
+		hdd_ipa_set_wake_up_idle(true);
+
+	for (nbuf = nbuf_list; nbuf; nbuf = qdf_nbuf_next(nbuf)) {
+		hdd_ipa_update_rx_nbuf(adapter, nbuf);
+		count++;
+	}
+
+	cpu_index = wlan_hdd_get_cpu();
+	adapter->hdd_stats.tx_rx_stats.rx_packets[cpu_index] += count;
+
+	refused = hdd_ipa_send_list_to_nw_stack(nbuf_list);
+
+	adapter->hdd_stats.tx_rx_stats.rx_delivered[cpu_index] +=
+							count - refused;
+	adapter->hdd_stats.tx_rx_stats.rx_refused[cpu_index] += refused;
+
+	if (!enabled)
+		hdd_ipa_set_wake_up_idle(false);
+}
+
 void hdd_ipa_set_mcc_mode(bool mcc_mode)
 {
 	struct hdd_context *hdd_ctx;
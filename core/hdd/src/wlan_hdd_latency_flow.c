@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_latency_flow.c
+ *
+ * WLAN Host Device Driver detection of latency sensitive flows.
+ *
+ * Every UDP packet of the adapter is accounted to its flow over windows
+ * of HDD_LATENCY_FLOW_WINDOW_US. At the end of a window the flow
+ * qualifies as interactive if it
+ *  - sent a moderate number of packets, which rules out both idle and
+ *    bulk flows,
+ *  - received packets too, within HDD_LATENCY_FLOW_MAX_DIR_RATIO of the
+ *    sent ones, which rules out one way streaming,
+ *  - sent packets smaller than HDD_LATENCY_FLOW_VI_MAX_SIZE,
+ *  - sent them at a steady pace, i.e. the jitter of the gap between two
+ *    TX packets is not larger than the gap itself.
+ * A flow is promoted after HDD_LATENCY_FLOW_PROMOTE_CNT qualifying
+ * windows, to VO if its packets are small and to VI otherwise, and is
+ * demoted after HDD_LATENCY_FLOW_DEMOTE_CNT failing ones.
+ */
+
+#include <linux/jhash.h>
+#include <linux/ip.h>
+#include <linux/ipv6.h>
+#include <linux/udp.h>
+#include <linux/if_ether.h>
+#include <net/ip.h>
+#include "wlan_hdd_main.h"
+#include "wlan_hdd_latency_flow.h"
+
+/**
+ * hdd_latency_flow_reset_window() - start a new window of a flow
+ * @flow: flow
+ *
+ * Return: None
+ */
+static void hdd_latency_flow_reset_window(struct hdd_latency_flow *flow)
+{
+	qdf_mem_zero(flow->pkts, sizeof(flow->pkts));
+	qdf_mem_zero(flow->bytes, sizeof(flow->bytes));
+}
+
+/**
+ * hdd_latency_flow_qualifies() - check the last window of a flow
+ * @flow: flow
+ * @up: user priority the flow qualifies for
+ *
+ * Return: true if the flow looked interactive during the window
+ */
+static bool hdd_latency_flow_qualifies(struct hdd_latency_flow *flow,
+				       enum sme_qos_wmmuptype *up)
+{
+	uint32_t tx = flow->pkts[HDD_LATENCY_FLOW_TX];
+	uint32_t rx = flow->pkts[HDD_LATENCY_FLOW_RX];
+	uint32_t size;
+
+	if (tx < HDD_LATENCY_FLOW_MIN_TX_PKTS ||
+	    tx > HDD_LATENCY_FLOW_MAX_TX_PKTS || !rx)
+		return false;
+
+	if (QDF_MAX(tx, rx) > HDD_LATENCY_FLOW_MAX_DIR_RATIO * QDF_MIN(tx, rx))
+		return false;
+
+	size = flow->bytes[HDD_LATENCY_FLOW_TX] / tx;
+	if (size > HDD_LATENCY_FLOW_VI_MAX_SIZE)
+		return false;
+
+	if (flow->gap_ewma_us > HDD_LATENCY_FLOW_MAX_GAP_US ||
+	    flow->jitter_ewma_us > flow->gap_ewma_us)
+		return false;
+
+	if (size <= HDD_LATENCY_FLOW_VO_MAX_SIZE)
+		*up = SME_QOS_WMM_UP_VO;
+	else
+		*up = SME_QOS_WMM_UP_VI;
+
+	return true;
+}
+
+/**
+ * hdd_latency_flow_fail() - account a failing window of a flow
+ * @table: flow table
+ * @flow: flow
+ *
+ * Return: None
+ */
+static void hdd_latency_flow_fail(struct hdd_latency_flow_table *table,
+				  struct hdd_latency_flow *flow)
+{
+	flow->pass_cnt = 0;
+	if (!flow->promoted)
+		return;
+
+	if (++flow->fail_cnt < HDD_LATENCY_FLOW_DEMOTE_CNT)
+		return;
+
+	flow->promoted = false;
+	flow->fail_cnt = 0;
+	table->num_promoted--;
+	hdd_debug("demote flow %08x port %u-%u", flow->key.hash,
+		  flow->key.port[0], flow->key.port[1]);
+}
+
+/**
+ * hdd_latency_flow_evaluate() - evaluate the elapsed windows of a flow
+ * @table: flow table
+ * @flow: flow
+ * @now_us: current timestamp
+ *
+ * Windows without any packet after the first elapsed one are failing
+ * windows.
+ *
+ * Return: None
+ */
+static void hdd_latency_flow_evaluate(struct hdd_latency_flow_table *table,
+				      struct hdd_latency_flow *flow,
+				      uint64_t now_us)
+{
+	enum sme_qos_wmmuptype up;
+	uint64_t windows;
+
+	if (now_us - flow->window_start_us < HDD_LATENCY_FLOW_WINDOW_US)
+		return;
+
+	windows = qdf_do_div(now_us - flow->window_start_us,
+			     HDD_LATENCY_FLOW_WINDOW_US);
+	flow->window_start_us += windows * HDD_LATENCY_FLOW_WINDOW_US;
+
+	qdf_mem_copy(flow->last_pkts, flow->pkts, sizeof(flow->pkts));
+	flow->last_tx_size = flow->pkts[HDD_LATENCY_FLOW_TX] ?
+		flow->bytes[HDD_LATENCY_FLOW_TX] /
+		flow->pkts[HDD_LATENCY_FLOW_TX] : 0;
+
+	if (hdd_latency_flow_qualifies(flow, &up)) {
+		flow->fail_cnt = 0;
+		if (!flow->promoted &&
+		    ++flow->pass_cnt >= HDD_LATENCY_FLOW_PROMOTE_CNT) {
+			/* the AC is kept while promoted to avoid reordering */
+			flow->promoted = true;
+			flow->up = up;
+			flow->promote_cnt++;
+			table->num_promoted++;
+			hdd_debug("promote flow %08x port %u-%u to up %d",
+				  flow->key.hash, flow->key.port[0],
+				  flow->key.port[1], up);
+		}
+	} else {
+		hdd_latency_flow_fail(table, flow);
+	}
+	hdd_latency_flow_reset_window(flow);
+
+	while (--windows && flow->promoted)
+		hdd_latency_flow_fail(table, flow);
+	if (windows)
+		flow->pass_cnt = 0;
+}
+
+/**
+ * hdd_latency_flow_remove() - drop a flow from the table
+ * @table: flow table
+ * @flow: flow
+ *
+ * Return: None
+ */
+static void hdd_latency_flow_remove(struct hdd_latency_flow_table *table,
+				    struct hdd_latency_flow *flow)
+{
+	if (flow->promoted)
+		table->num_promoted--;
+	qdf_mem_zero(flow, sizeof(*flow));
+}
+
+/**
+ * hdd_latency_flow_get() - find or add the entry of a flow
+ * @table: flow table
+ * @key: flow identifier
+ * @now_us: current timestamp
+ *
+ * When the table is full the least recently seen flow is replaced.
+ *
+ * Return: entry of the flow
+ */
+static struct hdd_latency_flow *
+hdd_latency_flow_get(struct hdd_latency_flow_table *table,
+		     struct hdd_latency_flow_key *key, uint64_t now_us)
+{
+	struct hdd_latency_flow *flow, *victim = NULL;
+	int i;
+
+	for (i = 0; i < HDD_LATENCY_FLOW_MAX; i++) {
+		flow = &table->flows[i];
+		if (!flow->in_use) {
+			if (!victim || victim->in_use)
+				victim = flow;
+			continue;
+		}
+
+		if (flow->key.hash == key->hash &&
+		    flow->key.port[0] == key->port[0] &&
+		    flow->key.port[1] == key->port[1] &&
+		    flow->key.ip_ver == key->ip_ver)
+			return flow;
+
+		if (!victim || (victim->in_use &&
+				flow->last_seen_us < victim->last_seen_us))
+			victim = flow;
+	}
+
+	if (victim->in_use) {
+		table->evictions++;
+		hdd_latency_flow_remove(table, victim);
+	}
+
+	victim->key = *key;
+	victim->in_use = true;
+	victim->window_start_us = now_us;
+	victim->last_seen_us = now_us;
+
+	return victim;
+}
+
+/**
+ * hdd_latency_flow_update_gap() - update the TX pacing of a flow
+ * @flow: flow
+ * @now_us: timestamp of the TX packet
+ *
+ * Return: None
+ */
+static void hdd_latency_flow_update_gap(struct hdd_latency_flow *flow,
+					uint64_t now_us)
+{
+	int32_t gap, diff;
+
+	if (!flow->last_tx_us) {
+		flow->last_tx_us = now_us;
+		flow->gap_ewma_us = HDD_LATENCY_FLOW_MAX_GAP_US;
+		return;
+	}
+
+	gap = QDF_MIN(now_us - flow->last_tx_us,
+		      (uint64_t)HDD_LATENCY_FLOW_IDLE_US);
+	flow->last_tx_us = now_us;
+
+	/* EWMA with weight 1/8, as the RTT estimator of TCP */
+	diff = gap - (int32_t)flow->gap_ewma_us;
+	flow->gap_ewma_us += diff / 8;
+	if (diff < 0)
+		diff = -diff;
+	flow->jitter_ewma_us += (diff - (int32_t)flow->jitter_ewma_us) / 8;
+}
+
+enum sme_qos_wmmuptype
+hdd_latency_flow_table_update(struct hdd_latency_flow_table *table,
+			      struct hdd_latency_flow_key *key, uint32_t len,
+			      enum hdd_latency_flow_dir dir, uint64_t now_us)
+{
+	struct hdd_latency_flow *flow;
+	enum sme_qos_wmmuptype up = SME_QOS_WMM_UP_BE;
+
+	qdf_spin_lock_bh(&table->lock);
+
+	flow = hdd_latency_flow_get(table, key, now_us);
+	hdd_latency_flow_evaluate(table, flow, now_us);
+
+	flow->pkts[dir]++;
+	flow->bytes[dir] += len;
+	flow->last_seen_us = now_us;
+	if (dir == HDD_LATENCY_FLOW_TX)
+		hdd_latency_flow_update_gap(flow, now_us);
+
+	if (flow->promoted)
+		up = flow->up;
+
+	qdf_spin_unlock_bh(&table->lock);
+
+	return up;
+}
+
+void hdd_latency_flow_table_age(struct hdd_latency_flow_table *table,
+				uint64_t now_us)
+{
+	struct hdd_latency_flow *flow;
+	int i;
+
+	qdf_spin_lock_bh(&table->lock);
+	for (i = 0; i < HDD_LATENCY_FLOW_MAX; i++) {
+		flow = &table->flows[i];
+		if (!flow->in_use)
+			continue;
+
+		if (now_us - flow->last_seen_us > HDD_LATENCY_FLOW_IDLE_US)
+			hdd_latency_flow_remove(table, flow);
+		else
+			hdd_latency_flow_evaluate(table, flow, now_us);
+	}
+	qdf_spin_unlock_bh(&table->lock);
+}
+
+int hdd_latency_flow_table_dump(struct hdd_latency_flow_table *table,
+				char *buf, size_t buf_len)
+{
+	struct hdd_latency_flow *flow;
+	int len;
+	int i;
+
+	qdf_spin_lock_bh(&table->lock);
+	len = scnprintf(buf, buf_len,
+			"enabled %d promoted %u evictions %u\n"
+			"%8s %2s %5s %5s %5s %2s %6s %6s %5s %8s %8s\n",
+			table->enabled, table->num_promoted, table->evictions,
+			"hash", "ip", "port0", "port1", "state", "up",
+			"tx_pkt", "rx_pkt", "size", "gap_us", "jitter");
+	for (i = 0; i < HDD_LATENCY_FLOW_MAX; i++) {
+		flow = &table->flows[i];
+		if (!flow->in_use)
+			continue;
+
+		len += scnprintf(buf + len, buf_len - len,
+				 "%08x %2u %5u %5u %5s %2u %6u %6u %5u %8u %8u\n",
+				 flow->key.hash, flow->key.ip_ver,
+				 flow->key.port[0], flow->key.port[1],
+				 flow->promoted ? "promo" : "-",
+				 flow->promoted ? flow->up : 0,
+				 flow->last_pkts[HDD_LATENCY_FLOW_TX],
+				 flow->last_pkts[HDD_LATENCY_FLOW_RX],
+				 flow->last_tx_size, flow->gap_ewma_us,
+				 flow->jitter_ewma_us);
+	}
+	qdf_spin_unlock_bh(&table->lock);
+
+	return len;
+}
+
+void hdd_latency_flow_table_init(struct hdd_latency_flow_table *table,
+				 bool enabled)
+{
+	qdf_mem_zero(table, sizeof(*table));
+	qdf_spinlock_create(&table->lock);
+	table->enabled = enabled;
+}
+
+void hdd_latency_flow_table_deinit(struct hdd_latency_flow_table *table)
+{
+	table->enabled = false;
+	qdf_spinlock_destroy(&table->lock);
+}
+
+/**
+ * hdd_latency_flow_make_key() - build the identifier of a flow
+ * @key: flow identifier to fill
+ * @ip_ver: IP version
+ * @src: source address
+ * @dst: destination address
+ * @addr_words: length of an address in 32 bit words
+ * @sport: source port, network order
+ * @dport: destination port, network order
+ *
+ * The address and port pairs are sorted, so that a packet and its reply
+ * map on the same flow.
+ *
+ * Return: None
+ */
+static void hdd_latency_flow_make_key(struct hdd_latency_flow_key *key,
+				      uint8_t ip_ver, const uint32_t *src,
+				      const uint32_t *dst, uint32_t addr_words,
+				      uint16_t sport, uint16_t dport)
+{
+	uint32_t words[2 * (sizeof(struct in6_addr) / sizeof(uint32_t)) + 1];
+	uint32_t addr_len = addr_words * sizeof(uint32_t);
+	int cmp;
+
+	sport = ntohs(sport);
+	dport = ntohs(dport);
+	cmp = qdf_mem_cmp(src, dst, addr_len);
+	if (cmp > 0 || (!cmp && sport > dport)) {
+		swap(src, dst);
+		swap(sport, dport);
+	}
+
+	qdf_mem_copy(words, src, addr_len);
+	qdf_mem_copy(&words[addr_words], dst, addr_len);
+	words[2 * addr_words] = (uint32_t)sport << 16 | dport;
+
+	key->hash = jhash2(words, 2 * addr_words + 1, ip_ver);
+	key->port[0] = sport;
+	key->port[1] = dport;
+	key->ip_ver = ip_ver;
+}
+
+/**
+ * hdd_latency_flow_get_key() - get the flow identifier of a packet
+ * @skb: packet, starting with its ethernet header
+ * @key: flow identifier to fill
+ *
+ * Return: true if the packet belongs to a UDP flow
+ */
+static bool hdd_latency_flow_get_key(struct sk_buff *skb,
+				     struct hdd_latency_flow_key *key)
+{
+	struct ethhdr *eth = (struct ethhdr *)skb->data;
+	struct iphdr *iph;
+	struct ipv6hdr *ip6h;
+	struct udphdr *udph;
+	uint32_t hlen = skb_headlen(skb);
+	uint32_t offset = ETH_HLEN;
+
+	if (hlen < ETH_HLEN)
+		return false;
+
+	switch (eth->h_proto) {
+	case htons(ETH_P_IP):
+		iph = (struct iphdr *)(skb->data + offset);
+		if (hlen < offset + sizeof(*iph) || iph->ihl < 5 ||
+		    iph->protocol != IPPROTO_UDP || ip_is_fragment(iph))
+			return false;
+		offset += iph->ihl * 4;
+		if (hlen < offset + sizeof(*udph))
+			return false;
+		udph = (struct udphdr *)(skb->data + offset);
+		hdd_latency_flow_make_key(key, 4, &iph->saddr, &iph->daddr,
+					  1, udph->source, udph->dest);
+		return true;
+	case htons(ETH_P_IPV6):
+		ip6h = (struct ipv6hdr *)(skb->data + offset);
+		if (hlen < offset + sizeof(*ip6h) ||
+		    ip6h->nexthdr != IPPROTO_UDP)
+			return false;
+		offset += sizeof(*ip6h);
+		if (hlen < offset + sizeof(*udph))
+			return false;
+		udph = (struct udphdr *)(skb->data + offset);
+		hdd_latency_flow_make_key(key, 6, ip6h->saddr.s6_addr32,
+					  ip6h->daddr.s6_addr32, 4,
+					  udph->source, udph->dest);
+		return true;
+	default:
+		return false;
+	}
+}
+
+void hdd_latency_flow_init(struct hdd_adapter *adapter)
+{
+	struct hdd_context *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+
+	hdd_latency_flow_table_init(&adapter->latency_flows,
+				    hdd_ctx->config->latency_flow_detect);
+}
+
+void hdd_latency_flow_deinit(struct hdd_adapter *adapter)
+{
+	hdd_latency_flow_table_deinit(&adapter->latency_flows);
+}
+
+bool hdd_latency_flow_tx(struct hdd_adapter *adapter, struct sk_buff *skb,
+			 enum sme_qos_wmmuptype *up)
+{
+	struct hdd_latency_flow_key key;
+	enum sme_qos_wmmuptype flow_up;
+
+	if (!adapter->latency_flows.enabled ||
+	    !hdd_latency_flow_get_key(skb, &key))
+		return false;
+
+	flow_up = hdd_latency_flow_table_update(&adapter->latency_flows, &key,
+						skb->len, HDD_LATENCY_FLOW_TX,
+						qdf_get_log_timestamp_usecs());
+	if (flow_up == SME_QOS_WMM_UP_BE)
+		return false;
+
+	*up = flow_up;
+
+	return true;
+}
+
+void hdd_latency_flow_rx(struct hdd_adapter *adapter, struct sk_buff *skb)
+{
+	struct hdd_latency_flow_key key;
+
+	if (!adapter->latency_flows.enabled ||
+	    !hdd_latency_flow_get_key(skb, &key))
+		return;
+
+	hdd_latency_flow_table_update(&adapter->latency_flows, &key, skb->len,
+				      HDD_LATENCY_FLOW_RX,
+				      qdf_get_log_timestamp_usecs());
+}
+
+void hdd_latency_flow_age(struct hdd_adapter *adapter)
+{
+	if (!adapter->latency_flows.enabled)
+		return;
+
+	hdd_latency_flow_table_age(&adapter->latency_flows,
+				   qdf_get_log_timestamp_usecs());
+}
+
+bool hdd_latency_flow_mscs_needed(struct hdd_context *hdd_ctx,
+				  struct hdd_adapter *adapter)
+{
+	return hdd_ctx->config->latency_flow_mscs &&
+	       READ_ONCE(adapter->latency_flows.num_promoted);
+}
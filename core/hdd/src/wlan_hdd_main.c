@@ -176,6 +176,11 @@
 #include <target_type.h>
 #include <wlan_hdd_debugfs_coex.h>
 #include <wlan_hdd_debugfs_config.h>
+#include <wlan_hdd_debugfs_pmo_latency.h>
+#include <wlan_hdd_debugfs_boot_profile.h>
+#include "cds_boot_profile.h"
+#include <wlan_hdd_debugfs_roam_latency.h>
+#include <wlan_hdd_debugfs_bus_bw.h>
 #include "wlan_blm_ucfg_api.h"
 #include "ftm_time_sync_ucfg_api.h"
 #include "ol_txrx.h"
@@ -3845,6 +3850,140 @@ void hdd_set_qmi_stats_enabled(struct hdd_context *hdd_ctx)
 }
 #endif
 
+/**
+ * hdd_netdev_prealloc() - allocate the net devices of the default interfaces
+ * @hdd_ctx: hdd context
+ *
+ * The adapter lives in the private area of its net device, which makes it
+ * one of the largest allocations of the bring up.
+ *
+ * Return: None
+ */
+static void hdd_netdev_prealloc(struct hdd_context *hdd_ctx)
+{
+	struct net_device *dev;
+	int i;
+
+	for (i = 0; i < HDD_NETDEV_PREALLOC_MAX; i++) {
+		if (hdd_ctx->prealloc_netdev[i])
+			continue;
+
+		dev = alloc_netdev_mq(sizeof(struct hdd_adapter), "wlan%d",
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 17, 0)) || defined(WITH_BACKPORTS)
+				      NET_NAME_UNKNOWN,
+#endif
+				      ether_setup, NUM_TX_QUEUES);
+		if (!dev) {
+			hdd_debug("Failed to preallocate net_device %d", i);
+			return;
+		}
+
+		hdd_ctx->prealloc_netdev[i] = dev;
+	}
+}
+
+/**
+ * hdd_netdev_prealloc_get() - take a preallocated net device
+ * @hdd_ctx: hdd context
+ * @session_type: type of the interface the net device is for
+ *
+ * Return: net device, NULL if none is left or if the interface needs
+ *	another setup than ethernet
+ */
+static struct net_device *
+hdd_netdev_prealloc_get(struct hdd_context *hdd_ctx, uint8_t session_type)
+{
+	struct net_device *dev;
+	int i;
+
+	if (hdd_ctx->host_prep_pending ||
+	    cds_get_conparam() == QDF_GLOBAL_MONITOR_MODE ||
+	    wlan_hdd_is_session_type_monitor(session_type))
+		return NULL;
+
+	for (i = 0; i < HDD_NETDEV_PREALLOC_MAX; i++) {
+		dev = hdd_ctx->prealloc_netdev[i];
+		if (dev) {
+			hdd_ctx->prealloc_netdev[i] = NULL;
+			return dev;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * hdd_netdev_prealloc_free() - free the preallocated net devices left
+ * @hdd_ctx: hdd context
+ *
+ * Return: None
+ */
+static void hdd_netdev_prealloc_free(struct hdd_context *hdd_ctx)
+{
+	int i;
+
+	for (i = 0; i < HDD_NETDEV_PREALLOC_MAX; i++) {
+		if (!hdd_ctx->prealloc_netdev[i])
+			continue;
+
+		free_netdev(hdd_ctx->prealloc_netdev[i]);
+		hdd_ctx->prealloc_netdev[i] = NULL;
+	}
+}
+
+/**
+ * hdd_host_prep_work() - host side preparation of a bring up
+ * @data: hdd context
+ *
+ * Return: None
+ */
+static void hdd_host_prep_work(void *data)
+{
+	struct hdd_context *hdd_ctx = data;
+
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_HOST_PREP);
+	hdd_netdev_prealloc(hdd_ctx);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_HOST_PREP);
+}
+
+/**
+ * hdd_host_prep_start() - start the host side preparation of a bring up
+ * @hdd_ctx: hdd context
+ *
+ * The steps which depend on neither the firmware nor the configuration it
+ * reports are run from a work, so that they overlap the firmware download
+ * and the wait for the ready events instead of adding to them.
+ *
+ * Return: None
+ */
+static void hdd_host_prep_start(struct hdd_context *hdd_ctx)
+{
+	struct hdd_adapter *adapter;
+
+	/* the interfaces are kept across SSR and idle shutdown */
+	if (hdd_get_conparam() != QDF_GLOBAL_MISSION_MODE ||
+	    QDF_IS_STATUS_SUCCESS(hdd_get_front_adapter(hdd_ctx, &adapter)))
+		return;
+
+	hdd_ctx->host_prep_pending = true;
+	qdf_sched_work(0, &hdd_ctx->host_prep_work);
+}
+
+/**
+ * hdd_host_prep_wait() - wait for the host side preparation to complete
+ * @hdd_ctx: hdd context
+ *
+ * Return: None
+ */
+static void hdd_host_prep_wait(struct hdd_context *hdd_ctx)
+{
+	if (!hdd_ctx->host_prep_pending)
+		return;
+
+	qdf_flush_work(&hdd_ctx->host_prep_work);
+	hdd_ctx->host_prep_pending = false;
+}
+
 int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 {
 	int ret = 0;
@@ -3881,7 +4020,9 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 		hdd_debug_domain_set(QDF_DEBUG_DOMAIN_ACTIVE);
 
 		if (!reinit && !unint) {
+			cds_boot_profile_step_begin(CDS_BOOT_STEP_POWER_ON);
 			ret = pld_power_on(qdf_dev->dev);
+			cds_boot_profile_step_end(CDS_BOOT_STEP_POWER_ON);
 			if (ret) {
 				hdd_err("Failed to power up device; errno:%d",
 					ret);
@@ -3893,10 +4034,12 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 		hdd_init_adapter_ops_wq(hdd_ctx);
 		pld_set_fw_log_mode(hdd_ctx->parent_dev,
 				    hdd_ctx->config->enable_fw_log);
+		cds_boot_profile_step_begin(CDS_BOOT_STEP_HIF_OPEN);
 		ret = hdd_hif_open(qdf_dev->dev, qdf_dev->drv_hdl, qdf_dev->bid,
 				   qdf_dev->bus_type,
 				   (reinit == true) ?  HIF_ENABLE_TYPE_REINIT :
 				   HIF_ENABLE_TYPE_PROBE);
+		cds_boot_profile_step_end(CDS_BOOT_STEP_HIF_OPEN);
 		if (ret) {
 			hdd_err("Failed to open hif; errno: %d", ret);
 			goto power_down;
@@ -3942,6 +4085,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 
 		hdd_update_cds_ac_specs_params(hdd_ctx);
 
+		cds_boot_profile_step_begin(CDS_BOOT_STEP_PSOC_OPEN);
 		status = hdd_component_psoc_open(hdd_ctx->psoc);
 		if (QDF_IS_STATUS_ERROR(status)) {
 			hdd_err("Failed to Open legacy components; status: %d",
@@ -3956,11 +4100,14 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 				ret);
 			goto ipa_component_free;
 		}
+		cds_boot_profile_step_end(CDS_BOOT_STEP_PSOC_OPEN);
 
 		status = wbuff_module_init();
 		if (QDF_IS_STATUS_ERROR(status))
 			hdd_err("WBUFF init unsuccessful; status: %d", status);
 
+		hdd_host_prep_start(hdd_ctx);
+
 		status = cds_open(hdd_ctx->psoc);
 		if (QDF_IS_STATUS_ERROR(status)) {
 			hdd_err("Failed to Open CDS; status: %d", status);
@@ -3992,7 +4139,9 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 		if (hdd_get_conparam() == QDF_GLOBAL_MONITOR_MODE)
 			hdd_override_all_ps(hdd_ctx);
 
+		cds_boot_profile_step_begin(CDS_BOOT_STEP_DP_OPEN);
 		status = cds_dp_open(hdd_ctx->psoc);
+		cds_boot_profile_step_end(CDS_BOOT_STEP_DP_OPEN);
 		if (!QDF_IS_STATUS_SUCCESS(status)) {
 			hdd_err("Failed to Open cds post open; status: %d",
 				status);
@@ -4021,7 +4170,10 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 
 		wlan_hdd_register_btc_chain_mode_handler(hdd_ctx->psoc);
 
+		cds_boot_profile_step_begin(CDS_BOOT_STEP_PRE_ENABLE);
 		status = cds_pre_enable();
+		cds_boot_profile_step_end(CDS_BOOT_STEP_PRE_ENABLE);
+		hdd_host_prep_wait(hdd_ctx);
 		if (!QDF_IS_STATUS_SUCCESS(status)) {
 			hdd_err("Failed to pre-enable CDS; status: %d", status);
 			ret = qdf_status_to_os_return(status);
@@ -4048,7 +4200,9 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			break;
 		}
 
+		cds_boot_profile_step_begin(CDS_BOOT_STEP_CONFIGURE);
 		ret = hdd_configure_cds(hdd_ctx);
+		cds_boot_profile_step_end(CDS_BOOT_STEP_CONFIGURE);
 		if (ret) {
 			hdd_err("Failed to Enable cds modules; errno: %d", ret);
 			goto sched_disable;
@@ -4078,6 +4232,8 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 				 hdd_softap_ipa_start_xmit);
 	ucfg_ipa_reg_send_to_nw_cb(hdd_ctx->pdev,
 				   hdd_ipa_send_nbuf_to_network);
+	ucfg_ipa_reg_send_to_nw_list_cb(hdd_ctx->pdev,
+					hdd_ipa_send_nbuf_list_to_network);
 	ucfg_ipa_reg_rps_enable_cb(hdd_ctx->pdev,
 				   hdd_adapter_set_rps);
 	hdd_exit();
@@ -4118,6 +4274,7 @@ close:
 	cds_close(hdd_ctx->psoc);
 
 psoc_close:
+	hdd_host_prep_wait(hdd_ctx);
 	hdd_component_psoc_close(hdd_ctx->psoc);
 	wlan_global_lmac_if_close(hdd_ctx->psoc);
 	cds_deinit_ini_config();
@@ -4810,11 +4967,11 @@ static void __hdd_set_multicast_list(struct net_device *dev)
 	if (!mc_list_request)
 		return;
 
-	/* Delete already configured multicast address list */
-	if (adapter->mc_addr_list.mc_cnt > 0)
-		hdd_disable_and_flush_mc_addr_list(adapter,
-			pmo_mc_list_change_notify);
-
+	/*
+	 * Already configured multicast address list is not deleted here,
+	 * PMO only sends the delta between the installed and the new list
+	 * to fwr when the new list is enabled.
+	 */
 	if (dev->flags & IFF_ALLMULTI) {
 		hdd_debug("allow all multicast frames");
 		hdd_disable_and_flush_mc_addr_list(adapter,
@@ -5156,14 +5313,23 @@ hdd_alloc_station_adapter(struct hdd_context *hdd_ctx, tSirMacAddr mac_addr,
 	QDF_STATUS qdf_status;
 
 	/* cfg80211 initialization and registration */
-	dev = alloc_netdev_mq(sizeof(*adapter), name,
+	dev = hdd_netdev_prealloc_get(hdd_ctx, session_type);
+	if (dev) {
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 17, 0)) || defined(WITH_BACKPORTS)
+		dev->name_assign_type = name_assign_type;
+#endif
+	} else {
+		dev = alloc_netdev_mq(sizeof(*adapter), name,
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 17, 0)) || defined(WITH_BACKPORTS)
-			      name_assign_type,
+				      name_assign_type,
 #endif
-			      ((cds_get_conparam() == QDF_GLOBAL_MONITOR_MODE ||
-			       wlan_hdd_is_session_type_monitor(session_type)) ?
-			       hdd_mon_mode_ether_setup : ether_setup),
-			      NUM_TX_QUEUES);
+				      ((cds_get_conparam() ==
+					QDF_GLOBAL_MONITOR_MODE ||
+				       wlan_hdd_is_session_type_monitor(
+							session_type)) ?
+				       hdd_mon_mode_ether_setup : ether_setup),
+				      NUM_TX_QUEUES);
+	}
 
 	if (!dev) {
 		hdd_err("Failed to allocate new net_device '%s'", name);
@@ -5954,6 +6120,8 @@ static void hdd_cleanup_adapter(struct hdd_context *hdd_ctx,
 	qdf_mutex_destroy(&adapter->disconnection_status_lock);
 	hdd_periodic_sta_stats_mutex_destroy(adapter);
 	hdd_apf_context_destroy(adapter);
+	hdd_latency_flow_deinit(adapter);
+	hdd_rx_coalesce_deinit(adapter);
 	qdf_spinlock_destroy(&adapter->vdev_lock);
 	hdd_sta_info_deinit(&adapter->sta_info_list);
 	hdd_sta_info_deinit(&adapter->cache_sta_info_list);
@@ -6752,6 +6920,9 @@ struct hdd_adapter *hdd_open_adapter(struct hdd_context *hdd_ctx, uint8_t sessio
 		goto err_cleanup_adapter;
 
 	adapter->upgrade_udp_qos_threshold = QCA_WLAN_AC_BK;
+	hdd_wmm_update_dscp_class(adapter);
+	hdd_latency_flow_init(adapter);
+	hdd_rx_coalesce_init(adapter);
 	qdf_spinlock_create(&adapter->vdev_lock);
 	qdf_atomic_init(&hdd_ctx->num_latency_critical_clients);
 
@@ -9040,6 +9211,10 @@ static void hdd_rx_wake_lock_create(struct hdd_context *hdd_ctx)
  */
 static int hdd_context_deinit(struct hdd_context *hdd_ctx)
 {
+	qdf_flush_work(&hdd_ctx->host_prep_work);
+	qdf_destroy_work(0, &hdd_ctx->host_prep_work);
+	hdd_netdev_prealloc_free(hdd_ctx);
+
 	qdf_wake_lock_destroy(&hdd_ctx->monitor_mode_wakelock);
 
 	wlan_hdd_cfg80211_deinit(hdd_ctx->wiphy);
@@ -9114,6 +9289,10 @@ void hdd_wlan_exit(struct hdd_context *hdd_ctx)
 
 	wlan_hdd_destroy_mib_stats_lock();
 	hdd_debugfs_ini_config_deinit(hdd_ctx);
+	hdd_debugfs_pmo_latency_deinit(hdd_ctx);
+	hdd_debugfs_roam_latency_deinit(hdd_ctx);
+	hdd_debugfs_bus_bw_deinit(hdd_ctx);
+	hdd_debugfs_boot_profile_deinit(hdd_ctx);
 	hdd_debugfs_mws_coex_info_deinit(hdd_ctx);
 	hdd_psoc_idle_timer_stop(hdd_ctx);
 	hdd_regulatory_deinit(hdd_ctx);
@@ -9861,18 +10040,11 @@ static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 
 	cpumask_clear(&pm_qos_cpu_mask);
 
+	/* keep the governor history up to date even while overridden */
+	next_vote_level = hdd_bus_bw_governor_get_vote(&hdd_ctx->bus_bw_gov,
+						       tx_packets, rx_packets);
 	if (hdd_ctx->high_bus_bw_request)
 		next_vote_level = PLD_BUS_WIDTH_VERY_HIGH;
-	else if (total_pkts > hdd_ctx->config->bus_bw_very_high_threshold)
-		next_vote_level = PLD_BUS_WIDTH_VERY_HIGH;
-	else if (total_pkts > hdd_ctx->config->bus_bw_high_threshold)
-		next_vote_level = PLD_BUS_WIDTH_HIGH;
-	else if (total_pkts > hdd_ctx->config->bus_bw_medium_threshold)
-		next_vote_level = PLD_BUS_WIDTH_MEDIUM;
-	else if (total_pkts > hdd_ctx->config->bus_bw_low_threshold)
-		next_vote_level = PLD_BUS_WIDTH_LOW;
-	else
-		next_vote_level = PLD_BUS_WIDTH_IDLE;
 
 	dptrace_high_tput_req =
 			next_vote_level > PLD_BUS_WIDTH_IDLE ? true : false;
@@ -10192,6 +10364,12 @@ void hdd_send_mscs_action_frame(struct hdd_context *hdd_ctx,
 	uint64_t mscs_vo_pkt_delta;
 	unsigned long tx_vo_pkts;
 
+	if (hdd_latency_flow_mscs_needed(hdd_ctx, adapter)) {
+		if (!mlme_get_is_mscs_req_sent(adapter->vdev))
+			sme_send_mscs_action_frame(adapter->vdev_id);
+		return;
+	}
+
 	tx_vo_pkts = adapter->hdd_stats.tx_rx_stats.tx_classified_ac[SME_AC_VO];
 
 	if (!adapter->mscs_counter)
@@ -10230,6 +10408,8 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 	bool connected = false;
 	uint32_t ipa_tx_packets = 0, ipa_rx_packets = 0;
 	uint64_t sta_tx_bytes = 0, sap_tx_bytes = 0;
+	struct hdd_tx_rx_stats *tx_rx_stats;
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 
 	if (wlan_hdd_validate_context(hdd_ctx))
 		goto stop_work;
@@ -10264,6 +10444,9 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 			continue;
 		}
 
+		hdd_sync_tx_rx_stats(adapter);
+		hdd_latency_flow_age(adapter);
+
 		tx_packets += HDD_BW_GET_DIFF(adapter->stats.tx_packets,
 					      adapter->prev_tx_packets);
 		rx_packets += HDD_BW_GET_DIFF(adapter->stats.rx_packets,
@@ -10336,8 +10519,10 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 	hdd_ipa_set_perf_level(hdd_ctx, &tx_packets, &rx_packets,
 			       &ipa_tx_packets, &ipa_rx_packets);
 	if (con_sap_adapter) {
-		con_sap_adapter->stats.tx_packets += ipa_tx_packets;
-		con_sap_adapter->stats.rx_packets += ipa_rx_packets;
+		tx_rx_stats = &con_sap_adapter->hdd_stats.tx_rx_stats;
+		pcpu_stats = &tx_rx_stats->pcpu[wlan_hdd_get_cpu()];
+		pcpu_stats->tx_packets += ipa_tx_packets;
+		pcpu_stats->rx_packets += ipa_rx_packets;
 	}
 
 	hdd_pld_request_bus_bandwidth(hdd_ctx, tx_packets, rx_packets);
@@ -10369,6 +10554,8 @@ int hdd_bus_bandwidth_init(struct hdd_context *hdd_ctx)
 
 	qdf_spinlock_create(&hdd_ctx->bus_bw_lock);
 
+	hdd_bus_bw_governor_init(&hdd_ctx->bus_bw_gov, hdd_ctx->config);
+
 	hdd_pm_qos_add_request(hdd_ctx);
 
 	status = qdf_periodic_work_create(&hdd_ctx->bus_bw_work,
@@ -11818,6 +12005,9 @@ static int hdd_context_init(struct hdd_context *hdd_ctx)
 	qdf_wake_lock_create(&hdd_ctx->monitor_mode_wakelock,
 			     "monitor_mode_wakelock");
 
+	qdf_create_work(0, &hdd_ctx->host_prep_work, hdd_host_prep_work,
+			hdd_ctx);
+
 	return 0;
 
 sap_destroy:
@@ -11932,7 +12122,9 @@ static int __hdd_psoc_idle_restart(struct hdd_context *hdd_ctx)
 	if (ret)
 		return ret;
 
+	cds_boot_profile_start(CDS_BOOT_IDLE_RESTART);
 	ret = hdd_wlan_start_modules(hdd_ctx, false);
+	cds_boot_profile_stop(qdf_status_from_os_return(ret));
 
 	hdd_soc_idle_restart_unlock();
 
@@ -14819,6 +15011,7 @@ int hdd_wlan_startup(struct hdd_context *hdd_ctx)
 	if (hdd_get_conparam() == QDF_GLOBAL_EPPING_MODE)
 		return 0;
 
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_WIPHY_INIT);
 	wlan_hdd_update_wiphy(hdd_ctx);
 
 	hdd_ctx->mac_handle = cds_get_context(QDF_MODULE_ID_SME);
@@ -14832,6 +15025,7 @@ int hdd_wlan_startup(struct hdd_context *hdd_ctx)
 		hdd_err("Failed to initialize wiphy; errno:%d", errno);
 		goto stop_modules;
 	}
+	cds_boot_profile_step_end(CDS_BOOT_STEP_WIPHY_INIT);
 
 	errno = hdd_initialize_mac_address(hdd_ctx);
 	if (errno) {
@@ -14857,6 +15051,10 @@ int hdd_wlan_startup(struct hdd_context *hdd_ctx)
 	hdd_set_idle_ps_config(hdd_ctx, is_imps_enabled);
 	hdd_debugfs_mws_coex_info_init(hdd_ctx);
 	hdd_debugfs_ini_config_init(hdd_ctx);
+	hdd_debugfs_pmo_latency_init(hdd_ctx);
+	hdd_debugfs_roam_latency_init(hdd_ctx);
+	hdd_debugfs_bus_bw_init(hdd_ctx);
+	hdd_debugfs_boot_profile_init(hdd_ctx);
 	wlan_hdd_debugfs_unit_test_host_create(hdd_ctx);
 	wlan_hdd_create_mib_stats_lock();
 	wlan_cfg80211_init_interop_issues_ap(hdd_ctx->pdev);
@@ -14895,11 +15093,14 @@ QDF_STATUS hdd_psoc_create_vdevs(struct hdd_context *hdd_ctx)
 	enum QDF_GLOBAL_MODE driver_mode = hdd_get_conparam();
 	QDF_STATUS status;
 
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_CREATE_VDEVS);
 	status = hdd_open_adapters_for_mode(hdd_ctx, driver_mode);
+	hdd_netdev_prealloc_free(hdd_ctx);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		hdd_err("Failed to create vdevs; status:%d", status);
 		return status;
 	}
+	cds_boot_profile_step_end(CDS_BOOT_STEP_CREATE_VDEVS);
 
 	if (hdd_ctx->rps)
 		hdd_set_rps_cpu_mask(hdd_ctx);
@@ -15660,6 +15861,7 @@ exit:
 	if (!hdd_is_any_adapter_connected(hdd_ctx)) {
 		qdf_atomic_set(&hdd_ctx->num_latency_critical_clients, 0);
 		hdd_ctx->cur_vote_level = PLD_BUS_WIDTH_NONE;
+		hdd_bus_bw_governor_reset(&hdd_ctx->bus_bw_gov);
 		pld_request_bus_bandwidth(hdd_ctx->parent_dev,
 					  PLD_BUS_WIDTH_NONE);
 	}
@@ -15688,6 +15890,8 @@ void hdd_bus_bw_compute_prev_txrx_stats(struct hdd_adapter *adapter)
 {
 	struct hdd_context *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
 
+	hdd_sync_tx_rx_stats(adapter);
+
 	qdf_spin_lock_bh(&hdd_ctx->bus_bw_lock);
 	adapter->prev_tx_packets = adapter->stats.tx_packets;
 	adapter->prev_rx_packets = adapter->stats.rx_packets;
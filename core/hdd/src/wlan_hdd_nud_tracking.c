@@ -24,6 +24,7 @@
 #include "wlan_hdd_main.h"
 #include "wlan_blm_ucfg_api.h"
 #include "hdd_dp_cfg.h"
+#include "wlan_hdd_tx_rx.h"
 #include <cdp_txrx_misc.h>
 
 void hdd_nud_set_gateway_addr(struct hdd_adapter *adapter,
@@ -157,6 +158,8 @@ static void hdd_nud_stats_info(struct hdd_adapter *adapter)
 static void hdd_nud_capture_stats(struct hdd_adapter *adapter,
 				  uint8_t nud_state)
 {
+	hdd_sync_tx_rx_stats(adapter);
+
 	switch (nud_state) {
 	case NUD_INCOMPLETE:
 	case NUD_PROBE:
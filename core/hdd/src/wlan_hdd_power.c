@@ -85,6 +85,7 @@
 #include "wlan_pkt_capture_ucfg_api.h"
 #include "wlan_hdd_thermal.h"
 #include "wlan_hdd_object_manager.h"
+#include "cds_boot_profile.h"
 /* Preprocessor definitions and constants */
 #ifdef QCA_WIFI_NAPIER_EMULATION
 #define HDD_SSR_BRING_UP_TIME 3000000
@@ -1659,6 +1660,7 @@ QDF_STATUS hdd_wlan_re_init(void)
 
 	hdd_dp_trace_init(hdd_ctx->config);
 
+	cds_boot_profile_start(CDS_BOOT_SSR);
 	ret = hdd_wlan_start_modules(hdd_ctx, true);
 	if (ret) {
 		hdd_err("Failed to start wlan after error");
@@ -1695,9 +1697,11 @@ QDF_STATUS hdd_wlan_re_init(void)
 		hdd_ssr_restart_sap(hdd_ctx);
 	hdd_is_interface_down_during_ssr(hdd_ctx);
 	hdd_wlan_ssr_reinit_event();
+	cds_boot_profile_stop(QDF_STATUS_SUCCESS);
 	return QDF_STATUS_SUCCESS;
 
 err_re_init:
+	cds_boot_profile_stop(QDF_STATUS_E_FAILURE);
 	qdf_dp_trace_deinit();
 
 err_ctx_null:
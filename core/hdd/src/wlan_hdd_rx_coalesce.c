@@ -0,0 +1,1013 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_rx_coalesce.c
+ *
+ * WLAN Host Device Driver software coalescing of received TCP segments.
+ *
+ * Each RX context owns a small table of flows. A TCP segment carrying
+ * data is chained to the super packet held for its flow when it is the
+ * next one in sequence and its headers match, the same rules GRO applies.
+ * The super packet is completed the way GRO completes one, with GSO and
+ * CHECKSUM_PARTIAL set, so that the stack can forward or bridge it as
+ * well as receive it.
+ *
+ * A super packet is delivered when
+ *  - a segment of its flow arrives out of order or does not match,
+ *  - a segment has PSH set or is shorter than the first one,
+ *  - it cannot grow any further,
+ *  - the RX batch ends and it is older than the flush interval, or the RX
+ *    context has nothing queued anymore,
+ *  - the flush timer expires.
+ * The flush interval follows the RX rate measured per context, so that
+ * super packets are only held across batches when enough segments arrive
+ * to fill them.
+ *
+ * Released super packets are queued to their context and given to the
+ * stack outside of its lock, by one CPU at a time and in the order they
+ * were released. A segment which takes another path to the stack first
+ * releases the super packet of its flow and waits for the queue of its
+ * context to be delivered, so that it cannot overtake a super packet the
+ * flush bottom half is delivering on another CPU.
+ */
+
+#include <linux/ip.h>
+#include <linux/ipv6.h>
+#include <linux/tcp.h>
+#include <linux/if_ether.h>
+#include <net/ip.h>
+#include <net/tcp.h>
+#include <net/ip6_checksum.h>
+#include "wlan_hdd_main.h"
+#include "wlan_hdd_rx_coalesce.h"
+
+/* TCP flags which end coalescing, as GRO does */
+#define HDD_RX_COALESCE_TCP_FLAGS_END \
+	(TCP_FLAG_SYN | TCP_FLAG_FIN | TCP_FLAG_RST | TCP_FLAG_URG | \
+	 TCP_FLAG_CWR | TCP_FLAG_ECE)
+
+/* Largest IP datagram a super packet may become */
+#define HDD_RX_COALESCE_MAX_LEN 0xffff
+
+/**
+ * struct hdd_rx_coalesce_pkt - headers of a received TCP segment
+ * @th: TCP header
+ * @net_len: length of the IP header
+ * @hdr_len: length of the IP and TCP headers
+ * @payload_len: length of the TCP payload
+ * @seq: TCP sequence number
+ */
+struct hdd_rx_coalesce_pkt {
+	struct tcphdr *th;
+	uint16_t net_len;
+	uint16_t hdr_len;
+	uint16_t payload_len;
+	uint32_t seq;
+};
+
+static const char * const hdd_rx_coalesce_flush_str[] = {
+	[HDD_RX_COALESCE_FLUSH_BATCH] = "batch",
+	[HDD_RX_COALESCE_FLUSH_TIMEOUT] = "timeout",
+	[HDD_RX_COALESCE_FLUSH_OOO] = "ooo",
+	[HDD_RX_COALESCE_FLUSH_MISMATCH] = "mismatch",
+	[HDD_RX_COALESCE_FLUSH_PUSH] = "push",
+	[HDD_RX_COALESCE_FLUSH_FULL] = "full",
+	[HDD_RX_COALESCE_FLUSH_EVICT] = "evict",
+};
+
+/**
+ * hdd_rx_coalesce_parse() - parse the IP and TCP headers of a packet
+ * @skb: packet, starting with its IP header
+ * @pkt: parsed headers
+ *
+ * Return: true if @skb is a TCP segment without IP options or extension
+ *	headers and with its headers in the linear part
+ */
+static bool hdd_rx_coalesce_parse(struct sk_buff *skb,
+				  struct hdd_rx_coalesce_pkt *pkt)
+{
+	struct iphdr *iph;
+	struct ipv6hdr *ip6h;
+	uint32_t net_len;
+	uint32_t tcp_len;
+
+	if (skb->protocol == htons(ETH_P_IP)) {
+		if (skb_headlen(skb) < sizeof(*iph))
+			return false;
+
+		iph = (struct iphdr *)skb->data;
+		if (iph->version != 4 || iph->ihl != 5 ||
+		    iph->protocol != IPPROTO_TCP ||
+		    (iph->frag_off & htons(IP_MF | IP_OFFSET)) ||
+		    ntohs(iph->tot_len) != skb->len)
+			return false;
+
+		net_len = sizeof(*iph);
+	} else if (skb->protocol == htons(ETH_P_IPV6)) {
+		if (skb_headlen(skb) < sizeof(*ip6h))
+			return false;
+
+		ip6h = (struct ipv6hdr *)skb->data;
+		if (ip6h->nexthdr != IPPROTO_TCP ||
+		    ntohs(ip6h->payload_len) + sizeof(*ip6h) != skb->len)
+			return false;
+
+		net_len = sizeof(*ip6h);
+	} else {
+		return false;
+	}
+
+	if (skb_headlen(skb) < net_len + sizeof(struct tcphdr))
+		return false;
+
+	pkt->th = (struct tcphdr *)(skb->data + net_len);
+	tcp_len = pkt->th->doff * 4;
+	if (tcp_len < sizeof(struct tcphdr) ||
+	    skb_headlen(skb) < net_len + tcp_len)
+		return false;
+
+	pkt->net_len = net_len;
+	pkt->hdr_len = net_len + tcp_len;
+	pkt->payload_len = skb->len - pkt->hdr_len;
+	pkt->seq = ntohl(pkt->th->seq);
+
+	return true;
+}
+
+/**
+ * hdd_rx_coalesce_eligible() - check if a TCP segment can be coalesced
+ * @skb: packet
+ * @pkt: headers of @skb
+ *
+ * Return: true if @skb carries data, has a checksum verified by the
+ *	hardware and no flag that must reach the stack on its own
+ */
+static bool hdd_rx_coalesce_eligible(struct sk_buff *skb,
+				     struct hdd_rx_coalesce_pkt *pkt)
+{
+	if (skb->ip_summed != CHECKSUM_UNNECESSARY || skb_cloned(skb) ||
+	    skb_has_frag_list(skb) || skb_is_gso(skb))
+		return false;
+
+	if (!pkt->payload_len || !pkt->th->ack ||
+	    (tcp_flag_word(pkt->th) & HDD_RX_COALESCE_TCP_FLAGS_END))
+		return false;
+
+	return true;
+}
+
+/**
+ * hdd_rx_coalesce_same_flow() - check if a packet belongs to a flow
+ * @flow: held flow
+ * @skb: packet
+ * @pkt: headers of @skb
+ *
+ * Return: true if the addresses and ports of @skb are the ones of @flow
+ */
+static bool hdd_rx_coalesce_same_flow(struct hdd_rx_coalesce_flow *flow,
+				      struct sk_buff *skb,
+				      struct hdd_rx_coalesce_pkt *pkt)
+{
+	struct sk_buff *head = flow->head;
+	struct tcphdr *th = (struct tcphdr *)(head->data + flow->net_len);
+	struct iphdr *iph;
+	struct ipv6hdr *ip6h;
+
+	if (head->protocol != skb->protocol || flow->net_len != pkt->net_len ||
+	    th->source != pkt->th->source || th->dest != pkt->th->dest)
+		return false;
+
+	if (head->protocol == htons(ETH_P_IP)) {
+		iph = (struct iphdr *)head->data;
+		return !qdf_mem_cmp(&iph->saddr, skb->data +
+				    offsetof(struct iphdr, saddr),
+				    2 * sizeof(iph->saddr));
+	}
+
+	ip6h = (struct ipv6hdr *)head->data;
+
+	return !qdf_mem_cmp(&ip6h->saddr, skb->data +
+			    offsetof(struct ipv6hdr, saddr),
+			    2 * sizeof(ip6h->saddr));
+}
+
+/**
+ * hdd_rx_coalesce_find() - find the flow held for a packet
+ * @ctx: flow table
+ * @skb: packet
+ * @pkt: headers of @skb
+ *
+ * Return: flow of @skb, NULL if none is held
+ */
+static struct hdd_rx_coalesce_flow *
+hdd_rx_coalesce_find(struct hdd_rx_coalesce_ctx *ctx, struct sk_buff *skb,
+		     struct hdd_rx_coalesce_pkt *pkt)
+{
+	struct hdd_rx_coalesce_flow *flow;
+	int i;
+
+	if (!ctx->num_flows)
+		return NULL;
+
+	for (i = 0; i < HDD_RX_COALESCE_MAX_FLOWS; i++) {
+		flow = &ctx->flows[i];
+		if (flow->head && hdd_rx_coalesce_same_flow(flow, skb, pkt))
+			return flow;
+	}
+
+	return NULL;
+}
+
+/**
+ * hdd_rx_coalesce_can_merge() - check if a segment extends a super packet
+ * @flow: held flow of the segment
+ * @skb: segment
+ * @pkt: headers of @skb
+ * @reason: set to the reason to flush @flow if the segment does not fit
+ *
+ * Return: true if @skb can be chained to the super packet of @flow
+ */
+static bool hdd_rx_coalesce_can_merge(struct hdd_rx_coalesce_flow *flow,
+				      struct sk_buff *skb,
+				      struct hdd_rx_coalesce_pkt *pkt,
+				      enum hdd_rx_coalesce_flush_reason *reason)
+{
+	struct sk_buff *head = flow->head;
+	struct tcphdr *th = (struct tcphdr *)(head->data + flow->net_len);
+	struct iphdr *iph, *head_iph;
+	struct ipv6hdr *ip6h, *head_ip6h;
+
+	if (pkt->seq != flow->next_seq) {
+		*reason = HDD_RX_COALESCE_FLUSH_OOO;
+		return false;
+	}
+
+	*reason = HDD_RX_COALESCE_FLUSH_MISMATCH;
+
+	/* ACK, window and options must be the ones of the first segment */
+	if (pkt->hdr_len != flow->hdr_len ||
+	    pkt->th->ack_seq != th->ack_seq ||
+	    ((tcp_flag_word(pkt->th) ^ tcp_flag_word(th)) & ~TCP_FLAG_PSH) ||
+	    qdf_mem_cmp(pkt->th + 1, th + 1,
+			flow->hdr_len - flow->net_len - sizeof(*th)))
+		return false;
+
+	if (head->protocol == htons(ETH_P_IP)) {
+		iph = (struct iphdr *)skb->data;
+		head_iph = (struct iphdr *)head->data;
+		if (iph->tos != head_iph->tos || iph->ttl != head_iph->ttl ||
+		    iph->frag_off != head_iph->frag_off)
+			return false;
+	} else {
+		ip6h = (struct ipv6hdr *)skb->data;
+		head_ip6h = (struct ipv6hdr *)head->data;
+		if (*(__be32 *)ip6h != *(__be32 *)head_ip6h ||
+		    ip6h->hop_limit != head_ip6h->hop_limit)
+			return false;
+	}
+
+	if (pkt->payload_len > flow->mss ||
+	    head->len + pkt->payload_len > HDD_RX_COALESCE_MAX_LEN) {
+		*reason = HDD_RX_COALESCE_FLUSH_FULL;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * hdd_rx_coalesce_merge() - chain a segment to a super packet
+ * @ctx: flow table
+ * @flow: held flow of the segment
+ * @skb: segment
+ * @pkt: headers of @skb
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_merge(struct hdd_rx_coalesce_ctx *ctx,
+				  struct hdd_rx_coalesce_flow *flow,
+				  struct sk_buff *skb,
+				  struct hdd_rx_coalesce_pkt *pkt)
+{
+	struct sk_buff *head = flow->head;
+	struct tcphdr *th = (struct tcphdr *)(head->data + flow->net_len);
+
+	th->psh |= pkt->th->psh;
+	skb_pull(skb, pkt->hdr_len);
+
+	if (flow->tail == head)
+		skb_shinfo(head)->frag_list = skb;
+	else
+		flow->tail->next = skb;
+	flow->tail = skb;
+
+	head->len += skb->len;
+	head->data_len += skb->len;
+	head->truesize += skb->truesize;
+
+	flow->next_seq += pkt->payload_len;
+	flow->segs++;
+	ctx->stats.merged++;
+}
+
+/**
+ * hdd_rx_coalesce_finalize() - turn a super packet into a GSO packet
+ * @flow: flow of the super packet
+ *
+ * The IP length and checksum are rewritten and the TCP checksum is left
+ * for the segments to be verified or recomputed from, as napi GRO does.
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_finalize(struct hdd_rx_coalesce_flow *flow)
+{
+	struct sk_buff *head = flow->head;
+	struct tcphdr *th = (struct tcphdr *)(head->data + flow->net_len);
+	uint32_t tcp_len = head->len - flow->net_len;
+	struct iphdr *iph;
+	struct ipv6hdr *ip6h;
+
+	if (head->protocol == htons(ETH_P_IP)) {
+		iph = (struct iphdr *)head->data;
+		iph->tot_len = htons(head->len);
+		iph->check = 0;
+		iph->check = ip_fast_csum((uint8_t *)iph, iph->ihl);
+		th->check = ~tcp_v4_check(tcp_len, iph->saddr, iph->daddr, 0);
+		skb_shinfo(head)->gso_type = SKB_GSO_TCPV4;
+	} else {
+		ip6h = (struct ipv6hdr *)head->data;
+		ip6h->payload_len = htons(tcp_len);
+		th->check = ~tcp_v6_check(tcp_len, &ip6h->saddr,
+					  &ip6h->daddr, 0);
+		skb_shinfo(head)->gso_type = SKB_GSO_TCPV6;
+	}
+
+	skb_reset_network_header(head);
+	skb_set_transport_header(head, flow->net_len);
+	skb_shinfo(head)->gso_size = flow->mss;
+	skb_shinfo(head)->gso_segs = flow->segs;
+	head->csum_start = skb_transport_header(head) - head->head;
+	head->csum_offset = offsetof(struct tcphdr, check);
+	head->ip_summed = CHECKSUM_PARTIAL;
+}
+
+/**
+ * hdd_rx_coalesce_complete() - release the super packet of a flow
+ * @ctx: flow table
+ * @flow: flow
+ * @reason: reason of the flush
+ *
+ * The super packet is queued for hdd_rx_coalesce_deliver().
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_complete(struct hdd_rx_coalesce_ctx *ctx,
+				     struct hdd_rx_coalesce_flow *flow,
+				     enum hdd_rx_coalesce_flush_reason reason)
+{
+	if (flow->segs > 1) {
+		hdd_rx_coalesce_finalize(flow);
+		ctx->stats.super_pkts++;
+		ctx->stats.super_segs += flow->segs;
+	}
+	ctx->stats.flush[reason]++;
+
+	__skb_queue_tail(&ctx->deliver_q, flow->head);
+	flow->head = NULL;
+	flow->tail = NULL;
+
+	/* seen by hdd_rx_coalesce_sync() callers before num_flows drops */
+	WRITE_ONCE(ctx->pending, true);
+	smp_wmb();
+	WRITE_ONCE(ctx->num_flows, ctx->num_flows - 1);
+}
+
+/**
+ * hdd_rx_coalesce_hold() - hold a segment as the start of a super packet
+ * @ctx: flow table
+ * @skb: segment
+ * @pkt: headers of @skb
+ * @now_us: current timestamp
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_hold(struct hdd_rx_coalesce_ctx *ctx,
+				 struct sk_buff *skb,
+				 struct hdd_rx_coalesce_pkt *pkt,
+				 uint64_t now_us)
+{
+	struct hdd_rx_coalesce_flow *flow = NULL;
+	struct hdd_rx_coalesce_flow *oldest = NULL;
+	int i;
+
+	for (i = 0; i < HDD_RX_COALESCE_MAX_FLOWS; i++) {
+		if (!ctx->flows[i].head) {
+			flow = &ctx->flows[i];
+			break;
+		}
+
+		if (!oldest || ctx->flows[i].start_us < oldest->start_us)
+			oldest = &ctx->flows[i];
+	}
+
+	if (!flow) {
+		hdd_rx_coalesce_complete(ctx, oldest,
+					 HDD_RX_COALESCE_FLUSH_EVICT);
+		flow = oldest;
+	}
+
+	flow->head = skb;
+	flow->tail = skb;
+	flow->start_us = now_us;
+	flow->next_seq = pkt->seq + pkt->payload_len;
+	flow->mss = pkt->payload_len;
+	flow->segs = 1;
+	flow->net_len = pkt->net_len;
+	flow->hdr_len = pkt->hdr_len;
+	WRITE_ONCE(ctx->num_flows, ctx->num_flows + 1);
+}
+
+/**
+ * hdd_rx_coalesce_flush_ctx() - release the super packets held too long
+ * @ctx: flow table
+ * @max_age_us: age from which a super packet is released, 0 for all
+ * @now_us: current timestamp
+ * @reason: reason of the flush
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_flush_ctx(struct hdd_rx_coalesce_ctx *ctx,
+				      uint32_t max_age_us, uint64_t now_us,
+				      enum hdd_rx_coalesce_flush_reason reason)
+{
+	struct hdd_rx_coalesce_flow *flow;
+	int i;
+
+	for (i = 0; i < HDD_RX_COALESCE_MAX_FLOWS && ctx->num_flows; i++) {
+		flow = &ctx->flows[i];
+		if (flow->head && now_us - flow->start_us >= max_age_us)
+			hdd_rx_coalesce_complete(ctx, flow, reason);
+	}
+}
+
+/**
+ * hdd_rx_coalesce_deliver() - give the released packets to the stack
+ * @rxc: RX coalescing state
+ * @ctx: flow table the packets were held in
+ *
+ * Called with the lock of @ctx, which is released. The queue of @ctx is
+ * delivered outside of the lock until it is empty, unless another CPU is
+ * already delivering it, in which case that CPU also delivers what was
+ * just queued. Bottom halves stay disabled while delivering so that no
+ * caller of hdd_rx_coalesce_sync() can spin on the delivering CPU.
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_deliver(struct hdd_rx_coalesce *rxc,
+				    struct hdd_rx_coalesce_ctx *ctx)
+{
+	struct sk_buff_head list;
+	struct sk_buff *skb;
+
+	if (ctx->draining || skb_queue_empty(&ctx->deliver_q)) {
+		qdf_spin_unlock_bh(&ctx->lock);
+		return;
+	}
+
+	ctx->draining = true;
+	__skb_queue_head_init(&list);
+	local_bh_disable();
+
+	do {
+		skb_queue_splice_tail_init(&ctx->deliver_q, &list);
+		qdf_spin_unlock_bh(&ctx->lock);
+
+		while ((skb = __skb_dequeue(&list)))
+			rxc->deliver(skb);
+
+		qdf_spin_lock_bh(&ctx->lock);
+	} while (!skb_queue_empty(&ctx->deliver_q));
+
+	ctx->draining = false;
+	smp_store_release(&ctx->pending, false);
+	qdf_spin_unlock_bh(&ctx->lock);
+	local_bh_enable();
+}
+
+/**
+ * hdd_rx_coalesce_sync() - wait for the released packets of a context
+ * @ctx: flow table
+ *
+ * Called before a packet of @ctx is given to the stack by the caller,
+ * once the super packet of its flow is released.
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_sync(struct hdd_rx_coalesce_ctx *ctx)
+{
+	while (smp_load_acquire(&ctx->pending))
+		cpu_relax();
+}
+
+/**
+ * hdd_rx_coalesce_netif_rx() - default delivery callback
+ * @skb: packet
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_netif_rx(struct sk_buff *skb)
+{
+	netif_receive_skb(skb);
+}
+
+/**
+ * hdd_rx_coalesce_flush_interval() - flush interval for an RX rate
+ * @rate_pps: RX rate in segments per second
+ *
+ * The interval is the time HDD_RX_COALESCE_TARGET_SEGS segments take to
+ * arrive, bounded by HDD_RX_COALESCE_MAX_FLUSH_US. Below
+ * HDD_RX_COALESCE_MIN_PPS nothing is held across batches so that slow
+ * flows do not pay for coalescing with latency.
+ *
+ * Return: flush interval in microseconds
+ */
+static uint32_t hdd_rx_coalesce_flush_interval(uint32_t rate_pps)
+{
+	uint64_t interval_us;
+
+	if (rate_pps < HDD_RX_COALESCE_MIN_PPS)
+		return 0;
+
+	interval_us = qdf_do_div((uint64_t)HDD_RX_COALESCE_TARGET_SEGS *
+				 USEC_PER_SEC, rate_pps);
+
+	return qdf_min(interval_us, (uint64_t)HDD_RX_COALESCE_MAX_FLUSH_US);
+}
+
+/**
+ * hdd_rx_coalesce_update_rate() - account the RX rate of a context
+ * @ctx: flow table
+ * @now_us: current timestamp
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_update_rate(struct hdd_rx_coalesce_ctx *ctx,
+					uint64_t now_us)
+{
+	uint64_t elapsed_us = now_us - ctx->rate_start_us;
+	uint32_t pps;
+
+	if (elapsed_us < HDD_RX_COALESCE_RATE_WINDOW_US)
+		return;
+
+	if (elapsed_us < USEC_PER_SEC)
+		pps = qdf_do_div((uint64_t)ctx->rate_pkts * USEC_PER_SEC,
+				 (uint32_t)elapsed_us);
+	else
+		pps = qdf_do_div(ctx->rate_pkts,
+				 qdf_do_div(elapsed_us, USEC_PER_SEC));
+
+	ctx->rate_pps = (3 * ctx->rate_pps + pps) / 4;
+	ctx->flush_us = hdd_rx_coalesce_flush_interval(ctx->rate_pps);
+	ctx->rate_start_us = now_us;
+	ctx->rate_pkts = 0;
+}
+
+/**
+ * hdd_rx_coalesce_arm_timer() - arm the flush timer if it is not running
+ * @rxc: RX coalescing state
+ * @flush_us: flush interval
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_arm_timer(struct hdd_rx_coalesce *rxc,
+				      uint32_t flush_us)
+{
+	/* not re-armed once hdd_rx_coalesce_deinit() started */
+	if (!READ_ONCE(rxc->enabled) ||
+	    qdf_atomic_read(&rxc->timer_running))
+		return;
+
+	qdf_atomic_set(&rxc->timer_running, 1);
+	qdf_hrtimer_start(&rxc->timer,
+			  qdf_ns_to_ktime((uint64_t)flush_us * NSEC_PER_USEC),
+			  __QDF_HRTIMER_MODE_REL);
+}
+
+/**
+ * hdd_rx_coalesce_flush_bh() - deliver the super packets held too long
+ * @data: RX coalescing state
+ *
+ * Super packets are held for at most twice their flush interval.
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_flush_bh(void *data)
+{
+	struct hdd_rx_coalesce *rxc = data;
+	struct hdd_rx_coalesce_ctx *ctx;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+	uint32_t flush_us = 0;
+	int i;
+
+	if (!READ_ONCE(rxc->enabled))
+		return;
+
+	for (i = 0; i < HDD_RX_COALESCE_MAX_CTX; i++) {
+		ctx = &rxc->ctx[i];
+		qdf_spin_lock_bh(&ctx->lock);
+		hdd_rx_coalesce_flush_ctx(ctx, ctx->flush_us, now_us,
+					  HDD_RX_COALESCE_FLUSH_TIMEOUT);
+		if (ctx->num_flows)
+			flush_us = qdf_max(flush_us, ctx->flush_us);
+		hdd_rx_coalesce_deliver(rxc, ctx);
+	}
+
+	if (flush_us)
+		hdd_rx_coalesce_arm_timer(rxc, flush_us);
+}
+
+/**
+ * hdd_rx_coalesce_timer_cb() - flush timer callback
+ * @timer: flush timer
+ *
+ * Return: __QDF_HRTIMER_NORESTART
+ */
+static enum qdf_hrtimer_restart_status
+hdd_rx_coalesce_timer_cb(qdf_hrtimer_data_t *timer)
+{
+	struct hdd_rx_coalesce *rxc = qdf_container_of(timer,
+						       struct hdd_rx_coalesce,
+						       timer);
+
+	qdf_atomic_set(&rxc->timer_running, 0);
+	if (READ_ONCE(rxc->enabled))
+		qdf_sched_bh(&rxc->flush_bh);
+
+	return __QDF_HRTIMER_NORESTART;
+}
+
+QDF_STATUS hdd_rx_coalesce_state_rx(struct hdd_rx_coalesce *rxc,
+				    struct sk_buff *skb, bool hold)
+{
+	enum hdd_rx_coalesce_flush_reason reason;
+	struct hdd_rx_coalesce_flow *flow;
+	struct hdd_rx_coalesce_ctx *ctx;
+	struct hdd_rx_coalesce_pkt pkt;
+	QDF_STATUS status = QDF_STATUS_E_NOSUPPORT;
+
+	if (!rxc->enabled)
+		return QDF_STATUS_E_NOSUPPORT;
+
+	ctx = &rxc->ctx[QDF_NBUF_CB_RX_CTX_ID(skb) % HDD_RX_COALESCE_MAX_CTX];
+
+	/* only the RX thread of the context adds flows, no lock needed */
+	if (!hold && !READ_ONCE(ctx->num_flows)) {
+		smp_rmb();
+		hdd_rx_coalesce_sync(ctx);
+		return QDF_STATUS_E_NOSUPPORT;
+	}
+
+	if (!hdd_rx_coalesce_parse(skb, &pkt))
+		return QDF_STATUS_E_NOSUPPORT;
+
+	qdf_spin_lock_bh(&ctx->lock);
+	flow = hdd_rx_coalesce_find(ctx, skb, &pkt);
+	if (!flow && !hold)
+		goto unlock;
+
+	if (!hdd_rx_coalesce_eligible(skb, &pkt)) {
+		/* deliver what is held first to keep the flow in order */
+		if (flow)
+			hdd_rx_coalesce_complete(
+					ctx, flow,
+					HDD_RX_COALESCE_FLUSH_MISMATCH);
+		goto unlock;
+	}
+
+	ctx->stats.eligible++;
+	ctx->rate_pkts++;
+
+	if (flow) {
+		if (hdd_rx_coalesce_can_merge(flow, skb, &pkt, &reason)) {
+			hdd_rx_coalesce_merge(ctx, flow, skb, &pkt);
+			status = QDF_STATUS_SUCCESS;
+
+			if (pkt.th->psh || pkt.payload_len < flow->mss)
+				hdd_rx_coalesce_complete(
+						ctx, flow,
+						HDD_RX_COALESCE_FLUSH_PUSH);
+			else if (flow->segs >= HDD_RX_COALESCE_MAX_SEGS)
+				hdd_rx_coalesce_complete(
+						ctx, flow,
+						HDD_RX_COALESCE_FLUSH_FULL);
+			goto unlock;
+		}
+
+		hdd_rx_coalesce_complete(ctx, flow, reason);
+	}
+
+	/* a segment ending a burst has nothing to be coalesced with */
+	if (!hold || pkt.th->psh)
+		goto unlock;
+
+	hdd_rx_coalesce_hold(ctx, skb, &pkt, qdf_get_log_timestamp_usecs());
+	status = QDF_STATUS_SUCCESS;
+
+unlock:
+	hdd_rx_coalesce_deliver(rxc, ctx);
+	if (QDF_IS_STATUS_ERROR(status))
+		hdd_rx_coalesce_sync(ctx);
+
+	return status;
+}
+
+QDF_STATUS hdd_rx_coalesce_rx(struct hdd_adapter *adapter,
+			      struct sk_buff *skb, bool hold)
+{
+	/* the stack asked for received packets not to be aggregated */
+	if (!(adapter->dev->features & NETIF_F_GRO)) {
+		hdd_rx_coalesce_flush_flow(adapter, skb);
+		return QDF_STATUS_E_NOSUPPORT;
+	}
+
+	return hdd_rx_coalesce_state_rx(&adapter->rx_coalesce, skb, hold);
+}
+
+void hdd_rx_coalesce_state_flush_flow(struct hdd_rx_coalesce *rxc,
+				      struct sk_buff *skb)
+{
+	struct hdd_rx_coalesce_flow *flow;
+	struct hdd_rx_coalesce_ctx *ctx;
+	struct hdd_rx_coalesce_pkt pkt;
+
+	if (!rxc->enabled)
+		return;
+
+	ctx = &rxc->ctx[QDF_NBUF_CB_RX_CTX_ID(skb) % HDD_RX_COALESCE_MAX_CTX];
+	if (!READ_ONCE(ctx->num_flows)) {
+		smp_rmb();
+		hdd_rx_coalesce_sync(ctx);
+		return;
+	}
+
+	if (!hdd_rx_coalesce_parse(skb, &pkt))
+		return;
+
+	qdf_spin_lock_bh(&ctx->lock);
+	flow = hdd_rx_coalesce_find(ctx, skb, &pkt);
+	if (flow)
+		hdd_rx_coalesce_complete(ctx, flow,
+					 HDD_RX_COALESCE_FLUSH_MISMATCH);
+	hdd_rx_coalesce_deliver(rxc, ctx);
+	hdd_rx_coalesce_sync(ctx);
+}
+
+void hdd_rx_coalesce_flush_flow(struct hdd_adapter *adapter,
+				struct sk_buff *skb)
+{
+	hdd_rx_coalesce_state_flush_flow(&adapter->rx_coalesce, skb);
+}
+
+void hdd_rx_coalesce_state_flush_batch(struct hdd_rx_coalesce *rxc,
+				       uint8_t rx_ctx_id, bool flush_all)
+{
+	struct hdd_rx_coalesce_ctx *ctx;
+	uint64_t now_us;
+	uint32_t flush_us = 0;
+
+	if (!rxc->enabled)
+		return;
+
+	ctx = &rxc->ctx[rx_ctx_id % HDD_RX_COALESCE_MAX_CTX];
+	now_us = qdf_get_log_timestamp_usecs();
+
+	/* nothing held and the rate window still running */
+	if (!ctx->num_flows &&
+	    now_us - ctx->rate_start_us < HDD_RX_COALESCE_RATE_WINDOW_US)
+		return;
+
+	qdf_spin_lock_bh(&ctx->lock);
+	hdd_rx_coalesce_update_rate(ctx, now_us);
+	hdd_rx_coalesce_flush_ctx(ctx, flush_all ? 0 : ctx->flush_us, now_us,
+				  HDD_RX_COALESCE_FLUSH_BATCH);
+	if (ctx->num_flows)
+		flush_us = ctx->flush_us;
+	hdd_rx_coalesce_deliver(rxc, ctx);
+
+	if (flush_us)
+		hdd_rx_coalesce_arm_timer(rxc, flush_us);
+}
+
+void hdd_rx_coalesce_flush_batch(struct hdd_adapter *adapter,
+				 uint8_t rx_ctx_id, bool flush_all)
+{
+	hdd_rx_coalesce_state_flush_batch(&adapter->rx_coalesce, rx_ctx_id,
+					  flush_all);
+}
+
+void hdd_rx_coalesce_state_flush_all(struct hdd_rx_coalesce *rxc)
+{
+	struct hdd_rx_coalesce_ctx *ctx;
+	int i;
+
+	if (!rxc->enabled)
+		return;
+
+	for (i = 0; i < HDD_RX_COALESCE_MAX_CTX; i++) {
+		ctx = &rxc->ctx[i];
+		qdf_spin_lock_bh(&ctx->lock);
+		hdd_rx_coalesce_flush_ctx(ctx, 0, 0,
+					  HDD_RX_COALESCE_FLUSH_BATCH);
+		hdd_rx_coalesce_deliver(rxc, ctx);
+	}
+}
+
+void hdd_rx_coalesce_flush_all(struct hdd_adapter *adapter)
+{
+	hdd_rx_coalesce_state_flush_all(&adapter->rx_coalesce);
+}
+
+void hdd_rx_coalesce_state_init(struct hdd_rx_coalesce *rxc, bool enabled,
+				hdd_rx_coalesce_deliver_cb deliver)
+{
+	int i;
+
+	qdf_mem_zero(rxc, sizeof(*rxc));
+	for (i = 0; i < HDD_RX_COALESCE_MAX_CTX; i++) {
+		qdf_spinlock_create(&rxc->ctx[i].lock);
+		__skb_queue_head_init(&rxc->ctx[i].deliver_q);
+	}
+
+	qdf_hrtimer_init(&rxc->timer, hdd_rx_coalesce_timer_cb,
+			 __QDF_CLOCK_MONOTONIC, __QDF_HRTIMER_MODE_REL,
+			 QDF_CONTEXT_HARDWARE);
+	qdf_create_bh(&rxc->flush_bh, hdd_rx_coalesce_flush_bh, rxc);
+	qdf_atomic_init(&rxc->timer_running);
+
+	rxc->deliver = deliver;
+	rxc->enabled = enabled;
+}
+
+void hdd_rx_coalesce_init(struct hdd_adapter *adapter)
+{
+	struct hdd_context *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+
+	hdd_rx_coalesce_state_init(&adapter->rx_coalesce,
+				   hdd_ctx->config->rx_coalesce,
+				   hdd_rx_coalesce_netif_rx);
+}
+
+void hdd_rx_coalesce_state_deinit(struct hdd_rx_coalesce *rxc)
+{
+	struct hdd_rx_coalesce_ctx *ctx;
+	int i;
+
+	/*
+	 * Once disabled, the bottom half does not arm the timer and the
+	 * timer does not schedule the bottom half, so neither can run past
+	 * the kill and the cancel below.
+	 */
+	WRITE_ONCE(rxc->enabled, false);
+	qdf_destroy_bh(&rxc->flush_bh);
+	qdf_hrtimer_cancel(&rxc->timer);
+
+	for (i = 0; i < HDD_RX_COALESCE_MAX_CTX; i++) {
+		ctx = &rxc->ctx[i];
+		qdf_spin_lock_bh(&ctx->lock);
+		hdd_rx_coalesce_flush_ctx(ctx, 0, 0,
+					  HDD_RX_COALESCE_FLUSH_BATCH);
+		__skb_queue_purge(&ctx->deliver_q);
+		ctx->pending = false;
+		qdf_spin_unlock_bh(&ctx->lock);
+		qdf_spinlock_destroy(&ctx->lock);
+	}
+}
+
+void hdd_rx_coalesce_deinit(struct hdd_adapter *adapter)
+{
+	hdd_rx_coalesce_state_deinit(&adapter->rx_coalesce);
+}
+
+/**
+ * hdd_rx_coalesce_ratio() - ratio of two counters scaled by 100
+ * @num: numerator
+ * @den: denominator
+ *
+ * Return: 100 * @num / @den, 0 if @den is 0
+ */
+static uint32_t hdd_rx_coalesce_ratio(uint64_t num, uint64_t den)
+{
+	if (!den)
+		return 0;
+
+	/* qdf_do_div() takes a 32 bit divisor */
+	while (den > U32_MAX || num > U64_MAX / 100) {
+		num >>= 1;
+		den >>= 1;
+	}
+
+	return qdf_do_div(num * 100, (uint32_t)den);
+}
+
+/**
+ * hdd_rx_coalesce_get_stats() - sum the statistics of all RX contexts
+ * @rxc: RX coalescing state
+ * @stats: summed statistics
+ *
+ * Return: None
+ */
+static void hdd_rx_coalesce_get_stats(struct hdd_rx_coalesce *rxc,
+				      struct hdd_rx_coalesce_stats *stats)
+{
+	struct hdd_rx_coalesce_stats *cur;
+	int i, j;
+
+	qdf_mem_zero(stats, sizeof(*stats));
+	for (i = 0; i < HDD_RX_COALESCE_MAX_CTX; i++) {
+		cur = &rxc->ctx[i].stats;
+		stats->eligible += cur->eligible;
+		stats->merged += cur->merged;
+		stats->super_pkts += cur->super_pkts;
+		stats->super_segs += cur->super_segs;
+		for (j = 0; j < HDD_RX_COALESCE_FLUSH_MAX; j++)
+			stats->flush[j] += cur->flush[j];
+	}
+}
+
+int hdd_rx_coalesce_dump(struct hdd_adapter *adapter, char *buf,
+			 size_t buf_len)
+{
+	struct hdd_rx_coalesce *rxc = &adapter->rx_coalesce;
+	struct hdd_rx_coalesce_stats stats;
+	struct hdd_rx_coalesce_ctx *ctx;
+	uint32_t avg_segs;
+	int len, i;
+
+	hdd_rx_coalesce_get_stats(rxc, &stats);
+	avg_segs = hdd_rx_coalesce_ratio(stats.super_segs, stats.super_pkts);
+
+	len = scnprintf(buf, buf_len,
+			"\nRX coalesce - %s, eligible %llu, merged %llu, hit rate %u%%, super pkts %llu, avg segs %u.%02u\nflush -",
+			rxc->enabled ? "enabled" : "disabled",
+			stats.eligible, stats.merged,
+			hdd_rx_coalesce_ratio(stats.merged, stats.eligible),
+			stats.super_pkts, avg_segs / 100, avg_segs % 100);
+
+	for (i = 0; i < HDD_RX_COALESCE_FLUSH_MAX; i++)
+		len += scnprintf(buf + len, buf_len - len, " %s %llu",
+				 hdd_rx_coalesce_flush_str[i], stats.flush[i]);
+
+	for (i = 0; i < HDD_RX_COALESCE_MAX_CTX; i++) {
+		ctx = &rxc->ctx[i];
+		len += scnprintf(buf + len, buf_len - len,
+				 "\nctx[%d]: rate %u pps, flush interval %u us, held %u",
+				 i, ctx->rate_pps, ctx->flush_us,
+				 ctx->num_flows);
+	}
+
+	len += scnprintf(buf + len, buf_len - len, "\n");
+
+	return len;
+}
+
+void hdd_rx_coalesce_display_stats(struct hdd_adapter *adapter)
+{
+	struct hdd_rx_coalesce *rxc = &adapter->rx_coalesce;
+	struct hdd_rx_coalesce_stats stats;
+	uint32_t avg_segs;
+
+	if (!rxc->enabled)
+		return;
+
+	hdd_rx_coalesce_get_stats(rxc, &stats);
+	avg_segs = hdd_rx_coalesce_ratio(stats.super_segs, stats.super_pkts);
+
+	hdd_debug("RX coalesce - eligible %llu merged %llu hit rate %u%% super pkts %llu avg segs %u.%02u flush(batch %llu timeout %llu ooo %llu mismatch %llu push %llu full %llu evict %llu)",
+		  stats.eligible, stats.merged,
+		  hdd_rx_coalesce_ratio(stats.merged, stats.eligible),
+		  stats.super_pkts, avg_segs / 100, avg_segs % 100,
+		  stats.flush[HDD_RX_COALESCE_FLUSH_BATCH],
+		  stats.flush[HDD_RX_COALESCE_FLUSH_TIMEOUT],
+		  stats.flush[HDD_RX_COALESCE_FLUSH_OOO],
+		  stats.flush[HDD_RX_COALESCE_FLUSH_MISMATCH],
+		  stats.flush[HDD_RX_COALESCE_FLUSH_PUSH],
+		  stats.flush[HDD_RX_COALESCE_FLUSH_FULL],
+		  stats.flush[HDD_RX_COALESCE_FLUSH_EVICT]);
+}
@@ -36,6 +36,7 @@ void hdd_rx_monitor_callback(ol_osif_vdev_handle context,
 	struct sk_buff *skb;
 	struct sk_buff *skb_next;
 	unsigned int cpu_index;
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 
 	qdf_assert(context);
 	qdf_assert(rxbuf);
@@ -48,6 +49,7 @@ void hdd_rx_monitor_callback(ol_osif_vdev_handle context,
 	}
 
 	cpu_index = wlan_hdd_get_cpu();
+	pcpu_stats = &adapter->hdd_stats.tx_rx_stats.pcpu[cpu_index];
 
 	/* walk the chain until all are processed */
 	skb = (struct sk_buff *)rxbuf;
@@ -56,8 +58,8 @@ void hdd_rx_monitor_callback(ol_osif_vdev_handle context,
 		skb->dev = adapter->dev;
 
 		++adapter->hdd_stats.tx_rx_stats.rx_packets[cpu_index];
-		++adapter->stats.rx_packets;
-		adapter->stats.rx_bytes += skb->len;
+		++pcpu_stats->rx_packets;
+		pcpu_stats->rx_bytes += skb->len;
 
 		/* Remove SKB from internal tracking table before submitting
 		 * it to stack
@@ -537,8 +537,10 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
 	uint32_t num_seg;
 	struct hdd_station_info *sta_info = NULL;
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 
-	++adapter->hdd_stats.tx_rx_stats.tx_called;
+	pcpu_stats = &adapter->hdd_stats.tx_rx_stats.pcpu[wlan_hdd_get_cpu()];
+	++pcpu_stats->tx_called;
 	adapter->hdd_stats.tx_rx_stats.cont_txtimeout_cnt = 0;
 
 	/* Prevent this function from being called during SSR since TL
@@ -645,7 +647,7 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 
 	/* Get TL AC corresponding to Qdisc queue index/AC. */
 	ac = hdd_qdisc_ac_to_tl_ac[skb->queue_mapping];
-	++adapter->hdd_stats.tx_rx_stats.tx_classified_ac[ac];
+	++pcpu_stats->tx_classified_ac[ac];
 
 #if defined(IPA_OFFLOAD)
 	if (!qdf_nbuf_ipa_owned_get(skb)) {
@@ -671,17 +673,17 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 	 */
 	qdf_net_buf_debug_acquire_skb(skb, __FILE__, __LINE__);
 
-	adapter->stats.tx_bytes += skb->len;
+	pcpu_stats->tx_bytes += skb->len;
 
 	if (sta_info) {
 		sta_info->tx_bytes += skb->len;
 
 		if (qdf_nbuf_is_tso(skb)) {
 			num_seg = qdf_nbuf_get_tso_num_seg(skb);
-			adapter->stats.tx_packets += num_seg;
+			pcpu_stats->tx_packets += num_seg;
 			sta_info->tx_packets += num_seg;
 		} else {
-			++adapter->stats.tx_packets;
+			++pcpu_stats->tx_packets;
 			sta_info->tx_packets++;
 			hdd_ctx->no_tx_offload_pkt_cnt++;
 		}
@@ -707,7 +709,7 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 		QDF_TRACE_DEBUG_RL(QDF_MODULE_ID_HDD_DATA,
 				   "%s: skb %pK linearize failed. drop the pkt",
 				   __func__, skb);
-		++adapter->hdd_stats.tx_rx_stats.tx_dropped_ac[ac];
+		++pcpu_stats->tx_dropped_ac[ac];
 		goto drop_pkt_and_release_skb;
 	}
 
@@ -716,7 +718,7 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 				   "%s: Failed to send packet to txrx for sta: "
 				   QDF_MAC_ADDR_FMT, __func__,
 				   QDF_MAC_ADDR_REF(dest_mac_addr->bytes));
-		++adapter->hdd_stats.tx_rx_stats.tx_dropped_ac[ac];
+		++pcpu_stats->tx_dropped_ac[ac];
 		goto drop_pkt_and_release_skb;
 	}
 	netif_trans_update(dev);
@@ -739,8 +741,7 @@ drop_pkt_accounting:
 	if (sta_info)
 		hdd_put_sta_info_ref(&adapter->sta_info_list, &sta_info, true,
 				     STA_INFO_SOFTAP_HARD_START_XMIT);
-	++adapter->stats.tx_dropped;
-	++adapter->hdd_stats.tx_rx_stats.tx_dropped;
+	++pcpu_stats->tx_dropped;
 }
 
 netdev_tx_t hdd_softap_hard_start_xmit(struct sk_buff *skb,
@@ -853,6 +854,7 @@ void hdd_softap_tx_timeout(struct net_device *net_dev)
 void hdd_softap_init_tx_rx(struct hdd_adapter *adapter)
 {
 	qdf_mem_zero(&adapter->stats, sizeof(struct net_device_stats));
+	hdd_clear_pcpu_tx_rx_stats(adapter);
 }
 
 QDF_STATUS hdd_softap_deinit_tx_rx(struct hdd_adapter *adapter)
@@ -1060,11 +1062,13 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 	struct hdd_adapter *adapter = NULL;
 	QDF_STATUS qdf_status;
 	unsigned int cpu_index;
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 	struct sk_buff *skb = NULL;
 	struct sk_buff *next = NULL;
 	struct hdd_context *hdd_ctx = NULL;
 	struct qdf_mac_addr *src_mac;
 	struct hdd_station_info *sta_info;
+	uint8_t rx_ctx_id;
 
 	/* Sanity check on inputs */
 	if (unlikely((!adapter_context) || (!rx_buf))) {
@@ -1088,6 +1092,8 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	rx_ctx_id = QDF_NBUF_CB_RX_CTX_ID(rx_buf);
+
 	/* walk the chain until all are processed */
 	next = (struct sk_buff *)rx_buf;
 
@@ -1115,11 +1121,12 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 			continue;
 		}
 		cpu_index = wlan_hdd_get_cpu();
+		pcpu_stats = &adapter->hdd_stats.tx_rx_stats.pcpu[cpu_index];
 		++adapter->hdd_stats.tx_rx_stats.rx_packets[cpu_index];
-		++adapter->stats.rx_packets;
+		++pcpu_stats->rx_packets;
 		/* count aggregated RX frame into stats */
-		adapter->stats.rx_packets += qdf_nbuf_get_gso_segs(skb);
-		adapter->stats.rx_bytes += skb->len;
+		pcpu_stats->rx_packets += qdf_nbuf_get_gso_segs(skb);
+		pcpu_stats->rx_bytes += skb->len;
 
 		/* Send DHCP Indication to FW */
 		src_mac = (struct qdf_mac_addr *)(skb->data +
@@ -1150,6 +1157,8 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 		DPTRACE(qdf_dp_trace_data_pkt(skb, QDF_TRACE_DEFAULT_PDEV_ID,
 				QDF_DP_TRACE_RX_PACKET_RECORD, 0, QDF_RX));
 
+		hdd_latency_flow_rx(adapter, skb);
+
 		skb->protocol = eth_type_trans(skb, skb->dev);
 
 		/* hold configurable wakelock for unicast traffic */
@@ -1185,6 +1194,8 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 		}
 	}
 
+	hdd_rx_coalesce_flush_batch(adapter, rx_ctx_id, false);
+
 	return QDF_STATUS_SUCCESS;
 }
 
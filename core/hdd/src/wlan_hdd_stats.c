@@ -45,6 +45,7 @@
 #include "cdp_txrx_misc.h"
 #include "cdp_txrx_host_stats.h"
 #include "wlan_hdd_object_manager.h"
+#include "wlan_hdd_tx_rx.h"
 
 #if (LINUX_VERSION_CODE < KERNEL_VERSION(4, 0, 0)) && !defined(WITH_BACKPORTS)
 #define HDD_INFO_SIGNAL                 STATION_INFO_SIGNAL
@@ -5447,6 +5448,7 @@ static int wlan_hdd_get_sta_stats(struct wiphy *wiphy,
 	wlan_hdd_fill_summary_stats(&adapter->hdd_stats.summary_stat,
 				    sinfo,
 				    adapter->vdev_id);
+	hdd_sync_tx_rx_stats(adapter);
 	sinfo->tx_bytes = adapter->stats.tx_bytes;
 	sinfo->rx_bytes = adapter->stats.rx_bytes;
 	sinfo->rx_packets = adapter->stats.rx_packets;
@@ -5685,6 +5687,8 @@ struct net_device_stats *hdd_get_stats(struct net_device *dev)
 	struct hdd_adapter *adapter = WLAN_HDD_GET_PRIV_PTR(dev);
 
 	hdd_enter_dev(dev);
+	hdd_sync_tx_rx_stats(adapter);
+
 	return &adapter->stats;
 }
 
@@ -6584,6 +6588,7 @@ void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 		}
 
 		hdd_debug("adapter: %u", adapter->vdev_id);
+		hdd_sync_tx_rx_stats(adapter);
 		for (; i < NUM_CPUS; i++) {
 			total_rx_pkt += stats->rx_packets[i];
 			total_rx_dropped += stats->rx_dropped[i];
@@ -6615,6 +6620,7 @@ void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 			  stats->rx_gro_low_tput_flush,
 			  qdf_atomic_read(&ctx->disable_rx_ol_in_concurrency),
 			  qdf_atomic_read(&ctx->disable_rx_ol_in_low_tput));
+		hdd_rx_coalesce_display_stats(adapter);
 	}
 }
 
@@ -66,10 +66,12 @@
 #include <wlan_hdd_sysfs_txrx_stats.h>
 #include <wlan_hdd_sysfs_dp_trace.h>
 #include <wlan_hdd_sysfs_stats.h>
+#include <wlan_hdd_sysfs_latency_flow.h>
 #include <wlan_hdd_sysfs_tdls_peers.h>
 #include <wlan_hdd_sysfs_temperature.h>
 #include <wlan_hdd_sysfs_thermal_cfg.h>
 #include <wlan_hdd_sysfs_motion_detection.h>
+#include <wlan_hdd_sysfs_pkt_capture_filter.h>
 #include <wlan_hdd_sysfs_ipa.h>
 #include <wlan_hdd_sysfs_pkt_log.h>
 #include <wlan_hdd_sysfs_policy_mgr.h>
@@ -661,6 +663,7 @@ hdd_sysfs_create_sta_adapter_root_obj(struct hdd_adapter *adapter)
 	hdd_sysfs_gtx_bw_mask_create(adapter);
 	hdd_sysfs_rts_cts_create(adapter);
 	hdd_sysfs_stats_create(adapter);
+	hdd_sysfs_latency_flow_create(adapter);
 	hdd_sysfs_txrx_fw_stats_create(adapter);
 	hdd_sysfs_txrx_stats_create(adapter);
 	hdd_sysfs_tdls_peers_interface_create(adapter);
@@ -668,11 +671,13 @@ hdd_sysfs_create_sta_adapter_root_obj(struct hdd_adapter *adapter)
 	hdd_sysfs_motion_detection_create(adapter);
 	hdd_sysfs_range_ext_create(adapter);
 	hdd_sysfs_dl_modes_create(adapter);
+	hdd_sysfs_pkt_capture_filter_create(adapter);
 }
 
 static void
 hdd_sysfs_destroy_sta_adapter_root_obj(struct hdd_adapter *adapter)
 {
+	hdd_sysfs_pkt_capture_filter_destroy(adapter);
 	hdd_sysfs_dl_modes_destroy(adapter);
 	hdd_sysfs_range_ext_destroy(adapter);
 	hdd_sysfs_motion_detection_destroy(adapter);
@@ -680,6 +685,7 @@ hdd_sysfs_destroy_sta_adapter_root_obj(struct hdd_adapter *adapter)
 	hdd_sysfs_tdls_peers_interface_destroy(adapter);
 	hdd_sysfs_txrx_stats_destroy(adapter);
 	hdd_sysfs_txrx_fw_stats_destroy(adapter);
+	hdd_sysfs_latency_flow_destroy(adapter);
 	hdd_sysfs_stats_destroy(adapter);
 	hdd_sysfs_rts_cts_destroy(adapter);
 	hdd_sysfs_gtx_bw_mask_destroy(adapter);
@@ -715,6 +721,7 @@ hdd_sysfs_create_sap_adapter_root_obj(struct hdd_adapter *adapter)
 	hdd_sysfs_radar_create(adapter);
 	hdd_sysfs_rts_cts_create(adapter);
 	hdd_sysfs_stats_create(adapter);
+	hdd_sysfs_latency_flow_create(adapter);
 	hdd_sysfs_he_bss_color_create(adapter);
 	hdd_sysfs_txrx_fw_stats_create(adapter);
 	hdd_sysfs_txrx_stats_create(adapter);
@@ -734,6 +741,7 @@ hdd_sysfs_destroy_sap_adapter_root_obj(struct hdd_adapter *adapter)
 	hdd_sysfs_txrx_stats_destroy(adapter);
 	hdd_sysfs_txrx_fw_stats_destroy(adapter);
 	hdd_sysfs_he_bss_color_destroy(adapter);
+	hdd_sysfs_latency_flow_destroy(adapter);
 	hdd_sysfs_stats_destroy(adapter);
 	hdd_sysfs_rts_cts_destroy(adapter);
 	hdd_sysfs_radar_destroy(adapter);
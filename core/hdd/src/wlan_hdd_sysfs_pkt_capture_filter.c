@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2020, The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+/**
+ * DOC: wlan_hdd_sysfs_pkt_capture_filter.c
+ *
+ * implementation for creating sysfs file pkt_capture_filter
+ */
+
+#include <wlan_hdd_includes.h>
+#include "osif_vdev_sync.h"
+#include "wlan_hdd_object_manager.h"
+#include "wlan_hdd_sysfs.h"
+#include "wlan_hdd_sysfs_pkt_capture_filter.h"
+#include "wlan_pkt_capture_ucfg_api.h"
+
+#define MAX_USER_COMMAND_SIZE_PKT_CAPTURE_FILTER 96
+
+/**
+ * hdd_sysfs_pkt_capture_parse_rule() - parse a filter rule from user input
+ * @sptr: user input following the "add" keyword
+ * @rule: rule to be filled
+ *
+ * Return: 0 on success and errno on failure
+ */
+static int
+hdd_sysfs_pkt_capture_parse_rule(char *sptr,
+				 struct pkt_capture_filter_rule *rule)
+{
+	char *token;
+
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou32(token, 0, &rule->match_flags))
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou8(token, 0, &rule->frame_type))
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou8(token, 0, &rule->frame_subtype))
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (!token)
+		return -EINVAL;
+	if (!mac_pton(token, rule->peer_mac.bytes))
+		qdf_zero_macaddr(&rule->peer_mac);
+
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou16(token, 0, &rule->ether_type))
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou8(token, 0, &rule->ip_proto))
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou16(token, 0, &rule->port))
+		return -EINVAL;
+
+	token = strsep(&sptr, " ");
+	if (!token || kstrtou16(token, 0, &rule->snaplen))
+		return -EINVAL;
+
+	if ((rule->match_flags & PKT_CAPTURE_FILTER_PEER_MAC) &&
+	    qdf_is_macaddr_zero(&rule->peer_mac))
+		return -EINVAL;
+
+	return 0;
+}
+
+static ssize_t
+__hdd_sysfs_pkt_capture_filter_store(struct net_device *net_dev,
+				     const char *buf, size_t count)
+{
+	struct hdd_adapter *adapter = netdev_priv(net_dev);
+	char buf_local[MAX_USER_COMMAND_SIZE_PKT_CAPTURE_FILTER + 1];
+	struct pkt_capture_filter_rule rule = {0};
+	struct hdd_context *hdd_ctx;
+	struct wlan_objmgr_vdev *vdev;
+	char *sptr, *token;
+	QDF_STATUS status;
+	int ret;
+
+	if (hdd_validate_adapter(adapter))
+		return -EINVAL;
+
+	hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	ret = wlan_hdd_validate_context(hdd_ctx);
+	if (ret != 0)
+		return ret;
+
+	if (!wlan_hdd_validate_modules_state(hdd_ctx))
+		return -EINVAL;
+
+	if (ucfg_pkt_capture_get_mode(hdd_ctx->psoc) ==
+	    PACKET_CAPTURE_MODE_DISABLE) {
+		hdd_err_rl("packet capture mode is not enabled");
+		return -EINVAL;
+	}
+
+	ret = hdd_sysfs_validate_and_copy_buf(buf_local, sizeof(buf_local),
+					      buf, count);
+	if (ret) {
+		hdd_err_rl("invalid input");
+		return ret;
+	}
+
+	hdd_debug("pkt_capture_filter: count %zu buf_local:(%s) net_devname %s",
+		  count, buf_local, net_dev->name);
+
+	sptr = buf_local;
+	token = strsep(&sptr, " ");
+	if (!token)
+		return -EINVAL;
+
+	vdev = hdd_objmgr_get_vdev(adapter);
+	if (!vdev)
+		return -EINVAL;
+
+	if (!strcmp(token, "clear")) {
+		status = ucfg_pkt_capture_filter_clear_rules(vdev);
+	} else if (!strcmp(token, "add") && sptr &&
+		   !hdd_sysfs_pkt_capture_parse_rule(sptr, &rule)) {
+		status = ucfg_pkt_capture_filter_add_rule(vdev, &rule);
+	} else {
+		hdd_err_rl("invalid pkt_capture_filter command");
+		status = QDF_STATUS_E_INVAL;
+	}
+
+	hdd_objmgr_put_vdev(vdev);
+
+	if (QDF_IS_STATUS_ERROR(status))
+		return qdf_status_to_os_return(status);
+
+	return count;
+}
+
+static ssize_t
+hdd_sysfs_pkt_capture_filter_store(struct device *dev,
+				   struct device_attribute *attr,
+				   char const *buf, size_t count)
+{
+	struct net_device *net_dev = container_of(dev, struct net_device, dev);
+	struct osif_vdev_sync *vdev_sync;
+	ssize_t errno_size;
+
+	errno_size = osif_vdev_sync_op_start(net_dev, &vdev_sync);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = __hdd_sysfs_pkt_capture_filter_store(net_dev, buf, count);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+
+	return errno_size;
+}
+
+static ssize_t
+__hdd_sysfs_pkt_capture_filter_show(struct net_device *net_dev, char *buf)
+{
+	struct hdd_adapter *adapter = netdev_priv(net_dev);
+	struct pkt_capture_filter_stats stats;
+	struct hdd_context *hdd_ctx;
+	struct wlan_objmgr_vdev *vdev;
+	uint8_t num_rules;
+	QDF_STATUS status;
+	int ret;
+
+	if (hdd_validate_adapter(adapter))
+		return -EINVAL;
+
+	hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	ret = wlan_hdd_validate_context(hdd_ctx);
+	if (ret != 0)
+		return ret;
+
+	vdev = hdd_objmgr_get_vdev(adapter);
+	if (!vdev)
+		return -EINVAL;
+
+	status = ucfg_pkt_capture_filter_get_stats(vdev, &num_rules, &stats);
+	hdd_objmgr_put_vdev(vdev);
+	if (QDF_IS_STATUS_ERROR(status))
+		return qdf_status_to_os_return(status);
+
+	return scnprintf(buf, PAGE_SIZE,
+			 "rules: %u\nmatched: %u\nfiltered: %u\ntruncated: %u\n",
+			 num_rules, stats.matched, stats.filtered,
+			 stats.truncated);
+}
+
+static ssize_t
+hdd_sysfs_pkt_capture_filter_show(struct device *dev,
+				  struct device_attribute *attr, char *buf)
+{
+	struct net_device *net_dev = container_of(dev, struct net_device, dev);
+	struct osif_vdev_sync *vdev_sync;
+	ssize_t errno_size;
+
+	errno_size = osif_vdev_sync_op_start(net_dev, &vdev_sync);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = __hdd_sysfs_pkt_capture_filter_show(net_dev, buf);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+
+	return errno_size;
+}
+
+static DEVICE_ATTR(pkt_capture_filter, 0660,
+		   hdd_sysfs_pkt_capture_filter_show,
+		   hdd_sysfs_pkt_capture_filter_store);
+
+int hdd_sysfs_pkt_capture_filter_create(struct hdd_adapter *adapter)
+{
+	int error;
+
+	error = device_create_file(&adapter->dev->dev,
+				   &dev_attr_pkt_capture_filter);
+	if (error)
+		hdd_err("could not create pkt_capture_filter sysfs file");
+
+	return error;
+}
+
+void hdd_sysfs_pkt_capture_filter_destroy(struct hdd_adapter *adapter)
+{
+	device_remove_file(&adapter->dev->dev, &dev_attr_pkt_capture_filter);
+}
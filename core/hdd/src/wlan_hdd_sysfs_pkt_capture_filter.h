@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020, The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+
+/**
+ * DOC: wlan_hdd_sysfs_pkt_capture_filter.h
+ *
+ * implementation for creating sysfs file pkt_capture_filter
+ */
+
+#ifndef _WLAN_HDD_SYSFS_PKT_CAPTURE_FILTER_H
+#define _WLAN_HDD_SYSFS_PKT_CAPTURE_FILTER_H
+
+#if defined(WLAN_SYSFS) && defined(WLAN_FEATURE_PKT_CAPTURE)
+/**
+ * hdd_sysfs_pkt_capture_filter_create() - API to create packet capture
+ * filter sysfs file
+ * @adapter: hdd adapter
+ *
+ * file path: /sys/class/net/wlanxx/pkt_capture_filter
+ *                (wlanxx is adapter name)
+ * usage:
+ *      echo add [flags] [type] [subtype] [mac] [ether_type] [proto]
+ *           [port] [snaplen] > pkt_capture_filter
+ *      echo clear > pkt_capture_filter
+ *      cat pkt_capture_filter
+ *
+ * flags is the bitmap of enum pkt_capture_filter_field selecting which of
+ * the following fields the rule matches on; unused fields can be 0.
+ * Reading the file dumps the number of rules and the filter statistics.
+ *
+ * Return: 0 on success and errno on failure
+ */
+int hdd_sysfs_pkt_capture_filter_create(struct hdd_adapter *adapter);
+
+/**
+ * hdd_sysfs_pkt_capture_filter_destroy() - API to destroy packet capture
+ * filter sysfs file
+ * @adapter: pointer to adapter
+ *
+ * Return: none
+ */
+void hdd_sysfs_pkt_capture_filter_destroy(struct hdd_adapter *adapter);
+#else
+static inline int
+hdd_sysfs_pkt_capture_filter_create(struct hdd_adapter *adapter)
+{
+	return 0;
+}
+
+static inline void
+hdd_sysfs_pkt_capture_filter_destroy(struct hdd_adapter *adapter)
+{
+}
+#endif
+#endif /* _WLAN_HDD_SYSFS_PKT_CAPTURE_FILTER_H */
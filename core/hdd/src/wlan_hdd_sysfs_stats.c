@@ -32,6 +32,48 @@
 
 static int stats_id = -1;
 
+static uint32_t
+hdd_sysfs_get_probe_rsp_cache_stats(struct hdd_adapter *adapter,
+				    char *buffer, size_t buf_len)
+{
+	struct sir_probe_rsp_cache_stats stats;
+	QDF_STATUS status;
+
+	if (adapter->device_mode != QDF_SAP_MODE &&
+	    adapter->device_mode != QDF_P2P_GO_MODE)
+		return 0;
+
+	status = sme_get_probe_rsp_cache_stats(adapter->hdd_ctx->mac_handle,
+					       adapter->vdev_id, &stats);
+	if (QDF_IS_STATUS_ERROR(status))
+		return 0;
+
+	return scnprintf(buffer, buf_len,
+			 "\nProbe Response cache - hits %u, builds %u, invalidations %u\n",
+			 stats.hits, stats.builds, stats.invalidations);
+}
+
+static uint32_t
+hdd_sysfs_get_probe_req_dedup_stats(struct hdd_adapter *adapter,
+				    char *buffer, size_t buf_len)
+{
+	struct sir_probe_req_dedup_stats stats;
+	QDF_STATUS status;
+
+	if (adapter->device_mode != QDF_SAP_MODE &&
+	    adapter->device_mode != QDF_P2P_GO_MODE)
+		return 0;
+
+	status = sme_get_probe_req_dedup_stats(adapter->hdd_ctx->mac_handle,
+					       &stats);
+	if (QDF_IS_STATUS_ERROR(status))
+		return 0;
+
+	return scnprintf(buffer, buf_len,
+			 "\nProbe Request dedup - passed %u, coalesced %u, dropped %u\n",
+			 stats.passed, stats.coalesced, stats.dropped);
+}
+
 static void hdd_sysfs_get_stats(struct hdd_adapter *adapter, ssize_t *length,
 				char *buffer, size_t buf_len)
 {
@@ -42,6 +84,7 @@ static void hdd_sysfs_get_stats(struct hdd_adapter *adapter, ssize_t *length,
 	int i = 0;
 	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
 
+	hdd_sync_tx_rx_stats(adapter);
 	for (; i < NUM_CPUS; i++) {
 		total_rx_pkt += stats->rx_packets[i];
 		total_rx_dropped += stats->rx_dropped[i];
@@ -100,6 +143,12 @@ static void hdd_sysfs_get_stats(struct hdd_adapter *adapter, ssize_t *length,
 		stats->txflow_pause_cnt,
 		stats->txflow_unpause_cnt);
 
+	len += hdd_sysfs_get_probe_rsp_cache_stats(adapter, &buffer[len],
+						   buf_len - len);
+	len += hdd_sysfs_get_probe_req_dedup_stats(adapter, &buffer[len],
+						   buf_len - len);
+	len += hdd_rx_coalesce_dump(adapter, &buffer[len], buf_len - len);
+
 	len += cdp_stats(cds_get_context(QDF_MODULE_ID_SOC),
 			 adapter->vdev_id, &buffer[len], (buf_len - len));
 	*length = len + 1;
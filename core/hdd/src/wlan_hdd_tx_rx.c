@@ -484,6 +484,7 @@ int hdd_set_udp_qos_upgrade_config(struct hdd_adapter *adapter,
 	}
 
 	adapter->upgrade_udp_qos_threshold = priority;
+	hdd_wmm_update_dscp_class(adapter);
 
 	hdd_debug("UDP packets qos upgrade to: %d", priority);
 
@@ -572,6 +573,52 @@ void hdd_reset_all_adapters_connectivity_stats(struct hdd_context *hdd_ctx)
 	hdd_exit();
 }
 
+void hdd_sync_tx_rx_stats(struct hdd_adapter *adapter)
+{
+	struct hdd_tx_rx_stats *stats = &adapter->hdd_stats.tx_rx_stats;
+	struct hdd_pcpu_tx_rx_stats *pcpu;
+	struct net_device_stats *net_stats = &adapter->stats;
+	uint64_t tx_packets = 0, tx_bytes = 0, tx_dropped = 0;
+	uint64_t rx_packets = 0, rx_bytes = 0;
+	uint32_t tx_called = 0;
+	uint32_t tx_classified_ac[NUM_TX_QUEUES] = {0};
+	uint32_t tx_dropped_ac[NUM_TX_QUEUES] = {0};
+	int cpu, ac;
+
+	for (cpu = 0; cpu < NUM_CPUS; cpu++) {
+		pcpu = &stats->pcpu[cpu];
+		tx_packets += READ_ONCE(pcpu->tx_packets);
+		tx_bytes += READ_ONCE(pcpu->tx_bytes);
+		tx_dropped += READ_ONCE(pcpu->tx_dropped);
+		rx_packets += READ_ONCE(pcpu->rx_packets);
+		rx_bytes += READ_ONCE(pcpu->rx_bytes);
+		tx_called += READ_ONCE(pcpu->tx_called);
+		for (ac = 0; ac < NUM_TX_QUEUES; ac++) {
+			tx_classified_ac[ac] +=
+				READ_ONCE(pcpu->tx_classified_ac[ac]);
+			tx_dropped_ac[ac] += READ_ONCE(pcpu->tx_dropped_ac[ac]);
+		}
+	}
+
+	net_stats->tx_packets = tx_packets;
+	net_stats->tx_bytes = tx_bytes;
+	net_stats->tx_dropped = tx_dropped;
+	net_stats->rx_packets = rx_packets;
+	net_stats->rx_bytes = rx_bytes;
+	stats->tx_called = tx_called;
+	stats->tx_dropped = tx_dropped;
+	qdf_mem_copy(stats->tx_classified_ac, tx_classified_ac,
+		     sizeof(stats->tx_classified_ac));
+	qdf_mem_copy(stats->tx_dropped_ac, tx_dropped_ac,
+		     sizeof(stats->tx_dropped_ac));
+}
+
+void hdd_clear_pcpu_tx_rx_stats(struct hdd_adapter *adapter)
+{
+	qdf_mem_zero(adapter->hdd_stats.tx_rx_stats.pcpu,
+		     sizeof(adapter->hdd_stats.tx_rx_stats.pcpu));
+}
+
 /**
  * hdd_is_tx_allowed() - check if Tx is allowed based on current peer state
  * @skb: pointer to OS packet (sk_buff)
@@ -1038,6 +1085,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 	enum qdf_proto_subtype subtype = QDF_PROTO_INVALID;
 	bool is_eapol = false;
 	bool is_dhcp = false;
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 
 #ifdef QCA_WIFI_FTM
 	if (hdd_get_conparam() == QDF_GLOBAL_FTM_MODE) {
@@ -1046,7 +1094,8 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 	}
 #endif
 
-	++adapter->hdd_stats.tx_rx_stats.tx_called;
+	pcpu_stats = &adapter->hdd_stats.tx_rx_stats.pcpu[wlan_hdd_get_cpu()];
+	++pcpu_stats->tx_called;
 	adapter->hdd_stats.tx_rx_stats.cont_txtimeout_cnt = 0;
 	qdf_mem_copy(mac_addr.bytes, skb->data, sizeof(mac_addr.bytes));
 
@@ -1137,7 +1186,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 	 */
 	up = skb->priority;
 
-	++adapter->hdd_stats.tx_rx_stats.tx_classified_ac[ac];
+	++pcpu_stats->tx_classified_ac[ac];
 #ifdef HDD_WMM_DEBUG
 	QDF_TRACE(QDF_MODULE_ID_HDD_DATA, QDF_TRACE_LEVEL_DEBUG,
 		  "%s: Classified as ac %d up %d", __func__, ac, up);
@@ -1207,7 +1256,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 		skb->queue_mapping = hdd_linux_up_to_ac_map[up];
 	}
 
-	adapter->stats.tx_bytes += skb->len;
+	pcpu_stats->tx_bytes += skb->len;
 
 	vdev = hdd_objmgr_get_vdev(adapter);
 	if (vdev) {
@@ -1216,9 +1265,9 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 	}
 
 	if (qdf_nbuf_is_tso(skb)) {
-		adapter->stats.tx_packets += qdf_nbuf_get_tso_num_seg(skb);
+		pcpu_stats->tx_packets += qdf_nbuf_get_tso_num_seg(skb);
 	} else {
-		++adapter->stats.tx_packets;
+		++pcpu_stats->tx_packets;
 		hdd_ctx->no_tx_offload_pkt_cnt++;
 	}
 
@@ -1240,7 +1289,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 			  FL("Tx not allowed for sta: "
 			  QDF_MAC_ADDR_FMT), QDF_MAC_ADDR_REF(
 			  mac_addr_tx_allowed.bytes));
-		++adapter->hdd_stats.tx_rx_stats.tx_dropped_ac[ac];
+		++pcpu_stats->tx_dropped_ac[ac];
 		goto drop_pkt_and_release_skb;
 	}
 
@@ -1250,7 +1299,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 			  QDF_TRACE_LEVEL_INFO_HIGH,
 			  "%s: skb %pK linearize failed. drop the pkt",
 			  __func__, skb);
-		++adapter->hdd_stats.tx_rx_stats.tx_dropped_ac[ac];
+		++pcpu_stats->tx_dropped_ac[ac];
 		goto drop_pkt_and_release_skb;
 	}
 
@@ -1261,7 +1310,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 		QDF_TRACE(QDF_MODULE_ID_HDD_SAP_DATA, QDF_TRACE_LEVEL_INFO_HIGH,
 			 "%s: TX function not registered by the data path",
 			 __func__);
-		++adapter->hdd_stats.tx_rx_stats.tx_dropped_ac[ac];
+		++pcpu_stats->tx_dropped_ac[ac];
 		goto drop_pkt_and_release_skb;
 	}
 
@@ -1272,7 +1321,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 			  "%s: Failed to send packet to txrx for sta_id: "
 			  QDF_MAC_ADDR_FMT,
 			  __func__, QDF_MAC_ADDR_REF(mac_addr.bytes));
-		++adapter->hdd_stats.tx_rx_stats.tx_dropped_ac[ac];
+		++pcpu_stats->tx_dropped_ac[ac];
 		goto drop_pkt_and_release_skb;
 	}
 
@@ -1298,8 +1347,7 @@ drop_pkt:
 
 drop_pkt_accounting:
 
-	++adapter->stats.tx_dropped;
-	++adapter->hdd_stats.tx_rx_stats.tx_dropped;
+	++pcpu_stats->tx_dropped;
 	if (is_arp) {
 		++adapter->hdd_stats.hdd_arp_stats.tx_dropped;
 		QDF_TRACE(QDF_MODULE_ID_HDD_DATA, QDF_TRACE_LEVEL_INFO_HIGH,
@@ -1494,6 +1542,7 @@ QDF_STATUS hdd_mon_rx_packet_cbk(void *context, qdf_nbuf_t rxbuf)
 	struct sk_buff *skb;
 	struct sk_buff *skb_next;
 	unsigned int cpu_index;
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 
 	/* Sanity check on inputs */
 	if ((!context) || (!rxbuf)) {
@@ -1510,6 +1559,7 @@ QDF_STATUS hdd_mon_rx_packet_cbk(void *context, qdf_nbuf_t rxbuf)
 	}
 
 	cpu_index = wlan_hdd_get_cpu();
+	pcpu_stats = &adapter->hdd_stats.tx_rx_stats.pcpu[cpu_index];
 
 	/* walk the chain until all are processed */
 	skb = (struct sk_buff *) rxbuf;
@@ -1518,8 +1568,8 @@ QDF_STATUS hdd_mon_rx_packet_cbk(void *context, qdf_nbuf_t rxbuf)
 		skb->dev = adapter->dev;
 
 		++adapter->hdd_stats.tx_rx_stats.rx_packets[cpu_index];
-		++adapter->stats.rx_packets;
-		adapter->stats.rx_bytes += skb->len;
+		++pcpu_stats->rx_packets;
+		pcpu_stats->rx_bytes += skb->len;
 
 		/* Remove SKB from internal tracking table before submitting
 		 * it to stack
@@ -2115,6 +2165,9 @@ QDF_STATUS hdd_rx_thread_gro_flush_ind_cbk(void *adapter, int rx_ctx_id)
 	if (hdd_adapter->runtime_disable_rx_thread)
 		return QDF_STATUS_SUCCESS;
 
+	/* the RX context is drained, nothing is coming to coalesce with */
+	hdd_rx_coalesce_flush_batch(hdd_adapter, rx_ctx_id, true);
+
 	if (hdd_is_low_tput_gro_enable(hdd_adapter->hdd_ctx)) {
 		hdd_adapter->hdd_stats.tx_rx_stats.rx_gro_flush_skip++;
 		gro_flush_code = DP_RX_GRO_LOW_TPUT_FLUSH;
@@ -2275,6 +2328,7 @@ QDF_STATUS hdd_rx_deliver_to_stack(struct hdd_adapter *adapter,
 	int status = QDF_STATUS_E_FAILURE;
 	int netif_status;
 	bool skb_receive_offload_ok = false;
+	bool skb_coalesce_ok;
 	uint8_t rx_ctx_id = QDF_NBUF_CB_RX_CTX_ID(skb);
 
 	/* rx_ctx_id is already verified for out-of-range */
@@ -2284,6 +2338,24 @@ QDF_STATUS hdd_rx_deliver_to_stack(struct hdd_adapter *adapter,
 	    !QDF_NBUF_CB_RX_PEER_CACHED_FRM(skb))
 		skb_receive_offload_ok = true;
 
+	skb_coalesce_ok = skb_receive_offload_ok &&
+			  !hdd_ctx->dp_agg_param.gro_force_flush[rx_ctx_id] &&
+			  !adapter->gro_disallowed[rx_ctx_id] &&
+			  !adapter->runtime_disable_rx_thread;
+
+	/*
+	 * Segments of a flow held by the software coalescing are chained to
+	 * it, any other packet of the flow releases it before taking another
+	 * path to the stack, so that the flow stays in order.
+	 */
+	if (!skb_coalesce_ok) {
+		hdd_rx_coalesce_flush_flow(adapter, skb);
+	} else if (QDF_IS_STATUS_SUCCESS(hdd_rx_coalesce_rx(adapter, skb,
+							   false))) {
+		adapter->hdd_stats.tx_rx_stats.rx_aggregated++;
+		return QDF_STATUS_SUCCESS;
+	}
+
 	if (skb_receive_offload_ok && hdd_ctx->receive_offload_cb &&
 	    !hdd_ctx->dp_agg_param.gro_force_flush[rx_ctx_id] &&
 	    !adapter->gro_flushed[rx_ctx_id] &&
@@ -2301,6 +2373,13 @@ QDF_STATUS hdd_rx_deliver_to_stack(struct hdd_adapter *adapter,
 		}
 	}
 
+	/* software coalescing of what LRO/GRO did not take */
+	if (skb_coalesce_ok &&
+	    QDF_IS_STATUS_SUCCESS(hdd_rx_coalesce_rx(adapter, skb, true))) {
+		adapter->hdd_stats.tx_rx_stats.rx_aggregated++;
+		return QDF_STATUS_SUCCESS;
+	}
+
 	/*
 	 * The below case handles the scenario when rx_aggregation is
 	 * re-enabled dynamically, in which case gro_force_flush needs
@@ -2350,11 +2429,28 @@ QDF_STATUS hdd_rx_deliver_to_stack(struct hdd_adapter *adapter,
 	int status = QDF_STATUS_E_FAILURE;
 	int netif_status;
 	bool skb_receive_offload_ok = false;
+	bool skb_coalesce_ok;
 
 	if (QDF_NBUF_CB_RX_TCP_PROTO(skb) &&
 	    !QDF_NBUF_CB_RX_PEER_CACHED_FRM(skb))
 		skb_receive_offload_ok = true;
 
+	skb_coalesce_ok = skb_receive_offload_ok &&
+			  !adapter->runtime_disable_rx_thread;
+
+	/*
+	 * Segments of a flow held by the software coalescing are chained to
+	 * it, any other packet of the flow releases it before taking another
+	 * path to the stack, so that the flow stays in order.
+	 */
+	if (!skb_coalesce_ok) {
+		hdd_rx_coalesce_flush_flow(adapter, skb);
+	} else if (QDF_IS_STATUS_SUCCESS(hdd_rx_coalesce_rx(adapter, skb,
+							   false))) {
+		adapter->hdd_stats.tx_rx_stats.rx_aggregated++;
+		return QDF_STATUS_SUCCESS;
+	}
+
 	if (skb_receive_offload_ok && hdd_ctx->receive_offload_cb) {
 		status = hdd_ctx->receive_offload_cb(adapter, skb);
 
@@ -2369,6 +2465,13 @@ QDF_STATUS hdd_rx_deliver_to_stack(struct hdd_adapter *adapter,
 		}
 	}
 
+	/* software coalescing of what LRO/GRO did not take */
+	if (skb_coalesce_ok &&
+	    QDF_IS_STATUS_SUCCESS(hdd_rx_coalesce_rx(adapter, skb, true))) {
+		adapter->hdd_stats.tx_rx_stats.rx_aggregated++;
+		return QDF_STATUS_SUCCESS;
+	}
+
 	adapter->hdd_stats.tx_rx_stats.rx_non_aggregated++;
 
 	/* Account for GRO/LRO ineligible packets, mostly UDP */
@@ -2444,6 +2547,8 @@ QDF_STATUS hdd_rx_flush_packet_cbk(void *adapter_context, uint8_t vdev_id)
 	if (hdd_ctx->enable_dp_rx_threads)
 		dp_txrx_flush_pkts_by_vdev_id(soc, vdev_id);
 
+	hdd_rx_coalesce_flush_all(adapter);
+
 	hdd_adapter_put(adapter);
 
 	return QDF_STATUS_SUCCESS;
@@ -2477,6 +2582,7 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 	struct sk_buff *next = NULL;
 	struct hdd_station_ctx *sta_ctx = NULL;
 	unsigned int cpu_index;
+	struct hdd_pcpu_tx_rx_stats *pcpu_stats;
 	struct qdf_mac_addr *mac_addr, *dest_mac_addr;
 	bool wake_lock = false;
 	uint8_t pkt_type = 0;
@@ -2485,6 +2591,7 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 	enum qdf_proto_subtype subtype = QDF_PROTO_INVALID;
 	bool is_eapol;
 	bool is_dhcp;
+	uint8_t rx_ctx_id;
 
 	/* Sanity check on inputs */
 	if (unlikely((!adapter_context) || (!rxBuf))) {
@@ -2509,6 +2616,8 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 	}
 
 	cpu_index = wlan_hdd_get_cpu();
+	pcpu_stats = &adapter->hdd_stats.tx_rx_stats.pcpu[cpu_index];
+	rx_ctx_id = QDF_NBUF_CB_RX_CTX_ID(rxBuf);
 
 	next = (struct sk_buff *)rxBuf;
 
@@ -2597,13 +2706,15 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 			}
 		}
 
+		hdd_latency_flow_rx(adapter, skb);
+
 		skb->dev = adapter->dev;
 		skb->protocol = eth_type_trans(skb, skb->dev);
 		++adapter->hdd_stats.tx_rx_stats.rx_packets[cpu_index];
-		++adapter->stats.rx_packets;
+		++pcpu_stats->rx_packets;
 		/* count aggregated RX frame into stats */
-		adapter->stats.rx_packets += qdf_nbuf_get_gso_segs(skb);
-		adapter->stats.rx_bytes += skb->len;
+		pcpu_stats->rx_packets += qdf_nbuf_get_gso_segs(skb);
+		pcpu_stats->rx_bytes += skb->len;
 
 		/* Incr GW Rx count for NUD tracking based on GW mac addr */
 		hdd_nud_incr_gw_rx_pkt_cnt(adapter, mac_addr);
@@ -2684,6 +2795,8 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 		}
 	}
 
+	hdd_rx_coalesce_flush_batch(adapter, rx_ctx_id, false);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -3488,6 +3601,49 @@ static inline void hdd_ini_mscs_params(struct hdd_config *config,
 }
 #endif
 
+#ifdef WLAN_FEATURE_LATENCY_FLOW
+/**
+ * hdd_ini_latency_flow_params() - Initialize INIs of latency flow detection
+ * @config: pointer to hdd config
+ * @psoc: pointer to psoc obj
+ *
+ * Return: none
+ */
+static void hdd_ini_latency_flow_params(struct hdd_config *config,
+					struct wlan_objmgr_psoc *psoc)
+{
+	config->latency_flow_detect =
+		cfg_get(psoc, CFG_DP_LATENCY_FLOW_DETECT);
+	config->latency_flow_mscs =
+		cfg_get(psoc, CFG_DP_LATENCY_FLOW_MSCS);
+}
+#else
+static inline void hdd_ini_latency_flow_params(struct hdd_config *config,
+					       struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
+#ifdef WLAN_FEATURE_RX_COALESCE
+/**
+ * hdd_ini_rx_coalesce_params() - Initialize INIs of software RX coalescing
+ * @config: pointer to hdd config
+ * @psoc: pointer to psoc obj
+ *
+ * Return: none
+ */
+static void hdd_ini_rx_coalesce_params(struct hdd_config *config,
+				       struct wlan_objmgr_psoc *psoc)
+{
+	config->rx_coalesce = cfg_get(psoc, CFG_DP_RX_COALESCE);
+}
+#else
+static inline void hdd_ini_rx_coalesce_params(struct hdd_config *config,
+					      struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
 /**
  * hdd_ini_tx_flow_control() - Initialize INIs concerned about bus bandwidth
@@ -3513,6 +3669,15 @@ static void hdd_ini_bus_bandwidth(struct hdd_config *config,
 		cfg_get(psoc, CFG_DP_BUS_LOW_BW_CNT_THRESHOLD);
 	config->enable_latency_crit_clients =
 		cfg_get(psoc, CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS);
+	config->bus_bw_governor = cfg_get(psoc, CFG_DP_BUS_BW_GOVERNOR);
+	config->bus_bw_ewma_weight = cfg_get(psoc, CFG_DP_BUS_BW_EWMA_WEIGHT);
+	config->bus_bw_hysteresis = cfg_get(psoc, CFG_DP_BUS_BW_HYSTERESIS);
+	config->bus_bw_ramp_down_hold_cnt =
+		cfg_get(psoc, CFG_DP_BUS_BW_RAMP_DOWN_HOLD_CNT);
+	config->bus_bw_ramp_up_policy =
+		cfg_get(psoc, CFG_DP_BUS_BW_RAMP_UP_POLICY);
+	config->bus_bw_ramp_down_policy =
+		cfg_get(psoc, CFG_DP_BUS_BW_RAMP_DOWN_POLICY);
 }
 
 /**
@@ -3692,6 +3857,8 @@ void hdd_dp_cfg_update(struct wlan_objmgr_psoc *psoc,
 	hdd_ini_bus_bandwidth(config, psoc);
 	hdd_ini_tcp_settings(config, psoc);
 	hdd_ini_mscs_params(config, psoc);
+	hdd_ini_latency_flow_params(config, psoc);
+	hdd_ini_rx_coalesce_params(config, psoc);
 
 	hdd_ini_tcp_del_ack_settings(config, psoc);
 
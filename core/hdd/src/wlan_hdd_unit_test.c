@@ -23,6 +23,7 @@
  * debugfs unit_test_host
  */
 #include "wlan_hdd_main.h"
+#include "lim_probe_req_dedup_test.h"
 #include "qdf_delayed_work_test.h"
 #include "qdf_hashtable_test.h"
 #include "qdf_periodic_work_test.h"
@@ -33,7 +34,11 @@
 #include "qdf_trace.h"
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
+#include "sap_ch_select_test.h"
+#include "sme_qos_test.h"
 #include "wlan_dsc_test.h"
+#include "wlan_hdd_latency_flow_test.h"
+#include "wlan_hdd_rx_coalesce_test.h"
 #include "wlan_hdd_unit_test.h"
 
 typedef uint32_t (*hdd_ut_callback)(void);
@@ -45,6 +50,9 @@ struct hdd_ut_entry {
 
 struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "dsc", .callback = dsc_unit_test },
+	{ .name = "latency_flow", .callback = hdd_latency_flow_unit_test },
+	{ .name = "lim_probe_req_dedup",
+	  .callback = lim_probe_req_dedup_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
 	{ .name = "qdf_periodic_work",
@@ -54,6 +62,9 @@ struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "qdf_talloc", .callback = qdf_talloc_unit_test },
 	{ .name = "qdf_tracker", .callback = qdf_tracker_unit_test },
 	{ .name = "qdf_types", .callback = qdf_types_unit_test },
+	{ .name = "rx_coalesce", .callback = hdd_rx_coalesce_unit_test },
+	{ .name = "sap_acs", .callback = sap_acs_unit_test },
+	{ .name = "sme_qos", .callback = sme_qos_unit_test },
 };
 
 #define hdd_for_each_ut_entry(cursor) \
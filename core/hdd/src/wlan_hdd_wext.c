@@ -3030,6 +3030,7 @@ void hdd_wlan_get_stats(struct hdd_adapter *adapter, uint16_t *length,
 	int i = 0;
 	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
 
+	hdd_sync_tx_rx_stats(adapter);
 	for (; i < NUM_CPUS; i++) {
 		total_rx_pkt += stats->rx_packets[i];
 		total_rx_dropped += stats->rx_dropped[i];
@@ -398,6 +398,7 @@ static void hdd_wmm_inactivity_timer_cb(void *user_data)
 	ac = &adapter->hdd_wmm_status.ac_status[ac_type];
 
 	/* Get the Tx stats for this AC. */
+	hdd_sync_tx_rx_stats(adapter);
 	traffic_count =
 		adapter->hdd_stats.tx_rx_stats.tx_classified_ac[qos_context->
 								    ac_type];
@@ -476,6 +477,7 @@ hdd_wmm_enable_inactivity_timer(struct hdd_wmm_qos_context *qos_context,
 	}
 	ac->inactivity_time = inactivity_time;
 	/* Initialize the current tx traffic count on this AC */
+	hdd_sync_tx_rx_stats(adapter);
 	ac->last_traffic_count =
 		adapter->hdd_stats.tx_rx_stats.tx_classified_ac[qos_context->
 								    ac_type];
@@ -1638,6 +1640,8 @@ QDF_STATUS hdd_wmm_dscp_initial_state(struct hdd_adapter *adapter)
 		status = hdd_send_dscp_up_map_to_fw(adapter);
 	}
 
+	hdd_wmm_update_dscp_class(adapter);
+
 	return status;
 }
 
@@ -1749,11 +1753,10 @@ QDF_STATUS hdd_wmm_adapter_close(struct hdd_adapter *adapter)
  *				     if the current set priority is below the
  *				     pre-configured threshold for upgrade.
  * @adapter: [in] pointer to the adapter context (Should not be invalid)
- * @skb: [in] pointer to the packet to be transmitted
- * @user_pri: [out] priority set for this packet
+ * @user_pri: [in/out] priority of a UDP packet
  *
- * This function checks if the packet is a UDP packet and upgrades its
- * priority if its below the pre-configured upgrade threshold.
+ * This function upgrades the priority of a UDP packet if its below the
+ * pre-configured upgrade threshold.
  * The upgrade order is as below:
  * BK -> BE -> VI -> VO
  *
@@ -1761,13 +1764,8 @@ QDF_STATUS hdd_wmm_adapter_close(struct hdd_adapter *adapter)
  */
 static inline void
 hdd_check_and_upgrade_udp_qos(struct hdd_adapter *adapter,
-			      qdf_nbuf_t skb,
 			      enum sme_qos_wmmuptype *user_pri)
 {
-	/* Upgrade UDP pkt priority alone */
-	if (!(qdf_nbuf_is_ipv4_udp_pkt(skb) || qdf_nbuf_is_ipv6_udp_pkt(skb)))
-		return;
-
 	switch (adapter->upgrade_udp_qos_threshold) {
 	case QCA_WLAN_AC_BK:
 		break;
@@ -1790,28 +1788,25 @@ hdd_check_and_upgrade_udp_qos(struct hdd_adapter *adapter,
 }
 
 /**
- * hdd_wmm_classify_pkt() - Function which will classify an OS packet
- * into a WMM AC based on DSCP
+ * hdd_wmm_get_pkt_tos() - Function which will extract the TOS of an OS
+ * packet
  *
- * @adapter: adapter upon which the packet is being transmitted
  * @skb: pointer to network buffer
- * @user_pri: user priority of the OS packet
+ * @pkt_tos: TOS of the OS packet
  * @is_eapol: eapol packet flag
  *
- * Return: None
+ * Return: true if the TOS was taken from an IP header, so that the
+ *	classification holds for the whole flow of the packet
  */
-static
-void hdd_wmm_classify_pkt(struct hdd_adapter *adapter,
-			  struct sk_buff *skb,
-			  enum sme_qos_wmmuptype *user_pri,
-			  bool *is_eapol)
+static bool hdd_wmm_get_pkt_tos(struct sk_buff *skb, unsigned char *pkt_tos,
+				bool *is_eapol)
 {
-	unsigned char dscp;
 	unsigned char tos;
 	union generic_ethhdr *eth_hdr;
 	struct iphdr *ip_hdr;
 	struct ipv6hdr *ipv6hdr;
 	unsigned char *pkt;
+	bool is_ip = true;
 
 	/* this code is executed for every packet therefore
 	 * all debug code is kept conditional
@@ -1892,6 +1887,7 @@ void hdd_wmm_classify_pkt(struct hdd_adapter *adapter,
 			hdd_warn("VLAN tagged Unhandled Protocol, using default tos");
 #endif /* HDD_WMM_DEBUG */
 			tos = 0;
+			is_ip = false;
 		}
 	} else {
 		/* default */
@@ -1905,16 +1901,50 @@ void hdd_wmm_classify_pkt(struct hdd_adapter *adapter,
 			*is_eapol = true;
 		} else
 			tos = 0;
+		is_ip = false;
 	}
 
+	*pkt_tos = tos;
+
+	return is_ip;
+}
+
+/**
+ * hdd_wmm_classify_pkt() - Function which will classify an OS packet
+ * into a WMM AC based on DSCP
+ *
+ * @adapter: adapter upon which the packet is being transmitted
+ * @skb: pointer to network buffer
+ * @tos: TOS of the OS packet
+ * @user_pri: user priority of the OS packet
+ * @queue: netdev queue of the OS packet
+ *
+ * Return: None
+ */
+static
+void hdd_wmm_classify_pkt(struct hdd_adapter *adapter,
+			  struct sk_buff *skb,
+			  unsigned char tos,
+			  enum sme_qos_wmmuptype *user_pri,
+			  uint16_t *queue)
+{
+	unsigned char dscp;
+	struct hdd_wmm_dscp_class *dscp_class;
+
 	dscp = (tos >> 2) & 0x3f;
-	*user_pri = adapter->dscp_to_up_map[dscp];
+	dscp_class = &adapter->hdd_wmm_status.dscp_class[dscp];
 
 	/*
-	 * Upgrade the priority, if the user priority of this packet is
-	 * less than the configured threshold.
+	 * UDP packets use the priority upgraded to the configured
+	 * threshold, if their user priority is below it.
 	 */
-	hdd_check_and_upgrade_udp_qos(adapter, skb, user_pri);
+	if (qdf_nbuf_is_ipv4_udp_pkt(skb) || qdf_nbuf_is_ipv6_udp_pkt(skb)) {
+		*user_pri = dscp_class->udp_up;
+		*queue = dscp_class->udp_queue;
+	} else {
+		*user_pri = dscp_class->up;
+		*queue = dscp_class->queue;
+	}
 
 #ifdef HDD_WMM_DEBUG
 	hdd_debug("tos is %d, dscp is %d, up is %d", tos, dscp, *user_pri);
@@ -1959,6 +1989,123 @@ uint16_t hdd_get_queue_index(uint16_t up, bool is_eapol)
 }
 #endif
 
+void hdd_wmm_update_dscp_class(struct hdd_adapter *adapter)
+{
+	struct hdd_wmm_status *wmm_status = &adapter->hdd_wmm_status;
+	struct hdd_wmm_dscp_class *dscp_class;
+	enum sme_qos_wmmuptype up;
+	uint8_t dscp;
+
+	for (dscp = 0; dscp <= WLAN_MAX_DSCP; dscp++) {
+		dscp_class = &wmm_status->dscp_class[dscp];
+		up = adapter->dscp_to_up_map[dscp];
+		dscp_class->up = up;
+		dscp_class->queue = __hdd_get_queue_index(up);
+
+		hdd_check_and_upgrade_udp_qos(adapter, &up);
+		dscp_class->udp_up = up;
+		dscp_class->udp_queue = __hdd_get_queue_index(up);
+	}
+
+	/* the new generation must not be seen before the new table */
+	smp_wmb();
+	WRITE_ONCE(wmm_status->flow_cache_gen, wmm_status->flow_cache_gen + 1);
+}
+
+#define HDD_WMM_FLOW_ENTRY(hash, tos, gen, up, queue) \
+	(((uint64_t)(hash) << 32) | ((uint64_t)(tos) << 24) | \
+	 ((uint64_t)(gen) << 8) | ((uint64_t)(up) << 4) | (uint64_t)(queue))
+#define HDD_WMM_FLOW_ENTRY_HASH(entry) ((uint32_t)((entry) >> 32))
+#define HDD_WMM_FLOW_ENTRY_TOS(entry) ((uint8_t)((entry) >> 24))
+#define HDD_WMM_FLOW_ENTRY_GEN(entry) ((uint16_t)((entry) >> 8))
+#define HDD_WMM_FLOW_ENTRY_UP(entry) ((uint8_t)(((entry) >> 4) & 0xf))
+#define HDD_WMM_FLOW_ENTRY_QUEUE(entry) ((uint8_t)((entry) & 0xf))
+
+/**
+ * hdd_wmm_get_flow_hash() - get the flow hash of a TX packet
+ * @skb: [in] pointer to os packet
+ *
+ * Only a hash computed over the L4 tuple, as set from the socket of
+ * locally generated traffic, identifies a flow well enough to reuse its
+ * classification.
+ *
+ * Return: flow hash, 0 if the packet has none
+ */
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 18, 0))
+static inline uint32_t hdd_wmm_get_flow_hash(struct sk_buff *skb)
+{
+	return skb->l4_hash ? skb->hash : 0;
+}
+#else
+static inline uint32_t hdd_wmm_get_flow_hash(struct sk_buff *skb)
+{
+	return 0;
+}
+#endif
+
+/**
+ * hdd_wmm_flow_cache_get() - look up the classification of a flow
+ * @adapter: [in] adapter upon which the packet is being transmitted
+ * @hash: [in] flow hash of the packet
+ * @tos: [in] TOS of the packet
+ * @gen: [in] current generation of the DSCP classification table
+ * @up: [out] cached user priority
+ * @queue: [out] cached netdev queue
+ *
+ * A flow which changes its TOS, or a hash collision with a flow using
+ * another TOS, misses the cache and gets classified again.
+ *
+ * Return: true if a valid classification was found
+ */
+static bool hdd_wmm_flow_cache_get(struct hdd_adapter *adapter,
+				   uint32_t hash, unsigned char tos,
+				   uint16_t gen,
+				   enum sme_qos_wmmuptype *up,
+				   uint16_t *queue)
+{
+	uint64_t entry;
+
+	if (!hash)
+		return false;
+
+	entry = READ_ONCE(adapter->hdd_wmm_status.flow_cache[
+				hash & (HDD_WMM_FLOW_CACHE_SIZE - 1)]);
+	if (HDD_WMM_FLOW_ENTRY_HASH(entry) != hash ||
+	    HDD_WMM_FLOW_ENTRY_TOS(entry) != tos ||
+	    HDD_WMM_FLOW_ENTRY_GEN(entry) != gen)
+		return false;
+
+	*up = HDD_WMM_FLOW_ENTRY_UP(entry);
+	*queue = HDD_WMM_FLOW_ENTRY_QUEUE(entry);
+
+	return true;
+}
+
+/**
+ * hdd_wmm_flow_cache_set() - cache the classification of a flow
+ * @adapter: [in] adapter upon which the packet is being transmitted
+ * @hash: [in] flow hash of the packet
+ * @tos: [in] TOS of the packet
+ * @gen: [in] generation of the table used to classify the packet
+ * @up: [in] user priority of the flow
+ * @queue: [in] netdev queue of the flow
+ *
+ * Entries are single 64 bit words updated without a lock by senders on
+ * any CPU. On 32 bit targets a torn read can at worst misprioritize a
+ * single packet.
+ *
+ * Return: None
+ */
+static void hdd_wmm_flow_cache_set(struct hdd_adapter *adapter,
+				   uint32_t hash, unsigned char tos,
+				   uint16_t gen, enum sme_qos_wmmuptype up,
+				   uint16_t queue)
+{
+	WRITE_ONCE(adapter->hdd_wmm_status.flow_cache[
+				hash & (HDD_WMM_FLOW_CACHE_SIZE - 1)],
+		   HDD_WMM_FLOW_ENTRY(hash, tos, gen, up, queue));
+}
+
 /**
  * hdd_wmm_select_queue() - Function which will classify the packet
  *       according to linux qdisc expectation.
@@ -1972,12 +2119,17 @@ static uint16_t hdd_wmm_select_queue(struct net_device *dev,
 				     struct sk_buff *skb)
 {
 	enum sme_qos_wmmuptype up = SME_QOS_WMM_UP_BE;
+	enum sme_qos_wmmuptype flow_up;
 	uint16_t index;
 	struct hdd_adapter *adapter = WLAN_HDD_GET_PRIV_PTR(dev);
 	bool is_crtical = false;
 	struct hdd_context *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
 	int status;
 	enum qdf_proto_subtype proto_subtype;
+	uint32_t pause_map;
+	uint32_t hash;
+	uint16_t gen;
+	unsigned char tos;
 
 	status = wlan_hdd_validate_context(hdd_ctx);
 	if (status != 0) {
@@ -1985,11 +2137,34 @@ static uint16_t hdd_wmm_select_queue(struct net_device *dev,
 		return HDD_LINUX_AC_BE;
 	}
 
-	/* Get the user priority from IP header */
-	hdd_wmm_classify_pkt(adapter, skb, &up, &is_crtical);
-	spin_lock_bh(&adapter->pause_map_lock);
-	if ((adapter->pause_map & (1 <<  WLAN_DATA_FLOW_CONTROL)) &&
-	   !(adapter->pause_map & (1 <<  WLAN_DATA_FLOW_CONTROL_PRIORITY))) {
+	/* only the flow of an IP packet shares its classification */
+	if (hdd_wmm_get_pkt_tos(skb, &tos, &is_crtical))
+		hash = hdd_wmm_get_flow_hash(skb);
+	else
+		hash = 0;
+	gen = READ_ONCE(adapter->hdd_wmm_status.flow_cache_gen);
+	/* pairs with smp_wmb() in hdd_wmm_update_dscp_class() */
+	smp_rmb();
+
+	if (!hdd_wmm_flow_cache_get(adapter, hash, tos, gen, &up, &index)) {
+		/* Get the user priority from IP header */
+		hdd_wmm_classify_pkt(adapter, skb, tos, &up, &index);
+		if (hash)
+			hdd_wmm_flow_cache_set(adapter, hash, tos, gen, up,
+					       index);
+	}
+
+	/* a latency sensitive flow only ever gets a higher access category */
+	if (hdd_latency_flow_tx(adapter, skb, &flow_up) &&
+	    __hdd_get_queue_index(flow_up) < index) {
+		up = flow_up;
+		index = __hdd_get_queue_index(up);
+	}
+
+	/* a single word read needs no pause_map_lock */
+	pause_map = READ_ONCE(adapter->pause_map);
+	if ((pause_map & (1 <<  WLAN_DATA_FLOW_CONTROL)) &&
+	    !(pause_map & (1 <<  WLAN_DATA_FLOW_CONTROL_PRIORITY))) {
 		if (qdf_nbuf_is_ipv4_arp_pkt(skb))
 			is_crtical = true;
 		else if (qdf_nbuf_is_icmpv6_pkt(skb)) {
@@ -2004,9 +2179,9 @@ static uint16_t hdd_wmm_select_queue(struct net_device *dev,
 			}
 		}
 	}
-	spin_unlock_bh(&adapter->pause_map_lock);
 	skb->priority = up;
-	index = hdd_get_queue_index(skb->priority, is_crtical);
+	if (qdf_unlikely(is_crtical))
+		index = hdd_get_queue_index(skb->priority, is_crtical);
 
 	return index;
 }
@@ -2352,6 +2527,8 @@ QDF_STATUS hdd_wmm_assoc(struct hdd_adapter *adapter,
 
 	if (!QDF_IS_STATUS_SUCCESS(status))
 		hdd_wmm_dscp_initial_state(adapter);
+	else
+		hdd_wmm_update_dscp_class(adapter);
 
 	hdd_exit();
 
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "wlan_hdd_latency_flow.h"
+#include "wlan_hdd_latency_flow_test.h"
+
+#define lf_err(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_HDD, QDF_TRACE_LEVEL_ERROR, fmt, ##args)
+
+/**
+ * struct latency_flow_trace - synthetic traffic of one flow
+ * @port: port identifying the flow
+ * @tx_period_ms: period of the TX bursts, 0 for none
+ * @tx_burst: packets per TX burst
+ * @tx_len: length of a TX packet
+ * @rx_period_ms: period of the RX bursts, 0 for none
+ * @rx_burst: packets per RX burst
+ * @rx_len: length of an RX packet
+ * @start_ms: time the flow starts
+ * @end_ms: time the flow stops
+ */
+struct latency_flow_trace {
+	uint16_t port;
+	uint16_t tx_period_ms;
+	uint16_t tx_burst;
+	uint16_t tx_len;
+	uint16_t rx_period_ms;
+	uint16_t rx_burst;
+	uint16_t rx_len;
+	uint32_t start_ms;
+	uint32_t end_ms;
+};
+
+static void latency_flow_test_key(struct hdd_latency_flow_key *key,
+				  uint16_t port)
+{
+	key->hash = port;
+	key->port[0] = port;
+	key->port[1] = port + 1;
+	key->ip_ver = 4;
+}
+
+static void latency_flow_test_send(struct hdd_latency_flow_table *table,
+				   uint16_t port, uint16_t period_ms,
+				   uint16_t burst, uint16_t len,
+				   enum hdd_latency_flow_dir dir,
+				   uint32_t elapsed_ms, uint64_t now_us)
+{
+	struct hdd_latency_flow_key key;
+	uint16_t i;
+
+	if (!period_ms || elapsed_ms % period_ms)
+		return;
+
+	latency_flow_test_key(&key, port);
+	/* packets of a burst go out back to back */
+	for (i = 0; i < burst; i++)
+		hdd_latency_flow_table_update(table, &key, len, dir,
+					      now_us + i);
+}
+
+/**
+ * latency_flow_test_replay() - replay traces through a flow table
+ * @table: flow table
+ * @trace: traces to replay
+ * @num: number of traces
+ * @from_ms: replay start
+ * @to_ms: replay end
+ *
+ * The flow table is aged at @to_ms so that the last window is evaluated.
+ *
+ * Return: None
+ */
+static void latency_flow_test_replay(struct hdd_latency_flow_table *table,
+				     const struct latency_flow_trace *trace,
+				     uint32_t num, uint32_t from_ms,
+				     uint32_t to_ms)
+{
+	const struct latency_flow_trace *cur;
+	uint64_t now_us;
+	uint32_t ms, i;
+
+	for (ms = from_ms; ms < to_ms; ms++) {
+		/* start at 1 ms, a zero timestamp means no TX seen yet */
+		now_us = (uint64_t)(ms + 1) * 1000;
+		for (i = 0; i < num; i++) {
+			cur = &trace[i];
+			if (ms < cur->start_ms || ms >= cur->end_ms)
+				continue;
+
+			latency_flow_test_send(table, cur->port,
+					       cur->tx_period_ms, cur->tx_burst,
+					       cur->tx_len, HDD_LATENCY_FLOW_TX,
+					       ms - cur->start_ms, now_us);
+			latency_flow_test_send(table, cur->port,
+					       cur->rx_period_ms, cur->rx_burst,
+					       cur->rx_len, HDD_LATENCY_FLOW_RX,
+					       ms - cur->start_ms, now_us);
+		}
+	}
+
+	hdd_latency_flow_table_age(table, (uint64_t)(to_ms + 1) * 1000);
+}
+
+static struct hdd_latency_flow *
+latency_flow_test_find(struct hdd_latency_flow_table *table, uint16_t port)
+{
+	struct hdd_latency_flow *flow;
+	int i;
+
+	for (i = 0; i < HDD_LATENCY_FLOW_MAX; i++) {
+		flow = &table->flows[i];
+		if (flow->in_use && flow->key.port[0] == port)
+			return flow;
+	}
+
+	return NULL;
+}
+
+static uint32_t latency_flow_test_expect(struct hdd_latency_flow_table *table,
+					 uint16_t port,
+					 enum sme_qos_wmmuptype expected)
+{
+	struct hdd_latency_flow *flow = latency_flow_test_find(table, port);
+	enum sme_qos_wmmuptype up = SME_QOS_WMM_UP_BE;
+
+	if (flow && flow->promoted)
+		up = flow->up;
+
+	if (up == expected)
+		return 0;
+
+	lf_err("FAIL: flow %u; expected up %d, found %d", port, expected, up);
+
+	return 1;
+}
+
+static struct hdd_latency_flow_table *latency_flow_test_create(void)
+{
+	struct hdd_latency_flow_table *table;
+
+	table = qdf_mem_malloc(sizeof(*table));
+	if (!table)
+		return NULL;
+
+	hdd_latency_flow_table_init(table, true);
+
+	return table;
+}
+
+static void latency_flow_test_destroy(struct hdd_latency_flow_table *table)
+{
+	hdd_latency_flow_table_deinit(table);
+	qdf_mem_free(table);
+}
+
+static uint32_t latency_flow_test_interactive(void)
+{
+	static const struct latency_flow_trace trace[] = {
+		/* cloud gaming: 60 Hz inputs, video frames back */
+		{ 1000, 16, 1, 120, 16, 4, 1300, 0, 3000 },
+		/* video call */
+		{ 2000, 10, 1, 1000, 10, 1, 1100, 0, 3000 },
+		/* VoIP, 20 ms frames */
+		{ 3000, 20, 1, 172, 20, 1, 172, 0, 3000 },
+	};
+	struct hdd_latency_flow_table *table;
+	uint32_t errors = 0;
+
+	table = latency_flow_test_create();
+	if (!table)
+		return 1;
+
+	/* one window is not enough to get promoted */
+	latency_flow_test_replay(table, trace, QDF_ARRAY_SIZE(trace), 0, 500);
+	errors += latency_flow_test_expect(table, 1000, SME_QOS_WMM_UP_BE);
+
+	latency_flow_test_replay(table, trace, QDF_ARRAY_SIZE(trace),
+				 500, 3000);
+	errors += latency_flow_test_expect(table, 1000, SME_QOS_WMM_UP_VO);
+	errors += latency_flow_test_expect(table, 2000, SME_QOS_WMM_UP_VI);
+	errors += latency_flow_test_expect(table, 3000, SME_QOS_WMM_UP_VO);
+	if (table->num_promoted != 3) {
+		lf_err("FAIL: expected 3 promoted flows, found %u",
+		       table->num_promoted);
+		errors++;
+	}
+
+	latency_flow_test_destroy(table);
+
+	return errors;
+}
+
+static uint32_t latency_flow_test_bulk(void)
+{
+	static const struct latency_flow_trace trace[] = {
+		/* QUIC download, ack every other packet */
+		{ 4000, 1, 1, 80, 1, 2, 1400, 0, 3000 },
+		/* upload */
+		{ 5000, 1, 1, 1400, 10, 1, 80, 0, 3000 },
+		/* bursty request/response */
+		{ 6000, 250, 10, 100, 250, 10, 100, 0, 3000 },
+		/* one way stream */
+		{ 7000, 0, 0, 0, 5, 1, 1300, 0, 3000 },
+	};
+	struct hdd_latency_flow_table *table;
+	uint32_t errors = 0;
+
+	table = latency_flow_test_create();
+	if (!table)
+		return 1;
+
+	latency_flow_test_replay(table, trace, QDF_ARRAY_SIZE(trace), 0, 3000);
+	errors += latency_flow_test_expect(table, 4000, SME_QOS_WMM_UP_BE);
+	errors += latency_flow_test_expect(table, 5000, SME_QOS_WMM_UP_BE);
+	errors += latency_flow_test_expect(table, 6000, SME_QOS_WMM_UP_BE);
+	errors += latency_flow_test_expect(table, 7000, SME_QOS_WMM_UP_BE);
+	if (table->num_promoted) {
+		lf_err("FAIL: expected no promoted flow, found %u",
+		       table->num_promoted);
+		errors++;
+	}
+
+	latency_flow_test_destroy(table);
+
+	return errors;
+}
+
+static uint32_t latency_flow_test_demote(void)
+{
+	static const struct latency_flow_trace trace[] = {
+		/* game session turning into a bulk transfer */
+		{ 1000, 16, 1, 120, 16, 1, 300, 0, 2000 },
+		{ 1000, 1, 1, 1400, 1, 1, 80, 2000, 4000 },
+		/* game session going silent */
+		{ 2000, 16, 1, 120, 16, 1, 300, 0, 2000 },
+	};
+	struct hdd_latency_flow_table *table;
+	uint32_t errors = 0;
+
+	table = latency_flow_test_create();
+	if (!table)
+		return 1;
+
+	latency_flow_test_replay(table, trace, QDF_ARRAY_SIZE(trace), 0, 2000);
+	errors += latency_flow_test_expect(table, 1000, SME_QOS_WMM_UP_VO);
+	errors += latency_flow_test_expect(table, 2000, SME_QOS_WMM_UP_VO);
+
+	/* two failing windows keep the promotion */
+	latency_flow_test_replay(table, trace, QDF_ARRAY_SIZE(trace),
+				 2000, 3000);
+	errors += latency_flow_test_expect(table, 1000, SME_QOS_WMM_UP_VO);
+	errors += latency_flow_test_expect(table, 2000, SME_QOS_WMM_UP_VO);
+
+	latency_flow_test_replay(table, trace, QDF_ARRAY_SIZE(trace),
+				 3000, 4000);
+	errors += latency_flow_test_expect(table, 1000, SME_QOS_WMM_UP_BE);
+	if (table->num_promoted) {
+		lf_err("FAIL: expected no promoted flow, found %u",
+		       table->num_promoted);
+		errors++;
+	}
+
+	/* the silent flow expires from the table */
+	if (latency_flow_test_find(table, 2000)) {
+		lf_err("FAIL: silent flow did not expire");
+		errors++;
+	}
+
+	latency_flow_test_destroy(table);
+
+	return errors;
+}
+
+static uint32_t latency_flow_test_bounded(void)
+{
+	struct hdd_latency_flow_table *table;
+	struct hdd_latency_flow_key key;
+	uint32_t errors = 0;
+	uint32_t in_use = 0;
+	uint16_t port;
+	int i;
+
+	table = latency_flow_test_create();
+	if (!table)
+		return 1;
+
+	for (port = 1; port <= HDD_LATENCY_FLOW_MAX + 8; port++) {
+		latency_flow_test_key(&key, port * 2);
+		hdd_latency_flow_table_update(table, &key, 100,
+					      HDD_LATENCY_FLOW_TX, port * 1000);
+	}
+
+	for (i = 0; i < HDD_LATENCY_FLOW_MAX; i++)
+		in_use += table->flows[i].in_use;
+
+	if (in_use != HDD_LATENCY_FLOW_MAX || table->evictions != 8) {
+		lf_err("FAIL: expected %d flows and 8 evictions, found %u, %u",
+		       HDD_LATENCY_FLOW_MAX, in_use, table->evictions);
+		errors++;
+	}
+
+	/* the least recently seen flows are the ones replaced */
+	if (latency_flow_test_find(table, 2 * 8) ||
+	    !latency_flow_test_find(table, 2 * 9)) {
+		lf_err("FAIL: evicted flows are not the oldest ones");
+		errors++;
+	}
+
+	latency_flow_test_destroy(table);
+
+	return errors;
+}
+
+uint32_t hdd_latency_flow_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += latency_flow_test_interactive();
+	errors += latency_flow_test_bulk();
+	errors += latency_flow_test_demote();
+	errors += latency_flow_test_bounded();
+
+	return errors;
+}
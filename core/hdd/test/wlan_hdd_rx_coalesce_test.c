@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <linux/ip.h>
+#include <linux/tcp.h>
+#include <linux/if_ether.h>
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "wlan_hdd_rx_coalesce.h"
+#include "wlan_hdd_rx_coalesce_test.h"
+
+#define rxc_err(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_HDD, QDF_TRACE_LEVEL_ERROR, fmt, ##args)
+
+/* payload length of the full sized segments */
+#define RXC_TEST_MSS 1000
+/* IP and TCP headers of the segments, without options */
+#define RXC_TEST_HDR_LEN (sizeof(struct iphdr) + sizeof(struct tcphdr))
+
+/* packets the coalescing gave to the stack */
+static struct sk_buff_head rxc_test_delivered;
+
+static void rxc_test_deliver(struct sk_buff *skb)
+{
+	skb_queue_tail(&rxc_test_delivered, skb);
+}
+
+static struct sk_buff *rxc_test_segment(uint16_t port, uint32_t seq,
+					uint16_t payload_len, bool psh)
+{
+	uint16_t len = RXC_TEST_HDR_LEN + payload_len;
+	struct sk_buff *skb;
+	struct iphdr *iph;
+	struct tcphdr *th;
+
+	skb = alloc_skb(len, GFP_KERNEL);
+	if (!skb)
+		return NULL;
+
+	iph = (struct iphdr *)skb_put(skb, len);
+	qdf_mem_zero(iph, len);
+	iph->version = 4;
+	iph->ihl = 5;
+	iph->ttl = 64;
+	iph->protocol = IPPROTO_TCP;
+	iph->tot_len = htons(len);
+	iph->saddr = htonl(0xc0a80101);
+	iph->daddr = htonl(0xc0a80102);
+
+	th = (struct tcphdr *)(iph + 1);
+	th->source = htons(port);
+	th->dest = htons(5001);
+	th->seq = htonl(seq);
+	th->ack_seq = htonl(1);
+	th->doff = sizeof(*th) / 4;
+	th->ack = 1;
+	th->psh = psh;
+	th->window = htons(1024);
+
+	skb->protocol = htons(ETH_P_IP);
+	skb->ip_summed = CHECKSUM_UNNECESSARY;
+
+	return skb;
+}
+
+static uint32_t rxc_test_rx(struct hdd_rx_coalesce *rxc, uint16_t port,
+			    uint32_t seq, uint16_t payload_len, bool psh,
+			    bool hold, QDF_STATUS expected)
+{
+	struct sk_buff *skb;
+	QDF_STATUS status;
+
+	skb = rxc_test_segment(port, seq, payload_len, psh);
+	if (!skb) {
+		rxc_err("FAIL: segment allocation failed");
+		return 1;
+	}
+
+	status = hdd_rx_coalesce_state_rx(rxc, skb, hold);
+	/* a segment which is not taken is delivered by the caller */
+	if (QDF_IS_STATUS_ERROR(status))
+		kfree_skb(skb);
+
+	if (status != expected) {
+		rxc_err("FAIL: port %u seq %u; expected status %d, found %d",
+			port, seq, expected, status);
+		return 1;
+	}
+
+	return 0;
+}
+
+static uint32_t rxc_test_expect(uint16_t port, uint32_t seq, uint16_t segs,
+				uint32_t payload_len)
+{
+	struct sk_buff *skb;
+	struct iphdr *iph;
+	struct tcphdr *th;
+	uint32_t errors = 0;
+
+	skb = skb_dequeue(&rxc_test_delivered);
+	if (!skb) {
+		rxc_err("FAIL: port %u seq %u; nothing delivered", port, seq);
+		return 1;
+	}
+
+	iph = (struct iphdr *)skb->data;
+	th = (struct tcphdr *)(iph + 1);
+	if (ntohs(th->source) != port || ntohl(th->seq) != seq ||
+	    skb->len != RXC_TEST_HDR_LEN + payload_len) {
+		rxc_err("FAIL: expected port %u seq %u len %zu, found %u %u %u",
+			port, seq, RXC_TEST_HDR_LEN + payload_len,
+			ntohs(th->source), ntohl(th->seq), skb->len);
+		errors++;
+	}
+
+	if (segs > 1) {
+		if (skb_shinfo(skb)->gso_segs != segs ||
+		    skb_shinfo(skb)->gso_size != RXC_TEST_MSS ||
+		    skb->ip_summed != CHECKSUM_PARTIAL ||
+		    ntohs(iph->tot_len) != skb->len) {
+			rxc_err("FAIL: port %u seq %u; expected a GSO packet of %u segs, found %u segs, gso size %u, tot len %u",
+				port, seq, segs, skb_shinfo(skb)->gso_segs,
+				skb_shinfo(skb)->gso_size, ntohs(iph->tot_len));
+			errors++;
+		}
+	} else if (skb_is_gso(skb)) {
+		rxc_err("FAIL: port %u seq %u; single segment turned into GSO",
+			port, seq);
+		errors++;
+	}
+
+	kfree_skb(skb);
+
+	return errors;
+}
+
+static uint32_t rxc_test_expect_none(void)
+{
+	if (skb_queue_empty(&rxc_test_delivered))
+		return 0;
+
+	rxc_err("FAIL: expected nothing delivered, found %u packets",
+		skb_queue_len(&rxc_test_delivered));
+	skb_queue_purge(&rxc_test_delivered);
+
+	return 1;
+}
+
+static uint32_t rxc_test_expect_flush(struct hdd_rx_coalesce *rxc,
+				      enum hdd_rx_coalesce_flush_reason reason,
+				      uint64_t expected)
+{
+	uint64_t flushed = rxc->ctx[0].stats.flush[reason];
+
+	if (flushed == expected)
+		return 0;
+
+	rxc_err("FAIL: flush reason %d; expected %llu, found %llu",
+		reason, expected, flushed);
+
+	return 1;
+}
+
+static struct hdd_rx_coalesce *rxc_test_create(void)
+{
+	struct hdd_rx_coalesce *rxc;
+
+	rxc = qdf_mem_malloc(sizeof(*rxc));
+	if (!rxc)
+		return NULL;
+
+	skb_queue_head_init(&rxc_test_delivered);
+	hdd_rx_coalesce_state_init(rxc, true, rxc_test_deliver);
+
+	return rxc;
+}
+
+static void rxc_test_destroy(struct hdd_rx_coalesce *rxc)
+{
+	hdd_rx_coalesce_state_deinit(rxc);
+	qdf_mem_free(rxc);
+	skb_queue_purge(&rxc_test_delivered);
+}
+
+static uint32_t rxc_test_merge(void)
+{
+	struct hdd_rx_coalesce *rxc;
+	uint32_t errors = 0;
+	int i;
+
+	rxc = rxc_test_create();
+	if (!rxc)
+		return 1;
+
+	/* two interleaved flows, each chained to its own super packet */
+	for (i = 0; i < 4; i++) {
+		errors += rxc_test_rx(rxc, 1000, 10000 + i * RXC_TEST_MSS,
+				      RXC_TEST_MSS, false, true,
+				      QDF_STATUS_SUCCESS);
+		errors += rxc_test_rx(rxc, 2000, 20000 + i * RXC_TEST_MSS,
+				      RXC_TEST_MSS, false, !i,
+				      QDF_STATUS_SUCCESS);
+	}
+	errors += rxc_test_expect_none();
+
+	if (rxc->ctx[0].num_flows != 2 || rxc->ctx[0].stats.merged != 6) {
+		rxc_err("FAIL: expected 2 flows and 6 merged, found %u, %llu",
+			rxc->ctx[0].num_flows, rxc->ctx[0].stats.merged);
+		errors++;
+	}
+
+	hdd_rx_coalesce_state_flush_batch(rxc, 0, true);
+	errors += rxc_test_expect(1000, 10000, 4, 4 * RXC_TEST_MSS);
+	errors += rxc_test_expect(2000, 20000, 4, 4 * RXC_TEST_MSS);
+	errors += rxc_test_expect_none();
+	errors += rxc_test_expect_flush(rxc, HDD_RX_COALESCE_FLUSH_BATCH, 2);
+
+	if (rxc->ctx[0].num_flows || rxc->ctx[0].stats.super_pkts != 2) {
+		rxc_err("FAIL: expected no flow and 2 super pkts, found %u, %llu",
+			rxc->ctx[0].num_flows, rxc->ctx[0].stats.super_pkts);
+		errors++;
+	}
+
+	rxc_test_destroy(rxc);
+
+	return errors;
+}
+
+static uint32_t rxc_test_push(void)
+{
+	struct hdd_rx_coalesce *rxc;
+	uint32_t errors = 0;
+
+	rxc = rxc_test_create();
+	if (!rxc)
+		return 1;
+
+	/* PSH delivers the super packet with the segment */
+	errors += rxc_test_rx(rxc, 1000, 10000, RXC_TEST_MSS, false, true,
+			      QDF_STATUS_SUCCESS);
+	errors += rxc_test_rx(rxc, 1000, 11000, RXC_TEST_MSS, true, true,
+			      QDF_STATUS_SUCCESS);
+	errors += rxc_test_expect(1000, 10000, 2, 2 * RXC_TEST_MSS);
+
+	/* so does a segment shorter than the first one */
+	errors += rxc_test_rx(rxc, 1000, 12000, RXC_TEST_MSS, false, true,
+			      QDF_STATUS_SUCCESS);
+	errors += rxc_test_rx(rxc, 1000, 13000, 500, false, true,
+			      QDF_STATUS_SUCCESS);
+	errors += rxc_test_expect(1000, 12000, 2, RXC_TEST_MSS + 500);
+
+	/* a lone PSH segment is left to the caller */
+	errors += rxc_test_rx(rxc, 1000, 13500, RXC_TEST_MSS, true, true,
+			      QDF_STATUS_E_NOSUPPORT);
+	errors += rxc_test_expect_none();
+	errors += rxc_test_expect_flush(rxc, HDD_RX_COALESCE_FLUSH_PUSH, 2);
+
+	rxc_test_destroy(rxc);
+
+	return errors;
+}
+
+static uint32_t rxc_test_out_of_order(void)
+{
+	struct hdd_rx_coalesce *rxc;
+	uint32_t errors = 0;
+
+	rxc = rxc_test_create();
+	if (!rxc)
+		return 1;
+
+	/* a gap delivers what is held and starts over from the segment */
+	errors += rxc_test_rx(rxc, 1000, 10000, RXC_TEST_MSS, false, true,
+			      QDF_STATUS_SUCCESS);
+	errors += rxc_test_rx(rxc, 1000, 12000, RXC_TEST_MSS, false, true,
+			      QDF_STATUS_SUCCESS);
+	errors += rxc_test_expect(1000, 10000, 1, RXC_TEST_MSS);
+	errors += rxc_test_expect_none();
+	errors += rxc_test_expect_flush(rxc, HDD_RX_COALESCE_FLUSH_OOO, 1);
+
+	hdd_rx_coalesce_state_flush_all(rxc);
+	errors += rxc_test_expect(1000, 12000, 1, RXC_TEST_MSS);
+	errors += rxc_test_expect_none();
+
+	rxc_test_destroy(rxc);
+
+	return errors;
+}
+
+static uint32_t rxc_test_bypass(void)
+{
+	struct hdd_rx_coalesce *rxc;
+	uint32_t errors = 0;
+	struct sk_buff *skb;
+
+	rxc = rxc_test_create();
+	if (!rxc)
+		return 1;
+
+	/* nothing held, nothing to chain to */
+	errors += rxc_test_rx(rxc, 1000, 10000, RXC_TEST_MSS, false, false,
+			      QDF_STATUS_E_NOSUPPORT);
+	errors += rxc_test_expect_none();
+
+	/* a pure ACK of a held flow is preceded by its super packet */
+	errors += rxc_test_rx(rxc, 1000, 10000, RXC_TEST_MSS, false, true,
+			      QDF_STATUS_SUCCESS);
+	errors += rxc_test_rx(rxc, 1000, 11000, 0, false, true,
+			      QDF_STATUS_E_NOSUPPORT);
+	errors += rxc_test_expect(1000, 10000, 1, RXC_TEST_MSS);
+	errors += rxc_test_expect_flush(rxc, HDD_RX_COALESCE_FLUSH_MISMATCH,
+					1);
+
+	/* so is a segment which goes to the stack another way */
+	errors += rxc_test_rx(rxc, 2000, 20000, RXC_TEST_MSS, false, true,
+			      QDF_STATUS_SUCCESS);
+	skb = rxc_test_segment(2000, 21000, RXC_TEST_MSS, false);
+	if (skb) {
+		hdd_rx_coalesce_state_flush_flow(rxc, skb);
+		kfree_skb(skb);
+		errors += rxc_test_expect(2000, 20000, 1, RXC_TEST_MSS);
+	} else {
+		errors++;
+	}
+	errors += rxc_test_expect_none();
+
+	rxc_test_destroy(rxc);
+
+	return errors;
+}
+
+uint32_t hdd_rx_coalesce_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += rxc_test_merge();
+	errors += rxc_test_push();
+	errors += rxc_test_out_of_order();
+	errors += rxc_test_bypass();
+
+	return errors;
+}
@@ -25,6 +25,7 @@
 #include "sys_def.h"
 #include "dph_global.h"
 #include "lim_global.h"
+#include "lim_probe_req_dedup.h"
 #include "sch_global.h"
 #include "sys_global.h"
 #include "sir_api.h"
@@ -653,6 +654,9 @@ typedef struct sAniSirLim {
 	wlan_scan_requester req_id;
 	QDF_STATUS (*sme_bcn_rcv_callback)(hdd_handle_t hdd_handle,
 				struct wlan_beacon_report *beacon_report);
+#ifdef WLAN_FEATURE_PROBE_REQ_DEDUP
+	struct lim_probe_req_dedup probe_req_dedup;
+#endif
 } tAniSirLim, *tpAniSirLim;
 
 struct mgmt_frm_reg_info {
@@ -719,6 +723,7 @@ struct vdev_type_nss {
  * @sta_bssid: Array of PE STA session's peer BSSIDs
  * @num_sap_session: Number of active PE SAP sessions
  * @sap_channel: Array of PE SAP session's channels
+ * @sap_freq: Array of PE SAP session's frequencies
  *
  * Used to filter the STA/IBSS/SAP beacons/probes required in PE and
  * drop other unwanted beacon/probe response frames
@@ -728,6 +733,7 @@ struct mgmt_beacon_probe_filter {
 	tSirMacAddr sta_bssid[WLAN_MAX_VDEVS];
 	uint8_t num_sap_sessions;
 	uint8_t sap_channel[WLAN_MAX_VDEVS];
+	qdf_freq_t sap_freq[WLAN_MAX_VDEVS];
 };
 
 #ifdef FEATURE_ANI_LEVEL_REQUEST
@@ -2798,6 +2798,31 @@ typedef struct sSirUpdateIEsInd {
 	eUpdateIEsType updateType;
 } tSirUpdateIEsInd, *tpSirUpdateIEsInd;
 
+/**
+ * struct sir_probe_rsp_cache_stats - probe response cache statistics
+ * @hits: probe responses sent from the cached frame
+ * @builds: probe responses built and cached
+ * @invalidations: cached probe responses dropped by a beacon or IE update
+ */
+struct sir_probe_rsp_cache_stats {
+	uint32_t hits;
+	uint32_t builds;
+	uint32_t invalidations;
+};
+
+/**
+ * struct sir_probe_req_dedup_stats - probe request deduplication statistics
+ * @passed: probe requests of a SAP or P2P GO checked and posted to PE,
+ *	while the deduplication is enabled
+ * @coalesced: duplicate probe requests dropped
+ * @dropped: probe requests dropped as the PE queue was full
+ */
+struct sir_probe_req_dedup_stats {
+	uint32_t passed;
+	uint32_t coalesced;
+	uint32_t dropped;
+};
+
 /* Message format for requesting channel switch announcement to lower layers */
 typedef struct sSirDfsCsaIeRequest {
 	uint16_t msgType;
@@ -2899,14 +2924,19 @@ typedef struct {
 } tSirStatsExtEvent, *tpSirStatsExtEvent;
 #endif
 
+/*
+ * The beacon/probe response and reassoc frames are not copied into the
+ * roam synch indication, they reference the buffers received from firmware
+ * which stay valid until the roam synch propagation is over.
+ */
 struct roam_offload_synch_ind {
 	uint16_t messageType;   /*eWNI_SME_ROAM_OFFLOAD_SYNCH_IND */
 	uint16_t length;
-	uint16_t beaconProbeRespOffset;
+	uint8_t *bcn_probe_rsp;
 	uint16_t beaconProbeRespLength;
-	uint16_t reassocRespOffset;
+	uint8_t *reassoc_rsp;
 	uint16_t reassocRespLength;
-	uint16_t reassoc_req_offset;
+	uint8_t *reassoc_req;
 	uint16_t reassoc_req_length;
 	uint8_t isBeacon;
 	uint8_t roamed_vdev_id;
@@ -500,5 +500,47 @@ void lim_handle_sap_beacon(struct wlan_objmgr_pdev *pdev,
  */
 enum ani_akm_type lim_translate_rsn_oui_to_akm_type(uint8_t auth_suite[4]);
 
+#ifdef WLAN_FEATURE_PROBE_RSP_CACHE
+/**
+ * lim_get_probe_rsp_cache_stats() - get the probe response cache statistics
+ * @mac_ctx: Pointer to Global MAC structure
+ * @vdev_id: vdev id of the AP session
+ * @stats: statistics to fill
+ *
+ * Return: QDF_STATUS_SUCCESS on success, QDF_STATUS_E_INVAL if there is no
+ *	AP session on @vdev_id
+ */
+QDF_STATUS
+lim_get_probe_rsp_cache_stats(struct mac_context *mac_ctx, uint8_t vdev_id,
+			      struct sir_probe_rsp_cache_stats *stats);
+#else
+static inline QDF_STATUS
+lim_get_probe_rsp_cache_stats(struct mac_context *mac_ctx, uint8_t vdev_id,
+			      struct sir_probe_rsp_cache_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif
+
+#ifdef WLAN_FEATURE_PROBE_REQ_DEDUP
+/**
+ * lim_get_probe_req_dedup_stats() - get the probe request dedup statistics
+ * @mac_ctx: Pointer to Global MAC structure
+ * @stats: statistics to fill
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+lim_get_probe_req_dedup_stats(struct mac_context *mac_ctx,
+			      struct sir_probe_req_dedup_stats *stats);
+#else
+static inline QDF_STATUS
+lim_get_probe_req_dedup_stats(struct mac_context *mac_ctx,
+			      struct sir_probe_req_dedup_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif
+
 /************************************************************/
 #endif /* __LIM_API_H */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: lim_probe_req_dedup.h
+ *
+ * Deduplication of the probe requests handled by the host for SAP and
+ * P2P GO. A scanning station sends bursts of probe requests, retries
+ * included, which only need one answer. The probe requests from a source
+ * for an SSID on a channel, with or without a P2P IE, are let through at
+ * most once per window, before they are parsed or posted to PE.
+ */
+
+#ifndef __LIM_PROBE_REQ_DEDUP_H
+#define __LIM_PROBE_REQ_DEDUP_H
+
+#include <qdf_types.h>
+#include <qdf_lock.h>
+#include "sir_api.h"
+
+#ifdef WLAN_FEATURE_PROBE_REQ_DEDUP
+/* Number of probe request sources tracked at once */
+#define LIM_PROBE_REQ_DEDUP_ENTRIES 32
+
+/**
+ * struct lim_probe_req_dedup_entry - probe requests of a source
+ * @sa: source address
+ * @freq: channel the probe requests are received on
+ * @ssid_hash: hash of the requested SSID, wildcard included
+ * @p2p: the probe requests carry a P2P IE, which changes the response
+ * @start_ms: time the window of the source started
+ */
+struct lim_probe_req_dedup_entry {
+	tSirMacAddr sa;
+	qdf_freq_t freq;
+	uint32_t ssid_hash;
+	bool p2p;
+	uint32_t start_ms;
+};
+
+/**
+ * struct lim_probe_req_dedup - probe request deduplication table
+ * @lock: protects the table, probe requests are checked in RX context
+ * @window_ms: window duplicate probe requests are dropped over, 0 if the
+ *	deduplication is disabled
+ * @num_entries: number of entries in use
+ * @entries: sources seen recently
+ * @stats: statistics
+ */
+struct lim_probe_req_dedup {
+	qdf_spinlock_t lock;
+	uint32_t window_ms;
+	uint32_t num_entries;
+	struct lim_probe_req_dedup_entry entries[LIM_PROBE_REQ_DEDUP_ENTRIES];
+	struct sir_probe_req_dedup_stats stats;
+};
+
+/**
+ * lim_probe_req_dedup_init() - initialize a deduplication table
+ * @dedup: deduplication table
+ * @window_ms: window duplicate probe requests are dropped over, 0 to
+ *	disable the deduplication
+ *
+ * Return: None
+ */
+void lim_probe_req_dedup_init(struct lim_probe_req_dedup *dedup,
+			      uint32_t window_ms);
+
+/**
+ * lim_probe_req_dedup_deinit() - deinitialize a deduplication table
+ * @dedup: deduplication table
+ *
+ * Return: None
+ */
+void lim_probe_req_dedup_deinit(struct lim_probe_req_dedup *dedup);
+
+/**
+ * lim_probe_req_dedup_check() - check if a probe request is a duplicate
+ * @dedup: deduplication table
+ * @sa: source address of the probe request
+ * @body: body of the probe request, its IEs
+ * @body_len: length of @body
+ * @freq: channel the probe request is received on
+ * @now_ms: current time
+ *
+ * The first probe request of a source for an SSID on a channel starts a
+ * window, over which the following ones with the same P2P IE presence are
+ * duplicates. The window is not
+ * extended by the duplicates, so that a source retrying continuously is
+ * still answered once per window.
+ *
+ * Return: true if the probe request is to be dropped
+ */
+bool lim_probe_req_dedup_check(struct lim_probe_req_dedup *dedup,
+			       const uint8_t *sa, const uint8_t *body,
+			       uint32_t body_len, qdf_freq_t freq,
+			       uint32_t now_ms);
+
+/**
+ * lim_probe_req_dedup_drop() - count a probe request dropped as PE is busy
+ * @dedup: deduplication table
+ *
+ * Such probe requests are to be dropped before being checked, so that they
+ * do not start a window in which the retries of their source are dropped.
+ *
+ * Return: None
+ */
+void lim_probe_req_dedup_drop(struct lim_probe_req_dedup *dedup);
+
+/**
+ * lim_probe_req_dedup_get_stats() - get the deduplication statistics
+ * @dedup: deduplication table
+ * @stats: statistics to fill
+ *
+ * Return: None
+ */
+void lim_probe_req_dedup_get_stats(struct lim_probe_req_dedup *dedup,
+				   struct sir_probe_req_dedup_stats *stats);
+#endif /* WLAN_FEATURE_PROBE_REQ_DEDUP */
+#endif /* __LIM_PROBE_REQ_DEDUP_H */
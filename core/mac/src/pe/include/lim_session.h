@@ -117,6 +117,27 @@ struct obss_detection_cfg {
 	uint8_t obss_ht_20mhz_detect_mode;
 };
 
+#ifdef WLAN_FEATURE_PROBE_RSP_CACHE
+/**
+ * struct lim_probe_rsp_cache - probe response cached for an AP session
+ * @frame: packed probe response, MAC header included, NULL if none
+ * @len: length of @frame
+ * @preq_p2pie: @frame answers probe requests carrying a P2P IE
+ * @stats: cache statistics
+ *
+ * Only the destination address and the sequence number of @frame differ
+ * from one probe response to the next. @frame is dropped whenever the
+ * beacon, and so the probe response template given to the firmware, or the
+ * additional probe response IEs get updated.
+ */
+struct lim_probe_rsp_cache {
+	uint8_t *frame;
+	uint32_t len;
+	uint8_t preq_p2pie;
+	struct sir_probe_rsp_cache_stats stats;
+};
+#endif
+
 #define ADAPTIVE_11R_STA_IE_LEN   0x0B
 #define ADAPTIVE_11R_STA_OUI      "\x00\x00\x0f\x22"
 #define ADAPTIVE_11R_OUI_LEN      0x04
@@ -458,6 +479,9 @@ struct pe_session {
 	bool isCiscoVendorAP;
 
 	struct add_ie_params add_ie_params;
+#ifdef WLAN_FEATURE_PROBE_RSP_CACHE
+	struct lim_probe_rsp_cache probe_rsp_cache;
+#endif
 
 	uint8_t *pSchProbeRspTemplate;
 	/* Beginning portion of the beacon frame to be written to TFP */
@@ -742,7 +766,7 @@ void pe_delete_fils_info(struct pe_session *session);
  *
  * @mac_ctx: pointer to global mac context
  * @session: pointer to the PE session
- * @sap_channel: Operating Channel of the session for SAP sessions
+ * @sap_freq: Operating frequency of the session for SAP sessions
  *
  * Sets the beacon/probe filter in the global mac context to filter
  * and drop beacon/probe frames before posting it to PE queue
@@ -751,7 +775,7 @@ void pe_delete_fils_info(struct pe_session *session);
  */
 void lim_set_bcn_probe_filter(struct mac_context *mac_ctx,
 				struct pe_session *session,
-				uint8_t sap_channel);
+				qdf_freq_t sap_freq);
 
 /**
  * lim_reset_bcn_probe_filter - clear the beacon/probe filter in mac context
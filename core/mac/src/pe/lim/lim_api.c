@@ -868,6 +868,7 @@ QDF_STATUS pe_open(struct mac_context *mac, struct cds_config_info *cds_cfg)
 
 	pe_hang_event_notifier.priv_data = mac;
 	qdf_hang_event_register_notifier(&pe_hang_event_notifier);
+	pe_probe_req_dedup_init(mac);
 
 	return status; /* status here will be QDF_STATUS_SUCCESS */
 
@@ -897,6 +898,7 @@ QDF_STATUS pe_close(struct mac_context *mac)
 	if (ANI_DRIVER_TYPE(mac) == QDF_DRIVER_TYPE_MFG)
 		return QDF_STATUS_SUCCESS;
 
+	pe_probe_req_dedup_deinit(mac);
 	qdf_hang_event_unregister_notifier(&pe_hang_event_notifier);
 	lim_cleanup(mac);
 	lim_unregister_sap_bcn_callback(mac);
@@ -1153,8 +1155,111 @@ static bool pe_filter_bcn_probe_frame(struct mac_context *mac_ctx,
 	return false;
 }
 
+#ifdef WLAN_FEATURE_PROBE_REQ_DEDUP
+static void pe_probe_req_dedup_init(struct mac_context *mac_ctx)
+{
+	struct wlan_mlme_cfg_sap *sap_cfg = &mac_ctx->mlme_cfg->sap_cfg;
+
+	lim_probe_req_dedup_init(&mac_ctx->lim.probe_req_dedup,
+				 sap_cfg->probe_req_dedup_window);
+}
+
+static void pe_probe_req_dedup_deinit(struct mac_context *mac_ctx)
+{
+	lim_probe_req_dedup_deinit(&mac_ctx->lim.probe_req_dedup);
+}
+
+/**
+ * pe_is_ap_on_freq() - check if a SAP or P2P GO operates on a channel
+ * @mac_ctx: Pointer to Global MAC structure
+ * @freq: channel
+ *
+ * Checked from the RX path, so the SAP frequencies are read from the
+ * beacon/probe filter, kept up to date as AP sessions start, switch
+ * channel and stop, rather than from the PE session table.
+ *
+ * Return: true if an AP role session operates on @freq
+ */
+static bool pe_is_ap_on_freq(struct mac_context *mac_ctx, qdf_freq_t freq)
+{
+	struct mgmt_beacon_probe_filter *filter = &mac_ctx->bcn_filter;
+	uint8_t session_id;
+
+	if (!filter->num_sap_sessions || !freq)
+		return false;
+
+	for (session_id = 0; session_id < WLAN_MAX_VDEVS; session_id++) {
+		if (filter->sap_freq[session_id] == freq)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * pe_is_dup_probe_req() - check if a probe request is a duplicate
+ * @mac_ctx: Pointer to Global MAC structure
+ * @rx_pkt_info: RX packet info of the probe request
+ *
+ * Only the probe requests answered by a SAP or P2P GO are deduplicated,
+ * not the ones received by a scanning STA or a listening P2P device.
+ *
+ * Return: true if the probe request is to be dropped
+ */
+static bool pe_is_dup_probe_req(struct mac_context *mac_ctx,
+				uint8_t *rx_pkt_info)
+{
+	struct lim_probe_req_dedup *dedup = &mac_ctx->lim.probe_req_dedup;
+	tpSirMacMgmtHdr hdr = WMA_GET_RX_MAC_HEADER(rx_pkt_info);
+	qdf_freq_t freq = WMA_GET_RX_FREQ(rx_pkt_info);
+	uint32_t now_ms;
+
+	if (!dedup->window_ms || !pe_is_ap_on_freq(mac_ctx, freq))
+		return false;
+
+	now_ms = qdf_system_ticks_to_msecs(qdf_system_ticks());
+
+	return lim_probe_req_dedup_check(dedup, hdr->sa,
+					 WMA_GET_RX_MPDU_DATA(rx_pkt_info),
+					 WMA_GET_RX_PAYLOAD_LEN(rx_pkt_info),
+					 freq, now_ms);
+}
+
+static void pe_drop_probe_req(struct mac_context *mac_ctx)
+{
+	lim_probe_req_dedup_drop(&mac_ctx->lim.probe_req_dedup);
+}
+
+QDF_STATUS
+lim_get_probe_req_dedup_stats(struct mac_context *mac_ctx,
+			      struct sir_probe_req_dedup_stats *stats)
+{
+	lim_probe_req_dedup_get_stats(&mac_ctx->lim.probe_req_dedup, stats);
+
+	return QDF_STATUS_SUCCESS;
+}
+#else
+static inline void pe_probe_req_dedup_init(struct mac_context *mac_ctx)
+{
+}
+
+static inline void pe_probe_req_dedup_deinit(struct mac_context *mac_ctx)
+{
+}
+
+static inline bool pe_is_dup_probe_req(struct mac_context *mac_ctx,
+				       uint8_t *rx_pkt_info)
+{
+	return false;
+}
+
+static inline void pe_drop_probe_req(struct mac_context *mac_ctx)
+{
+}
+#endif /* WLAN_FEATURE_PROBE_REQ_DEDUP */
+
 static QDF_STATUS pe_handle_probe_req_frames(struct mac_context *mac_ctx,
-					cds_pkt_t *pkt)
+					cds_pkt_t *pkt, uint8_t *rx_pkt_info)
 {
 	QDF_STATUS status;
 	struct scheduler_msg msg = {0};
@@ -1166,9 +1271,16 @@ static QDF_STATUS pe_handle_probe_req_frames(struct mac_context *mac_ctx,
 	    scan_queue_size > MAX_BCN_PROBE_IN_SCAN_QUEUE) {
 		pe_debug_rl("Dropping probe req frame, queue size %d",
 			    scan_queue_size);
+		pe_drop_probe_req(mac_ctx);
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	/* A duplicate is dropped before it gets parsed or queued */
+	if (pe_is_dup_probe_req(mac_ctx, rx_pkt_info)) {
+		cds_pkt_return_packet(pkt);
+		return QDF_STATUS_SUCCESS;
+	}
+
 	/* Forward to MAC via mesg = SIR_BB_XPORT_MGMT_MSG */
 	msg.type = SIR_BB_XPORT_MGMT_MSG;
 	msg.bodyptr = pkt;
@@ -1267,7 +1379,8 @@ static QDF_STATUS pe_handle_mgmt_frame(struct wlan_objmgr_psoc *psoc,
 	 * Post Probe Req frames to Scan queue and return
 	 */
 	if (mHdr->fc.subType == SIR_MAC_MGMT_PROBE_REQ) {
-		qdf_status = pe_handle_probe_req_frames(mac, pVosPkt);
+		qdf_status = pe_handle_probe_req_frames(mac, pVosPkt,
+							pRxPacketInfo);
 		if (!QDF_IS_STATUS_SUCCESS(qdf_status)) {
 			cds_pkt_return_packet(pVosPkt);
 			pVosPkt = NULL;
@@ -1790,8 +1903,7 @@ static void pe_set_rmf_caps(struct mac_context *mac_ctx,
 	uint32_t status;
 	tSirMacRsnInfo rsn_ie;
 
-	assoc_body = (uint8_t *)roam_synch + roam_synch->reassoc_req_offset +
-			sizeof(tSirMacMgmtHdr);
+	assoc_body = roam_synch->reassoc_req + sizeof(tSirMacMgmtHdr);
 	len = roam_synch->reassoc_req_length - sizeof(tSirMacMgmtHdr);
 
 	assoc_req = qdf_mem_malloc(sizeof(*assoc_req));
@@ -1882,8 +1994,7 @@ lim_roam_gen_mbssid_beacon(struct mac_context *mac,
 	uint8_t ie_offset;
 
 	ie_offset = SIR_MAC_HDR_LEN_3A + SIR_MAC_B_PR_SSID_OFFSET;
-	bcn_prb_ptr = (uint8_t *)roam_ind +
-				roam_ind->beaconProbeRespOffset;
+	bcn_prb_ptr = roam_ind->bcn_probe_rsp;
 
 	rx_param.chan_freq = roam_ind->chan_freq;
 	rx_param.pdev_id = wlan_objmgr_pdev_get_pdev_id(mac->pdev);
@@ -1989,19 +2100,31 @@ error:
 	return status;
 }
 
+/**
+ * lim_roam_gen_beacon_descr() - parse the beacon/probe rsp of the roamed AP
+ * @mac: global mac context
+ * @roam_ind: roam synch indication
+ * @parsed_frm: parsed frame, filled by this API
+ * @ie: IEs of the roamed AP, filled by this API
+ * @ie_len: length of @ie, filled by this API
+ * @ie_alloc: set by this API if @ie is allocated and has to be freed by the
+ *	caller, otherwise @ie points into the frame of the roam synch indication
+ *
+ * Return: QDF_STATUS
+ */
 static QDF_STATUS
 lim_roam_gen_beacon_descr(struct mac_context *mac,
 			  struct roam_offload_synch_ind *roam_ind,
 			  tpSirProbeRespBeacon parsed_frm,
-			  uint8_t **ie, uint32_t *ie_len)
+			  uint8_t **ie, uint32_t *ie_len, bool *ie_alloc)
 {
 	QDF_STATUS status;
 	uint8_t *bcn_prb_ptr;
 	tpSirMacMgmtHdr mac_hdr;
 	uint8_t ie_offset;
 
-	bcn_prb_ptr = (uint8_t *)roam_ind +
-		roam_ind->beaconProbeRespOffset;
+	*ie_alloc = false;
+	bcn_prb_ptr = roam_ind->bcn_probe_rsp;
 	mac_hdr = (tpSirMacMgmtHdr)bcn_prb_ptr;
 	ie_offset = SIR_MAC_HDR_LEN_3A + SIR_MAC_B_PR_SSID_OFFSET;
 
@@ -2029,6 +2152,7 @@ lim_roam_gen_beacon_descr(struct mac_context *mac,
 			pe_err("failed to gen mbssid beacon");
 			return QDF_STATUS_E_FAILURE;
 		}
+		*ie_alloc = !!*ie;
 	} else {
 		if (roam_ind->isBeacon) {
 			if (sir_parse_beacon_ie(mac, parsed_frm,
@@ -2056,10 +2180,7 @@ lim_roam_gen_beacon_descr(struct mac_context *mac,
 		/* 24 byte MAC header and 12 byte to ssid IE */
 		if (roam_ind->beaconProbeRespLength > ie_offset) {
 			*ie_len = roam_ind->beaconProbeRespLength - ie_offset;
-			*ie = qdf_mem_malloc(*ie_len);
-			if (!*ie)
-				return QDF_STATUS_E_NOMEM;
-			qdf_mem_copy(*ie, bcn_prb_ptr + ie_offset, *ie_len);
+			*ie = bcn_prb_ptr + ie_offset;
 			pe_debug("beacon/probe Ie length: %d", *ie_len);
 		}
 	}
@@ -2085,9 +2206,9 @@ lim_roam_fill_bss_descr(struct mac_context *mac,
 	uint8_t *bcn_proberesp_ptr;
 	QDF_STATUS status;
 	uint8_t *ie = NULL;
+	bool ie_alloc = false;
 
-	bcn_proberesp_ptr = (uint8_t *)roam_synch_ind_ptr +
-		roam_synch_ind_ptr->beaconProbeRespOffset;
+	bcn_proberesp_ptr = roam_synch_ind_ptr->bcn_probe_rsp;
 	mac_hdr = (tpSirMacMgmtHdr)bcn_proberesp_ptr;
 	parsed_frm_ptr = qdf_mem_malloc(sizeof(tSirProbeRespBeacon));
 	if (!parsed_frm_ptr)
@@ -2108,7 +2229,7 @@ lim_roam_fill_bss_descr(struct mac_context *mac,
 	status = lim_roam_gen_beacon_descr(mac,
 					   roam_synch_ind_ptr,
 					   parsed_frm_ptr,
-					   &ie, &ie_len);
+					   &ie, &ie_len, &ie_alloc);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		pe_err("Failed to parse beacon");
 		qdf_mem_free(parsed_frm_ptr);
@@ -2179,11 +2300,11 @@ lim_roam_fill_bss_descr(struct mac_context *mac,
 	pe_debug("chan: %d rssi: %d ie_len %d",
 		 bss_desc_ptr->chan_freq,
 		 bss_desc_ptr->rssi, ie_len);
-	if (ie_len) {
+	if (ie_len)
 		qdf_mem_copy(&bss_desc_ptr->ieFields,
 			     ie, ie_len);
+	if (ie_alloc)
 		qdf_mem_free(ie);
-	}
 	qdf_mem_free(parsed_frm_ptr);
 	return QDF_STATUS_SUCCESS;
 }
@@ -2418,7 +2539,7 @@ lim_check_ft_initial_im_association(struct roam_offload_synch_ind *roam_synch,
 	tpSirMacMgmtHdr hdr;
 	uint8_t *assoc_req_ptr;
 
-	assoc_req_ptr = (uint8_t *) roam_synch + roam_synch->reassoc_req_offset;
+	assoc_req_ptr = roam_synch->reassoc_req;
 	hdr = (tpSirMacMgmtHdr) assoc_req_ptr;
 
 	if (hdr->fc.type == SIR_MAC_MGMT_FRAME &&
@@ -2577,8 +2698,7 @@ pe_roam_synch_callback(struct mac_context *mac_ctx,
 		curr_sta_ds->is_key_installed = true;
 	}
 
-	reassoc_resp = (uint8_t *)roam_sync_ind_ptr +
-			roam_sync_ind_ptr->reassocRespOffset;
+	reassoc_resp = roam_sync_ind_ptr->reassoc_rsp;
 	lim_process_assoc_rsp_frame(mac_ctx, reassoc_resp,
 				    roam_sync_ind_ptr->reassocRespLength,
 				    LIM_REASSOC, ft_session_ptr);
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: lim_probe_req_dedup.c
+ *
+ * Deduplication of the probe requests handled by the host
+ */
+
+#include <qdf_mem.h>
+#include <wlan_utility.h>
+#include "lim_probe_req_dedup.h"
+
+/* FNV-1a parameters */
+#define LIM_PROBE_REQ_HASH_BASIS 2166136261U
+#define LIM_PROBE_REQ_HASH_PRIME 16777619U
+
+/**
+ * lim_probe_req_ssid_hash() - hash the SSID of a probe request
+ * @body: body of the probe request
+ * @body_len: length of @body
+ *
+ * Only the SSID IE is looked up, the probe request is not parsed.
+ *
+ * Return: hash of the SSID, the one of the wildcard SSID if there is none
+ */
+static uint32_t lim_probe_req_ssid_hash(const uint8_t *body,
+					uint32_t body_len)
+{
+	uint32_t hash = LIM_PROBE_REQ_HASH_BASIS;
+	const uint8_t *ssid;
+	uint8_t i;
+
+	ssid = wlan_get_ie_ptr_from_eid(WLAN_ELEMID_SSID, body, body_len);
+	if (!ssid || ssid + 2 + ssid[1] > body + body_len)
+		return hash;
+
+	for (i = 0; i < ssid[1]; i++)
+		hash = (hash ^ ssid[2 + i]) * LIM_PROBE_REQ_HASH_PRIME;
+
+	return hash;
+}
+
+void lim_probe_req_dedup_init(struct lim_probe_req_dedup *dedup,
+			      uint32_t window_ms)
+{
+	qdf_mem_zero(dedup, sizeof(*dedup));
+	qdf_spinlock_create(&dedup->lock);
+	dedup->window_ms = window_ms;
+}
+
+void lim_probe_req_dedup_deinit(struct lim_probe_req_dedup *dedup)
+{
+	qdf_spinlock_destroy(&dedup->lock);
+}
+
+/**
+ * lim_probe_req_dedup_get_entry() - get the entry to track a source with
+ * @dedup: deduplication table
+ * @now_ms: current time
+ *
+ * Return: a free entry, else the one with the oldest window
+ */
+static struct lim_probe_req_dedup_entry *
+lim_probe_req_dedup_get_entry(struct lim_probe_req_dedup *dedup,
+			      uint32_t now_ms)
+{
+	struct lim_probe_req_dedup_entry *entry, *oldest;
+	uint32_t i;
+
+	if (dedup->num_entries < LIM_PROBE_REQ_DEDUP_ENTRIES)
+		return &dedup->entries[dedup->num_entries++];
+
+	oldest = &dedup->entries[0];
+	for (i = 1; i < dedup->num_entries; i++) {
+		entry = &dedup->entries[i];
+		if (now_ms - entry->start_ms > now_ms - oldest->start_ms)
+			oldest = entry;
+	}
+
+	return oldest;
+}
+
+bool lim_probe_req_dedup_check(struct lim_probe_req_dedup *dedup,
+			       const uint8_t *sa, const uint8_t *body,
+			       uint32_t body_len, qdf_freq_t freq,
+			       uint32_t now_ms)
+{
+	struct lim_probe_req_dedup_entry *entry = NULL;
+	uint32_t ssid_hash;
+	uint32_t i;
+	bool p2p;
+
+	if (!dedup->window_ms)
+		return false;
+
+	ssid_hash = lim_probe_req_ssid_hash(body, body_len);
+	p2p = !!wlan_get_vendor_ie_ptr_from_oui(SIR_MAC_P2P_OUI,
+						SIR_MAC_P2P_OUI_SIZE,
+						body, body_len);
+
+	qdf_spin_lock_bh(&dedup->lock);
+	for (i = 0; i < dedup->num_entries; i++) {
+		if (dedup->entries[i].ssid_hash == ssid_hash &&
+		    dedup->entries[i].freq == freq &&
+		    dedup->entries[i].p2p == p2p &&
+		    !qdf_mem_cmp(dedup->entries[i].sa, sa,
+				 sizeof(tSirMacAddr))) {
+			entry = &dedup->entries[i];
+			break;
+		}
+	}
+
+	if (entry && now_ms - entry->start_ms < dedup->window_ms) {
+		dedup->stats.coalesced++;
+		qdf_spin_unlock_bh(&dedup->lock);
+		return true;
+	}
+
+	if (!entry) {
+		entry = lim_probe_req_dedup_get_entry(dedup, now_ms);
+		qdf_mem_copy(entry->sa, sa, sizeof(tSirMacAddr));
+		entry->freq = freq;
+		entry->ssid_hash = ssid_hash;
+		entry->p2p = p2p;
+	}
+	entry->start_ms = now_ms;
+	dedup->stats.passed++;
+	qdf_spin_unlock_bh(&dedup->lock);
+
+	return false;
+}
+
+void lim_probe_req_dedup_drop(struct lim_probe_req_dedup *dedup)
+{
+	qdf_spin_lock_bh(&dedup->lock);
+	dedup->stats.dropped++;
+	qdf_spin_unlock_bh(&dedup->lock);
+}
+
+void lim_probe_req_dedup_get_stats(struct lim_probe_req_dedup *dedup,
+				   struct sir_probe_req_dedup_stats *stats)
+{
+	qdf_spin_lock_bh(&dedup->lock);
+	*stats = dedup->stats;
+	qdf_spin_unlock_bh(&dedup->lock);
+}
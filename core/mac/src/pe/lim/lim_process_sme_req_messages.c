@@ -573,7 +573,6 @@ __lim_handle_sme_start_bss_request(struct mac_context *mac_ctx, uint32_t *msg_bu
 {
 	uint16_t size;
 	uint32_t val = 0;
-	tSirMacChanNum channel_number;
 	tLimMlmStartReq *mlm_start_req = NULL;
 	struct start_bss_req *sme_start_bss_req = NULL;
 	tSirResultCodes ret_code = eSIR_SME_SUCCESS;
@@ -611,8 +610,6 @@ __lim_handle_sme_start_bss_request(struct mac_context *mac_ctx, uint32_t *msg_bu
 			ret_code = eSIR_SME_INVALID_PARAMETERS;
 			goto free;
 		}
-		channel_number = wlan_reg_freq_to_chan(mac_ctx->pdev,
-					sme_start_bss_req->oper_ch_freq);
 		/*
 		 * This is the place where PE is going to create a session.
 		 * If session is not existed, then create a new session
@@ -639,8 +636,9 @@ __lim_handle_sme_start_bss_request(struct mac_context *mac_ctx, uint32_t *msg_bu
 			}
 
 			/* Update the beacon/probe filter in mac_ctx */
-			lim_set_bcn_probe_filter(mac_ctx, session,
-						 channel_number);
+			lim_set_bcn_probe_filter(
+					mac_ctx, session,
+					sme_start_bss_req->oper_ch_freq);
 		}
 
 		if (QDF_NDI_MODE != sme_start_bss_req->bssPersona) {
@@ -1185,7 +1183,6 @@ __lim_process_sme_join_req(struct mac_context *mac_ctx, void *msg_buf)
 	tSirResultCodes ret_code = eSIR_SME_SUCCESS;
 	uint32_t val = 0;
 	uint8_t session_id;
-	uint8_t bss_chan_id;
 	struct pe_session *session = NULL;
 	uint8_t vdev_id = 0;
 	int8_t local_power_constraint = 0, reg_max = 0;
@@ -1245,8 +1242,6 @@ __lim_process_sme_join_req(struct mac_context *mac_ctx, void *msg_buf)
 		/* check for the existence of start BSS session  */
 		session = pe_find_session_by_bssid(mac_ctx, bss_desc->bssId,
 				&session_id);
-		bss_chan_id = wlan_reg_freq_to_chan(mac_ctx->pdev,
-						    bss_desc->chan_freq);
 
 		if (session) {
 			pe_err("Session(%d) Already exists for BSSID: "
@@ -1292,7 +1287,7 @@ __lim_process_sme_join_req(struct mac_context *mac_ctx, void *msg_buf)
 			}
 			/* Update the beacon/probe filter in mac_ctx */
 			lim_set_bcn_probe_filter(mac_ctx, session,
-						 bss_chan_id);
+						 bss_desc->chan_freq);
 		}
 		session->max_amsdu_num = sme_join_req->max_amsdu_num;
 		session->enable_session_twt_support =
@@ -2710,6 +2705,7 @@ __lim_handle_sme_stop_bss_request(struct mac_context *mac, uint32_t *msg_buf)
 	pe_session->stop_bss_reason = stop_bss_req.reasonCode;
 
 	if (!LIM_IS_NDI_ROLE(pe_session)) {
+		lim_probe_rsp_cache_invalidate(pe_session);
 		/* Free the buffer allocated in START_BSS_REQ */
 		qdf_mem_free(pe_session->add_ie_params.probeRespData_buff);
 		pe_session->add_ie_params.probeRespDataLen = 0;
@@ -5244,6 +5240,7 @@ static void lim_process_modify_add_ies(struct mac_context *mac_ctx,
 				modify_add_ies->updateType);
 		goto end;
 	}
+	lim_probe_rsp_cache_invalidate(session_entry);
 	add_ie_params = &session_entry->add_ie_params;
 	switch (modify_add_ies->updateType) {
 	case eUPDATE_IE_PROBE_RESP:
@@ -5312,6 +5309,7 @@ static void lim_process_update_add_ies(struct mac_context *mac_ctx,
 			 QDF_MAC_ADDR_REF(update_ie->bssid.bytes));
 		goto end;
 	}
+	lim_probe_rsp_cache_invalidate(session_entry);
 	addn_ie = &session_entry->add_ie_params;
 	/* if len is 0, upper layer requested freeing of buffer */
 	if (0 == update_ie->ieBufferlength) {
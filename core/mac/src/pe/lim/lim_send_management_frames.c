@@ -565,6 +565,144 @@ static void lim_add_additional_ie(uint8_t *frame, uint32_t frame_offset,
 	}
 }
 
+/**
+ * lim_get_probe_rsp_tx_flag() - get the TX flags of a probe response
+ * @pe_session: PE session
+ *
+ * Return: TX flags
+ */
+static uint8_t lim_get_probe_rsp_tx_flag(struct pe_session *pe_session)
+{
+	if (!wlan_reg_is_24ghz_ch_freq(pe_session->curr_op_freq) ||
+	    pe_session->opmode == QDF_P2P_CLIENT_MODE ||
+	    pe_session->opmode == QDF_P2P_GO_MODE)
+		return HAL_USE_BD_RATE2_FOR_MANAGEMENT_FRAME;
+
+	return 0;
+}
+
+#ifdef WLAN_FEATURE_PROBE_RSP_CACHE
+void lim_probe_rsp_cache_invalidate(struct pe_session *pe_session)
+{
+	struct lim_probe_rsp_cache *cache = &pe_session->probe_rsp_cache;
+
+	if (!cache->frame)
+		return;
+
+	qdf_mem_free(cache->frame);
+	cache->frame = NULL;
+	cache->len = 0;
+	cache->stats.invalidations++;
+}
+
+/**
+ * lim_probe_rsp_cache_update() - cache a built probe response
+ * @pe_session: PE session
+ * @frame: packed probe response, MAC header included
+ * @len: length of @frame
+ * @preq_p2pie: P2P IE in the probe request @frame answers
+ *
+ * Return: void
+ */
+static void lim_probe_rsp_cache_update(struct pe_session *pe_session,
+				       uint8_t *frame, uint32_t len,
+				       uint8_t preq_p2pie)
+{
+	struct lim_probe_rsp_cache *cache = &pe_session->probe_rsp_cache;
+
+	if (!LIM_IS_AP_ROLE(pe_session))
+		return;
+
+	lim_probe_rsp_cache_invalidate(pe_session);
+
+	cache->frame = qdf_mem_malloc(len);
+	if (!cache->frame)
+		return;
+
+	qdf_mem_copy(cache->frame, frame, len);
+	cache->len = len;
+	cache->preq_p2pie = preq_p2pie;
+	cache->stats.builds++;
+}
+
+/**
+ * lim_send_cached_probe_rsp() - send the cached probe response
+ * @mac_ctx: Pointer to Global MAC structure
+ * @peer_macaddr: Mac address of requesting peer
+ * @pe_session: PE session
+ * @preq_p2pie: P2P IE in incoming probe request
+ *
+ * Return: QDF_STATUS_SUCCESS if the cached probe response was sent,
+ *	QDF_STATUS_E_NOENT if it has to be built
+ */
+static QDF_STATUS lim_send_cached_probe_rsp(struct mac_context *mac_ctx,
+					    tSirMacAddr peer_macaddr,
+					    struct pe_session *pe_session,
+					    uint8_t preq_p2pie)
+{
+	struct lim_probe_rsp_cache *cache = &pe_session->probe_rsp_cache;
+	tpSirMacMgmtHdr mac_hdr;
+	uint8_t *frame;
+	void *packet;
+	QDF_STATUS qdf_status;
+
+	if (!LIM_IS_AP_ROLE(pe_session) || !cache->frame ||
+	    cache->preq_p2pie != preq_p2pie)
+		return QDF_STATUS_E_NOENT;
+
+	qdf_status = cds_packet_alloc((uint16_t)cache->len, (void **)&frame,
+				      (void **)&packet);
+	if (QDF_IS_STATUS_ERROR(qdf_status))
+		return QDF_STATUS_E_NOENT;
+
+	qdf_mem_copy(frame, cache->frame, cache->len);
+	mac_hdr = (tpSirMacMgmtHdr)frame;
+	qdf_mem_copy(mac_hdr->da, peer_macaddr, sizeof(tSirMacAddr));
+	lim_add_mgmt_seq_num(mac_ctx, mac_hdr);
+	cache->stats.hits++;
+
+	qdf_status = wma_tx_frame(mac_ctx, packet, (uint16_t)cache->len,
+				  TXRX_FRM_802_11_MGMT, ANI_TXDIR_TODS,
+				  7, lim_tx_complete, frame,
+				  lim_get_probe_rsp_tx_flag(pe_session),
+				  pe_session->vdev_id, 0, RATEID_DEFAULT, 0);
+	/* Pkt will be freed up by the callback */
+	if (QDF_IS_STATUS_ERROR(qdf_status))
+		pe_err("Could not send Probe Response");
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS
+lim_get_probe_rsp_cache_stats(struct mac_context *mac_ctx, uint8_t vdev_id,
+			      struct sir_probe_rsp_cache_stats *stats)
+{
+	struct pe_session *pe_session;
+
+	pe_session = pe_find_session_by_vdev_id(mac_ctx, vdev_id);
+	if (!pe_session || !LIM_IS_AP_ROLE(pe_session))
+		return QDF_STATUS_E_INVAL;
+
+	*stats = pe_session->probe_rsp_cache.stats;
+
+	return QDF_STATUS_SUCCESS;
+}
+#else
+static inline void lim_probe_rsp_cache_update(struct pe_session *pe_session,
+					      uint8_t *frame, uint32_t len,
+					      uint8_t preq_p2pie)
+{
+}
+
+static inline QDF_STATUS
+lim_send_cached_probe_rsp(struct mac_context *mac_ctx,
+			  tSirMacAddr peer_macaddr,
+			  struct pe_session *pe_session, uint8_t preq_p2pie)
+{
+	return QDF_STATUS_E_NOENT;
+}
+#endif /* WLAN_FEATURE_PROBE_RSP_CACHE */
+
 void
 lim_send_probe_rsp_mgmt_frame(struct mac_context *mac_ctx,
 			      tSirMacAddr peer_macaddr,
@@ -613,6 +751,13 @@ lim_send_probe_rsp_mgmt_frame(struct mac_context *mac_ctx,
 			  FL("CAC timer is running, probe response dropped"));
 		return;
 	}
+
+	if (QDF_IS_STATUS_SUCCESS(lim_send_cached_probe_rsp(mac_ctx,
+							    peer_macaddr,
+							    pe_session,
+							    preq_p2pie)))
+		return;
+
 	vdev_id = pe_session->vdev_id;
 	frm = qdf_mem_malloc(sizeof(tDot11fProbeResponse));
 	if (!frm)
@@ -863,10 +1008,12 @@ lim_send_probe_rsp_mgmt_frame(struct mac_context *mac_ctx,
 			      addn_ie_len, p2p_ie, noa_ie, total_noalen,
 			      noa_stream, noalen);
 
-	if (!wlan_reg_is_24ghz_ch_freq(pe_session->curr_op_freq) ||
-	    pe_session->opmode == QDF_P2P_CLIENT_MODE ||
-	    pe_session->opmode == QDF_P2P_GO_MODE)
-		tx_flag |= HAL_USE_BD_RATE2_FOR_MANAGEMENT_FRAME;
+	/* the NoA attribute changes without the beacon getting updated */
+	if (!p2p_ie)
+		lim_probe_rsp_cache_update(pe_session, frame, bytes,
+					   preq_p2pie);
+
+	tx_flag |= lim_get_probe_rsp_tx_flag(pe_session);
 
 	/* Queue Probe Response frame in high priority WQ */
 	qdf_status = wma_tx_frame(mac_ctx, packet,
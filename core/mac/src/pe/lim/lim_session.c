@@ -419,7 +419,7 @@ lim_get_peer_idxpool_size(uint16_t num_sta, enum bss_type bss_type)
 
 void lim_set_bcn_probe_filter(struct mac_context *mac_ctx,
 				struct pe_session *session,
-				uint8_t sap_channel)
+				qdf_freq_t sap_freq)
 {
 	struct mgmt_beacon_probe_filter *filter;
 	enum bss_type bss_type;
@@ -449,14 +449,16 @@ void lim_set_bcn_probe_filter(struct mac_context *mac_ctx,
 		pe_debug("Set filter for STA Session %d bssid "QDF_MAC_ADDR_FMT,
 			session_id, QDF_MAC_ADDR_REF(*bssid));
 	} else if (eSIR_INFRA_AP_MODE == bss_type) {
-		if (!sap_channel) {
+		if (!sap_freq) {
 			pe_err("SAP Type with invalid channel");
 			goto done;
 		}
 		filter->num_sap_sessions++;
-		filter->sap_channel[session_id] = sap_channel;
-		pe_debug("Set filter for SAP session %d channel %d",
-			session_id, sap_channel);
+		filter->sap_channel[session_id] =
+			wlan_reg_freq_to_chan(mac_ctx->pdev, sap_freq);
+		filter->sap_freq[session_id] = sap_freq;
+		pe_debug("Set filter for SAP session %d freq %d",
+			session_id, sap_freq);
 	}
 
 done:
@@ -497,6 +499,7 @@ void lim_reset_bcn_probe_filter(struct mac_context *mac_ctx,
 		if (filter->num_sap_sessions)
 			filter->num_sap_sessions--;
 		filter->sap_channel[session_id] = 0;
+		filter->sap_freq[session_id] = 0;
 		pe_debug("Cleared SAP Filter for session %d", session_id);
 	}
 
@@ -530,6 +533,7 @@ void lim_update_bcn_probe_filter(struct mac_context *mac_ctx,
 	if (eSIR_INFRA_AP_MODE == bss_type) {
 		filter->sap_channel[session_id] = wlan_reg_freq_to_chan(
 			mac_ctx->pdev, session->curr_op_freq);
+		filter->sap_freq[session_id] = session->curr_op_freq;
 		pe_debug("Updated SAP Filter for session %d channel %d",
 			session_id, filter->sap_channel[session_id]);
 	} else {
@@ -998,6 +1002,8 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 		session->pSchBeaconFrameEnd = NULL;
 	}
 
+	lim_probe_rsp_cache_invalidate(session);
+
 	/* Must free the buffer before peSession invalid */
 	if (session->add_ie_params.probeRespData_buff) {
 		qdf_mem_free(session->add_ie_params.probeRespData_buff);
@@ -570,6 +570,24 @@ lim_send_probe_rsp_mgmt_frame(struct mac_context *mac_ctx,
 			      struct pe_session *pe_session,
 			      uint8_t preq_p2pie);
 
+#ifdef WLAN_FEATURE_PROBE_RSP_CACHE
+/**
+ * lim_probe_rsp_cache_invalidate() - drop the cached probe response
+ * @pe_session: PE session
+ *
+ * To be called whenever the content of the probe response changes, the
+ * next probe response is then built from scratch.
+ *
+ * Return: void
+ */
+void lim_probe_rsp_cache_invalidate(struct pe_session *pe_session);
+#else
+static inline void
+lim_probe_rsp_cache_invalidate(struct pe_session *pe_session)
+{
+}
+#endif
+
 void lim_send_auth_mgmt_frame(struct mac_context *, tSirMacAuthFrameBody *, tSirMacAddr,
 			      uint8_t, struct pe_session *);
 void lim_send_assoc_req_mgmt_frame(struct mac_context *, tLimMlmAssocReq *, struct pe_session *);
@@ -249,6 +249,9 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 	bool extcap_present = true, addnie_present = false;
 	bool is_6ghz_chsw;
 
+	/* the probe response follows the beacon */
+	lim_probe_rsp_cache_invalidate(session);
+
 	bcn_1 = qdf_mem_malloc(sizeof(tDot11fBeacon1));
 	if (!bcn_1)
 		return QDF_STATUS_E_NOMEM;
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "cds_test_util.h"
+#include "qdf_mem.h"
+#include "qdf_str.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "wlan_cmn_ieee80211.h"
+#include "lim_probe_req_dedup.h"
+#include "lim_probe_req_dedup_test.h"
+
+#define dedup_test_err(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_PE, QDF_TRACE_LEVEL_ERROR, fmt, ##args)
+#define dedup_test_info(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_PE, QDF_TRACE_LEVEL_INFO_HIGH, fmt, ##args)
+
+/* Window the replays are deduplicated over */
+#define DEDUP_TEST_WINDOW_MS 100
+/* Stations of the replayed probe storm, all tracked by the table */
+#define DEDUP_TEST_STORM_STA 16
+/* Length of the replayed probe storm */
+#define DEDUP_TEST_STORM_MS 2000
+/* Largest probe request body built by the test */
+#define DEDUP_TEST_BODY_LEN 64
+
+/**
+ * struct dedup_test_probe - a probe request of a replay
+ * @time_ms: reception time
+ * @sta: last byte of the source address
+ * @ssid: requested SSID, "" for the wildcard SSID
+ * @freq: channel the probe request is received on
+ * @dup: the probe request is expected to be dropped
+ */
+struct dedup_test_probe {
+	uint32_t time_ms;
+	uint8_t sta;
+	const char *ssid;
+	qdf_freq_t freq;
+	bool dup;
+};
+
+/* A scan of two stations, with retries, on the channel of two APs */
+static const struct dedup_test_probe dedup_test_capture[] = {
+	{ 0, 1, "", 2437, false },
+	{ 2, 1, "", 2437, true },
+	{ 3, 1, "venue", 2437, false },
+	{ 5, 1, "venue", 2437, true },
+	{ 6, 2, "", 2437, false },
+	{ 8, 2, "", 2437, true },
+	{ 10, 1, "", 5180, false },
+	{ 11, 1, "", 5180, true },
+	{ 60, 1, "", 2437, true },
+	{ 99, 1, "", 2437, true },
+	{ 100, 1, "", 2437, false },
+	{ 101, 1, "venue", 2437, true },
+	{ 103, 1, "venue", 2437, false },
+	{ 150, 1, "", 2437, true },
+	{ 150, 2, "", 2437, false },
+	{ 200, 1, "", 2437, false },
+	{ 200, 2, "", 2437, true },
+	{ 250, 1, "venue2", 2437, false },
+};
+
+static uint32_t dedup_test_build(uint8_t *body, const char *ssid)
+{
+	static const uint8_t rates[] = { 1, 4, 0x82, 0x84, 0x8b, 0x96 };
+	uint32_t ssid_len = qdf_str_len(ssid);
+
+	body[0] = WLAN_ELEMID_SSID;
+	body[1] = ssid_len;
+	qdf_mem_copy(&body[2], ssid, ssid_len);
+	qdf_mem_copy(&body[2 + ssid_len], rates, sizeof(rates));
+
+	return 2 + ssid_len + sizeof(rates);
+}
+
+static bool dedup_test_probe_p2p(struct lim_probe_req_dedup *dedup,
+				 uint8_t sta, const char *ssid,
+				 qdf_freq_t freq, uint32_t time_ms, bool p2p)
+{
+	static const uint8_t p2p_ie[] = {
+		WLAN_ELEMID_VENDOR, 4, 0x50, 0x6f, 0x9a, 0x09
+	};
+	tSirMacAddr sa = { 0x02, 0x00, 0x00, 0x00, 0x00, sta };
+	uint8_t body[DEDUP_TEST_BODY_LEN];
+	uint32_t body_len = dedup_test_build(body, ssid);
+
+	if (p2p) {
+		qdf_mem_copy(&body[body_len], p2p_ie, sizeof(p2p_ie));
+		body_len += sizeof(p2p_ie);
+	}
+
+	return lim_probe_req_dedup_check(dedup, sa, body, body_len, freq,
+					 time_ms);
+}
+
+static bool dedup_test_probe(struct lim_probe_req_dedup *dedup,
+			     uint8_t sta, const char *ssid, qdf_freq_t freq,
+			     uint32_t time_ms)
+{
+	return dedup_test_probe_p2p(dedup, sta, ssid, freq, time_ms, false);
+}
+
+static uint32_t dedup_test_capture_replay(void)
+{
+	const struct dedup_test_probe *probe;
+	struct lim_probe_req_dedup dedup;
+	struct sir_probe_req_dedup_stats stats;
+	uint32_t errors = 0;
+	uint32_t coalesced = 0;
+	uint32_t i;
+
+	lim_probe_req_dedup_init(&dedup, DEDUP_TEST_WINDOW_MS);
+	for (i = 0; i < QDF_ARRAY_SIZE(dedup_test_capture); i++) {
+		probe = &dedup_test_capture[i];
+		if (probe->dup)
+			coalesced++;
+		if (dedup_test_probe(&dedup, probe->sta, probe->ssid,
+				     probe->freq, probe->time_ms) ==
+		    probe->dup)
+			continue;
+
+		dedup_test_err("FAIL: probe %d from sta %d at %d ms %s",
+			       i, probe->sta, probe->time_ms,
+			       probe->dup ? "passed" : "dropped");
+		errors++;
+	}
+
+	lim_probe_req_dedup_get_stats(&dedup, &stats);
+	if (stats.coalesced != coalesced ||
+	    stats.passed != QDF_ARRAY_SIZE(dedup_test_capture) - coalesced) {
+		dedup_test_err("FAIL: passed %d coalesced %d",
+			       stats.passed, stats.coalesced);
+		errors++;
+	}
+	lim_probe_req_dedup_deinit(&dedup);
+
+	return errors;
+}
+
+static uint32_t dedup_test_disabled(void)
+{
+	struct lim_probe_req_dedup dedup;
+	struct sir_probe_req_dedup_stats stats;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	lim_probe_req_dedup_init(&dedup, 0);
+	for (i = 0; i < 8; i++) {
+		if (dedup_test_probe(&dedup, 1, "", 2437, i)) {
+			dedup_test_err("FAIL: probe dropped while disabled");
+			errors++;
+		}
+	}
+
+	/* nothing but the drops is counted while disabled */
+	lim_probe_req_dedup_drop(&dedup);
+	lim_probe_req_dedup_get_stats(&dedup, &stats);
+	if (stats.passed || stats.coalesced || stats.dropped != 1) {
+		dedup_test_err("FAIL: passed %d coalesced %d dropped %d",
+			       stats.passed, stats.coalesced, stats.dropped);
+		errors++;
+	}
+	lim_probe_req_dedup_deinit(&dedup);
+
+	return errors;
+}
+
+static uint32_t dedup_test_p2p(void)
+{
+	struct lim_probe_req_dedup dedup;
+	uint32_t errors = 0;
+
+	/* a P2P IE changes the response, so it is not a duplicate */
+	lim_probe_req_dedup_init(&dedup, DEDUP_TEST_WINDOW_MS);
+	dedup_test_probe_p2p(&dedup, 1, "", 2437, 0, false);
+	if (dedup_test_probe_p2p(&dedup, 1, "", 2437, 1, true)) {
+		dedup_test_err("FAIL: probe with P2P IE dropped");
+		errors++;
+	}
+	if (!dedup_test_probe_p2p(&dedup, 1, "", 2437, 2, true)) {
+		dedup_test_err("FAIL: duplicate probe with P2P IE passed");
+		errors++;
+	}
+	if (!dedup_test_probe_p2p(&dedup, 1, "", 2437, 3, false)) {
+		dedup_test_err("FAIL: duplicate probe without P2P IE passed");
+		errors++;
+	}
+	lim_probe_req_dedup_deinit(&dedup);
+
+	return errors;
+}
+
+static uint32_t dedup_test_eviction(void)
+{
+	struct lim_probe_req_dedup dedup;
+	uint32_t errors = 0;
+	uint8_t sta;
+
+	/* one source more than the table holds, each a ms apart */
+	lim_probe_req_dedup_init(&dedup, DEDUP_TEST_WINDOW_MS);
+	for (sta = 0; sta <= LIM_PROBE_REQ_DEDUP_ENTRIES; sta++)
+		dedup_test_probe(&dedup, sta, "", 2437, sta);
+
+	/* the oldest source got evicted, the others are still tracked */
+	if (dedup_test_probe(&dedup, 0, "", 2437, 50)) {
+		dedup_test_err("FAIL: evicted source dropped");
+		errors++;
+	}
+	if (!dedup_test_probe(&dedup, LIM_PROBE_REQ_DEDUP_ENTRIES, "", 2437,
+			      50)) {
+		dedup_test_err("FAIL: latest source passed");
+		errors++;
+	}
+	lim_probe_req_dedup_deinit(&dedup);
+
+	/* the time wrapping around does not extend a window */
+	lim_probe_req_dedup_init(&dedup, DEDUP_TEST_WINDOW_MS);
+	dedup_test_probe(&dedup, 1, "", 2437, U32_MAX - 10);
+	if (!dedup_test_probe(&dedup, 1, "", 2437, 20)) {
+		dedup_test_err("FAIL: probe passed across time wrap");
+		errors++;
+	}
+	if (dedup_test_probe(&dedup, 1, "", 2437, 90)) {
+		dedup_test_err("FAIL: probe dropped across time wrap");
+		errors++;
+	}
+	lim_probe_req_dedup_deinit(&dedup);
+
+	return errors;
+}
+
+/**
+ * dedup_test_storm_replay() - replay a probe storm
+ *
+ * Stations scan continuously, each sending a burst of probe requests,
+ * retries included, for the wildcard and the venue SSID every few ms. The
+ * probe requests let through have to match those of a reference keeping
+ * the start of the window of every source.
+ *
+ * Return: number of failed test cases
+ */
+static uint32_t dedup_test_storm_replay(void)
+{
+	static const char * const ssids[] = { "", "venue" };
+	struct lim_probe_req_dedup dedup;
+	struct sir_probe_req_dedup_stats stats;
+	uint32_t ref_start[DEDUP_TEST_STORM_STA][QDF_ARRAY_SIZE(ssids)];
+	bool ref_seen[DEDUP_TEST_STORM_STA][QDF_ARRAY_SIZE(ssids)] = { };
+	uint32_t seed = 3;
+	uint32_t errors = 0;
+	uint32_t total = 0, ref_passed = 0;
+	uint32_t time_ms, burst;
+	uint8_t sta, ssid;
+	bool dup, ref_dup;
+
+	lim_probe_req_dedup_init(&dedup, DEDUP_TEST_WINDOW_MS);
+	for (time_ms = 0; time_ms < DEDUP_TEST_STORM_MS; time_ms++) {
+		for (sta = 0; sta < DEDUP_TEST_STORM_STA; sta++) {
+			if (cds_test_rand(&seed) % 8)
+				continue;
+
+			ssid = cds_test_rand(&seed) % QDF_ARRAY_SIZE(ssids);
+			for (burst = 0; burst < 2; burst++) {
+				dup = dedup_test_probe(&dedup, sta,
+						       ssids[ssid], 2437,
+						       time_ms);
+				ref_dup = ref_seen[sta][ssid] &&
+					  time_ms - ref_start[sta][ssid] <
+					  DEDUP_TEST_WINDOW_MS;
+				if (!ref_dup) {
+					ref_seen[sta][ssid] = true;
+					ref_start[sta][ssid] = time_ms;
+					ref_passed++;
+				}
+				total++;
+				if (dup == ref_dup)
+					continue;
+
+				dedup_test_err("FAIL: sta %d at %d ms %s",
+					       sta, time_ms,
+					       dup ? "dropped" : "passed");
+				errors++;
+				goto deinit;
+			}
+		}
+	}
+
+	lim_probe_req_dedup_get_stats(&dedup, &stats);
+	if (stats.passed != ref_passed ||
+	    stats.coalesced != total - ref_passed) {
+		dedup_test_err("FAIL: passed %d coalesced %d, expected %d %d",
+			       stats.passed, stats.coalesced, ref_passed,
+			       total - ref_passed);
+		errors++;
+	}
+
+	dedup_test_info("%d probe requests over %d ms: %d passed, %d coalesced",
+			total, DEDUP_TEST_STORM_MS, stats.passed,
+			stats.coalesced);
+
+deinit:
+	lim_probe_req_dedup_deinit(&dedup);
+
+	return errors;
+}
+
+uint32_t lim_probe_req_dedup_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += dedup_test_capture_replay();
+	errors += dedup_test_disabled();
+	errors += dedup_test_p2p();
+	errors += dedup_test_eviction();
+	errors += dedup_test_storm_replay();
+
+	return errors;
+}
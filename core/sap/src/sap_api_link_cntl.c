@@ -208,6 +208,15 @@ wlansap_calculate_chan_from_scan_result(mac_handle_t mac_handle,
 	qdf_list_t *list = NULL;
 	struct scan_filter *filter;
 	uint32_t oper_channel = SAP_CHANNEL_NOT_SELECTED;
+	QDF_STATUS status;
+
+	/* the channels scored while the ACS scan ran only need a final pass */
+	status = sap_acs_stream_select_channel(mac_handle, sap_ctx, scan_id,
+					       &oper_channel);
+	if (QDF_IS_STATUS_SUCCESS(status)) {
+		wlansap_send_acs_success_event(sap_ctx, scan_id);
+		return oper_channel;
+	}
 
 	filter = qdf_mem_malloc(sizeof(*filter));
 
@@ -360,6 +369,7 @@ QDF_STATUS wlansap_pre_start_bss_acs_scan_callback(mac_handle_t mac_handle,
 	sap_ctx->sap_state = eSAP_ACS_CHANNEL_SELECTED;
 	sap_ctx->sap_status = eSAP_STATUS_SUCCESS;
 close_session:
+	sap_acs_stream_stop(sap_ctx);
 #ifdef SOFTAP_CHANNEL_RANGE
 	if (sap_ctx->freq_list) {
 		/*
@@ -1272,10 +1282,13 @@ void sap_scan_event_callback(struct wlan_objmgr_vdev *vdev,
 	qdf_mtrace(QDF_MODULE_ID_SCAN, QDF_MODULE_ID_SAP, event->type,
 		   event->vdev_id, event->scan_id);
 
-	if (!util_is_scan_completed(event, &success))
+	if (!util_is_scan_completed(event, &success)) {
+		sap_acs_stream_scan_event(mac_handle, arg, event);
 		return;
+	}
 
-	if (success)
+	/* a scan stopped early by the streamed ACS has what it needs */
+	if (success || sap_acs_stream_is_stopped(arg, scan_id))
 		scan_status = eCSR_SCAN_SUCCESS;
 
 	wlansap_pre_start_bss_acs_scan_callback(mac_handle,
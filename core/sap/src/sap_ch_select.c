@@ -49,6 +49,7 @@
 #include "pld_common.h"
 #include "wlan_reg_services_api.h"
 #include <wlan_scan_utils_api.h>
+#include <wlan_scan_ucfg_api.h>
 
 /*--------------------------------------------------------------------------
    Function definitions
@@ -264,6 +265,66 @@ sap_check_n_add_overlapped_chnls(struct sap_context *sap_ctx,
 		return true;
 }
 
+/**
+ * sap_process_avoid_ie_entry() - processes the Q2Q IE of a scan result
+ * @mac_ctx:            mac context
+ * @sap_ctx:            sap context.
+ * @cur_node:           scan result
+ * @spect_info:         spectrum weights array to update
+ *
+ * Return: void
+ */
+static void
+sap_process_avoid_ie_entry(struct mac_context *mac_ctx,
+			   struct sap_context *sap_ctx,
+			   struct scan_cache_node *cur_node,
+			   tSapChSelSpectInfo *spect_info)
+{
+	const uint8_t *temp_ptr = NULL;
+	struct sAvoidChannelIE *avoid_ch_ie;
+	tSapSpectChInfo *spect_ch = NULL;
+	uint32_t chan_freq;
+
+	temp_ptr = wlan_get_vendor_ie_ptr_from_oui(
+			SIR_MAC_QCOM_VENDOR_OUI,
+			SIR_MAC_QCOM_VENDOR_SIZE,
+			util_scan_entry_ie_data(cur_node->entry),
+			util_scan_entry_ie_len(cur_node->entry));
+	if (!temp_ptr)
+		return;
+
+	avoid_ch_ie = (struct sAvoidChannelIE *)temp_ptr;
+	if (avoid_ch_ie->type != QCOM_VENDOR_IE_MCC_AVOID_CH)
+		return;
+
+	sap_ctx->sap_detected_avoid_ch_ie.present = 1;
+
+	chan_freq = wlan_reg_legacy_chan_to_freq(mac_ctx->pdev,
+						 avoid_ch_ie->channel);
+
+	sap_debug("Q2Q-IE avoid freq = %d", chan_freq);
+	/* add this channel to to_avoid channel list */
+	sap_check_n_add_channel(sap_ctx, avoid_ch_ie->channel);
+	sap_check_n_add_overlapped_chnls(sap_ctx, avoid_ch_ie->channel);
+	/*
+	 * Mark weight of these channel present in IE to MAX
+	 * so that ACS logic will to avoid thse channels
+	 */
+	spect_ch = sap_acs_get_spect_ch(spect_info, chan_freq);
+	if (spect_ch) {
+		/*
+		 * weight is set more than max so that,
+		 * in the case of other channels being
+		 * assigned max weight due to noise,
+		 * they may be preferred over channels
+		 * with Q2Q IE.
+		 */
+		spect_ch->avoid = true;
+		spect_ch->weight = SAP_ACS_WEIGHT_MAX + 1;
+		spect_ch->weight_copy = SAP_ACS_WEIGHT_MAX + 1;
+	}
+}
+
 /**
  * sap_process_avoid_ie() - processes the detected Q2Q IE
  * context's avoid_channels_info struct
@@ -284,17 +345,9 @@ static void
 sap_process_avoid_ie(mac_handle_t mac_handle, struct sap_context *sap_ctx,
 		     qdf_list_t *scan_list, tSapChSelSpectInfo *spect_info)
 {
-	const uint8_t *temp_ptr = NULL;
-	uint8_t i = 0;
-	struct sAvoidChannelIE *avoid_ch_ie;
-	struct mac_context *mac_ctx = NULL;
-	tSapSpectChInfo *spect_ch = NULL;
+	struct mac_context *mac_ctx = MAC_CONTEXT(mac_handle);
 	qdf_list_node_t *cur_lst = NULL, *next_lst = NULL;
 	struct scan_cache_node *cur_node = NULL;
-	uint32_t chan_freq;
-
-	mac_ctx = MAC_CONTEXT(mac_handle);
-	spect_ch = spect_info->pSpectCh;
 
 	if (scan_list)
 		qdf_list_peek_front(scan_list, &cur_lst);
@@ -303,60 +356,22 @@ sap_process_avoid_ie(mac_handle_t mac_handle, struct sap_context *sap_ctx,
 		cur_node = qdf_container_of(cur_lst, struct scan_cache_node,
 					    node);
 
-		temp_ptr = wlan_get_vendor_ie_ptr_from_oui(
-				SIR_MAC_QCOM_VENDOR_OUI,
-				SIR_MAC_QCOM_VENDOR_SIZE,
-				util_scan_entry_ie_data(cur_node->entry),
-				util_scan_entry_ie_len(cur_node->entry));
-
-		if (temp_ptr) {
-			avoid_ch_ie = (struct sAvoidChannelIE *)temp_ptr;
-			if (avoid_ch_ie->type !=
-					QCOM_VENDOR_IE_MCC_AVOID_CH) {
-				qdf_list_peek_next(scan_list,
-						   cur_lst, &next_lst);
-				cur_lst = next_lst;
-				next_lst = NULL;
-				continue;
-			}
-
-			sap_ctx->sap_detected_avoid_ch_ie.present = 1;
-
-			chan_freq =
-			    wlan_reg_legacy_chan_to_freq(mac_ctx->pdev,
-							 avoid_ch_ie->channel);
-
-			sap_debug("Q2Q-IE avoid freq = %d", chan_freq);
-			/* add this channel to to_avoid channel list */
-			sap_check_n_add_channel(sap_ctx, avoid_ch_ie->channel);
-			sap_check_n_add_overlapped_chnls(sap_ctx,
-							 avoid_ch_ie->channel);
-			/*
-			 * Mark weight of these channel present in IE to MAX
-			 * so that ACS logic will to avoid thse channels
-			 */
-			for (i = 0; i < spect_info->numSpectChans; i++) {
-				if (spect_ch[i].chan_freq != chan_freq)
-					continue;
-				/*
-				 * weight is set more than max so that,
-				 * in the case of other channels being
-				 * assigned max weight due to noise,
-				 * they may be preferred over channels
-				 * with Q2Q IE.
-				 */
-				spect_ch[i].weight = SAP_ACS_WEIGHT_MAX + 1;
-				spect_ch[i].weight_copy =
-							SAP_ACS_WEIGHT_MAX + 1;
-				break;
-			}
-		}
+		sap_process_avoid_ie_entry(mac_ctx, sap_ctx, cur_node,
+					   spect_info);
 
 		qdf_list_peek_next(scan_list, cur_lst, &next_lst);
 		cur_lst = next_lst;
 		next_lst = NULL;
 	}
 }
+#else
+static inline void
+sap_process_avoid_ie_entry(struct mac_context *mac_ctx,
+			   struct sap_context *sap_ctx,
+			   struct scan_cache_node *cur_node,
+			   tSapChSelSpectInfo *spect_info)
+{
+}
 #endif /* FEATURE_AP_MCC_CH_AVOIDANCE */
 
 /**
@@ -393,6 +408,186 @@ uint32_t sap_select_preferred_channel_from_channel_list(uint32_t best_ch_freq,
 	return SAP_CHANNEL_NOT_SELECTED;
 }
 
+bool sap_acs_spect_info_alloc(tSapChSelSpectInfo *spect_info,
+			      uint8_t num_chans)
+{
+	spect_info->numSpectChans = num_chans;
+	spect_info->pSpectCh = qdf_mem_malloc(num_chans *
+					      sizeof(*spect_info->pSpectCh));
+	spect_info->freq_idx = qdf_mem_malloc(SAP_ACS_FREQ_IDX_SIZE *
+					      sizeof(*spect_info->freq_idx));
+	spect_info->sorted_idx =
+		qdf_mem_malloc(num_chans * sizeof(*spect_info->sorted_idx));
+	spect_info->sort_buf = qdf_mem_malloc(num_chans *
+					      sizeof(*spect_info->sort_buf));
+	if (!spect_info->pSpectCh || !spect_info->freq_idx ||
+	    !spect_info->sorted_idx || !spect_info->sort_buf) {
+		sap_acs_spect_info_free(spect_info);
+		return false;
+	}
+
+	return true;
+}
+
+void sap_acs_spect_info_free(tSapChSelSpectInfo *spect_info)
+{
+	qdf_mem_free(spect_info->pSpectCh);
+	spect_info->pSpectCh = NULL;
+	qdf_mem_free(spect_info->freq_idx);
+	spect_info->freq_idx = NULL;
+	qdf_mem_free(spect_info->sorted_idx);
+	spect_info->sorted_idx = NULL;
+	qdf_mem_free(spect_info->sort_buf);
+	spect_info->sort_buf = NULL;
+	spect_info->numSpectChans = 0;
+}
+
+/**
+ * sap_acs_freq_slot() - get the frequency index slot of a frequency
+ * @chan_freq: frequency
+ *
+ * Channels are 5 MHz apart, but for channel 14, so that every channel of
+ * the range gets its own slot.
+ *
+ * Return: slot of @chan_freq, SAP_ACS_FREQ_IDX_SIZE if out of range
+ */
+static inline uint32_t sap_acs_freq_slot(uint32_t chan_freq)
+{
+	if (chan_freq < SAP_ACS_FREQ_IDX_START ||
+	    chan_freq > SAP_ACS_FREQ_IDX_END)
+		return SAP_ACS_FREQ_IDX_SIZE;
+
+	return (chan_freq - SAP_ACS_FREQ_IDX_START + 2) / 5;
+}
+
+void sap_acs_build_freq_idx(tSapChSelSpectInfo *spect_info)
+{
+	uint32_t slot;
+	uint8_t i;
+
+	qdf_mem_zero(spect_info->freq_idx,
+		     SAP_ACS_FREQ_IDX_SIZE * sizeof(*spect_info->freq_idx));
+
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		slot = sap_acs_freq_slot(spect_info->pSpectCh[i].chan_freq);
+		if (slot < SAP_ACS_FREQ_IDX_SIZE)
+			spect_info->freq_idx[slot] = i + 1;
+	}
+}
+
+tSapSpectChInfo *sap_acs_get_spect_ch(tSapChSelSpectInfo *spect_info,
+				      uint32_t chan_freq)
+{
+	tSapSpectChInfo *spect_ch;
+	uint32_t slot = sap_acs_freq_slot(chan_freq);
+
+	if (slot >= SAP_ACS_FREQ_IDX_SIZE || !spect_info->freq_idx[slot])
+		return NULL;
+
+	spect_ch = &spect_info->pSpectCh[spect_info->freq_idx[slot] - 1];
+	if (spect_ch->chan_freq != chan_freq)
+		return NULL;
+
+	return spect_ch;
+}
+
+/**
+ * sap_acs_ch_less() - check if a channel ranks before another one
+ * @spect_ch: spectrum table
+ * @a: index of the first channel
+ * @b: index of the second channel
+ *
+ * Return: true if @a has less weight, or as much weight and less BSSs
+ */
+static inline bool sap_acs_ch_less(tSapSpectChInfo *spect_ch,
+				   uint16_t a, uint16_t b)
+{
+	if (spect_ch[a].weight != spect_ch[b].weight)
+		return spect_ch[a].weight < spect_ch[b].weight;
+
+	return spect_ch[a].bssCount < spect_ch[b].bssCount;
+}
+
+void sap_sort_chl_weight(tSapChSelSpectInfo *pSpectInfoParams)
+{
+	tSapSpectChInfo *spect_ch = pSpectInfoParams->pSpectCh;
+	uint16_t *idx = pSpectInfoParams->sorted_idx;
+	uint16_t *buf = pSpectInfoParams->sort_buf;
+	uint16_t *tmp;
+	uint32_t num = pSpectInfoParams->numSpectChans;
+	uint32_t width, start, mid, end, left, right, i;
+
+	for (i = 0; i < num; i++)
+		idx[i] = i;
+
+	/* bottom up merge sort, stable so that ties keep the spectrum order */
+	for (width = 1; width < num; width *= 2) {
+		for (start = 0; start < num; start += 2 * width) {
+			mid = qdf_min(start + width, num);
+			end = qdf_min(start + 2 * width, num);
+			left = start;
+			right = mid;
+			for (i = start; i < end; i++) {
+				if (left < mid &&
+				    (right >= end ||
+				     !sap_acs_ch_less(spect_ch, idx[right],
+						      idx[left])))
+					buf[i] = idx[left++];
+				else
+					buf[i] = idx[right++];
+			}
+		}
+		tmp = idx;
+		idx = buf;
+		buf = tmp;
+	}
+
+	pSpectInfoParams->sorted_idx = idx;
+	pSpectInfoParams->sort_buf = buf;
+}
+
+tSapSpectChInfo *sap_acs_aggregate_bonded_ch(tSapChSelSpectInfo *spect_info,
+					     uint32_t start_freq,
+					     uint8_t num_ch,
+					     uint32_t max_weight)
+{
+	tSapSpectChInfo *group[SAP_ACS_MAX_BONDED_CH];
+	tSapSpectChInfo *best = NULL;
+	uint32_t combined_weight = 0;
+	bool complete = true;
+	uint8_t i;
+
+	if (num_ch > SAP_ACS_MAX_BONDED_CH)
+		return NULL;
+
+	for (i = 0; i < num_ch; i++) {
+		group[i] = sap_acs_get_spect_ch(spect_info,
+						start_freq + 20 * i);
+		if (!group[i]) {
+			complete = false;
+			continue;
+		}
+
+		combined_weight += group[i]->weight;
+		if (!best || group[i]->weight < best->weight)
+			best = group[i];
+	}
+
+	for (i = 0; i < num_ch; i++) {
+		if (!group[i])
+			continue;
+		group[i]->weight = max_weight;
+		group[i]->weight_calc_done = true;
+	}
+
+	if (!complete)
+		return NULL;
+
+	best->weight = combined_weight;
+
+	return best;
+}
+
 /**
  * sap_chan_sel_init() - Initialize channel select
  * @mac_handle: Opaque handle to the global MAC context
@@ -415,17 +610,12 @@ static bool sap_chan_sel_init(mac_handle_t mac_handle,
 	bool include_dfs_ch = true;
 	uint8_t sta_sap_scc_on_dfs_chnl_config_value;
 
-	pSpectInfoParams->numSpectChans =
-		mac->scan.base_channels.numChannels;
-
 	/* Allocate memory for weight computation of 2.4GHz */
-	pSpectCh = qdf_mem_malloc((pSpectInfoParams->numSpectChans) *
-			sizeof(*pSpectCh));
-	if (!pSpectCh)
+	if (!sap_acs_spect_info_alloc(pSpectInfoParams,
+				      mac->scan.base_channels.numChannels))
 		return false;
 
-	/* Initialize the pointers in the DfsParams to the allocated memory */
-	pSpectInfoParams->pSpectCh = pSpectCh;
+	pSpectCh = pSpectInfoParams->pSpectCh;
 
 	pChans = mac->scan.base_channels.channel_freq_list;
 
@@ -500,6 +690,8 @@ static bool sap_chan_sel_init(mac_handle_t mac_handle,
 		pSpectCh->weight = 0;
 	}
 
+	sap_acs_build_freq_idx(pSpectInfoParams);
+
 	return true;
 }
 
@@ -1252,211 +1444,240 @@ sap_upd_chan_spec_params(struct scan_cache_node *scan_entry,
 }
 
 /**
- * sap_compute_spect_weight() - Compute spectrum weight
+ * sap_add_scan_entry() - account a scan result in the spectrum
  * @pSpectInfoParams: Pointer to the tSpectInfoParams structure
- * @mac_handle: Opaque handle to the global MAC context
- * @pResult: Pointer to tScanResultHandle
- * @sap_ctx: Context of the SAP
+ * @cur_node: scan result
  *
- * Main function for computing the weight of each channel in the
- * spectrum based on the RSSI value of the BSSes on the channel
- * and number of BSS
+ * Updates the RSSI and BSS count of the channel of the scan result, and
+ * those of the channels it interferes with.
+ *
+ * Return: none
  */
-static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
-				     mac_handle_t mac_handle,
-				     qdf_list_t *scan_list,
-				     struct sap_context *sap_ctx)
+static void sap_add_scan_entry(tSapChSelSpectInfo *pSpectInfoParams,
+			       struct scan_cache_node *cur_node)
 {
-	int8_t rssi = 0;
-	uint8_t chn_num = 0;
-	tSapSpectChInfo *pSpectCh = pSpectInfoParams->pSpectCh;
+	tSapSpectChInfo *pSpectCh;
 	tSirMacHTChannelWidth ch_width = 0;
 	uint16_t secondaryChannelOffset;
 	uint32_t center_freq0, center_freq1;
-	uint8_t i;
-	bool found;
-	struct mac_context *mac = MAC_CONTEXT(mac_handle);
 	tSapSpectChInfo *spectch_start = pSpectInfoParams->pSpectCh;
 	tSapSpectChInfo *spectch_end = pSpectInfoParams->pSpectCh +
 		pSpectInfoParams->numSpectChans;
-	qdf_list_node_t *cur_lst = NULL, *next_lst = NULL;
-	struct scan_cache_node *cur_node = NULL;
-	uint32_t normalized_weight;
-	uint8_t normalize_factor;
 	uint32_t chan_freq;
-	struct acs_weight *weight_list =
-				mac->mlme_cfg->acs.normalize_weight_chan;
-	struct acs_weight_range *range_list =
-				mac->mlme_cfg->acs.normalize_weight_range;
-	bool freq_present_in_list = false;
 
-	sap_debug("Computing spectral weight");
+	/* Defining the default values, so that any value will hold the default values */
 
-	if (scan_list)
-		qdf_list_peek_front(scan_list, &cur_lst);
-	while (cur_lst) {
-		cur_node = qdf_container_of(cur_lst, struct scan_cache_node,
-					    node);
-		pSpectCh = pSpectInfoParams->pSpectCh;
-		/* Defining the default values, so that any value will hold the default values */
+	secondaryChannelOffset = PHY_SINGLE_CHANNEL_CENTERED;
+	center_freq0 = 0;
+	center_freq1 = 0;
 
-		secondaryChannelOffset = PHY_SINGLE_CHANNEL_CENTERED;
-		center_freq0 = 0;
-		center_freq1 = 0;
+	chan_freq = util_scan_entry_channel_frequency(cur_node->entry);
 
-		chan_freq =
-		    util_scan_entry_channel_frequency(cur_node->entry);
+	sap_upd_chan_spec_params(cur_node, &ch_width,
+				 &secondaryChannelOffset,
+				 &center_freq0, &center_freq1);
 
-		sap_upd_chan_spec_params(cur_node, &ch_width,
-					 &secondaryChannelOffset,
-					 &center_freq0, &center_freq1);
+	pSpectCh = sap_acs_get_spect_ch(pSpectInfoParams, chan_freq);
+	if (!pSpectCh)
+		return;
 
-		/* Processing for each tCsrScanResultInfo in the tCsrScanResult DLink list */
-		for (chn_num = 0; chn_num < pSpectInfoParams->numSpectChans;
-		     chn_num++) {
+	if (pSpectCh->rssiAgr < cur_node->entry->rssi_raw)
+		pSpectCh->rssiAgr = cur_node->entry->rssi_raw;
 
-			if (chan_freq != pSpectCh->chan_freq) {
-				pSpectCh++;
-				continue;
-			}
+	++pSpectCh->bssCount;
 
-			if (pSpectCh->rssiAgr < cur_node->entry->rssi_raw)
-				pSpectCh->rssiAgr = cur_node->entry->rssi_raw;
+	if (WLAN_REG_IS_24GHZ_CH_FREQ(chan_freq))
+		sap_interference_rssi_count(pSpectCh,
+			spectch_start, spectch_end);
+	else
+		sap_interference_rssi_count_5G(
+		    pSpectCh, ch_width, secondaryChannelOffset,
+		    center_freq0, center_freq1, chan_freq,
+		    spectch_start, spectch_end);
+}
 
-			++pSpectCh->bssCount;
+/**
+ * sap_compute_ch_weight() - Compute the weight of a channel
+ * @mac: Pointer to mac_context
+ * @sap_ctx: Context of the SAP
+ * @pSpectCh: channel
+ *
+ * The weight is computed from the RSSI and BSS count accounted so far and
+ * from the channel status, if any. It can be computed again as more scan
+ * results get accounted.
+ *
+ * Return: none
+ */
+static void sap_compute_ch_weight(struct mac_context *mac,
+				  struct sap_context *sap_ctx,
+				  tSapSpectChInfo *pSpectCh)
+{
+	int8_t rssi = 0;
+	uint8_t i;
+	bool found;
+	uint32_t normalized_weight;
+	uint8_t normalize_factor = 0;
+	uint32_t chan_freq;
+	struct acs_weight *weight_list =
+				mac->mlme_cfg->acs.normalize_weight_chan;
+	struct acs_weight_range *range_list =
+				mac->mlme_cfg->acs.normalize_weight_range;
+	bool freq_present_in_list = false;
 
-			if (WLAN_REG_IS_24GHZ_CH_FREQ(chan_freq))
-				sap_interference_rssi_count(pSpectCh,
-					spectch_start, spectch_end);
-			else
-				sap_interference_rssi_count_5G(
-				    pSpectCh, ch_width, secondaryChannelOffset,
-				    center_freq0, center_freq1, chan_freq,
-				    spectch_start, spectch_end);
+	/*
+	   rssi : Maximum received signal strength among all BSS on that channel
+	   bssCount : Number of BSS on that channel
+	 */
 
-			pSpectCh++;
-			break;
+	rssi = (int8_t) pSpectCh->rssiAgr;
+	if (ch_in_pcl(sap_ctx, pSpectCh->chan_freq))
+		rssi -= PCL_RSSI_DISCOUNT;
 
-		}
+	if (rssi < SOFTAP_MIN_RSSI)
+		rssi = SOFTAP_MIN_RSSI;
 
-		qdf_list_peek_next(scan_list, cur_lst, &next_lst);
-		cur_lst = next_lst;
-		next_lst = NULL;
+	if (!pSpectCh->valid) {
+		pSpectCh->weight = SAP_ACS_WEIGHT_MAX;
+		pSpectCh->weight_copy = pSpectCh->weight;
+		goto debug_info;
 	}
 
-	/* Calculate the weights for all channels in the spectrum pSpectCh */
-	pSpectCh = pSpectInfoParams->pSpectCh;
-
-	for (chn_num = 0; chn_num < (pSpectInfoParams->numSpectChans);
-	     chn_num++) {
-
-		/*
-		   rssi : Maximum received signal strength among all BSS on that channel
-		   bssCount : Number of BSS on that channel
-		 */
+	if (pSpectCh->avoid) {
+		pSpectCh->weight = SAP_ACS_WEIGHT_MAX + 1;
+		pSpectCh->weight_copy = pSpectCh->weight;
+		goto debug_info;
+	}
 
-		rssi = (int8_t) pSpectCh->rssiAgr;
-		if (ch_in_pcl(sap_ctx, pSpectCh->chan_freq))
-			rssi -= PCL_RSSI_DISCOUNT;
+	/* There may be channels in scanlist, which were not sent to
+	 * FW for scanning as part of ACS scan list, but they do have an
+	 * effect on the neighbouring channels, so they help to find a
+	 * suitable channel, but there weight should be max as they were
+	 * and not meant to be included in the ACS scan results.
+	 * So just assign RSSI as -100, bsscount as 0, and weight as max
+	 * to them, so that they always stay low in sorting of best
+	 * channles which were included in ACS scan list
+	 */
+	found = false;
+	for (i = 0; i < sap_ctx->num_of_channel; i++) {
+		if (pSpectCh->chan_freq == sap_ctx->freq_list[i]) {
+		/* Scan channel was included in ACS scan list */
+			found = true;
+			break;
+		}
+	}
 
-		if (rssi < SOFTAP_MIN_RSSI)
-			rssi = SOFTAP_MIN_RSSI;
+	if (found)
+		pSpectCh->weight =
+			SAPDFS_NORMALISE_1000 *
+			(sapweight_rssi_count(sap_ctx, rssi,
+			pSpectCh->bssCount) + sap_weight_channel_status(
+			sap_ctx, sap_get_channel_status(mac,
+						 pSpectCh->chan_freq)));
+	else {
+		pSpectCh->weight = SAP_ACS_WEIGHT_MAX;
+		pSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
+		rssi = SOFTAP_MIN_RSSI;
+		pSpectCh->bssCount = SOFTAP_MIN_COUNT;
+	}
 
-		if (pSpectCh->weight == SAP_ACS_WEIGHT_MAX) {
-			pSpectCh->weight_copy = pSpectCh->weight;
-			goto debug_info;
-		}
+	chan_freq = pSpectCh->chan_freq;
 
-		/* There may be channels in scanlist, which were not sent to
-		 * FW for scanning as part of ACS scan list, but they do have an
-		 * effect on the neighbouring channels, so they help to find a
-		 * suitable channel, but there weight should be max as they were
-		 * and not meant to be included in the ACS scan results.
-		 * So just assign RSSI as -100, bsscount as 0, and weight as max
-		 * to them, so that they always stay low in sorting of best
-		 * channles which were included in ACS scan list
-		 */
-		found = false;
-		for (i = 0; i < sap_ctx->num_of_channel; i++) {
-			if (pSpectCh->chan_freq == sap_ctx->freq_list[i]) {
-			/* Scan channel was included in ACS scan list */
-				found = true;
-				break;
-			}
-		}
+	if (wlan_reg_is_dfs_for_freq(mac->pdev, chan_freq)) {
+		normalize_factor =
+			MLME_GET_DFS_CHAN_WEIGHT(
+			mac->mlme_cfg->acs.np_chan_weightage);
+		freq_present_in_list = true;
+		sap_debug_rl("DFS channel weightage %d",
+			     normalize_factor);
+	}
 
-		if (found)
-			pSpectCh->weight =
-				SAPDFS_NORMALISE_1000 *
-				(sapweight_rssi_count(sap_ctx, rssi,
-				pSpectCh->bssCount) + sap_weight_channel_status(
-				sap_ctx, sap_get_channel_status(mac,
-							 pSpectCh->chan_freq)));
-		else {
-			pSpectCh->weight = SAP_ACS_WEIGHT_MAX;
-			pSpectCh->rssiAgr = SOFTAP_MIN_RSSI;
-			rssi = SOFTAP_MIN_RSSI;
-			pSpectCh->bssCount = SOFTAP_MIN_COUNT;
+	/* Check if the freq is present in range list */
+	for (i = 0; i < mac->mlme_cfg->acs.num_weight_range; i++) {
+		if (chan_freq >= range_list[i].start_freq &&
+		    chan_freq <= range_list[i].end_freq) {
+			normalize_factor =
+				range_list[i].normalize_weight;
+			sap_debug("Range list, freq %d normalize weight factor %d",
+				  chan_freq, normalize_factor);
+			freq_present_in_list = true;
 		}
+	}
 
-		chan_freq = pSpectCh->chan_freq;
+	/* Check if user wants a special factor for this freq */
 
-		if (wlan_reg_is_dfs_for_freq(mac->pdev, chan_freq)) {
+	for (i = 0; i < mac->mlme_cfg->acs.normalize_weight_num_chan;
+	     i++) {
+		if (chan_freq == weight_list[i].chan_freq) {
 			normalize_factor =
-				MLME_GET_DFS_CHAN_WEIGHT(
-				mac->mlme_cfg->acs.np_chan_weightage);
+				weight_list[i].normalize_weight;
+			sap_debug("freq %d normalize weight factor %d",
+				  chan_freq, normalize_factor);
 			freq_present_in_list = true;
-			sap_debug_rl("DFS channel weightage %d",
-				     normalize_factor);
 		}
+	}
 
-		/* Check if the freq is present in range list */
-		for (i = 0; i < mac->mlme_cfg->acs.num_weight_range; i++) {
-			if (chan_freq >= range_list[i].start_freq &&
-			    chan_freq <= range_list[i].end_freq) {
-				normalize_factor =
-					range_list[i].normalize_weight;
-				sap_debug("Range list, freq %d normalize weight factor %d",
-					  chan_freq, normalize_factor);
-				freq_present_in_list = true;
-			}
-		}
+	if (freq_present_in_list) {
+		normalized_weight =
+			((SAP_ACS_WEIGHT_MAX - pSpectCh->weight) *
+			(100 - normalize_factor)) / 100;
+		sap_debug("freq %d old weight %d new weight %d",
+			  chan_freq, pSpectCh->weight,
+			  pSpectCh->weight + normalized_weight);
+		pSpectCh->weight += normalized_weight;
+	}
 
-		/* Check if user wants a special factor for this freq */
+	if (pSpectCh->weight > SAP_ACS_WEIGHT_MAX)
+		pSpectCh->weight = SAP_ACS_WEIGHT_MAX;
+	pSpectCh->weight_copy = pSpectCh->weight;
 
-		for (i = 0; i < mac->mlme_cfg->acs.normalize_weight_num_chan;
-		     i++) {
-			if (chan_freq == weight_list[i].chan_freq) {
-				normalize_factor =
-					weight_list[i].normalize_weight;
-				sap_debug("freq %d normalize weight factor %d",
-					  chan_freq, normalize_factor);
-				freq_present_in_list = true;
-			}
-		}
+debug_info:
+	sap_debug("freq = %d, weight = %d rssi = %d bss count = %d",
+		   pSpectCh->chan_freq, pSpectCh->weight,
+		  pSpectCh->rssiAgr, pSpectCh->bssCount);
+}
 
-		if (freq_present_in_list) {
-			normalized_weight =
-				((SAP_ACS_WEIGHT_MAX - pSpectCh->weight) *
-				(100 - normalize_factor)) / 100;
-			sap_debug("freq %d old weight %d new weight %d",
-				  chan_freq, pSpectCh->weight,
-				  pSpectCh->weight + normalized_weight);
-			pSpectCh->weight += normalized_weight;
-			freq_present_in_list = false;
-		}
+/**
+ * sap_compute_spect_weight() - Compute spectrum weight
+ * @pSpectInfoParams: Pointer to the tSpectInfoParams structure
+ * @mac_handle: Opaque handle to the global MAC context
+ * @pResult: Pointer to tScanResultHandle
+ * @sap_ctx: Context of the SAP
+ *
+ * Main function for computing the weight of each channel in the
+ * spectrum based on the RSSI value of the BSSes on the channel
+ * and number of BSS
+ */
+static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
+				     mac_handle_t mac_handle,
+				     qdf_list_t *scan_list,
+				     struct sap_context *sap_ctx)
+{
+	uint8_t chn_num = 0;
+	struct mac_context *mac = MAC_CONTEXT(mac_handle);
+	qdf_list_node_t *cur_lst = NULL, *next_lst = NULL;
+	struct scan_cache_node *cur_node = NULL;
 
-		if (pSpectCh->weight > SAP_ACS_WEIGHT_MAX)
-			pSpectCh->weight = SAP_ACS_WEIGHT_MAX;
-		pSpectCh->weight_copy = pSpectCh->weight;
+	sap_debug("Computing spectral weight");
 
-debug_info:
-		sap_debug("freq = %d, weight = %d rssi = %d bss count = %d",
-			   pSpectCh->chan_freq, pSpectCh->weight,
-			  pSpectCh->rssiAgr, pSpectCh->bssCount);
+	if (scan_list)
+		qdf_list_peek_front(scan_list, &cur_lst);
+	while (cur_lst) {
+		cur_node = qdf_container_of(cur_lst, struct scan_cache_node,
+					    node);
+		/* Processing for each tCsrScanResultInfo in the tCsrScanResult DLink list */
+		sap_add_scan_entry(pSpectInfoParams, cur_node);
 
-		pSpectCh++;
+		qdf_list_peek_next(scan_list, cur_lst, &next_lst);
+		cur_lst = next_lst;
+		next_lst = NULL;
 	}
+
+	/* Calculate the weights for all channels in the spectrum pSpectCh */
+	for (chn_num = 0; chn_num < (pSpectInfoParams->numSpectChans);
+	     chn_num++)
+		sap_compute_ch_weight(mac, sap_ctx,
+				      &pSpectInfoParams->pSpectCh[chn_num]);
+
 	sap_clear_channel_status(mac);
 }
 
@@ -1483,350 +1704,95 @@ debug_info:
 static void sap_chan_sel_exit(tSapChSelSpectInfo *pSpectInfoParams)
 {
 	/* Free all the allocated memory */
-	qdf_mem_free(pSpectInfoParams->pSpectCh);
-}
-
-/*==========================================================================
-   FUNCTION    sap_sort_chl_weight
-
-   DESCRIPTION
-    Function to sort the channels with the least weight first for 20MHz channels
-
-   DEPENDENCIES
-    NA.
-
-   PARAMETERS
-
-    IN
-    pSpectInfoParams       : Pointer to the tSapChSelSpectInfo structure
-
-   RETURN VALUE
-    void     : NULL
-
-   SIDE EFFECTS
-   ============================================================================*/
-static void sap_sort_chl_weight(tSapChSelSpectInfo *pSpectInfoParams)
-{
-	tSapSpectChInfo temp;
-
-	tSapSpectChInfo *pSpectCh = NULL;
-	uint32_t i = 0, j = 0, minWeightIndex = 0;
-
-	pSpectCh = pSpectInfoParams->pSpectCh;
-	for (i = 0; i < pSpectInfoParams->numSpectChans; i++) {
-		minWeightIndex = i;
-		for (j = i + 1; j < pSpectInfoParams->numSpectChans; j++) {
-			if (pSpectCh[j].weight <
-			    pSpectCh[minWeightIndex].weight) {
-				minWeightIndex = j;
-			} else if (pSpectCh[j].weight ==
-				   pSpectCh[minWeightIndex].weight) {
-				if (pSpectCh[j].bssCount <
-				    pSpectCh[minWeightIndex].bssCount)
-					minWeightIndex = j;
-			}
-		}
-		if (minWeightIndex != i) {
-			qdf_mem_copy(&temp, &pSpectCh[minWeightIndex],
-				     sizeof(*pSpectCh));
-			qdf_mem_copy(&pSpectCh[minWeightIndex], &pSpectCh[i],
-				     sizeof(*pSpectCh));
-			qdf_mem_copy(&pSpectCh[i], &temp, sizeof(*pSpectCh));
-		}
-	}
+	sap_acs_spect_info_free(pSpectInfoParams);
 }
 
 /**
- * sap_sort_chl_weight_80_mhz() - to sort the channels with the least weight
+ * sap_sort_chl_weight_bonded() - to sort the channels with the least weight
+ * @mac_ctx: Pointer to mac_context
  * @pSpectInfoParams: Pointer to the tSapChSelSpectInfo structure
- * Function to sort the channels with the least weight first for HT80 channels
+ * @ch_width: bandwidth of the bonded channels, 40 MHz and wider
+ *
+ * Function to sort the channels with the least weight first for 40, 80 and
+ * 160 MHz channels. The weights of each group of bonded channels are
+ * combined on the channel of the group with the least weight, in a single
+ * pass over the spectrum.
  *
  * Return: none
  */
-static void sap_sort_chl_weight_80_mhz(struct mac_context *mac_ctx,
-				       tSapChSelSpectInfo *pSpectInfoParams)
+static void sap_sort_chl_weight_bonded(struct mac_context *mac_ctx,
+				       tSapChSelSpectInfo *pSpectInfoParams,
+				       enum phy_ch_width ch_width)
 {
-	uint8_t i, j;
+	uint8_t j;
 	tSapSpectChInfo *pSpectInfo;
-	uint8_t minIdx;
+	tSapSpectChInfo *best;
 	struct ch_params acs_ch_params;
-	int8_t center_freq_diff;
-	uint32_t combined_weight;
-	uint32_t min_ch_weight;
-
-	pSpectInfo = pSpectInfoParams->pSpectCh;
+	uint32_t center_freq;
+	uint32_t max_weight;
+	uint8_t num_ch;
 
-	for (j = 0; j < pSpectInfoParams->numSpectChans; j++) {
-
-		if (pSpectInfo[j].weight_calc_done)
-			continue;
-
-		acs_ch_params.ch_width = CH_WIDTH_80MHZ;
-
-		wlan_reg_set_channel_params_for_freq(mac_ctx->pdev,
-						     pSpectInfo[j].chan_freq,
-						     0, &acs_ch_params);
-
-		/* Check if the freq supports 80 Mhz */
-		if (acs_ch_params.ch_width != CH_WIDTH_80MHZ) {
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 4;
-			pSpectInfo[j].weight_calc_done = true;
-			continue;
-		}
-
-		center_freq_diff = acs_ch_params.mhz_freq_seg0 -
-				   pSpectInfo[j].chan_freq;
-
-		/* This channel frequency does not have all channels */
-		if (center_freq_diff != 30) {
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 4;
-			pSpectInfo[j].weight_calc_done = true;
-			continue;
-		}
-
-		/* no other freq left for 80 Mhz operation in spectrum */
-		if (j + 3 > pSpectInfoParams->numSpectChans)
-			continue;
-
-		/* Check whether all frequencies are present for 80 Mhz */
-
-		if (!(((pSpectInfo[j].chan_freq + 20) ==
-			pSpectInfo[j + 1].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 40) ==
-				 pSpectInfo[j + 2].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 60) ==
-				 pSpectInfo[j + 3].chan_freq))) {
-			/*
-			 * some channels does not exist in pSectInfo array,
-			 * skip this channel and those in the same HT80 width
-			 */
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 4;
-			pSpectInfo[j].weight_calc_done = true;
-			if ((pSpectInfo[j].chan_freq + 20) ==
-					pSpectInfo[j + 1].chan_freq) {
-				pSpectInfo[j + 1].weight =
-					SAP_ACS_WEIGHT_MAX * 4;
-				pSpectInfo[j +1].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 40) ==
-					pSpectInfo[j + 2].chan_freq) {
-				pSpectInfo[j + 2].weight =
-					SAP_ACS_WEIGHT_MAX * 4;
-				pSpectInfo[j +2].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 60) ==
-					pSpectInfo[j + 3].chan_freq) {
-				pSpectInfo[j + 3].weight =
-					SAP_ACS_WEIGHT_MAX * 4;
-				pSpectInfo[j +3].weight_calc_done = true;
-			}
-
-			continue;
-		}
-
-		/* We have 4 channels to calculate cumulative weight */
-
-		combined_weight = pSpectInfo[j].weight +
-				  pSpectInfo[j + 1].weight +
-				  pSpectInfo[j + 2].weight +
-				  pSpectInfo[j + 3].weight;
-
-		min_ch_weight = pSpectInfo[j].weight;
-		minIdx = 0;
-
-		for (i = 0; i < 4; i++) {
-			if (min_ch_weight > pSpectInfo[j + i].weight) {
-				min_ch_weight = pSpectInfo[j + i].weight;
-				minIdx = i;
-			}
-			pSpectInfo[j + i].weight = SAP_ACS_WEIGHT_MAX * 4;
-			pSpectInfo[j + i].weight_calc_done = true;
-		}
-
-		pSpectInfo[j + minIdx].weight = combined_weight;
-
-		sap_debug("best freq = %d for 80mhz center freq %d combined weight = %d",
-			  pSpectInfo[j + minIdx].chan_freq,
-			  acs_ch_params.mhz_freq_seg0,
-			  combined_weight);
-	}
-
-	sap_sort_chl_weight(pSpectInfoParams);
-
-	pSpectInfo = pSpectInfoParams->pSpectCh;
-
-	for (j = 0; j < (pSpectInfoParams->numSpectChans); j++) {
-		sap_debug("freq = %d weight = %d rssi = %d bss count = %d",
-			  pSpectInfo->chan_freq, pSpectInfo->weight,
-			  pSpectInfo->rssiAgr, pSpectInfo->bssCount);
-
-		pSpectInfo++;
+	switch (ch_width) {
+	case CH_WIDTH_40MHZ:
+		num_ch = 2;
+		break;
+	case CH_WIDTH_160MHZ:
+		num_ch = 8;
+		break;
+	default:
+		num_ch = 4;
+		break;
 	}
-}
-
-/**
- * sap_sort_chl_weight_vht160() - to sort the channels with the least weight
- * @pSpectInfoParams: Pointer to the tSapChSelSpectInfo structure
- *
- * Function to sort the channels with the least weight first for VHT160 channels
- *
- * Return: none
- */
-static void sap_sort_chl_weight_160_mhz(struct mac_context *mac_ctx,
-					tSapChSelSpectInfo *pSpectInfoParams)
-{
-	uint8_t i, j;
-	tSapSpectChInfo *pSpectInfo;
-	uint8_t minIdx;
-	struct ch_params acs_ch_params;
-	int8_t center_freq_diff;
-	uint32_t combined_weight;
-	uint32_t min_ch_weight;
+	max_weight = SAP_ACS_WEIGHT_MAX * num_ch;
 
 	pSpectInfo = pSpectInfoParams->pSpectCh;
 
 	for (j = 0; j < pSpectInfoParams->numSpectChans; j++) {
+		if (ch_width == CH_WIDTH_40MHZ &&
+		    WLAN_REG_IS_24GHZ_CH_FREQ(pSpectInfo[j].chan_freq))
+			continue;
 
 		if (pSpectInfo[j].weight_calc_done)
 			continue;
 
-		acs_ch_params.ch_width = CH_WIDTH_160MHZ;
+		acs_ch_params.ch_width = ch_width;
 
 		wlan_reg_set_channel_params_for_freq(mac_ctx->pdev,
 						     pSpectInfo[j].chan_freq,
 						     0, &acs_ch_params);
 
-		/* Check if the freq supports 160 Mhz */
-		if (acs_ch_params.ch_width != CH_WIDTH_160MHZ) {
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 8;
+		/* Check if the freq supports the bandwidth */
+		if (acs_ch_params.ch_width != ch_width) {
+			pSpectInfo[j].weight = max_weight;
 			pSpectInfo[j].weight_calc_done = true;
 			continue;
 		}
 
-		center_freq_diff = acs_ch_params.mhz_freq_seg1 -
-				   pSpectInfo[j].chan_freq;
+		if (ch_width == CH_WIDTH_160MHZ)
+			center_freq = acs_ch_params.mhz_freq_seg1;
+		else
+			center_freq = acs_ch_params.mhz_freq_seg0;
 
-		/* This channel frequency does not have all channels */
-		if (center_freq_diff != 70) {
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 8;
+		/* Only the lowest channel of a group starts the group */
+		if (center_freq !=
+		    pSpectInfo[j].chan_freq + (num_ch - 1) * 10) {
+			pSpectInfo[j].weight = max_weight;
 			pSpectInfo[j].weight_calc_done = true;
 			continue;
 		}
 
-		/* no other freq left for 160 Mhz operation in spectrum */
-		if (j + 7 > pSpectInfoParams->numSpectChans)
+		best = sap_acs_aggregate_bonded_ch(pSpectInfoParams,
+						   pSpectInfo[j].chan_freq,
+						   num_ch, max_weight);
+		if (!best)
 			continue;
 
-		/* Check whether all frequencies are present for 160 Mhz */
-
-		if (!(((pSpectInfo[j].chan_freq + 20) ==
-			pSpectInfo[j + 1].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 40) ==
-				 pSpectInfo[j + 2].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 60) ==
-				 pSpectInfo[j + 3].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 80) ==
-				 pSpectInfo[j + 4].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 100) ==
-				 pSpectInfo[j + 5].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 120) ==
-				 pSpectInfo[j + 6].chan_freq) &&
-			((pSpectInfo[j].chan_freq + 140) ==
-				 pSpectInfo[j + 7].chan_freq))) {
-			/*
-			 * some channels does not exist in pSectInfo array,
-			 * skip this channel and those in the same VHT160 width
-			 */
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 8;
-			pSpectInfo[j].weight_calc_done = true;
-			if ((pSpectInfo[j].chan_freq + 20) ==
-					pSpectInfo[j + 1].chan_freq) {
-				pSpectInfo[j + 1].weight =
-					SAP_ACS_WEIGHT_MAX * 8;
-				pSpectInfo[j + 1].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 40) ==
-					pSpectInfo[j + 2].chan_freq) {
-				pSpectInfo[j + 2].weight =
-					SAP_ACS_WEIGHT_MAX * 8;
-				pSpectInfo[j + 2].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 60) ==
-					pSpectInfo[j + 3].chan_freq) {
-				pSpectInfo[j + 3].weight =
-					SAP_ACS_WEIGHT_MAX * 8;
-				pSpectInfo[j + 3].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 80) ==
-					pSpectInfo[j + 4].chan_freq) {
-				pSpectInfo[j + 4].weight =
-					SAP_ACS_WEIGHT_MAX * 8;
-				pSpectInfo[j + 4].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 100) ==
-					pSpectInfo[j + 5].chan_freq) {
-				pSpectInfo[j + 5].weight =
-					SAP_ACS_WEIGHT_MAX * 8;
-				pSpectInfo[j + 5].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 120) ==
-					pSpectInfo[j + 6].chan_freq) {
-				pSpectInfo[j + 6].weight =
-					SAP_ACS_WEIGHT_MAX * 8;
-				pSpectInfo[j + 6].weight_calc_done = true;
-			}
-			if ((pSpectInfo[j].chan_freq + 140) ==
-					pSpectInfo[j + 7].chan_freq) {
-				pSpectInfo[j + 7].weight =
-					SAP_ACS_WEIGHT_MAX * 8;
-				pSpectInfo[j + 7].weight_calc_done = true;
-			}
-
-			continue;
-		}
-
-
-		/* We have 8 channels to calculate cumulative weight */
-
-		combined_weight = pSpectInfo[j].weight +
-				  pSpectInfo[j + 1].weight +
-				  pSpectInfo[j + 2].weight +
-				  pSpectInfo[j + 3].weight +
-				  pSpectInfo[j + 4].weight +
-				  pSpectInfo[j + 5].weight +
-				  pSpectInfo[j + 6].weight +
-				  pSpectInfo[j + 7].weight;
-
-		min_ch_weight = pSpectInfo[j].weight;
-		minIdx = 0;
-
-		for (i = 0; i < 8; i++) {
-			if (min_ch_weight > pSpectInfo[j + i].weight) {
-				min_ch_weight = pSpectInfo[j + i].weight;
-				minIdx = i;
-			}
-			pSpectInfo[j + i].weight = SAP_ACS_WEIGHT_MAX * 8;
-			pSpectInfo[j + i].weight_calc_done = true;
-		}
-
-		pSpectInfo[j + minIdx].weight = combined_weight;
-
-		sap_debug("best freq = %d for 160mhz center freq %d combined weight = %d",
-			  pSpectInfo[j + minIdx].chan_freq,
-			  acs_ch_params.mhz_freq_seg1,
-			  combined_weight);
+		sap_debug("best freq = %d for %dmhz center freq %d combined weight = %d",
+			  best->chan_freq, num_ch * 20, center_freq,
+			  best->weight);
 	}
 
 	sap_sort_chl_weight(pSpectInfoParams);
-
-	pSpectInfo = pSpectInfoParams->pSpectCh;
-	for (j = 0; j < (pSpectInfoParams->numSpectChans); j++) {
-		sap_debug("freq = %d weight = %d rssi = %d bss count = %d",
-			  pSpectInfo->chan_freq, pSpectInfo->weight,
-			  pSpectInfo->rssiAgr, pSpectInfo->bssCount);
-
-		pSpectInfo++;
-	}
 }
 
 /**
@@ -1892,92 +1858,68 @@ static void sap_sort_chl_weight_ht40_24_g(struct mac_context *mac_ctx,
 {
 	uint8_t i, j;
 	tSapSpectChInfo *pSpectInfo;
+	tSapSpectChInfo *ch, *ch_20, *ch_40;
 	uint32_t tmpWeight1, tmpWeight2;
 	uint32_t ht40plus2gendch = 0;
-	uint32_t channel;
 	uint32_t chan_freq;
 
-	pSpectInfo = pSpectInfoParams->pSpectCh;
 	/*
 	 * for each HT40 channel, calculate the combined weight of the
 	 * two 20MHz weight
 	 */
 	for (i = 0; i < ARRAY_SIZE(acs_ht40_channels24_g); i++) {
-		for (j = 0; j < pSpectInfoParams->numSpectChans; j++) {
-			channel = wlan_freq_to_chan(pSpectInfo[j].chan_freq);
-			if (channel == acs_ht40_channels24_g[i].chStartNum)
-				break;
-		}
-		if (j == pSpectInfoParams->numSpectChans)
+		chan_freq = wlan_reg_legacy_chan_to_freq(mac_ctx->pdev,
+				acs_ht40_channels24_g[i].chStartNum);
+		ch = sap_acs_get_spect_ch(pSpectInfoParams, chan_freq);
+		if (!ch)
 			continue;
 
-		if (!((pSpectInfo[j].chan_freq + 20) ==
-		       pSpectInfo[j + 4].chan_freq)) {
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 2;
+		ch_20 = sap_acs_get_spect_ch(pSpectInfoParams, chan_freq + 20);
+		if (!ch_20) {
+			ch->weight = SAP_ACS_WEIGHT_MAX * 2;
 			continue;
 		}
 		/*
 		 * check if there is another channel combination possiblity
 		 * e.g., {1, 5} & {5, 9}
 		 */
-		if ((pSpectInfo[j + 4].chan_freq + 20) ==
-		     pSpectInfo[j + 8].chan_freq) {
+		ch_40 = sap_acs_get_spect_ch(pSpectInfoParams, chan_freq + 40);
+		if (ch_40) {
 			/* need to compare two channel pairs */
-			tmpWeight1 = pSpectInfo[j].weight +
-						pSpectInfo[j + 4].weight;
-			tmpWeight2 = pSpectInfo[j + 4].weight +
-						pSpectInfo[j + 8].weight;
+			tmpWeight1 = ch->weight + ch_20->weight;
+			tmpWeight2 = ch_20->weight + ch_40->weight;
 			if (tmpWeight1 <= tmpWeight2) {
-				if (pSpectInfo[j].weight <=
-						pSpectInfo[j + 4].weight) {
-					pSpectInfo[j].weight =
-						tmpWeight1;
-					pSpectInfo[j + 4].weight =
-						SAP_ACS_WEIGHT_MAX * 2;
-					pSpectInfo[j + 8].weight =
-						SAP_ACS_WEIGHT_MAX * 2;
+				if (ch->weight <= ch_20->weight) {
+					ch->weight = tmpWeight1;
+					ch_20->weight = SAP_ACS_WEIGHT_MAX * 2;
+					ch_40->weight = SAP_ACS_WEIGHT_MAX * 2;
 				} else {
-					pSpectInfo[j + 4].weight =
-						tmpWeight1;
+					ch_20->weight = tmpWeight1;
 					/* for secondary channel selection */
-					pSpectInfo[j].weight =
-						SAP_ACS_WEIGHT_MAX * 2
-						- 1;
-					pSpectInfo[j + 8].weight =
-						SAP_ACS_WEIGHT_MAX * 2;
+					ch->weight = SAP_ACS_WEIGHT_MAX * 2 - 1;
+					ch_40->weight = SAP_ACS_WEIGHT_MAX * 2;
 				}
 			} else {
-				if (pSpectInfo[j + 4].weight <=
-						pSpectInfo[j + 8].weight) {
-					pSpectInfo[j + 4].weight =
-						tmpWeight2;
-					pSpectInfo[j].weight =
-						SAP_ACS_WEIGHT_MAX * 2;
+				if (ch_20->weight <= ch_40->weight) {
+					ch_20->weight = tmpWeight2;
+					ch->weight = SAP_ACS_WEIGHT_MAX * 2;
 					/* for secondary channel selection */
-					pSpectInfo[j + 8].weight =
-						SAP_ACS_WEIGHT_MAX * 2
-						- 1;
+					ch_40->weight =
+						SAP_ACS_WEIGHT_MAX * 2 - 1;
 				} else {
-					pSpectInfo[j + 8].weight =
-						tmpWeight2;
-					pSpectInfo[j].weight =
-						SAP_ACS_WEIGHT_MAX * 2;
-					pSpectInfo[j + 4].weight =
-						SAP_ACS_WEIGHT_MAX * 2;
+					ch_40->weight = tmpWeight2;
+					ch->weight = SAP_ACS_WEIGHT_MAX * 2;
+					ch_20->weight = SAP_ACS_WEIGHT_MAX * 2;
 				}
 			}
 		} else {
-			tmpWeight1 = pSpectInfo[j].weight_copy +
-						pSpectInfo[j + 4].weight_copy;
-			if (pSpectInfo[j].weight_copy <=
-					pSpectInfo[j + 4].weight_copy) {
-				pSpectInfo[j].weight = tmpWeight1;
-				pSpectInfo[j + 4].weight =
-					SAP_ACS_WEIGHT_MAX * 2;
+			tmpWeight1 = ch->weight_copy + ch_20->weight_copy;
+			if (ch->weight_copy <= ch_20->weight_copy) {
+				ch->weight = tmpWeight1;
+				ch_20->weight = SAP_ACS_WEIGHT_MAX * 2;
 			} else {
-				pSpectInfo[j + 4].weight = tmpWeight1;
-				pSpectInfo[j].weight =
-					SAP_ACS_WEIGHT_MAX * 2;
+				ch_20->weight = tmpWeight1;
+				ch->weight = SAP_ACS_WEIGHT_MAX * 2;
 			}
 		}
 	}
@@ -1992,23 +1934,18 @@ static void sap_sort_chl_weight_ht40_24_g(struct mac_context *mac_ctx,
 		ht40plus2gendch = HT40PLUS_2G_EURJAP_CH_END;
 	for (i = HT40MINUS_2G_CH_START; i <= ht40plus2gendch; i++) {
 		chan_freq = wlan_reg_legacy_chan_to_freq(mac_ctx->pdev, i);
-		for (j = 0; j < pSpectInfoParams->numSpectChans; j++) {
-			if (pSpectInfo[j].chan_freq == chan_freq &&
-				((pSpectInfo[j].chan_freq + 20) !=
-					pSpectInfo[j + 4].chan_freq) &&
-				((pSpectInfo[j].chan_freq - 20) !=
-					pSpectInfo[j - 4].chan_freq))
-				pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 2;
-		}
+		ch = sap_acs_get_spect_ch(pSpectInfoParams, chan_freq);
+		if (ch &&
+		    !sap_acs_get_spect_ch(pSpectInfoParams, chan_freq + 20) &&
+		    !sap_acs_get_spect_ch(pSpectInfoParams, chan_freq - 20))
+			ch->weight = SAP_ACS_WEIGHT_MAX * 2;
 	}
 	for (i = ht40plus2gendch + 1; i <= HT40MINUS_2G_CH_END; i++) {
 		chan_freq = wlan_reg_legacy_chan_to_freq(mac_ctx->pdev, i);
-		for (j = 0; j < pSpectInfoParams->numSpectChans; j++) {
-			if (pSpectInfo[j].chan_freq == chan_freq &&
-				(pSpectInfo[j].chan_freq - 20) !=
-					pSpectInfo[j - 4].chan_freq)
-				pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 2;
-		}
+		ch = sap_acs_get_spect_ch(pSpectInfoParams, chan_freq);
+		if (ch &&
+		    !sap_acs_get_spect_ch(pSpectInfoParams, chan_freq - 20))
+			ch->weight = SAP_ACS_WEIGHT_MAX * 2;
 	}
 
 	pSpectInfo = pSpectInfoParams->pSpectCh;
@@ -2023,112 +1960,6 @@ static void sap_sort_chl_weight_ht40_24_g(struct mac_context *mac_ctx,
 	sap_sort_chl_weight(pSpectInfoParams);
 }
 
-static void sap_sort_chl_weight_40_mhz(struct mac_context *mac_ctx,
-				       tSapChSelSpectInfo *pSpectInfoParams)
-{
-	uint8_t i, j;
-	tSapSpectChInfo *pSpectInfo;
-	uint8_t minIdx;
-	struct ch_params acs_ch_params;
-	int8_t center_freq_diff;
-	uint32_t combined_weight;
-	uint32_t min_ch_weight;
-
-	pSpectInfo = pSpectInfoParams->pSpectCh;
-
-	for (j = 0; j < pSpectInfoParams->numSpectChans; j++) {
-
-		if (WLAN_REG_IS_24GHZ_CH_FREQ(pSpectInfo[j].chan_freq))
-			continue;
-
-		if (pSpectInfo[j].weight_calc_done)
-			continue;
-
-		acs_ch_params.ch_width = CH_WIDTH_40MHZ;
-
-		wlan_reg_set_channel_params_for_freq(mac_ctx->pdev,
-						     pSpectInfo[j].chan_freq,
-						     0, &acs_ch_params);
-
-		/* Check if the freq supports 40 Mhz */
-		if (acs_ch_params.ch_width != CH_WIDTH_40MHZ) {
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 2;
-			pSpectInfo[j].weight_calc_done = true;
-			continue;
-		}
-
-		center_freq_diff = acs_ch_params.mhz_freq_seg0 -
-				   pSpectInfo[j].chan_freq;
-
-		/* This channel frequency does not have all channels */
-		if (center_freq_diff != 10) {
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 2;
-			pSpectInfo[j].weight_calc_done = true;
-			continue;
-		}
-
-		/* no other freq left for 40 Mhz operation in spectrum */
-		if (j + 1 > pSpectInfoParams->numSpectChans)
-			continue;
-
-		/* Check whether all frequencies are present for 40 Mhz */
-
-		if (!((pSpectInfo[j].chan_freq + 20) ==
-		       pSpectInfo[j + 1].chan_freq)) {
-			/*
-			 * some channels does not exist in pSectInfo array,
-			 * skip this channel and those in the same 40 width
-			 */
-			pSpectInfo[j].weight = SAP_ACS_WEIGHT_MAX * 2;
-			pSpectInfo[j].weight_calc_done = true;
-
-			if ((pSpectInfo[j].chan_freq + 20) ==
-					pSpectInfo[j + 1].chan_freq) {
-				pSpectInfo[j + 1].weight =
-					SAP_ACS_WEIGHT_MAX * 2;
-				pSpectInfo[j +1].weight_calc_done = true;
-			}
-
-			continue;
-		}
-
-		/* We have 2 channels to calculate cumulative weight */
-
-		combined_weight = pSpectInfo[j].weight +
-				  pSpectInfo[j + 1].weight;
-
-		min_ch_weight = pSpectInfo[j].weight;
-		minIdx = 0;
-
-		for (i = 0; i < 2; i++) {
-			if (min_ch_weight > pSpectInfo[j + i].weight) {
-				min_ch_weight = pSpectInfo[j + i].weight;
-				minIdx = i;
-			}
-			pSpectInfo[j + i].weight = SAP_ACS_WEIGHT_MAX * 2;
-			pSpectInfo[j + i].weight_calc_done = true;
-		}
-
-		pSpectInfo[j + minIdx].weight = combined_weight;
-
-		sap_debug("best freq = %d for 40mhz center freq %d combined weight = %d",
-			  pSpectInfo[j + minIdx].chan_freq,
-			  acs_ch_params.mhz_freq_seg0,
-			  combined_weight);
-	}
-
-	sap_sort_chl_weight(pSpectInfoParams);
-
-	pSpectInfo = pSpectInfoParams->pSpectCh;
-	for (j = 0; j < (pSpectInfoParams->numSpectChans); j++) {
-		sap_debug("freq = %d weight = %d rssi = %d bss count = %d",
-			  pSpectInfo->chan_freq, pSpectInfo->weight,
-			  pSpectInfo->rssiAgr, pSpectInfo->bssCount);
-
-		pSpectInfo++;
-	}
-}
-
 /*==========================================================================
    FUNCTION    sap_sort_chl_weight_all
 
@@ -2158,8 +1989,6 @@ static void sap_sort_chl_weight_all(struct mac_context *mac_ctx,
 	tSapSpectChInfo *pSpectCh = NULL;
 	uint32_t j = 0;
 
-	pSpectCh = pSpectInfoParams->pSpectCh;
-
 	switch (sap_ctx->acs_cfg->ch_width) {
 	case CH_WIDTH_40MHZ:
 		/*
@@ -2174,15 +2003,18 @@ static void sap_sort_chl_weight_all(struct mac_context *mac_ctx,
 						      domain);
 		} else {
 			sap_allocate_max_weight_40_mhz_24_g(pSpectInfoParams);
-			sap_sort_chl_weight_40_mhz(mac_ctx, pSpectInfoParams);
+			sap_sort_chl_weight_bonded(mac_ctx, pSpectInfoParams,
+						   CH_WIDTH_40MHZ);
 		}
 		break;
 	case CH_WIDTH_80MHZ:
 	case CH_WIDTH_80P80MHZ:
-		sap_sort_chl_weight_80_mhz(mac_ctx, pSpectInfoParams);
+		sap_sort_chl_weight_bonded(mac_ctx, pSpectInfoParams,
+					   CH_WIDTH_80MHZ);
 		break;
 	case CH_WIDTH_160MHZ:
-		sap_sort_chl_weight_160_mhz(mac_ctx, pSpectInfoParams);
+		sap_sort_chl_weight_bonded(mac_ctx, pSpectInfoParams,
+					   CH_WIDTH_160MHZ);
 		break;
 	case CH_WIDTH_20MHZ:
 	default:
@@ -2190,12 +2022,11 @@ static void sap_sort_chl_weight_all(struct mac_context *mac_ctx,
 		sap_sort_chl_weight(pSpectInfoParams);
 	}
 
-	pSpectCh = pSpectInfoParams->pSpectCh;
 	for (j = 0; j < (pSpectInfoParams->numSpectChans); j++) {
+		pSpectCh = sap_acs_get_ranked_ch(pSpectInfoParams, j);
 		sap_debug("Freq = %d weight = %d rssi aggr = %d bss count = %d",
 			  pSpectCh->chan_freq, pSpectCh->weight,
 			  pSpectCh->rssiAgr, pSpectCh->bssCount);
-		pSpectCh++;
 	}
 
 }
@@ -2218,13 +2049,18 @@ static bool sap_is_ch_non_overlap(struct sap_context *sap_ctx, uint16_t ch)
 	return false;
 }
 
-uint32_t sap_select_channel(mac_handle_t mac_handle,
-			   struct sap_context *sap_ctx,
-			   qdf_list_t *scan_list)
+/**
+ * sap_select_best_channel() - select the best channel of a scored spectrum
+ * @mac_ctx: Pointer to mac_context
+ * @sap_ctx: Sap context
+ * @spect_info: spectrum, with the weight of every channel computed
+ *
+ * Return: channel frequency if success, 0 otherwise
+ */
+static uint32_t sap_select_best_channel(struct mac_context *mac_ctx,
+					struct sap_context *sap_ctx,
+					tSapChSelSpectInfo *spect_info)
 {
-	/* DFS param object holding all the data req by the algo */
-	tSapChSelSpectInfo spect_info_obj = { NULL, 0 };
-	tSapChSelSpectInfo *spect_info = &spect_info_obj;
 	uint8_t best_ch_num = SAP_CHANNEL_NOT_SELECTED;
 	uint32_t best_ch_weight = SAP_ACS_WEIGHT_MAX;
 	uint32_t ht40plus2gendch = 0;
@@ -2232,25 +2068,8 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 	uint8_t country[CDS_COUNTRY_CODE_LEN + 1];
 	uint8_t count;
 	uint32_t operating_band = 0;
-	struct mac_context *mac_ctx;
 	uint32_t best_chan_freq = 0;
 
-	mac_ctx = MAC_CONTEXT(mac_handle);
-
-	/* Initialize the structure pointed by spect_info */
-	if (sap_chan_sel_init(mac_handle, spect_info, sap_ctx) != true) {
-		sap_err("Ch Select initialization failed");
-		return SAP_CHANNEL_NOT_SELECTED;
-	}
-
-	/* Compute the weight of the entire spectrum in the operating band */
-	sap_compute_spect_weight(spect_info, mac_handle, scan_list, sap_ctx);
-
-#ifdef FEATURE_AP_MCC_CH_AVOIDANCE
-	/* process avoid channel IE to collect all channels to avoid */
-	sap_process_avoid_ie(mac_handle, sap_ctx, scan_list, spect_info);
-#endif /* FEATURE_AP_MCC_CH_AVOIDANCE */
-
 	wlan_reg_read_current_country(mac_ctx->psoc, country);
 	wlan_reg_get_domain_from_country_code(&domain, country, SOURCE_DRIVER);
 
@@ -2262,7 +2081,8 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 
 	/*Loop till get the best channel in the given range */
 	for (count = 0; count < spect_info->numSpectChans; count++) {
-		best_chan_freq = spect_info->pSpectCh[count].chan_freq;
+		best_chan_freq =
+			sap_acs_get_ranked_ch(spect_info, count)->chan_freq;
 		/* check if best_ch_num is in preferred channel list */
 		best_chan_freq =
 			sap_select_preferred_channel_from_channel_list(
@@ -2294,7 +2114,8 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 			continue;
 		}
 
-		best_ch_weight = spect_info->pSpectCh[count].weight;
+		best_ch_weight =
+			sap_acs_get_ranked_ch(spect_info, count)->weight;
 		sap_debug("Freq = %d selected as best frequency weight = %d",
 			  best_chan_freq, best_ch_weight);
 
@@ -2308,9 +2129,12 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 	 */
 	if (!ch_in_pcl(sap_ctx, best_chan_freq)) {
 		uint32_t cal_chan_freq, cal_chan_weight;
+		tSapSpectChInfo *cal_ch;
+
 		for (count = 0; count < spect_info->numSpectChans; count++) {
-			cal_chan_freq = spect_info->pSpectCh[count].chan_freq;
-			cal_chan_weight = spect_info->pSpectCh[count].weight;
+			cal_ch = sap_acs_get_ranked_ch(spect_info, count);
+			cal_chan_freq = cal_ch->chan_freq;
+			cal_chan_weight = cal_ch->weight;
 			/* skip pcl channel whose weight is bigger than best */
 			if (!ch_in_pcl(sap_ctx, cal_chan_freq) ||
 			    (cal_chan_weight > best_ch_weight))
@@ -2340,7 +2164,7 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 	/* determine secondary channel for 2.4G channel 5, 6, 7 in HT40 */
 	if ((operating_band != eCSR_DOT11_MODE_11g) ||
 	    (sap_ctx->acs_cfg->ch_width != CH_WIDTH_40MHZ))
-		goto sap_ch_sel_end;
+		return best_chan_freq;
 
 	best_ch_num = wlan_reg_freq_to_chan(mac_ctx->pdev, best_chan_freq);
 
@@ -2350,17 +2174,18 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 		ht40plus2gendch = HT40PLUS_2G_EURJAP_CH_END;
 	if ((best_ch_num >= HT40MINUS_2G_CH_START) &&
 			(best_ch_num <= ht40plus2gendch)) {
-		int weight_below, weight_above, i;
+		int weight_below, weight_above;
 		tSapSpectChInfo *pspect_info;
 
 		weight_below = weight_above = SAP_ACS_WEIGHT_MAX;
-		pspect_info = spect_info->pSpectCh;
-		for (i = 0; i < spect_info->numSpectChans; i++) {
-			if (pspect_info[i].chan_freq == (best_chan_freq - 20))
-				weight_below = pspect_info[i].weight;
-			if (pspect_info[i].chan_freq == (best_ch_num + 20))
-				weight_above = pspect_info[i].weight;
-		}
+		pspect_info = sap_acs_get_spect_ch(spect_info,
+						   best_chan_freq - 20);
+		if (pspect_info)
+			weight_below = pspect_info->weight;
+		pspect_info = sap_acs_get_spect_ch(spect_info,
+						   best_chan_freq + 20);
+		if (pspect_info)
+			weight_above = pspect_info->weight;
 
 		if (weight_below < weight_above)
 			sap_ctx->acs_cfg->ht_sec_ch_freq =
@@ -2380,9 +2205,367 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 	}
 	sap_ctx->sec_ch_freq = sap_ctx->acs_cfg->ht_sec_ch_freq;
 
-sap_ch_sel_end:
+	return best_chan_freq;
+}
+
+uint32_t sap_select_channel(mac_handle_t mac_handle,
+			   struct sap_context *sap_ctx,
+			   qdf_list_t *scan_list)
+{
+	/* DFS param object holding all the data req by the algo */
+	tSapChSelSpectInfo spect_info_obj = { NULL, 0 };
+	tSapChSelSpectInfo *spect_info = &spect_info_obj;
+	struct mac_context *mac_ctx;
+	uint32_t best_chan_freq;
+
+	mac_ctx = MAC_CONTEXT(mac_handle);
+
+	/* Initialize the structure pointed by spect_info */
+	if (sap_chan_sel_init(mac_handle, spect_info, sap_ctx) != true) {
+		sap_err("Ch Select initialization failed");
+		return SAP_CHANNEL_NOT_SELECTED;
+	}
+
+	/* Compute the weight of the entire spectrum in the operating band */
+	sap_compute_spect_weight(spect_info, mac_handle, scan_list, sap_ctx);
+
+#ifdef FEATURE_AP_MCC_CH_AVOIDANCE
+	/* process avoid channel IE to collect all channels to avoid */
+	sap_process_avoid_ie(mac_handle, sap_ctx, scan_list, spect_info);
+#endif /* FEATURE_AP_MCC_CH_AVOIDANCE */
+
+	best_chan_freq = sap_select_best_channel(mac_ctx, sap_ctx, spect_info);
+
 	/* Free all the allocated memory */
 	sap_chan_sel_exit(spect_info);
 
 	return best_chan_freq;
 }
+
+#ifdef WLAN_FEATURE_SAP_ACS_STREAMING
+/**
+ * sap_acs_stream_take_chan() - account the scan results of scanned channels
+ * @mac_ctx: Pointer to mac_context
+ * @sap_ctx: Sap context
+ * @stream: streamed ACS
+ * @freq_list: channels the scan is done with
+ * @num_freq: number of channels in @freq_list
+ *
+ * The channels are scored with the results accounted so far, which folds in
+ * their channel status, reported at the end of their dwell. Channels already
+ * accounted are skipped, so that their BSSs are not counted twice.
+ *
+ * Return: None
+ */
+static void sap_acs_stream_take_chan(struct mac_context *mac_ctx,
+				     struct sap_context *sap_ctx,
+				     struct sap_acs_stream *stream,
+				     uint32_t *freq_list, uint8_t num_freq)
+{
+	tSapChSelSpectInfo *spect_info = &stream->spect_info;
+	tSapSpectChInfo *spect_ch;
+	struct scan_filter *filter;
+	qdf_list_t *list;
+	qdf_list_node_t *cur_lst = NULL, *next_lst = NULL;
+	struct scan_cache_node *cur_node;
+	uint8_t i;
+
+	if (!num_freq)
+		return;
+
+	filter = qdf_mem_malloc(sizeof(*filter));
+	if (!filter)
+		return;
+
+	for (i = 0; i < num_freq; i++) {
+		spect_ch = sap_acs_get_spect_ch(spect_info, freq_list[i]);
+		if (spect_ch && spect_ch->scanned)
+			continue;
+
+		filter->chan_freq_list[filter->num_of_channels++] =
+								freq_list[i];
+	}
+
+	if (!filter->num_of_channels) {
+		qdf_mem_free(filter);
+		return;
+	}
+
+	filter->age_threshold = qdf_get_time_of_the_day_ms() -
+					sap_ctx->acs_req_timestamp;
+	list = ucfg_scan_get_result(mac_ctx->pdev, filter);
+	qdf_mem_free(filter);
+
+	if (list)
+		qdf_list_peek_front(list, &cur_lst);
+	while (cur_lst) {
+		cur_node = qdf_container_of(cur_lst, struct scan_cache_node,
+					    node);
+		sap_add_scan_entry(spect_info, cur_node);
+		sap_process_avoid_ie_entry(mac_ctx, sap_ctx, cur_node,
+					   spect_info);
+
+		qdf_list_peek_next(list, cur_lst, &next_lst);
+		cur_lst = next_lst;
+		next_lst = NULL;
+	}
+	if (list)
+		ucfg_scan_purge_results(list);
+
+	for (i = 0; i < num_freq; i++) {
+		spect_ch = sap_acs_get_spect_ch(spect_info, freq_list[i]);
+		if (!spect_ch || spect_ch->scanned)
+			continue;
+
+		spect_ch->scanned = true;
+		stream->num_scanned++;
+		sap_compute_ch_weight(mac_ctx, sap_ctx, spect_ch);
+	}
+}
+
+/**
+ * sap_acs_stream_take_remaining() - account the channels not scanned yet
+ * @mac_ctx: Pointer to mac_context
+ * @sap_ctx: Sap context
+ * @stream: streamed ACS
+ *
+ * These are the last two channels of the scan, the ones the scan did not
+ * report and those outside of the ACS scan list, whose results still
+ * interfere with their neighbours.
+ *
+ * Return: None
+ */
+static void sap_acs_stream_take_remaining(struct mac_context *mac_ctx,
+					  struct sap_context *sap_ctx,
+					  struct sap_acs_stream *stream)
+{
+	tSapChSelSpectInfo *spect_info = &stream->spect_info;
+	uint32_t freq_list[NUM_CHANNELS];
+	uint8_t num_freq = 0;
+	uint8_t i;
+
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		if (spect_info->pSpectCh[i].scanned)
+			continue;
+
+		freq_list[num_freq++] = spect_info->pSpectCh[i].chan_freq;
+		if (num_freq == QDF_ARRAY_SIZE(freq_list)) {
+			sap_acs_stream_take_chan(mac_ctx, sap_ctx, stream,
+						 freq_list, num_freq);
+			num_freq = 0;
+		}
+	}
+
+	sap_acs_stream_take_chan(mac_ctx, sap_ctx, stream, freq_list,
+				 num_freq);
+}
+
+/**
+ * sap_acs_stream_cancel_scan() - cancel the ACS scan
+ * @mac_ctx: Pointer to mac_context
+ * @sap_ctx: Sap context
+ * @stream: streamed ACS
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS sap_acs_stream_cancel_scan(struct mac_context *mac_ctx,
+					     struct sap_context *sap_ctx,
+					     struct sap_acs_stream *stream)
+{
+	struct scan_cancel_request *req;
+	struct wlan_objmgr_vdev *vdev;
+	QDF_STATUS status;
+
+	vdev = wlan_objmgr_get_vdev_by_id_from_psoc(mac_ctx->psoc,
+						    sap_ctx->sessionId,
+						    WLAN_LEGACY_SAP_ID);
+	if (!vdev) {
+		sap_err("Invalid vdev objmgr");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	req = qdf_mem_malloc(sizeof(*req));
+	if (!req) {
+		status = QDF_STATUS_E_NOMEM;
+		goto release_vdev_ref;
+	}
+
+	req->vdev = vdev;
+	req->cancel_req.requester = sap_ctx->req_id;
+	req->cancel_req.scan_id = stream->scan_id;
+	req->cancel_req.vdev_id = sap_ctx->sessionId;
+	req->cancel_req.req_type = WLAN_SCAN_CANCEL_SINGLE;
+	status = ucfg_scan_cancel(req);
+
+release_vdev_ref:
+	wlan_objmgr_vdev_release_ref(vdev, WLAN_LEGACY_SAP_ID);
+
+	return status;
+}
+
+/**
+ * sap_acs_stream_check_stable() - stop the ACS scan if the ranking is stable
+ * @mac_ctx: Pointer to mac_context
+ * @sap_ctx: Sap context
+ * @stream: streamed ACS
+ *
+ * Return: None
+ */
+static void sap_acs_stream_check_stable(struct mac_context *mac_ctx,
+					struct sap_context *sap_ctx,
+					struct sap_acs_stream *stream)
+{
+	tSapChSelSpectInfo *spect_info = &stream->spect_info;
+	uint8_t stable_chan = mac_ctx->mlme_cfg->acs.early_stop_stable_chan;
+	tSapSpectChInfo *spect_ch, *best = NULL;
+	uint8_t i;
+
+	if (!stable_chan || stream->stopped)
+		return;
+
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		spect_ch = &spect_info->pSpectCh[i];
+		if (!spect_ch->scanned ||
+		    spect_ch->weight >= SAP_ACS_WEIGHT_MAX)
+			continue;
+
+		if (!best || spect_ch->weight < best->weight)
+			best = spect_ch;
+	}
+
+	if (!best)
+		return;
+
+	if (best->chan_freq != stream->best_freq) {
+		stream->best_freq = best->chan_freq;
+		stream->stable_count = 0;
+		return;
+	}
+
+	stream->stable_count++;
+	/* the best channel has to hold over at least half of the scan */
+	if (stream->stable_count < stable_chan ||
+	    stream->num_scanned * 2 < sap_ctx->num_of_channel)
+		return;
+
+	if (QDF_IS_STATUS_ERROR(sap_acs_stream_cancel_scan(mac_ctx, sap_ctx,
+							   stream)))
+		return;
+
+	sap_info("ACS scan %d stopped after %d channels, best freq %d",
+		 stream->scan_id, stream->num_scanned, stream->best_freq);
+	stream->stopped = true;
+}
+
+QDF_STATUS sap_acs_stream_start(mac_handle_t mac_handle,
+				struct sap_context *sap_ctx, uint32_t scan_id)
+{
+	struct sap_acs_stream *stream;
+
+	sap_acs_stream_stop(sap_ctx);
+
+	stream = qdf_mem_malloc(sizeof(*stream));
+	if (!stream)
+		return QDF_STATUS_E_NOMEM;
+
+	if (!sap_chan_sel_init(mac_handle, &stream->spect_info, sap_ctx)) {
+		qdf_mem_free(stream);
+		return QDF_STATUS_E_NOMEM;
+	}
+
+	stream->scan_id = scan_id;
+	sap_ctx->acs_stream = stream;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void sap_acs_stream_scan_event(mac_handle_t mac_handle,
+			       struct sap_context *sap_ctx,
+			       struct scan_event *event)
+{
+	struct sap_acs_stream *stream = sap_ctx->acs_stream;
+	struct mac_context *mac_ctx = MAC_CONTEXT(mac_handle);
+
+	if (!stream || stream->scan_id != event->scan_id ||
+	    event->type != SCAN_EVENT_TYPE_FOREIGN_CHANNEL)
+		return;
+
+	/*
+	 * A channel is accounted one dwell after its own, so that the frames
+	 * received at the end of its dwell have made it to the scan DB.
+	 */
+	if (stream->prev_freq) {
+		sap_acs_stream_take_chan(mac_ctx, sap_ctx, stream,
+					 &stream->prev_freq, 1);
+		sap_acs_stream_check_stable(mac_ctx, sap_ctx, stream);
+	}
+
+	stream->prev_freq = stream->cur_freq;
+	stream->cur_freq = event->chan_freq;
+}
+
+bool sap_acs_stream_is_stopped(struct sap_context *sap_ctx, uint32_t scan_id)
+{
+	struct sap_acs_stream *stream = sap_ctx->acs_stream;
+
+	return stream && stream->scan_id == scan_id && stream->stopped;
+}
+
+QDF_STATUS sap_acs_stream_select_channel(mac_handle_t mac_handle,
+					 struct sap_context *sap_ctx,
+					 uint32_t scan_id, uint32_t *chan_freq)
+{
+	struct sap_acs_stream *stream = sap_ctx->acs_stream;
+	struct mac_context *mac_ctx = MAC_CONTEXT(mac_handle);
+	tSapChSelSpectInfo *spect_info;
+	tSapSpectChInfo *spect_ch;
+	uint8_t i;
+
+	if (!stream || stream->scan_id != scan_id)
+		return QDF_STATUS_E_NOENT;
+
+	spect_info = &stream->spect_info;
+	/* when stopped, the dwell on the previous channel still completed */
+	if (!stream->stopped)
+		sap_acs_stream_take_remaining(mac_ctx, sap_ctx, stream);
+	else if (stream->prev_freq)
+		sap_acs_stream_take_chan(mac_ctx, sap_ctx, stream,
+					 &stream->prev_freq, 1);
+
+	/*
+	 * Score again the channels whose neighbours got scanned after them,
+	 * and leave out those the scan was stopped before.
+	 */
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		spect_ch = &spect_info->pSpectCh[i];
+		if (!spect_ch->scanned) {
+			spect_ch->weight = SAP_ACS_WEIGHT_MAX;
+			spect_ch->weight_copy = SAP_ACS_WEIGHT_MAX;
+			continue;
+		}
+
+		sap_compute_ch_weight(mac_ctx, sap_ctx, spect_ch);
+	}
+	sap_clear_channel_status(mac_ctx);
+
+	sap_debug("ACS scan %d: %d channels scanned", scan_id,
+		  stream->num_scanned);
+	*chan_freq = sap_select_best_channel(mac_ctx, sap_ctx, spect_info);
+
+	sap_acs_stream_stop(sap_ctx);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void sap_acs_stream_stop(struct sap_context *sap_ctx)
+{
+	struct sap_acs_stream *stream = sap_ctx->acs_stream;
+
+	if (!stream)
+		return;
+
+	sap_ctx->acs_stream = NULL;
+	sap_acs_spect_info_free(&stream->spect_info);
+	qdf_mem_free(stream);
+}
+#endif /* WLAN_FEATURE_SAP_ACS_STREAMING */
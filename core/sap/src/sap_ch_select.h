@@ -110,6 +110,8 @@ typedef struct {
 	uint32_t weight_copy;   /* copy of the orignal weight */
 	bool valid;             /* Is this a valid center frequency for regulatory domain */
 	bool weight_calc_done;
+	bool avoid;             /* a Q2Q IE asks to avoid this channel */
+	bool scanned;           /* scan results of this channel are accounted */
 } tSapSpectChInfo;              /* tDfsSpectChInfo; */
 
 /**
@@ -120,6 +122,124 @@ typedef struct {
 typedef struct {
 	tSapSpectChInfo *pSpectCh;      /* tDfsSpectChInfo *pSpectCh;  // Ptr to the channels in the entire spectrum band */
 	uint8_t numSpectChans;  /* Total num of channels in the spectrum */
+	uint8_t *freq_idx;      /* 1 + index in pSpectCh per frequency slot */
+	uint16_t *sorted_idx;   /* indices in pSpectCh, least weight first */
+	uint16_t *sort_buf;     /* scratch indices for sorting */
 } tSapChSelSpectInfo;           /* tDfsChSelParams; */
 
+/**
+ * struct sap_acs_stream - ACS channel scoring run along with the ACS scan
+ * @scan_id: id of the ACS scan
+ * @spect_info: spectrum being scored
+ * @cur_freq: channel the scan dwells on, 0 if none yet
+ * @prev_freq: channel the scan dwelt on before @cur_freq, accounted when
+ *	the scan moves to the next channel, 0 if none
+ * @num_scanned: number of channels whose scan results are accounted
+ * @best_freq: best channel among the scanned ones
+ * @stable_count: number of channels scanned since @best_freq last changed
+ * @stopped: the scan was cancelled as the ranking got stable
+ */
+struct sap_acs_stream {
+	uint32_t scan_id;
+	tSapChSelSpectInfo spect_info;
+	uint32_t cur_freq;
+	uint32_t prev_freq;
+	uint8_t num_scanned;
+	uint32_t best_freq;
+	uint8_t stable_count;
+	bool stopped;
+};
+
+/* Frequency range covered by the frequency index of tSapChSelSpectInfo */
+#define SAP_ACS_FREQ_IDX_START 2407
+#define SAP_ACS_FREQ_IDX_END 7125
+#define SAP_ACS_FREQ_IDX_SIZE \
+	((SAP_ACS_FREQ_IDX_END - SAP_ACS_FREQ_IDX_START) / 5 + 1)
+
+/* Max number of 20 MHz channels bonded together */
+#define SAP_ACS_MAX_BONDED_CH 8
+
+/**
+ * sap_acs_spect_info_alloc() - allocate the spectrum table and its indices
+ * @spect_info: spectrum information
+ * @num_chans: number of channels of the spectrum
+ *
+ * Return: true on success, false if out of memory
+ */
+bool sap_acs_spect_info_alloc(tSapChSelSpectInfo *spect_info,
+			      uint8_t num_chans);
+
+/**
+ * sap_acs_spect_info_free() - free the spectrum table and its indices
+ * @spect_info: spectrum information
+ *
+ * Return: None
+ */
+void sap_acs_spect_info_free(tSapChSelSpectInfo *spect_info);
+
+/**
+ * sap_acs_build_freq_idx() - index the spectrum table by frequency
+ * @spect_info: spectrum information, with the frequency of every channel
+ *	filled
+ *
+ * Return: None
+ */
+void sap_acs_build_freq_idx(tSapChSelSpectInfo *spect_info);
+
+/**
+ * sap_acs_get_spect_ch() - look up the channel of a frequency
+ * @spect_info: spectrum information
+ * @chan_freq: frequency
+ *
+ * Return: channel of @chan_freq, NULL if it is not part of the spectrum
+ */
+tSapSpectChInfo *sap_acs_get_spect_ch(tSapChSelSpectInfo *spect_info,
+				      uint32_t chan_freq);
+
+/**
+ * sap_acs_get_ranked_ch() - get the channel of a rank
+ * @spect_info: spectrum information
+ * @rank: rank, 0 for the least weight
+ *
+ * Only valid after sap_sort_chl_weight().
+ *
+ * Return: channel of @rank
+ */
+static inline tSapSpectChInfo *
+sap_acs_get_ranked_ch(tSapChSelSpectInfo *spect_info, uint8_t rank)
+{
+	return &spect_info->pSpectCh[spect_info->sorted_idx[rank]];
+}
+
+/**
+ * sap_sort_chl_weight() - rank the channels with the least weight first
+ * @spect_info: spectrum information
+ *
+ * The channels are ranked on their weight then their BSS count, ties keep
+ * the spectrum order. Only the indices are sorted, the spectrum table is
+ * left as is.
+ *
+ * Return: None
+ */
+void sap_sort_chl_weight(tSapChSelSpectInfo *spect_info);
+
+/**
+ * sap_acs_aggregate_bonded_ch() - combine the weights of bonded channels
+ * @spect_info: spectrum information
+ * @start_freq: frequency of the lowest 20 MHz channel of the group
+ * @num_ch: number of 20 MHz channels of the group
+ * @max_weight: weight given to the channels not carrying the group
+ *
+ * The channel of the group with the least weight carries the combined
+ * weight of the group and the others get @max_weight. If a channel of the
+ * group is missing from the spectrum, all of them get @max_weight. Every
+ * channel of the group found is marked as done.
+ *
+ * Return: channel carrying the group, NULL if the group is incomplete
+ */
+tSapSpectChInfo *sap_acs_aggregate_bonded_ch(tSapChSelSpectInfo *spect_info,
+					     uint32_t start_freq,
+					     uint8_t num_ch,
+					     uint32_t max_weight);
+
 #endif /* if !defined __SAP_CH_SELECT_H */
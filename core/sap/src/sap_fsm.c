@@ -970,9 +970,12 @@ QDF_STATUS sap_channel_sel(struct sap_context *sap_context)
 		/* Set requestType to Full scan */
 
 		sap_context->acs_req_timestamp = qdf_get_time_of_the_day_ms();
+		/* the channels get scored as the scan goes, if possible */
+		sap_acs_stream_start(mac_handle, sap_context, scan_id);
 		qdf_ret_status = ucfg_scan_start(req);
 		if (qdf_ret_status != QDF_STATUS_SUCCESS) {
 			sap_err("scan request  fail %d!!!", qdf_ret_status);
+			sap_acs_stream_stop(sap_context);
 			sap_info("SAP Configuring default ch, Ch_freq=%d",
 				  sap_context->chan_freq);
 			default_op_freq = sap_select_default_oper_chan(
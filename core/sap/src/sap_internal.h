@@ -182,6 +182,9 @@ struct sap_context {
 	struct sap_acs_cfg *acs_cfg;
 
 	qdf_time_t acs_req_timestamp;
+#ifdef WLAN_FEATURE_SAP_ACS_STREAMING
+	struct sap_acs_stream *acs_stream;
+#endif
 
 #ifdef FEATURE_WLAN_MCC_TO_SCC_SWITCH
 	uint8_t cc_switch_mode;
@@ -301,6 +304,98 @@ QDF_STATUS wlansap_pre_start_bss_acs_scan_callback(mac_handle_t mac_handle,
 uint32_t sap_select_channel(mac_handle_t mac_handle, struct sap_context *sap_ctx,
 			   qdf_list_t *scan_list);
 
+#ifdef WLAN_FEATURE_SAP_ACS_STREAMING
+/**
+ * sap_acs_stream_start() - score the channels along with an ACS scan
+ * @mac_handle: Opaque handle to the global MAC context
+ * @sap_ctx: Sap context
+ * @scan_id: id of the ACS scan
+ *
+ * The scan results of a channel are accounted and the channel is scored as
+ * soon as the scan leaves it, so that only the ranking is left to do when
+ * the scan completes.
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error otherwise, in which case the
+ *	channels are scored from the whole scan list once the scan completes
+ */
+QDF_STATUS sap_acs_stream_start(mac_handle_t mac_handle,
+				struct sap_context *sap_ctx, uint32_t scan_id);
+
+/**
+ * sap_acs_stream_scan_event() - handle an event of the ACS scan
+ * @mac_handle: Opaque handle to the global MAC context
+ * @sap_ctx: Sap context
+ * @event: scan event, other than a completion
+ *
+ * Return: None
+ */
+void sap_acs_stream_scan_event(mac_handle_t mac_handle,
+			       struct sap_context *sap_ctx,
+			       struct scan_event *event);
+
+/**
+ * sap_acs_stream_is_stopped() - check if the ranking stopped the ACS scan
+ * @sap_ctx: Sap context
+ * @scan_id: id of the ACS scan
+ *
+ * Return: true if the ACS scan was cancelled as its ranking got stable
+ */
+bool sap_acs_stream_is_stopped(struct sap_context *sap_ctx, uint32_t scan_id);
+
+/**
+ * sap_acs_stream_select_channel() - select the channel of a streamed ACS
+ * @mac_handle: Opaque handle to the global MAC context
+ * @sap_ctx: Sap context
+ * @scan_id: id of the completed ACS scan
+ * @chan_freq: selected channel frequency, 0 if none
+ *
+ * Return: QDF_STATUS_SUCCESS if @chan_freq is set, QDF_STATUS_E_NOENT if
+ *	the channels of @scan_id were not scored along with the scan
+ */
+QDF_STATUS sap_acs_stream_select_channel(mac_handle_t mac_handle,
+					 struct sap_context *sap_ctx,
+					 uint32_t scan_id, uint32_t *chan_freq);
+
+/**
+ * sap_acs_stream_stop() - stop scoring the channels along with the ACS scan
+ * @sap_ctx: Sap context
+ *
+ * Return: None
+ */
+void sap_acs_stream_stop(struct sap_context *sap_ctx);
+#else
+static inline QDF_STATUS sap_acs_stream_start(mac_handle_t mac_handle,
+					      struct sap_context *sap_ctx,
+					      uint32_t scan_id)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline void sap_acs_stream_scan_event(mac_handle_t mac_handle,
+					     struct sap_context *sap_ctx,
+					     struct scan_event *event)
+{
+}
+
+static inline bool sap_acs_stream_is_stopped(struct sap_context *sap_ctx,
+					     uint32_t scan_id)
+{
+	return false;
+}
+
+static inline QDF_STATUS
+sap_acs_stream_select_channel(mac_handle_t mac_handle,
+			      struct sap_context *sap_ctx,
+			      uint32_t scan_id, uint32_t *chan_freq)
+{
+	return QDF_STATUS_E_NOENT;
+}
+
+static inline void sap_acs_stream_stop(struct sap_context *sap_ctx)
+{
+}
+#endif /* WLAN_FEATURE_SAP_ACS_STREAMING */
+
 QDF_STATUS
 sap_signal_hdd_event(struct sap_context *sap_ctx,
 		  struct csr_roam_info *pCsrRoamInfo,
@@ -373,6 +373,7 @@ QDF_STATUS sap_deinit_ctx(struct sap_context *sap_ctx)
 	}
 	ucfg_scan_unregister_requester(mac->psoc, sap_ctx->req_id);
 
+	sap_acs_stream_stop(sap_ctx);
 	if (sap_ctx->freq_list) {
 		qdf_mem_free(sap_ctx->freq_list);
 		sap_ctx->freq_list = NULL;
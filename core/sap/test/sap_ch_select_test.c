@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "cds_test_util.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "sap_ch_select.h"
+#include "sap_ch_select_test.h"
+
+#define acs_test_err(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_ERROR, fmt, ##args)
+#define acs_test_info(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_INFO_HIGH, fmt, ##args)
+
+/* Scan results of the synthetic scan list */
+#define SAP_ACS_TEST_NUM_BSS 1024
+/* Times the synthetic scan list is ranked by the benchmark */
+#define SAP_ACS_TEST_ROUNDS 64
+
+/**
+ * struct sap_acs_test_band - channels of a synthetic band
+ * @start_freq: first channel
+ * @end_freq: last channel
+ * @step: spacing of the channels
+ */
+struct sap_acs_test_band {
+	uint32_t start_freq;
+	uint32_t end_freq;
+	uint32_t step;
+};
+
+static const struct sap_acs_test_band sap_acs_test_bands[] = {
+	{ 2412, 2472, 5 },
+	{ 2484, 2484, 5 },
+	{ 5180, 5320, 20 },
+	{ 5500, 5720, 20 },
+	{ 5745, 5825, 20 },
+	{ 5955, 7115, 20 },
+};
+
+static bool sap_acs_test_create(tSapChSelSpectInfo *spect_info)
+{
+	const struct sap_acs_test_band *band;
+	uint32_t num = 0;
+	uint32_t freq;
+	uint8_t i, j = 0;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(sap_acs_test_bands); i++) {
+		band = &sap_acs_test_bands[i];
+		num += (band->end_freq - band->start_freq) / band->step + 1;
+	}
+
+	if (!sap_acs_spect_info_alloc(spect_info, num))
+		return false;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(sap_acs_test_bands); i++) {
+		band = &sap_acs_test_bands[i];
+		for (freq = band->start_freq; freq <= band->end_freq;
+		     freq += band->step) {
+			spect_info->pSpectCh[j].chan_freq = freq;
+			spect_info->pSpectCh[j].rssiAgr = SOFTAP_MIN_RSSI;
+			spect_info->pSpectCh[j].valid = true;
+			j++;
+		}
+	}
+
+	sap_acs_build_freq_idx(spect_info);
+
+	return true;
+}
+
+static uint32_t sap_acs_test_lookup(tSapChSelSpectInfo *spect_info)
+{
+	static const uint32_t absent[] = {
+		2400, 2413, 2485, 5170, 5340, 5960, 7200,
+	};
+	tSapSpectChInfo *spect_ch;
+	uint32_t errors = 0;
+	uint8_t i;
+
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		spect_ch = &spect_info->pSpectCh[i];
+		if (sap_acs_get_spect_ch(spect_info, spect_ch->chan_freq) ==
+		    spect_ch)
+			continue;
+
+		acs_test_err("FAIL: freq %d not found", spect_ch->chan_freq);
+		errors++;
+	}
+
+	for (i = 0; i < QDF_ARRAY_SIZE(absent); i++) {
+		if (!sap_acs_get_spect_ch(spect_info, absent[i]))
+			continue;
+
+		acs_test_err("FAIL: freq %d found", absent[i]);
+		errors++;
+	}
+
+	return errors;
+}
+
+static uint32_t sap_acs_test_check_rank(tSapChSelSpectInfo *spect_info)
+{
+	tSapSpectChInfo *prev, *cur;
+	bool seen[U8_MAX + 1] = {0};
+	uint16_t idx;
+	uint8_t i;
+
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		idx = spect_info->sorted_idx[i];
+		if (idx >= spect_info->numSpectChans || seen[idx]) {
+			acs_test_err("FAIL: rank %d has bad index %d", i, idx);
+			return 1;
+		}
+		seen[idx] = true;
+	}
+
+	for (i = 1; i < spect_info->numSpectChans; i++) {
+		prev = sap_acs_get_ranked_ch(spect_info, i - 1);
+		cur = sap_acs_get_ranked_ch(spect_info, i);
+		if (prev->weight < cur->weight)
+			continue;
+		if (prev->weight == cur->weight &&
+		    (prev->bssCount < cur->bssCount ||
+		     (prev->bssCount == cur->bssCount && prev < cur)))
+			continue;
+
+		acs_test_err("FAIL: freq %d ranked before freq %d",
+			     prev->chan_freq, cur->chan_freq);
+		return 1;
+	}
+
+	return 0;
+}
+
+static uint32_t sap_acs_test_sort(tSapChSelSpectInfo *spect_info)
+{
+	uint32_t seed = 1;
+	uint32_t errors = 0;
+	uint8_t i;
+
+	/* few distinct weights, so that the ties are exercised */
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		spect_info->pSpectCh[i].weight =
+			(cds_test_rand(&seed) % 8) * 100;
+		spect_info->pSpectCh[i].bssCount =
+			cds_test_rand(&seed) % 3;
+	}
+
+	sap_sort_chl_weight(spect_info);
+	errors += sap_acs_test_check_rank(spect_info);
+
+	/* sorting again starts from the spectrum order */
+	sap_sort_chl_weight(spect_info);
+	errors += sap_acs_test_check_rank(spect_info);
+
+	return errors;
+}
+
+static void sap_acs_test_set_weight(tSapChSelSpectInfo *spect_info,
+				    uint32_t freq, uint32_t weight)
+{
+	tSapSpectChInfo *spect_ch = sap_acs_get_spect_ch(spect_info, freq);
+
+	spect_ch->weight = weight;
+	spect_ch->weight_calc_done = false;
+}
+
+static uint32_t sap_acs_test_bonded(tSapChSelSpectInfo *spect_info)
+{
+	tSapSpectChInfo *best, *spect_ch;
+	uint32_t errors = 0;
+	uint32_t freq;
+
+	sap_acs_test_set_weight(spect_info, 5180, 40);
+	sap_acs_test_set_weight(spect_info, 5200, 10);
+	sap_acs_test_set_weight(spect_info, 5220, 30);
+	sap_acs_test_set_weight(spect_info, 5240, 20);
+
+	best = sap_acs_aggregate_bonded_ch(spect_info, 5180, 4,
+					   SAP_ACS_WEIGHT_MAX * 4);
+	if (!best || best->chan_freq != 5200 || best->weight != 100) {
+		acs_test_err("FAIL: 80 MHz group not carried by freq 5200");
+		errors++;
+	}
+
+	for (freq = 5180; freq <= 5240; freq += 20) {
+		spect_ch = sap_acs_get_spect_ch(spect_info, freq);
+		if (!spect_ch->weight_calc_done ||
+		    (freq != 5200 &&
+		     spect_ch->weight != SAP_ACS_WEIGHT_MAX * 4)) {
+			acs_test_err("FAIL: freq %d not done", freq);
+			errors++;
+		}
+	}
+
+	/* 5845 is not part of the spectrum */
+	sap_acs_test_set_weight(spect_info, 5825, 10);
+	best = sap_acs_aggregate_bonded_ch(spect_info, 5825, 2,
+					   SAP_ACS_WEIGHT_MAX * 2);
+	spect_ch = sap_acs_get_spect_ch(spect_info, 5825);
+	if (best || spect_ch->weight != SAP_ACS_WEIGHT_MAX * 2) {
+		acs_test_err("FAIL: incomplete 40 MHz group not discarded");
+		errors++;
+	}
+
+	return errors;
+}
+
+/**
+ * sap_acs_test_bench() - rank the channels of a synthetic scan list
+ * @spect_info: spectrum information
+ *
+ * The channels of the scan results are looked up through the frequency
+ * index and, as a reference, through a linear search of the spectrum. The
+ * BSS counts of both have to match; the time taken by each is logged.
+ *
+ * Return: number of failed test cases
+ */
+static uint32_t sap_acs_test_bench(tSapChSelSpectInfo *spect_info)
+{
+	uint16_t *ref_count;
+	uint32_t *scan_freq;
+	tSapSpectChInfo *spect_ch;
+	uint64_t start_us, idx_us = 0, linear_us = 0;
+	uint32_t seed = 7;
+	uint32_t errors = 0;
+	uint32_t round, i;
+	uint8_t j, num = spect_info->numSpectChans;
+
+	scan_freq = qdf_mem_malloc(SAP_ACS_TEST_NUM_BSS * sizeof(*scan_freq));
+	ref_count = qdf_mem_malloc(num * sizeof(*ref_count));
+	if (!scan_freq || !ref_count) {
+		errors++;
+		goto free;
+	}
+
+	/* one result out of eight is on a channel outside of the spectrum */
+	for (i = 0; i < SAP_ACS_TEST_NUM_BSS; i++) {
+		j = cds_test_rand(&seed) % num;
+		scan_freq[i] = spect_info->pSpectCh[j].chan_freq;
+		if (!(cds_test_rand(&seed) % 8))
+			scan_freq[i] += 10;
+	}
+
+	for (round = 0; round < SAP_ACS_TEST_ROUNDS; round++) {
+		for (j = 0; j < num; j++) {
+			spect_info->pSpectCh[j].bssCount = 0;
+			ref_count[j] = 0;
+		}
+
+		start_us = qdf_get_log_timestamp_usecs();
+		for (i = 0; i < SAP_ACS_TEST_NUM_BSS; i++) {
+			for (j = 0; j < num; j++) {
+				if (spect_info->pSpectCh[j].chan_freq ==
+				    scan_freq[i]) {
+					ref_count[j]++;
+					break;
+				}
+			}
+		}
+		linear_us += qdf_get_log_timestamp_usecs() - start_us;
+
+		start_us = qdf_get_log_timestamp_usecs();
+		for (i = 0; i < SAP_ACS_TEST_NUM_BSS; i++) {
+			spect_ch = sap_acs_get_spect_ch(spect_info,
+							scan_freq[i]);
+			if (spect_ch)
+				spect_ch->bssCount++;
+		}
+		for (j = 0; j < num; j++)
+			spect_info->pSpectCh[j].weight =
+				spect_info->pSpectCh[j].bssCount * 10;
+		sap_sort_chl_weight(spect_info);
+		idx_us += qdf_get_log_timestamp_usecs() - start_us;
+
+		for (j = 0; j < num; j++) {
+			if (spect_info->pSpectCh[j].bssCount == ref_count[j])
+				continue;
+
+			acs_test_err("FAIL: freq %d counted %d BSSs, expected %d",
+				     spect_info->pSpectCh[j].chan_freq,
+				     spect_info->pSpectCh[j].bssCount,
+				     ref_count[j]);
+			errors++;
+			goto free;
+		}
+	}
+
+	errors += sap_acs_test_check_rank(spect_info);
+
+	acs_test_info("%d channels, %d BSSs x %d: indexed rank %llu us, linear lookup %llu us",
+		      num, SAP_ACS_TEST_NUM_BSS, SAP_ACS_TEST_ROUNDS,
+		      idx_us, linear_us);
+
+free:
+	qdf_mem_free(ref_count);
+	qdf_mem_free(scan_freq);
+
+	return errors;
+}
+
+uint32_t sap_acs_unit_test(void)
+{
+	tSapChSelSpectInfo spect_info = {0};
+	uint32_t errors = 0;
+
+	if (!sap_acs_test_create(&spect_info))
+		return 1;
+
+	errors += sap_acs_test_lookup(&spect_info);
+	errors += sap_acs_test_sort(&spect_info);
+	errors += sap_acs_test_bonded(&spect_info);
+	errors += sap_acs_test_bench(&spect_info);
+
+	sap_acs_spect_info_free(&spect_info);
+
+	return errors;
+}
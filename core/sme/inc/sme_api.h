@@ -4350,4 +4350,45 @@ sme_set_beacon_latency_event_cb(mac_handle_t mac_handle,
 }
 #endif
 
+#ifdef WLAN_FEATURE_PROBE_RSP_CACHE
+/**
+ * sme_get_probe_rsp_cache_stats() - get the probe response cache statistics
+ * @mac_handle: Opaque handle to the MAC context
+ * @vdev_id: vdev id of the SAP or P2P GO
+ * @stats: statistics to fill
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+sme_get_probe_rsp_cache_stats(mac_handle_t mac_handle, uint8_t vdev_id,
+			      struct sir_probe_rsp_cache_stats *stats);
+#else
+static inline QDF_STATUS
+sme_get_probe_rsp_cache_stats(mac_handle_t mac_handle, uint8_t vdev_id,
+			      struct sir_probe_rsp_cache_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif
+
+#ifdef WLAN_FEATURE_PROBE_REQ_DEDUP
+/**
+ * sme_get_probe_req_dedup_stats() - get the probe request dedup statistics
+ * @mac_handle: Opaque handle to the MAC context
+ * @stats: statistics to fill
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS
+sme_get_probe_req_dedup_stats(mac_handle_t mac_handle,
+			      struct sir_probe_req_dedup_stats *stats);
+#else
+static inline QDF_STATUS
+sme_get_probe_req_dedup_stats(mac_handle_t mac_handle,
+			      struct sir_probe_req_dedup_stats *stats)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+#endif
+
 #endif /* #if !defined( __SME_API_H ) */
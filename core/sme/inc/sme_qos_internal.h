@@ -108,4 +108,63 @@ uint8_t sme_qos_ese_retrieve_tspec_info(struct mac_context *mac, uint8_t session
 		tTspecInfo * pTspecInfo);
 #endif
 
+#ifdef WLAN_SME_QOS_TEST
+/**
+ * enum sme_qos_test_key - key a unit test looks a QoS flow up by
+ * @SME_QOS_TEST_KEY_FLOW_ID: QoS flow ID
+ * @SME_QOS_TEST_KEY_AC: access category
+ * @SME_QOS_TEST_KEY_AC_DIR: access category and TSPEC direction
+ */
+enum sme_qos_test_key {
+	SME_QOS_TEST_KEY_FLOW_ID,
+	SME_QOS_TEST_KEY_AC,
+	SME_QOS_TEST_KEY_AC_DIR,
+};
+
+/**
+ * sme_qos_test_is_idle() - check that no QoS flow exists
+ *
+ * Return: true if the flow list and its indexes are empty
+ */
+bool sme_qos_test_is_idle(void);
+
+/**
+ * sme_qos_test_add_flow() - add an admitted flow to the flow list
+ * @session_id: session of the flow
+ * @ac: access category of the flow
+ * @direction: TSPEC direction of the flow
+ * @flow_id: QoS flow ID of the flow
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS sme_qos_test_add_flow(uint8_t session_id,
+				 enum qca_wlan_ac_type ac,
+				 enum sme_qos_wmm_dir_type direction,
+				 uint32_t flow_id);
+
+/**
+ * sme_qos_test_del_flow() - remove a flow added by sme_qos_test_add_flow()
+ * @flow_id: QoS flow ID of the flow
+ *
+ * Return: QDF_STATUS_E_NOENT if the flow is not found
+ */
+QDF_STATUS sme_qos_test_del_flow(uint32_t flow_id);
+
+/**
+ * sme_qos_test_find_flow() - look a flow up the way SME QoS does
+ * @session_id: session of the flow, WLAN_MAX_VDEVS for any session
+ * @key: key to look the flow up by
+ * @ac: access category, for SME_QOS_TEST_KEY_AC(_DIR)
+ * @direction: TSPEC direction, for SME_QOS_TEST_KEY_AC_DIR
+ * @flow_id: QoS flow ID, for SME_QOS_TEST_KEY_FLOW_ID
+ *
+ * Return: QoS flow ID of the first flow matching, 0 if none does
+ */
+uint32_t sme_qos_test_find_flow(uint8_t session_id,
+				enum sme_qos_test_key key,
+				enum qca_wlan_ac_type ac,
+				enum sme_qos_wmm_dir_type direction,
+				uint32_t flow_id);
+#endif /* WLAN_SME_QOS_TEST */
+
 #endif /* #if !defined( __SMEQOSINTERNAL_H ) */
@@ -38,12 +38,30 @@
   Type declarations
   ------------------------------------------------------------------------*/
 typedef struct sRrmNeighborReportDesc {
-	tListElem List;
 	tSirNeighborBssDescription *pNeighborBssDescription;
 	uint32_t roamScore;
 	uint8_t sessionId;
 } tRrmNeighborReportDesc, *tpRrmNeighborReportDesc;
 
+/* A neighbor report never carries more than this many neighbors */
+#define RRM_NEIGHBOR_CACHE_SIZE MAX_SUPPORTED_NEIGHBOR_RPT
+
+/**
+ * struct rrm_neighbor_cache - neighbor report cache
+ * @lock: protects the cache
+ * @bss_desc: storage of the cached neighbor BSS descriptions, the first
+ *            @num_entries slots are in use
+ * @entries: cached neighbors sorted by roamScore in descending order, each
+ *           one pointing to its slot in @bss_desc
+ * @num_entries: number of cached neighbors
+ */
+struct rrm_neighbor_cache {
+	qdf_spinlock_t lock;
+	tSirNeighborBssDescription bss_desc[RRM_NEIGHBOR_CACHE_SIZE];
+	tRrmNeighborReportDesc entries[RRM_NEIGHBOR_CACHE_SIZE];
+	uint8_t num_entries;
+};
+
 typedef void (*NeighborReportRspCallback)(void *context,
 		QDF_STATUS qdf_status);
 
@@ -76,7 +94,7 @@ typedef struct sRrmSMEContext {
 	uint16_t duration[SIR_ESE_MAX_MEAS_IE_REQS];
 	uint8_t measMode[SIR_ESE_MAX_MEAS_IE_REQS];
 	uint32_t scan_id;
-	tDblLinkList neighborReportCache;
+	struct rrm_neighbor_cache neighborReportCache;
 	tRrmNeighborRequestControlInfo neighborReqControlInfo;
 
 #ifdef FEATURE_WLAN_ESE
@@ -47,6 +47,7 @@
 #include "wma.h"
 #include "wma_twt.h"
 #include "sch_api.h"
+#include "lim_api.h"
 #include "sme_nan_datapath.h"
 #include "csr_api.h"
 #include "wlan_reg_services_api.h"
@@ -16669,3 +16670,33 @@ sme_set_beacon_latency_event_cb(mac_handle_t mac_handle,
 	return qdf_status;
 }
 #endif
+
+#ifdef WLAN_FEATURE_PROBE_RSP_CACHE
+QDF_STATUS
+sme_get_probe_rsp_cache_stats(mac_handle_t mac_handle, uint8_t vdev_id,
+			      struct sir_probe_rsp_cache_stats *stats)
+{
+	QDF_STATUS qdf_status;
+	struct mac_context *mac = MAC_CONTEXT(mac_handle);
+
+	qdf_status = sme_acquire_global_lock(&mac->sme);
+	if (QDF_IS_STATUS_ERROR(qdf_status))
+		return qdf_status;
+
+	qdf_status = lim_get_probe_rsp_cache_stats(mac, vdev_id, stats);
+	sme_release_global_lock(&mac->sme);
+
+	return qdf_status;
+}
+#endif
+
+#ifdef WLAN_FEATURE_PROBE_REQ_DEDUP
+QDF_STATUS
+sme_get_probe_req_dedup_stats(mac_handle_t mac_handle,
+			      struct sir_probe_req_dedup_stats *stats)
+{
+	struct mac_context *mac = MAC_CONTEXT(mac_handle);
+
+	return lim_get_probe_req_dedup_stats(mac, stats);
+}
+#endif
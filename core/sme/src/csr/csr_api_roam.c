@@ -5239,7 +5239,7 @@ static enum csr_join_state csr_roam_join(struct mac_context *mac,
 {
 	enum csr_join_state eRoamState = eCsrContinueRoaming;
 	struct bss_description *bss_desc = &pScanResult->BssDescriptor;
-	tDot11fBeaconIEs *pIesLocal = (tDot11fBeaconIEs *) (pScanResult->pvIes);
+	tDot11fBeaconIEs *pIesLocal;
 	struct csr_roam_session *pSession = CSR_GET_SESSION(mac, sessionId);
 
 	if (!pSession) {
@@ -5247,9 +5247,8 @@ static enum csr_join_state csr_roam_join(struct mac_context *mac,
 		return eCsrStopRoaming;
 	}
 
-	if (!pIesLocal &&
-		!QDF_IS_STATUS_SUCCESS(csr_get_parsed_bss_description_ies(mac,
-				bss_desc, &pIesLocal))) {
+	pIesLocal = csr_scan_result_get_parsed_ies(mac, pScanResult);
+	if (!pIesLocal) {
 		sme_err("fail to parse IEs");
 		return eCsrStopRoaming;
 	}
@@ -5305,8 +5304,6 @@ static enum csr_join_state csr_roam_join(struct mac_context *mac,
 						pIesLocal)))
 		eRoamState = eCsrStopRoaming;
 
-	if (pIesLocal && !pScanResult->pvIes)
-		qdf_mem_free(pIesLocal);
 	return eRoamState;
 }
 
@@ -5598,21 +5595,19 @@ static void csr_roam_join_handle_profile(struct mac_context *mac_ctx,
 		qdf_mem_zero(roam_info_ptr, sizeof(struct csr_roam_info));
 		if (!scan_result)
 			cmd->u.roamCmd.roamProfile.uapsd_mask = 0;
-		else
-			ies_local = scan_result->Result.pvIes;
 
 		if (!result) {
 			sme_err(" cannot parse IEs");
 			*roam_state = eCsrStopRoaming;
 			return;
-		} else if (scan_result && !ies_local &&
-				(!QDF_IS_STATUS_SUCCESS(
-					csr_get_parsed_bss_description_ies(
-						mac_ctx, &result->BssDescriptor,
-						&ies_local)))) {
-			sme_err(" cannot parse IEs");
-			*roam_state = eCsrStopRoaming;
-			return;
+		} else if (scan_result) {
+			ies_local = csr_scan_result_get_parsed_ies(mac_ctx,
+								   result);
+			if (!ies_local) {
+				sme_err(" cannot parse IEs");
+				*roam_state = eCsrStopRoaming;
+				return;
+			}
 		}
 		roam_info_ptr->bss_desc = &result->BssDescriptor;
 		cmd->u.roamCmd.pLastRoamBss = roam_info_ptr->bss_desc;
@@ -5627,8 +5622,6 @@ static void csr_roam_join_handle_profile(struct mac_context *mac_ctx,
 		} else {
 			cmd->u.roamCmd.roamProfile.uapsd_mask = 0;
 		}
-		if (ies_local && !scan_result->Result.pvIes)
-			qdf_mem_free(ies_local);
 		roam_info_ptr->pProfile = profile;
 		session->bRefAssocStartCnt++;
 		csr_roam_call_callback(mac_ctx, session_id, roam_info_ptr,
@@ -5884,6 +5877,7 @@ QDF_STATUS csr_process_ft_reassoc_roam_command(struct mac_context *mac,
 	struct csr_roam_session *pSession;
 	struct tag_csrscan_result *pScanResult = NULL;
 	struct bss_description *bss_desc = NULL;
+	tDot11fBeaconIEs *ies;
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 
 	sessionId = pCommand->vdev_id;
@@ -5911,9 +5905,14 @@ QDF_STATUS csr_process_ft_reassoc_roam_command(struct mac_context *mac,
 		csr_roam_complete(mac, eCsrNothingToJoin, NULL, sessionId);
 		return QDF_STATUS_E_FAILURE;
 	}
-	status = csr_roam_issue_reassociate(mac, sessionId, bss_desc,
-					    (tDot11fBeaconIEs *) (pScanResult->
-								  Result.pvIes),
+	ies = csr_scan_result_get_parsed_ies(mac, &pScanResult->Result);
+	if (!ies) {
+		sme_err("fail to parse IEs");
+		csr_roam_complete(mac, eCsrNothingToJoin, NULL, sessionId);
+		return QDF_STATUS_E_FAILURE;
+	}
+
+	status = csr_roam_issue_reassociate(mac, sessionId, bss_desc, ies,
 					    &pCommand->u.roamCmd.roamProfile);
 	return status;
 }
@@ -7132,8 +7131,8 @@ static void csr_roam_process_join_res(struct mac_context *mac_ctx,
 					struct tag_csrscan_result, Link);
 			if (scan_res) {
 				bss_desc = &scan_res->Result.BssDescriptor;
-				ies_ptr = (tDot11fBeaconIEs *)
-					(scan_res->Result.pvIes);
+				ies_ptr = csr_scan_result_get_parsed_ies(
+						mac_ctx, &scan_res->Result);
 				qdf_mem_copy(&roam_info->bssid,
 					     &bss_desc->bssId,
 					     sizeof(struct qdf_mac_addr));
@@ -8254,8 +8253,11 @@ QDF_STATUS csr_roam_connect(struct mac_context *mac, uint32_t sessionId,
 		qdf_mem_free(filter);
 		goto error;
 	}
-	status = csr_scan_get_result(mac, filter, &hBSSList,
-				     opmode == QDF_STA_MODE ? true : false);
+	if (opmode == QDF_STA_MODE)
+		status = csr_scan_get_candidates(mac, filter, &hBSSList,
+						 CSR_MAX_SCORED_CANDIDATES);
+	else
+		status = csr_scan_get_result(mac, filter, &hBSSList, false);
 	qdf_mem_free(filter);
 	csr_roam_print_candidate_aps(hBSSList);
 	if (QDF_IS_STATUS_SUCCESS(status)) {
@@ -9277,7 +9279,6 @@ csr_roaming_state_config_cnf_processor(struct mac_context *mac_ctx,
 	uint32_t session_id;
 	struct csr_roam_session *session;
 	tDot11fBeaconIEs *local_ies = NULL;
-	bool is_ies_malloced = false;
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
 
 	if (!cmd) {
@@ -9342,14 +9343,10 @@ csr_roaming_state_config_cnf_processor(struct mac_context *mac_ctx,
 		return;
 	}
 
-	local_ies = (tDot11fBeaconIEs *) scan_result->Result.pvIes;
-	if (!local_ies) {
-		status = csr_get_parsed_bss_description_ies(mac_ctx, bss_desc,
-							    &local_ies);
-		if (!QDF_IS_STATUS_SUCCESS(status))
-			return;
-		is_ies_malloced = true;
-	}
+	local_ies = csr_scan_result_get_parsed_ies(mac_ctx,
+						   &scan_result->Result);
+	if (!local_ies)
+		return;
 
 	if (csr_is_conn_state_connected_infra(mac_ctx, session_id)) {
 		if (csr_is_ssid_equal(mac_ctx, session->pConnectBssDesc,
@@ -9418,10 +9415,6 @@ csr_roaming_state_config_cnf_processor(struct mac_context *mac_ctx,
 			csr_roam(mac_ctx, cmd, false);
 		}
 	}
-	if (is_ies_malloced) {
-		/* Locally allocated */
-		qdf_mem_free(local_ies);
-	}
 }
 
 static void csr_roam_roaming_state_reassoc_rsp_processor(struct mac_context *mac,
@@ -14797,6 +14790,7 @@ QDF_STATUS csr_send_join_req_msg(struct mac_context *mac, uint32_t sessionId,
 	struct wlan_objmgr_vdev *vdev;
 	bool follow_ap_edca;
 	bool reconn_after_assoc_timeout = false;
+	uint32_t vendor_ap_actions;
 
 	if (!pSession) {
 		sme_err("session %d not found", sessionId);
@@ -14951,9 +14945,13 @@ QDF_STATUS csr_send_join_req_msg(struct mac_context *mac, uint32_t sessionId,
 			pSession->vdev_nss = vdev_type_nss->sta;
 		pSession->nss = pSession->vdev_nss;
 
-		force_max_nss = ucfg_action_oui_search(mac->psoc,
-						&vendor_ap_search_attr,
-						ACTION_OUI_FORCE_MAX_NSS);
+		/* all the actions are matched in one pass over the IEs */
+		vendor_ap_actions =
+			ucfg_action_oui_search_all(mac->psoc,
+						   &vendor_ap_search_attr);
+
+		force_max_nss = !!(vendor_ap_actions &
+				   BIT(ACTION_OUI_FORCE_MAX_NSS));
 
 		if (!mac->mlme_cfg->vht_caps.vht_cap_info.enable2x2) {
 			force_max_nss = false;
@@ -14974,13 +14972,11 @@ QDF_STATUS csr_send_join_req_msg(struct mac_context *mac, uint32_t sessionId,
 		if (pSession->nss == 1)
 			pSession->supported_nss_1x1 = true;
 
-		follow_ap_edca = ucfg_action_oui_search(mac->psoc,
-					    &vendor_ap_search_attr,
-					    ACTION_OUI_DISABLE_AGGRESSIVE_EDCA);
+		follow_ap_edca = !!(vendor_ap_actions &
+				    BIT(ACTION_OUI_DISABLE_AGGRESSIVE_EDCA));
 
 		if (messageType == eWNI_SME_JOIN_REQ &&
-		    ucfg_action_oui_search(mac->psoc, &vendor_ap_search_attr,
-					   ACTION_OUI_HOST_RECONN))
+		    vendor_ap_actions & BIT(ACTION_OUI_HOST_RECONN))
 			reconn_after_assoc_timeout = true;
 		mlme_set_reconn_after_assoc_timeout_flag(
 				mac->psoc, sessionId,
@@ -14994,10 +14990,8 @@ QDF_STATUS csr_send_join_req_msg(struct mac_context *mac, uint32_t sessionId,
 			wlan_objmgr_vdev_release_ref(vdev, WLAN_LEGACY_MAC_ID);
 		}
 
-		is_vendor_ap_present =
-				ucfg_action_oui_search(mac->psoc,
-						       &vendor_ap_search_attr,
-						       ACTION_OUI_CONNECT_1X1);
+		is_vendor_ap_present = !!(vendor_ap_actions &
+					  BIT(ACTION_OUI_CONNECT_1X1));
 
 		if (is_vendor_ap_present) {
 			is_vendor_ap_present = csr_check_vendor_ap_3_present(
@@ -15014,10 +15008,8 @@ QDF_STATUS csr_send_join_req_msg(struct mac_context *mac, uint32_t sessionId,
 		 */
 
 		if (!is_vendor_ap_present) {
-			is_vendor_ap_present =
-				ucfg_action_oui_search(mac->psoc,
-					&vendor_ap_search_attr,
-					ACTION_OUI_CONNECT_1X1_WITH_1_CHAIN);
+			is_vendor_ap_present = !!(vendor_ap_actions &
+				BIT(ACTION_OUI_CONNECT_1X1_WITH_1_CHAIN));
 			if (is_vendor_ap_present)
 				sme_debug("1x1 with 1 Chain AP");
 		}
@@ -15043,10 +15035,8 @@ QDF_STATUS csr_send_join_req_msg(struct mac_context *mac, uint32_t sessionId,
 		 * If CCK WAR is set for current AP, update to firmware via
 		 * WMI_VDEV_PARAM_ABG_MODE_TX_CHAIN_NUM
 		 */
-		is_vendor_ap_present =
-				ucfg_action_oui_search(mac->psoc,
-						       &vendor_ap_search_attr,
-						       ACTION_OUI_CCKM_1X1);
+		is_vendor_ap_present = !!(vendor_ap_actions &
+					  BIT(ACTION_OUI_CCKM_1X1));
 		if (is_vendor_ap_present) {
 			sme_debug("vdev: %d WMI_VDEV_PARAM_ABG_MODE_TX_CHAIN_NUM 1",
 				 pSession->sessionId);
@@ -15060,10 +15050,8 @@ QDF_STATUS csr_send_join_req_msg(struct mac_context *mac, uint32_t sessionId,
 		 * If Switch to 11N WAR is set for current AP, change dot11
 		 * mode to 11N.
 		 */
-		is_vendor_ap_present =
-			ucfg_action_oui_search(mac->psoc,
-					       &vendor_ap_search_attr,
-					       ACTION_OUI_SWITCH_TO_11N_MODE);
+		is_vendor_ap_present = !!(vendor_ap_actions &
+					  BIT(ACTION_OUI_SWITCH_TO_11N_MODE));
 		if (mac->roam.configParam.is_force_1x1 &&
 		    mac->mlme_cfg->gen.as_enabled &&
 		    is_vendor_ap_present &&
@@ -23286,14 +23274,12 @@ csr_process_roam_sync_callback(struct mac_context *mac_ctx,
 		goto end;
 	}
 	qdf_mem_copy(roam_info->pbFrames,
-			(uint8_t *)roam_synch_data +
-			roam_synch_data->reassoc_req_offset +
+			roam_synch_data->reassoc_req +
 			SIR_MAC_HDR_LEN_3A + ssid_offset,
 			roam_info->nAssocReqLength);
 
 	qdf_mem_copy(roam_info->pbFrames + roam_info->nAssocReqLength,
-			(uint8_t *)roam_synch_data +
-			roam_synch_data->reassocRespOffset +
+			roam_synch_data->reassoc_rsp +
 			SIR_MAC_HDR_LEN_3A,
 			roam_info->nAssocRspLength);
 
@@ -23363,8 +23349,9 @@ csr_process_roam_sync_callback(struct mac_context *mac_ctx,
 	sme_qos_csr_event_ind(mac_ctx, session_id,
 		SME_QOS_CSR_REASSOC_COMPLETE, &assoc_info);
 	roam_info->bss_desc = bss_desc;
+	/* Reuse the IEs parsed above rather than unpacking them per AC */
 	conn_profile->acm_mask = sme_qos_get_acm_mask(mac_ctx,
-			bss_desc, NULL);
+			bss_desc, ies_local);
 	if (conn_profile->modifyProfileFields.uapsd_mask) {
 		sme_debug(
 				" uapsd_mask (0x%X) set, request UAPSD now",
@@ -23423,6 +23410,8 @@ csr_process_roam_sync_callback(struct mac_context *mac_ctx,
 	sme_debug("Update roam reason : %d", roam_info->roam_reason);
 	csr_copy_fils_join_rsp_roam_info(roam_info, roam_synch_data);
 
+	wlan_cm_roam_latency_record(mac_ctx->psoc, session_id,
+				    ROAM_LATENCY_STAGE_CSR_PROPAGATION);
 	csr_roam_call_callback(mac_ctx, session_id, roam_info, 0,
 		eCSR_ROAM_ASSOCIATION_COMPLETION, eCSR_ROAM_RESULT_ASSOCIATED);
 	csr_reset_pmkid_candidate_list(mac_ctx, session_id);
@@ -165,7 +165,8 @@ QDF_STATUS csr_scan_handle_search_for_ssid(struct mac_context *mac_ctx,
 			qdf_mem_free(filter);
 			break;
 		}
-		status = csr_scan_get_result(mac_ctx, filter, &hBSSList, true);
+		status = csr_scan_get_candidates(mac_ctx, filter, &hBSSList,
+						 CSR_MAX_SCORED_CANDIDATES);
 		qdf_mem_free(filter);
 		if (!QDF_IS_STATUS_SUCCESS(status))
 			break;
@@ -1278,6 +1279,23 @@ tCsrScanResultInfo *csr_scan_result_get_next(struct mac_context *mac,
 	return pRet;
 }
 
+tDot11fBeaconIEs *csr_scan_result_get_parsed_ies(struct mac_context *mac,
+						 tCsrScanResultInfo *result)
+{
+	tDot11fBeaconIEs *ies;
+
+	if (result->pvIes)
+		return result->pvIes;
+
+	if (QDF_IS_STATUS_ERROR(csr_get_parsed_bss_description_ies(mac,
+					&result->BssDescriptor, &ies)))
+		return NULL;
+
+	result->pvIes = ies;
+
+	return ies;
+}
+
 /**
  * csr_scan_for_ssid() -  Function usually used for BSSs that suppresses SSID
  * @mac_ctx: Pointer to Global Mac structure
@@ -2163,18 +2181,74 @@ csr_fill_single_pmk_ap_cap_from_scan_entry(struct bss_description *bss_desc,
 }
 #endif
 
+/* MDID (2 bytes) and FT capability and policy (1 byte) */
+#define CSR_MDIE_BODY_LEN 3
+/* station count (2), channel utilization (1), admission capacity (2) */
+#define CSR_QBSS_LOAD_BODY_LEN 5
+#define CSR_QBSS_LOAD_AVAIL_OFFSET 3
+
+/**
+ * csr_fill_mdie_from_scan_entry() - fill mobility domain from scan entry
+ * @bss_desc: bss description to fill
+ * @scan_entry: scan entry
+ *
+ * Return: None
+ */
+static void csr_fill_mdie_from_scan_entry(struct bss_description *bss_desc,
+					  struct scan_cache_entry *scan_entry)
+{
+	uint8_t *mdie = util_scan_entry_mdie(scan_entry);
+
+	if (!mdie || mdie[1] < CSR_MDIE_BODY_LEN)
+		return;
+
+	bss_desc->mdiePresent = true;
+	/* MDID followed by the overDS and resourceReq capability bits */
+	bss_desc->mdie[0] = mdie[2];
+	bss_desc->mdie[1] = mdie[3];
+	bss_desc->mdie[2] = mdie[4] & 0x03;
+}
+
+#ifdef FEATURE_WLAN_ESE
+/**
+ * csr_fill_qbss_load_from_scan_entry() - fill QBSS load from scan entry
+ * @bss_desc: bss description to fill
+ * @scan_entry: scan entry
+ *
+ * Return: None
+ */
+static void
+csr_fill_qbss_load_from_scan_entry(struct bss_description *bss_desc,
+				   struct scan_cache_entry *scan_entry)
+{
+	uint8_t *qbss_load = util_scan_entry_qbssload(scan_entry);
+	uint8_t *avail;
+
+	if (!qbss_load || qbss_load[1] < CSR_QBSS_LOAD_BODY_LEN)
+		return;
+
+	avail = &qbss_load[2 + CSR_QBSS_LOAD_AVAIL_OFFSET];
+	bss_desc->QBSSLoad_present = true;
+	bss_desc->QBSSLoad_avail = avail[0] | (avail[1] << 8);
+}
+#else
+static inline void
+csr_fill_qbss_load_from_scan_entry(struct bss_description *bss_desc,
+				   struct scan_cache_entry *scan_entry)
+{
+}
+#endif
+
 static QDF_STATUS csr_fill_bss_from_scan_entry(struct mac_context *mac_ctx,
 					struct scan_cache_entry *scan_entry,
 					struct tag_csrscan_result **p_result)
 {
-	tDot11fBeaconIEs *bcn_ies;
 	struct bss_description *bss_desc;
 	tCsrScanResultInfo *result_info;
 	tpSirMacMgmtHdr hdr;
 	uint8_t *ie_ptr;
 	struct tag_csrscan_result *bss;
 	uint32_t bss_len, alloc_len, ie_len;
-	QDF_STATUS status;
 	enum channel_state ap_channel_state;
 
 	ap_channel_state =
@@ -2264,55 +2338,57 @@ static QDF_STATUS csr_fill_bss_from_scan_entry(struct mac_context *mac_ctx,
 	qdf_mem_copy((uint8_t *) &bss_desc->ieFields,
 		ie_ptr, ie_len);
 
-	status = csr_get_parsed_bss_description_ies(mac_ctx,
-			  bss_desc, &bcn_ies);
-	if (QDF_IS_STATUS_ERROR(status)) {
-		qdf_mem_free(bss);
-		return status;
-	}
-	result_info->pvIes = bcn_ies;
-
-	if (bcn_ies->MobilityDomain.present) {
-		bss_desc->mdiePresent = true;
-		qdf_mem_copy((uint8_t *)&(bss_desc->mdie[0]),
-			     (uint8_t *)&(bcn_ies->MobilityDomain.MDID),
-			     sizeof(uint16_t));
-		bss_desc->mdie[2] =
-			((bcn_ies->MobilityDomain.overDSCap << 0) |
-			(bcn_ies->MobilityDomain.resourceReqCap << 1));
-	}
-#ifdef FEATURE_WLAN_ESE
-	if (bcn_ies->QBSSLoad.present) {
-		bss_desc->QBSSLoad_present = true;
-		bss_desc->QBSSLoad_avail =
-			bcn_ies->QBSSLoad.avail;
-	}
-#endif
+	/*
+	 * The IEs are unpacked into tDot11fBeaconIEs only when a consumer
+	 * asks for them, see csr_scan_result_get_parsed_ies(). Most entries
+	 * of a result list are never looked at beyond their score, so take
+	 * the few fields needed here from the IEs the scan module already
+	 * located in the scan entry.
+	 */
+	result_info->pvIes = NULL;
+	csr_fill_mdie_from_scan_entry(bss_desc, scan_entry);
+	csr_fill_qbss_load_from_scan_entry(bss_desc, scan_entry);
 	csr_update_bss_with_fils_data(mac_ctx, scan_entry, bss_desc);
 
 	*p_result = bss;
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * csr_parse_scan_list() - convert scan cache entries into csr scan results
+ * @mac_ctx: Pointer to Global MAC structure
+ * @ret_list: list to add the converted results to
+ * @scan_list: scan cache entries, sorted by score if scoring was done
+ * @max_bss: max number of results to convert, 0 for no limit
+ *
+ * Return: QDF_STATUS
+ */
 static QDF_STATUS csr_parse_scan_list(struct mac_context *mac_ctx,
 				      struct scan_result_list *ret_list,
-				      qdf_list_t *scan_list)
+				      qdf_list_t *scan_list,
+				      uint32_t max_bss)
 {
 	struct tag_csrscan_result *pResult = NULL;
 	struct scan_cache_node *cur_node = NULL;
 	struct scan_cache_node *next_node = NULL;
+	uint32_t num_bss = 0;
 
 	qdf_list_peek_front(scan_list, (qdf_list_node_t **) &cur_node);
 
 	while (cur_node) {
+		if (max_bss && num_bss >= max_bss)
+			break;
+
 		qdf_list_peek_next(scan_list, (qdf_list_node_t *) cur_node,
 				  (qdf_list_node_t **) &next_node);
 		pResult = NULL;
 		csr_fill_bss_from_scan_entry(mac_ctx,
 					     cur_node->entry, &pResult);
-		if (pResult)
+		if (pResult) {
 			csr_ll_insert_tail(&ret_list->List, &pResult->Link,
 					   LL_ACCESS_NOLOCK);
+			num_bss++;
+		}
 		cur_node = next_node;
 		next_node = NULL;
 	}
@@ -2362,10 +2438,21 @@ static void csr_calculate_scores(struct mac_context *mac_ctx,
 		qdf_mem_free(pcl_lst);
 }
 
-QDF_STATUS csr_scan_get_result(struct mac_context *mac_ctx,
-			       struct scan_filter *filter,
-			       tScanResultHandle *results,
-			       bool scoring_required)
+/**
+ * __csr_scan_get_result() - get scan results based on filter
+ * @mac_ctx: Pointer to Global MAC structure
+ * @filter: scan filter
+ * @results: an object for the result
+ * @scoring_required: if scoring is required for AP
+ * @max_bss: max number of results to return, 0 for no limit
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS __csr_scan_get_result(struct mac_context *mac_ctx,
+					struct scan_filter *filter,
+					tScanResultHandle *results,
+					bool scoring_required,
+					uint32_t max_bss)
 {
 	QDF_STATUS status;
 	struct scan_result_list *ret_list = NULL;
@@ -2409,7 +2496,7 @@ QDF_STATUS csr_scan_get_result(struct mac_context *mac_ctx,
 
 	csr_ll_open(&ret_list->List);
 	ret_list->pCurEntry = NULL;
-	status = csr_parse_scan_list(mac_ctx, ret_list, list);
+	status = csr_parse_scan_list(mac_ctx, ret_list, list, max_bss);
 	if (QDF_IS_STATUS_ERROR(status) || !results)
 		/* Fail or No one wants the result. */
 		csr_scan_result_purge(mac_ctx, (tScanResultHandle) ret_list);
@@ -2441,6 +2528,28 @@ error:
 	return status;
 }
 
+QDF_STATUS csr_scan_get_result(struct mac_context *mac_ctx,
+			       struct scan_filter *filter,
+			       tScanResultHandle *results,
+			       bool scoring_required)
+{
+	return __csr_scan_get_result(mac_ctx, filter, results,
+				     scoring_required, 0);
+}
+
+QDF_STATUS csr_scan_get_candidates(struct mac_context *mac_ctx,
+				   struct scan_filter *filter,
+				   tScanResultHandle *results,
+				   uint32_t max_candidates)
+{
+	/* Results are only sorted by score if there is a filter */
+	if (!filter)
+		max_candidates = 0;
+
+	return __csr_scan_get_result(mac_ctx, filter, results, true,
+				     max_candidates);
+}
+
 QDF_STATUS csr_scan_get_result_for_bssid(struct mac_context *mac_ctx,
 					 struct qdf_mac_addr *bssid,
 					 tCsrScanResultInfo *res)
@@ -2464,8 +2573,8 @@ QDF_STATUS csr_scan_get_result_for_bssid(struct mac_context *mac_ctx,
 	qdf_mem_copy(scan_filter->bssid_list[0].bytes, bssid->bytes,
 		     QDF_MAC_ADDR_SIZE);
 
-	status = csr_scan_get_result(mac_ctx, scan_filter,
-				&filtered_scan_result, false);
+	status = __csr_scan_get_result(mac_ctx, scan_filter,
+				       &filtered_scan_result, false, 1);
 
 	if (!QDF_IS_STATUS_SUCCESS(status)) {
 		sme_err("Failed to get scan result");
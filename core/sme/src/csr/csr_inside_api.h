@@ -42,6 +42,12 @@
  * (command timeout/5000 - 1) candidates.
  * ***************************************************************************/
 #define CSR_MAX_BSSID_COUNT     (SME_ACTIVE_LIST_CMD_TIMEOUT_VALUE/5000) - 1
+/*
+ * Number of best scored candidates converted for a connect. Some candidates
+ * are skipped without a join attempt (e.g. blacklisted or not allowed by
+ * concurrency), so keep a few times CSR_MAX_BSSID_COUNT of them.
+ */
+#define CSR_MAX_SCORED_CANDIDATES ((CSR_MAX_BSSID_COUNT) * 4)
 #define CSR_CUSTOM_CONC_GO_BI    100
 extern uint8_t csr_wpa_oui[][CSR_WPA_OUI_SIZE];
 bool csr_is_supported_channel(struct mac_context *mac, uint32_t chan_freq);
@@ -472,6 +478,24 @@ QDF_STATUS csr_scan_get_result(struct mac_context *mac,
 			       tScanResultHandle *phResult,
 			       bool scoring_required);
 
+/**
+ * csr_scan_get_candidates() - Return best scored scan results based on filter
+ * @mac: Pointer to Global MAC structure
+ * @filter: scan filter
+ * @results: an object for the result
+ * @max_candidates: max number of results to return
+ *
+ * Same as csr_scan_get_result() with scoring, but only the @max_candidates
+ * best scored entries are converted into the result, the rest of the scan
+ * list is dropped right after scoring.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS csr_scan_get_candidates(struct mac_context *mac,
+				   struct scan_filter *filter,
+				   tScanResultHandle *results,
+				   uint32_t max_candidates);
+
 /**
  * csr_scan_get_result_for_bssid - gets the scan result from scan cache for the
  *      bssid specified
@@ -514,6 +538,20 @@ tCsrScanResultInfo *csr_scan_result_get_first(struct mac_context *mac,
 tCsrScanResultInfo *csr_scan_result_get_next(struct mac_context *mac,
 					     tScanResultHandle hScanResult);
 
+/**
+ * csr_scan_result_get_parsed_ies() - get unpacked IEs of a scan result
+ * @mac: Pointer to Global MAC structure
+ * @result: scan result returned from csr_scan_result_get_first/next
+ *
+ * Scan results are built without unpacking their IEs. They are unpacked on
+ * the first call to this API and cached in the result, so they are freed
+ * together with the result list.
+ *
+ * Return: unpacked IEs, NULL if they cannot be parsed
+ */
+tDot11fBeaconIEs *csr_scan_result_get_parsed_ies(struct mac_context *mac,
+						 tCsrScanResultInfo *result);
+
 /*
  * csr_get_regulatory_domain_for_country() -
  * This function is to get the regulatory domain for a country.
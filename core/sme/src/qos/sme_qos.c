@@ -70,6 +70,8 @@
 #define SME_QOS_SEARCH_KEY_INDEX_5       0x10   /* ac + tspec_mask */
 /* special value for searching any Session Id */
 #define SME_QOS_SEARCH_SESSION_ID_ANY    WLAN_MAX_VDEVS
+/* number of buckets in the flow ID index, must be a power of 2 */
+#define SME_QOS_FLOW_ID_HASH_SIZE        32
 #define SME_QOS_ACCESS_POLICY_EDCA       1
 #define SME_QOS_MAX_TID                  255
 #define SME_QOS_TSPEC_IE_LENGTH          61
@@ -144,6 +146,8 @@ enum qca_wlan_ac_type sme_qos_up_to_ac_map[SME_QOS_WMM_UP_MAX] = {
  */
 struct sme_qos_flowinfoentry {
 	tListElem link;         /* list links */
+	qdf_list_node_t flow_id_node;   /* links in the flow ID index */
+	qdf_list_node_t ac_node;        /* links in the session/AC index */
 	uint8_t sessionId;
 	uint8_t tspec_mask;
 	enum sme_qos_reasontype reason;
@@ -448,6 +452,9 @@ static QDF_STATUS sme_qos_request_reassoc(struct mac_context *mac,
 					  tCsrRoamModifyProfileFields *
 					  pModFields, bool fForce);
 static uint32_t sme_qos_assign_flow_id(void);
+static void sme_qos_add_flow_entry(struct sme_qos_flowinfoentry *flow_info);
+static void sme_qos_remove_flow_entry(struct sme_qos_flowinfoentry *flow_info);
+static void sme_qos_free_flow_list(void);
 static uint8_t sme_qos_assign_dialog_token(void);
 static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionId,
 					   struct sme_qos_searchinfo search_key,
@@ -464,6 +471,10 @@ struct sme_qos_cb_s {
 	struct sme_qos_sessioninfo *sessionInfo;
 	/* All FLOW info */
 	tDblLinkList flow_list;
+	/* flow_list entries hashed on their flow ID */
+	qdf_list_t flow_id_hash[SME_QOS_FLOW_ID_HASH_SIZE];
+	/* flow_list entries of each session & AC, in flow_list order */
+	qdf_list_t ac_flow_list[WLAN_MAX_VDEVS][QCA_WLAN_AC_ALL];
 	/* default TSPEC params */
 	struct sme_qos_wmmtspecinfo *def_QoSInfo;
 	/* counter for assigning Flow IDs */
@@ -538,8 +549,10 @@ static inline void sme_qos_free_control_block_buffer(void)
 QDF_STATUS sme_qos_open(struct mac_context *mac)
 {
 	struct sme_qos_sessioninfo *pSession;
+	enum qca_wlan_ac_type ac;
 	uint8_t sessionId;
 	QDF_STATUS status;
+	uint8_t i;
 
 	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 		  "%s: %d: initializing SME-QoS module", __func__, __LINE__);
@@ -564,10 +577,15 @@ QDF_STATUS sme_qos_open(struct mac_context *mac)
 		sme_qos_free_control_block_buffer();
 		return QDF_STATUS_E_FAILURE;
 	}
+	for (i = 0; i < SME_QOS_FLOW_ID_HASH_SIZE; i++)
+		qdf_list_create(&sme_qos_cb.flow_id_hash[i], 0);
 
 	for (sessionId = 0; sessionId < WLAN_MAX_VDEVS; ++sessionId) {
 		pSession = &sme_qos_cb.sessionInfo[sessionId];
 		pSession->sessionId = sessionId;
+		for (ac = QCA_WLAN_AC_BE; ac < QCA_WLAN_AC_ALL; ac++)
+			qdf_list_create(&sme_qos_cb.ac_flow_list[sessionId][ac],
+					0);
 		/* initialize the session's per-AC information */
 		sme_qos_init_a_cs(mac, sessionId);
 		/* initialize the session's buffered command list */
@@ -605,7 +623,8 @@ QDF_STATUS sme_qos_close(struct mac_context *mac)
 		  "%s: %d: closing down SME-QoS", __func__, __LINE__);
 
 	/* cleanup control block */
-	/* close the flow list */
+	/* free the flows left and their indexes, then close the flow list */
+	sme_qos_free_flow_list();
 	csr_ll_close(&sme_qos_cb.flow_list);
 	/* shut down all of the sessions */
 	for (sessionId = 0; sessionId < WLAN_MAX_VDEVS; ++sessionId) {
@@ -1210,8 +1229,7 @@ static enum sme_qos_statustype sme_qos_internal_setup_req(struct mac_context *ma
 				  "%s: %d: Creating entry on session %d at %pK with flowID %d",
 				  __func__, __LINE__,
 				  sessionId, pentry, QosFlowID);
-			csr_ll_insert_tail(&sme_qos_cb.flow_list, &pentry->link,
-					   true);
+			sme_qos_add_flow_entry(pentry);
 		} else {
 			/* unexpected status returned by sme_qos_setup() */
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
@@ -1567,8 +1585,7 @@ static enum sme_qos_statustype sme_qos_internal_setup_req(struct mac_context *ma
 				  "%s: %d: On session %d creating entry at %pK with flowID %d",
 				  __func__, __LINE__,
 				  sessionId, pentry, QosFlowID);
-			csr_ll_insert_tail(&sme_qos_cb.flow_list, &pentry->link,
-					   true);
+			sme_qos_add_flow_entry(pentry);
 		} else {
 			/* unexpected status returned by sme_qos_setup() */
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
@@ -1776,8 +1793,7 @@ static enum sme_qos_statustype sme_qos_internal_modify_req(struct mac_context *m
 			  __func__, __LINE__,
 			  sessionId, pNewEntry, pNewEntry->QosFlowID);
 		/* add the new entry under construction to the Flow List */
-		csr_ll_insert_tail(&sme_qos_cb.flow_list, &pNewEntry->link,
-				   true);
+		sme_qos_add_flow_entry(pNewEntry);
 		/* update TSPEC with the new param set */
 		hstatus = sme_qos_update_params(sessionId,
 						ac, pNewEntry->tspec_mask,
@@ -2248,8 +2264,7 @@ static enum sme_qos_statustype sme_qos_internal_release_req(struct mac_context *
 						  "%s: %d: Deleting entry at %pK with flowID %d",
 						  __func__, __LINE__, flow_info,
 						  QosFlowID);
-					csr_ll_remove_entry(&sme_qos_cb.
-						flow_list, pEntry, true);
+					sme_qos_remove_flow_entry(flow_info);
 					pDeletedFlow = flow_info;
 					if (SME_QOS_STATUS_SETUP_SUCCESS_APSD_SET_ALREADY == status) {
 						qdf_mem_zero(&search_key,
@@ -2311,9 +2326,7 @@ static enum sme_qos_statustype sme_qos_internal_release_req(struct mac_context *
 						  "%s: %d: On session %d deleting entry at %pK with flowID %d",
 						__func__, __LINE__, sessionId,
 						  flow_info, QosFlowID);
-					csr_ll_remove_entry(&sme_qos_cb.
-								flow_list,
-							    pEntry, true);
+					sme_qos_remove_flow_entry(flow_info);
 					pDeletedFlow = flow_info;
 					if (buffered_cmd) {
 						flow_info->QoSCallback(MAC_HANDLE(mac),
@@ -2535,8 +2548,7 @@ static enum sme_qos_statustype sme_qos_internal_release_req(struct mac_context *
 				  "%s: %d: On session %d deleting entry at %pK with flowID %d",
 				  __func__, __LINE__,
 				  sessionId, flow_info, QosFlowID);
-			csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry,
-					    true);
+			sme_qos_remove_flow_entry(flow_info);
 			pDeletedFlow = flow_info;
 			pACInfo->relTrig = SME_QOS_RELEASE_DEFAULT;
 		}
@@ -5267,10 +5279,11 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionid,
 						search_key,
 					    uint8_t new_tspec_mask)
 {
-	tListElem *list_elt = NULL, *list_next_elt = NULL;
 	struct sme_qos_flowinfoentry *flow_info = NULL;
+	qdf_list_node_t *node = NULL, *next_node = NULL;
 	struct sme_qos_sessioninfo *qos_session;
 	struct sme_qos_acinfo *ac_info;
+	qdf_list_t *ac_flow_list;
 
 	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 		  FL("invoked on session %d for AC %d TSPEC %d"),
@@ -5286,23 +5299,18 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionid,
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	list_elt = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-	if (!list_elt) {
+	/* only the flows of this session & AC can match */
+	ac_flow_list = sme_qos_get_ac_flow_list(&search_key);
+	if (!ac_flow_list ||
+	    QDF_IS_STATUS_ERROR(qdf_list_peek_front(ac_flow_list, &node))) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
 			  FL("Flow List empty, nothing to update"));
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	while (list_elt) {
-		list_next_elt = csr_ll_next(&sme_qos_cb.flow_list, list_elt,
-					    false);
-		flow_info = GET_BASE_ADDR(list_elt, struct
-					sme_qos_flowinfoentry, link);
-
-		if (search_key.sessionId != flow_info->sessionId) {
-			list_elt = list_next_elt;
-			continue;
-		}
+	while (node) {
+		flow_info = GET_BASE_ADDR(node, struct sme_qos_flowinfoentry,
+					  ac_node);
 
 		if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_4) {
 			if ((search_key.key.ac_type == flow_info->ac_type) &&
@@ -5326,7 +5334,10 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionid,
 				flow_info->tspec_mask = new_tspec_mask;
 			}
 		}
-		list_elt = list_next_elt;
+		if (QDF_IS_STATUS_ERROR(qdf_list_peek_next(ac_flow_list, node,
+							   &next_node)))
+			break;
+		node = next_node;
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -5881,6 +5892,179 @@ static void sme_qos_state_transition(uint8_t sessionId,
 			  pACInfo->prev_state, ac);
 }
 
+/**
+ * sme_qos_flow_id_bucket() - get the flow ID index bucket of a flow
+ * @flow_id: QoS flow ID
+ *
+ * Return: bucket of the flow ID index the flow is hashed into
+ */
+static inline qdf_list_t *sme_qos_flow_id_bucket(uint32_t flow_id)
+{
+	return &sme_qos_cb.flow_id_hash[flow_id &
+					(SME_QOS_FLOW_ID_HASH_SIZE - 1)];
+}
+
+/**
+ * sme_qos_add_flow_entry() - add an entry at the end of the flow list
+ * @flow_info: flow entry, with its session, AC & flow ID already set
+ *
+ * Besides flow_list, the entry is linked into the flow ID index and into
+ * the index of its session & AC, so that the searches done on every ADDTS
+ * and DELTS do not have to walk the flows of all sessions.
+ *
+ * Return: None
+ */
+static void sme_qos_add_flow_entry(struct sme_qos_flowinfoentry *flow_info)
+{
+	csr_ll_insert_tail(&sme_qos_cb.flow_list, &flow_info->link, true);
+	qdf_list_insert_back(sme_qos_flow_id_bucket(flow_info->QosFlowID),
+			     &flow_info->flow_id_node);
+	qdf_list_insert_back(&sme_qos_cb.ac_flow_list[flow_info->sessionId]
+						     [flow_info->ac_type],
+			     &flow_info->ac_node);
+}
+
+/**
+ * sme_qos_remove_flow_entry() - remove an entry from the flow list
+ * @flow_info: flow entry added by sme_qos_add_flow_entry()
+ *
+ * The entry is unlinked from flow_list and from both indexes, the caller
+ * still owns its memory.
+ *
+ * Return: None
+ */
+static void sme_qos_remove_flow_entry(struct sme_qos_flowinfoentry *flow_info)
+{
+	csr_ll_remove_entry(&sme_qos_cb.flow_list, &flow_info->link, true);
+	qdf_list_remove_node(sme_qos_flow_id_bucket(flow_info->QosFlowID),
+			     &flow_info->flow_id_node);
+	qdf_list_remove_node(&sme_qos_cb.ac_flow_list[flow_info->sessionId]
+						     [flow_info->ac_type],
+			     &flow_info->ac_node);
+}
+
+/**
+ * sme_qos_free_flow_list() - free every flow entry and the flow indexes
+ *
+ * Called when the module is closed, with no other user of the flow list.
+ *
+ * Return: None
+ */
+static void sme_qos_free_flow_list(void)
+{
+	struct sme_qos_flowinfoentry *flow_info;
+	enum qca_wlan_ac_type ac;
+	tListElem *entry;
+	uint8_t session_id;
+	uint8_t i;
+
+	while ((entry = csr_ll_peek_head(&sme_qos_cb.flow_list, true))) {
+		flow_info = GET_BASE_ADDR(entry, struct sme_qos_flowinfoentry,
+					  link);
+		sme_qos_remove_flow_entry(flow_info);
+		qdf_mem_free(flow_info);
+	}
+
+	for (i = 0; i < SME_QOS_FLOW_ID_HASH_SIZE; i++)
+		qdf_list_destroy(&sme_qos_cb.flow_id_hash[i]);
+
+	for (session_id = 0; session_id < WLAN_MAX_VDEVS; session_id++)
+		for (ac = QCA_WLAN_AC_BE; ac < QCA_WLAN_AC_ALL; ac++)
+			qdf_list_destroy(
+				&sme_qos_cb.ac_flow_list[session_id][ac]);
+}
+
+/**
+ * sme_qos_get_ac_flow_list() - get the flows of a session & AC
+ * @search_key: search key holding the session & AC
+ *
+ * Return: index list of the session & AC, NULL if the search is not
+ * restricted to a single valid session & AC
+ */
+static qdf_list_t *sme_qos_get_ac_flow_list(struct sme_qos_searchinfo
+						*search_key)
+{
+	if (search_key->sessionId >= WLAN_MAX_VDEVS ||
+	    search_key->key.ac_type >= QCA_WLAN_AC_ALL)
+		return NULL;
+
+	return &sme_qos_cb.ac_flow_list[search_key->sessionId]
+				       [search_key->key.ac_type];
+}
+
+/**
+ * sme_qos_flow_from_node() - get the flow entry of an index node
+ * @node: node in either the flow ID or the session/AC index
+ * @flow_id_index: true if @node belongs to the flow ID index
+ *
+ * Return: flow entry
+ */
+static inline struct sme_qos_flowinfoentry *
+sme_qos_flow_from_node(qdf_list_node_t *node, bool flow_id_index)
+{
+	if (flow_id_index)
+		return GET_BASE_ADDR(node, struct sme_qos_flowinfoentry,
+				     flow_id_node);
+
+	return GET_BASE_ADDR(node, struct sme_qos_flowinfoentry, ac_node);
+}
+
+/**
+ * sme_qos_is_flow_match() - check a flow entry against a search key
+ * @search_key: search key
+ * @flow_info: flow entry
+ *
+ * Return: true if @flow_info matches the key selected by @search_key
+ */
+static bool sme_qos_is_flow_match(struct sme_qos_searchinfo *search_key,
+				  struct sme_qos_flowinfoentry *flow_info)
+{
+	if ((search_key->sessionId != flow_info->sessionId) &&
+	    (search_key->sessionId != SME_QOS_SEARCH_SESSION_ID_ANY))
+		return false;
+
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_1)
+		return search_key->key.QosFlowID == flow_info->QosFlowID;
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_2)
+		return search_key->key.ac_type == flow_info->ac_type;
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_3)
+		return search_key->key.reason == flow_info->reason;
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_4)
+		return (search_key->key.ac_type == flow_info->ac_type) &&
+		       (search_key->direction ==
+				flow_info->QoSInfo.ts_info.direction);
+
+	return false;
+}
+
+/**
+ * sme_qos_get_search_index() - get the index list to search a key in
+ * @search_key: search key
+ * @flow_id_index: set to true if the flow ID index is returned
+ *
+ * Return: index list holding every entry that can match @search_key, NULL
+ * if the key can only be searched by walking the whole flow list
+ */
+static qdf_list_t *sme_qos_get_search_index(struct sme_qos_searchinfo
+						*search_key,
+					    bool *flow_id_index)
+{
+	*flow_id_index = false;
+
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_1) {
+		*flow_id_index = true;
+		return sme_qos_flow_id_bucket(search_key->key.QosFlowID);
+	}
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_2)
+		return sme_qos_get_ac_flow_list(search_key);
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_3)
+		return NULL;
+	if (search_key->index & SME_QOS_SEARCH_KEY_INDEX_4)
+		return sme_qos_get_ac_flow_list(search_key);
+
+	return NULL;
+}
+
 /**
  * sme_qos_find_in_flow_list() - find a flow entry from the flow list
  * @search_key: We can either use the flowID or the ac type to find the
@@ -5890,7 +6074,9 @@ static void sme_qos_state_transition(uint8_t sessionId,
  *              bit 0 - Flow ID
  *              bit 1 - AC type
  *
- * Utility function to find an flow entry from the flow_list.
+ * Utility function to find an flow entry from the flow_list. Flow ID and
+ * per session AC searches are served from the flow indexes, the other
+ * keys walk the whole flow_list.
  *
  * Return: pointer to the list element
  */
@@ -5899,6 +6085,9 @@ static tListElem *sme_qos_find_in_flow_list(struct sme_qos_searchinfo
 {
 	tListElem *list_elt = NULL, *list_next_elt = NULL;
 	struct sme_qos_flowinfoentry *flow_info = NULL;
+	qdf_list_node_t *node = NULL, *next_node = NULL;
+	qdf_list_t *index_list;
+	bool flow_id_index;
 
 	list_elt = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
 	if (!list_elt) {
@@ -5907,54 +6096,79 @@ static tListElem *sme_qos_find_in_flow_list(struct sme_qos_searchinfo
 		return NULL;
 	}
 
+	index_list = sme_qos_get_search_index(&search_key, &flow_id_index);
+	if (index_list) {
+		qdf_list_peek_front(index_list, &node);
+		while (node) {
+			flow_info = sme_qos_flow_from_node(node,
+							   flow_id_index);
+			if (sme_qos_is_flow_match(&search_key, flow_info)) {
+				QDF_TRACE(QDF_MODULE_ID_SME,
+					  QDF_TRACE_LEVEL_DEBUG,
+					  FL("match found on index %d, ending search"),
+					  search_key.index);
+				return &flow_info->link;
+			}
+			if (QDF_IS_STATUS_ERROR(qdf_list_peek_next(index_list,
+								   node,
+								   &next_node)))
+				break;
+			node = next_node;
+		}
+		return NULL;
+	}
+
 	while (list_elt) {
 		list_next_elt = csr_ll_next(&sme_qos_cb.flow_list, list_elt,
 					    false);
 		flow_info = GET_BASE_ADDR(list_elt, struct
 					sme_qos_flowinfoentry, link);
 
-		if ((search_key.sessionId != flow_info->sessionId) &&
-		    (search_key.sessionId != SME_QOS_SEARCH_SESSION_ID_ANY)) {
-			list_elt = list_next_elt;
-			continue;
-		}
-
-		if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_1) {
-			if (search_key.key.QosFlowID == flow_info->QosFlowID) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on flowID, ending search"));
-				break;
-			}
-		} else if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_2) {
-			if (search_key.key.ac_type == flow_info->ac_type) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on ac, ending search"));
-				break;
-			}
-		} else if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_3) {
-			if (search_key.key.reason == flow_info->reason) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on reason, ending search"));
-				break;
-			}
-		} else if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_4) {
-			if ((search_key.key.ac_type == flow_info->ac_type) &&
-			    (search_key.direction ==
-				flow_info->QoSInfo.ts_info.direction)) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on reason, ending search"));
-				break;
-			}
+		if (sme_qos_is_flow_match(&search_key, flow_info)) {
+			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
+				  FL("match found on index %d, ending search"),
+				  search_key.index);
+			break;
 		}
 		list_elt = list_next_elt;
 	}
 	return list_elt;
 }
 
+/**
+ * sme_qos_process_found_flow() - act on a flow found in the flow list
+ * @mac_ctx: global MAC context
+ * @search_key: search key
+ * @flow_info: flow entry matching @search_key
+ * @fnp: function pointer specifying the action type for the entry found
+ *
+ * @fnp may delete the entry, so it must not be accessed afterwards.
+ *
+ * Return: status returned by @fnp
+ */
+static QDF_STATUS
+sme_qos_process_found_flow(struct mac_context *mac_ctx,
+			   struct sme_qos_searchinfo *search_key,
+			   struct sme_qos_flowinfoentry *flow_info,
+			   sme_QosProcessSearchEntry fnp)
+{
+	struct sme_qos_sessioninfo *qos_session;
+	QDF_STATUS status;
+
+	if (!(search_key->index & SME_QOS_SEARCH_KEY_INDEX_1)) {
+		qos_session = &sme_qos_cb.sessionInfo[flow_info->sessionId];
+		flow_info->hoRenewal =
+			qos_session->ac_info[flow_info->ac_type].hoRenewal;
+	}
+
+	status = fnp(mac_ctx, &flow_info->link);
+	if (QDF_STATUS_E_FAILURE == status)
+		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
+			  FL("Failed to process entry"));
+
+	return status;
+}
+
 /**
  * sme_qos_find_all_in_flow_list() - find a flow entry in the flow list
  * @mac_ctx: global MAC context
@@ -5976,10 +6190,15 @@ static QDF_STATUS sme_qos_find_all_in_flow_list(struct mac_context *mac_ctx,
 					 sme_QosProcessSearchEntry fnp)
 {
 	tListElem *list_elt = NULL, *list_next_elt = NULL;
-	struct sme_qos_sessioninfo *qos_session;
 	struct sme_qos_flowinfoentry *flow_info = NULL;
+	qdf_list_node_t *node = NULL, *next_node = NULL;
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
-	enum qca_wlan_ac_type ac_type;
+	qdf_list_t *index_list;
+	bool flow_id_index;
+
+	if (!(search_key.index & (SME_QOS_SEARCH_KEY_INDEX_1 |
+				  SME_QOS_SEARCH_KEY_INDEX_2)))
+		return QDF_STATUS_E_FAILURE;
 
 	list_elt = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
 	if (!list_elt) {
@@ -5988,43 +6207,41 @@ static QDF_STATUS sme_qos_find_all_in_flow_list(struct mac_context *mac_ctx,
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	index_list = sme_qos_get_search_index(&search_key, &flow_id_index);
+	if (index_list) {
+		qdf_list_peek_front(index_list, &node);
+		while (node) {
+			/* fnp may delete the entry, fetch the next one first */
+			if (QDF_IS_STATUS_ERROR(qdf_list_peek_next(index_list,
+								   node,
+								   &next_node)))
+				next_node = NULL;
+			flow_info = sme_qos_flow_from_node(node,
+							   flow_id_index);
+			if (sme_qos_is_flow_match(&search_key, flow_info)) {
+				status = sme_qos_process_found_flow(mac_ctx,
+								    &search_key,
+								    flow_info,
+								    fnp);
+				if (QDF_STATUS_E_FAILURE == status)
+					break;
+			}
+			node = next_node;
+		}
+		return status;
+	}
+
 	while (list_elt) {
 		list_next_elt = csr_ll_next(&sme_qos_cb.flow_list, list_elt,
 					    false);
 		flow_info = GET_BASE_ADDR(list_elt, struct
 					sme_qos_flowinfoentry, link);
-		qos_session = &sme_qos_cb.sessionInfo[flow_info->sessionId];
-		if ((search_key.sessionId != flow_info->sessionId) &&
-		    (search_key.sessionId != SME_QOS_SEARCH_SESSION_ID_ANY)) {
-			list_elt = list_next_elt;
-			continue;
-		}
-
-		if ((search_key.index & SME_QOS_SEARCH_KEY_INDEX_1) &&
-		    (search_key.key.QosFlowID == flow_info->QosFlowID)) {
-			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
-			    FL("match found on flowID, ending search"));
-			status = fnp(mac_ctx, list_elt);
-			if (QDF_STATUS_E_FAILURE == status) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				    QDF_TRACE_LEVEL_ERROR,
-				    FL("Failed to process entry"));
+		if (sme_qos_is_flow_match(&search_key, flow_info)) {
+			status = sme_qos_process_found_flow(mac_ctx,
+							    &search_key,
+							    flow_info, fnp);
+			if (QDF_STATUS_E_FAILURE == status)
 				break;
-			}
-		} else if ((search_key.index & SME_QOS_SEARCH_KEY_INDEX_2) &&
-			   (search_key.key.ac_type == flow_info->ac_type)) {
-			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
-			    FL("match found on ac, ending search"));
-			ac_type = flow_info->ac_type;
-			flow_info->hoRenewal =
-				qos_session->ac_info[ac_type].hoRenewal;
-			status = fnp(mac_ctx, list_elt);
-			if (QDF_STATUS_E_FAILURE == status) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				    QDF_TRACE_LEVEL_ERROR,
-				    FL("Failed to process entry"));
-				break;
-			}
 		}
 		list_elt = list_next_elt;
 	}
@@ -6209,7 +6426,7 @@ static QDF_STATUS sme_qos_buffer_existing_flows(struct mac_context *mac_ctx,
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  FL("Deleting original entry at %pK with flowID %d"),
 			  flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, list_entry, true);
+		sme_qos_remove_flow_entry(flow_info);
 		qdf_mem_free(flow_info);
 
 		list_entry = list_nextentry;
@@ -6257,8 +6474,7 @@ static QDF_STATUS sme_qos_delete_existing_flows(struct mac_context *mac,
 				  __func__, __LINE__,
 				  flow_info, flow_info->QosFlowID);
 			/* delete the entry from Flow List */
-			csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry,
-					    true);
+			sme_qos_remove_flow_entry(flow_info);
 			qdf_mem_free(flow_info);
 		}
 		pEntry = pNextEntry;
@@ -6617,7 +6833,7 @@ static QDF_STATUS sme_qos_modify_fnp(struct mac_context *mac, tListElem *pEntry)
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  "%s: %d: Deleting original entry at %pK with flowID %d",
 			  __func__, __LINE__, flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry, true);
+		sme_qos_remove_flow_entry(flow_info);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 		break;
@@ -6793,7 +7009,7 @@ sme_qos_reassoc_success_ev_fnp(struct mac_context *mac_ctx,
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			FL("Deleting entry at %pK with flowID %d"),
 			flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, entry, true);
+		sme_qos_remove_flow_entry(flow_info);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 	}
@@ -6882,7 +7098,7 @@ static QDF_STATUS sme_qos_add_ts_failure_fnp(struct mac_context *mac, tListElem
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  "%s: %d: Deleting entry at %pK with flowID %d",
 			  __func__, __LINE__, flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry, true);
+		sme_qos_remove_flow_entry(flow_info);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 	}
@@ -7050,7 +7266,7 @@ static QDF_STATUS sme_qos_add_ts_success_fnp(struct mac_context *mac_ctx,
 			FL("Deleting entry at %pK with flowID %d"),
 			flow_info, flow_info->QosFlowID);
 		/* delete the entry from Flow List */
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, entry, true);
+		sme_qos_remove_flow_entry(flow_info);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 	}
@@ -7650,4 +7866,115 @@ static uint8_t sme_qos_assign_dialog_token(void)
 		  FL("token %d"), token);
 	return token;
 }
+
+#ifdef WLAN_SME_QOS_TEST
+bool sme_qos_test_is_idle(void)
+{
+	enum qca_wlan_ac_type ac;
+	uint8_t session_id;
+	uint8_t i;
+
+	if (csr_ll_count(&sme_qos_cb.flow_list))
+		return false;
+
+	for (i = 0; i < SME_QOS_FLOW_ID_HASH_SIZE; i++)
+		if (qdf_list_size(&sme_qos_cb.flow_id_hash[i]))
+			return false;
+
+	for (session_id = 0; session_id < WLAN_MAX_VDEVS; session_id++)
+		for (ac = QCA_WLAN_AC_BE; ac < QCA_WLAN_AC_ALL; ac++)
+			if (qdf_list_size(
+				&sme_qos_cb.ac_flow_list[session_id][ac]))
+				return false;
+
+	return true;
+}
+
+QDF_STATUS sme_qos_test_add_flow(uint8_t session_id,
+				 enum qca_wlan_ac_type ac,
+				 enum sme_qos_wmm_dir_type direction,
+				 uint32_t flow_id)
+{
+	struct sme_qos_flowinfoentry *flow_info;
+
+	if (session_id >= WLAN_MAX_VDEVS || ac >= QCA_WLAN_AC_ALL)
+		return QDF_STATUS_E_INVAL;
+
+	flow_info = qdf_mem_malloc(sizeof(*flow_info));
+	if (!flow_info)
+		return QDF_STATUS_E_NOMEM;
+
+	flow_info->sessionId = session_id;
+	flow_info->ac_type = ac;
+	flow_info->QosFlowID = flow_id;
+	flow_info->reason = SME_QOS_REASON_REQ_SUCCESS;
+	flow_info->tspec_mask = SME_QOS_TSPEC_MASK_BIT_1_SET;
+	flow_info->QoSInfo.ts_info.direction = direction;
+	sme_qos_add_flow_entry(flow_info);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS sme_qos_test_del_flow(uint32_t flow_id)
+{
+	struct sme_qos_flowinfoentry *flow_info;
+	struct sme_qos_searchinfo search_key;
+	tListElem *entry;
+
+	qdf_mem_zero(&search_key, sizeof(search_key));
+	search_key.key.QosFlowID = flow_id;
+	search_key.index = SME_QOS_SEARCH_KEY_INDEX_1;
+	search_key.sessionId = SME_QOS_SEARCH_SESSION_ID_ANY;
+
+	entry = sme_qos_find_in_flow_list(search_key);
+	if (!entry)
+		return QDF_STATUS_E_NOENT;
+
+	flow_info = GET_BASE_ADDR(entry, struct sme_qos_flowinfoentry, link);
+	sme_qos_remove_flow_entry(flow_info);
+	qdf_mem_free(flow_info);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+uint32_t sme_qos_test_find_flow(uint8_t session_id,
+				enum sme_qos_test_key key,
+				enum qca_wlan_ac_type ac,
+				enum sme_qos_wmm_dir_type direction,
+				uint32_t flow_id)
+{
+	struct sme_qos_flowinfoentry *flow_info;
+	struct sme_qos_searchinfo search_key;
+	tListElem *entry;
+
+	qdf_mem_zero(&search_key, sizeof(search_key));
+	search_key.sessionId = session_id;
+
+	switch (key) {
+	case SME_QOS_TEST_KEY_FLOW_ID:
+		search_key.key.QosFlowID = flow_id;
+		search_key.index = SME_QOS_SEARCH_KEY_INDEX_1;
+		break;
+	case SME_QOS_TEST_KEY_AC:
+		search_key.key.ac_type = ac;
+		search_key.index = SME_QOS_SEARCH_KEY_INDEX_2;
+		break;
+	case SME_QOS_TEST_KEY_AC_DIR:
+		search_key.key.ac_type = ac;
+		search_key.direction = direction;
+		search_key.index = SME_QOS_SEARCH_KEY_INDEX_4;
+		break;
+	default:
+		return 0;
+	}
+
+	entry = sme_qos_find_in_flow_list(search_key);
+	if (!entry)
+		return 0;
+
+	flow_info = GET_BASE_ADDR(entry, struct sme_qos_flowinfoentry, link);
+
+	return flow_info->QosFlowID;
+}
+#endif /* WLAN_SME_QOS_TEST */
 #endif /* WLAN_MDM_CODE_REDUCTION_OPT */
@@ -66,30 +66,35 @@
 uint64_t rrm_scan_timer;
 
 /**
- * rrm_ll_purge_neighbor_cache() -Purges all the entries in the neighbor cache
- *
+ * rrm_purge_neighbor_cache() - Purges all the entries in the neighbor cache
  * @mac: Pointer to the Hal Handle.
- * @pList: Pointer the List that should be purged.
- *
- * This function purges all the entries in the neighbor cache and frees up all
- * the internal nodes
+ * @cache: Pointer the cache that should be purged.
  *
  * Return: void
  */
-static void rrm_ll_purge_neighbor_cache(struct mac_context *mac,
-	tDblLinkList *pList)
+static void rrm_purge_neighbor_cache(struct mac_context *mac,
+				     struct rrm_neighbor_cache *cache)
 {
-	tListElem *pEntry;
-	tRrmNeighborReportDesc *pNeighborReportDesc;
-
-	csr_ll_lock(pList);
-	while ((pEntry = csr_ll_remove_head(pList, LL_ACCESS_NOLOCK)) != NULL) {
-		pNeighborReportDesc =
-			GET_BASE_ADDR(pEntry, tRrmNeighborReportDesc, List);
-		qdf_mem_free(pNeighborReportDesc->pNeighborBssDescription);
-		qdf_mem_free(pNeighborReportDesc);
-	}
-	csr_ll_unlock(pList);
+	qdf_spin_lock_bh(&cache->lock);
+	cache->num_entries = 0;
+	qdf_spin_unlock_bh(&cache->lock);
+}
+
+/**
+ * rrm_get_neighbor_cache_count() - Get number of entries in neighbor cache
+ * @cache: Pointer to the neighbor cache
+ *
+ * Return: number of cached neighbors
+ */
+static uint8_t rrm_get_neighbor_cache_count(struct rrm_neighbor_cache *cache)
+{
+	uint8_t count;
+
+	qdf_spin_lock_bh(&cache->lock);
+	count = cache->num_entries;
+	qdf_spin_unlock_bh(&cache->lock);
+
+	return count;
 }
 
 /**
@@ -1355,8 +1360,8 @@ QDF_STATUS sme_rrm_neighbor_report_request(struct mac_context *mac, uint8_t
 	if (!pMsg)
 		return QDF_STATUS_E_NOMEM;
 
-	rrm_ll_purge_neighbor_cache(mac,
-			    &mac->rrm.rrmSmeContext[0].neighborReportCache);
+	rrm_purge_neighbor_cache(mac,
+				 &mac->rrm.rrmSmeContext[0].neighborReportCache);
 
 	pMsg->messageType = eWNI_SME_NEIGHBOR_REPORT_REQ_IND;
 	pMsg->length = sizeof(tSirNeighborReportReqInd);
@@ -1473,16 +1478,65 @@ check_11r_assoc:
 	nbr_report_desc->roamScore = roam_score;
 }
 
+/**
+ * rrm_neighbor_cache_find_pos() - find the position of a roam score
+ * @cache: neighbor cache
+ * @roam_score: roam score of the neighbor to be inserted
+ *
+ * Binary search for the first cached neighbor with a roam score lower than
+ * @roam_score, so that neighbors with equal scores stay in arrival order.
+ * Must be called with the cache lock held.
+ *
+ * Return: position to insert the neighbor at
+ */
+static uint8_t rrm_neighbor_cache_find_pos(struct rrm_neighbor_cache *cache,
+					   uint32_t roam_score)
+{
+	uint8_t low = 0, high = cache->num_entries, mid;
+
+	while (low < high) {
+		mid = low + (high - low) / 2;
+		if (cache->entries[mid].roamScore < roam_score)
+			high = mid;
+		else
+			low = mid + 1;
+	}
+
+	return low;
+}
+
+/**
+ * rrm_neighbor_cache_remove() - remove a neighbor from the sorted entries
+ * @cache: neighbor cache
+ * @pos: position of the neighbor in the sorted entries
+ *
+ * The storage slot of the neighbor is not released, the caller either
+ * reuses it right away or drops the last slot. Must be called with the
+ * cache lock held.
+ *
+ * Return: void
+ */
+static void rrm_neighbor_cache_remove(struct rrm_neighbor_cache *cache,
+				      uint8_t pos)
+{
+	cache->num_entries--;
+	if (pos < cache->num_entries)
+		qdf_mem_move(&cache->entries[pos], &cache->entries[pos + 1],
+			     (cache->num_entries - pos) *
+			     sizeof(cache->entries[0]));
+}
+
 /**
  * rrm_store_neighbor_rpt_by_roam_score()-store Neighbor BSS descriptor
  * @mac: Pointer to mac context
  * @pNeighborReportDesc - Neighbor BSS Descriptor node to be stored in cache
  * @index: RRM sme context index
  *
- * This API is called to store a given
- * Neighbor BSS descriptor to the neighbor cache. This function
- * stores the neighbor BSS descriptors in such a way that descriptors
- * are sorted by roamScore in descending order
+ * This API is called to store a given Neighbor BSS descriptor to the
+ * neighbor cache. The descriptor is copied into the cache storage and kept
+ * sorted by roamScore in descending order. A BSSID is cached only once,
+ * a later report of the same BSSID replaces the earlier one. When the cache
+ * is full the neighbor with the lowest roamScore is evicted.
  *
  * Return: void.
  */
@@ -1490,9 +1544,12 @@ static void rrm_store_neighbor_rpt_by_roam_score(struct mac_context *mac,
 				tpRrmNeighborReportDesc pNeighborReportDesc,
 				uint8_t index)
 {
-	tpRrmSMEContext pSmeRrmContext = &mac->rrm.rrmSmeContext[0];
-	tListElem *pEntry;
-	tRrmNeighborReportDesc *pTempNeighborReportDesc;
+	struct rrm_neighbor_cache *cache =
+		&mac->rrm.rrmSmeContext[index].neighborReportCache;
+	tSirNeighborBssDescription *nbr_bss_desc;
+	tSirNeighborBssDescription *slot = NULL;
+	tpRrmNeighborReportDesc last;
+	uint8_t i, pos;
 
 	if (!pNeighborReportDesc) {
 		QDF_ASSERT(0);
@@ -1502,47 +1559,49 @@ static void rrm_store_neighbor_rpt_by_roam_score(struct mac_context *mac,
 		QDF_ASSERT(0);
 		return;
 	}
-
-	if (csr_ll_is_list_empty
-		    (&pSmeRrmContext->neighborReportCache, LL_ACCESS_LOCK)) {
-		sme_err("Neighbor report cache is empty.. Adding a entry now");
-		/* Neighbor list cache is empty. Insert this entry
-		 * in the tail
-		 */
-		csr_ll_insert_tail(&pSmeRrmContext->neighborReportCache,
-				   &pNeighborReportDesc->List, LL_ACCESS_LOCK);
-		return;
+	nbr_bss_desc = pNeighborReportDesc->pNeighborBssDescription;
+
+	qdf_spin_lock_bh(&cache->lock);
+	for (i = 0; i < cache->num_entries; i++) {
+		if (qdf_mem_cmp(cache->entries[i].pNeighborBssDescription->bssId,
+				nbr_bss_desc->bssId, sizeof(tSirMacAddr)))
+			continue;
+
+		sme_debug("Replacing cached neighbor " QDF_MAC_ADDR_FMT,
+			  QDF_MAC_ADDR_REF(nbr_bss_desc->bssId));
+		slot = cache->entries[i].pNeighborBssDescription;
+		rrm_neighbor_cache_remove(cache, i);
+		break;
 	}
-	/* Should store the neighbor BSS description in the order
-	 * sorted by roamScore in descending order. APs with highest
-	 * roamScore should be the 1st entry in the list
-	 */
-	pEntry = csr_ll_peek_head(&pSmeRrmContext->neighborReportCache,
-				LL_ACCESS_LOCK);
-	while (pEntry) {
-		pTempNeighborReportDesc = GET_BASE_ADDR(pEntry,
-					tRrmNeighborReportDesc, List);
-		if (pTempNeighborReportDesc->roamScore <
-				pNeighborReportDesc->roamScore)
-			break;
-		pEntry = csr_ll_next(&pSmeRrmContext->
-				neighborReportCache, pEntry, LL_ACCESS_LOCK);
+
+	if (!slot) {
+		if (cache->num_entries < RRM_NEIGHBOR_CACHE_SIZE) {
+			slot = &cache->bss_desc[cache->num_entries];
+		} else {
+			last = &cache->entries[cache->num_entries - 1];
+			if (last->roamScore >= pNeighborReportDesc->roamScore) {
+				qdf_spin_unlock_bh(&cache->lock);
+				sme_debug("Neighbor cache full, dropping "
+					  QDF_MAC_ADDR_FMT,
+					  QDF_MAC_ADDR_REF(nbr_bss_desc->bssId));
+				return;
+			}
+			slot = last->pNeighborBssDescription;
+			cache->num_entries--;
 		}
+	}
 
-	if (pEntry)
-		/* This BSS roamscore is better than something in the
-		 * list. Insert this before that one
-		 */
-		csr_ll_insert_entry(&pSmeRrmContext->neighborReportCache,
-					pEntry, &pNeighborReportDesc->List,
-					LL_ACCESS_LOCK);
-	else
-		/* All the entries in the list has a better roam Score
-		 * than this one. Insert this at the last
-		 */
-		csr_ll_insert_tail(&pSmeRrmContext->neighborReportCache,
-					&pNeighborReportDesc->List,
-					LL_ACCESS_LOCK);
+	qdf_mem_copy(slot, nbr_bss_desc, sizeof(*slot));
+	pos = rrm_neighbor_cache_find_pos(cache,
+					  pNeighborReportDesc->roamScore);
+	if (pos < cache->num_entries)
+		qdf_mem_move(&cache->entries[pos + 1], &cache->entries[pos],
+			     (cache->num_entries - pos) *
+			     sizeof(cache->entries[0]));
+	cache->entries[pos] = *pNeighborReportDesc;
+	cache->entries[pos].pNeighborBssDescription = slot;
+	cache->num_entries++;
+	qdf_spin_unlock_bh(&cache->lock);
 }
 
 /**
@@ -1559,49 +1618,45 @@ static void rrm_store_neighbor_rpt_by_roam_score(struct mac_context *mac,
 static QDF_STATUS sme_rrm_process_neighbor_report(struct mac_context *mac,
 						  void *msg_buf)
 {
-	QDF_STATUS status = QDF_STATUS_SUCCESS;
 	tpSirNeighborReportInd neighbor_rpt = (tpSirNeighborReportInd)msg_buf;
-	tpRrmNeighborReportDesc neighbor_rpt_desc;
+	tRrmNeighborReportDesc neighbor_rpt_desc;
+	struct rrm_neighbor_cache *cache;
 	uint8_t i = 0;
 	QDF_STATUS qdf_status = QDF_STATUS_SUCCESS;
 
+	if (neighbor_rpt->measurement_idx >= MAX_MEASUREMENT_REQUEST) {
+		sme_err("Invalid measurement index %d",
+			neighbor_rpt->measurement_idx);
+		return QDF_STATUS_E_INVAL;
+	}
+	cache = &mac->rrm.rrmSmeContext[neighbor_rpt->measurement_idx].
+		neighborReportCache;
+
 	/* Purge the cache on reception of unsolicited neighbor report */
 	if (!mac->rrm.rrmSmeContext[neighbor_rpt->measurement_idx].
 	    neighborReqControlInfo.isNeighborRspPending)
-		rrm_ll_purge_neighbor_cache(mac,
-			&mac->rrm.rrmSmeContext[neighbor_rpt->measurement_idx].
-			neighborReportCache);
+		rrm_purge_neighbor_cache(mac, cache);
 
 	for (i = 0; i < neighbor_rpt->numNeighborReports; i++) {
-		neighbor_rpt_desc =
-			qdf_mem_malloc(sizeof(tRrmNeighborReportDesc));
-		if (!neighbor_rpt_desc) {
-			status = QDF_STATUS_E_NOMEM;
-			goto end;
-
-		}
-
-		neighbor_rpt_desc->pNeighborBssDescription =
-			qdf_mem_malloc(sizeof(tSirNeighborBssDescription));
-		if (!neighbor_rpt_desc->pNeighborBssDescription) {
-			qdf_mem_free(neighbor_rpt_desc);
-			status = QDF_STATUS_E_NOMEM;
-			goto end;
-		}
-		qdf_mem_copy(neighbor_rpt_desc->pNeighborBssDescription,
-			     &neighbor_rpt->sNeighborBssDescription[i],
-			     sizeof(tSirNeighborBssDescription));
+		/*
+		 * The descriptor only points to the report while it is
+		 * scored, the cache keeps its own copy of it.
+		 */
+		qdf_mem_zero(&neighbor_rpt_desc, sizeof(neighbor_rpt_desc));
+		neighbor_rpt_desc.pNeighborBssDescription =
+			&neighbor_rpt->sNeighborBssDescription[i];
+		neighbor_rpt_desc.sessionId = neighbor_rpt->sessionId;
 
 		sme_debug("Received neighbor report with Neighbor BSSID: "
 			QDF_MAC_ADDR_FMT,
 			QDF_MAC_ADDR_REF(
 			       neighbor_rpt->sNeighborBssDescription[i].bssId));
 
-		rrm_calculate_neighbor_ap_roam_score(mac, neighbor_rpt_desc);
+		rrm_calculate_neighbor_ap_roam_score(mac, &neighbor_rpt_desc);
 
-		if (neighbor_rpt_desc->roamScore > 0) {
+		if (neighbor_rpt_desc.roamScore > 0) {
 			rrm_store_neighbor_rpt_by_roam_score(
-					mac, neighbor_rpt_desc,
+					mac, &neighbor_rpt_desc,
 					neighbor_rpt->measurement_idx);
 		} else {
 			sme_err("Roam score of BSSID  " QDF_MAC_ADDR_FMT
@@ -1609,22 +1664,15 @@ static QDF_STATUS sme_rrm_process_neighbor_report(struct mac_context *mac,
 				QDF_MAC_ADDR_REF(neighbor_rpt->
 					       sNeighborBssDescription[i].
 					       bssId));
-
-			qdf_mem_free(
-				neighbor_rpt_desc->pNeighborBssDescription);
-			qdf_mem_free(neighbor_rpt_desc);
 		}
 	}
-end:
 
-	if (!csr_ll_count(
-		&mac->rrm.rrmSmeContext[neighbor_rpt->measurement_idx].
-		neighborReportCache))
+	if (!rrm_get_neighbor_cache_count(cache))
 		qdf_status = QDF_STATUS_E_FAILURE;
 
 	rrm_indicate_neighbor_report_result(mac, qdf_status);
 
-	return status;
+	return QDF_STATUS_SUCCESS;
 }
 
 /**
@@ -1712,7 +1760,6 @@ QDF_STATUS rrm_open(struct mac_context *mac)
 
 	QDF_STATUS qdf_status;
 	tpRrmSMEContext pSmeRrmContext;
-	QDF_STATUS qdf_ret_status = QDF_STATUS_SUCCESS;
 	uint8_t i;
 
 	mac->rrm.rrmConfig.max_randn_interval = 50;        /* ms */
@@ -1735,12 +1782,8 @@ QDF_STATUS rrm_open(struct mac_context *mac)
 		pSmeRrmContext->neighborReqControlInfo.isNeighborRspPending =
 						false;
 
-		qdf_ret_status =
-			csr_ll_open(&pSmeRrmContext->neighborReportCache);
-		if (QDF_STATUS_SUCCESS != qdf_ret_status) {
-			sme_err("Fail to open neighbor cache result");
-			return QDF_STATUS_E_FAILURE;
-		}
+		qdf_spinlock_create(&pSmeRrmContext->neighborReportCache.lock);
+		pSmeRrmContext->neighborReportCache.num_entries = 0;
 	}
 
 	rrm_change_default_config_param(mac);
@@ -1791,9 +1834,9 @@ QDF_STATUS rrm_close(struct mac_context *mac)
 		if (!QDF_IS_STATUS_SUCCESS(qdf_status))
 			sme_err("Fail to destroy timer");
 
-		rrm_ll_purge_neighbor_cache(
-				mac, &pSmeRrmContext->neighborReportCache);
-		csr_ll_close(&pSmeRrmContext->neighborReportCache);
+		rrm_purge_neighbor_cache(mac,
+					 &pSmeRrmContext->neighborReportCache);
+		qdf_spinlock_destroy(&pSmeRrmContext->neighborReportCache.lock);
 	}
 
 	return qdf_status;
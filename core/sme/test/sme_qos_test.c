@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "cds_api.h"
+#include "cds_test_util.h"
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "sme_inside.h"
+#include "sme_qos_internal.h"
+#include "sme_qos_test.h"
+
+#define qos_test_err(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR, fmt, ##args)
+#define qos_test_info(fmt, args...) \
+	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_INFO_HIGH, fmt, ##args)
+
+/* Sessions the replayed flows are spread over */
+#define QOS_TEST_SESSIONS 4
+/* Largest number of flows admitted at once during the storm */
+#define QOS_TEST_MAX_FLOWS 64
+/* TSPEC setup and teardown requests of the storm */
+#define QOS_TEST_STORM_OPS 4000
+/* First flow ID of the test, away from the ones SME hands out */
+#define QOS_TEST_FIRST_FLOW_ID 0x10000
+
+/**
+ * struct qos_test_flow - a flow admitted during the replay
+ * @session_id: session of the flow
+ * @ac: access category of the flow
+ * @direction: TSPEC direction of the flow
+ * @flow_id: QoS flow ID of the flow
+ */
+struct qos_test_flow {
+	uint8_t session_id;
+	enum qca_wlan_ac_type ac;
+	enum sme_qos_wmm_dir_type direction;
+	uint32_t flow_id;
+};
+
+/**
+ * struct qos_test_model - the flows SME QoS is expected to hold
+ * @flows: admitted flows, in the order they were set up
+ * @num_flows: number of admitted flows
+ * @next_flow_id: flow ID of the next setup
+ */
+struct qos_test_model {
+	struct qos_test_flow flows[QOS_TEST_MAX_FLOWS];
+	uint32_t num_flows;
+	uint32_t next_flow_id;
+};
+
+static const enum sme_qos_wmm_dir_type qos_test_dirs[] = {
+	SME_QOS_WMM_TS_DIR_UPLINK,
+	SME_QOS_WMM_TS_DIR_DOWNLINK,
+	SME_QOS_WMM_TS_DIR_BOTH,
+};
+
+/**
+ * qos_test_model_find() - first flow of the model matching a key
+ * @model: expected flows
+ * @session_id: session of the flow, WLAN_MAX_VDEVS for any session
+ * @key: key to look the flow up by
+ * @ac: access category
+ * @direction: TSPEC direction
+ * @flow_id: QoS flow ID
+ *
+ * Return: QoS flow ID of the first flow matching, 0 if none does
+ */
+static uint32_t qos_test_model_find(struct qos_test_model *model,
+				    uint8_t session_id,
+				    enum sme_qos_test_key key,
+				    enum qca_wlan_ac_type ac,
+				    enum sme_qos_wmm_dir_type direction,
+				    uint32_t flow_id)
+{
+	struct qos_test_flow *flow;
+	uint32_t i;
+
+	for (i = 0; i < model->num_flows; i++) {
+		flow = &model->flows[i];
+		if (session_id != WLAN_MAX_VDEVS &&
+		    session_id != flow->session_id)
+			continue;
+
+		if (key == SME_QOS_TEST_KEY_FLOW_ID) {
+			if (flow->flow_id == flow_id)
+				return flow->flow_id;
+		} else if (flow->ac == ac &&
+			   (key == SME_QOS_TEST_KEY_AC ||
+			    flow->direction == direction)) {
+			return flow->flow_id;
+		}
+	}
+
+	return 0;
+}
+
+static uint32_t qos_test_expect(struct qos_test_model *model,
+				uint8_t session_id,
+				enum sme_qos_test_key key,
+				enum qca_wlan_ac_type ac,
+				enum sme_qos_wmm_dir_type direction,
+				uint32_t flow_id)
+{
+	uint32_t expected, found;
+
+	expected = qos_test_model_find(model, session_id, key, ac, direction,
+				       flow_id);
+	found = sme_qos_test_find_flow(session_id, key, ac, direction,
+				       flow_id);
+	if (found == expected)
+		return 0;
+
+	qos_test_err("FAIL: session %u key %d ac %d dir %d flow 0x%x; expected flow 0x%x, found 0x%x",
+		     session_id, key, ac, direction, flow_id, expected, found);
+
+	return 1;
+}
+
+static uint32_t qos_test_setup(struct qos_test_model *model, uint32_t *seed)
+{
+	struct qos_test_flow *flow = &model->flows[model->num_flows];
+
+	flow->session_id = cds_test_rand(seed) % QOS_TEST_SESSIONS;
+	flow->ac = cds_test_rand(seed) % QCA_WLAN_AC_ALL;
+	flow->direction = qos_test_dirs[cds_test_rand(seed) %
+					QDF_ARRAY_SIZE(qos_test_dirs)];
+	flow->flow_id = model->next_flow_id++;
+
+	if (QDF_IS_STATUS_ERROR(sme_qos_test_add_flow(flow->session_id,
+						      flow->ac,
+						      flow->direction,
+						      flow->flow_id))) {
+		qos_test_err("FAIL: setup of flow 0x%x failed", flow->flow_id);
+		return 1;
+	}
+
+	model->num_flows++;
+
+	return 0;
+}
+
+static uint32_t qos_test_teardown(struct qos_test_model *model, uint32_t i)
+{
+	uint32_t flow_id = model->flows[i].flow_id;
+
+	model->num_flows--;
+	qdf_mem_move(&model->flows[i], &model->flows[i + 1],
+		     (model->num_flows - i) * sizeof(model->flows[0]));
+
+	if (QDF_IS_STATUS_ERROR(sme_qos_test_del_flow(flow_id))) {
+		qos_test_err("FAIL: teardown of flow 0x%x failed", flow_id);
+		return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * qos_test_check() - look flows up by every key SME QoS searches by
+ * @model: expected flows
+ * @seed: state of the random sequence
+ *
+ * Return: number of failed lookups
+ */
+static uint32_t qos_test_check(struct qos_test_model *model, uint32_t *seed)
+{
+	enum sme_qos_wmm_dir_type direction;
+	enum qca_wlan_ac_type ac;
+	uint32_t errors = 0;
+	uint32_t flow_id;
+	uint8_t session_id;
+
+	/* a flow admitted, or torn down, or never set up */
+	flow_id = QOS_TEST_FIRST_FLOW_ID +
+		  cds_test_rand(seed) % (model->next_flow_id -
+					 QOS_TEST_FIRST_FLOW_ID + 1);
+	errors += qos_test_expect(model, WLAN_MAX_VDEVS,
+				  SME_QOS_TEST_KEY_FLOW_ID, 0, 0, flow_id);
+
+	session_id = cds_test_rand(seed) % QOS_TEST_SESSIONS;
+	ac = cds_test_rand(seed) % QCA_WLAN_AC_ALL;
+	direction = qos_test_dirs[cds_test_rand(seed) %
+				  QDF_ARRAY_SIZE(qos_test_dirs)];
+	errors += qos_test_expect(model, session_id, SME_QOS_TEST_KEY_AC,
+				  ac, 0, 0);
+	errors += qos_test_expect(model, session_id, SME_QOS_TEST_KEY_AC_DIR,
+				  ac, direction, 0);
+	/* not restricted to a session, served by the whole flow list */
+	errors += qos_test_expect(model, WLAN_MAX_VDEVS, SME_QOS_TEST_KEY_AC,
+				  ac, 0, 0);
+
+	return errors;
+}
+
+/**
+ * qos_test_storm() - replay a storm of TSPEC setups and teardowns
+ *
+ * Flows are set up and torn down in a random order over several sessions
+ * and ACs, as applications do while calls start and end. After each
+ * request, flows are looked up by every key and the first match has to be
+ * the one a walk of the flows in setup order finds. At the end, nothing
+ * is left in the flow list nor in its indexes.
+ *
+ * Return: number of failed test cases
+ */
+static uint32_t qos_test_storm(void)
+{
+	struct qos_test_model *model;
+	uint64_t start_us, elapsed_us;
+	uint32_t seed = 13;
+	uint32_t errors = 0;
+	uint32_t op;
+
+	model = qdf_mem_malloc(sizeof(*model));
+	if (!model)
+		return 1;
+
+	model->next_flow_id = QOS_TEST_FIRST_FLOW_ID;
+
+	start_us = qdf_get_log_timestamp_usecs();
+	for (op = 0; op < QOS_TEST_STORM_OPS && errors < 16; op++) {
+		if (model->num_flows < QOS_TEST_MAX_FLOWS &&
+		    (!model->num_flows || cds_test_rand(&seed) % 3))
+			errors += qos_test_setup(model, &seed);
+		else
+			errors += qos_test_teardown(model,
+						    cds_test_rand(&seed) %
+						    model->num_flows);
+
+		errors += qos_test_check(model, &seed);
+	}
+
+	while (model->num_flows)
+		errors += qos_test_teardown(model, model->num_flows - 1);
+	elapsed_us = qdf_get_log_timestamp_usecs() - start_us;
+
+	if (!sme_qos_test_is_idle()) {
+		qos_test_err("FAIL: flows left after the storm");
+		errors++;
+	}
+
+	qos_test_info("%u TSPEC requests replayed in %llu us", op, elapsed_us);
+
+	qdf_mem_free(model);
+
+	return errors;
+}
+
+uint32_t sme_qos_unit_test(void)
+{
+	struct mac_context *mac = cds_get_context(QDF_MODULE_ID_PE);
+	uint32_t errors = 0;
+
+	if (!mac) {
+		qos_test_err("FAIL: no MAC context");
+		return 1;
+	}
+
+	/* keep SME QoS requests out while the flow list is borrowed */
+	if (QDF_IS_STATUS_ERROR(sme_acquire_global_lock(&mac->sme)))
+		return 1;
+
+	if (sme_qos_test_is_idle())
+		errors += qos_test_storm();
+	else
+		qos_test_info("QoS flows are active, skip the replay");
+
+	sme_release_global_lock(&mac->sme);
+
+	return errors;
+}
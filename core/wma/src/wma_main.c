@@ -114,6 +114,7 @@
 #endif
 
 #include "wlan_pkt_capture_ucfg_api.h"
+#include "cds_boot_profile.h"
 
 #define WMA_LOG_COMPLETION_TIMER 3000 /* 3 seconds */
 #define WMI_TLV_HEADROOM 128
@@ -5749,6 +5750,7 @@ int wma_rx_service_ready_event(void *handle, uint8_t *cmd_param_info,
 	uint32_t *service_bitmap;
 
 	wma_debug("Enter");
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_SERVICE_READY);
 
 	if (!handle) {
 		wma_err("wma_handle passed is NULL");
@@ -6021,6 +6023,7 @@ int wma_rx_service_ready_event(void *handle, uint8_t *cmd_param_info,
 	wma_handle->dynamic_nss_chains_support = wmi_service_enabled(wmi_handle,
 					wmi_service_per_vdev_chain_support);
 	target_psoc_set_num_radios(tgt_hdl, 1);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_SERVICE_READY);
 
 	return 0;
 
@@ -6685,6 +6688,7 @@ int wma_rx_service_ready_ext_event(void *handle, uint8_t *event,
 	uint8_t sta_sap_scc_on_dfs_chnl;
 
 	wma_debug("Enter");
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_SERVICE_READY_EXT);
 
 	if (!wma_handle) {
 		wma_err("Invalid WMA handle");
@@ -6840,6 +6844,7 @@ int wma_rx_service_ready_ext_event(void *handle, uint8_t *event,
 	wma_init_dbr_params(wma_handle);
 
 	wma_set_coex_res_cfg(wma_handle, wmi_handle, wlan_res_cfg);
+	cds_boot_profile_step_end(CDS_BOOT_STEP_SERVICE_READY_EXT);
 
 	return 0;
 }
@@ -6862,6 +6867,7 @@ int wma_rx_ready_event(void *handle, uint8_t *cmd_param_info,
 	int ret;
 
 	wma_debug("Enter");
+	cds_boot_profile_step_begin(CDS_BOOT_STEP_READY);
 
 	param_buf = (WMI_READY_EVENTID_param_tlvs *) cmd_param_info;
 	if (!(wma_handle && param_buf)) {
@@ -6892,6 +6898,7 @@ int wma_rx_ready_event(void *handle, uint8_t *cmd_param_info,
 	if (ret)
 		return ret;
 
+	cds_boot_profile_step_end(CDS_BOOT_STEP_READY);
 	wma_debug("Exit");
 
 	return 0;
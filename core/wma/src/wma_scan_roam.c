@@ -2451,12 +2451,11 @@ static void wma_free_roam_synch_frame_ind(struct wma_txrx_node *iface)
  * synch frame event data
  * @wma: Global WMA Handle
  * @roam_synch_ind_ptr: Buffer to be filled
- * @param_buf: Source buffer
+ * @iface: vdev the synch frame event was received on
  *
- * Firmware sends all the required information required for roam
- * synch propagation as TLV's and stored in param_buf. These
- * parameters are parsed and filled into the roam synch indication
- * buffer which will be used at different layers for propagation.
+ * The frames received through WMI_ROAM_SYNCH_FRAME_EVENTID are not copied,
+ * the roam synch indication references the buffers held by @iface. They
+ * are freed by the roam synch event handler once the propagation is over.
  *
  * Return: None
  */
@@ -2464,51 +2463,23 @@ static void wma_fill_data_synch_frame_event(tp_wma_handle wma,
 				struct roam_offload_synch_ind *roam_synch_ind_ptr,
 				struct wma_txrx_node *iface)
 {
-	uint8_t *bcn_probersp_ptr;
-	uint8_t *reassoc_rsp_ptr;
-	uint8_t *reassoc_req_ptr;
-
 	/* Beacon/Probe Rsp data */
-	roam_synch_ind_ptr->beaconProbeRespOffset =
-		sizeof(struct roam_offload_synch_ind);
-	bcn_probersp_ptr = (uint8_t *) roam_synch_ind_ptr +
-		roam_synch_ind_ptr->beaconProbeRespOffset;
+	roam_synch_ind_ptr->bcn_probe_rsp =
+		iface->roam_synch_frame_ind.bcn_probe_rsp;
 	roam_synch_ind_ptr->beaconProbeRespLength =
 		iface->roam_synch_frame_ind.bcn_probe_rsp_len;
-	qdf_mem_copy(bcn_probersp_ptr,
-		iface->roam_synch_frame_ind.bcn_probe_rsp,
-		roam_synch_ind_ptr->beaconProbeRespLength);
-	qdf_mem_free(iface->roam_synch_frame_ind.bcn_probe_rsp);
-		iface->roam_synch_frame_ind.bcn_probe_rsp = NULL;
 
 	/* ReAssoc Rsp data */
-	roam_synch_ind_ptr->reassocRespOffset =
-		sizeof(struct roam_offload_synch_ind) +
-		roam_synch_ind_ptr->beaconProbeRespLength;
+	roam_synch_ind_ptr->reassoc_rsp =
+		iface->roam_synch_frame_ind.reassoc_rsp;
 	roam_synch_ind_ptr->reassocRespLength =
 		iface->roam_synch_frame_ind.reassoc_rsp_len;
-	reassoc_rsp_ptr = (uint8_t *) roam_synch_ind_ptr +
-			  roam_synch_ind_ptr->reassocRespOffset;
-	qdf_mem_copy(reassoc_rsp_ptr,
-		     iface->roam_synch_frame_ind.reassoc_rsp,
-		     roam_synch_ind_ptr->reassocRespLength);
-	qdf_mem_free(iface->roam_synch_frame_ind.reassoc_rsp);
-	iface->roam_synch_frame_ind.reassoc_rsp = NULL;
 
 	/* ReAssoc Req data */
-	roam_synch_ind_ptr->reassoc_req_offset =
-		sizeof(struct roam_offload_synch_ind) +
-		roam_synch_ind_ptr->beaconProbeRespLength +
-		roam_synch_ind_ptr->reassocRespLength;
+	roam_synch_ind_ptr->reassoc_req =
+		iface->roam_synch_frame_ind.reassoc_req;
 	roam_synch_ind_ptr->reassoc_req_length =
 		iface->roam_synch_frame_ind.reassoc_req_len;
-	reassoc_req_ptr = (uint8_t *) roam_synch_ind_ptr +
-			  roam_synch_ind_ptr->reassoc_req_offset;
-	qdf_mem_copy(reassoc_req_ptr,
-		     iface->roam_synch_frame_ind.reassoc_req,
-		     roam_synch_ind_ptr->reassoc_req_length);
-	qdf_mem_free(iface->roam_synch_frame_ind.reassoc_req);
-	iface->roam_synch_frame_ind.reassoc_req = NULL;
 }
 
 /**
@@ -2518,10 +2489,9 @@ static void wma_fill_data_synch_frame_event(tp_wma_handle wma,
  * @roam_synch_ind_ptr: Buffer to be filled
  * @param_buf: Source buffer
  *
- * Firmware sends all the required information required for roam
- * synch propagation as TLV's and stored in param_buf. These
- * parameters are parsed and filled into the roam synch indication
- * buffer which will be used at different layers for propagation.
+ * The frames carried in the synch event TLVs are not copied, the roam
+ * synch indication references them in @param_buf which stays valid for
+ * the whole roam synch propagation.
  *
  * Return: None
  */
@@ -2529,43 +2499,22 @@ static void wma_fill_data_synch_event(tp_wma_handle wma,
 				struct roam_offload_synch_ind *roam_synch_ind_ptr,
 				WMI_ROAM_SYNCH_EVENTID_param_tlvs *param_buf)
 {
-	uint8_t *bcn_probersp_ptr;
-	uint8_t *reassoc_rsp_ptr;
-	uint8_t *reassoc_req_ptr;
 	wmi_roam_synch_event_fixed_param *synch_event;
 
 	synch_event = param_buf->fixed_param;
 
 	/* Beacon/Probe Rsp data */
-	roam_synch_ind_ptr->beaconProbeRespOffset =
-		sizeof(struct roam_offload_synch_ind);
-	bcn_probersp_ptr = (uint8_t *) roam_synch_ind_ptr +
-		roam_synch_ind_ptr->beaconProbeRespOffset;
+	roam_synch_ind_ptr->bcn_probe_rsp = param_buf->bcn_probe_rsp_frame;
 	roam_synch_ind_ptr->beaconProbeRespLength =
 		synch_event->bcn_probe_rsp_len;
-	qdf_mem_copy(bcn_probersp_ptr, param_buf->bcn_probe_rsp_frame,
-		     roam_synch_ind_ptr->beaconProbeRespLength);
+
 	/* ReAssoc Rsp data */
-	roam_synch_ind_ptr->reassocRespOffset =
-		sizeof(struct roam_offload_synch_ind) +
-		roam_synch_ind_ptr->beaconProbeRespLength;
+	roam_synch_ind_ptr->reassoc_rsp = param_buf->reassoc_rsp_frame;
 	roam_synch_ind_ptr->reassocRespLength = synch_event->reassoc_rsp_len;
-	reassoc_rsp_ptr = (uint8_t *) roam_synch_ind_ptr +
-			  roam_synch_ind_ptr->reassocRespOffset;
-	qdf_mem_copy(reassoc_rsp_ptr,
-		     param_buf->reassoc_rsp_frame,
-		     roam_synch_ind_ptr->reassocRespLength);
 
 	/* ReAssoc Req data */
-	roam_synch_ind_ptr->reassoc_req_offset =
-		sizeof(struct roam_offload_synch_ind) +
-		roam_synch_ind_ptr->beaconProbeRespLength +
-		roam_synch_ind_ptr->reassocRespLength;
+	roam_synch_ind_ptr->reassoc_req = param_buf->reassoc_req_frame;
 	roam_synch_ind_ptr->reassoc_req_length = synch_event->reassoc_req_len;
-	reassoc_req_ptr = (uint8_t *) roam_synch_ind_ptr +
-			  roam_synch_ind_ptr->reassoc_req_offset;
-	qdf_mem_copy(reassoc_req_ptr, param_buf->reassoc_req_frame,
-		     roam_synch_ind_ptr->reassoc_req_length);
 }
 
 /**
@@ -2984,6 +2933,7 @@ int wma_mlme_roam_synch_event_handler_cb(void *handle, uint8_t *event,
 	A_UINT32 bcn_probe_rsp_len;
 	A_UINT32 reassoc_rsp_len;
 	A_UINT32 reassoc_req_len;
+	bool frame_ind_used = false;
 
 	wma_debug("LFR3: Received WMA_ROAM_OFFLOAD_SYNCH_IND");
 	if (!event) {
@@ -3008,6 +2958,9 @@ int wma_mlme_roam_synch_event_handler_cb(void *handle, uint8_t *event,
 		return status;
 	}
 
+	wlan_cm_roam_latency_record(wma->psoc, synch_event->vdev_id,
+				    ROAM_LATENCY_STAGE_SYNCH_START);
+
 	/*
 	 * This flag is set during ROAM_START and once this event is being
 	 * executed which is a run to completion, no other event can interrupt
@@ -3067,9 +3020,7 @@ int wma_mlme_roam_synch_event_handler_cb(void *handle, uint8_t *event,
 				      roam_synch_frame_ind.reassoc_req_len;
 		reassoc_rsp_len = wma->interfaces[synch_event->vdev_id].
 				      roam_synch_frame_ind.reassoc_rsp_len;
-
-		roam_synch_data_len = bcn_probe_rsp_len + reassoc_rsp_len +
-			reassoc_req_len + sizeof(struct roam_offload_synch_ind);
+		frame_ind_used = true;
 
 		wma_debug("Updated synch payload: LEN bcn:%d, req:%d, rsp:%d",
 			 bcn_probe_rsp_len,
@@ -3101,8 +3052,6 @@ int wma_mlme_roam_synch_event_handler_cb(void *handle, uint8_t *event,
 			(sizeof(*synch_event) + sizeof(wmi_channel) +
 			 sizeof(wmi_key_material) + sizeof(uint32_t)))
 			goto cleanup_label;
-
-		roam_synch_data_len += sizeof(struct roam_offload_synch_ind);
 	}
 
 	cds_host_diag_log_work(&wma->roam_ho_wl,
@@ -3111,17 +3060,19 @@ int wma_mlme_roam_synch_event_handler_cb(void *handle, uint8_t *event,
 	qdf_wake_lock_timeout_acquire(&wma->roam_ho_wl,
 				      WMA_ROAM_HO_WAKE_LOCK_DURATION);
 
-	roam_synch_ind_ptr = qdf_mem_malloc(roam_synch_data_len);
+	/* Frames are referenced from the event rather than copied */
+	roam_synch_ind_ptr = qdf_mem_malloc(sizeof(*roam_synch_ind_ptr));
 	if (!roam_synch_ind_ptr) {
 		QDF_ASSERT(roam_synch_ind_ptr);
 		status = -ENOMEM;
 		goto cleanup_label;
 	}
-	qdf_mem_zero(roam_synch_ind_ptr, roam_synch_data_len);
 	status = wma_fill_roam_synch_buffer(wma,
 			roam_synch_ind_ptr, param_buf);
 	if (status != 0)
 		goto cleanup_label;
+	wlan_cm_roam_latency_record(wma->psoc, synch_event->vdev_id,
+				    ROAM_LATENCY_STAGE_FILL_BUFFER);
 	/* 24 byte MAC header and 12 byte to ssid IE */
 	if (roam_synch_ind_ptr->beaconProbeRespLength >
 			(SIR_MAC_HDR_LEN_3A + SIR_MAC_B_PR_SSID_OFFSET)) {
@@ -3145,6 +3096,8 @@ int wma_mlme_roam_synch_event_handler_cb(void *handle, uint8_t *event,
 		status = -EBUSY;
 		goto cleanup_label;
 	}
+	wlan_cm_roam_latency_record(wma->psoc, synch_event->vdev_id,
+				    ROAM_LATENCY_STAGE_PE_PROPAGATION);
 
 	wma_roam_update_vdev(wma, roam_synch_ind_ptr);
 	wma->csr_roam_synch_cb(wma->mac_context, roam_synch_ind_ptr,
@@ -3171,6 +3124,10 @@ int wma_mlme_roam_synch_event_handler_cb(void *handle, uint8_t *event,
 
 	wma->csr_roam_synch_cb(wma->mac_context, roam_synch_ind_ptr,
 			       bss_desc_ptr, SIR_ROAM_SYNCH_COMPLETE);
+	wlan_cm_roam_latency_record(wma->psoc, synch_event->vdev_id,
+				    ROAM_LATENCY_STAGE_SYNCH_COMPLETE);
+	wlan_cm_roam_latency_end(wma->psoc, synch_event->vdev_id,
+				 QDF_STATUS_SUCCESS);
 	wma->interfaces[synch_event->vdev_id].roam_synch_delay =
 		qdf_get_system_timestamp() - roam_synch_received;
 	wma_debug("LFR3: roam_synch_delay:%d",
@@ -3186,9 +3143,16 @@ cleanup_label:
 			wma->csr_roam_synch_cb(wma->mac_context,
 					       roam_synch_ind_ptr, NULL,
 					       SIR_ROAMING_ABORT);
-		if (synch_event)
+		if (synch_event) {
+			wlan_cm_roam_latency_end(wma->psoc,
+						 synch_event->vdev_id,
+						 QDF_STATUS_E_FAILURE);
 			wma_post_roam_sync_failure(wma, synch_event->vdev_id);
+		}
 	}
+	if (frame_ind_used)
+		wma_free_roam_synch_frame_ind(
+				&wma->interfaces[synch_event->vdev_id]);
 	if (roam_synch_ind_ptr && roam_synch_ind_ptr->join_rsp)
 		qdf_mem_free(roam_synch_ind_ptr->join_rsp);
 	if (roam_synch_ind_ptr)
@@ -3377,6 +3341,8 @@ int wma_roam_synch_event_handler(void *handle, uint8_t *event,
 		return status;
 	}
 
+	wlan_cm_roam_latency_begin(wma->psoc, synch_event->vdev_id);
+
 	iface = &wma->interfaces[synch_event->vdev_id];
 	mlme_obj = wlan_vdev_mlme_get_cmpt_obj(iface->vdev);
 	if (mlme_obj)
@@ -3389,6 +3355,8 @@ int wma_roam_synch_event_handler(void *handle, uint8_t *event,
 						   event);
 	if (QDF_IS_STATUS_ERROR(qdf_status)) {
 		wma_err("Failed to send the EV_ROAM");
+		wlan_cm_roam_latency_end(wma->psoc, synch_event->vdev_id,
+					 QDF_STATUS_E_FAILURE);
 		wma_post_roam_sync_failure(wma, synch_event->vdev_id);
 		return status;
 	}